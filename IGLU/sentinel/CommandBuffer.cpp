@@ -67,4 +67,14 @@ void CommandBuffer::copyTextureToBuffer(igl::ITexture& src,
   IGLU_SENTINEL_ASSERT_IF_NOT(shouldAssert_);
 }
 
+void CommandBuffer::resetQueries(igl::IQueryPool& /*pool*/,
+                                 uint32_t /*firstQuery*/,
+                                 uint32_t /*queryCount*/) {
+  IGLU_SENTINEL_ASSERT_IF_NOT(shouldAssert_);
+}
+
+void CommandBuffer::writeTimestamp(igl::IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGLU_SENTINEL_ASSERT_IF_NOT(shouldAssert_);
+}
+
 } // namespace iglu::sentinel
@@ -44,6 +44,8 @@ class CommandBuffer final : public igl::ICommandBuffer {
                            uint64_t dstOffset,
                            uint32_t level,
                            uint32_t layer) final;
+  void resetQueries(igl::IQueryPool& pool, uint32_t firstQuery, uint32_t queryCount) final;
+  void writeTimestamp(igl::IQueryPool& pool, uint32_t query) final;
 
  private:
   [[maybe_unused]] bool shouldAssert_;
@@ -129,6 +129,13 @@ std::shared_ptr<igl::IFramebuffer> Device::createFramebuffer(
   return nullptr;
 }
 
+std::shared_ptr<igl::IQueryPool> Device::createQueryPool(
+    const igl::QueryPoolDesc& /*desc*/,
+    igl::Result* IGL_NULLABLE /*outResult*/) const {
+  IGLU_SENTINEL_ASSERT_IF_NOT(shouldAssert_);
+  return nullptr;
+}
+
 const igl::IPlatformDevice& Device::getPlatformDevice() const noexcept {
   IGLU_SENTINEL_ASSERT_IF_NOT(shouldAssert_);
   return platformDevice_;
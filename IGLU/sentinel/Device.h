@@ -76,6 +76,9 @@ class Device final : public igl::IDevice {
   [[nodiscard]] std::shared_ptr<igl::IFramebuffer> createFramebuffer(
       const igl::FramebufferDesc& desc,
       igl::Result* IGL_NULLABLE outResult) final;
+  [[nodiscard]] std::shared_ptr<igl::IQueryPool> createQueryPool(
+      const igl::QueryPoolDesc& desc,
+      igl::Result* IGL_NULLABLE outResult) const final;
   [[nodiscard]] const igl::IPlatformDevice& getPlatformDevice() const noexcept final;
   [[nodiscard]] bool verifyScope() final;
   [[nodiscard]] igl::BackendType getBackendType() const final;
@@ -20,7 +20,9 @@
 #include <secure_lib/secure_string.h>
 #endif
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <string>
@@ -139,6 +141,8 @@ ShaderUniforms::ShaderUniforms(igl::IDevice& device,
       bufferDesc->memberIndices[uniformDesc.name] = i;
     }
 
+    bufferDesc->index = static_cast<uint32_t>(buffers_.size());
+    buffers_.push_back(bufferDesc.get());
     bufferDescs_.insert({iglDesc.name, std::move(bufferDesc)});
   }
 
@@ -310,6 +314,208 @@ void ShaderUniforms::setUniformBytes(const igl::NameHandle& name,
   }
 }
 
+uint8_t* ShaderUniforms::getUniformData(const BufferDesc& buffer) {
+  uintptr_t subAllocatedOffset = 0;
+  if (buffer.isSuballocated && buffer.currentAllocation >= 0) {
+    subAllocatedOffset = buffer.currentAllocation * buffer.suballocationsSize;
+  }
+  return static_cast<uint8_t*>(buffer.allocation->ptr) + subAllocatedOffset;
+}
+
+const uint8_t* ShaderUniforms::getBufferData(const igl::NameHandle& bufferName) const {
+  auto it = bufferDescs_.find(bufferName);
+  return it != bufferDescs_.end() ? getUniformData(*it->second) : nullptr;
+}
+
+bool ShaderUniforms::addUniformTarget(const UniformDesc& uniformDesc, size_t elementSize) {
+  auto strongBuffer = uniformDesc.buffer.lock();
+  if (!strongBuffer) {
+    return false;
+  }
+  const auto& iglMemberDesc = uniformDesc.iglMemberDesc;
+
+  UniformTarget target;
+  target.bufferIndex = strongBuffer->index;
+  target.offset = static_cast<uint32_t>(iglMemberDesc.offset);
+  target.arrayLength = static_cast<uint32_t>(std::max<size_t>(iglMemberDesc.arrayLength, 1));
+  target.elementSize = static_cast<uint32_t>(elementSize);
+  target.stride = target.elementSize;
+
+  const bool isVec3 = iglMemberDesc.type == igl::UniformType::Float3 ||
+                      iglMemberDesc.type == igl::UniformType::Mat3x3;
+  if (isVec3 && elementSize % sizeof(iglu::simdtypes::float4) == 0) {
+    // Individual uniforms in OpenGL are tightly packed, buffers keep the padding of each vector
+    const bool isPacked = device_.getBackendType() == igl::BackendType::OpenGL &&
+                          !strongBuffer->iglBufferDesc.isUniformBlock;
+    target.columnStride = isPacked ? sizeof(float[3]) : sizeof(iglu::simdtypes::float4);
+    target.stride = static_cast<uint32_t>(elementSize / sizeof(iglu::simdtypes::float4)) *
+                    target.columnStride;
+  }
+
+  // Checked once here, so setting through the handle only checks the array range. The last vector
+  // of 3 floats is not padded.
+  const size_t lastElementSize = target.columnStride == 0
+                                     ? target.elementSize
+                                     : target.stride - target.columnStride + sizeof(float[3]);
+  const size_t end = static_cast<size_t>(target.offset) +
+                     static_cast<size_t>(target.stride) * (target.arrayLength - 1) +
+                     lastElementSize;
+  if (end > strongBuffer->iglBufferDesc.bufferDataSize) {
+    IGL_LOG_ERROR_ONCE("[IGL][Error] Uniform %s does not fit in its buffer\n",
+                       iglMemberDesc.name.c_str());
+    return false;
+  }
+
+  uniformTargets_.push_back(target);
+  return true;
+}
+
+std::pair<uint32_t, uint32_t> ShaderUniforms::resolveUniformTargets(
+    const igl::NameHandle& uniformName,
+    size_t elementSize) {
+  const auto firstTarget = static_cast<uint32_t>(uniformTargets_.size());
+  auto range = allUniformsByName_.equal_range(uniformName);
+  for (auto it = range.first; it != range.second; ++it) {
+    addUniformTarget(it->second, elementSize);
+  }
+  const auto numTargets = static_cast<uint32_t>(uniformTargets_.size()) - firstTarget;
+  if (numTargets == 0) {
+    IGL_LOG_ERROR_ONCE("[IGL][Error] Invalid uniform name: %s\n", uniformName.c_str());
+  }
+  return findOrKeepUniformTargets(firstTarget);
+}
+
+std::pair<uint32_t, uint32_t> ShaderUniforms::resolveUniformTargets(
+    const igl::NameHandle& blockTypeName,
+    const igl::NameHandle& blockInstanceName,
+    const igl::NameHandle& memberName,
+    size_t elementSize) {
+  const auto firstTarget = static_cast<uint32_t>(uniformTargets_.size());
+  auto possibleBufferNames =
+      getPossibleBufferAndMemberNames(blockTypeName, blockInstanceName, memberName);
+
+  // Same lookup as setUniformBytes(), done once
+  for (auto& [bufferName, bufferMemberName] : possibleBufferNames) {
+    auto range = bufferDescs_.equal_range(bufferName);
+    if (range.first == range.second) {
+      continue;
+    }
+    for (auto bufferDescIt = range.first; bufferDescIt != range.second; ++bufferDescIt) {
+      auto& bufferDesc = bufferDescIt->second;
+      auto memberIndexIt = bufferDesc->memberIndices.find(bufferMemberName);
+      if (memberIndexIt != bufferDesc->memberIndices.end()) {
+        addUniformTarget(bufferDesc->uniforms[memberIndexIt->second], elementSize);
+      }
+    }
+    break;
+  }
+
+  const auto numTargets = static_cast<uint32_t>(uniformTargets_.size()) - firstTarget;
+  if (numTargets == 0) {
+    IGL_LOG_ERROR_ONCE("[IGL][Error] Uniform not found: %s.%s\n",
+                       blockTypeName.c_str(),
+                       memberName.c_str());
+  }
+  return findOrKeepUniformTargets(firstTarget);
+}
+
+ShaderUniforms::BufferHandle ShaderUniforms::resolveBuffer(
+    const igl::NameHandle& blockTypeName,
+    const igl::NameHandle& blockInstanceName) {
+  // See getPossibleBufferAndMemberNames()
+  const igl::NameHandle& bufferName = device_.getBackendType() == igl::BackendType::Metal
+                                          ? blockInstanceName
+                                          : blockTypeName;
+
+  const auto firstTarget = static_cast<uint32_t>(uniformTargets_.size());
+  auto range = bufferDescs_.equal_range(bufferName);
+  for (auto it = range.first; it != range.second; ++it) {
+    const BufferDesc& bufferDesc = *it->second;
+    if (device_.getBackendType() == igl::BackendType::OpenGL &&
+        !bufferDesc.iglBufferDesc.isUniformBlock) {
+      continue;
+    }
+    UniformTarget target;
+    target.bufferIndex = bufferDesc.index;
+    target.stride = static_cast<uint32_t>(bufferDesc.iglBufferDesc.bufferDataSize);
+    target.arrayLength = 1;
+    target.elementSize = target.stride;
+    uniformTargets_.push_back(target);
+  }
+
+  const auto numTargets = static_cast<uint32_t>(uniformTargets_.size()) - firstTarget;
+  if (numTargets == 0) {
+    IGL_LOG_ERROR_ONCE("[IGL][Error] Buffer block not found: %s\n", blockTypeName.c_str());
+  }
+  const auto [resolvedFirstTarget, resolvedNumTargets] = findOrKeepUniformTargets(firstTarget);
+  return {resolvedFirstTarget, resolvedNumTargets};
+}
+
+std::pair<uint32_t, uint32_t> ShaderUniforms::findOrKeepUniformTargets(uint32_t firstTarget) {
+  const auto numTargets = static_cast<uint32_t>(uniformTargets_.size()) - firstTarget;
+  if (numTargets == 0) {
+    return {firstTarget, 0};
+  }
+  // Resolving is not done per frame, so a linear search keeps uniformTargets_ from growing when
+  // the same uniform is resolved again
+  const auto newTargets = uniformTargets_.begin() + firstTarget;
+  for (uint32_t i = 0; i + numTargets <= firstTarget; ++i) {
+    if (std::equal(newTargets, uniformTargets_.end(), uniformTargets_.begin() + i)) {
+      uniformTargets_.erase(newTargets, uniformTargets_.end());
+      return {i, numTargets};
+    }
+  }
+  return {firstTarget, numTargets};
+}
+
+void ShaderUniforms::setUniformBytes(uint32_t firstTarget,
+                                     uint32_t numTargets,
+                                     const void* data,
+                                     size_t count,
+                                     size_t arrayIndex) {
+  IGL_DEBUG_ASSERT(firstTarget + numTargets <= uniformTargets_.size());
+  for (uint32_t i = firstTarget; i < firstTarget + numTargets; ++i) {
+    const UniformTarget& target = uniformTargets_[i];
+    if (arrayIndex + count > target.arrayLength) {
+      IGL_LOG_ERROR_ONCE("[IGL][Error] Invalid range for uniform: %zu,%zu,%u\n",
+                         arrayIndex,
+                         count,
+                         target.arrayLength);
+      continue;
+    }
+
+    uint8_t* dst = getUniformData(*buffers_[target.bufferIndex]) + target.offset +
+                   static_cast<size_t>(target.stride) * arrayIndex;
+    if (target.columnStride == 0) {
+      std::memcpy(dst, data, static_cast<size_t>(target.elementSize) * count);
+      continue;
+    }
+
+    // Drop the padding of each vector of 3 floats
+    const auto* src = static_cast<const uint8_t*>(data);
+    const size_t numColumns = (target.elementSize / sizeof(iglu::simdtypes::float4)) * count;
+    for (size_t column = 0; column < numColumns; ++column) {
+      std::memcpy(dst, src, sizeof(float[3]));
+      dst += target.columnStride;
+      src += sizeof(iglu::simdtypes::float4);
+    }
+  }
+}
+
+void ShaderUniforms::setBuffer(const BufferHandle& handle, const void* data, size_t length) {
+  IGL_DEBUG_ASSERT(handle.firstTarget + handle.numTargets <= uniformTargets_.size());
+  for (uint32_t i = handle.firstTarget; i < handle.firstTarget + handle.numTargets; ++i) {
+    const UniformTarget& target = uniformTargets_[i];
+    if (length > target.stride) {
+      IGL_LOG_ERROR_ONCE("[IGL][Error] Invalid length for uniform buffer: %zu,%u\n",
+                         length,
+                         target.stride);
+      continue;
+    }
+    std::memcpy(getUniformData(*buffers_[target.bufferIndex]), data, length);
+  }
+}
+
 void ShaderUniforms::setBool(const igl::NameHandle& uniformName,
                              const bool& value,
                              size_t arrayIndex) {
@@ -191,6 +191,68 @@ class ShaderUniforms final {
                const iglu::simdtypes::int2& value,
                size_t arrayIndex = 0);
 
+  /// A uniform resolved by resolveUniform(). Setting it through the handle skips the name lookups
+  /// and writes straight to the uniform data. `T` is the type of the values passed to set().
+  template<typename T>
+  struct UniformHandle {
+    // Range of resolved locations in uniformTargets_, a uniform can be in several buffers
+    uint32_t firstTarget = 0;
+    uint32_t numTargets = 0;
+
+    [[nodiscard]] bool isValid() const noexcept {
+      return numTargets != 0;
+    }
+  };
+
+  /// A whole uniform buffer resolved by resolveBuffer()
+  struct BufferHandle {
+    uint32_t firstTarget = 0;
+    uint32_t numTargets = 0;
+
+    [[nodiscard]] bool isValid() const noexcept {
+      return numTargets != 0;
+    }
+  };
+
+  /// @brief Resolves a uniform once, e.g. when creating a drawable, to set it every frame with
+  /// set(). Resolving the same uniform again returns the same handle.
+  /// @returns an invalid handle if the uniform does not exist
+  template<typename T>
+  [[nodiscard]] UniformHandle<T> resolveUniform(const igl::NameHandle& uniformName) {
+    const auto [firstTarget, numTargets] = resolveUniformTargets(uniformName, sizeof(T));
+    return {firstTarget, numTargets};
+  }
+  template<typename T>
+  [[nodiscard]] UniformHandle<T> resolveUniform(const igl::NameHandle& blockTypeName,
+                                                const igl::NameHandle& blockInstanceName,
+                                                const igl::NameHandle& memberName) {
+    const auto [firstTarget, numTargets] =
+        resolveUniformTargets(blockTypeName, blockInstanceName, memberName, sizeof(T));
+    return {firstTarget, numTargets};
+  }
+
+  /// @brief Resolves a uniform block, to update all of its members at once with setBuffer().
+  /// Individual uniforms in legacy OpenGL shaders are not buffers and cannot be resolved.
+  /// @returns an invalid handle if the block does not exist
+  [[nodiscard]] BufferHandle resolveBuffer(const igl::NameHandle& blockTypeName,
+                                           const igl::NameHandle& blockInstanceName);
+
+  template<typename T>
+  void set(const UniformHandle<T>& handle, const T& value, size_t arrayIndex = 0) {
+    setUniformBytes(handle.firstTarget, handle.numTargets, &value, 1, arrayIndex);
+  }
+  template<typename T>
+  void setArray(const UniformHandle<T>& handle,
+                const T* value,
+                size_t count = 1,
+                size_t arrayIndex = 0) {
+    setUniformBytes(handle.firstTarget, handle.numTargets, value, count, arrayIndex);
+  }
+
+  /// @brief Copies `length` bytes to the start of a uniform block, typically a struct which matches
+  /// the layout of the block in the shader.
+  void setBuffer(const BufferHandle& handle, const void* data, size_t length);
+
   void setTexture(const std::string& name,
                   const std::shared_ptr<igl::ITexture>& value,
                   const std::shared_ptr<igl::ISamplerState>& sampler,
@@ -241,6 +303,11 @@ class ShaderUniforms final {
                        const igl::NameHandle& blockInstanceName,
                        const igl::NameHandle& memberName);
 
+  /// @brief The uniform data of the buffer named `bufferName` (a uniform block, or an individual
+  /// uniform in legacy OpenGL shaders), which is uploaded when the buffer is bound.
+  /// @returns nullptr if there is no such buffer
+  [[nodiscard]] const uint8_t* getBufferData(const igl::NameHandle& bufferName) const;
+
   class MemoizedQualifiedMemberNameCalculator {
    public:
     igl::NameHandle getQualifiedMemberName(const igl::NameHandle& blockTypeName,
@@ -283,6 +350,9 @@ class ShaderUniforms final {
     std::vector<UniformDesc> uniforms;
     std::unordered_map<igl::NameHandle, int> memberIndices;
 
+    // Index in buffers_
+    uint32_t index = 0;
+
     // For suballocation:
     bool isSuballocated = false;
     size_t suballocationsSize = 0; // this is a fixed size
@@ -298,6 +368,29 @@ class ShaderUniforms final {
 
   std::unordered_multimap<igl::NameHandle, UniformDesc> allUniformsByName_;
 
+  // Location of a resolved uniform in one of the buffers
+  struct UniformTarget {
+    uint32_t bufferIndex = 0;
+    uint32_t offset = 0;
+    // Bytes between array elements in the buffer
+    uint32_t stride = 0;
+    uint32_t arrayLength = 0;
+    // Bytes of each element in the values passed to set()
+    uint32_t elementSize = 0;
+    // Vectors of 3 floats are padded to 16 bytes in simdtypes. When this is not 0, only 12 bytes of
+    // each vector are written, `columnStride` bytes apart.
+    uint32_t columnStride = 0;
+
+    bool operator==(const UniformTarget& other) const {
+      return bufferIndex == other.bufferIndex && offset == other.offset &&
+             stride == other.stride && arrayLength == other.arrayLength &&
+             elementSize == other.elementSize && columnStride == other.columnStride;
+    }
+  };
+
+  std::vector<BufferDesc*> buffers_;
+  std::vector<UniformTarget> uniformTargets_;
+
   MemoizedQualifiedMemberNameCalculator memoizedQualifiedMemberNameCalculator_;
 
   struct TextureSlot {
@@ -339,6 +432,24 @@ class ShaderUniforms final {
                        size_t count,
                        size_t arrayIndex);
 
+  std::pair<uint32_t, uint32_t> resolveUniformTargets(const igl::NameHandle& uniformName,
+                                                      size_t elementSize);
+  std::pair<uint32_t, uint32_t> resolveUniformTargets(const igl::NameHandle& blockTypeName,
+                                                      const igl::NameHandle& blockInstanceName,
+                                                      const igl::NameHandle& memberName,
+                                                      size_t elementSize);
+  bool addUniformTarget(const UniformDesc& uniformDesc, size_t elementSize);
+  // Returns the targets added from `firstTarget` on, or the same targets resolved earlier
+  std::pair<uint32_t, uint32_t> findOrKeepUniformTargets(uint32_t firstTarget);
+
+  void setUniformBytes(uint32_t firstTarget,
+                       uint32_t numTargets,
+                       const void* data,
+                       size_t count,
+                       size_t arrayIndex);
+
+  [[nodiscard]] static uint8_t* getUniformData(const BufferDesc& buffer);
+
   void bindUniformOpenGL(const igl::NameHandle& uniformName,
                          const UniformDesc& uniformDesc,
                          const igl::IRenderPipelineState& pipelineState,
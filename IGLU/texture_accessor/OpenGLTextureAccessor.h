@@ -16,8 +16,6 @@
 
 #if IGL_BACKEND_OPENGL
 
-#include <igl/opengl/GLIncludes.h>
-
 namespace iglu::textureaccessor {
 
 class OpenGLTextureAccessor : public ITextureAccessor {
@@ -38,11 +36,9 @@ class OpenGLTextureAccessor : public ITextureAccessor {
   size_t textureHeight_ = 0;
   size_t textureBytesPerImage_ = 0;
 
-  GLuint pboId_ = 0;
-  GLsync sync_ = nullptr;
-  bool dataCopied_ = false;
-  bool asyncReadbackSupported_ = false;
-  bool textureAttached_ = false;
+  // reads into a pixel pack buffer where supported, see
+  // igl::opengl::Framebuffer::requestBytesColorAttachment()
+  std::shared_ptr<igl::IFramebufferReadback> readback_;
 };
 
 } // namespace iglu::textureaccessor
@@ -7,6 +7,19 @@
 
 #include <IGLU/texture_loader/IData.h>
 
+#include <cstdio>
+#include <limits>
+#include <igl/IGLSafeC.h>
+
+#define IGLU_TEXTURE_LOADER_MMAP (!IGL_PLATFORM_WINDOWS && !IGL_PLATFORM_EMSCRIPTEN)
+
+#if IGLU_TEXTURE_LOADER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace iglu::textureloader {
 namespace {
 class ByteData final : public IData {
@@ -44,6 +57,120 @@ IData::ExtractedData ByteData::extractData() noexcept {
       .deleter = [](void* d) { delete[] reinterpret_cast<uint8_t*>(d); },
   };
 }
+
+#if IGLU_TEXTURE_LOADER_MMAP
+class MappedFileData final : public IData {
+ public:
+  MappedFileData(void* IGL_NONNULL mapping, uint32_t length) noexcept;
+
+  ~MappedFileData() final;
+
+  [[nodiscard]] const uint8_t* IGL_NONNULL data() const noexcept final;
+  [[nodiscard]] uint32_t length() const noexcept final;
+
+  [[nodiscard]] ExtractedData extractData() noexcept final;
+
+ private:
+  void* mapping_ = nullptr;
+  uint32_t length_ = 0;
+};
+
+MappedFileData::MappedFileData(void* IGL_NONNULL mapping, uint32_t length) noexcept :
+  mapping_(mapping), length_(length) {}
+
+MappedFileData::~MappedFileData() {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, length_);
+  }
+}
+
+const uint8_t* IGL_NONNULL MappedFileData::data() const noexcept {
+  IGL_DEBUG_ASSERT(mapping_ != nullptr);
+  return static_cast<const uint8_t*>(mapping_);
+}
+
+uint32_t MappedFileData::length() const noexcept {
+  return length_;
+}
+
+IData::ExtractedData MappedFileData::extractData() noexcept {
+  // The deleter does not receive the length, which munmap() needs, so the extracted data is a heap
+  // copy of the mapping.
+  auto* copy = new uint8_t[length_];
+  checked_memcpy(copy, length_, mapping_, length_);
+  munmap(mapping_, length_);
+  mapping_ = nullptr;
+  return {
+      .data = copy,
+      .length = length_,
+      .deleter = [](void* d) { delete[] reinterpret_cast<uint8_t*>(d); },
+  };
+}
+
+std::unique_ptr<IData> tryMapFile(const char* IGL_NONNULL path,
+                                  igl::Result* IGL_NULLABLE outResult) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Failed to open file.");
+    return nullptr;
+  }
+
+  struct stat fileStat = {};
+  if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0 ||
+      static_cast<uint64_t>(fileStat.st_size) > std::numeric_limits<uint32_t>::max()) {
+    close(fd);
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentInvalid, "File is empty or too large.");
+    return nullptr;
+  }
+  const auto length = static_cast<uint32_t>(fileStat.st_size);
+
+  void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Failed to map file.");
+    return nullptr;
+  }
+  // Texture data is mostly read front to back, one mip level at a time
+  madvise(mapping, length, MADV_SEQUENTIAL);
+
+  igl::Result::setOk(outResult);
+  return std::make_unique<MappedFileData>(mapping, length);
+}
+#else
+std::unique_ptr<IData> tryReadFile(const char* IGL_NONNULL path,
+                                   igl::Result* IGL_NULLABLE outResult) {
+  FILE* file = fopen(path, "rb");
+  if (file == nullptr) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Failed to open file.");
+    return nullptr;
+  }
+
+  fseek(file, 0, SEEK_END);
+  const long fileSize = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  if (fileSize <= 0 ||
+      static_cast<unsigned long>(fileSize) > std::numeric_limits<uint32_t>::max()) {
+    fclose(file);
+    igl::Result::setResult(
+        outResult, igl::Result::Code::ArgumentInvalid, "File is empty or too large.");
+    return nullptr;
+  }
+  const auto length = static_cast<uint32_t>(fileSize);
+
+  auto data = std::make_unique<uint8_t[]>(length);
+  const size_t bytesRead = fread(data.get(), 1, length, file);
+  fclose(file);
+  if (bytesRead != length) {
+    igl::Result::setResult(outResult, igl::Result::Code::RuntimeError, "Failed to read file.");
+    return nullptr;
+  }
+
+  igl::Result::setOk(outResult);
+  return IData::tryCreate(std::move(data), length, outResult);
+}
+#endif
 } // namespace
 
 std::unique_ptr<IData> IData::tryCreate(std::unique_ptr<uint8_t[]> data,
@@ -62,4 +189,18 @@ std::unique_ptr<IData> IData::tryCreate(std::unique_ptr<uint8_t[]> data,
   return std::make_unique<ByteData>(std::move(data), length);
 }
 
+std::unique_ptr<IData> IData::tryCreateFromFile(const char* IGL_NONNULL path,
+                                                igl::Result* IGL_NULLABLE outResult) {
+  if (path == nullptr) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentNull, "path is nullptr");
+    return nullptr;
+  }
+
+#if IGLU_TEXTURE_LOADER_MMAP
+  return tryMapFile(path, outResult);
+#else
+  return tryReadFile(path, outResult);
+#endif
+}
+
 } // namespace iglu::textureloader
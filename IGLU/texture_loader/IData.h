@@ -25,6 +25,13 @@ class IData {
                                           uint32_t length,
                                           igl::Result* IGL_NULLABLE outResult);
 
+  /// Creates an IData with the contents of a file. Where supported, the file is memory mapped
+  /// read-only instead of being read into a heap buffer, so pages are only brought in when the
+  /// data is accessed and can be evicted again under memory pressure. On other platforms the file
+  /// is read into a heap buffer.
+  static std::unique_ptr<IData> tryCreateFromFile(const char* IGL_NONNULL path,
+                                                  igl::Result* IGL_NULLABLE outResult);
+
   /// @returns a read-only pointer to the data. May be nullptr.
   [[nodiscard]] virtual const uint8_t* IGL_NONNULL data() const noexcept = 0;
   /// @returns the length of the data in bytes.
@@ -103,14 +103,18 @@ std::shared_ptr<igl::ITexture> ITextureLoader::create(const igl::IDevice& device
   return device.createTexture(desc, outResult);
 }
 
+bool ITextureLoader::matchesDescriptor(const igl::ITexture& texture) const noexcept {
+  const auto dimensions = texture.getDimensions();
+  return texture.getType() == desc_.type &&
+         (desc_.numMipLevels <= 1 || texture.getNumMipLevels() == desc_.numMipLevels) &&
+         texture.getNumLayers() == desc_.numLayers && dimensions.width == desc_.width &&
+         dimensions.height == desc_.height && dimensions.depth == desc_.depth &&
+         texture.getFormat() == desc_.format;
+}
+
 void ITextureLoader::upload(igl::ITexture& texture,
                             igl::Result* IGL_NULLABLE outResult) const noexcept {
-  const auto dimensions = texture.getDimensions();
-  if (texture.getType() != desc_.type ||
-      (desc_.numMipLevels > 1 && texture.getNumMipLevels() != desc_.numMipLevels) ||
-      texture.getNumLayers() != desc_.numLayers || dimensions.width != desc_.width ||
-      dimensions.height != desc_.height || dimensions.depth != desc_.depth ||
-      texture.getFormat() != desc_.format) {
+  if (!matchesDescriptor(texture)) {
     igl::Result::setResult(
         outResult, igl::Result::Code::InvalidOperation, "Texture descriptor mismatch.");
     return;
@@ -119,6 +123,24 @@ void ITextureLoader::upload(igl::ITexture& texture,
   uploadInternal(texture, outResult);
 }
 
+void ITextureLoader::upload(igl::ITexture& texture,
+                            const IData& data,
+                            igl::Result* IGL_NULLABLE outResult) const noexcept {
+  if (!matchesDescriptor(texture)) {
+    igl::Result::setResult(
+        outResult, igl::Result::Code::InvalidOperation, "Texture descriptor mismatch.");
+    return;
+  }
+  if (data.length() < memorySizeInBytes()) {
+    igl::Result::setResult(outResult, igl::Result::Code::ArgumentInvalid, "data is too short.");
+    return;
+  }
+
+  const auto range = shouldGenerateMipmaps() ? texture.getFullRange() : texture.getFullMipRange();
+  auto result = texture.upload(range, data.data());
+  igl::Result::setResult(outResult, std::move(result));
+}
+
 std::unique_ptr<IData> ITextureLoader::load(igl::Result* IGL_NULLABLE outResult) const noexcept {
   return loadInternal(outResult);
 }
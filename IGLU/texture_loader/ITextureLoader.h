@@ -61,6 +61,11 @@ class ITextureLoader {
   }
 
   void upload(igl::ITexture& texture, igl::Result* IGL_NULLABLE outResult) const noexcept;
+  /// Uploads `data`, which was returned by load(), so the image is not decoded a second time. This
+  /// allows load() to run on a worker thread and only the upload on the render thread.
+  void upload(igl::ITexture& texture,
+              const IData& data,
+              igl::Result* IGL_NULLABLE outResult) const noexcept;
 
   [[nodiscard]] std::unique_ptr<IData> load(igl::Result* IGL_NULLABLE outResult) const noexcept;
   void loadToExternalMemory(uint8_t* IGL_NONNULL data,
@@ -94,6 +99,8 @@ class ITextureLoader {
   }
 
  private:
+  [[nodiscard]] bool matchesDescriptor(const igl::ITexture& texture) const noexcept;
+
   void defaultUpload(igl::ITexture& texture, igl::Result* IGL_NULLABLE outResult) const noexcept;
   [[nodiscard]] std::unique_ptr<IData> defaultLoad(
       igl::Result* IGL_NULLABLE outResult) const noexcept;
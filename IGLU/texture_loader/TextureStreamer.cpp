@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_loader/TextureStreamer.h>
+
+#include <IGLU/texture_loader/ThreadPool.h>
+#include <algorithm>
+#include <atomic>
+#include <igl/Device.h>
+
+namespace iglu::textureloader {
+namespace {
+
+// decoding is CPU-heavy; leave a core for the render thread
+constexpr uint32_t kMaxDefaultNumThreads = 8;
+
+uint32_t getDefaultNumThreads() {
+  const uint32_t numHardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+  return std::min(numHardwareThreads - 1u, kMaxDefaultNumThreads);
+}
+
+} // namespace
+
+struct TextureStreamer::Request {
+  RequestId id = 0;
+  int32_t priority = 0;
+  igl::TextureFormat preferredFormat = igl::TextureFormat::Invalid;
+  Callback callback;
+
+  // encoded data, referenced by the loader
+  std::unique_ptr<IData> data;
+  std::unique_ptr<ITextureLoader> loader;
+  // null if the loader uploads from the source data
+  std::unique_ptr<IData> decoded;
+  igl::Result result;
+
+  // ITextureLoader::memorySizeInBytes(), known once the loader is created
+  size_t bytes = 0;
+  // whether `bytes` are counted in inFlightBytes_
+  bool isInFlight = false;
+  // set under mutex_, but also polled by the decoding worker without it to skip the decode
+  std::atomic<bool> isCancelled = false;
+};
+
+TextureStreamer::TextureStreamer(const ITextureLoaderFactory& factory, Config config) :
+  factory_(factory),
+  config_(config),
+  numThreads_(config.numThreads ? config.numThreads : getDefaultNumThreads()) {}
+
+TextureStreamer::~TextureStreamer() {
+  {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+
+  for (auto& t : threads_) {
+    t.join();
+  }
+}
+
+TextureStreamer::RequestId TextureStreamer::enqueue(std::unique_ptr<IData> data,
+                                                    int32_t priority,
+                                                    Callback callback,
+                                                    igl::TextureFormat preferredFormat) {
+  if (!IGL_DEBUG_VERIFY(data != nullptr)) {
+    return 0;
+  }
+
+  auto request = std::make_unique<Request>();
+  request->priority = priority;
+  request->preferredFormat = preferredFormat;
+  request->callback = std::move(callback);
+  request->data = std::move(data);
+
+  RequestId id = 0;
+  {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    IGL_DEBUG_ASSERT(!stop_);
+
+    id = nextId_++;
+    request->id = id;
+    queued_.push_back(std::move(request));
+
+    if (threads_.size() < numThreads_ && threads_.size() < queued_.size()) {
+      threads_.emplace_back([this]() { workerLoop(); });
+    }
+  }
+  condition_.notify_one();
+
+  return id;
+}
+
+bool TextureStreamer::setPriority(RequestId id, int32_t priority) {
+  const std::lock_guard<std::mutex> guard(mutex_);
+  Request* request = findRequest(id);
+  if (request == nullptr) {
+    return false;
+  }
+  request->priority = priority;
+  return true;
+}
+
+bool TextureStreamer::cancel(RequestId id) {
+  bool releasedBytes = false;
+  {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    auto matchesId = [id](const std::unique_ptr<Request>& r) { return r->id == id; };
+
+    if (auto it = std::find_if(queued_.begin(), queued_.end(), matchesId); it != queued_.end()) {
+      queued_.erase(it);
+      return true;
+    }
+    if (auto it = std::find_if(ready_.begin(), ready_.end(), matchesId); it != ready_.end()) {
+      releasedBytes = (*it)->isInFlight;
+      releaseInFlightBytes(**it);
+      ready_.erase(it);
+    } else {
+      // the worker drops it when the decode is finished
+      auto decodingIt = std::find_if(
+          decoding_.begin(), decoding_.end(), [id](const Request* r) { return r->id == id; });
+      if (decodingIt == decoding_.end()) {
+        return false;
+      }
+      (*decodingIt)->isCancelled = true;
+    }
+  }
+  if (releasedBytes) {
+    condition_.notify_all();
+  }
+  return true;
+}
+
+uint32_t TextureStreamer::processUploads(const igl::IDevice& device,
+                                         igl::ICommandQueue& commandQueue) {
+  uint32_t numCompleted = 0;
+  size_t uploadedBytes = 0;
+
+  for (;;) {
+    std::unique_ptr<Request> request;
+    {
+      const std::lock_guard<std::mutex> guard(mutex_);
+      auto it = findNextRequest(ready_, false);
+      if (it == ready_.end() ||
+          (uploadedBytes > 0 && uploadedBytes + (*it)->bytes > config_.maxUploadBytesPerFrame)) {
+        break;
+      }
+      request = std::move(*it);
+      ready_.erase(it);
+    }
+
+    std::shared_ptr<igl::ITexture> texture;
+    igl::Result result = std::move(request->result);
+    if (result.isOk()) {
+      const ITextureLoader& loader = *request->loader;
+      texture = loader.create(device, &result);
+      if (texture != nullptr) {
+        if (request->decoded) {
+          loader.upload(*texture, *request->decoded, &result);
+        } else {
+          loader.upload(*texture, &result);
+        }
+      }
+      if (!result.isOk()) {
+        texture = nullptr;
+      } else if (loader.shouldGenerateMipmaps()) {
+        texture->generateMipmap(commandQueue);
+      }
+    }
+    uploadedBytes += request->bytes;
+
+    {
+      const std::lock_guard<std::mutex> guard(mutex_);
+      releaseInFlightBytes(*request);
+      if (result.isOk()) {
+        stats_.numUploaded++;
+        stats_.uploadedBytes += request->bytes;
+      } else {
+        stats_.numFailed++;
+      }
+    }
+    condition_.notify_all();
+    numCompleted++;
+
+    if (request->callback) {
+      request->callback(std::move(texture), result);
+    }
+  }
+
+  return numCompleted;
+}
+
+size_t TextureStreamer::getNumPendingRequests() const {
+  const std::lock_guard<std::mutex> guard(mutex_);
+  return queued_.size() + decoding_.size() + ready_.size();
+}
+
+size_t TextureStreamer::getNumReadyRequests() const {
+  const std::lock_guard<std::mutex> guard(mutex_);
+  return ready_.size();
+}
+
+TextureStreamer::Stats TextureStreamer::getStats() const {
+  const std::lock_guard<std::mutex> guard(mutex_);
+  return stats_;
+}
+
+void TextureStreamer::workerLoop() {
+  // the workers already decode in parallel, so loaders do not split up their work any further
+  ThreadPool::setIsWorkerThread(true);
+  for (;;) {
+    std::unique_ptr<Request> request;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() {
+        return stop_ || findNextRequest(queued_, true) != queued_.end();
+      });
+      if (stop_) {
+        return;
+      }
+      auto it = findNextRequest(queued_, true);
+      request = std::move(*it);
+      queued_.erase(it);
+      if (request->loader) {
+        reserveInFlightBytes(*request);
+      }
+      decoding_.push_back(request.get());
+    }
+
+    if (!request->loader) {
+      // parsing only reads the header for most formats, the budget is checked afterwards
+      request->loader = factory_.tryCreate(request->data->data(),
+                                           request->data->length(),
+                                           request->preferredFormat,
+                                           &request->result);
+      if (request->loader) {
+        request->bytes = request->loader->memorySizeInBytes();
+
+        const std::lock_guard<std::mutex> guard(mutex_);
+        if (!request->isCancelled && !fitsInFlight(request->bytes)) {
+          std::erase(decoding_, request.get());
+          queued_.push_back(std::move(request));
+          continue;
+        }
+        reserveInFlightBytes(*request);
+      }
+    }
+
+    if (request->loader && !request->loader->canUploadSourceData() && !request->isCancelled) {
+      request->decoded = request->loader->load(&request->result);
+      if (!request->decoded && request->result.isOk()) {
+        request->result =
+            igl::Result(igl::Result::Code::RuntimeError, "Failed to decode texture data.");
+      }
+    }
+
+    bool releasedBytes = false;
+    {
+      const std::lock_guard<std::mutex> guard(mutex_);
+      std::erase(decoding_, request.get());
+      if (request->isCancelled) {
+        releasedBytes = request->isInFlight;
+        releaseInFlightBytes(*request);
+      } else {
+        if (request->result.isOk()) {
+          stats_.numDecoded++;
+        }
+        ready_.push_back(std::move(request));
+      }
+    }
+    if (releasedBytes) {
+      condition_.notify_all();
+    }
+  }
+}
+
+bool TextureStreamer::fitsInFlight(size_t bytes) const noexcept {
+  return inFlightBytes_ == 0 || inFlightBytes_ + bytes <= config_.maxInFlightBytes;
+}
+
+void TextureStreamer::reserveInFlightBytes(Request& request) noexcept {
+  IGL_DEBUG_ASSERT(!request.isInFlight);
+  request.isInFlight = true;
+  inFlightBytes_ += request.bytes;
+  stats_.peakInFlightBytes = std::max(stats_.peakInFlightBytes, inFlightBytes_);
+}
+
+void TextureStreamer::releaseInFlightBytes(Request& request) noexcept {
+  if (request.isInFlight) {
+    request.isInFlight = false;
+    inFlightBytes_ -= request.bytes;
+  }
+}
+
+TextureStreamer::RequestList::iterator TextureStreamer::findNextRequest(
+    RequestList& requests,
+    bool checkInFlight) noexcept {
+  auto best = requests.end();
+  for (auto it = requests.begin(); it != requests.end(); ++it) {
+    const Request& r = **it;
+    // parsed requests wait until their decoded bytes fit in the budget
+    if (checkInFlight && r.loader && !fitsInFlight(r.bytes)) {
+      continue;
+    }
+    if (best == requests.end() || r.priority > (*best)->priority ||
+        (r.priority == (*best)->priority && r.id < (*best)->id)) {
+      best = it;
+    }
+  }
+  return best;
+}
+
+TextureStreamer::Request* TextureStreamer::findRequest(RequestId id) noexcept {
+  for (const auto& r : queued_) {
+    if (r->id == id) {
+      return r.get();
+    }
+  }
+  for (Request* r : decoding_) {
+    if (r->id == id) {
+      return r;
+    }
+  }
+  for (const auto& r : ready_) {
+    if (r->id == id) {
+      return r.get();
+    }
+  }
+  return nullptr;
+}
+
+} // namespace iglu::textureloader
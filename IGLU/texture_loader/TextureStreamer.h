@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <IGLU/texture_loader/IData.h>
+#include <IGLU/texture_loader/ITextureLoaderFactory.h>
+
+namespace igl {
+class ICommandQueue;
+class IDevice;
+} // namespace igl
+
+namespace iglu::textureloader {
+
+/**
+ * @brief Loads textures in the background and uploads them on the render thread.
+ *
+ * Requests are parsed and decoded (ITextureLoader::load()) on a pool of worker threads, highest
+ * priority first. Decoded requests wait in memory until processUploads() is called on the render
+ * thread, which creates the textures and uploads them within a per call byte budget. The bytes of
+ * decoded requests which are not uploaded yet are capped, so workers stop decoding when the render
+ * thread falls behind.
+ *
+ * Loaders which upload straight from the source data (e.g. KTX) are not decoded on the workers,
+ * but still count against the budgets.
+ *
+ * The factory is used from the worker threads concurrently and must outlive the streamer. The
+ * factories in IGLU are stateless and can be shared.
+ */
+class TextureStreamer final {
+ public:
+  using RequestId = uint64_t;
+  /// Called from processUploads() when a request completes. `texture` is null if loading failed.
+  using Callback =
+      std::function<void(std::shared_ptr<igl::ITexture> texture, const igl::Result& result)>;
+
+  struct Config {
+    /// Worker threads, 0 selects a default based on the number of hardware threads
+    uint32_t numThreads = 0;
+    /// Decoded bytes of requests which are not uploaded yet. A request larger than this is still
+    /// decoded when nothing else is in flight.
+    size_t maxInFlightBytes = 256u * 1024u * 1024u;
+    /// Bytes uploaded by one call to processUploads(). At least one request is uploaded per call.
+    size_t maxUploadBytesPerFrame = 32u * 1024u * 1024u;
+  };
+
+  struct Stats {
+    /// Requests which have been decoded, or prepared for uploading from source data
+    uint32_t numDecoded = 0;
+    /// Requests which completed successfully
+    uint32_t numUploaded = 0;
+    /// Requests which completed with an error
+    uint32_t numFailed = 0;
+    uint64_t uploadedBytes = 0;
+    size_t peakInFlightBytes = 0;
+  };
+
+  TextureStreamer(const ITextureLoaderFactory& factory, Config config);
+  /// @brief Discards the remaining requests without calling their callbacks and joins the workers
+  ~TextureStreamer();
+
+  TextureStreamer(const TextureStreamer&) = delete;
+  TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+  /// @brief Schedules loading a texture from encoded `data`. Higher `priority` requests are
+  /// decoded and uploaded first, requests with the same priority in order.
+  RequestId enqueue(std::unique_ptr<IData> data,
+                    int32_t priority,
+                    Callback callback,
+                    igl::TextureFormat preferredFormat = igl::TextureFormat::Invalid);
+
+  /// @brief Changes the priority of a request which has not been uploaded yet
+  bool setPriority(RequestId id, int32_t priority);
+
+  /// @brief Drops a request which has not been uploaded yet. Its callback is not called.
+  bool cancel(RequestId id);
+
+  /// @brief Must be called on the render thread, typically once per frame. Creates and uploads the
+  /// textures of decoded requests, highest priority first, up to the upload budget and calls their
+  /// callbacks. Mipmaps are generated with `commandQueue` when the loader requires it.
+  /// @returns the number of completed requests
+  uint32_t processUploads(const igl::IDevice& device, igl::ICommandQueue& commandQueue);
+
+  /// @returns the number of requests which have not completed
+  [[nodiscard]] size_t getNumPendingRequests() const;
+  /// @returns the number of decoded requests waiting for processUploads()
+  [[nodiscard]] size_t getNumReadyRequests() const;
+
+  [[nodiscard]] Stats getStats() const;
+
+ private:
+  struct Request;
+  using RequestList = std::vector<std::unique_ptr<Request>>;
+
+  void workerLoop();
+  // must be called with mutex_ held
+  [[nodiscard]] bool fitsInFlight(size_t bytes) const noexcept;
+  [[nodiscard]] RequestList::iterator findNextRequest(RequestList& requests,
+                                                      bool checkInFlight) noexcept;
+  [[nodiscard]] Request* findRequest(RequestId id) noexcept;
+  void reserveInFlightBytes(Request& request) noexcept;
+  void releaseInFlightBytes(Request& request) noexcept;
+
+  const ITextureLoaderFactory& factory_;
+  const Config config_;
+  const uint32_t numThreads_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<std::thread> threads_;
+  bool stop_ = false;
+  RequestId nextId_ = 1;
+
+  // waiting for a worker, including parsed requests which do not fit in the in-flight budget
+  RequestList queued_;
+  // being decoded by a worker
+  std::vector<Request*> decoding_;
+  // waiting for processUploads()
+  RequestList ready_;
+  size_t inFlightBytes_ = 0;
+  Stats stats_;
+};
+
+} // namespace iglu::textureloader
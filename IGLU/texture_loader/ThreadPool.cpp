@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_loader/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace iglu::textureloader {
+namespace {
+
+// decompression is bound by memory bandwidth, more threads rarely help
+constexpr uint32_t kMaxSharedNumThreads = 4;
+
+thread_local bool tlsIsWorkerThread = false;
+
+// The indices of one parallelFor() call. It is shared with the jobs, which may only start after the
+// call returned and then find no index left.
+struct ParallelForState {
+  explicit ParallelForState(size_t count) : count(count) {}
+
+  // returns false once every index was taken
+  bool runNext(const std::function<void(size_t)>& task) {
+    const size_t index = next.fetch_add(1);
+    if (index >= count) {
+      return false;
+    }
+    task(index);
+    if (++numCompleted == count) {
+      const std::lock_guard<std::mutex> guard(mutex);
+      condition.notify_all();
+    }
+    return true;
+  }
+
+  const size_t count;
+  std::atomic<size_t> next = 0;
+  std::atomic<size_t> numCompleted = 0;
+  std::mutex mutex;
+  std::condition_variable condition;
+};
+
+} // namespace
+
+ThreadPool::ThreadPool(uint32_t numThreads) {
+  threads_.reserve(numThreads);
+  for (uint32_t i = 0; i != numThreads; ++i) {
+    threads_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+
+  for (auto& t : threads_) {
+    t.join();
+  }
+}
+
+ThreadPool& ThreadPool::shared() {
+  static ThreadPool pool([]() {
+    const uint32_t numHardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    return std::min(numHardwareThreads - 1u, kMaxSharedNumThreads);
+  }());
+  return pool;
+}
+
+void ThreadPool::setIsWorkerThread(bool isWorkerThread) noexcept {
+  tlsIsWorkerThread = isWorkerThread;
+}
+
+bool ThreadPool::isWorkerThread() noexcept {
+  return tlsIsWorkerThread;
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+  if (count <= 1 || threads_.empty() || tlsIsWorkerThread) {
+    for (size_t i = 0; i != count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>(count);
+  {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    const size_t numJobs = std::min(count - 1, threads_.size());
+    for (size_t i = 0; i != numJobs; ++i) {
+      // `task` is only called while the caller waits for it
+      jobs_.emplace_back([state, &task]() {
+        while (state->runNext(task)) {
+        }
+      });
+    }
+  }
+  condition_.notify_all();
+
+  while (state->runNext(task)) {
+  }
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->condition.wait(lock, [&state]() { return state->numCompleted == state->count; });
+}
+
+void ThreadPool::workerLoop() {
+  tlsIsWorkerThread = true;
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() { return stop_ || !jobs_.empty(); });
+      if (stop_) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job();
+  }
+}
+
+} // namespace iglu::textureloader
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace iglu::textureloader {
+
+/**
+ * @brief A fixed number of worker threads which loaders use to split up CPU-heavy work, e.g. the
+ * decompression of mip levels.
+ *
+ * shared() is created on first use and is used by every loader of the process, so concurrent
+ * loads do not start more threads than the pool has. Threads which already run loads in parallel,
+ * like the workers of the pool and of TextureStreamer, do the work inline instead of waiting for
+ * the pool.
+ */
+class ThreadPool final {
+ public:
+  explicit ThreadPool(uint32_t numThreads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// The pool of the process, with a thread per hardware thread but one, up to a small maximum
+  static ThreadPool& shared();
+
+  /// Marks the calling thread as a worker, so parallelFor() calls made on it run inline
+  static void setIsWorkerThread(bool isWorkerThread) noexcept;
+  [[nodiscard]] static bool isWorkerThread() noexcept;
+
+  /// Calls `task` for every index in [0, count) and returns once all calls have finished. The
+  /// calling thread takes part in the work.
+  void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+  [[nodiscard]] size_t numThreads() const noexcept {
+    return threads_.size();
+  }
+
+ private:
+  void workerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::function<void()>> jobs_;
+  bool stop_ = false;
+  std::vector<std::thread> threads_;
+};
+
+} // namespace iglu::textureloader
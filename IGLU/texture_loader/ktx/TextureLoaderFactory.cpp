@@ -7,12 +7,19 @@
 
 #include <IGLU/texture_loader/ktx/TextureLoaderFactory.h>
 
+#include <algorithm>
 #include <ktx.h>
 #include <igl/IGLSafeC.h>
 
 namespace iglu::textureloader::ktx {
 namespace {
 
+#if IGL_PLATFORM_ANDROID || IGL_PLATFORM_IOS
+constexpr ktx_transcode_fmt_e kBasisTranscodeFormat = KTX_TTF_ASTC_4x4_RGBA;
+#else
+constexpr ktx_transcode_fmt_e kBasisTranscodeFormat = KTX_TTF_BC7_RGBA;
+#endif
+
 struct KtxDeleter {
   void operator()(void* p) const {
     ktxTexture_Destroy(ktxTexture(p));
@@ -26,7 +33,9 @@ class TextureLoader : public ITextureLoader {
   TextureLoader(DataReader reader,
                 const igl::TextureRangeDesc& range,
                 igl::TextureFormat format,
-                std::unique_ptr<ktxTexture, KtxDeleter> texture) noexcept;
+                std::unique_ptr<ktxTexture, KtxDeleter> texture,
+                std::vector<uint32_t> mipLevelOffsets,
+                std::unique_ptr<IData> mipLevelData) noexcept;
 
   [[nodiscard]] bool canUploadSourceData() const noexcept final;
   [[nodiscard]] bool shouldGenerateMipmaps() const noexcept final;
@@ -38,14 +47,34 @@ class TextureLoader : public ITextureLoader {
                                     uint32_t length,
                                     igl::Result* IGL_NULLABLE outResult) const noexcept final;
 
+  void streamUpload(igl::ITexture& texture, igl::Result* IGL_NULLABLE outResult) const noexcept;
+  void streamLoadToExternalMemory(uint8_t* IGL_NONNULL data,
+                                  uint32_t length,
+                                  igl::Result* IGL_NULLABLE outResult) const noexcept;
+
+  [[nodiscard]] uint32_t numMipLevelsToLoad() const noexcept;
+  [[nodiscard]] const uint8_t* IGL_NONNULL mipLevelBytes(uint32_t mipLevel) const noexcept;
+
   std::unique_ptr<ktxTexture, KtxDeleter> texture_;
+  igl::TextureRangeDesc range_;
+  // Offsets of the mip levels in mipLevelData_ or the reader, empty if libktx has loaded the image
+  // data
+  std::vector<uint32_t> mipLevelOffsets_;
+  // Decompressed image data, null if the mip levels are read from the reader
+  std::unique_ptr<IData> mipLevelData_;
 };
 
 TextureLoader::TextureLoader(DataReader reader,
                              const igl::TextureRangeDesc& range,
                              igl::TextureFormat format,
-                             std::unique_ptr<ktxTexture, KtxDeleter> texture) noexcept :
-  Super(reader), texture_(std::move(texture)) {
+                             std::unique_ptr<ktxTexture, KtxDeleter> texture,
+                             std::vector<uint32_t> mipLevelOffsets,
+                             std::unique_ptr<IData> mipLevelData) noexcept :
+  Super(reader),
+  texture_(std::move(texture)),
+  range_(range),
+  mipLevelOffsets_(std::move(mipLevelOffsets)),
+  mipLevelData_(std::move(mipLevelData)) {
   auto& desc = mutableDescriptor();
   desc.format = format;
   desc.numLayers = range.numLayers;
@@ -75,8 +104,22 @@ bool TextureLoader::shouldGenerateMipmaps() const noexcept {
   return texture_->generateMipmaps;
 }
 
+uint32_t TextureLoader::numMipLevelsToLoad() const noexcept {
+  return std::min(descriptor().numMipLevels, texture_->numLevels);
+}
+
+const uint8_t* IGL_NONNULL TextureLoader::mipLevelBytes(uint32_t mipLevel) const noexcept {
+  const uint32_t offset = mipLevelOffsets_[mipLevel];
+  return mipLevelData_ ? mipLevelData_->data() + offset : reader().at(offset);
+}
+
 void TextureLoader::uploadInternal(igl::ITexture& texture,
                                    igl::Result* IGL_NULLABLE outResult) const noexcept {
+  if (!mipLevelOffsets_.empty()) {
+    streamUpload(texture, outResult);
+    return;
+  }
+
   const auto& desc = descriptor();
 
   size_t offset = 0;
@@ -98,6 +141,11 @@ void TextureLoader::loadToExternalMemoryInternal(uint8_t* IGL_NONNULL data,
                                                  uint32_t length,
                                                  igl::Result* IGL_NULLABLE
                                                      outResult) const noexcept {
+  if (!mipLevelOffsets_.empty()) {
+    streamLoadToExternalMemory(data, length, outResult);
+    return;
+  }
+
   const auto& desc = descriptor();
 
   size_t offset = 0;
@@ -128,6 +176,48 @@ void TextureLoader::loadToExternalMemoryInternal(uint8_t* IGL_NONNULL data,
     offset += mipLevelLength;
   }
 }
+
+void TextureLoader::streamUpload(igl::ITexture& texture,
+                                 igl::Result* IGL_NULLABLE outResult) const noexcept {
+  // Smallest mip levels first: they are stored first in KTX2 files and make the texture usable at
+  // a lower resolution as early as possible
+  const uint32_t numMipLevels = numMipLevelsToLoad();
+  for (uint32_t i = 0; i < numMipLevels; ++i) {
+    const uint32_t mipLevel = numMipLevels - i - 1;
+    auto result = texture.upload(texture.getFullRange(mipLevel), mipLevelBytes(mipLevel));
+    if (!result.isOk()) {
+      igl::Result::setResult(outResult, std::move(result));
+      return;
+    }
+  }
+
+  igl::Result::setOk(outResult);
+}
+
+void TextureLoader::streamLoadToExternalMemory(uint8_t* IGL_NONNULL data,
+                                               uint32_t length,
+                                               igl::Result* IGL_NULLABLE
+                                                   outResult) const noexcept {
+  // Mip levels are tightly packed from the largest to the smallest, as expected by
+  // ITexture::upload() for a range with multiple mip levels
+  const auto properties = igl::TextureFormatProperties::fromTextureFormat(descriptor().format);
+  const uint32_t numMipLevels = numMipLevelsToLoad();
+  size_t offset = 0;
+  for (uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel) {
+    const size_t mipLevelLength = properties.getBytesPerRange(range_.atMipLevel(mipLevel));
+    const size_t availableSize = offset > length ? 0 : length - offset;
+    if (mipLevelLength > availableSize) {
+      igl::Result::setResult(
+          outResult, igl::Result::Code::InvalidOperation, "data length is too small.");
+      return;
+    }
+
+    checked_memcpy_offset(data, length, offset, mipLevelBytes(mipLevel), mipLevelLength);
+    offset += mipLevelLength;
+  }
+
+  igl::Result::setOk(outResult);
+}
 } // namespace
 
 std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
@@ -145,9 +235,28 @@ std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
     return nullptr;
   }
 
+  // When the image data can be uploaded as stored, only the header and the level index are parsed
+  // here and mip levels are uploaded straight from the reader later. This avoids a copy of the
+  // whole image data, and the reader may be a memory mapped file (see IData::tryCreateFromFile()).
+  auto mipLevelOffsets = this->mipLevelOffsets(reader, range);
+  std::unique_ptr<IData> mipLevelData;
+  if (mipLevelOffsets.empty()) {
+    // Supercompressed mip levels are decompressed in parallel
+    mipLevelData = decompressMipLevels(reader, range, mipLevelOffsets);
+  }
+  auto transcodedFormat = igl::TextureFormat::Invalid;
+  if (mipLevelOffsets.empty()) {
+    // Basis Universal mip levels are transcoded in parallel
+    mipLevelData = transcodeMipLevels(
+        reader, range, kBasisTranscodeFormat, mipLevelOffsets, transcodedFormat);
+  }
+  const ktxTextureCreateFlags createFlags = mipLevelOffsets.empty()
+                                                ? KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT
+                                                : KTX_TEXTURE_CREATE_NO_FLAGS;
+
   ktxTexture* rawTexture = nullptr;
-  auto error = ktxTexture_CreateFromMemory(
-      reader.data(), reader.length(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &rawTexture);
+  auto error =
+      ktxTexture_CreateFromMemory(reader.data(), reader.length(), createFlags, &rawTexture);
 
   if (error != KTX_SUCCESS || rawTexture == nullptr) {
     IGL_LOG_ERROR("Error loading KTX texture: %d %s\n", error, ktxErrorString(error));
@@ -161,14 +270,9 @@ std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
 
   auto texture = std::unique_ptr<ktxTexture, KtxDeleter>(rawTexture);
 
-  if (ktxTexture_NeedsTranscoding(rawTexture)) {
-#if IGL_PLATFORM_ANDROID || IGL_PLATFORM_IOS
-    const ktx_transcode_fmt_e transcodeFormat = KTX_TTF_ASTC_4x4_RGBA;
-#else
-    const ktx_transcode_fmt_e transcodeFormat = KTX_TTF_BC7_RGBA;
-#endif
-    error =
-        ktxTexture2_TranscodeBasis(reinterpret_cast<ktxTexture2*>(rawTexture), transcodeFormat, 0);
+  if (mipLevelOffsets.empty() && ktxTexture_NeedsTranscoding(rawTexture)) {
+    error = ktxTexture2_TranscodeBasis(
+        reinterpret_cast<ktxTexture2*>(rawTexture), kBasisTranscodeFormat, 0);
     if (error != KTX_SUCCESS) {
       IGL_LOG_ERROR("Error transcoding KTX texture: %d %s\n", error, ktxErrorString(error));
       igl::Result::setResult(
@@ -177,7 +281,8 @@ std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
     }
   }
 
-  const auto format = textureFormat(rawTexture);
+  const auto format = transcodedFormat != igl::TextureFormat::Invalid ? transcodedFormat
+                                                                       : textureFormat(rawTexture);
   if (format == igl::TextureFormat::Invalid) {
     igl::Result::setResult(
         outResult, igl::Result::Code::RuntimeError, "Unsupported KTX texture format.");
@@ -214,6 +319,11 @@ std::unique_ptr<ITextureLoader> TextureLoaderFactory::tryCreateInternal(
     return nullptr;
   }
 
-  return std::make_unique<TextureLoader>(reader, range, format, std::move(texture));
+  return std::make_unique<TextureLoader>(reader,
+                                         range,
+                                         format,
+                                         std::move(texture),
+                                         std::move(mipLevelOffsets),
+                                         std::move(mipLevelData));
 }
 } // namespace iglu::textureloader::ktx
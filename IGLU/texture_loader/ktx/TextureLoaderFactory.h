@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <vector>
 #include <IGLU/texture_loader/ITextureLoaderFactory.h>
 
 struct ktxTexture;
@@ -28,6 +29,38 @@ class TextureLoaderFactory : public ITextureLoaderFactory {
   [[nodiscard]] virtual igl::TextureFormat textureFormat(
       const ktxTexture* IGL_NONNULL texture) const noexcept = 0;
 
+  /// @returns the offset in `reader` of the image data of each mip level, if the data can be
+  /// uploaded as stored. In that case the loader uploads straight from the reader and libktx does
+  /// not copy the image data. Returns an empty vector if libktx has to decode the data first.
+  [[nodiscard]] virtual std::vector<uint32_t> mipLevelOffsets(
+      DataReader reader,
+      const igl::TextureRangeDesc& range) const noexcept = 0;
+
+  /// Decompresses supercompressed image data which can be uploaded once decompressed, instead of
+  /// letting libktx inflate the mip levels one after the other. Returns null if libktx has to load
+  /// the data. Otherwise the mip levels are tightly packed from the largest to the smallest and
+  /// `outMipLevelOffsets` receives their offsets.
+  [[nodiscard]] virtual std::unique_ptr<IData> decompressMipLevels(
+      DataReader /*reader*/,
+      const igl::TextureRangeDesc& /*range*/,
+      std::vector<uint32_t>& /*outMipLevelOffsets*/) const noexcept {
+    return nullptr;
+  }
+
+  /// Transcodes Basis Universal image data to `transcodeFormat` (a ktx_transcode_fmt_e) one mip
+  /// level at a time on the shared ThreadPool, instead of letting libktx transcode the whole
+  /// texture on the calling thread. Returns null if libktx has to transcode the data. Otherwise the
+  /// mip levels are tightly packed from the largest to the smallest, `outMipLevelOffsets` receives
+  /// their offsets and `outFormat` the format of the transcoded data.
+  [[nodiscard]] virtual std::unique_ptr<IData> transcodeMipLevels(
+      DataReader /*reader*/,
+      const igl::TextureRangeDesc& /*range*/,
+      uint32_t /*transcodeFormat*/,
+      std::vector<uint32_t>& /*outMipLevelOffsets*/,
+      igl::TextureFormat& /*outFormat*/) const noexcept {
+    return nullptr;
+  }
+
  private:
   [[nodiscard]] std::unique_ptr<ITextureLoader> tryCreateInternal(
       DataReader reader,
@@ -37,4 +37,7 @@ static_assert(sizeof(Header) == 13 * sizeof(uint32_t) + 12);
 
 constexpr uint32_t kHeaderLength = static_cast<uint32_t>(sizeof(Header));
 
+/// Header::endianness of files in the byte order of a little endian machine
+constexpr uint32_t kEndiannessReference = 0x04030201u;
+
 } // namespace iglu::textureloader::ktx1
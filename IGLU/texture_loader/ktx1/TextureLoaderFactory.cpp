@@ -119,4 +119,31 @@ igl::TextureFormat TextureLoaderFactory::textureFormat(const ktxTexture* texture
   return igl::TextureFormat::Invalid;
 }
 
+std::vector<uint32_t> TextureLoaderFactory::mipLevelOffsets(
+    DataReader reader,
+    const igl::TextureRangeDesc& range) const noexcept {
+  const Header* header = reader.as<Header>();
+  // Data in big endian byte order is swapped by libktx
+  if (header->endianness != kEndiannessReference) {
+    return {};
+  }
+
+  const uint32_t numFaces = header->numberOfFaces == 6u ? 6u : 1u;
+
+  // validate() has already checked every imageSize
+  std::vector<uint32_t> offsets(range.numMipLevels);
+  uint32_t offset = kHeaderLength + header->bytesOfKeyValueData;
+  for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
+    const uint32_t imageSize = reader.readAt<uint32_t>(offset);
+    // Images which are not a multiple of 4 bytes are followed by cube and mip padding
+    if (imageSize % 4u != 0u) {
+      return {};
+    }
+    offsets[mipLevel] = offset + 4u;
+    offset += 4u + numFaces * imageSize;
+  }
+
+  return offsets;
+}
+
 } // namespace iglu::textureloader::ktx1
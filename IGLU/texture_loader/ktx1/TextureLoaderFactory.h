@@ -34,6 +34,10 @@ class TextureLoaderFactory final : public ktx::TextureLoaderFactory {
 
   [[nodiscard]] igl::TextureFormat textureFormat(
       const ktxTexture* IGL_NONNULL texture) const noexcept final;
+
+  [[nodiscard]] std::vector<uint32_t> mipLevelOffsets(
+      DataReader reader,
+      const igl::TextureRangeDesc& range) const noexcept final;
 };
 
 } // namespace iglu::textureloader::ktx1
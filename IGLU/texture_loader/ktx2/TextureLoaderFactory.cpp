@@ -7,9 +7,14 @@
 
 #include <IGLU/texture_loader/ktx2/TextureLoaderFactory.h>
 
+#include <IGLU/texture_loader/ThreadPool.h>
 #include <IGLU/texture_loader/ktx2/Header.h>
+#include <algorithm>
+#include <cstring>
 #include <ktx.h>
+#include <limits>
 #include <numeric>
+#include <zstd.h>
 #include <igl/vulkan/util/TextureFormat.h>
 
 namespace iglu::textureloader::ktx2 {
@@ -18,6 +23,153 @@ template<typename T>
 T align(T offset, T alignment) {
   return (offset + (alignment - 1)) & ~(alignment - 1);
 }
+
+// KHR_DF supercompression scheme, see ktxSupercmpScheme
+constexpr uint32_t kSupercompressionBasisLz = 1u;
+constexpr uint32_t kSupercompressionZstd = 2u;
+
+// Sizes of ktxBasisLzGlobalHeader and ktxBasisLzEtc1sImageDesc in the supercompression global data
+constexpr uint64_t kBasisLzGlobalHeaderLength = 20u;
+constexpr uint64_t kBasisLzImageDescLength = 20u;
+
+// Smaller mip levels are decompressed or transcoded on the calling thread: handing them to the
+// pool costs more
+constexpr uint64_t kMinParallelDecompressionBytes = 256u * 1024u;
+
+struct CompressedMipLevel {
+  const uint8_t* src = nullptr;
+  size_t srcLength = 0;
+  size_t dstOffset = 0;
+  size_t dstLength = 0;
+};
+
+bool decompressZstd(const CompressedMipLevel& level, uint8_t* dst) {
+  const size_t length =
+      ZSTD_decompress(dst + level.dstOffset, level.dstLength, level.src, level.srcLength);
+  return !ZSTD_isError(length) && length == level.dstLength;
+}
+
+bool isInReader(uint64_t offset, uint64_t length, uint32_t readerLength) {
+  return offset <= readerLength && length <= readerLength - offset;
+}
+
+uint32_t numImagesInMipLevel(const igl::TextureRangeDesc& range, uint32_t mipLevel) {
+  return std::max(range.depth >> mipLevel, 1u) * range.numLayers * range.numFaces;
+}
+
+/// A KTX2 file with only `mipLevel` of the Basis Universal file in `reader`, which libktx can
+/// transcode independently of the other mip levels. Empty if the file is malformed.
+std::vector<uint8_t> extractMipLevel(DataReader reader,
+                                     const igl::TextureRangeDesc& range,
+                                     uint32_t mipLevel) {
+  const Header* header = reader.as<Header>();
+  const uint32_t length = reader.length();
+  const uint32_t levelIndexOffset = kHeaderLength + mipLevel * 24u;
+  // validate() does not check the level index of Basis Universal files
+  if (!isInReader(levelIndexOffset, 24u, length)) {
+    return {};
+  }
+  const uint64_t byteOffset = reader.readAt<uint64_t>(levelIndexOffset);
+  const uint64_t byteLength = reader.readAt<uint64_t>(levelIndexOffset + 8u);
+  const uint64_t uncompressedByteLength = reader.readAt<uint64_t>(levelIndexOffset + 16u);
+  if (!isInReader(byteOffset, byteLength, length) ||
+      !isInReader(header->dfdByteOffset, header->dfdByteLength, length) ||
+      !isInReader(header->kvdByteOffset, header->kvdByteLength, length) ||
+      !isInReader(header->sgdByteOffset, header->sgdByteLength, length)) {
+    return {};
+  }
+
+  const uint8_t* sgdBytes = reader.at(static_cast<uint32_t>(header->sgdByteOffset));
+  std::vector<uint8_t> sgd;
+  if (header->supercompressionScheme == kSupercompressionBasisLz) {
+    // The global data describes every image of every mip level, only the descriptions of this mip
+    // level are kept. The codebooks which follow them are shared by all mip levels.
+    uint64_t firstImage = 0;
+    uint64_t numImages = 0;
+    for (uint32_t level = 0; level < range.numMipLevels; ++level) {
+      firstImage += level < mipLevel ? numImagesInMipLevel(range, level) : 0u;
+      numImages += numImagesInMipLevel(range, level);
+    }
+    const uint64_t imageDescsLength = numImages * kBasisLzImageDescLength;
+    if (header->sgdByteLength < kBasisLzGlobalHeaderLength + imageDescsLength) {
+      return {};
+    }
+    const uint8_t* imageDescs = sgdBytes + kBasisLzGlobalHeaderLength;
+    sgd.insert(sgd.end(), sgdBytes, imageDescs);
+    sgd.insert(sgd.end(),
+               imageDescs + firstImage * kBasisLzImageDescLength,
+               imageDescs + (firstImage + numImagesInMipLevel(range, mipLevel)) *
+                                kBasisLzImageDescLength);
+    sgd.insert(sgd.end(), imageDescs + imageDescsLength, sgdBytes + header->sgdByteLength);
+  } else {
+    sgd.assign(sgdBytes, sgdBytes + header->sgdByteLength);
+  }
+
+  Header levelHeader = *header;
+  levelHeader.pixelWidth = header->pixelWidth ? std::max(header->pixelWidth >> mipLevel, 1u) : 0u;
+  levelHeader.pixelHeight =
+      header->pixelHeight ? std::max(header->pixelHeight >> mipLevel, 1u) : 0u;
+  levelHeader.pixelDepth = header->pixelDepth ? std::max(header->pixelDepth >> mipLevel, 1u) : 0u;
+  levelHeader.levelCount = 1u;
+
+  // Same layout as the source file: level index, DFD, key/value data, global data and image data
+  uint64_t offset = kHeaderLength + 24u;
+  levelHeader.dfdByteOffset = static_cast<uint32_t>(offset);
+  offset += header->dfdByteLength;
+  levelHeader.kvdByteOffset = header->kvdByteLength ? static_cast<uint32_t>(offset) : 0u;
+  offset += header->kvdByteLength;
+  levelHeader.sgdByteOffset = sgd.empty() ? 0u : align<uint64_t>(offset, 8u);
+  levelHeader.sgdByteLength = sgd.size();
+  offset = sgd.empty() ? offset : levelHeader.sgdByteOffset + sgd.size();
+  // Only the 16-byte blocks of UASTC are aligned, supercompressed data is not
+  const uint64_t dataOffset =
+      header->supercompressionScheme == 0u ? align<uint64_t>(offset, 16u) : offset;
+
+  std::vector<uint8_t> file(static_cast<size_t>(dataOffset + byteLength));
+  const uint64_t levelIndex[3] = {dataOffset, byteLength, uncompressedByteLength};
+  std::memcpy(file.data(), &levelHeader, kHeaderLength);
+  std::memcpy(file.data() + kHeaderLength, levelIndex, sizeof(levelIndex));
+  std::memcpy(file.data() + levelHeader.dfdByteOffset,
+              reader.at(header->dfdByteOffset),
+              header->dfdByteLength);
+  if (header->kvdByteLength) {
+    std::memcpy(file.data() + levelHeader.kvdByteOffset,
+                reader.at(header->kvdByteOffset),
+                header->kvdByteLength);
+  }
+  if (!sgd.empty()) {
+    std::memcpy(file.data() + levelHeader.sgdByteOffset, sgd.data(), sgd.size());
+  }
+  std::memcpy(file.data() + dataOffset,
+              reader.at(static_cast<uint32_t>(byteOffset)),
+              static_cast<size_t>(byteLength));
+  return file;
+}
+
+struct Ktx2Deleter {
+  void operator()(ktxTexture2* p) const {
+    ktxTexture_Destroy(ktxTexture(p));
+  }
+};
+
+std::unique_ptr<ktxTexture2, Ktx2Deleter> transcodeBasis(const std::vector<uint8_t>& file,
+                                                         ktx_transcode_fmt_e transcodeFormat) {
+  if (file.empty()) {
+    return nullptr;
+  }
+  ktxTexture2* rawTexture = nullptr;
+  if (ktxTexture2_CreateFromMemory(
+          file.data(), file.size(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &rawTexture) !=
+          KTX_SUCCESS ||
+      rawTexture == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<ktxTexture2, Ktx2Deleter> texture(rawTexture);
+  if (ktxTexture2_TranscodeBasis(rawTexture, transcodeFormat, 0) != KTX_SUCCESS) {
+    return nullptr;
+  }
+  return texture;
+}
 } // namespace
 
 uint32_t TextureLoaderFactory::headerLength() const noexcept {
@@ -95,11 +247,13 @@ bool TextureLoaderFactory::validate(DataReader reader,
         igl::vulkan::util::vkTextureFormatToTextureFormat(static_cast<int32_t>(header->vkFormat));
     const auto properties = igl::TextureFormatProperties::fromTextureFormat(format);
 
+    // Supercompressed mip levels are not padded
+    const bool isSupercompressed = header->supercompressionScheme != 0;
     const uint32_t mipLevelAlignment =
-        std::lcm(static_cast<uint32_t>(properties.bytesPerBlock), 4u);
+        isSupercompressed ? 1u : std::lcm(static_cast<uint32_t>(properties.bytesPerBlock), 4u);
 
     size_t rangeBytesAsSizeT = 0;
-    for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
+    for (uint32_t mipLevel = 0; !isSupercompressed && mipLevel < range.numMipLevels; ++mipLevel) {
       rangeBytesAsSizeT += align(properties.getBytesPerRange(range.atMipLevel(mipLevel)),
                                  static_cast<size_t>(mipLevelAlignment));
     }
@@ -109,6 +263,7 @@ bool TextureLoaderFactory::validate(DataReader reader,
           outResult, igl::Result::Code::InvalidOperation, "Length is too short.");
       return false;
     }
+    // 0 for supercompressed data, whose length is checked for each mip level below
     const uint32_t rangeBytes = static_cast<uint32_t>(rangeBytesAsSizeT);
 
     // Mipmap metadata is:
@@ -158,6 +313,13 @@ bool TextureLoaderFactory::validate(DataReader reader,
         return false;
       }
 
+      if (expectedDataOffset > length ||
+          byteLength > static_cast<uint64_t>(length - expectedDataOffset)) {
+        igl::Result::setResult(
+            outResult, igl::Result::Code::InvalidOperation, "Length shorter than expected length.");
+        return false;
+      }
+
       if (static_cast<size_t>(uncompressedByteLength) !=
           properties.getBytesPerRange(range.atMipLevel(mipLevel))) {
         igl::Result::setResult(
@@ -182,4 +344,167 @@ igl::TextureFormat TextureLoaderFactory::textureFormat(const ktxTexture* texture
 
   return igl::TextureFormat::Invalid;
 }
+
+std::vector<uint32_t> TextureLoaderFactory::mipLevelOffsets(
+    DataReader reader,
+    const igl::TextureRangeDesc& range) const noexcept {
+  const Header* header = reader.as<Header>();
+  // Basis Universal and supercompressed data has to be decoded first
+  if (header->vkFormat == 0u || header->supercompressionScheme != 0u) {
+    return {};
+  }
+
+  // validate() has already checked every byteOffset in the level index
+  std::vector<uint32_t> offsets(range.numMipLevels);
+  for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
+    offsets[mipLevel] =
+        static_cast<uint32_t>(reader.readAt<uint64_t>(kHeaderLength + mipLevel * 24u));
+  }
+
+  return offsets;
+}
+
+std::unique_ptr<IData> TextureLoaderFactory::decompressMipLevels(
+    DataReader reader,
+    const igl::TextureRangeDesc& range,
+    std::vector<uint32_t>& outMipLevelOffsets) const noexcept {
+  const Header* header = reader.as<Header>();
+  // Basis Universal data is supercompressed and transcoded by libktx
+  if (header->vkFormat == 0u || header->supercompressionScheme != kSupercompressionZstd) {
+    return nullptr;
+  }
+
+  // validate() has already checked the level index against the reader and the format
+  std::vector<CompressedMipLevel> levels(range.numMipLevels);
+  uint64_t length = 0;
+  for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
+    const uint32_t offset = kHeaderLength + mipLevel * 24u;
+    auto& level = levels[mipLevel];
+    level.src = reader.at(static_cast<uint32_t>(reader.readAt<uint64_t>(offset)));
+    level.srcLength = static_cast<size_t>(reader.readAt<uint64_t>(offset + 8u));
+    level.dstOffset = static_cast<size_t>(length);
+    level.dstLength = static_cast<size_t>(reader.readAt<uint64_t>(offset + 16u));
+    length += level.dstLength;
+  }
+  if (length == 0 || length > std::numeric_limits<uint32_t>::max()) {
+    return nullptr;
+  }
+
+  auto data = std::make_unique<uint8_t[]>(static_cast<size_t>(length));
+
+  // Each mip level is a separate Zstandard frame. The large ones are spread over the shared pool,
+  // which runs them inline when this is already a loading thread, e.g. of TextureStreamer.
+  std::vector<uint8_t> succeeded(levels.size(), 0);
+  std::vector<size_t> largeLevels;
+  for (size_t i = 0; i < levels.size(); ++i) {
+    if (levels[i].dstLength >= kMinParallelDecompressionBytes) {
+      largeLevels.push_back(i);
+    } else {
+      succeeded[i] = decompressZstd(levels[i], data.get()) ? 1 : 0;
+    }
+  }
+  ThreadPool::shared().parallelFor(
+      largeLevels.size(), [&levels, &largeLevels, &succeeded, dst = data.get()](size_t j) {
+        const size_t i = largeLevels[j];
+        succeeded[i] = decompressZstd(levels[i], dst) ? 1 : 0;
+      });
+
+  if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end()) {
+    // libktx reports the error
+    IGL_LOG_ERROR("Error decompressing KTX2 mip levels with Zstandard\n");
+    return nullptr;
+  }
+
+  outMipLevelOffsets.resize(levels.size());
+  for (size_t i = 0; i < levels.size(); ++i) {
+    outMipLevelOffsets[i] = static_cast<uint32_t>(levels[i].dstOffset);
+  }
+  return IData::tryCreate(std::move(data), static_cast<uint32_t>(length), nullptr);
+}
+
+std::unique_ptr<IData> TextureLoaderFactory::transcodeMipLevels(
+    DataReader reader,
+    const igl::TextureRangeDesc& range,
+    uint32_t transcodeFormat,
+    std::vector<uint32_t>& outMipLevelOffsets,
+    igl::TextureFormat& outFormat) const noexcept {
+  const Header* header = reader.as<Header>();
+  // A single mip level gains nothing over libktx transcoding the whole texture
+  if (header->vkFormat != 0u || range.numMipLevels < 2u) {
+    return nullptr;
+  }
+
+  // Each mip level is extracted to a KTX2 file of its own, which libktx transcodes like any other.
+  // The smallest one goes first on the calling thread: it initializes the transcoder tables, which
+  // is not thread-safe, and yields the format of the transcoded data.
+  const auto format = static_cast<ktx_transcode_fmt_e>(transcodeFormat);
+  const uint32_t smallestMipLevel = range.numMipLevels - 1u;
+  auto smallest = transcodeBasis(extractMipLevel(reader, range, smallestMipLevel), format);
+  if (!smallest) {
+    return nullptr;
+  }
+  outFormat = textureFormat(ktxTexture(smallest.get()));
+  if (outFormat == igl::TextureFormat::Invalid) {
+    return nullptr;
+  }
+
+  const auto properties = igl::TextureFormatProperties::fromTextureFormat(outFormat);
+  std::vector<size_t> offsets(range.numMipLevels);
+  std::vector<size_t> lengths(range.numMipLevels);
+  uint64_t length = 0;
+  for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
+    offsets[mipLevel] = static_cast<size_t>(length);
+    lengths[mipLevel] = properties.getBytesPerRange(range.atMipLevel(mipLevel));
+    length += lengths[mipLevel];
+  }
+  if (length == 0 || length > std::numeric_limits<uint32_t>::max()) {
+    return nullptr;
+  }
+
+  auto data = std::make_unique<uint8_t[]>(static_cast<size_t>(length));
+  const ktx_uint32_t vkFormat = smallest->vkFormat;
+  auto copyMipLevel = [&offsets, &lengths, vkFormat, dst = data.get()](
+                          const ktxTexture2* texture, uint32_t mipLevel) {
+    if (!texture || texture->vkFormat != vkFormat ||
+        ktxTexture_GetDataSize(ktxTexture(texture)) != lengths[mipLevel]) {
+      return false;
+    }
+    std::memcpy(dst + offsets[mipLevel], texture->pData, lengths[mipLevel]);
+    return true;
+  };
+
+  std::vector<uint8_t> succeeded(range.numMipLevels, 0);
+  succeeded[smallestMipLevel] = copyMipLevel(smallest.get(), smallestMipLevel) ? 1 : 0;
+  smallest.reset();
+
+  // Like decompressMipLevels(), only the large mip levels are worth handing to the shared pool
+  auto transcodeMipLevel = [&](uint32_t mipLevel) {
+    const auto texture = transcodeBasis(extractMipLevel(reader, range, mipLevel), format);
+    succeeded[mipLevel] = copyMipLevel(texture.get(), mipLevel) ? 1 : 0;
+  };
+  std::vector<uint32_t> largeMipLevels;
+  for (uint32_t mipLevel = 0; mipLevel < smallestMipLevel; ++mipLevel) {
+    if (lengths[mipLevel] >= kMinParallelDecompressionBytes) {
+      largeMipLevels.push_back(mipLevel);
+    } else {
+      transcodeMipLevel(mipLevel);
+    }
+  }
+  ThreadPool::shared().parallelFor(
+      largeMipLevels.size(),
+      [&largeMipLevels, &transcodeMipLevel](size_t j) { transcodeMipLevel(largeMipLevels[j]); });
+
+  if (std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end()) {
+    // libktx transcodes the whole texture instead
+    IGL_LOG_ERROR("Error transcoding KTX2 mip levels\n");
+    outFormat = igl::TextureFormat::Invalid;
+    return nullptr;
+  }
+
+  outMipLevelOffsets.resize(range.numMipLevels);
+  for (uint32_t mipLevel = 0; mipLevel < range.numMipLevels; ++mipLevel) {
+    outMipLevelOffsets[mipLevel] = static_cast<uint32_t>(offsets[mipLevel]);
+  }
+  return IData::tryCreate(std::move(data), static_cast<uint32_t>(length), nullptr);
+}
 } // namespace iglu::textureloader::ktx2
@@ -34,6 +34,22 @@ class TextureLoaderFactory final : public ktx::TextureLoaderFactory {
 
   [[nodiscard]] igl::TextureFormat textureFormat(
       const ktxTexture* IGL_NONNULL texture) const noexcept final;
+
+  [[nodiscard]] std::vector<uint32_t> mipLevelOffsets(
+      DataReader reader,
+      const igl::TextureRangeDesc& range) const noexcept final;
+
+  [[nodiscard]] std::unique_ptr<IData> decompressMipLevels(
+      DataReader reader,
+      const igl::TextureRangeDesc& range,
+      std::vector<uint32_t>& outMipLevelOffsets) const noexcept final;
+
+  [[nodiscard]] std::unique_ptr<IData> transcodeMipLevels(
+      DataReader reader,
+      const igl::TextureRangeDesc& range,
+      uint32_t transcodeFormat,
+      std::vector<uint32_t>& outMipLevelOffsets,
+      igl::TextureFormat& outFormat) const noexcept final;
 };
 
 } // namespace iglu::textureloader::ktx2
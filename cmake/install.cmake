@@ -178,6 +178,7 @@ if(NOT ALL_DISCOVERED_TARGETS)
       IGLVulkan
       IGLGlslang
       IGLstb
+      IGLzstd
       # IGLU targets
       IGLUimgui
       IGLUmanagedUniformBuffer
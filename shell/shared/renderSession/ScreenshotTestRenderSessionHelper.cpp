@@ -6,6 +6,7 @@
  */
 
 #include <igl/Config.h>
+#include <igl/PixelConversion.h>
 
 #include <shell/shared/imageWriter/ImageWriter.h>
 #include <shell/shared/renderSession/ScreenshotTestRenderSessionHelper.h>
@@ -38,9 +39,7 @@ void SaveFrameBufferToPng(const char* absoluteFilename,
     // Swap B and R channels, as image writer expects RGBA.
     // Note that this is only defined for the Windows platform, as in practice
     // BGRA might only be used there for render targets.
-    for (size_t i = 0; i < numPixels; i += bytesPerPixel) {
-      std::swap(buffer.get()[i], buffer.get()[i + 2]);
-    }
+    convertPixels(buffer.get(), buffer.get(), numPixels, PixelConversion::SwapRedBlue8);
   }
 #endif
 
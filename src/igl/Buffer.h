@@ -53,6 +53,7 @@ struct BufferDesc {
     // @fb-only
     Ring = 1 << 4, // Metal/Vulkan: Ring buffers with memory for each swapchain image
     NoCopy = 1 << 5, // Metal: The buffer should re-use previously allocated memory.
+    Streaming = 1 << 6, // OpenGL: Persistently mapped memory with a slot per draw in flight
   };
 
   using BufferAPIHint = uint8_t;
@@ -15,6 +15,7 @@
 namespace igl {
 
 class IComputeCommandEncoder;
+class IQueryPool;
 class ISamplerState;
 struct RenderPassDesc;
 
@@ -134,6 +135,19 @@ class ICommandBuffer {
                                    uint32_t level = 0,
                                    uint32_t layer = 0) = 0;
 
+  /**
+   * @brief Resets queries [firstQuery, firstQuery + queryCount) so they can be written again. This
+   * has to be called outside of render and compute encoders.
+   */
+  virtual void resetQueries(IQueryPool& pool, uint32_t firstQuery, uint32_t queryCount) = 0;
+
+  /**
+   * @brief Writes a GPU timestamp into the QueryType::Timestamp query `query` once all previously
+   * recorded commands have completed. This has to be called outside of render and compute
+   * encoders; use ICommandEncoder::writeTimestamp() inside them.
+   */
+  virtual void writeTimestamp(IQueryPool& pool, uint32_t query) = 0;
+
   /**
    * @returns the number of draw operations tracked by this CommandBuffer. This is tracked manually
    * via calls to incrementCurrentDrawCount().
@@ -18,6 +18,7 @@ class ICommandBuffer;
 class IDevice;
 
 class IBuffer;
+class IQueryPool;
 class IRenderPipelineState;
 class ISamplerState;
 class ITexture;
@@ -98,6 +99,23 @@ class ICommandEncoder {
    */
   virtual void popDebugGroupLabel() const = 0;
 
+  /**
+   * Writes a GPU timestamp into the QueryType::Timestamp query `query` once all previously
+   * encoded commands have completed.
+   */
+  virtual void writeTimestamp(IQueryPool& pool, uint32_t query) = 0;
+
+  /**
+   * Starts counting pipeline statistics into the QueryType::PipelineStatistics query `query`.
+   * Every beginQuery() must be matched by endQuery() within the same encoder.
+   */
+  virtual void beginQuery(IQueryPool& pool, uint32_t query) = 0;
+
+  /**
+   * Stops counting pipeline statistics started by beginQuery().
+   */
+  virtual void endQuery(IQueryPool& pool, uint32_t query) = 0;
+
   ICommandBuffer& getCommandBuffer() {
     IGL_DEBUG_ASSERT(commandBuffer_);
     return *commandBuffer_;
@@ -22,6 +22,7 @@ struct BufferDesc;
 struct ComputePipelineDesc;
 struct DepthStencilStateDesc;
 struct FramebufferDesc;
+struct QueryPoolDesc;
 struct RenderPipelineDesc;
 struct SamplerStateDesc;
 struct ShaderLibraryDesc;
@@ -33,6 +34,7 @@ class ICommandBuffer;
 class IComputePipelineState;
 class IDepthStencilState;
 class IFramebuffer;
+class IQueryPool;
 class IRenderPipelineState;
 class ISamplerState;
 class IShaderLibrary;
@@ -221,6 +223,17 @@ class IDevice : public ICapabilities {
   virtual std::shared_ptr<IFramebuffer> createFramebuffer(const FramebufferDesc& desc,
                                                           Result* IGL_NULLABLE outResult) = 0;
 
+  /**
+   * @brief Creates a pool of GPU queries.
+   * @see igl::QueryPoolDesc
+   * @param desc Description for the desired resource.
+   * @param outResult Pointer to where the result (success, failure, etc) is written. Can be null if
+   * no reporting is desired.
+   * @return Shared pointer to the created query pool.
+   */
+  virtual std::shared_ptr<IQueryPool> createQueryPool(const QueryPoolDesc& desc,
+                                                      Result* IGL_NULLABLE outResult) const = 0;
+
   /**
    * @brief Returns a platform-specific device. If the requested device type does not match that of
    * the actual underlying device, then null is returned.
@@ -42,6 +42,7 @@ namespace igl {
  * MultiSampleResolve         Supports GPU multisampled texture resolve
  * Multiview                  Supports multiview
  * MultiViewMultisample       Supports multisampled multiview
+ * PipelineStatisticsQueries  Supports QueryType::PipelineStatistics query pools
  * PushConstants              Supports push constants(Vulkan)
  * ReadWriteFramebuffer       Supports separate FB reading/writing binding
  * SamplerMinMaxLod           Supports constraining the min and max texture LOD when sampling
@@ -66,6 +67,7 @@ namespace igl {
  * TextureNotPot              Supports non power-of-two textures
  * TexturePartialMipChain     Supports mip chains that do not go all the way to 1x1
  * TextureViews               Supports IDevice::createTextureView()
+ * TimestampQueries           Supports QueryType::Timestamp query pools
  * UniformBlocks,             Supports uniform blocks
  * Indices8Bit,               Supports uint8 vertex indices
  * ValidationLayersEnabled,   Validation layers are enabled
@@ -94,6 +96,7 @@ enum class DeviceFeatures {
   MultiSampleResolve,
   Multiview,
   MultiViewMultisample,
+  PipelineStatisticsQueries,
   PushConstants,
   ReadWriteFramebuffer,
   SamplerMinMaxLod,
@@ -119,6 +122,7 @@ enum class DeviceFeatures {
   TextureNotPot,
   TexturePartialMipChain,
   TextureViews,
+  TimestampQueries,
   UniformBlocks,
   ValidationLayersEnabled,
 };
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/Framebuffer.h>
+
+#include <cstring>
+#include <utility>
+
+namespace igl {
+
+namespace {
+
+// the pixels were copied synchronously when the readback was requested
+class CompletedFramebufferReadback final : public IFramebufferReadback {
+ public:
+  CompletedFramebufferReadback(std::vector<uint8_t> pixels, size_t bytesPerRow) :
+    pixels_(std::move(pixels)), bytesPerRow_(bytesPerRow) {}
+
+  [[nodiscard]] bool isReady() const override {
+    return true;
+  }
+
+  Result copyBytes(void* pixelBytes, size_t bytesPerRow) override {
+    if (!IGL_DEBUG_VERIFY(pixelBytes)) {
+      return Result(Result::Code::ArgumentNull, "pixelBytes is null");
+    }
+    if (bytesPerRow == 0 || bytesPerRow == bytesPerRow_) {
+      memcpy(pixelBytes, pixels_.data(), pixels_.size());
+      return Result();
+    }
+    if (bytesPerRow < bytesPerRow_) {
+      return Result(Result::Code::ArgumentOutOfRange, "bytesPerRow is too small");
+    }
+    auto* dst = static_cast<uint8_t*>(pixelBytes);
+    for (size_t offset = 0; offset < pixels_.size(); offset += bytesPerRow_) {
+      memcpy(dst, pixels_.data() + offset, bytesPerRow_);
+      dst += bytesPerRow;
+    }
+    return Result();
+  }
+
+ private:
+  std::vector<uint8_t> pixels_;
+  size_t bytesPerRow_;
+};
+
+} // namespace
+
+std::shared_ptr<IFramebufferReadback> IFramebuffer::requestBytesColorAttachment(
+    ICommandQueue& cmdQueue,
+    size_t index,
+    const TextureRangeDesc& range,
+    Result* IGL_NULLABLE outResult) const {
+  const auto texture = getColorAttachment(index);
+  if (!texture) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "No color attachment at index");
+    return nullptr;
+  }
+  const auto& properties = texture->getProperties();
+  const size_t bytesPerRow = properties.getBytesPerRow(range);
+  std::vector<uint8_t> pixels(bytesPerRow * properties.getRows(range));
+  copyBytesColorAttachment(cmdQueue, index, pixels.data(), range, bytesPerRow);
+
+  Result::setOk(outResult);
+  return std::make_shared<CompletedFramebufferReadback>(std::move(pixels), bytesPerRow);
+}
+
+} // namespace igl
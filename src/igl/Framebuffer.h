@@ -44,6 +44,22 @@ struct FramebufferDesc {
   FramebufferMode mode = FramebufferMode::Mono;
 };
 
+/**
+ * @brief A pending copy of framebuffer pixels into CPU-visible memory, see
+ * IFramebuffer::requestBytesColorAttachment()
+ */
+class IFramebufferReadback {
+ public:
+  virtual ~IFramebufferReadback() = default;
+
+  /** @brief Returns true once the copy has finished, so copyBytes() does not wait for the GPU. */
+  [[nodiscard]] virtual bool isReady() const = 0;
+
+  /** @brief Copies the pixels into 'pixelBytes', waiting for the copy if it has not finished yet.
+   * If bytesPerRow is 0, it will be autocalculated assuming no padding. */
+  virtual Result copyBytes(void* pixelBytes, size_t bytesPerRow = 0) = 0;
+};
+
 /**
  * @brief Interface common to all frame buffers across all implementations
  */
@@ -79,6 +95,17 @@ class IFramebuffer : public ITrackedResource<IFramebuffer> {
                                         const TextureRangeDesc& range,
                                         size_t bytesPerRow = 0) const = 0;
 
+  /** @brief Starts copying color data from the color attachment at the specified index into
+   * staging memory, without waiting for the GPU. The returned handle becomes ready a few frames
+   * later, and its staging memory is reused once the handle is destroyed. Implementations without
+   * asynchronous readbacks copy the pixels right away and return a handle which is already ready.
+   * Some implementations may only support index 0. */
+  virtual std::shared_ptr<IFramebufferReadback> requestBytesColorAttachment(
+      ICommandQueue& cmdQueue,
+      size_t index,
+      const TextureRangeDesc& range,
+      Result* IGL_NULLABLE outResult = nullptr) const;
+
   /** @brief Copy depth data from the depth attachment into 'pixelBytes'. If bytesPerRow is 0, it
    * will be autocalculated assuming now padding. */
   virtual void copyBytesDepthAttachment(ICommandQueue& cmdQueue,
@@ -17,6 +17,7 @@
 #include <igl/Device.h> // IWYU pragma: export
 #include <igl/Framebuffer.h> // IWYU pragma: export
 #include <igl/HWDevice.h> // IWYU pragma: export
+#include <igl/QueryPool.h> // IWYU pragma: export
 #include <igl/RenderCommandEncoder.h> // IWYU pragma: export
 #include <igl/RenderPass.h> // IWYU pragma: export
 #include <igl/RenderPipelineState.h> // IWYU pragma: export
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/PixelConversion.h>
+
+#include <cstring>
+#include <igl/Common.h>
+
+// The instruction sets are selected at compile time, e.g. with -mavx2 -mf16c or /arch:AVX2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IGL_PIXEL_CONVERSION_SSE2 1
+#include <emmintrin.h>
+#else
+#define IGL_PIXEL_CONVERSION_SSE2 0
+#endif
+
+#if IGL_PIXEL_CONVERSION_SSE2 && defined(__AVX2__)
+#define IGL_PIXEL_CONVERSION_AVX2 1
+#include <immintrin.h>
+#else
+#define IGL_PIXEL_CONVERSION_AVX2 0
+#endif
+
+// MSVC does not define __F16C__, but every CPU with AVX2 supports F16C
+#if IGL_PIXEL_CONVERSION_SSE2 && (defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__)))
+#define IGL_PIXEL_CONVERSION_F16C 1
+#include <immintrin.h>
+#else
+#define IGL_PIXEL_CONVERSION_F16C 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define IGL_PIXEL_CONVERSION_NEON 1
+#include <arm_neon.h>
+#else
+#define IGL_PIXEL_CONVERSION_NEON 0
+#endif
+
+// Half precision conversion instructions are optional on 32-bit ARM
+#if IGL_PIXEL_CONVERSION_NEON && (defined(__aarch64__) || defined(_M_ARM64))
+#define IGL_PIXEL_CONVERSION_NEON_FP16 1
+#else
+#define IGL_PIXEL_CONVERSION_NEON_FP16 0
+#endif
+
+namespace igl {
+namespace {
+
+uint32_t loadUint32(const uint8_t* IGL_NONNULL src) {
+  uint32_t value = 0;
+  std::memcpy(&value, src, sizeof(value));
+  return value;
+}
+
+void storeUint32(uint8_t* IGL_NONNULL dst, uint32_t value) {
+  std::memcpy(dst, &value, sizeof(value));
+}
+
+uint16_t loadUint16(const uint8_t* IGL_NONNULL src) {
+  uint16_t value = 0;
+  std::memcpy(&value, src, sizeof(value));
+  return value;
+}
+
+void storeUint16(uint8_t* IGL_NONNULL dst, uint16_t value) {
+  std::memcpy(dst, &value, sizeof(value));
+}
+
+float asFloat(uint32_t bits) {
+  float value = 0.0f;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint32_t asUint32(float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Scalar conversions, which the SSE2 code below vectorizes. Half denormals become float normals by
+// subtracting a magic number, which keeps working when the FPU flushes float denormals to zero.
+uint32_t halfToFloatBits(uint16_t half) {
+  constexpr uint32_t kShiftedExponent = 0x7c00u << 13;
+  constexpr uint32_t kMagic = 113u << 23;
+
+  uint32_t bits = static_cast<uint32_t>(half & 0x7fffu) << 13;
+  const uint32_t exponent = bits & kShiftedExponent;
+  bits += (127u - 15u) << 23;
+  if (exponent == kShiftedExponent) {
+    // Inf and NaN
+    bits += (128u - 16u) << 23;
+  } else if (exponent == 0) {
+    // Zero and denormals
+    bits += 1u << 23;
+    bits = asUint32(asFloat(bits) - asFloat(kMagic));
+  }
+  return bits | (static_cast<uint32_t>(half & 0x8000u) << 16);
+}
+
+uint16_t floatToHalfBits(uint32_t bits) {
+  constexpr uint32_t kInfinity = 255u << 23;
+  constexpr uint32_t kHalfMax = (127u + 16u) << 23;
+  constexpr uint32_t kMinNormal = (127u - 14u) << 23;
+  constexpr uint32_t kDenormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+  const uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint32_t half = 0;
+  if (bits >= kHalfMax) {
+    // Overflows to Inf, NaN becomes a quiet NaN
+    half = bits > kInfinity ? 0x7e00u : 0x7c00u;
+  } else if (bits < kMinNormal) {
+    // The addition aligns the mantissa and rounds to nearest even
+    half = asUint32(asFloat(bits) + asFloat(kDenormalMagic)) - kDenormalMagic;
+  } else {
+    const uint32_t mantissaOdd = (bits >> 13) & 1u;
+    bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfffu + mantissaOdd;
+    half = bits >> 13;
+  }
+  return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+#if IGL_PIXEL_CONVERSION_SSE2 && !IGL_PIXEL_CONVERSION_F16C
+__m128i select(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// 4 halves in the low 16 bits of each 32-bit lane
+__m128 halfToFloatSSE2(__m128i half) {
+  const __m128i shiftedExponent = _mm_set1_epi32(0x7c00 << 13);
+  const __m128i magic = _mm_set1_epi32(113 << 23);
+
+  const __m128i expMantissa = _mm_and_si128(half, _mm_set1_epi32(0x7fff));
+  __m128i bits = _mm_slli_epi32(expMantissa, 13);
+  const __m128i exponent = _mm_and_si128(bits, shiftedExponent);
+  bits = _mm_add_epi32(bits, _mm_set1_epi32((127 - 15) << 23));
+
+  const __m128i isInfNan = _mm_cmpeq_epi32(exponent, shiftedExponent);
+  bits = _mm_add_epi32(bits, _mm_and_si128(isInfNan, _mm_set1_epi32((128 - 16) << 23)));
+
+  const __m128i isDenormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+  const __m128 renormalized = _mm_sub_ps(
+      _mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))), _mm_castsi128_ps(magic));
+  bits = select(isDenormal, _mm_castps_si128(renormalized), bits);
+
+  const __m128i sign = _mm_slli_epi32(_mm_xor_si128(half, expMantissa), 16);
+  return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+}
+
+// 4 halves in the low 16 bits of each 32-bit lane, the high bits are 0
+__m128i floatToHalfSSE2(__m128 value) {
+  const __m128i halfMax = _mm_set1_epi32((127 + 16) << 23);
+  const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+  const __m128i denormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+  const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+  const __m128i bits = _mm_castps_si128(value);
+  const __m128i sign = _mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+  const __m128i absBits = _mm_xor_si128(bits, sign);
+  const __m128 absValue = _mm_castsi128_ps(absBits);
+
+  const __m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absValue, absValue));
+  const __m128i infOrNan =
+      _mm_or_si128(_mm_and_si128(isNan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+  const __m128i isRegular = _mm_cmpgt_epi32(halfMax, absBits);
+  const __m128i isDenormal = _mm_cmpgt_epi32(minNormal, absBits);
+
+  const __m128i denormal = _mm_sub_epi32(
+      _mm_castps_si128(_mm_add_ps(absValue, _mm_castsi128_ps(denormalMagic))), denormalMagic);
+
+  // All ones when the mantissa bit which becomes the last half mantissa bit is set
+  const __m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31);
+  const __m128i normal =
+      _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absBits, normalBias), mantissaOdd), 13);
+
+  const __m128i half = select(isRegular, select(isDenormal, denormal, normal), infOrNan);
+  return _mm_or_si128(half, _mm_srli_epi32(sign, 16));
+}
+
+// Packs the low 16 bits of each 32-bit lane, SSE2 only has a signed saturating pack
+__m128i packHalves(__m128i low, __m128i high) {
+  return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(low, 16), 16),
+                         _mm_srai_epi32(_mm_slli_epi32(high, 16), 16));
+}
+#endif // IGL_PIXEL_CONVERSION_SSE2 && !IGL_PIXEL_CONVERSION_F16C
+
+void swapRedBlue8(const uint8_t* IGL_NONNULL src, uint8_t* IGL_NONNULL dst, size_t numPixels) {
+  size_t i = 0;
+#if IGL_PIXEL_CONVERSION_AVX2
+  const __m256i shuffle = _mm256_setr_epi8(
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15, //
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  for (; i + 8 <= numPixels; i += 8) {
+    const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4),
+                        _mm256_shuffle_epi8(pixels, shuffle));
+  }
+#endif // IGL_PIXEL_CONVERSION_AVX2
+#if IGL_PIXEL_CONVERSION_SSE2
+  const __m128i keepMask = _mm_set1_epi32(static_cast<int>(0xff00ff00u));
+  const __m128i lowMask = _mm_set1_epi32(0xff);
+  for (; i + 4 <= numPixels; i += 4) {
+    const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+    const __m128i red = _mm_slli_epi32(_mm_and_si128(pixels, lowMask), 16);
+    const __m128i blue = _mm_and_si128(_mm_srli_epi32(pixels, 16), lowMask);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4),
+                     _mm_or_si128(_mm_and_si128(pixels, keepMask), _mm_or_si128(red, blue)));
+  }
+#elif IGL_PIXEL_CONVERSION_NEON
+  for (; i + 16 <= numPixels; i += 16) {
+    uint8x16x4_t pixels = vld4q_u8(src + i * 4);
+    const uint8x16_t red = pixels.val[0];
+    pixels.val[0] = pixels.val[2];
+    pixels.val[2] = red;
+    vst4q_u8(dst + i * 4, pixels);
+  }
+#endif
+  for (; i < numPixels; ++i) {
+    const uint32_t pixel = loadUint32(src + i * 4);
+    storeUint32(dst + i * 4,
+                (pixel & 0xff00ff00u) | ((pixel & 0xffu) << 16) | ((pixel >> 16) & 0xffu));
+  }
+}
+
+void halfToFloat(const uint8_t* IGL_NONNULL src, uint8_t* IGL_NONNULL dst, size_t numValues) {
+  size_t i = 0;
+#if IGL_PIXEL_CONVERSION_F16C
+  for (; i + 8 <= numValues; i += 8) {
+    const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    _mm_storeu_ps(reinterpret_cast<float*>(dst + i * 4), _mm_cvtph_ps(halves));
+    _mm_storeu_ps(reinterpret_cast<float*>(dst + i * 4 + 16),
+                  _mm_cvtph_ps(_mm_unpackhi_epi64(halves, halves)));
+  }
+#elif IGL_PIXEL_CONVERSION_SSE2
+  for (; i + 8 <= numValues; i += 8) {
+    const __m128i halves = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+    const __m128i zero = _mm_setzero_si128();
+    _mm_storeu_ps(reinterpret_cast<float*>(dst + i * 4),
+                  halfToFloatSSE2(_mm_unpacklo_epi16(halves, zero)));
+    _mm_storeu_ps(reinterpret_cast<float*>(dst + i * 4 + 16),
+                  halfToFloatSSE2(_mm_unpackhi_epi16(halves, zero)));
+  }
+#elif IGL_PIXEL_CONVERSION_NEON_FP16
+  for (; i + 8 <= numValues; i += 8) {
+    const uint16x8_t halves = vld1q_u16(reinterpret_cast<const uint16_t*>(src + i * 2));
+    vst1q_f32(reinterpret_cast<float*>(dst + i * 4),
+              vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(halves))));
+    vst1q_f32(reinterpret_cast<float*>(dst + i * 4 + 16),
+              vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(halves))));
+  }
+#endif
+  for (; i < numValues; ++i) {
+    storeUint32(dst + i * 4, halfToFloatBits(loadUint16(src + i * 2)));
+  }
+}
+
+void floatToHalf(const uint8_t* IGL_NONNULL src, uint8_t* IGL_NONNULL dst, size_t numValues) {
+  size_t i = 0;
+#if IGL_PIXEL_CONVERSION_F16C
+  for (; i + 8 <= numValues; i += 8) {
+    const __m128i low = _mm_cvtps_ph(_mm_loadu_ps(reinterpret_cast<const float*>(src + i * 4)),
+                                     _MM_FROUND_TO_NEAREST_INT);
+    const __m128i high = _mm_cvtps_ph(
+        _mm_loadu_ps(reinterpret_cast<const float*>(src + i * 4 + 16)), _MM_FROUND_TO_NEAREST_INT);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm_unpacklo_epi64(low, high));
+  }
+#elif IGL_PIXEL_CONVERSION_SSE2
+  for (; i + 8 <= numValues; i += 8) {
+    const __m128i low =
+        floatToHalfSSE2(_mm_loadu_ps(reinterpret_cast<const float*>(src + i * 4)));
+    const __m128i high =
+        floatToHalfSSE2(_mm_loadu_ps(reinterpret_cast<const float*>(src + i * 4 + 16)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), packHalves(low, high));
+  }
+#elif IGL_PIXEL_CONVERSION_NEON_FP16
+  for (; i + 8 <= numValues; i += 8) {
+    const float16x4_t low = vcvt_f16_f32(vld1q_f32(reinterpret_cast<const float*>(src + i * 4)));
+    const float16x4_t high =
+        vcvt_f16_f32(vld1q_f32(reinterpret_cast<const float*>(src + i * 4 + 16)));
+    vst1q_u16(reinterpret_cast<uint16_t*>(dst + i * 2),
+              vcombine_u16(vreinterpret_u16_f16(low), vreinterpret_u16_f16(high)));
+  }
+#endif
+  for (; i < numValues; ++i) {
+    storeUint16(dst + i * 2, floatToHalfBits(loadUint32(src + i * 4)));
+  }
+}
+
+} // namespace
+
+size_t getConvertedBytes(PixelConversion conversion, size_t srcBytes) noexcept {
+  switch (conversion) {
+  case PixelConversion::None:
+  case PixelConversion::SwapRedBlue8:
+    return srcBytes;
+  case PixelConversion::HalfToFloat:
+    return srcBytes * 2;
+  case PixelConversion::FloatToHalf:
+    return srcBytes / 2;
+  }
+  IGL_UNREACHABLE_RETURN(srcBytes)
+}
+
+void convertPixels(const uint8_t* IGL_NONNULL src,
+                   uint8_t* IGL_NONNULL dst,
+                   size_t srcBytes,
+                   PixelConversion conversion) noexcept {
+  switch (conversion) {
+  case PixelConversion::None:
+    if (src != dst) {
+      std::memcpy(dst, src, srcBytes);
+    }
+    break;
+  case PixelConversion::SwapRedBlue8:
+    IGL_DEBUG_ASSERT(srcBytes % 4 == 0);
+    swapRedBlue8(src, dst, srcBytes / 4);
+    break;
+  case PixelConversion::HalfToFloat:
+    IGL_DEBUG_ASSERT(srcBytes % 2 == 0 && src != dst);
+    halfToFloat(src, dst, srcBytes / 2);
+    break;
+  case PixelConversion::FloatToHalf:
+    IGL_DEBUG_ASSERT(srcBytes % 4 == 0 && src != dst);
+    floatToHalf(src, dst, srcBytes / 4);
+    break;
+  }
+}
+
+void copyPixelRows(const uint8_t* IGL_NONNULL src,
+                   size_t srcBytesPerRow,
+                   uint8_t* IGL_NONNULL dst,
+                   size_t dstBytesPerRow,
+                   size_t srcRowBytes,
+                   size_t numRows,
+                   PixelConversion conversion,
+                   bool flipVertical) noexcept {
+  if (numRows == 0) {
+    return;
+  }
+  IGL_DEBUG_ASSERT(srcBytesPerRow >= srcRowBytes);
+  IGL_DEBUG_ASSERT(dstBytesPerRow >= getConvertedBytes(conversion, srcRowBytes));
+
+  // Tightly packed rows without a flip are a single run
+  if (!flipVertical && srcBytesPerRow == srcRowBytes &&
+      dstBytesPerRow == getConvertedBytes(conversion, srcRowBytes)) {
+    convertPixels(src, dst, srcRowBytes * numRows, conversion);
+    return;
+  }
+
+  uint8_t* dstRow = flipVertical ? dst + dstBytesPerRow * (numRows - 1) : dst;
+  const std::ptrdiff_t dstIncrement = flipVertical ? -static_cast<std::ptrdiff_t>(dstBytesPerRow)
+                                                   : static_cast<std::ptrdiff_t>(dstBytesPerRow);
+  for (size_t y = 0; y < numRows; ++y) {
+    convertPixels(src, dstRow, srcRowBytes, conversion);
+    src += srcBytesPerRow;
+    dstRow += dstIncrement;
+  }
+}
+
+} // namespace igl
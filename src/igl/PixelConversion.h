@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <igl/Common.h>
+
+namespace igl {
+
+/**
+ * @brief Conversion applied to every pixel by copyPixelRows().
+ *
+ * The conversions are vectorized with SSE2 or NEON and use wider instructions (AVX2, F16C) when
+ * the library is compiled with them enabled. Other targets use a scalar implementation which
+ * produces the same results, except for the payload of NaNs.
+ */
+enum class PixelConversion : uint8_t {
+  /// Copies the bytes unchanged
+  None,
+  /// Swaps the first and third channels of 4 x 8-bit pixels, e.g. RGBA_UNorm8 <-> BGRA_UNorm8
+  SwapRedBlue8,
+  /// Widens 16-bit floats to 32-bit floats, e.g. RGBA_F16 -> RGBA_F32
+  HalfToFloat,
+  /// Narrows 32-bit floats to 16-bit floats, rounding to nearest even, e.g. RGBA_F32 -> RGBA_F16
+  FloatToHalf,
+};
+
+/// @returns the number of bytes `conversion` writes for `srcBytes` bytes of input
+[[nodiscard]] size_t getConvertedBytes(PixelConversion conversion, size_t srcBytes) noexcept;
+
+/**
+ * @brief Converts `srcBytes` bytes of pixels from `src` to `dst`.
+ *
+ * `srcBytes` must be a multiple of the input element size (4 bytes for SwapRedBlue8 and
+ * FloatToHalf, 2 bytes for HalfToFloat). `src` and `dst` may be equal for SwapRedBlue8, otherwise
+ * they must not overlap.
+ */
+void convertPixels(const uint8_t* IGL_NONNULL src,
+                   uint8_t* IGL_NONNULL dst,
+                   size_t srcBytes,
+                   PixelConversion conversion) noexcept;
+
+/**
+ * @brief Copies `numRows` rows of `srcRowBytes` bytes from `src` to `dst` in a single pass,
+ * converting the pixels and optionally flipping the rows vertically.
+ *
+ * Rows start every `srcBytesPerRow` bytes in `src` and every `dstBytesPerRow` bytes in `dst`, which
+ * allows repacking rows with padding into tightly packed rows and vice versa. Each destination row
+ * receives getConvertedBytes(conversion, srcRowBytes) bytes; padding bytes are left untouched.
+ * When `flipVertical` is true, the first source row is written to the last destination row.
+ */
+void copyPixelRows(const uint8_t* IGL_NONNULL src,
+                   size_t srcBytesPerRow,
+                   uint8_t* IGL_NONNULL dst,
+                   size_t dstBytesPerRow,
+                   size_t srcRowBytes,
+                   size_t numRows,
+                   PixelConversion conversion = PixelConversion::None,
+                   bool flipVertical = false) noexcept;
+
+} // namespace igl
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <string>
+#include <igl/Common.h>
+#include <igl/ITrackedResource.h>
+
+namespace igl {
+
+/**
+ * @brief The kind of queries stored in an IQueryPool.
+ *
+ * Timestamp          : GPU timestamps written with writeTimestamp(). Requires
+ *                      DeviceFeatures::TimestampQueries.
+ * PipelineStatistics : Pipeline statistics counted between beginQuery() and endQuery(). Requires
+ *                      DeviceFeatures::PipelineStatisticsQueries.
+ */
+enum class QueryType : uint8_t {
+  Timestamp,
+  PipelineStatistics,
+};
+
+/**
+ * @brief Describes an IQueryPool.
+ */
+struct QueryPoolDesc {
+  QueryType type = QueryType::Timestamp;
+  /** @brief The number of queries in the pool. */
+  uint32_t queryCount = 0;
+  std::string debugName;
+};
+
+/**
+ * @brief The results of a single QueryType::PipelineStatistics query.
+ */
+struct PipelineStatistics {
+  uint64_t inputAssemblyVertices = 0;
+  uint64_t inputAssemblyPrimitives = 0;
+  uint64_t vertexShaderInvocations = 0;
+  uint64_t clippingPrimitives = 0;
+  uint64_t fragmentShaderInvocations = 0;
+  uint64_t computeShaderInvocations = 0;
+};
+
+/**
+ * @brief A pool of GPU queries.
+ *
+ * Queries are recorded with ICommandBuffer::writeTimestamp() and ICommandEncoder::writeTimestamp(),
+ * beginQuery() and endQuery(). Queries have to be reset with ICommandBuffer::resetQueries() before
+ * they are reused. Results are read back without stalling the CPU: the getters return false until
+ * all the requested queries are available, so they can be polled a few frames later.
+ */
+class IQueryPool : public ITrackedResource<IQueryPool> {
+ protected:
+  explicit IQueryPool(const QueryPoolDesc& desc) : desc_(desc) {}
+
+ public:
+  ~IQueryPool() override = default;
+
+  [[nodiscard]] const QueryPoolDesc& getDesc() const {
+    return desc_;
+  }
+
+  /**
+   * @brief Reads back timestamps of QueryType::Timestamp queries [firstQuery, firstQuery +
+   * queryCount) without blocking.
+   *
+   * Timestamps are in nanoseconds and have an arbitrary origin: only the differences between
+   * timestamps written into the same command queue are meaningful.
+   *
+   * @return true if all the results were available and written into `outNanoseconds`.
+   */
+  [[nodiscard]] virtual bool getTimestamps(uint32_t firstQuery,
+                                           uint32_t queryCount,
+                                           uint64_t* IGL_NONNULL outNanoseconds) const = 0;
+
+  /**
+   * @brief Reads back QueryType::PipelineStatistics queries [firstQuery, firstQuery + queryCount)
+   * without blocking.
+   *
+   * @return true if all the results were available and written into `outStatistics`.
+   */
+  [[nodiscard]] virtual bool getPipelineStatistics(uint32_t firstQuery,
+                                                   uint32_t queryCount,
+                                                   PipelineStatistics* IGL_NONNULL
+                                                       outStatistics) const = 0;
+
+ protected:
+  QueryPoolDesc desc_;
+};
+
+} // namespace igl
@@ -238,6 +238,15 @@ class IRenderPipelineState {
     return desc_;
   }
 
+  /**
+   * @brief Returns false while the backend is still compiling the shaders of the pipeline in the
+   * background. Binding a pipeline which is not ready waits for the compilation, so a loading
+   * screen can create many pipelines up front and poll this instead.
+   */
+  [[nodiscard]] virtual bool isReady() const {
+    return true;
+  }
+
  protected:
   const RenderPipelineDesc desc_{};
 };
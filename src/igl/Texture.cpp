@@ -10,7 +10,7 @@
 #include <cstddef>
 #include <limits>
 #include <utility>
-#include <igl/IGLSafeC.h>
+#include <igl/PixelConversion.h>
 
 size_t std::hash<igl::TextureFormat>::operator()(const igl::TextureFormat& key) const {
   return std::hash<size_t>()(static_cast<size_t>(key));
@@ -665,22 +665,16 @@ void ITexture::repackData(const TextureFormatProperties& properties,
                                                                 : repackedBytesPerRow;
     const auto totalNumLayers = mipRange.numLayers * mipRange.numFaces * mipRange.depth;
     for (size_t layer = 0; layer < totalNumLayers; ++layer) {
-      uint8_t* repackedDataPtr = repackedData;
-      const std::ptrdiff_t increment = flipVertical ? -repackedDataIncrement
-                                                    : repackedDataIncrement;
-      // Start at the end
-      if (flipVertical) {
-        repackedDataPtr += repackedDataIncrement * (mipRange.height - 1);
-      }
-      for (size_t y = 0; y < mipRange.height; ++y) {
-        checked_memcpy_robust(repackedDataPtr,
-                              repackedDataIncrement,
-                              originalData,
-                              originalDataIncrement,
-                              rangeBytesPerRow);
-        repackedDataPtr += increment;
-        originalData += originalDataIncrement;
-      }
+      // Repacks and flips in a single pass, tightly packed layers are copied at once
+      copyPixelRows(originalData,
+                    originalDataIncrement,
+                    repackedData,
+                    repackedDataIncrement,
+                    rangeBytesPerRow,
+                    mipRange.height,
+                    PixelConversion::None,
+                    flipVertical);
+      originalData += originalDataIncrement * mipRange.height;
       repackedData += repackedDataIncrement * mipRange.height;
     }
   }
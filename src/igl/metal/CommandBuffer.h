@@ -45,6 +45,9 @@ class CommandBuffer final : public ICommandBuffer,
                            uint32_t level,
                            uint32_t layer) override;
 
+  void resetQueries(IQueryPool& pool, uint32_t firstQuery, uint32_t queryCount) override;
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+
   void waitUntilScheduled() override;
 
   void waitUntilCompleted() override;
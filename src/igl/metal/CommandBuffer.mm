@@ -85,6 +85,16 @@ void CommandBuffer::copyTextureToBuffer(ITexture& src,
   IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
 }
 
+void CommandBuffer::resetQueries(IQueryPool& /*pool*/,
+                                 uint32_t /*firstQuery*/,
+                                 uint32_t /*queryCount*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void CommandBuffer::writeTimestamp(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
 void CommandBuffer::waitUntilScheduled() {
   [value_ waitUntilScheduled];
 }
@@ -48,6 +48,18 @@ void ComputeCommandEncoder::popDebugGroupLabel() const {
   [encoder_ popDebugGroup];
 }
 
+void ComputeCommandEncoder::writeTimestamp(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void ComputeCommandEncoder::beginQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void ComputeCommandEncoder::endQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
 void ComputeCommandEncoder::bindComputePipelineState(
     const std::shared_ptr<IComputePipelineState>& pipelineState) {
   if (pipelineState) {
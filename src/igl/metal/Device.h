@@ -79,6 +79,10 @@ class Device : public IDevice {
   std::unique_ptr<IShaderStages> createShaderStages(const ShaderStagesDesc& desc,
                                                     Result* IGL_NULLABLE outResult) const override;
 
+  // Queries
+  std::shared_ptr<IQueryPool> createQueryPool(const QueryPoolDesc& desc,
+                                              Result* IGL_NULLABLE outResult) const override;
+
   // Platform-specific extensions
   [[nodiscard]] const PlatformDevice& getPlatformDevice() const noexcept override;
 
@@ -561,6 +561,12 @@ std::shared_ptr<IShaderModule> Device::createShaderModule(const ShaderModuleDesc
   return nullptr;
 }
 
+std::shared_ptr<IQueryPool> Device::createQueryPool(const QueryPoolDesc& /*desc*/,
+                                                    Result* outResult) const {
+  Result::setResult(outResult, Result::Code::Unimplemented, "Query pools are not implemented");
+  return nullptr;
+}
+
 std::unique_ptr<IShaderStages> Device::createShaderStages(const ShaderStagesDesc& desc,
                                                           Result* outResult) const {
   const Result result;
@@ -206,6 +206,9 @@ bool DeviceFeatureSet::hasFeature(DeviceFeatures feature) const {
     return false;
   case DeviceFeatures::TextureViews:
     return false;
+  case DeviceFeatures::TimestampQueries:
+  case DeviceFeatures::PipelineStatisticsQueries:
+    return false;
   }
   return false;
 }
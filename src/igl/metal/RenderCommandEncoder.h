@@ -33,6 +33,10 @@ class RenderCommandEncoder final : public IRenderCommandEncoder {
   void insertDebugEventLabel(const char* label, const igl::Color& color) const override;
   void popDebugGroupLabel() const override;
 
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+  void beginQuery(IQueryPool& pool, uint32_t query) override;
+  void endQuery(IQueryPool& pool, uint32_t query) override;
+
   void bindViewport(const Viewport& viewport) override;
   void bindScissorRect(const ScissorRect& rect) override;
 
@@ -161,6 +161,18 @@ void RenderCommandEncoder::popDebugGroupLabel() const {
   [encoder_ popDebugGroup];
 }
 
+void RenderCommandEncoder::writeTimestamp(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RenderCommandEncoder::beginQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RenderCommandEncoder::endQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
 void RenderCommandEncoder::bindViewport(const Viewport& viewport) {
   IGL_DEBUG_ASSERT(encoder_);
   const MTLViewport metalViewport = {viewport.x,
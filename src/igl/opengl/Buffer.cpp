@@ -7,11 +7,23 @@
 
 #include <igl/opengl/Buffer.h>
 
+#include <cstring>
 #include <igl/Buffer.h>
 #include <igl/DeviceFeatures.h>
 
 namespace igl::opengl {
 
+namespace {
+
+// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT is at most 256, so every slot can be bound as a uniform
+// block
+constexpr size_t kStreamingSlotAlignment = 256;
+constexpr GLuint64 kStreamingWaitTimeoutNs = 1000000; // 1 ms
+// a slot which is still not released by then is assumed to belong to a lost context or a hung GPU
+constexpr GLuint64 kStreamingMaxWaitNs = 1000000000; // 1 s
+
+} // namespace
+
 // ********************************
 // ****  ArrayBuffer
 // ********************************
@@ -26,6 +38,14 @@ ArrayBuffer::ArrayBuffer(IContext& context,
 }
 
 ArrayBuffer::~ArrayBuffer() {
+  for (GLsync& sync : streamingSyncs_) {
+    if (sync) {
+      getContext().deleteSync(sync);
+      sync = nullptr;
+    }
+  }
+  // deleting the buffer also unmaps the streaming memory
+  streamingData_ = nullptr;
   if (iD_ != 0) {
     getContext().deleteBuffers(1, &iD_);
     getContext().unbindBuffer(target_);
@@ -81,15 +101,37 @@ void ArrayBuffer::initialize(const BufferDesc& desc, Result* outResult) {
   } else if (desc.type & BufferDesc::BufferTypeBits::Index) {
     target_ = GL_ELEMENT_ARRAY_BUFFER;
   } else if (desc.type & BufferDesc::BufferTypeBits::Indirect) {
-    target_ = GL_DRAW_INDIRECT_BUFFER;
+    // without indirect draws the commands are read on the CPU, see getIndirectCommands()
+    emulatesIndirect_ =
+        !getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DrawArraysIndirect);
+    target_ = emulatesIndirect_ ? GL_ARRAY_BUFFER : GL_DRAW_INDIRECT_BUFFER;
   } else {
     IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
   }
 
   size_ = desc.length;
 
+  const bool streaming = canStream(desc);
+  size_t storageSize = size_;
+
   getContext().bindBuffer(target_, iD_);
-  getContext().bufferData(target_, size_, desc.data, usage);
+  if (streaming) {
+    // immutable storage which stays mapped, with a slot for each draw the GPU may still read
+    streamingSlotStride_ = (size_ + kStreamingSlotAlignment - 1) & ~(kStreamingSlotAlignment - 1);
+    storageSize = streamingSlotStride_ * kNumStreamingSlots;
+    // map() hands out the mapped memory, which may be read
+    const GLbitfield flags =
+        GL_MAP_READ_BIT | GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    // glBufferSubData() writes slots whose fence timed out, see waitForStreamingSlot()
+    getContext().bufferStorage(target_,
+                               static_cast<GLsizeiptr>(storageSize),
+                               nullptr,
+                               flags | GL_DYNAMIC_STORAGE_BIT);
+    streamingData_ = static_cast<uint8_t*>(
+        getContext().mapBufferRange(target_, 0, static_cast<GLsizeiptr>(storageSize), flags));
+  } else {
+    getContext().bufferData(target_, size_, desc.data, usage);
+  }
 
   // make sure the buffer was fully allocated
   GLint bufferSize = 0;
@@ -106,16 +148,51 @@ void ArrayBuffer::initialize(const BufferDesc& desc, Result* outResult) {
 
   getContext().bindBuffer(target_, 0);
 
-  if (bufferSize != size_) {
+  if (streaming && streamingData_ == nullptr) {
     getContext().deleteBuffers(1, &iD_);
     iD_ = 0;
+    Result::setResult(outResult, Result::Code::RuntimeError, "Failed to map streaming buffer");
+    return;
+  }
+
+  if (static_cast<size_t>(bufferSize) != storageSize) {
+    getContext().deleteBuffers(1, &iD_);
+    iD_ = 0;
+    streamingData_ = nullptr;
     Result::setResult(outResult, Result::Code::ArgumentOutOfRange, "bufferSize != dataSize");
     return;
   }
 
+  if (streamingData_) {
+    streamingWritableRange_ = BufferRange(size_, 0);
+    if (desc.data) {
+      memcpy(streamingData_, desc.data, size_);
+    }
+  }
+
+  if (emulatesIndirect_) {
+    indirectCommands_.assign(size_, 0);
+    if (desc.data) {
+      memcpy(indirectCommands_.data(), desc.data, size_);
+    }
+  }
+
   Result::setOk(outResult);
 }
 
+bool ArrayBuffer::canStream(const BufferDesc& desc) const {
+  if ((desc.hint & BufferDesc::BufferAPIHintBits::Streaming) == 0 || !isDynamic_ || size_ == 0) {
+    return false;
+  }
+  // index and indirect buffers are read at offsets which are not known to the buffer
+  if (target_ != GL_ARRAY_BUFFER && target_ != GL_UNIFORM_BUFFER) {
+    return false;
+  }
+  const auto& features = getContext().deviceFeatures();
+  return features.hasInternalFeature(InternalFeatures::BufferStorage) &&
+         features.hasInternalFeature(InternalFeatures::Sync);
+}
+
 // upload data to the buffer at the given offset with the given size
 Result ArrayBuffer::upload(const void* data, const BufferRange& range) {
   // static buffers can only upload data once during creation
@@ -123,6 +200,21 @@ Result ArrayBuffer::upload(const void* data, const BufferRange& range) {
     return Result(Result::Code::InvalidOperation, "Can't upload to static buffers");
   }
 
+  if (streamingData_) {
+    if (!IGL_DEBUG_VERIFY(range.offset + range.size <= size_)) {
+      return Result(Result::Code::ArgumentOutOfRange, "upload() size + offset must be <= size");
+    }
+    uploadStreaming(data, range);
+    return Result();
+  }
+
+  if (emulatesIndirect_) {
+    if (!IGL_DEBUG_VERIFY(range.offset + range.size <= size_)) {
+      return Result(Result::Code::ArgumentOutOfRange, "upload() size + offset must be <= size");
+    }
+    memcpy(indirectCommands_.data() + range.offset, data, range.size);
+  }
+
   getContext().bindBuffer(target_, iD_);
 
   getContext().bufferSubData(target_, range.offset, range.size, data);
@@ -132,6 +224,116 @@ Result ArrayBuffer::upload(const void* data, const BufferRange& range) {
   return Result();
 }
 
+void ArrayBuffer::uploadStreaming(const void* data, const BufferRange& range) {
+  // the GPU may read the current slot, or a pending copy from the previous slot writes to the range
+  if (streamingSlotUsed_ || (streamingSlotSynced_ && !isStreamingRangeWritable(range))) {
+    switchStreamingSlot(range, false);
+  }
+  streamingStats_.uploads++;
+  if (range.size == 0) {
+    return;
+  }
+  const size_t offset = getStreamingOffset() + range.offset;
+  if (streamingSlotSynced_) {
+    memcpy(streamingData_ + offset, data, range.size);
+    return;
+  }
+  // glBufferSubData() is ordered after the draws which may still read the slot
+  getContext().bindBuffer(target_, iD_);
+  getContext().bufferSubData(target_, offset, range.size, data);
+  getContext().bindBuffer(target_, 0);
+}
+
+void* ArrayBuffer::mapStreaming(const BufferRange& range, Result* outResult) {
+  if (streamingSlotSynced_ && !isStreamingRangeWritable(range)) {
+    // the previous contents of the range are written by a pending copy, which has to finish before
+    // the CPU reads them
+    streamingSyncs_[streamingSlot_] = getContext().fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    streamingSlotSynced_ = waitForStreamingSlot();
+    streamingWritableRange_ = BufferRange(size_, 0);
+  }
+  if (streamingSlotUsed_) {
+    switchStreamingSlot(range, true);
+  }
+  if (!streamingSlotSynced_) {
+    Result::setResult(
+        outResult, Result::Code::RuntimeError, "Timed out waiting for a streaming buffer slot");
+    return nullptr;
+  }
+  Result::setOk(outResult);
+  return streamingData_ + getStreamingOffset() + range.offset;
+}
+
+void ArrayBuffer::switchStreamingSlot(const BufferRange& range, bool keepRange) {
+  auto& context = getContext();
+  const size_t previousOffset = getStreamingOffset();
+  // the draws which read the slot and the copies which write to it were issued before this fence
+  streamingSyncs_[streamingSlot_] = context.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  streamingSlot_ = (streamingSlot_ + 1) % kNumStreamingSlots;
+  streamingSlotUsed_ = false;
+  streamingStats_.slotSwitches++;
+  streamingSlotSynced_ = waitForStreamingSlot();
+
+  // the rest of the contents is carried over on the GPU, so mapped memory is not read back
+  copyStreaming(previousOffset, 0, range.offset);
+  copyStreaming(previousOffset, range.offset + range.size, size_ - range.offset - range.size);
+  if (!keepRange) {
+    streamingWritableRange_ = range;
+  } else if (streamingSlotSynced_) {
+    // map() returns the current contents of the range
+    memcpy(streamingData_ + getStreamingOffset() + range.offset,
+           streamingData_ + previousOffset + range.offset,
+           range.size);
+    streamingWritableRange_ = range;
+  } else {
+    copyStreaming(previousOffset, range.offset, range.size);
+    streamingWritableRange_ = BufferRange();
+  }
+  if (streamingWritableRange_.size == size_) {
+    streamingWritableRange_ = BufferRange(size_, 0);
+  }
+}
+
+bool ArrayBuffer::waitForStreamingSlot() {
+  auto& context = getContext();
+  GLsync& sync = streamingSyncs_[streamingSlot_];
+  if (!sync) {
+    return true;
+  }
+  GLenum status = context.clientWaitSync(sync, 0, 0);
+  if (status == GL_TIMEOUT_EXPIRED) {
+    streamingStats_.waits++;
+    GLuint64 waitedNs = 0;
+    do {
+      status = context.clientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, kStreamingWaitTimeoutNs);
+      waitedNs += kStreamingWaitTimeoutNs;
+    } while (status == GL_TIMEOUT_EXPIRED && waitedNs < kStreamingMaxWaitNs);
+  }
+  context.deleteSync(sync);
+  sync = nullptr;
+  if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) {
+    IGL_LOG_ERROR("Timed out waiting for a streaming buffer slot, using glBufferSubData()\n");
+    streamingStats_.failedWaits++;
+    return false;
+  }
+  return true;
+}
+
+void ArrayBuffer::copyStreaming(size_t srcOffset, size_t offset, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  auto& context = getContext();
+  context.bindBuffer(target_, iD_);
+  context.copyBufferSubData(target_,
+                            target_,
+                            static_cast<GLintptr>(srcOffset + offset),
+                            static_cast<GLintptr>(getStreamingOffset() + offset),
+                            static_cast<GLsizeiptr>(size));
+  context.bindBuffer(target_, 0);
+  streamingStats_.copiedBytes += size;
+}
+
 void* ArrayBuffer::map(const BufferRange& range, Result* outResult) {
   if ((range.size + range.offset) > getSizeInBytes()) {
     Result::setResult(
@@ -139,6 +341,15 @@ void* ArrayBuffer::map(const BufferRange& range, Result* outResult) {
     return nullptr;
   }
 
+  if (streamingData_) {
+    return mapStreaming(range, outResult);
+  }
+  if (emulatesIndirect_) {
+    // contexts without indirect draws may not have glMapBufferRange() either
+    Result::setOk(outResult);
+    return indirectCommands_.data() + range.offset;
+  }
+
   bind();
 
   void* srcData = nullptr;
@@ -154,6 +365,10 @@ void* ArrayBuffer::map(const BufferRange& range, Result* outResult) {
 }
 
 void ArrayBuffer::unmap() {
+  if (streamingData_ || emulatesIndirect_) {
+    // the streaming memory stays mapped and is coherent
+    return;
+  }
   bind();
   getContext().unmapBuffer(target_);
 }
@@ -195,7 +410,12 @@ void UniformBlockBuffer::bindBase(size_t index, Result* outResult) {
       Result::setResult(outResult, Result::Code::InvalidOperation, kErrorMsg);
       return;
     }
-    getContext().bindBufferBase(target_, (GLuint)index, iD_);
+    if (isStreaming()) {
+      getContext().bindBufferRange(
+          target_, (GLuint)index, iD_, (GLintptr)useStreamingSlot(), getSizeInBytes());
+    } else {
+      getContext().bindBufferBase(target_, (GLuint)index, iD_);
+    }
     Result::setOk(outResult);
   } else {
     static const char* kErrorMsg = "Uniform Blocks are not supported";
@@ -218,8 +438,11 @@ void UniformBlockBuffer::bindRange(size_t index, size_t offset, size_t size, Res
                      offset,
                      size,
                      getSizeInBytes());
-    getContext().bindBufferRange(
-        target_, (GLuint)index, iD_, (GLintptr)offset, size ? size : getSizeInBytes() - offset);
+    getContext().bindBufferRange(target_,
+                                 (GLuint)index,
+                                 iD_,
+                                 (GLintptr)(offset + useStreamingSlot()),
+                                 size ? size : getSizeInBytes() - offset);
     Result::setOk(outResult);
   } else {
     static const char* kErrorMsg = "Uniform Blocks are not supported";
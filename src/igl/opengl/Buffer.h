@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
 #include <igl/Buffer.h>
 #include <igl/Shader.h>
 #include <igl/opengl/GLIncludes.h>
@@ -49,6 +51,24 @@ class Buffer : public WithContext, public IBuffer {
 
 class ArrayBuffer : public Buffer {
  public:
+  // number of copies of the contents of a streaming buffer, i.e. draws which the GPU may read
+  // while the CPU writes the next copy (see BufferDesc::BufferAPIHintBits::Streaming)
+  static constexpr size_t kNumStreamingSlots = 4;
+
+  struct StreamingStats {
+    uint64_t uploads = 0;
+    // uploads and maps which fenced the current slot and moved to the next one, because the GPU may
+    // still read the current one
+    uint64_t slotSwitches = 0;
+    // slot switches which had to wait for the GPU to release the next slot
+    uint64_t waits = 0;
+    // waits which timed out or failed, after which the slot is written with glBufferSubData()
+    // until the next slot switch
+    uint64_t failedWaits = 0;
+    // bytes which a slot switch copied from the previous slot with glCopyBufferSubData()
+    uint64_t copiedBytes = 0;
+  };
+
   ArrayBuffer(IContext& context,
               BufferDesc::BufferAPIHint requestedApiHints,
               BufferDesc::BufferType bufferType);
@@ -60,7 +80,7 @@ class ArrayBuffer : public Buffer {
   void unmap() override;
 
   [[nodiscard]] BufferDesc::BufferAPIHint acceptedApiHints() const noexcept override {
-    return 0;
+    return isStreaming() ? BufferDesc::BufferAPIHintBits::Streaming : 0;
   }
 
   [[nodiscard]] ResourceStorage storage() const noexcept override {
@@ -92,6 +112,31 @@ class ArrayBuffer : public Buffer {
     return Type::Attribute;
   }
 
+  /// @brief True if the buffer accepted BufferDesc::BufferAPIHintBits::Streaming. Its contents are
+  /// written to persistently mapped memory, and every draw reads them at useStreamingSlot().
+  [[nodiscard]] bool isStreaming() const noexcept {
+    return streamingData_ != nullptr;
+  }
+
+  /// @brief Returns the offset of the current contents, which has to be added to every offset into
+  /// the buffer when it is bound for a draw. The contents are marked as read by the GPU, so the
+  /// next upload() or map() moves them to the next slot. Returns 0 for other buffers.
+  size_t useStreamingSlot() noexcept {
+    streamingSlotUsed_ = true;
+    return getStreamingOffset();
+  }
+
+  [[nodiscard]] const StreamingStats& getStreamingStats() const {
+    return streamingStats_;
+  }
+
+  /// @brief The contents of an indirect buffer on contexts without indirect draws, whose commands
+  /// are issued from the CPU (see RenderCommandAdapter::multiDrawArraysIndirect()). Returns
+  /// nullptr for other buffers.
+  [[nodiscard]] const uint8_t* IGL_NULLABLE getIndirectCommands() const noexcept {
+    return emulatesIndirect_ ? indirectCommands_.data() : nullptr;
+  }
+
  protected:
   // the GL ID for this texture
   GLuint iD_;
@@ -101,9 +146,45 @@ class ArrayBuffer : public Buffer {
   GLenum target_{};
 
  private:
+  [[nodiscard]] bool canStream(const BufferDesc& desc) const;
+  void uploadStreaming(const void* data, const BufferRange& range);
+  [[nodiscard]] void* IGL_NULLABLE mapStreaming(const BufferRange& range, Result* outResult);
+  // fences the current slot and moves to the next one, which gets the contents of the previous
+  // slot outside of `range`; the contents inside of it are copied too if `keepRange` is true
+  void switchStreamingSlot(const BufferRange& range, bool keepRange);
+  // returns false if the wait for the current slot timed out or failed
+  [[nodiscard]] bool waitForStreamingSlot();
+  void copyStreaming(size_t srcOffset, size_t offset, size_t size);
+  // true if the CPU may write `range` of the current slot, i.e. no pending copy writes to it
+  [[nodiscard]] bool isStreamingRangeWritable(const BufferRange& range) const noexcept {
+    return range.offset >= streamingWritableRange_.offset &&
+           range.offset + range.size <=
+               streamingWritableRange_.offset + streamingWritableRange_.size;
+  }
+  [[nodiscard]] size_t getStreamingOffset() const noexcept {
+    return streamingSlot_ * streamingSlotStride_;
+  }
+
   size_t size_;
 
   bool isDynamic_;
+
+  // only used by streaming buffers, whose storage holds kNumStreamingSlots copies of the contents
+  uint8_t* IGL_NULLABLE streamingData_ = nullptr;
+  // fences the slots which may still be read by the GPU, set when the CPU moves to the next slot
+  std::array<GLsync, kNumStreamingSlots> streamingSyncs_{};
+  size_t streamingSlotStride_ = 0;
+  size_t streamingSlot_ = 0;
+  bool streamingSlotUsed_ = false;
+  // false if the GPU may still read the current slot, see StreamingStats::failedWaits
+  bool streamingSlotSynced_ = true;
+  // the part of the current slot which is not written by a pending glCopyBufferSubData()
+  BufferRange streamingWritableRange_;
+  StreamingStats streamingStats_;
+
+  // only used by indirect buffers on contexts without indirect draws
+  bool emulatesIndirect_ = false;
+  std::vector<uint8_t> indirectCommands_;
 };
 
 class UniformBlockBuffer : public ArrayBuffer {
@@ -122,7 +203,8 @@ class UniformBlockBuffer : public ArrayBuffer {
   void bindRange(size_t index, size_t offset, size_t size, Result* outResult);
 
   [[nodiscard]] BufferDesc::BufferAPIHint acceptedApiHints() const noexcept override {
-    return BufferDesc::BufferAPIHintBits::UniformBlock;
+    return static_cast<BufferDesc::BufferAPIHint>(BufferDesc::BufferAPIHintBits::UniformBlock |
+                                                  ArrayBuffer::acceptedApiHints());
   }
 };
 
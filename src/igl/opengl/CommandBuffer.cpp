@@ -8,14 +8,22 @@
 #include <igl/opengl/CommandBuffer.h>
 
 #include <igl/opengl/Buffer.h>
+#include <igl/opengl/CommandStream.h>
 #include <igl/opengl/ComputeCommandEncoder.h>
 #include <igl/opengl/IContext.h>
+#include <igl/opengl/QueryPool.h>
+#include <igl/opengl/RecordingComputeCommandEncoder.h>
+#include <igl/opengl/RecordingRenderCommandEncoder.h>
 #include <igl/opengl/RenderCommandEncoder.h>
 
 namespace igl::opengl {
 
-CommandBuffer::CommandBuffer(std::shared_ptr<IContext> context, CommandBufferDesc desc) :
-  ICommandBuffer(std::move(desc)), context_(std::move(context)) {}
+CommandBuffer::CommandBuffer(std::shared_ptr<IContext> context,
+                             CommandBufferDesc desc,
+                             bool isRecording) :
+  ICommandBuffer(std::move(desc)),
+  context_(std::move(context)),
+  commandStream_(isRecording ? std::make_unique<CommandStream>() : nullptr) {}
 
 CommandBuffer::~CommandBuffer() = default;
 
@@ -24,15 +32,31 @@ std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder
     const std::shared_ptr<IFramebuffer>& framebuffer,
     const Dependencies& dependencies,
     Result* outResult) {
+  if (commandStream_) {
+    if (!framebuffer) {
+      Result::setResult(outResult, Result::Code::ArgumentNull, "framebuffer was null");
+      return nullptr;
+    }
+    Result::setOk(outResult);
+    return std::make_unique<RecordingRenderCommandEncoder>(
+        shared_from_this(), *commandStream_, renderPass, framebuffer, dependencies);
+  }
   return RenderCommandEncoder::create(
       shared_from_this(), renderPass, framebuffer, dependencies, outResult);
 }
 
 std::unique_ptr<IComputeCommandEncoder> CommandBuffer::createComputeCommandEncoder() {
+  if (commandStream_) {
+    return std::make_unique<RecordingComputeCommandEncoder>(*commandStream_);
+  }
   return std::make_unique<ComputeCommandEncoder>(shared_from_this()->getContext());
 }
 
 void CommandBuffer::present(const std::shared_ptr<ITexture>& surface) const {
+  if (commandStream_) {
+    commandStream_->record(CommandStream::Present{surface});
+    return;
+  }
   context_->present(surface);
 }
 
@@ -46,6 +70,10 @@ void CommandBuffer::waitUntilCompleted() {
 
 void CommandBuffer::pushDebugGroupLabel(const char* label, const igl::Color& /*color*/) const {
   IGL_DEBUG_ASSERT(label != nullptr && *label);
+  if (commandStream_) {
+    commandStream_->pushDebugGroup(label);
+    return;
+  }
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DebugMessage)) {
     getContext().pushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, label);
   } else {
@@ -54,6 +82,10 @@ void CommandBuffer::pushDebugGroupLabel(const char* label, const igl::Color& /*c
 }
 
 void CommandBuffer::popDebugGroupLabel() const {
+  if (commandStream_) {
+    commandStream_->record(CommandStream::PopDebugGroup{});
+    return;
+  }
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DebugMessage)) {
     getContext().popDebugGroup();
   } else {
@@ -66,6 +98,10 @@ void CommandBuffer::copyBuffer(IBuffer& src,
                                uint64_t srcOffset,
                                uint64_t dstOffset,
                                uint64_t size) {
+  if (commandStream_) {
+    commandStream_->record(CommandStream::CopyBuffer{&src, &dst, srcOffset, dstOffset, size});
+    return;
+  }
   IContext& ctx = getContext();
 
   if (!ctx.deviceFeatures().hasFeature(igl::DeviceFeatures::CopyBuffer)) {
@@ -96,8 +132,34 @@ void CommandBuffer::copyTextureToBuffer(ITexture& src,
   IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
 }
 
+void CommandBuffer::resetQueries(IQueryPool& /*pool*/,
+                                 uint32_t /*firstQuery*/,
+                                 uint32_t /*queryCount*/) {}
+
+void CommandBuffer::writeTimestamp(IQueryPool& pool, uint32_t query) {
+  if (commandStream_) {
+    commandStream_->record(CommandStream::WriteTimestamp{&pool, query});
+    return;
+  }
+  static_cast<QueryPool&>(pool).writeTimestamp(query);
+}
+
 IContext& CommandBuffer::getContext() const {
   return *context_;
 }
 
+size_t CommandBuffer::getNumRecordedCommands() const {
+  return commandStream_ ? commandStream_->size() : 0;
+}
+
+void CommandBuffer::replayRecordedCommands() {
+  if (!commandStream_ || commandStream_->empty()) {
+    return;
+  }
+  // detach the stream so the encoders created during the replay issue GL calls immediately
+  auto stream = std::move(commandStream_);
+  stream->replay(shared_from_this());
+  commandStream_ = std::move(stream);
+}
+
 } // namespace igl::opengl
@@ -10,12 +10,17 @@
 #include <igl/CommandBuffer.h>
 
 namespace igl::opengl {
+class CommandStream;
 class IContext;
 
 class CommandBuffer final : public ICommandBuffer,
                             public std::enable_shared_from_this<CommandBuffer> {
  public:
-  explicit CommandBuffer(std::shared_ptr<IContext> context, CommandBufferDesc desc);
+  /// @param isRecording If true, encoders record commands into a CommandStream, which is replayed
+  /// when the command buffer is submitted (see CommandQueue::setCommandRecordingEnabled())
+  explicit CommandBuffer(std::shared_ptr<IContext> context,
+                         CommandBufferDesc desc,
+                         bool isRecording = false);
   ~CommandBuffer() override;
 
   std::unique_ptr<IRenderCommandEncoder> createRenderCommandEncoder(
@@ -48,10 +53,25 @@ class CommandBuffer final : public ICommandBuffer,
                            uint32_t level,
                            uint32_t layer) override;
 
+  /// @brief No-op: OpenGL queries do not have to be reset before they are reused
+  void resetQueries(IQueryPool& pool, uint32_t firstQuery, uint32_t queryCount) override;
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+
   IContext& getContext() const;
 
+  [[nodiscard]] bool isRecording() const {
+    return commandStream_ != nullptr;
+  }
+  /// @brief The number of recorded commands which have not been replayed yet
+  [[nodiscard]] size_t getNumRecordedCommands() const;
+  /// @brief Issues the recorded commands to GL. Called by CommandQueue::submit() on the thread
+  /// which owns the context
+  void replayRecordedCommands();
+
  private:
   std::shared_ptr<IContext> context_;
+  // null in the immediate mode
+  std::unique_ptr<CommandStream> commandStream_;
 };
 
 } // namespace igl::opengl
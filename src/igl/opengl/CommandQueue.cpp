@@ -26,7 +26,8 @@ std::shared_ptr<ICommandBuffer> CommandQueue::createCommandBuffer(const CommandB
     return nullptr;
   }
 
-  auto commandBuffer = std::make_shared<CommandBuffer>(context_, desc);
+  auto commandBuffer =
+      std::make_shared<CommandBuffer>(context_, desc, isCommandRecordingEnabled_.load());
   activeCommandBuffers_++;
   Result::setOk(outResult);
 
@@ -34,7 +35,9 @@ std::shared_ptr<ICommandBuffer> CommandQueue::createCommandBuffer(const CommandB
 }
 
 SubmitHandle CommandQueue::submit(const ICommandBuffer& commandBuffer, bool /* endOfFrame */) {
-  const auto& cb = static_cast<const CommandBuffer&>(commandBuffer);
+  auto& cb = const_cast<CommandBuffer&>(static_cast<const CommandBuffer&>(commandBuffer));
+  // draws are counted when they are replayed
+  cb.replayRecordedCommands();
   incrementDrawCount(cb.getCurrentDrawCount());
 
   activeCommandBuffers_--;
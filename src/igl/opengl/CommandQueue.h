@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <igl/CommandQueue.h>
 
 namespace igl::opengl {
@@ -20,9 +21,22 @@ class CommandQueue final : public ICommandQueue {
 
   void setInitialContext(const std::shared_ptr<IContext>& context);
 
+  /** Enables the deferred recording mode for command buffers created afterwards. Their encoders
+   * record commands instead of issuing GL calls, so they can be used on any thread. The recorded
+   * commands are issued by submit(), which still has to be called on the thread owning the
+   * context. Disabled by default.
+   */
+  void setCommandRecordingEnabled(bool enabled) {
+    isCommandRecordingEnabled_ = enabled;
+  }
+  [[nodiscard]] bool isCommandRecordingEnabled() const {
+    return isCommandRecordingEnabled_;
+  }
+
  private:
   std::shared_ptr<IContext> context_;
-  uint32_t activeCommandBuffers_ = 0;
+  std::atomic<uint32_t> activeCommandBuffers_ = 0;
+  std::atomic<bool> isCommandRecordingEnabled_ = false;
 };
 
 } // namespace igl::opengl
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/CommandStream.h>
+
+#include <igl/ComputeCommandEncoder.h>
+#include <igl/RenderCommandEncoder.h>
+#include <igl/opengl/CommandBuffer.h>
+
+namespace igl::opengl {
+
+namespace {
+
+// Forwards the recorded commands to the encoders of `commandBuffer`. Commands outside of a pass go
+// to the command buffer itself.
+class Replayer final {
+ public:
+  Replayer(const std::shared_ptr<CommandBuffer>& commandBuffer,
+           const std::vector<RenderPassDesc>& renderPasses,
+           const std::vector<std::string>& labels,
+           const std::vector<UniformDesc>& uniforms,
+           const std::vector<uint8_t>& uniformData,
+           const std::vector<uint32_t>& dynamicOffsets,
+           const std::vector<Dependencies>& dependencies) :
+    commandBuffer_(commandBuffer),
+    renderPasses_(renderPasses),
+    labels_(labels),
+    uniforms_(uniforms),
+    uniformData_(uniformData),
+    dynamicOffsets_(dynamicOffsets),
+    dependencies_(dependencies) {}
+
+  [[nodiscard]] bool hasOpenPass() const {
+    return render_ || compute_;
+  }
+
+  void operator()(const CommandStream::BeginRenderPass& cmd) {
+    Result result;
+    render_ = commandBuffer_->createRenderCommandEncoder(
+        renderPasses_[cmd.renderPass], cmd.framebuffer, getDependencies(cmd.dependencies), &result);
+    if (!result.isOk()) {
+      IGL_LOG_ERROR("Cannot replay a render pass: %s\n", result.message.c_str());
+      render_ = nullptr;
+    }
+  }
+  void operator()(const CommandStream::EndRenderPass& /*cmd*/) {
+    if (render_) {
+      render_->endEncoding();
+      render_ = nullptr;
+    }
+  }
+  void operator()(const CommandStream::BeginComputePass& /*cmd*/) {
+    compute_ = commandBuffer_->createComputeCommandEncoder();
+  }
+  void operator()(const CommandStream::EndComputePass& /*cmd*/) {
+    if (compute_) {
+      compute_->endEncoding();
+      compute_ = nullptr;
+    }
+  }
+  void operator()(const CommandStream::PushDebugGroup& cmd) {
+    const char* label = labels_[cmd.label].c_str();
+    if (render_) {
+      render_->pushDebugGroupLabel(label);
+    } else if (compute_) {
+      compute_->pushDebugGroupLabel(label);
+    } else {
+      commandBuffer_->pushDebugGroupLabel(label, Color(1, 1, 1, 1));
+    }
+  }
+  void operator()(const CommandStream::InsertDebugEvent& cmd) {
+    const char* label = labels_[cmd.label].c_str();
+    if (render_) {
+      render_->insertDebugEventLabel(label);
+    } else if (compute_) {
+      compute_->insertDebugEventLabel(label);
+    }
+  }
+  void operator()(const CommandStream::PopDebugGroup& /*cmd*/) {
+    if (render_) {
+      render_->popDebugGroupLabel();
+    } else if (compute_) {
+      compute_->popDebugGroupLabel();
+    } else {
+      commandBuffer_->popDebugGroupLabel();
+    }
+  }
+  void operator()(const CommandStream::WriteTimestamp& cmd) {
+    if (render_) {
+      render_->writeTimestamp(*cmd.pool, cmd.query);
+    } else if (compute_) {
+      compute_->writeTimestamp(*cmd.pool, cmd.query);
+    } else {
+      commandBuffer_->writeTimestamp(*cmd.pool, cmd.query);
+    }
+  }
+  void operator()(const CommandStream::BindViewport& cmd) {
+    if (render_) {
+      render_->bindViewport(cmd.viewport);
+    }
+  }
+  void operator()(const CommandStream::BindScissorRect& cmd) {
+    if (render_) {
+      render_->bindScissorRect(cmd.rect);
+    }
+  }
+  void operator()(const CommandStream::BindRenderPipelineState& cmd) {
+    if (render_) {
+      render_->bindRenderPipelineState(cmd.pipelineState);
+    }
+  }
+  void operator()(const CommandStream::BindComputePipelineState& cmd) {
+    if (compute_) {
+      compute_->bindComputePipelineState(cmd.pipelineState);
+    }
+  }
+  void operator()(const CommandStream::BindDepthStencilState& cmd) {
+    if (render_) {
+      render_->bindDepthStencilState(cmd.depthStencilState);
+    }
+  }
+  void operator()(const CommandStream::BindUniform& cmd) {
+    if (render_) {
+      render_->bindUniform(uniforms_[cmd.uniform], uniformData_.data() + cmd.data);
+    } else if (compute_) {
+      compute_->bindUniform(uniforms_[cmd.uniform], uniformData_.data() + cmd.data);
+    }
+  }
+  void operator()(const CommandStream::BindBuffer& cmd) {
+    if (render_) {
+      render_->bindBuffer(cmd.index, cmd.buffer, cmd.offset, cmd.size);
+    } else if (compute_) {
+      compute_->bindBuffer(cmd.index, cmd.buffer, cmd.offset, cmd.size);
+    }
+  }
+  void operator()(const CommandStream::BindVertexBuffer& cmd) {
+    if (render_) {
+      render_->bindVertexBuffer(cmd.index, *cmd.buffer, cmd.offset);
+    }
+  }
+  void operator()(const CommandStream::BindIndexBuffer& cmd) {
+    if (render_) {
+      render_->bindIndexBuffer(*cmd.buffer, cmd.format, cmd.offset);
+    }
+  }
+  void operator()(const CommandStream::BindSamplerState& cmd) {
+    if (render_) {
+      render_->bindSamplerState(cmd.index, cmd.target, cmd.samplerState);
+    }
+  }
+  void operator()(const CommandStream::BindTexture& cmd) {
+    if (render_) {
+      render_->bindTexture(cmd.index, cmd.target, cmd.texture);
+    } else if (compute_) {
+      compute_->bindTexture(cmd.index, cmd.texture);
+    }
+  }
+  void operator()(const CommandStream::BindBindGroupTexture& cmd) {
+    if (render_) {
+      render_->bindBindGroup(cmd.handle);
+    }
+  }
+  void operator()(const CommandStream::BindBindGroupBuffer& cmd) {
+    if (render_) {
+      render_->bindBindGroup(cmd.handle,
+                             cmd.numDynamicOffsets,
+                             cmd.numDynamicOffsets ? &dynamicOffsets_[cmd.firstDynamicOffset]
+                                                   : nullptr);
+    }
+  }
+  void operator()(const CommandStream::Draw& cmd) {
+    if (render_) {
+      render_->draw(cmd.vertexCount, cmd.instanceCount, cmd.firstVertex, cmd.baseInstance);
+    }
+  }
+  void operator()(const CommandStream::DrawIndexed& cmd) {
+    if (render_) {
+      render_->drawIndexed(
+          cmd.indexCount, cmd.instanceCount, cmd.firstIndex, cmd.vertexOffset, cmd.baseInstance);
+    }
+  }
+  void operator()(const CommandStream::MultiDrawIndirect& cmd) {
+    if (!render_) {
+      return;
+    }
+    if (cmd.indexed) {
+      render_->multiDrawIndexedIndirect(
+          *cmd.indirectBuffer, cmd.indirectBufferOffset, cmd.drawCount, cmd.stride);
+    } else {
+      render_->multiDrawIndirect(
+          *cmd.indirectBuffer, cmd.indirectBufferOffset, cmd.drawCount, cmd.stride);
+    }
+  }
+  void operator()(const CommandStream::DispatchThreadGroups& cmd) {
+    if (compute_) {
+      compute_->dispatchThreadGroups(
+          cmd.threadgroupCount, cmd.threadgroupSize, getDependencies(cmd.dependencies));
+    }
+  }
+  void operator()(const CommandStream::SetStencilReferenceValue& cmd) {
+    if (render_) {
+      render_->setStencilReferenceValue(cmd.value);
+    }
+  }
+  void operator()(const CommandStream::SetBlendColor& cmd) {
+    if (render_) {
+      render_->setBlendColor(cmd.color);
+    }
+  }
+  void operator()(const CommandStream::SetDepthBias& cmd) {
+    if (render_) {
+      render_->setDepthBias(cmd.depthBias, cmd.slopeScale, cmd.clamp);
+    }
+  }
+  void operator()(const CommandStream::CopyBuffer& cmd) {
+    commandBuffer_->copyBuffer(*cmd.src, *cmd.dst, cmd.srcOffset, cmd.dstOffset, cmd.size);
+  }
+  void operator()(const CommandStream::Present& cmd) {
+    commandBuffer_->present(cmd.surface);
+  }
+
+ private:
+  // the returned chain is valid until the next call
+  const Dependencies& getDependencies(const CommandStream::DependencyList& list) {
+    chain_.assign(dependencies_.begin() + list.firstDependencies,
+                  dependencies_.begin() + list.firstDependencies + list.numDependencies);
+    if (chain_.empty()) {
+      chain_.emplace_back();
+    }
+    for (size_t i = 0; i + 1 < chain_.size(); i++) {
+      chain_[i].next = &chain_[i + 1];
+    }
+    return chain_.front();
+  }
+
+  const std::shared_ptr<CommandBuffer>& commandBuffer_;
+  const std::vector<RenderPassDesc>& renderPasses_;
+  const std::vector<std::string>& labels_;
+  const std::vector<UniformDesc>& uniforms_;
+  const std::vector<uint8_t>& uniformData_;
+  const std::vector<uint32_t>& dynamicOffsets_;
+  const std::vector<Dependencies>& dependencies_;
+  std::vector<Dependencies> chain_;
+  std::unique_ptr<IRenderCommandEncoder> render_;
+  std::unique_ptr<IComputeCommandEncoder> compute_;
+};
+
+} // namespace
+
+void CommandStream::beginRenderPass(const RenderPassDesc& renderPass,
+                                    const std::shared_ptr<IFramebuffer>& framebuffer,
+                                    const Dependencies& dependencies) {
+  renderPasses_.push_back(renderPass);
+  record(BeginRenderPass{static_cast<uint32_t>(renderPasses_.size() - 1),
+                         framebuffer,
+                         recordDependencies(dependencies)});
+}
+
+void CommandStream::dispatchThreadGroups(const Dimensions& threadgroupCount,
+                                         const Dimensions& threadgroupSize,
+                                         const Dependencies& dependencies) {
+  record(DispatchThreadGroups{threadgroupCount, threadgroupSize, recordDependencies(dependencies)});
+}
+
+CommandStream::DependencyList CommandStream::recordDependencies(const Dependencies& dependencies) {
+  DependencyList list{static_cast<uint32_t>(dependencies_.size()), 0};
+  // most passes have no dependencies, which are not stored
+  if (!dependencies.textures[0] && !dependencies.buffers[0] && !dependencies.next) {
+    return list;
+  }
+  for (const Dependencies* deps = &dependencies; deps; deps = deps->next) {
+    dependencies_.push_back(*deps);
+    dependencies_.back().next = nullptr;
+    list.numDependencies++;
+  }
+  return list;
+}
+
+void CommandStream::pushDebugGroup(const char* label) {
+  labels_.emplace_back(label);
+  record(PushDebugGroup{static_cast<uint32_t>(labels_.size() - 1)});
+}
+
+void CommandStream::insertDebugEvent(const char* label) {
+  labels_.emplace_back(label);
+  record(InsertDebugEvent{static_cast<uint32_t>(labels_.size() - 1)});
+}
+
+void CommandStream::bindUniform(const UniformDesc& uniformDesc, const void* data) {
+  // copy only the bytes the encoder reads, the replay binds them at offset 0
+  const size_t stride = uniformDesc.elementStride != 0 ? uniformDesc.elementStride
+                                                       : sizeForUniformType(uniformDesc.type);
+  const size_t length = stride * uniformDesc.numElements;
+  const size_t dataOffset = uniformData_.size();
+  const auto* src = static_cast<const uint8_t*>(data) + uniformDesc.offset;
+  uniformData_.insert(uniformData_.end(), src, src + length);
+
+  uniforms_.push_back(uniformDesc);
+  uniforms_.back().offset = 0;
+  record(BindUniform{static_cast<uint32_t>(uniforms_.size() - 1), dataOffset});
+}
+
+void CommandStream::bindBindGroup(BindGroupBufferHandle handle,
+                                  uint32_t numDynamicOffsets,
+                                  const uint32_t* dynamicOffsets) {
+  const auto firstDynamicOffset = static_cast<uint32_t>(dynamicOffsets_.size());
+  if (numDynamicOffsets && IGL_DEBUG_VERIFY(dynamicOffsets)) {
+    dynamicOffsets_.insert(
+        dynamicOffsets_.end(), dynamicOffsets, dynamicOffsets + numDynamicOffsets);
+  } else {
+    numDynamicOffsets = 0;
+  }
+  record(BindBindGroupBuffer{handle, firstDynamicOffset, numDynamicOffsets});
+}
+
+void CommandStream::replay(const std::shared_ptr<CommandBuffer>& commandBuffer) {
+  IGL_PROFILER_FUNCTION();
+
+  Replayer replayer(commandBuffer,
+                    renderPasses_,
+                    labels_,
+                    uniforms_,
+                    uniformData_,
+                    dynamicOffsets_,
+                    dependencies_);
+
+  for (const Command& cmd : commands_) {
+    std::visit(replayer, cmd);
+  }
+
+  IGL_DEBUG_ASSERT(!replayer.hasOpenPass(), "Every encoder has to be ended before submission");
+
+  clear();
+}
+
+void CommandStream::clear() {
+  commands_.clear();
+  renderPasses_.clear();
+  labels_.clear();
+  uniforms_.clear();
+  uniformData_.clear();
+  dynamicOffsets_.clear();
+  dependencies_.clear();
+}
+
+} // namespace igl::opengl
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+#include <igl/Buffer.h>
+#include <igl/CommandEncoder.h>
+#include <igl/Common.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderPass.h>
+#include <igl/Uniform.h>
+
+namespace igl {
+class IComputePipelineState;
+class IDepthStencilState;
+class IQueryPool;
+class IRenderPipelineState;
+class ISamplerState;
+namespace opengl {
+
+class CommandBuffer;
+
+/**
+ * @brief A compact list of commands recorded by a CommandBuffer in the deferred recording mode
+ * (see CommandQueue::setCommandRecordingEnabled()). Recording does not make any GL calls, so it can
+ * happen on any thread. The commands are replayed through regular RenderCommandEncoder and
+ * ComputeCommandEncoder instances when the command buffer is submitted.
+ *
+ * Commands keep raw pointers to buffers, textures, samplers and query pools, which must stay alive
+ * until the command buffer is submitted. Uniform data is copied into the stream when recorded, so
+ * the caller can reuse its memory right after bindUniform(), just like in the immediate mode. Bind
+ * groups are resolved during the replay. Dependencies are copied, including the ones chained with
+ * Dependencies::next, and passed to the encoders during the replay.
+ */
+class CommandStream final {
+ public:
+  // a chain of Dependencies in dependencies_, empty if numDependencies is 0
+  struct DependencyList {
+    uint32_t firstDependencies; // index into dependencies_
+    uint32_t numDependencies;
+  };
+  struct BeginRenderPass {
+    uint32_t renderPass; // index into renderPasses_
+    std::shared_ptr<IFramebuffer> framebuffer;
+    DependencyList dependencies;
+  };
+  struct EndRenderPass {};
+  struct BeginComputePass {};
+  struct EndComputePass {};
+  struct PushDebugGroup {
+    uint32_t label; // index into labels_
+  };
+  struct InsertDebugEvent {
+    uint32_t label; // index into labels_
+  };
+  struct PopDebugGroup {};
+  struct WriteTimestamp {
+    IQueryPool* pool;
+    uint32_t query;
+  };
+  struct BindViewport {
+    Viewport viewport;
+  };
+  struct BindScissorRect {
+    ScissorRect rect;
+  };
+  struct BindRenderPipelineState {
+    std::shared_ptr<IRenderPipelineState> pipelineState;
+  };
+  struct BindComputePipelineState {
+    std::shared_ptr<IComputePipelineState> pipelineState;
+  };
+  struct BindDepthStencilState {
+    std::shared_ptr<IDepthStencilState> depthStencilState;
+  };
+  struct BindUniform {
+    uint32_t uniform; // index into uniforms_
+    size_t data; // offset into uniformData_
+  };
+  struct BindBuffer {
+    uint32_t index;
+    IBuffer* buffer;
+    size_t offset;
+    size_t size;
+  };
+  struct BindVertexBuffer {
+    uint32_t index;
+    IBuffer* buffer;
+    size_t offset;
+  };
+  struct BindIndexBuffer {
+    IBuffer* buffer;
+    IndexFormat format;
+    size_t offset;
+  };
+  struct BindSamplerState {
+    uint32_t index;
+    uint8_t target;
+    ISamplerState* samplerState;
+  };
+  struct BindTexture {
+    uint32_t index;
+    uint8_t target; // ignored in compute passes
+    ITexture* texture;
+  };
+  struct BindBindGroupTexture {
+    BindGroupTextureHandle handle;
+  };
+  struct BindBindGroupBuffer {
+    BindGroupBufferHandle handle;
+    uint32_t firstDynamicOffset; // index into dynamicOffsets_
+    uint32_t numDynamicOffsets;
+  };
+  struct Draw {
+    size_t vertexCount;
+    uint32_t instanceCount;
+    uint32_t firstVertex;
+    uint32_t baseInstance;
+  };
+  struct DrawIndexed {
+    size_t indexCount;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t baseInstance;
+  };
+  struct MultiDrawIndirect {
+    IBuffer* indirectBuffer;
+    size_t indirectBufferOffset;
+    uint32_t drawCount;
+    uint32_t stride;
+    bool indexed;
+  };
+  struct DispatchThreadGroups {
+    Dimensions threadgroupCount;
+    Dimensions threadgroupSize;
+    DependencyList dependencies;
+  };
+  struct SetStencilReferenceValue {
+    uint32_t value;
+  };
+  struct SetBlendColor {
+    Color color;
+  };
+  struct SetDepthBias {
+    float depthBias;
+    float slopeScale;
+    float clamp;
+  };
+  struct CopyBuffer {
+    IBuffer* src;
+    IBuffer* dst;
+    uint64_t srcOffset;
+    uint64_t dstOffset;
+    uint64_t size;
+  };
+  struct Present {
+    std::shared_ptr<ITexture> surface;
+  };
+
+  using Command = std::variant<BeginRenderPass,
+                               EndRenderPass,
+                               BeginComputePass,
+                               EndComputePass,
+                               PushDebugGroup,
+                               InsertDebugEvent,
+                               PopDebugGroup,
+                               WriteTimestamp,
+                               BindViewport,
+                               BindScissorRect,
+                               BindRenderPipelineState,
+                               BindComputePipelineState,
+                               BindDepthStencilState,
+                               BindUniform,
+                               BindBuffer,
+                               BindVertexBuffer,
+                               BindIndexBuffer,
+                               BindSamplerState,
+                               BindTexture,
+                               BindBindGroupTexture,
+                               BindBindGroupBuffer,
+                               Draw,
+                               DrawIndexed,
+                               MultiDrawIndirect,
+                               DispatchThreadGroups,
+                               SetStencilReferenceValue,
+                               SetBlendColor,
+                               SetDepthBias,
+                               CopyBuffer,
+                               Present>;
+
+  template<typename T>
+  void record(T&& command) {
+    commands_.emplace_back(std::forward<T>(command));
+  }
+
+  void beginRenderPass(const RenderPassDesc& renderPass,
+                       const std::shared_ptr<IFramebuffer>& framebuffer,
+                       const Dependencies& dependencies);
+  void dispatchThreadGroups(const Dimensions& threadgroupCount,
+                            const Dimensions& threadgroupSize,
+                            const Dependencies& dependencies);
+  void pushDebugGroup(const char* label);
+  void insertDebugEvent(const char* label);
+  void bindUniform(const UniformDesc& uniformDesc, const void* data);
+  void bindBindGroup(BindGroupBufferHandle handle,
+                     uint32_t numDynamicOffsets,
+                     const uint32_t* dynamicOffsets);
+
+  /// @brief Replays all recorded commands on the calling thread, which has to own the GL context,
+  /// and clears the stream
+  void replay(const std::shared_ptr<CommandBuffer>& commandBuffer);
+
+  [[nodiscard]] size_t size() const {
+    return commands_.size();
+  }
+  [[nodiscard]] bool empty() const {
+    return commands_.empty();
+  }
+  void clear();
+
+ private:
+  DependencyList recordDependencies(const Dependencies& dependencies);
+
+  std::vector<Command> commands_;
+  // out-of-line data which would make every command large
+  std::vector<RenderPassDesc> renderPasses_;
+  std::vector<std::string> labels_;
+  std::vector<UniformDesc> uniforms_;
+  std::vector<uint8_t> uniformData_;
+  std::vector<uint32_t> dynamicOffsets_;
+  // chains are stored contiguously, Dependencies::next is linked again during the replay
+  std::vector<Dependencies> dependencies_;
+};
+
+} // namespace opengl
+} // namespace igl
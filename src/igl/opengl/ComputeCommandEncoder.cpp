@@ -14,6 +14,7 @@
 #include <igl/opengl/DeviceFeatureSet.h>
 #include <igl/opengl/GLIncludes.h>
 #include <igl/opengl/IContext.h>
+#include <igl/opengl/QueryPool.h>
 
 namespace igl::opengl {
 
@@ -88,6 +89,18 @@ void ComputeCommandEncoder::popDebugGroupLabel() const {
   }
 }
 
+void ComputeCommandEncoder::writeTimestamp(IQueryPool& pool, uint32_t query) {
+  static_cast<QueryPool&>(pool).writeTimestamp(query);
+}
+
+void ComputeCommandEncoder::beginQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void ComputeCommandEncoder::endQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
 void ComputeCommandEncoder::bindUniform(const UniformDesc& uniformDesc, const void* data) {
   IGL_DEBUG_ASSERT(uniformDesc.location >= 0,
                    "Invalid location passed to bindUniformBuffer: %d",
@@ -38,6 +38,12 @@ class ComputeCommandEncoder final : public IComputeCommandEncoder, public WithCo
   void pushDebugGroupLabel(const char* label, const igl::Color& color) const override;
   void insertDebugEventLabel(const char* label, const igl::Color& color) const override;
   void popDebugGroupLabel() const override;
+
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+  /// @brief Not supported: OpenGL only implements timestamp queries
+  void beginQuery(IQueryPool& pool, uint32_t query) override;
+  /// @brief Not supported: OpenGL only implements timestamp queries
+  void endQuery(IQueryPool& pool, uint32_t query) override;
   void bindUniform(const UniformDesc& uniformDesc, const void* data) override;
   void bindTexture(uint32_t index, ITexture* texture) override;
   void bindImageTexture(uint32_t index, ITexture* texture, TextureFormat format) override;
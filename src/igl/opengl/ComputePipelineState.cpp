@@ -29,6 +29,11 @@ Result ComputePipelineState::create(const ComputePipelineDesc& desc) {
     return result;
   }
   shaderStages_ = std::static_pointer_cast<ShaderStages>(desc.shaderStages);
+  // compute pipelines have no pending state, so a deferred link is checked right away
+  result = shaderStages_->waitForLink();
+  if (!result.isOk()) {
+    return result;
+  }
   reflection_ = std::make_shared<ComputePipelineReflection>(getContext(), *shaderStages_);
 
   for (const auto& unitSampler : desc.imagesMap) {
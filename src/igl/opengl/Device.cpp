@@ -16,6 +16,7 @@
 #include <igl/opengl/DeviceFeatureSet.h>
 #include <igl/opengl/Framebuffer.h>
 #include <igl/opengl/IContext.h>
+#include <igl/opengl/QueryPool.h>
 #include <igl/opengl/RenderPipelineState.h>
 #include <igl/opengl/SamplerState.h>
 #include <igl/opengl/TextureBuffer.h>
@@ -282,6 +283,21 @@ std::shared_ptr<IFramebuffer> Device::createFramebuffer(const FramebufferDesc& d
   return getPlatformDevice().createFramebuffer(desc, outResult);
 }
 
+std::shared_ptr<IQueryPool> Device::createQueryPool(const QueryPoolDesc& desc,
+                                                    Result* outResult) const {
+  auto resource = std::make_shared<QueryPool>(getContext(), desc);
+  const Result result = resource->create();
+  if (!result.isOk()) {
+    Result::setResult(outResult, result);
+    return nullptr;
+  }
+  if (hasResourceTracker()) {
+    resource->initResourceTracker(getResourceTracker(), desc.debugName);
+  }
+  Result::setOk(outResult);
+  return resource;
+}
+
 bool Device::hasFeature(DeviceFeatures capability) const {
   return deviceFeatureSet_.hasFeature(capability);
 }
@@ -310,11 +326,18 @@ BackendVersion Device::getBackendVersion() const {
 }
 
 void Device::beginScope() {
+  const bool isOutermostScope = !IDevice::verifyScope();
+
   IDevice::beginScope();
 
   IGL_DEBUG_ASSERT(context_);
   context_->setCurrent();
 
+  if (isOutermostScope) {
+    // the context could have been used outside of IGL since the last scope ended
+    context_->invalidateStateCache();
+  }
+
   // UnbindPolicy is fixed for duration of this scope
   cachedUnbindPolicy_ = getContext().getUnbindPolicy();
 }
@@ -89,6 +89,9 @@ class Device : public IDevice {
   std::shared_ptr<IFramebuffer> createFramebuffer(const FramebufferDesc& desc,
                                                   Result* IGL_NULLABLE outResult) noexcept override;
 
+  std::shared_ptr<IQueryPool> createQueryPool(const QueryPoolDesc& desc,
+                                              Result* IGL_NULLABLE outResult) const override;
+
   // debug markers useful in GPU captures
   void pushMarker(int len, const char* IGL_NULLABLE name);
   void popMarker();
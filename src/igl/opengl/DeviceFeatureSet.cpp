@@ -192,6 +192,8 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
     return hasESExtension(*this, "GL_OES_depth_texture");
   case Extensions::DiscardFramebuffer:
     return hasESExtension(*this, "GL_EXT_discard_framebuffer");
+  case Extensions::DisjointTimerQuery:
+    return hasESExtension(*this, "GL_EXT_disjoint_timer_query");
   case Extensions::DrawBuffers:
     return hasESExtension(*this, "GL_EXT_draw_buffers");
   case Extensions::Es2Compatibility:
@@ -379,6 +381,10 @@ bool DeviceFeatureSet::isFeatureSupported(DeviceFeatures feature) const {
 
   case DeviceFeatures::TextureViews:
     return false;
+  case DeviceFeatures::TimestampQueries:
+    return hasInternalFeature(InternalFeatures::TimerQuery);
+  case DeviceFeatures::PipelineStatisticsQueries:
+    return false;
 
   case DeviceFeatures::PushConstants:
     return false;
@@ -450,6 +456,10 @@ bool DeviceFeatureSet::isFeatureSupported(DeviceFeatures feature) const {
 
 bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) const {
   switch (feature) {
+  case InternalFeatures::BufferStorage:
+    return hasDesktopVersionOrExtension(*this, GLVersion::v4_4, "GL_ARB_buffer_storage") ||
+           hasESExtension(*this, "GL_EXT_buffer_storage");
+
   case InternalFeatures::ClearDepthf:
     return hasDesktopOrESVersion(*this, GLVersion::v4_1, GLVersion::v2_0_ES);
 
@@ -496,6 +506,13 @@ bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) cons
   case InternalFeatures::PolygonFillMode:
     return hasDesktopVersion(*this, GLVersion::v2_0);
 
+  case InternalFeatures::ProgramBinary:
+    return hasDesktopOrESVersionOrExtension(*this,
+                                            GLVersion::v4_1,
+                                            GLVersion::v3_0_ES,
+                                            "GL_ARB_get_program_binary",
+                                            "GL_OES_get_program_binary");
+
   case InternalFeatures::ProgramInterfaceQuery:
     return hasDesktopOrESVersion(*this, GLVersion::v4_3, GLVersion::v3_1_ES) ||
            hasDesktopExtension(*this, "GL_ARB_program_interface_query");
@@ -512,6 +529,10 @@ bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) cons
                *this, GLVersion::v4_2, GLVersion::v3_0_ES, "GL_ARB_texture_storage") ||
            hasExtension(Extensions::TexStorage);
 
+  case InternalFeatures::TimerQuery:
+    return hasDesktopVersionOrExtension(*this, GLVersion::v3_3, "GL_ARB_timer_query") ||
+           hasExtension(Extensions::DisjointTimerQuery);
+
   case InternalFeatures::ShaderImageLoadStore:
     return hasDesktopOrESVersion(*this, GLVersion::v4_2, GLVersion::v3_1_ES) ||
            hasDesktopExtension(*this, "GL_ARB_shader_image_load_store") ||
@@ -543,11 +564,30 @@ bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) cons
            hasExtension(Extensions::VertexAttribDivisor);
 
   case InternalFeatures::DrawArraysIndirect:
+    // OpenGL ES only sources indirect draws from a vertex array object other than 0
+    if (usesOpenGLES() && !isInternalFeatureSupported(InternalFeatures::VertexArrayObject)) {
+      return false;
+    }
     return hasDesktopOrESVersionOrExtension(
         *this, GLVersion::v4_0, GLVersion::v3_1_ES, "GL_ARB_draw_indirect");
 
   case InternalFeatures::PackRowLength:
     return hasDesktopOrESVersion(*this, GLVersion::v2_0, GLVersion::v3_0_ES);
+
+  case InternalFeatures::BaseInstance:
+    return hasDesktopVersionOrExtension(*this, GLVersion::v4_2, "GL_ARB_base_instance") ||
+           hasESExtension(*this, "GL_EXT_base_instance");
+
+  case InternalFeatures::MultiDrawIndirect:
+    if (!isInternalFeatureSupported(InternalFeatures::DrawArraysIndirect)) {
+      return false;
+    }
+    return hasDesktopVersionOrExtension(*this, GLVersion::v4_3, "GL_ARB_multi_draw_indirect") ||
+           hasESExtension(*this, "GL_EXT_multi_draw_indirect");
+
+  case InternalFeatures::ParallelShaderCompile:
+    return isSupported("GL_KHR_parallel_shader_compile") ||
+           hasDesktopExtension(*this, "GL_ARB_parallel_shader_compile");
   }
 
   return false;
@@ -951,6 +991,10 @@ bool DeviceFeatureSet::hasRequirement(DeviceRequirement requirement) const {
 
 bool DeviceFeatureSet::hasInternalRequirement(InternalRequirement requirement) const {
   switch (requirement) {
+  case InternalRequirement::BufferStorageExtReq:
+    // OpenGL ES does not include BufferStorage
+    return usesOpenGLES();
+
   case InternalRequirement::ColorTexImageRgb5A1Unsized:
     return usesOpenGLES() && !hasESVersion(*this, GLVersion::v3_0_ES);
 
@@ -1006,6 +1050,17 @@ bool DeviceFeatureSet::hasInternalRequirement(InternalRequirement requirement) c
     // OpenGL ES 2 does not include MapBufferRange
     return usesOpenGLES() && !hasESVersion(*this, GLVersion::v3_0_ES);
 
+  case InternalRequirement::MultiDrawIndirectExtReq:
+    // OpenGL ES does not include MultiDrawIndirect
+    return usesOpenGLES();
+
+  case InternalRequirement::ParallelShaderCompileArbReq:
+    // Some desktop drivers only expose glMaxShaderCompilerThreadsARB
+    return !isSupported("GL_KHR_parallel_shader_compile");
+
+  case InternalRequirement::ProgramBinaryExtReq:
+    return usesOpenGLES() && !hasESVersion(*this, GLVersion::v3_0_ES);
+
   case InternalRequirement::MultiSampleExtReq:
     // OpenGL ES has various extensions before 3.0 that are required, and
     // GL_IMG_multisampled_render_to_texture uses different enum values than later standard
@@ -1031,6 +1086,9 @@ bool DeviceFeatureSet::hasInternalRequirement(InternalRequirement requirement) c
   case InternalRequirement::Texture3DExtReq:
     return !hasDesktopOrESVersion(*this, GLVersion::v2_0, GLVersion::v3_0_ES);
 
+  case InternalRequirement::TimerQueryExtReq:
+    return usesOpenGLES();
+
   case InternalRequirement::TextureHalfFloatExtReq:
     // GL_OES_texture_half_float extension uses different enum values for GL_HALF_FLOAT_OES than
     // GL_HALF_FLOAT.
@@ -30,6 +30,7 @@ enum class Extensions {
   Depth32,                    // GL_OES_depth32 is supported
   DepthTexture,               // GL_OES_depth_texture is supported
   DiscardFramebuffer,         // GL_EXT_discard_framebuffer is supported
+  DisjointTimerQuery,         // GL_EXT_disjoint_timer_query is supported
   Es2Compatibility,           // GL_ARB_ES2_compatibility is supported
   DrawBuffers,                // GL_EXT_draw_buffers is supported
   FramebufferBlit,            // GL_EXT_framebuffer_blit is supported
@@ -64,6 +65,7 @@ enum class Extensions {
 
 // clang-format off
 enum class InternalFeatures {
+  BufferStorage,             // glBufferStorage and persistent mappings are supported
   ClearDepthf,               // glClearDepthf is supported
   DebugLabel,                // Debug labels on objects are supported
   DebugMessage,              // Debug messages and group markers are supported
@@ -75,18 +77,23 @@ enum class InternalFeatures {
   MapBuffer,                 // glMapBuffer is supported
   PixelBufferObject,         // PBOs are available
   PolygonFillMode,           // glPolygonFillMode is supported
+  ProgramBinary,             // glGetProgramBinary and glProgramBinary are supported
   ProgramInterfaceQuery,     // Querying info about shader program interfaces is supported
   SeamlessCubeMap,           // GL_TEXTURE_CUBE_MAP_SEAMLESS is supported
   ShaderImageLoadStore,      // Shader image load/store is supported
   Sync,                      // Sync objects are supported
   TexStorage,                // glTexStorage* is available
   TextureCompare,            // GL_TEXTURE_COMPARE_MODE and GL_TEXTURE_COMPARE_FUNC are supported
+  TimerQuery,                // GL_TIMESTAMP queries with glQueryCounter are supported
   UnmapBuffer,               // glUnmapBuffer is supported
   UnpackRowLength,           // GL_UNPACK_ROW_LENGTH is supported with glPixelStorei
   VertexArrayObject,         // VAOS are available
   VertexAttribDivisor,       // glVertexAttribDivisor is supported
-  DrawArraysIndirect,        // glDrawArraysIndirect is supported
+  DrawArraysIndirect,        // glDrawArraysIndirect and glDrawElementsIndirect can be used
   PackRowLength,             // GL_PACK_ROW_LENGTH is supported with glPixelStorei
+  BaseInstance,              // The baseInstance of indirect draw commands is honored
+  MultiDrawIndirect,         // glMultiDraw*Indirect is supported
+  ParallelShaderCompile,     // GL_COMPLETION_STATUS_KHR can be queried without blocking
 };
 // clang-format on
 
@@ -156,6 +163,7 @@ enum class TextureFeatures {
 // clang-format on
 
 enum class InternalRequirement {
+  BufferStorageExtReq,
   ColorTexImageRgb10A2Unsized,
   ColorTexImageRgb5A1Unsized,
   ColorTexImageRgba4Unsized,
@@ -171,12 +179,16 @@ enum class InternalRequirement {
   InvalidateFramebufferExtReq,
   MapBufferExtReq,
   MapBufferRangeExtReq,
+  MultiDrawIndirectExtReq,
   MultiSampleExtReq,
+  ParallelShaderCompileArbReq,
+  ProgramBinaryExtReq,
   ShaderImageLoadStoreExtReq,
   SyncExtReq,
   SwizzleAlphaTexturesReq,
   TexStorageExtReq,
   Texture3DExtReq,
+  TimerQueryExtReq,
   TextureHalfFloatExtReq,
   UnmapBufferExtReq,
   VertexArrayObjectExtReq,
@@ -8,9 +8,12 @@
 #include <igl/opengl/Framebuffer.h>
 
 #include <cstdlib>
+#include <memory>
+#include <igl/PixelConversion.h>
 #include <igl/RenderPass.h>
 #include <igl/opengl/DeviceFeatureSet.h>
 #include <igl/opengl/DummyTexture.h>
+#include <igl/opengl/FramebufferReadback.h>
 #include <igl/opengl/GLIncludes.h>
 
 #include <algorithm>
@@ -195,10 +198,58 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
                                            void* pixelBytes,
                                            const TextureRangeDesc& range,
                                            size_t bytesPerRow) const {
+  readPixelsColorAttachment(index, pixelBytes, range, bytesPerRow);
+}
+
+std::shared_ptr<IFramebufferReadback> Framebuffer::requestBytesColorAttachment(
+    ICommandQueue& cmdQueue,
+    size_t index,
+    const TextureRangeDesc& range,
+    Result* IGL_NULLABLE outResult) const {
+  auto& context = getContext();
+  if (!PixelPackBufferPool::isSupported(context)) {
+    return IFramebuffer::requestBytesColorAttachment(cmdQueue, index, range, outResult);
+  }
+  const auto texture = getColorAttachment(index);
+  if (index != 0 || !texture) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "Invalid index");
+    return nullptr;
+  }
+
+  const auto& properties = texture->getProperties();
+  const size_t bytesPerRow = properties.getBytesPerRow(range);
+  const size_t numRows = properties.getRows(range);
+  auto& pool = context.getPixelPackBufferPool();
+  const auto allocation = pool.acquire(context, bytesPerRow * numRows);
+  if (!allocation.isValid()) {
+    Result::setResult(outResult, Result::Code::RuntimeError, "Failed to create a readback buffer");
+    return nullptr;
+  }
+
+  // glReadPixels() writes to the buffer at offset 0 and returns without waiting for the GPU
+  context.bindBuffer(GL_PIXEL_PACK_BUFFER, allocation.buffer);
+  const bool issued = readPixelsColorAttachment(index, nullptr, range, bytesPerRow);
+  context.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  if (!issued) {
+    pool.release(context, allocation);
+    Result::setResult(outResult, Result::Code::RuntimeError, "Failed to read the pixels");
+    return nullptr;
+  }
+  GLsync sync = context.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  context.flush();
+
+  Result::setOk(outResult);
+  return std::make_shared<FramebufferReadback>(context, allocation, bytesPerRow, numRows, sync);
+}
+
+bool Framebuffer::readPixelsColorAttachment(size_t index,
+                                            void* IGL_NULLABLE pixelBytes,
+                                            const TextureRangeDesc& range,
+                                            size_t bytesPerRow) const {
   // Only support attachment 0 because that's what glReadPixels supports
   if (index != 0) {
     IGL_DEBUG_ABORT("Invalid index: %d", index);
-    return;
+    return false;
   }
   IGL_DEBUG_ASSERT(range.numFaces == 1, "range.numFaces MUST be 1");
   IGL_DEBUG_ASSERT(range.numLayers == 1, "range.numLayers MUST be 1");
@@ -207,7 +258,7 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
   auto itexture = getColorAttachment(index);
   if (itexture == nullptr) {
     IGL_DEBUG_ABORT("The framebuffer does not have any color attachment at index %d", index);
-    return;
+    return false;
   }
 
   const FramebufferBindingGuard guard(getContext());
@@ -233,6 +284,11 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
   const bool usePackRowLength = packRowLengthSupported && bytesPerRow != 0 &&
                                 bytesPerRow % itexture->getProperties().bytesPerBlock == 0;
 
+  // Without GL_PACK_ROW_LENGTH, rows are only padded up to the pack alignment. Other row pitches
+  // are read tightly packed and repacked on the CPU.
+  const size_t rangeBytesPerRow = itexture->getProperties().getBytesPerRow(range);
+  std::unique_ptr<uint8_t[]> packedPixelBytes;
+
   if (usePackRowLength) {
     const int packRowLength =
         static_cast<int>(bytesPerRow / itexture->getProperties().bytesPerBlock);
@@ -244,9 +300,17 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
     if (packRowLengthSupported) {
       getContext().pixelStorei(GL_PACK_ROW_LENGTH, 0);
     }
-    getContext().pixelStorei(GL_PACK_ALIGNMENT,
-                             texture.getAlignment(finalBytesPerRow, range.mipLevel, range.width));
+    GLint alignment = texture.getAlignment(finalBytesPerRow, range.mipLevel, range.width);
+    const auto alignmentBytes = static_cast<size_t>(alignment);
+    const size_t alignedBytesPerRow =
+        (rangeBytesPerRow + alignmentBytes - 1) / alignmentBytes * alignmentBytes;
+    if (pixelBytes != nullptr && bytesPerRow != 0 && bytesPerRow != alignedBytesPerRow) {
+      packedPixelBytes = std::make_unique<uint8_t[]>(rangeBytesPerRow * range.height);
+      alignment = 1;
+    }
+    getContext().pixelStorei(GL_PACK_ALIGNMENT, alignment);
   }
+  void* IGL_NULLABLE readPixelBytes = packedPixelBytes ? packedPixelBytes.get() : pixelBytes;
 
   // Note read out format is based on
   // (https://www.khronos.org/registry/OpenGL-Refpages/es2.0/xhtml/glReadPixels.xml)
@@ -269,32 +333,37 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
   if (textureFormat == TextureFormat::RGBA_UInt32) {
     if (IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasTextureFeature(TextureFeatures::TextureInteger))) {
-      getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGBA_INTEGER, GL_UNSIGNED_INT, pixelBytes);
+      getContext().readPixels(rangeX,
+                              rangeY,
+                              rangeWidth,
+                              rangeHeight,
+                              GL_RGBA_INTEGER,
+                              GL_UNSIGNED_INT,
+                              readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::R_UNorm8) {
     if (IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFormatRG))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RED, GL_UNSIGNED_BYTE, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RED, GL_UNSIGNED_BYTE, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::RG_UNorm8) {
     if (IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFormatRG))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RG, GL_UNSIGNED_BYTE, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RG, GL_UNSIGNED_BYTE, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::RGBA_F16) {
     if (IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureHalfFloat))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGBA, kHalfFloatFormat, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGBA, kHalfFloatFormat, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::RGB_F16) {
     if (IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureHalfFloat))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGB, kHalfFloatFormat, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGB, kHalfFloatFormat, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::RG_F16) {
     if (IGL_DEBUG_VERIFY(
@@ -302,7 +371,7 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
         IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFormatRG))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RG, kHalfFloatFormat, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RG, kHalfFloatFormat, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::R_F16) {
     if (IGL_DEBUG_VERIFY(
@@ -310,34 +379,44 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
         IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFormatRG))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RED, kHalfFloatFormat, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RED, kHalfFloatFormat, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::RGBA_F32) {
     if (IGL_DEBUG_VERIFY(getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFloat))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGBA, GL_FLOAT, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGBA, GL_FLOAT, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::RGB_F32) {
     if (IGL_DEBUG_VERIFY(getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFloat))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGB, GL_FLOAT, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RGB, GL_FLOAT, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::RG_F32) {
     if (IGL_DEBUG_VERIFY(getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFloat)) &&
         IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFormatRG))) {
-      getContext().readPixels(rangeX, rangeY, rangeWidth, rangeHeight, GL_RG, GL_FLOAT, pixelBytes);
+      getContext().readPixels(
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RG, GL_FLOAT, readPixelBytes);
     }
   } else if (textureFormat == TextureFormat::R_F32) {
     if (IGL_DEBUG_VERIFY(getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFloat)) &&
         IGL_DEBUG_VERIFY(
             getContext().deviceFeatures().hasFeature(DeviceFeatures::TextureFormatRG))) {
       getContext().readPixels(
-          rangeX, rangeY, rangeWidth, rangeHeight, GL_RED, GL_FLOAT, pixelBytes);
+          rangeX, rangeY, rangeWidth, rangeHeight, GL_RED, GL_FLOAT, readPixelBytes);
     }
   } else {
     getContext().readPixels(
-        rangeX, rangeY, rangeWidth, rangeHeight, GL_RGBA, GL_UNSIGNED_BYTE, pixelBytes);
+        rangeX, rangeY, rangeWidth, rangeHeight, GL_RGBA, GL_UNSIGNED_BYTE, readPixelBytes);
+  }
+
+  if (packedPixelBytes) {
+    copyPixelRows(packedPixelBytes.get(),
+                  rangeBytesPerRow,
+                  static_cast<uint8_t*>(pixelBytes),
+                  bytesPerRow,
+                  rangeBytesPerRow,
+                  range.height);
   }
 
   // Reset the GL_PACK_ROW_LENGTH
@@ -350,6 +429,7 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
   getContext().checkForErrors(nullptr, 0);
   auto error = getContext().getLastError();
   IGL_DEBUG_ASSERT(error.isOk(), error.message.c_str());
+  return error.isOk();
 }
 
 void Framebuffer::copyBytesDepthAttachment(ICommandQueue& /* unused */,
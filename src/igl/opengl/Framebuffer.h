@@ -49,6 +49,15 @@ class Framebuffer : public WithContext, public IFramebuffer {
                                 const TextureRangeDesc& range,
                                 size_t bytesPerRow = 0) const override;
 
+  /// @brief Reads the pixels into a pooled GL_PIXEL_PACK_BUFFER (see PixelPackBufferPool), which
+  /// the returned FramebufferReadback maps once the GPU is done. Contexts without pixel pack
+  /// buffers or sync objects read the pixels synchronously.
+  std::shared_ptr<IFramebufferReadback> requestBytesColorAttachment(
+      ICommandQueue& cmdQueue,
+      size_t index,
+      const TextureRangeDesc& range,
+      Result* IGL_NULLABLE outResult = nullptr) const override;
+
   void copyBytesDepthAttachment(ICommandQueue& /* unused */,
                                 void* pixelBytes,
                                 const TextureRangeDesc& range,
@@ -74,6 +83,12 @@ class Framebuffer : public WithContext, public IFramebuffer {
   [[nodiscard]] bool isSwapchainBound() const override;
 
  protected:
+  // glReadPixels() into client memory, or at the offset `pixelBytes` into the bound
+  // GL_PIXEL_PACK_BUFFER. Returns false if the read failed.
+  bool readPixelsColorAttachment(size_t index,
+                                 void* IGL_NULLABLE pixelBytes,
+                                 const TextureRangeDesc& range,
+                                 size_t bytesPerRow) const;
   void attachAsColor(ITexture& texture,
                      uint32_t index,
                      const Texture::AttachmentParams& params) const;
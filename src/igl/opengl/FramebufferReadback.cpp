@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/FramebufferReadback.h>
+
+#include <cstring>
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+namespace {
+
+constexpr GLuint64 kWaitTimeoutNs = 1000000; // 1 ms
+
+} // namespace
+
+FramebufferReadback::FramebufferReadback(IContext& context,
+                                         PixelPackBufferPool::Allocation allocation,
+                                         size_t bytesPerRow,
+                                         size_t numRows,
+                                         GLsync sync) :
+  WithContext(context),
+  allocation_(allocation),
+  bytesPerRow_(bytesPerRow),
+  numRows_(numRows),
+  sync_(sync) {}
+
+FramebufferReadback::~FramebufferReadback() {
+  auto& context = getContext();
+  if (!isReady()) {
+    // the GPU may still write the buffer, so it cannot be reused yet
+    context.deleteSync(sync_);
+    sync_ = nullptr;
+    context.deleteBuffers(1, &allocation_.buffer);
+    return;
+  }
+  context.getPixelPackBufferPool().release(context, allocation_);
+}
+
+bool FramebufferReadback::isReady() const {
+  if (sync_) {
+    const GLenum status = getContext().clientWaitSync(sync_, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+      return false;
+    }
+    getContext().deleteSync(sync_);
+    sync_ = nullptr;
+  }
+  return true;
+}
+
+void FramebufferReadback::wait() {
+  if (!sync_) {
+    return;
+  }
+  auto& context = getContext();
+  GLenum status = GL_TIMEOUT_EXPIRED;
+  do {
+    status = context.clientWaitSync(sync_, GL_SYNC_FLUSH_COMMANDS_BIT, kWaitTimeoutNs);
+  } while (status == GL_TIMEOUT_EXPIRED);
+  context.deleteSync(sync_);
+  sync_ = nullptr;
+}
+
+Result FramebufferReadback::copyBytes(void* pixelBytes, size_t bytesPerRow) {
+  if (!IGL_DEBUG_VERIFY(pixelBytes)) {
+    return Result(Result::Code::ArgumentNull, "pixelBytes is null");
+  }
+  if (bytesPerRow != 0 && bytesPerRow < bytesPerRow_) {
+    return Result(Result::Code::ArgumentOutOfRange, "bytesPerRow is too small");
+  }
+  wait();
+
+  auto& context = getContext();
+  const size_t length = bytesPerRow_ * numRows_;
+  context.bindBuffer(GL_PIXEL_PACK_BUFFER, allocation_.buffer);
+  const auto* pixels = static_cast<const uint8_t*>(context.mapBufferRange(
+      GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(length), GL_MAP_READ_BIT));
+  Result result;
+  if (pixels == nullptr) {
+    result = Result(Result::Code::RuntimeError, "Failed to map the pixel pack buffer");
+  } else {
+    if (bytesPerRow == 0 || bytesPerRow == bytesPerRow_) {
+      memcpy(pixelBytes, pixels, length);
+    } else {
+      auto* dst = static_cast<uint8_t*>(pixelBytes);
+      for (size_t row = 0; row != numRows_; row++) {
+        memcpy(dst + row * bytesPerRow, pixels + row * bytesPerRow_, bytesPerRow_);
+      }
+    }
+    context.unmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  context.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  return result;
+}
+
+} // namespace igl::opengl
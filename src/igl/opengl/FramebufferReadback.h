@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/Framebuffer.h>
+#include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/PixelPackBufferPool.h>
+#include <igl/opengl/WithContext.h>
+
+namespace igl::opengl {
+
+/**
+ * @brief A glReadPixels() into a pooled pixel pack buffer, see
+ * Framebuffer::requestBytesColorAttachment().
+ *
+ * The readback owns the buffer and the fence after the read. isReady() polls the fence without
+ * waiting, and copyBytes() maps the buffer. The buffer goes back to the PixelPackBufferPool of the
+ * context when the readback is destroyed, which must happen with the context current.
+ */
+class FramebufferReadback final : public WithContext, public IFramebufferReadback {
+ public:
+  FramebufferReadback(IContext& context,
+                      PixelPackBufferPool::Allocation allocation,
+                      size_t bytesPerRow,
+                      size_t numRows,
+                      GLsync sync);
+  ~FramebufferReadback() override;
+
+  [[nodiscard]] bool isReady() const override;
+  Result copyBytes(void* pixelBytes, size_t bytesPerRow = 0) override;
+
+ private:
+  // waits for the fence and deletes it
+  void wait();
+
+  PixelPackBufferPool::Allocation allocation_;
+  size_t bytesPerRow_;
+  size_t numRows_;
+  // null once the read has finished
+  mutable GLsync sync_;
+};
+
+} // namespace igl::opengl
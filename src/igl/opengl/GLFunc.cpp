@@ -459,15 +459,27 @@ void iglRenderbufferStorageMultisampleAPPLE(GLenum target,
 /// MARK: - GL_APPLE_sync
 
 #if defined(GL_APPLE_sync)
+#define CAN_CALL_glClientWaitSyncAPPLE CAN_CALL_OPENGL_ES
 #define CAN_CALL_glDeleteSyncAPPLE CAN_CALL_OPENGL_ES
 #define CAN_CALL_glFenceSyncAPPLE CAN_CALL_OPENGL_ES
 #define CAN_CALL_glGetSyncivAPPLE CAN_CALL_OPENGL_ES
 #else
+#define CAN_CALL_glClientWaitSyncAPPLE 0
 #define CAN_CALL_glDeleteSyncAPPLE 0
 #define CAN_CALL_glFenceSyncAPPLE 0
 #define CAN_CALL_glGetSyncivAPPLE 0
 #endif
 
+GLenum iglClientWaitSyncAPPLE(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+  GLEXTENSION_METHOD_BODY_WITH_RETURN(CAN_CALL_glClientWaitSyncAPPLE,
+                                      glClientWaitSyncAPPLE,
+                                      PFNIGLCLIENTWAITSYNCPROC,
+                                      GL_WAIT_FAILED,
+                                      sync,
+                                      flags,
+                                      timeout);
+}
+
 void iglDeleteSyncAPPLE(GLsync sync) {
   GLEXTENSION_METHOD_BODY(
       CAN_CALL_glDeleteSyncAPPLE, glDeleteSyncAPPLE, PFNIGLDELETESYNCPROC, sync);
@@ -524,6 +536,25 @@ void iglMakeTextureHandleNonResidentARB(GLuint64 handle) {
                           handle);
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_buffer_storage
+
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+#define CAN_CALL_glBufferStorage CAN_CALL_OPENGL
+#else
+#define CAN_CALL_glBufferStorage 0
+#endif
+
+void iglBufferStorage(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glBufferStorage,
+                          glBufferStorage,
+                          PFNIGLBUFFERSTORAGEPROC,
+                          target,
+                          size,
+                          data,
+                          flags);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_compute_shader
 
@@ -817,6 +848,53 @@ void iglRenderbufferStorageMultisample(GLenum target,
                           height)
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_get_program_binary
+
+#if defined(GL_VERSION_4_1) || defined(GL_ES_VERSION_3_0) || defined(GL_ARB_get_program_binary)
+#define CAN_CALL_glGetProgramBinary CAN_CALL
+#define CAN_CALL_glProgramBinary CAN_CALL
+#define CAN_CALL_glProgramParameteri CAN_CALL
+#else
+#define CAN_CALL_glGetProgramBinary 0
+#define CAN_CALL_glProgramBinary 0
+#define CAN_CALL_glProgramParameteri 0
+#endif
+
+void iglGetProgramBinary(GLuint program,
+                         GLsizei bufSize,
+                         GLsizei* length,
+                         GLenum* binaryFormat,
+                         void* binary) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetProgramBinary,
+                          glGetProgramBinary,
+                          PFNIGLGETPROGRAMBINARYPROC,
+                          program,
+                          bufSize,
+                          length,
+                          binaryFormat,
+                          binary);
+}
+
+void iglProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glProgramBinary,
+                          glProgramBinary,
+                          PFNIGLPROGRAMBINARYPROC,
+                          program,
+                          binaryFormat,
+                          binary,
+                          length);
+}
+
+void iglProgramParameteri(GLuint program, GLenum pname, GLint value) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glProgramParameteri,
+                          glProgramParameteri,
+                          PFNIGLPROGRAMPARAMETERIPROC,
+                          program,
+                          pname,
+                          value);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_invalidate_subdata
 
@@ -855,6 +933,61 @@ void* iglMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbit
                                       access);
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_multi_draw_indirect
+
+#if defined(GL_VERSION_4_3) || defined(GL_ARB_multi_draw_indirect)
+#define CAN_CALL_glMultiDrawArraysIndirect CAN_CALL_OPENGL
+#define CAN_CALL_glMultiDrawElementsIndirect CAN_CALL_OPENGL
+#else
+#define CAN_CALL_glMultiDrawArraysIndirect 0
+#define CAN_CALL_glMultiDrawElementsIndirect 0
+#endif
+
+void iglMultiDrawArraysIndirect(GLenum mode,
+                                const GLvoid* indirect,
+                                GLsizei drawcount,
+                                GLsizei stride) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMultiDrawArraysIndirect,
+                          glMultiDrawArraysIndirect,
+                          PFNIGLMULTIDRAWARRAYSINDIRECTPROC,
+                          mode,
+                          indirect,
+                          drawcount,
+                          stride);
+}
+
+void iglMultiDrawElementsIndirect(GLenum mode,
+                                  GLenum type,
+                                  const GLvoid* indirect,
+                                  GLsizei drawcount,
+                                  GLsizei stride) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMultiDrawElementsIndirect,
+                          glMultiDrawElementsIndirect,
+                          PFNIGLMULTIDRAWELEMENTSINDIRECTPROC,
+                          mode,
+                          type,
+                          indirect,
+                          drawcount,
+                          stride);
+}
+
+///--------------------------------------
+/// MARK: - GL_ARB_parallel_shader_compile
+
+#if defined(GL_ARB_parallel_shader_compile)
+#define CAN_CALL_glMaxShaderCompilerThreadsARB CAN_CALL_OPENGL
+#else
+#define CAN_CALL_glMaxShaderCompilerThreadsARB 0
+#endif
+
+void iglMaxShaderCompilerThreadsARB(GLuint count) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMaxShaderCompilerThreadsARB,
+                          glMaxShaderCompilerThreadsARB,
+                          PFNIGLMAXSHADERCOMPILERTHREADSPROC,
+                          count);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_program_interface_query
 
@@ -970,15 +1103,27 @@ void iglMemoryBarrier(GLbitfield barriers) {
 /// MARK: - GL_ARB_sync
 
 #if defined(GL_VERSION_3_2) || defined(GL_ES_VERSION_3_0) || defined(GL_ARB_sync)
+#define CAN_CALL_glClientWaitSync CAN_CALL
 #define CAN_CALL_glDeleteSync CAN_CALL
 #define CAN_CALL_glFenceSync CAN_CALL
 #define CAN_CALL_glGetSynciv CAN_CALL
 #else
+#define CAN_CALL_glClientWaitSync 0
 #define CAN_CALL_glDeleteSync 0
 #define CAN_CALL_glFenceSync 0
 #define CAN_CALL_glGetSynciv 0
 #endif
 
+GLenum iglClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+  GLEXTENSION_METHOD_BODY_WITH_RETURN(CAN_CALL_glClientWaitSync,
+                                      glClientWaitSync,
+                                      PFNIGLCLIENTWAITSYNCPROC,
+                                      GL_WAIT_FAILED,
+                                      sync,
+                                      flags,
+                                      timeout);
+}
+
 void iglDeleteSync(GLsync sync) {
   GLEXTENSION_METHOD_BODY(CAN_CALL_glDeleteSync, glDeleteSync, PFNIGLDELETESYNCPROC, sync);
 }
@@ -1052,6 +1197,58 @@ void iglTexStorage3D(GLenum target,
                           depth);
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_timer_query
+
+#if defined(GL_VERSION_1_5) || defined(GL_ES_VERSION_3_0)
+#define CAN_CALL_glDeleteQueries CAN_CALL
+#define CAN_CALL_glGenQueries CAN_CALL
+#define CAN_CALL_glGetQueryObjectuiv CAN_CALL
+#else
+#define CAN_CALL_glDeleteQueries 0
+#define CAN_CALL_glGenQueries 0
+#define CAN_CALL_glGetQueryObjectuiv 0
+#endif
+#if defined(GL_VERSION_3_3) || defined(GL_ARB_timer_query)
+#define CAN_CALL_glGetQueryObjectui64v CAN_CALL_OPENGL
+#define CAN_CALL_glQueryCounter CAN_CALL_OPENGL
+#else
+#define CAN_CALL_glGetQueryObjectui64v 0
+#define CAN_CALL_glQueryCounter 0
+#endif
+
+void iglDeleteQueries(GLsizei n, const GLuint* ids) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glDeleteQueries, glDeleteQueries, PFNIGLDELETEQUERIESPROC, n, ids);
+}
+
+void iglGenQueries(GLsizei n, GLuint* ids) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGenQueries, glGenQueries, PFNIGLGENQUERIESPROC, n, ids);
+}
+
+void iglGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetQueryObjectuiv,
+                          glGetQueryObjectuiv,
+                          PFNIGLGETQUERYOBJECTUIVPROC,
+                          id,
+                          pname,
+                          params);
+}
+
+void iglGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetQueryObjectui64v,
+                          glGetQueryObjectui64v,
+                          PFNIGLGETQUERYOBJECTUI64VPROC,
+                          id,
+                          pname,
+                          params);
+}
+
+void iglQueryCounter(GLuint id, GLenum target) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glQueryCounter, glQueryCounter, PFNIGLQUERYCOUNTERPROC, id, target);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_uniform_buffer_object
 
@@ -1200,6 +1397,25 @@ void iglPolygonOffsetClamp(float factor, float units, float clamp) {
                           clamp);
 }
 
+///--------------------------------------
+/// MARK: - GL_EXT_buffer_storage
+
+#if defined(GL_EXT_buffer_storage)
+#define CAN_CALL_glBufferStorageEXT CAN_CALL_OPENGL_ES
+#else
+#define CAN_CALL_glBufferStorageEXT 0
+#endif
+
+void iglBufferStorageEXT(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glBufferStorageEXT,
+                          glBufferStorageEXT,
+                          PFNIGLBUFFERSTORAGEPROC,
+                          target,
+                          size,
+                          data,
+                          flags);
+}
+
 ///--------------------------------------
 /// MARK: - GL_EXT_debug_label
 
@@ -1279,6 +1495,55 @@ void iglDiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenu
                           attachments);
 }
 
+///--------------------------------------
+/// MARK: - GL_EXT_disjoint_timer_query
+
+#if defined(GL_EXT_disjoint_timer_query)
+#define CAN_CALL_glDeleteQueriesEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glGenQueriesEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glGetQueryObjectuivEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glGetQueryObjectui64vEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glQueryCounterEXT CAN_CALL_OPENGL_ES
+#else
+#define CAN_CALL_glDeleteQueriesEXT 0
+#define CAN_CALL_glGenQueriesEXT 0
+#define CAN_CALL_glGetQueryObjectuivEXT 0
+#define CAN_CALL_glGetQueryObjectui64vEXT 0
+#define CAN_CALL_glQueryCounterEXT 0
+#endif
+
+void iglDeleteQueriesEXT(GLsizei n, const GLuint* ids) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glDeleteQueriesEXT, glDeleteQueriesEXT, PFNIGLDELETEQUERIESPROC, n, ids);
+}
+
+void iglGenQueriesEXT(GLsizei n, GLuint* ids) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGenQueriesEXT, glGenQueriesEXT, PFNIGLGENQUERIESPROC, n, ids);
+}
+
+void iglGetQueryObjectuivEXT(GLuint id, GLenum pname, GLuint* params) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetQueryObjectuivEXT,
+                          glGetQueryObjectuivEXT,
+                          PFNIGLGETQUERYOBJECTUIVPROC,
+                          id,
+                          pname,
+                          params);
+}
+
+void iglGetQueryObjectui64vEXT(GLuint id, GLenum pname, GLuint64* params) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetQueryObjectui64vEXT,
+                          glGetQueryObjectui64vEXT,
+                          PFNIGLGETQUERYOBJECTUI64VPROC,
+                          id,
+                          pname,
+                          params);
+}
+
+void iglQueryCounterEXT(GLuint id, GLenum target) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glQueryCounterEXT, glQueryCounterEXT, PFNIGLQUERYCOUNTERPROC, id, target);
+}
+
 ///--------------------------------------
 /// MARK: - GL_EXT_draw_buffers
 
@@ -1437,6 +1702,45 @@ void iglImportMemoryFdEXT(GLuint memory, GLuint64 size, GLenum handleType, GLint
                           fd);
 }
 
+///--------------------------------------
+/// MARK: - GL_EXT_multi_draw_indirect
+
+#if defined(GL_EXT_multi_draw_indirect)
+#define CAN_CALL_glMultiDrawArraysIndirectEXT CAN_CALL_OPENGL_ES
+#define CAN_CALL_glMultiDrawElementsIndirectEXT CAN_CALL_OPENGL_ES
+#else
+#define CAN_CALL_glMultiDrawArraysIndirectEXT 0
+#define CAN_CALL_glMultiDrawElementsIndirectEXT 0
+#endif
+
+void iglMultiDrawArraysIndirectEXT(GLenum mode,
+                                   const GLvoid* indirect,
+                                   GLsizei drawcount,
+                                   GLsizei stride) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMultiDrawArraysIndirectEXT,
+                          glMultiDrawArraysIndirectEXT,
+                          PFNIGLMULTIDRAWARRAYSINDIRECTPROC,
+                          mode,
+                          indirect,
+                          drawcount,
+                          stride);
+}
+
+void iglMultiDrawElementsIndirectEXT(GLenum mode,
+                                     GLenum type,
+                                     const GLvoid* indirect,
+                                     GLsizei drawcount,
+                                     GLsizei stride) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMultiDrawElementsIndirectEXT,
+                          glMultiDrawElementsIndirectEXT,
+                          PFNIGLMULTIDRAWELEMENTSINDIRECTPROC,
+                          mode,
+                          type,
+                          indirect,
+                          drawcount,
+                          stride);
+}
+
 ///--------------------------------------
 /// MARK: - GL_EXT_multisampled_render_to_texture
 
@@ -1722,6 +2026,22 @@ void iglPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar
                           message);
 }
 
+///--------------------------------------
+/// MARK: - GL_KHR_parallel_shader_compile
+
+#if defined(GL_KHR_parallel_shader_compile)
+#define CAN_CALL_glMaxShaderCompilerThreadsKHR CAN_CALL
+#else
+#define CAN_CALL_glMaxShaderCompilerThreadsKHR 0
+#endif
+
+void iglMaxShaderCompilerThreadsKHR(GLuint count) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMaxShaderCompilerThreadsKHR,
+                          glMaxShaderCompilerThreadsKHR,
+                          PFNIGLMAXSHADERCOMPILERTHREADSPROC,
+                          count);
+}
+
 ///--------------------------------------
 /// MARK: - GL_NV_bindless_texture
 
@@ -1828,6 +2148,42 @@ void iglFramebufferTextureMultisampleMultiviewOVR(GLenum target,
                           numViews)
 }
 
+///--------------------------------------
+/// MARK: - GL_OES_get_program_binary
+
+#if defined(GL_OES_get_program_binary)
+#define CAN_CALL_glGetProgramBinaryOES CAN_CALL_OPENGL_ES
+#define CAN_CALL_glProgramBinaryOES CAN_CALL_OPENGL_ES
+#else
+#define CAN_CALL_glGetProgramBinaryOES 0
+#define CAN_CALL_glProgramBinaryOES 0
+#endif
+
+void iglGetProgramBinaryOES(GLuint program,
+                            GLsizei bufSize,
+                            GLsizei* length,
+                            GLenum* binaryFormat,
+                            void* binary) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetProgramBinaryOES,
+                          glGetProgramBinaryOES,
+                          PFNIGLGETPROGRAMBINARYPROC,
+                          program,
+                          bufSize,
+                          length,
+                          binaryFormat,
+                          binary);
+}
+
+void iglProgramBinaryOES(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glProgramBinaryOES,
+                          glProgramBinaryOES,
+                          PFNIGLPROGRAMBINARYPROC,
+                          program,
+                          binaryFormat,
+                          binary,
+                          length);
+}
+
 ///--------------------------------------
 /// MARK: - GL_OES_mapbuffer
 
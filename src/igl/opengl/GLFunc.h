@@ -54,9 +54,14 @@ using PFNIGLBLITFRAMEBUFFERPROC = void (*)(GLint srcX0,
                                            GLint dstY1,
                                            GLbitfield mask,
                                            GLenum filter);
+using PFNIGLBUFFERSTORAGEPROC = void (*)(GLenum target,
+                                         GLsizeiptr size,
+                                         const GLvoid* data,
+                                         GLbitfield flags);
 using PFNIGLCHECKFRAMEBUFFERSTATUSPROC = GLenum (*)(GLenum target);
 using PFNIGLCLEARDEPTHPROC = void (*)(GLdouble depth);
 using PFNIGLCLEARDEPTHFPROC = void (*)(GLfloat depth);
+using PFNIGLCLIENTWAITSYNCPROC = GLenum (*)(GLsync sync, GLbitfield flags, GLuint64 timeout);
 using PFNIGLCOMPRESSEDTEXIMAGE3DPROC = void (*)(GLenum target,
                                                 GLint level,
                                                 GLenum internalformat,
@@ -94,6 +99,7 @@ using PFNIGLDEBUGMESSAGEINSERTPROC = void (*)(GLenum source,
                                               const GLchar* buf);
 using PFNIGLDELETEFRAMEBUFFERSPROC = void (*)(GLsizei n, const GLuint* framebuffers);
 using PFNIGLDELETEMEMORYOBJECTSPROC = void (*)(GLsizei n, const GLuint* memoryObjects);
+using PFNIGLDELETEQUERIESPROC = void (*)(GLsizei n, const GLuint* ids);
 using PFNIGLDELETERENDERBUFFERSPROC = void (*)(GLsizei n, const GLuint* renderbuffers);
 using PFNIGLDELETESYNCPROC = void (*)(GLsync sync);
 using PFNIGLDELETEVERTEXARRAYSPROC = void (*)(GLsizei n, const GLuint* vertexArrays);
@@ -134,6 +140,7 @@ using PFNIGLFRAMEBUFFERTEXTUREMULTIVIEWPROC = void (*)(GLenum target,
                                                        GLsizei numViews);
 using PFNIGLGENERATEMIPMAPPROC = void (*)(GLenum target);
 using PFNIGLGENFRAMEBUFFERSPROC = void (*)(GLsizei n, GLuint* framebuffers);
+using PFNIGLGENQUERIESPROC = void (*)(GLsizei n, GLuint* ids);
 using PFNIGLGENRENDERBUFFERSPROC = void (*)(GLsizei n, GLuint* renderbuffers);
 using PFNIGLGENVERTEXARRAYSPROC = void (*)(GLsizei n, GLuint* vertexArrays);
 using PFNIGLGETACTIVEUNIFORMSIVPROC = void (*)(GLuint program,
@@ -162,6 +169,11 @@ using PFNIGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC = void (*)(GLenum target,
                                                                GLenum attachment,
                                                                GLenum pname,
                                                                GLint* params);
+using PFNIGLGETPROGRAMBINARYPROC = void (*)(GLuint program,
+                                            GLsizei bufSize,
+                                            GLsizei* length,
+                                            GLenum* binaryFormat,
+                                            void* binary);
 using PFNIGLGETPROGRAMINTERFACEIVPROC = void (*)(GLuint program,
                                                  GLenum programInterface,
                                                  GLenum pname,
@@ -183,6 +195,8 @@ using PFNIGLGETPROGRAMRESOURCENAMEPROC = void (*)(GLuint program,
                                                   GLsizei bufSize,
                                                   GLsizei* length,
                                                   char* name);
+using PFNIGLGETQUERYOBJECTUIVPROC = void (*)(GLuint id, GLenum pname, GLuint* params);
+using PFNIGLGETQUERYOBJECTUI64VPROC = void (*)(GLuint id, GLenum pname, GLuint64* params);
 using PFNIGLGETRENDERBUFFERPARAMETERIVPROC = void (*)(GLenum target, GLenum pname, GLint* params);
 using PFNIGLGETSTRINGIPROC = const GLubyte* (*)(GLenum name, GLuint index);
 using PFNIGLGETSYNCIVPROC =
@@ -206,11 +220,26 @@ using PFNIGLMAPBUFFERRANGEPROC = void* (*)(GLenum target,
                                            GLintptr offset,
                                            GLsizeiptr length,
                                            GLbitfield access);
+using PFNIGLMAXSHADERCOMPILERTHREADSPROC = void (*)(GLuint count);
 using PFNIGLMEMORYBARRIERPROC = void (*)(GLbitfield barriers);
+using PFNIGLMULTIDRAWARRAYSINDIRECTPROC = void (*)(GLenum mode,
+                                                   const GLvoid* indirect,
+                                                   GLsizei drawcount,
+                                                   GLsizei stride);
+using PFNIGLMULTIDRAWELEMENTSINDIRECTPROC = void (*)(GLenum mode,
+                                                     GLenum type,
+                                                     const GLvoid* indirect,
+                                                     GLsizei drawcount,
+                                                     GLsizei stride);
 using PFNIGLOBJECTLABELPROC = void (*)(GLenum identifier,
                                        GLuint name,
                                        GLsizei length,
                                        const char* label);
+using PFNIGLPROGRAMBINARYPROC = void (*)(GLuint program,
+                                         GLenum binaryFormat,
+                                         const void* binary,
+                                         GLsizei length);
+using PFNIGLPROGRAMPARAMETERIPROC = void (*)(GLuint program, GLenum pname, GLint value);
 using PFNIGLPOPDEBUGGROUPPROC = void (*)();
 using PFNIGLPOPGROUPMARKERPROC = void (*)();
 using PFNIGLPUSHDEBUGGROUPPROC = void (*)(GLenum source,
@@ -218,6 +247,7 @@ using PFNIGLPUSHDEBUGGROUPPROC = void (*)(GLenum source,
                                           GLsizei length,
                                           const GLchar* message);
 using PFNIGLPUSHGROUPMARKERPROC = void (*)(GLsizei length, const GLchar* marker);
+using PFNIGLQUERYCOUNTERPROC = void (*)(GLuint id, GLenum target);
 using PFNIGLRENDERBUFFERSTORAGEPROC = void (*)(GLenum target,
                                                GLenum internalformat,
                                                GLsizei width,
@@ -376,6 +406,7 @@ void iglRenderbufferStorageMultisampleAPPLE(GLenum target,
 ///--------------------------------------
 /// MARK: - GL_APPLE_sync
 
+GLenum iglClientWaitSyncAPPLE(GLsync sync, GLbitfield flags, GLuint64 timeout);
 void iglDeleteSyncAPPLE(GLsync sync);
 GLsync iglFenceSyncAPPLE(GLenum condition, GLbitfield flags);
 void iglGetSyncivAPPLE(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei* length, GLint* values);
@@ -387,6 +418,11 @@ GLuint64 iglGetTextureHandleARB(GLuint texture);
 void iglMakeTextureHandleResidentARB(GLuint64 handle);
 void iglMakeTextureHandleNonResidentARB(GLuint64 handle);
 
+///--------------------------------------
+/// MARK: - GL_ARB_buffer_storage
+
+void iglBufferStorage(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_compute_shader
 
@@ -453,6 +489,17 @@ void iglRenderbufferStorageMultisample(GLenum target,
                                        GLsizei width,
                                        GLsizei height);
 
+///--------------------------------------
+/// MARK: - GL_ARB_get_program_binary
+
+void iglGetProgramBinary(GLuint program,
+                         GLsizei bufSize,
+                         GLsizei* length,
+                         GLenum* binaryFormat,
+                         void* binary);
+void iglProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+void iglProgramParameteri(GLuint program, GLenum pname, GLint value);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_invalidate_subdata
 
@@ -463,6 +510,24 @@ void iglInvalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenu
 
 void* iglMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 
+///--------------------------------------
+/// MARK: - GL_ARB_multi_draw_indirect
+
+void iglMultiDrawArraysIndirect(GLenum mode,
+                                const GLvoid* indirect,
+                                GLsizei drawcount,
+                                GLsizei stride);
+void iglMultiDrawElementsIndirect(GLenum mode,
+                                  GLenum type,
+                                  const GLvoid* indirect,
+                                  GLsizei drawcount,
+                                  GLsizei stride);
+
+///--------------------------------------
+/// MARK: - GL_ARB_parallel_shader_compile
+
+void iglMaxShaderCompilerThreadsARB(GLuint count);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_program_interface_query
 
@@ -498,6 +563,7 @@ void iglMemoryBarrier(GLbitfield barriers);
 ///--------------------------------------
 /// MARK: - GL_ARB_sync
 
+GLenum iglClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout);
 void iglDeleteSync(GLsync sync);
 GLsync iglFenceSync(GLenum condition, GLbitfield flags);
 void iglGetSynciv(GLsync sync, GLenum pname, GLsizei bufSize, GLsizei* length, GLint* values);
@@ -518,6 +584,15 @@ void iglTexStorage3D(GLenum target,
                      GLsizei height,
                      GLsizei depth);
 
+///--------------------------------------
+/// MARK: - GL_ARB_timer_query
+
+void iglDeleteQueries(GLsizei n, const GLuint* ids);
+void iglGenQueries(GLsizei n, GLuint* ids);
+void iglGetQueryObjectuiv(GLuint id, GLenum pname, GLuint* params);
+void iglGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params);
+void iglQueryCounter(GLuint id, GLenum target);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_uniform_buffer_object
 
@@ -553,6 +628,11 @@ void iglGenVertexArrays(GLsizei n, GLuint* vertexArrays);
 
 void iglPolygonOffsetClamp(float factor, float units, float clamp);
 
+///--------------------------------------
+/// MARK: - GL_EXT_buffer_storage
+
+void iglBufferStorageEXT(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags);
+
 ///--------------------------------------
 /// MARK: - GL_EXT_debug_label
 
@@ -578,6 +658,15 @@ void iglPushGroupMarkerEXT(GLenum source, GLuint id, GLsizei length, const GLcha
 
 void iglDiscardFramebufferEXT(GLenum target, GLsizei numAttachments, const GLenum* attachments);
 
+///--------------------------------------
+/// MARK: - GL_EXT_disjoint_timer_query
+
+void iglDeleteQueriesEXT(GLsizei n, const GLuint* ids);
+void iglGenQueriesEXT(GLsizei n, GLuint* ids);
+void iglGetQueryObjectuivEXT(GLuint id, GLenum pname, GLuint* params);
+void iglGetQueryObjectui64vEXT(GLuint id, GLenum pname, GLuint64* params);
+void iglQueryCounterEXT(GLuint id, GLenum target);
+
 ///--------------------------------------
 /// MARK: - GL_EXT_draw_buffers
 
@@ -628,6 +717,19 @@ void iglTexStorageMem3DEXT(GLenum target,
 
 void iglImportMemoryFdEXT(GLuint memory, GLuint64 size, GLenum handleType, GLint fd);
 
+///--------------------------------------
+/// MARK: - GL_EXT_multi_draw_indirect
+
+void iglMultiDrawArraysIndirectEXT(GLenum mode,
+                                   const GLvoid* indirect,
+                                   GLsizei drawcount,
+                                   GLsizei stride);
+void iglMultiDrawElementsIndirectEXT(GLenum mode,
+                                     GLenum type,
+                                     const GLvoid* indirect,
+                                     GLsizei drawcount,
+                                     GLsizei stride);
+
 ///--------------------------------------
 /// MARK: - GL_EXT_multisampled_render_to_texture
 
@@ -708,6 +810,11 @@ void iglObjectLabelKHR(GLenum identifier, GLuint name, GLsizei length, const cha
 void iglPopDebugGroupKHR();
 void iglPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar* message);
 
+///--------------------------------------
+/// MARK: - GL_KHR_parallel_shader_compile
+
+void iglMaxShaderCompilerThreadsKHR(GLuint count);
+
 ///--------------------------------------
 /// MARK: - GL_NV_bindless_texture
 
@@ -740,6 +847,16 @@ void iglFramebufferTextureMultisampleMultiviewOVR(GLenum target,
                                                   GLsizei samples,
                                                   GLint baseViewIndex,
                                                   GLsizei numViews);
+///--------------------------------------
+/// MARK: - GL_OES_get_program_binary
+
+void iglGetProgramBinaryOES(GLuint program,
+                            GLsizei bufSize,
+                            GLsizei* length,
+                            GLenum* binaryFormat,
+                            void* binary);
+void iglProgramBinaryOES(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+
 ///--------------------------------------
 /// MARK: - GL_OES_mapbuffer
 
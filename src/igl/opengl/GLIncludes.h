@@ -97,6 +97,9 @@
 #ifndef GL_ACTIVE_RESOURCES
 #define GL_ACTIVE_RESOURCES 0x92f5
 #endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911a
+#endif
 #ifndef GL_ALPHA_BITS
 #define GL_ALPHA_BITS 0xd55
 #endif
@@ -130,12 +133,21 @@
 #ifndef GL_BUFFER_UPDATE_BARRIER_BIT
 #define GL_BUFFER_UPDATE_BARRIER_BIT 0x200
 #endif
+#ifndef GL_CLIENT_STORAGE_BIT
+#define GL_CLIENT_STORAGE_BIT 0x200
+#endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911c
+#endif
 #ifndef GL_COLOR_ATTACHMENT1
 #define GL_COLOR_ATTACHMENT1 0x8ce1
 #endif
 #ifndef GL_COMPARE_REF_TO_TEXTURE
 #define GL_COMPARE_REF_TO_TEXTURE 0x884e
 #endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 #ifndef GL_COMPRESSED_R11_EAC
 #define GL_COMPRESSED_R11_EAC 0x9270
 #endif
@@ -373,6 +385,9 @@
 #ifndef GL_DYNAMIC_READ
 #define GL_DYNAMIC_READ 0x88e9
 #endif
+#ifndef GL_DYNAMIC_STORAGE_BIT
+#define GL_DYNAMIC_STORAGE_BIT 0x100
+#endif
 #ifndef GL_ELEMENT_ARRAY_BARRIER_BIT
 #define GL_ELEMENT_ARRAY_BARRIER_BIT 0x2
 #endif
@@ -430,6 +445,9 @@
 #ifndef GL_GREEN
 #define GL_GREEN 0x1904
 #endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
 #ifndef GL_HALF_FLOAT
 #define GL_HALF_FLOAT 0x140B
 #endif
@@ -490,9 +508,30 @@
 #ifndef GL_LUMINANCE8_ALPHA8
 #define GL_LUMINANCE8_ALPHA8 0x8045
 #endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x80
+#endif
+#ifndef GL_MAP_FLUSH_EXPLICIT_BIT
+#define GL_MAP_FLUSH_EXPLICIT_BIT 0x10
+#endif
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x8
+#endif
+#ifndef GL_MAP_INVALIDATE_RANGE_BIT
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x4
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x40
+#endif
 #ifndef GL_MAP_READ_BIT
 #define GL_MAP_READ_BIT 0x1
 #endif
+#ifndef GL_MAP_UNSYNCHRONIZED_BIT
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x20
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x2
+#endif
 #ifndef GL_MAX
 #define GL_MAX 0x8008
 #endif
@@ -532,6 +571,9 @@
 #ifndef GL_NUM_EXTENSIONS
 #define GL_NUM_EXTENSIONS 0x821d
 #endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87fe
+#endif
 #ifndef GL_PACK_ROW_LENGTH
 #define GL_PACK_ROW_LENGTH 0x0d02
 #endif
@@ -544,9 +586,21 @@
 #ifndef GL_PROGRAM
 #define GL_PROGRAM 0x82e2
 #endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
 #ifndef GL_PROGRAM_OBJECT_EXT
 #define GL_PROGRAM_OBJECT_EXT 0x8B40
 #endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT 0x8866
+#endif
+#ifndef GL_QUERY_RESULT_AVAILABLE
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#endif
 #ifndef GL_R16
 #define GL_R16 0x822A
 #endif
@@ -709,6 +763,9 @@
 #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
 #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
 #endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x1
+#endif
 #ifndef GL_SYNC_STATUS
 #define GL_SYNC_STATUS 0x9114
 #endif
@@ -778,9 +835,15 @@
 #ifndef GL_TEXTURE_WRAP_R
 #define GL_TEXTURE_WRAP_R 0x8072
 #endif
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED 0x911b
+#endif
 #ifndef GL_TRANSFORM_FEEDBACK_BUFFER
 #define GL_TRANSFORM_FEEDBACK_BUFFER 0x8c8e
 #endif
+#ifndef GL_UNIFORM_ARRAY_STRIDE
+#define GL_UNIFORM_ARRAY_STRIDE 0x8a3c
+#endif
 #ifndef GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES
 #define GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES 0x8a43
 #endif
@@ -796,6 +859,9 @@
 #ifndef GL_UNIFORM_BUFFER
 #define GL_UNIFORM_BUFFER 0x8a11
 #endif
+#ifndef GL_UNIFORM_MATRIX_STRIDE
+#define GL_UNIFORM_MATRIX_STRIDE 0x8a3d
+#endif
 #ifndef GL_UNIFORM_OFFSET
 #define GL_UNIFORM_OFFSET 0x8a3b
 #endif
@@ -838,3 +904,6 @@
 #ifndef GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT
 #define GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT 0x1
 #endif
+#ifndef GL_WAIT_FAILED
+#define GL_WAIT_FAILED 0x911d
+#endif
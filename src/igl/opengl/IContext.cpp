@@ -749,6 +749,16 @@ void IContext::willDestroy(void* glContext) {
   // Clear pool explicitly, since it might have reference back to IContext.
   getAdapterPool().clear();
   getComputeAdapterPool().clear();
+  setVertexArrayObjectCacheEnabled(false);
+  setPixelUnpackBufferRingEnabled(false);
+  if (uniformBatchBuffer_) {
+    uniformBatchBuffer_->clear(*this);
+    uniformBatchBuffer_ = nullptr;
+  }
+  if (pixelPackBufferPool_) {
+    pixelPackBufferPool_->clear(*this);
+    pixelPackBufferPool_ = nullptr;
+  }
   // Unregister context
   if (glContext != nullptr) {
     IContext::unregisterContext((void*)glContext);
@@ -770,6 +780,9 @@ bool IContext::shouldQueueAPI() const {
 }
 
 void IContext::activeTexture(GLenum texture) {
+  if (stateCache_ && !stateCache_->activeTexture(texture)) {
+    return;
+  }
   GLCALL(ActiveTexture)(texture);
   APILOG("glActiveTexture(%s)\n", GL_ENUM_TO_STRING(texture));
   GLCHECK_ERRORS();
@@ -782,6 +795,12 @@ void IContext::attachShader(GLuint program, GLuint shader) {
 }
 
 void IContext::bindBuffer(GLenum target, GLuint buffer) {
+  if (stateCache_ && !stateCache_->bindBuffer(target, buffer)) {
+    return;
+  }
+  if (vertexArrayObjectCache_ && target == GL_ELEMENT_ARRAY_BUFFER) {
+    vertexArrayObjectCache_->onElementArrayBufferBound(buffer);
+  }
   GLCALL(BindBuffer)(target, buffer);
   APILOG("glBindBuffer(%s, %u)\n", GL_ENUM_TO_STRING(target), buffer);
   GLCHECK_ERRORS();
@@ -789,6 +808,10 @@ void IContext::bindBuffer(GLenum target, GLuint buffer) {
 
 void IContext::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
   IGLCALL(BindBufferBase)(target, index, buffer);
+  if (stateCache_) {
+    // the generic binding point of `target` now refers to `buffer`
+    stateCache_->invalidateBuffer(target);
+  }
   APILOG("glBindBufferBase(%s, %u, %u)\n", GL_ENUM_TO_STRING(target), index, buffer);
   GLCHECK_ERRORS();
 }
@@ -799,6 +822,10 @@ void IContext::bindBufferRange(GLenum target,
                                GLintptr offset,
                                GLsizeiptr size) {
   IGLCALL(BindBufferRange)(target, index, buffer, offset, size);
+  if (stateCache_) {
+    // the generic binding point of `target` now refers to `buffer`
+    stateCache_->invalidateBuffer(target);
+  }
   APILOG("glBindBufferRange(%s, %u, %u)\n", GL_ENUM_TO_STRING(target), index, buffer);
   GLCHECK_ERRORS();
 }
@@ -816,6 +843,9 @@ void IContext::bindRenderbuffer(GLenum target, GLuint renderbuffer) {
 }
 
 void IContext::bindTexture(GLenum target, GLuint texture) {
+  if (stateCache_ && !stateCache_->bindTexture(target, texture)) {
+    return;
+  }
   GLCALL(BindTexture)(target, texture);
   APILOG("glBindTexture(%s, %u)\n", GL_ENUM_TO_STRING(target), texture);
   GLCHECK_ERRORS();
@@ -861,24 +891,39 @@ void IContext::bindVertexArray(GLuint vao) {
     }
     IGL_DEBUG_ASSERT(bindVertexArrayProc_, "No supported function for glBindVertexArray\n");
   }
+  if (vertexArrayObjectCache_) {
+    vertexArrayObjectCache_->onVertexArrayBound(vao);
+  }
+  if (stateCache_ && !stateCache_->bindVertexArray(vao)) {
+    return;
+  }
   GLCALL_PROC(bindVertexArrayProc_, vao);
   APILOG("glBindVertexArray(%u)\n", vao);
   GLCHECK_ERRORS();
 }
 
 void IContext::blendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+  if (stateCache_ && !stateCache_->blendColor(red, green, blue, alpha)) {
+    return;
+  }
   GLCALL(BlendColor)(red, green, blue, alpha);
   APILOG("glBlendColor(%f, %f, %f, %f)\n", red, green, blue, alpha);
   GLCHECK_ERRORS();
 }
 
 void IContext::blendEquation(GLenum mode) {
+  if (stateCache_ && !stateCache_->blendEquationSeparate(mode, mode)) {
+    return;
+  }
   GLCALL(BlendEquation)(mode);
   APILOG("glBlendEquation(%s)\n", GL_ENUM_TO_STRING(mode));
   GLCHECK_ERRORS();
 }
 
 void IContext::blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+  if (stateCache_ && !stateCache_->blendEquationSeparate(modeRGB, modeAlpha)) {
+    return;
+  }
   GLCALL(BlendEquationSeparate)(modeRGB, modeAlpha);
   APILOG("glBlendEquationSeparate(%s, %s)\n",
          GL_ENUM_TO_STRING(modeRGB),
@@ -887,12 +932,18 @@ void IContext::blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
 }
 
 void IContext::blendFunc(GLenum sfactor, GLenum dfactor) {
+  if (stateCache_ && !stateCache_->blendFuncSeparate(sfactor, dfactor, sfactor, dfactor)) {
+    return;
+  }
   GLCALL(BlendFunc)(sfactor, dfactor);
   APILOG("glBlendFunc(%s, %s)\n", GL_ENUM_TO_STRING(sfactor), GL_ENUM_TO_STRING(dfactor));
   GLCHECK_ERRORS();
 }
 
 void IContext::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+  if (stateCache_ && !stateCache_->blendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha)) {
+    return;
+  }
   GLCALL(BlendFuncSeparate)(srcRGB, dstRGB, srcAlpha, dstAlpha);
   APILOG("glBlendFuncSeparate(%s, %s, %s, %s)\n",
          GL_ENUM_TO_STRING(srcRGB),
@@ -948,6 +999,22 @@ void IContext::bufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GL
   GLCHECK_ERRORS();
 }
 
+void IContext::bufferStorage(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags) {
+  if (bufferStorageProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::BufferStorageExtReq)) {
+      if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::BufferStorage)) {
+        bufferStorageProc_ = iglBufferStorageEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::BufferStorage)) {
+      bufferStorageProc_ = iglBufferStorage;
+    }
+    IGL_DEBUG_ASSERT(bufferStorageProc_, "No supported function for glBufferStorage\n");
+  }
+  GLCALL_PROC(bufferStorageProc_, target, size, data, flags);
+  APILOG("glBufferStorage(%s, %zu, %p, 0x%x)\n", GL_ENUM_TO_STRING(target), size, data, flags);
+  GLCHECK_ERRORS();
+}
+
 void IContext::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data) {
   GLCALL(BufferSubData)(target, offset, size, data);
   APILOG("glBufferSubData(%s, %zu, %zu, %p)\n", GL_ENUM_TO_STRING(target), offset, size, data);
@@ -999,7 +1066,32 @@ void IContext::clearStencil(GLint s) {
   GLCHECK_ERRORS();
 }
 
+GLenum IContext::clientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout) {
+  if (clientWaitSyncProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::SyncExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::Sync)) {
+        clientWaitSyncProc_ = iglClientWaitSyncAPPLE;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::Sync)) {
+      clientWaitSyncProc_ = iglClientWaitSync;
+    }
+    IGL_DEBUG_ASSERT(clientWaitSyncProc_, "No supported function for glClientWaitSync\n");
+  }
+  GLenum ret = GL_WAIT_FAILED;
+  GLCALL_PROC_WITH_RETURN(ret, clientWaitSyncProc_, GL_WAIT_FAILED, sync, flags, timeout);
+  APILOG("glClientWaitSync(%p, %u, %llu) = %s\n",
+         sync,
+         flags,
+         static_cast<unsigned long long>(timeout),
+         GL_ENUM_TO_STRING(ret));
+  GLCHECK_ERRORS();
+  return ret;
+}
+
 void IContext::colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+  if (stateCache_ && !stateCache_->colorMask(red, green, blue, alpha)) {
+    return;
+  }
   GLCALL(ColorMask)(red, green, blue, alpha);
   APILOG("glColorMask(%s, %s, %s, %s)\n",
          GL_BOOL_TO_STRING(red),
@@ -1224,6 +1316,9 @@ GLuint IContext::createShader(GLenum shaderType) {
 }
 
 void IContext::cullFace(GLint mode) {
+  if (stateCache_ && !stateCache_->cullFace(mode)) {
+    return;
+  }
   GLCALL(CullFace)(mode);
   APILOG("glCullFace(%s)\n", GL_ENUM_TO_STRING(mode));
   GLCHECK_ERRORS();
@@ -1288,6 +1383,12 @@ void IContext::deleteBuffers(GLsizei n, const GLuint* buffers) {
       deletionQueues_.queueDeleteBuffers(n, buffers);
     } else {
       GLCALL(DeleteBuffers)(n, buffers);
+      if (stateCache_) {
+        stateCache_->onBuffersDeleted(n, buffers);
+      }
+      if (vertexArrayObjectCache_) {
+        vertexArrayObjectCache_->onBuffersDeleted(*this, n, buffers);
+      }
       APILOG("glDeleteBuffers(%u, %p)\n", n, buffers);
       GLCHECK_ERRORS();
     }
@@ -1326,12 +1427,34 @@ void IContext::deleteProgram(GLuint program) {
       deletionQueues_.queueDeleteProgram(program);
     } else {
       GLCALL(DeleteProgram)(program);
+      if (stateCache_) {
+        stateCache_->onProgramDeleted(program);
+      }
       APILOG("glDeleteProgram(%u)\n", program);
       GLCHECK_ERRORS();
     }
   }
 }
 
+void IContext::deleteQueries(GLsizei n, const GLuint* ids) {
+  if (deleteQueriesProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        deleteQueriesProc_ = iglDeleteQueriesEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      deleteQueriesProc_ = iglDeleteQueries;
+    }
+    IGL_DEBUG_ASSERT(deleteQueriesProc_, "No supported function for glDeleteQueries\n");
+  }
+
+  if (isDestructionAllowed() && IGL_DEBUG_VERIFY(ids != nullptr)) {
+    GLCALL_PROC(deleteQueriesProc_, n, ids);
+    APILOG("glDeleteQueries(%u, %p)\n", n, ids);
+    GLCHECK_ERRORS();
+  }
+}
+
 void IContext::deleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
   if (isDestructionAllowed() && IGL_DEBUG_VERIFY(renderbuffers != nullptr)) {
     if (shouldQueueAPI()) {
@@ -1360,6 +1483,9 @@ void IContext::deleteVertexArrays(GLsizei n, const GLuint* vertexArrays) {
       deletionQueues_.queueDeleteVertexArrays(n, vertexArrays);
     } else {
       GLCALL_PROC(deleteVertexArraysProc_, n, vertexArrays);
+      if (stateCache_) {
+        stateCache_->onVertexArraysDeleted(n, vertexArrays);
+      }
       APILOG("glDeleteVertexArrays(%u, %p)\n", n, vertexArrays);
       GLCHECK_ERRORS();
     }
@@ -1401,6 +1527,9 @@ void IContext::deleteTextures(const std::vector<GLuint>& textures) {
       deletionQueues_.queueDeleteTextures(textures);
     } else {
       GLCALL(DeleteTextures)(static_cast<GLsizei>(textures.size()), textures.data());
+      if (stateCache_) {
+        stateCache_->onTexturesDeleted(static_cast<GLsizei>(textures.size()), textures.data());
+      }
       APILOG("glDeleteTextures(%u, %p)\n", textures.size(), textures.data());
       GLCHECK_ERRORS();
     }
@@ -1408,12 +1537,18 @@ void IContext::deleteTextures(const std::vector<GLuint>& textures) {
 }
 
 void IContext::depthFunc(GLenum func) {
+  if (stateCache_ && !stateCache_->depthFunc(func)) {
+    return;
+  }
   GLCALL(DepthFunc)(func);
   APILOG("glDepthFunc(%s)\n", GL_ENUM_TO_STRING(func));
   GLCHECK_ERRORS();
 }
 
 void IContext::depthMask(GLboolean flag) {
+  if (stateCache_ && !stateCache_->depthMask(flag)) {
+    return;
+  }
   GLCALL(DepthMask)(flag);
   APILOG("glDepthMask(%s)\n", GL_BOOL_TO_STRING(flag));
   GLCHECK_ERRORS();
@@ -1432,6 +1567,9 @@ void IContext::detachShader(GLuint program, GLuint shader) {
 }
 
 void IContext::disable(GLenum cap) {
+  if (stateCache_ && !stateCache_->setEnabled(cap, false)) {
+    return;
+  }
   GLCALL(Disable)(cap);
   APILOG("glDisable(%s)\n", GL_ENUM_TO_STRING(cap));
   GLCHECK_ERRORS();
@@ -1552,6 +1690,9 @@ void IContext::drawElementsIndirect(GLenum mode, GLenum type, const GLvoid* indi
 }
 
 void IContext::enable(GLenum cap) {
+  if (stateCache_ && !stateCache_->setEnabled(cap, true)) {
+    return;
+  }
   GLCALL(Enable)(cap);
   APILOG("glEnable(%s)\n", GL_ENUM_TO_STRING(cap));
   GLCHECK_ERRORS();
@@ -1697,6 +1838,9 @@ void IContext::framebufferTextureLayer(GLenum target,
 }
 
 void IContext::frontFace(GLenum mode) {
+  if (stateCache_ && !stateCache_->frontFace(mode)) {
+    return;
+  }
   GLCALL(FrontFace)(mode);
   APILOG("glFrontFace(%s)\n", GL_ENUM_TO_STRING(mode));
   GLCHECK_ERRORS();
@@ -1733,6 +1877,23 @@ void IContext::genFramebuffers(GLsizei n, GLuint* framebuffers) {
   GLCHECK_ERRORS();
 }
 
+void IContext::genQueries(GLsizei n, GLuint* ids) {
+  if (genQueriesProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        genQueriesProc_ = iglGenQueriesEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      genQueriesProc_ = iglGenQueries;
+    }
+    IGL_DEBUG_ASSERT(genQueriesProc_, "No supported function for glGenQueries\n");
+  }
+
+  GLCALL_PROC(genQueriesProc_, n, ids);
+  APILOG("glGenQueries(%u, %p) = %u\n", n, ids, ids == nullptr ? 0 : *ids);
+  GLCHECK_ERRORS();
+}
+
 void IContext::genRenderbuffers(GLsizei n, GLuint* renderbuffers) {
   IGLCALL(GenRenderbuffers)(n, renderbuffers);
   APILOG("glGenRenderbuffers(%u, %p) = %u\n",
@@ -1978,6 +2139,32 @@ void IContext::getProgramiv(GLuint program, GLenum pname, GLint* params) const {
   GLCHECK_ERRORS();
 }
 
+void IContext::getProgramBinary(GLuint program,
+                                GLsizei bufSize,
+                                GLsizei* length,
+                                GLenum* binaryFormat,
+                                void* binary) const {
+  if (getProgramBinaryProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::ProgramBinaryExtReq)) {
+      if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::ProgramBinary)) {
+        getProgramBinaryProc_ = iglGetProgramBinaryOES;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::ProgramBinary)) {
+      getProgramBinaryProc_ = iglGetProgramBinary;
+    }
+    IGL_DEBUG_ASSERT(getProgramBinaryProc_, "No supported function for glGetProgramBinary\n");
+  }
+
+  GLCALL_PROC(getProgramBinaryProc_, program, bufSize, length, binaryFormat, binary);
+  APILOG("glGetProgramBinary(%u, %d, %p, %p, %p)\n",
+         program,
+         bufSize,
+         length,
+         binaryFormat,
+         binary);
+  GLCHECK_ERRORS();
+}
+
 void IContext::getProgramInterfaceiv(GLuint program,
                                      GLenum programInterface,
                                      GLenum pname,
@@ -2046,6 +2233,49 @@ void IContext::getProgramResourceName(GLuint program,
   GLCHECK_ERRORS();
 }
 
+void IContext::getQueryObjectuiv(GLuint id, GLenum pname, GLuint* params) const {
+  if (getQueryObjectuivProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        getQueryObjectuivProc_ = iglGetQueryObjectuivEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      getQueryObjectuivProc_ = iglGetQueryObjectuiv;
+    }
+    IGL_DEBUG_ASSERT(getQueryObjectuivProc_, "No supported function for glGetQueryObjectuiv\n");
+  }
+
+  GLCALL_PROC(getQueryObjectuivProc_, id, pname, params);
+  APILOG("glGetQueryObjectuiv(%u, %s, %p) = %u\n",
+         id,
+         GL_ENUM_TO_STRING(pname),
+         params,
+         params == nullptr ? 0 : *params);
+  GLCHECK_ERRORS();
+}
+
+void IContext::getQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) const {
+  if (getQueryObjectui64vProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        getQueryObjectui64vProc_ = iglGetQueryObjectui64vEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      getQueryObjectui64vProc_ = iglGetQueryObjectui64v;
+    }
+    IGL_DEBUG_ASSERT(getQueryObjectui64vProc_,
+                     "No supported function for glGetQueryObjectui64v\n");
+  }
+
+  GLCALL_PROC(getQueryObjectui64vProc_, id, pname, params);
+  APILOG("glGetQueryObjectui64v(%u, %s, %p) = %llu\n",
+         id,
+         GL_ENUM_TO_STRING(pname),
+         params,
+         params == nullptr ? 0ull : static_cast<unsigned long long>(*params));
+  GLCHECK_ERRORS();
+}
+
 void IContext::getShaderiv(GLuint shader, GLenum pname, GLint* params) const {
   GLCALL(GetShaderiv)(shader, pname, params);
   APILOG("glGetShaderiv(%u, %s, %p) = %d\n",
@@ -2245,6 +2475,84 @@ void* IContext::mapBufferRange(GLenum target,
   return ret;
 }
 
+void IContext::maxShaderCompilerThreads(GLuint count) {
+  if (maxShaderCompilerThreadsProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::ParallelShaderCompile)) {
+      if (deviceFeatureSet_.hasInternalRequirement(
+              InternalRequirement::ParallelShaderCompileArbReq)) {
+        maxShaderCompilerThreadsProc_ = iglMaxShaderCompilerThreadsARB;
+      } else {
+        maxShaderCompilerThreadsProc_ = iglMaxShaderCompilerThreadsKHR;
+      }
+    }
+    IGL_DEBUG_ASSERT(maxShaderCompilerThreadsProc_,
+                     "No supported function for glMaxShaderCompilerThreadsKHR\n");
+  }
+  GLCALL_PROC(maxShaderCompilerThreadsProc_, count);
+  APILOG("glMaxShaderCompilerThreadsKHR(%u)\n", count);
+  GLCHECK_ERRORS();
+}
+
+void IContext::multiDrawArraysIndirect(GLenum mode,
+                                       const GLvoid* indirect,
+                                       GLsizei drawcount,
+                                       GLsizei stride) {
+  if (multiDrawArraysIndirectProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::MultiDrawIndirect)) {
+      if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::MultiDrawIndirectExtReq)) {
+        multiDrawArraysIndirectProc_ = iglMultiDrawArraysIndirectEXT;
+      } else {
+        multiDrawArraysIndirectProc_ = iglMultiDrawArraysIndirect;
+      }
+    }
+    IGL_DEBUG_ASSERT(multiDrawArraysIndirectProc_,
+                     "No supported function for glMultiDrawArraysIndirect\n");
+  }
+  drawCallCount_++;
+
+  IGL_PROFILER_ZONE_GPU_COLOR_OGL("multiDrawArraysIndirect()", IGL_PROFILER_COLOR_DRAW);
+
+  GLCALL_PROC(multiDrawArraysIndirectProc_, mode, indirect, drawcount, stride);
+  APILOG("glMultiDrawArraysIndirect(%s, %p, %d, %d)\n",
+         GL_ENUM_TO_STRING(mode),
+         indirect,
+         drawcount,
+         stride);
+  GLCHECK_ERRORS();
+  APILOG_DEC_DRAW_COUNT();
+}
+
+void IContext::multiDrawElementsIndirect(GLenum mode,
+                                         GLenum type,
+                                         const GLvoid* indirect,
+                                         GLsizei drawcount,
+                                         GLsizei stride) {
+  if (multiDrawElementsIndirectProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::MultiDrawIndirect)) {
+      if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::MultiDrawIndirectExtReq)) {
+        multiDrawElementsIndirectProc_ = iglMultiDrawElementsIndirectEXT;
+      } else {
+        multiDrawElementsIndirectProc_ = iglMultiDrawElementsIndirect;
+      }
+    }
+    IGL_DEBUG_ASSERT(multiDrawElementsIndirectProc_,
+                     "No supported function for glMultiDrawElementsIndirect\n");
+  }
+  drawCallCount_++;
+
+  IGL_PROFILER_ZONE_GPU_COLOR_OGL("multiDrawElementsIndirect()", IGL_PROFILER_COLOR_DRAW);
+
+  GLCALL_PROC(multiDrawElementsIndirectProc_, mode, type, indirect, drawcount, stride);
+  APILOG("glMultiDrawElementsIndirect(%s, %s, %p, %d, %d)\n",
+         GL_ENUM_TO_STRING(mode),
+         GL_ENUM_TO_STRING(type),
+         indirect,
+         drawcount,
+         stride);
+  GLCHECK_ERRORS();
+  APILOG_DEC_DRAW_COUNT();
+}
+
 void IContext::objectLabel(GLenum identifier, GLuint name, GLsizei length, const char* label) {
   if (objectLabelProc_ == nullptr) {
     if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::DebugLabelExtReq)) {
@@ -2286,6 +2594,45 @@ void IContext::polygonOffsetClamp(GLfloat factor, GLfloat units, float clamp) {
   GLCHECK_ERRORS();
 }
 
+void IContext::programBinary(GLuint program,
+                             GLenum binaryFormat,
+                             const void* binary,
+                             GLsizei length) {
+  if (programBinaryProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::ProgramBinaryExtReq)) {
+      if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::ProgramBinary)) {
+        programBinaryProc_ = iglProgramBinaryOES;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::ProgramBinary)) {
+      programBinaryProc_ = iglProgramBinary;
+    }
+    IGL_DEBUG_ASSERT(programBinaryProc_, "No supported function for glProgramBinary\n");
+  }
+
+  GLCALL_PROC(programBinaryProc_, program, binaryFormat, binary, length);
+  APILOG("glProgramBinary(%u, %s, %p, %d)\n",
+         program,
+         GL_ENUM_TO_STRING(binaryFormat),
+         binary,
+         length);
+  GLCHECK_ERRORS();
+}
+
+void IContext::programParameteri(GLuint program, GLenum pname, GLint value) {
+  if (programParameteriProc_ == nullptr) {
+    // GL_OES_get_program_binary has no glProgramParameteri()
+    if (!deviceFeatureSet_.hasInternalRequirement(InternalRequirement::ProgramBinaryExtReq) &&
+        deviceFeatureSet_.hasInternalFeature(InternalFeatures::ProgramBinary)) {
+      programParameteriProc_ = iglProgramParameteri;
+    }
+    IGL_DEBUG_ASSERT(programParameteriProc_, "No supported function for glProgramParameteri\n");
+  }
+
+  GLCALL_PROC(programParameteriProc_, program, pname, value);
+  APILOG("glProgramParameteri(%u, %s, %d)\n", program, GL_ENUM_TO_STRING(pname), value);
+  GLCHECK_ERRORS();
+}
+
 void IContext::pushDebugGroup(GLenum source, GLuint id, GLsizei length, const GLchar* message) {
   if (pushDebugGroupProc_ == nullptr) {
     if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::DebugMessage)) {
@@ -2345,6 +2692,23 @@ void IContext::popDebugGroup() {
   }
 }
 
+void IContext::queryCounter(GLuint id, GLenum target) {
+  if (queryCounterProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::TimerQueryExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::DisjointTimerQuery)) {
+        queryCounterProc_ = iglQueryCounterEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::TimerQuery)) {
+      queryCounterProc_ = iglQueryCounter;
+    }
+    IGL_DEBUG_ASSERT(queryCounterProc_, "No supported function for glQueryCounter\n");
+  }
+
+  GLCALL_PROC(queryCounterProc_, id, target);
+  APILOG("glQueryCounter(%u, %s)\n", id, GL_ENUM_TO_STRING(target));
+  GLCHECK_ERRORS();
+}
+
 void IContext::readPixels(GLint x,
                           GLint y,
                           GLsizei width,
@@ -2449,12 +2813,18 @@ void IContext::framebufferTextureMultisampleMultiview(GLenum target,
 }
 
 void IContext::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  if (stateCache_ && !stateCache_->scissor(x, y, width, height)) {
+    return;
+  }
   GLCALL(Scissor)(x, y, width, height);
   APILOG("glScissor(%d, %d, %u, %u)\n", x, y, width, height);
   GLCHECK_ERRORS();
 }
 
 void IContext::setEnabled(bool shouldEnable, GLenum cap) {
+  if (stateCache_ && !stateCache_->setEnabled(cap, shouldEnable)) {
+    return;
+  }
   if (shouldEnable) {
     GLCALL(Enable)(cap);
     APILOG("glEnable(%s)\n", GL_ENUM_TO_STRING(cap));
@@ -2476,6 +2846,9 @@ void IContext::shaderSource(GLuint shader,
 }
 
 void IContext::stencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+  if (stateCache_ && !stateCache_->stencilFuncSeparate(face, func, ref, mask)) {
+    return;
+  }
   GLCALL(StencilFuncSeparate)(face, func, ref, mask);
   APILOG("glStencilFuncSeparate(%s, %s, %d, 0x%x)\n",
          GL_ENUM_TO_STRING(face),
@@ -2486,18 +2859,27 @@ void IContext::stencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint m
 }
 
 void IContext::stencilMask(GLuint mask) {
+  if (stateCache_ && !stateCache_->stencilMaskSeparate(GL_FRONT_AND_BACK, mask)) {
+    return;
+  }
   GLCALL(StencilMask)(mask);
   APILOG("glStencilMask(0x%x)\n", mask);
   GLCHECK_ERRORS();
 }
 
 void IContext::stencilMaskSeparate(GLenum face, GLuint mask) {
+  if (stateCache_ && !stateCache_->stencilMaskSeparate(face, mask)) {
+    return;
+  }
   GLCALL(StencilMaskSeparate)(face, mask);
   APILOG("glStencilMaskSeparate(%s, 0x%x)\n", GL_ENUM_TO_STRING(face), mask);
   GLCHECK_ERRORS();
 }
 
 void IContext::stencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass) {
+  if (stateCache_ && !stateCache_->stencilOpSeparate(face, fail, zfail, zpass)) {
+    return;
+  }
   GLCALL(StencilOpSeparate)(face, fail, zfail, zpass);
   APILOG("glStencilOpSeparate(%s, %s, %s, %s)\n",
          GL_ENUM_TO_STRING(face),
@@ -2983,6 +3365,9 @@ void IContext::unmapBuffer(GLenum target) {
 }
 
 void IContext::useProgram(GLuint program) {
+  if (stateCache_ && !stateCache_->useProgram(program)) {
+    return;
+  }
   GLCALL(UseProgram)(program);
   APILOG("glUseProgram(%u)\n", program);
   GLCHECK_ERRORS();
@@ -2995,6 +3380,9 @@ void IContext::validateProgram(GLuint program) {
 }
 
 void IContext::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  if (stateCache_ && !stateCache_->viewport(x, y, width, height)) {
+    return;
+  }
   GLCALL(Viewport)(x, y, width, height);
   APILOG("glViewport(%d, %d, %u, %u)\n", x, y, width, height);
   GLCHECK_ERRORS();
@@ -3165,6 +3553,98 @@ void IContext::resetCounters() {
   callCounter_ = 0;
 }
 
+void IContext::setStateCacheEnabled(bool enabled) {
+  if (!enabled) {
+    stateCache_ = nullptr;
+  } else if (!stateCache_) {
+    stateCache_ = std::make_unique<StateCache>();
+  }
+}
+
+void IContext::invalidateStateCache() {
+  if (stateCache_) {
+    stateCache_->invalidate();
+  }
+}
+
+StateCache::Stats IContext::getStateCacheStats() const {
+  return stateCache_ ? stateCache_->getStats() : StateCache::Stats{};
+}
+
+void IContext::resetStateCacheStats() {
+  if (stateCache_) {
+    stateCache_->resetStats();
+  }
+}
+
+void IContext::setVertexArrayObjectCacheEnabled(bool enabled) {
+  if (!enabled) {
+    if (vertexArrayObjectCache_) {
+      vertexArrayObjectCache_->clear(*this);
+      vertexArrayObjectCache_ = nullptr;
+    }
+  } else if (!vertexArrayObjectCache_) {
+    if (!deviceFeatures().hasInternalFeature(InternalFeatures::VertexArrayObject)) {
+      IGL_LOG_INFO("Vertex array objects are not supported, the cache stays disabled\n");
+      return;
+    }
+    vertexArrayObjectCache_ = std::make_unique<VertexArrayObjectCache>();
+  }
+}
+
+void IContext::setParallelShaderCompileEnabled(bool enabled) {
+  if (enabled && !parallelShaderCompileEnabled_ &&
+      deviceFeatures().hasInternalFeature(InternalFeatures::ParallelShaderCompile)) {
+    // let the driver pick the number of compiler threads
+    maxShaderCompilerThreads(0xffffffff);
+  }
+  parallelShaderCompileEnabled_ = enabled;
+}
+
+void IContext::setPixelUnpackBufferRingEnabled(bool enabled, size_t capacity) {
+  if (pixelUnpackBufferRing_) {
+    pixelUnpackBufferRing_->clear(*this);
+    pixelUnpackBufferRing_ = nullptr;
+  }
+  if (enabled) {
+    if (!PixelUnpackBufferRing::isSupported(*this)) {
+      IGL_LOG_INFO("Pixel unpack buffers are not supported, uploads stay synchronous\n");
+      return;
+    }
+    pixelUnpackBufferRing_ = std::make_unique<PixelUnpackBufferRing>(capacity);
+  }
+}
+
+PixelPackBufferPool& IContext::getPixelPackBufferPool() {
+  if (!pixelPackBufferPool_) {
+    pixelPackBufferPool_ = std::make_unique<PixelPackBufferPool>();
+  }
+  return *pixelPackBufferPool_;
+}
+
+UniformBatchBuffer& IContext::getUniformBatchBuffer() {
+  if (!uniformBatchBuffer_) {
+    uniformBatchBuffer_ = std::make_unique<UniformBatchBuffer>();
+  }
+  return *uniformBatchBuffer_;
+}
+
+void IContext::setProgramBinaryStorage(std::shared_ptr<IProgramBinaryStorage> storage) {
+  programBinaryCache_ = nullptr;
+  if (!storage) {
+    return;
+  }
+  GLint numFormats = 0;
+  if (deviceFeatures().hasInternalFeature(InternalFeatures::ProgramBinary)) {
+    getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+  }
+  if (numFormats <= 0) {
+    IGL_LOG_INFO("Program binaries are not supported, the cache stays disabled\n");
+    return;
+  }
+  programBinaryCache_ = std::make_unique<ProgramBinaryCache>(std::move(storage));
+}
+
 bool IContext::addRef() {
   const bool ret = isLikelyValidObject();
   if (ret) {
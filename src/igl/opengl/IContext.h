@@ -20,8 +20,14 @@
 #include <igl/opengl/DeviceFeatureSet.h>
 #include <igl/opengl/GLFunc.h>
 #include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/PixelPackBufferPool.h>
+#include <igl/opengl/PixelUnpackBufferRing.h>
+#include <igl/opengl/ProgramBinaryCache.h>
 #include <igl/opengl/RenderCommandAdapter.h>
+#include <igl/opengl/StateCache.h>
+#include <igl/opengl/UniformBatchBuffer.h>
 #include <igl/opengl/UnbindPolicy.h>
+#include <igl/opengl/VertexArrayObjectCache.h>
 #include <igl/opengl/Version.h>
 #include <igl/opengl/WithContext.h>
 
@@ -89,12 +95,14 @@ class IContext {
                        GLbitfield mask,
                        GLenum filter);
   void bufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage);
+  void bufferStorage(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags);
   void bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data);
   virtual GLenum checkFramebufferStatus(GLenum target);
   void clear(GLbitfield mask);
   void clearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
   void clearDepthf(GLfloat depth);
   void clearStencil(GLint s);
+  GLenum clientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout);
   void colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
   void compileShader(GLuint shader);
   void compressedTexImage2D(GLenum target,
@@ -164,6 +172,7 @@ class IContext {
   void deleteRenderbuffers(GLsizei n, const GLuint* renderbuffers);
   void deleteVertexArrays(GLsizei n, const GLuint* vertexArrays);
   void deleteProgram(GLuint program);
+  void deleteQueries(GLsizei n, const GLuint* ids);
   void deleteShader(GLuint shaderId);
   void deleteSync(GLsync sync);
   void deleteTextures(const std::vector<GLuint>& textures);
@@ -214,6 +223,7 @@ class IContext {
   void generateMipmap(GLenum target);
   void genBuffers(GLsizei n, GLuint* buffers);
   void genFramebuffers(GLsizei n, GLuint* framebuffers);
+  void genQueries(GLsizei n, GLuint* ids);
   void genRenderbuffers(GLsizei n, GLuint* renderbuffers);
   void genTextures(GLsizei n, GLuint* textures);
   void genVertexArrays(GLsizei n, GLuint* vertexArrays);
@@ -261,6 +271,11 @@ class IContext {
                                            GLint* params) const;
   void getIntegerv(GLenum pname, GLint* params) const;
   void getProgramiv(GLuint program, GLenum pname, GLint* params) const;
+  void getProgramBinary(GLuint program,
+                        GLsizei bufSize,
+                        GLsizei* length,
+                        GLenum* binaryFormat,
+                        void* binary) const;
   void getProgramInterfaceiv(GLuint program,
                              GLenum programInterface,
                              GLenum pname,
@@ -273,6 +288,8 @@ class IContext {
                               GLsizei bufSize,
                               GLsizei* length,
                               char* name) const;
+  void getQueryObjectuiv(GLuint id, GLenum pname, GLuint* params) const;
+  void getQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) const;
   void getShaderiv(GLuint shader, GLenum pname, GLint* params) const;
   void getShaderInfoLog(GLuint shader, GLsizei maxLength, GLsizei* length, GLchar* infoLog) const;
   virtual const GLubyte* getString(GLenum name) const;
@@ -287,11 +304,24 @@ class IContext {
   void linkProgram(GLuint program);
   void* mapBuffer(GLenum target, GLbitfield access);
   void* mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+  void maxShaderCompilerThreads(GLuint count);
+  void multiDrawArraysIndirect(GLenum mode,
+                               const GLvoid* indirect,
+                               GLsizei drawcount,
+                               GLsizei stride);
+  void multiDrawElementsIndirect(GLenum mode,
+                                 GLenum type,
+                                 const GLvoid* indirect,
+                                 GLsizei drawcount,
+                                 GLsizei stride);
   void objectLabel(GLenum identifier, GLuint name, GLsizei length, const char* label);
   void pixelStorei(GLenum pname, GLint param);
   void polygonOffsetClamp(GLfloat factor, GLfloat units, float clamp);
+  void programBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+  void programParameteri(GLuint program, GLenum pname, GLint value);
   void popDebugGroup();
   void pushDebugGroup(GLenum source, GLuint id, GLsizei length, const GLchar* message);
+  void queryCounter(GLuint id, GLenum target);
   void readPixels(GLint x,
                   GLint y,
                   GLsizei width,
@@ -456,6 +486,83 @@ class IContext {
 
   void resetCounters();
 
+  /** Enables or disables the shadow of the GL state (see StateCache). When it is enabled, calls
+   * which would not change the GL state are not issued. It is disabled by default.
+   */
+  void setStateCacheEnabled(bool enabled);
+  [[nodiscard]] bool isStateCacheEnabled() const {
+    return stateCache_ != nullptr;
+  }
+  /** Forgets the shadowed GL state. Call this after the context was used without IContext, e.g. by
+   * another library. Device::beginScope() calls it when the outermost scope begins.
+   */
+  void invalidateStateCache();
+  /** Returns the number of issued and elided calls since the state cache was enabled. */
+  [[nodiscard]] StateCache::Stats getStateCacheStats() const;
+  void resetStateCacheStats();
+
+  /** Enables or disables the cache of prebuilt vertex array objects (see VertexArrayObjectCache).
+   * When it is enabled, render passes bind one cached vertex array object per draw instead of
+   * setting up every vertex attribute. It requires vertex array objects and is disabled by default.
+   * Disabling it deletes the cached objects, so the context has to be current.
+   */
+  void setVertexArrayObjectCacheEnabled(bool enabled);
+  [[nodiscard]] bool isVertexArrayObjectCacheEnabled() const {
+    return vertexArrayObjectCache_ != nullptr;
+  }
+  /** Returns the cache, or nullptr when it is disabled. */
+  [[nodiscard]] VertexArrayObjectCache* getVertexArrayObjectCache() const {
+    return vertexArrayObjectCache_.get();
+  }
+
+  /** Sets the storage of the program binary cache (see ProgramBinaryCache). Programs linked after
+   * this call are stored in it and loaded with glProgramBinary() instead of being linked again.
+   * While the cache is enabled, shader modules are only compiled when a program using them is not
+   * cached, so compile errors are reported when the shader stages are created. Pass nullptr to
+   * disable the cache. Contexts without program binaries ignore the storage.
+   */
+  void setProgramBinaryStorage(std::shared_ptr<IProgramBinaryStorage> storage);
+  /** Returns the cache, or nullptr when it is disabled. */
+  [[nodiscard]] ProgramBinaryCache* getProgramBinaryCache() const {
+    return programBinaryCache_.get();
+  }
+
+  /** Enables or disables deferred shader compilation. While it is enabled, shader modules and
+   * shader stages do not query GL_COMPILE_STATUS or GL_LINK_STATUS, so creating many of them in a
+   * row keeps the compiler threads of the driver busy instead of waiting for each program. Render
+   * pipelines of programs which are still linking report IRenderPipelineState::isReady() false,
+   * and the link status is checked when they are first bound. With
+   * GL_KHR_parallel_shader_compile, isReady() polls GL_COMPLETION_STATUS_KHR; without it, pipelines
+   * report ready right away and binding them may wait for the driver. Disabled by default.
+   */
+  void setParallelShaderCompileEnabled(bool enabled);
+  [[nodiscard]] bool isParallelShaderCompileEnabled() const {
+    return parallelShaderCompileEnabled_;
+  }
+
+  /** Enables or disables the staging ring of asynchronous texture uploads (see
+   * PixelUnpackBufferRing). While it is enabled, large texture uploads are staged in the ring, and
+   * TextureBuffer::uploadFromUnpackBuffer() uploads pixels which were written to an allocation on
+   * any thread. Contexts without pixel unpack buffers or sync objects ignore this.
+   */
+  void setPixelUnpackBufferRingEnabled(
+      bool enabled,
+      size_t capacity = PixelUnpackBufferRing::kDefaultCapacity);
+  /** Returns the ring, or nullptr when it is disabled. */
+  [[nodiscard]] PixelUnpackBufferRing* getPixelUnpackBufferRing() const {
+    return pixelUnpackBufferRing_.get();
+  }
+
+  /** Returns the pool of pixel pack buffers of asynchronous framebuffer readbacks (see
+   * Framebuffer::requestBytesColorAttachment()). It is created on first use.
+   */
+  [[nodiscard]] PixelPackBufferPool& getPixelPackBufferPool();
+
+  /** Returns the ring which holds the batched uniforms of programs with a
+   * UniformBatchBuffer::kBlockName block. It is created on first use.
+   */
+  [[nodiscard]] UniformBatchBuffer& getUniformBatchBuffer();
+
   /** Manual reference counting.
    * In some cases, mostly for performance reasons, we hold unprotected references to the IContext.
    * When doing so, use the functions below to signal such references so we can at least throw an
@@ -544,29 +651,42 @@ class IContext {
   PFNIGLBINDIMAGETEXTUREPROC bindImageTexturerProc_ = nullptr;
   PFNIGLBINDVERTEXARRAYPROC bindVertexArrayProc_ = nullptr;
   PFNIGLBLITFRAMEBUFFERPROC blitFramebufferProc_ = nullptr;
+  PFNIGLBUFFERSTORAGEPROC bufferStorageProc_ = nullptr;
   PFNIGLCLEARDEPTHFPROC clearDepthfProc_ = nullptr;
+  PFNIGLCLIENTWAITSYNCPROC clientWaitSyncProc_ = nullptr;
   PFNIGLCOMPRESSEDTEXIMAGE3DPROC compressedTexImage3DProc_ = nullptr;
   PFNIGLCOMPRESSEDTEXSUBIMAGE3DPROC compressedTexSubImage3DProc_ = nullptr;
   PFNIGLDEBUGMESSAGECALLBACKPROC debugMessageCallbackProc_ = nullptr;
   PFNIGLDEBUGMESSAGEINSERTPROC debugMessageInsertProc_ = nullptr;
+  PFNIGLDELETEQUERIESPROC deleteQueriesProc_ = nullptr;
   PFNIGLDELETESYNCPROC deleteSyncProc_ = nullptr;
   PFNIGLDELETEVERTEXARRAYSPROC deleteVertexArraysProc_ = nullptr;
   PFNIGLDRAWBUFFERSPROC drawBuffersProc_ = nullptr;
   PFNIGLFENCESYNCPROC fenceSyncProc_ = nullptr;
   PFNIGLFRAMEBUFFERTEXTURE2DMULTISAMPLEPROC framebufferTexture2DMultisampleProc_ = nullptr;
   PFNIGLINVALIDATEFRAMEBUFFERPROC invalidateFramebufferProc_ = nullptr;
+  PFNIGLGENQUERIESPROC genQueriesProc_ = nullptr;
   PFNIGLGENVERTEXARRAYSPROC genVertexArraysProc_ = nullptr;
   mutable PFNIGLGETDEBUGMESSAGELOGPROC getDebugMessageLogProc_ = nullptr;
+  mutable PFNIGLGETPROGRAMBINARYPROC getProgramBinaryProc_ = nullptr;
+  mutable PFNIGLGETQUERYOBJECTUIVPROC getQueryObjectuivProc_ = nullptr;
+  mutable PFNIGLGETQUERYOBJECTUI64VPROC getQueryObjectui64vProc_ = nullptr;
   mutable PFNIGLGETSYNCIVPROC getSyncivProc_ = nullptr;
   PFNIGLGETTEXTUREHANDLEPROC getTextureHandleProc_ = nullptr;
   PFNIGLMAKETEXTUREHANDLERESIDENTPROC makeTextureHandleResidentProc_ = nullptr;
   PFNIGLMAKETEXTUREHANDLENONRESIDENTPROC makeTextureHandleNonResidentProc_ = nullptr;
   PFNIGLMAPBUFFERPROC mapBufferProc_ = nullptr;
   PFNIGLMAPBUFFERRANGEPROC mapBufferRangeProc_ = nullptr;
+  PFNIGLMAXSHADERCOMPILERTHREADSPROC maxShaderCompilerThreadsProc_ = nullptr;
   PFNIGLMEMORYBARRIERPROC memoryBarrierProc_ = nullptr;
+  PFNIGLMULTIDRAWARRAYSINDIRECTPROC multiDrawArraysIndirectProc_ = nullptr;
+  PFNIGLMULTIDRAWELEMENTSINDIRECTPROC multiDrawElementsIndirectProc_ = nullptr;
   PFNIGLOBJECTLABELPROC objectLabelProc_ = nullptr;
   PFNIGLPOPDEBUGGROUPPROC popDebugGroupProc_ = nullptr;
+  PFNIGLPROGRAMBINARYPROC programBinaryProc_ = nullptr;
+  PFNIGLPROGRAMPARAMETERIPROC programParameteriProc_ = nullptr;
   PFNIGLPUSHDEBUGGROUPPROC pushDebugGroupProc_ = nullptr;
+  PFNIGLQUERYCOUNTERPROC queryCounterProc_ = nullptr;
   PFNIGLRENDERBUFFERSTORAGEMULTISAMPLEPROC renderbufferStorageMultisampleProc_ = nullptr;
   PFNIGLTEXIMAGE3DPROC texImage3DProc_ = nullptr;
   PFNIGLTEXSTORAGE1DPROC texStorage1DProc_ = nullptr;
@@ -625,6 +745,20 @@ class IContext {
 
   UnbindPolicy unbindPolicy_ = UnbindPolicy::Default;
 
+  // null when the state cache is disabled
+  std::unique_ptr<StateCache> stateCache_;
+  // null when the vertex array object cache is disabled
+  std::unique_ptr<VertexArrayObjectCache> vertexArrayObjectCache_;
+  // null when no program binary storage is set
+  std::unique_ptr<ProgramBinaryCache> programBinaryCache_;
+  // null when asynchronous texture uploads are disabled
+  std::unique_ptr<PixelUnpackBufferRing> pixelUnpackBufferRing_;
+  // null until a program with batched uniforms is drawn
+  std::unique_ptr<UniformBatchBuffer> uniformBatchBuffer_;
+  // null until the first asynchronous readback
+  std::unique_ptr<PixelPackBufferPool> pixelPackBufferPool_;
+  bool parallelShaderCompileEnabled_ = false;
+
   void getGLMajorAndMinorVersions(GLint& majorVersion, GLint& minorVersion) const;
   void getGLMajorAndMinorVersions_(GLint& majorVersion, GLint& minorVersion) const;
   friend class DestructionGuard;
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/PixelPackBufferPool.h>
+
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+bool PixelPackBufferPool::isSupported(IContext& context) {
+  const auto& features = context.deviceFeatures();
+  return features.hasInternalFeature(InternalFeatures::PixelBufferObject) &&
+         features.hasInternalFeature(InternalFeatures::Sync) &&
+         features.hasFeature(DeviceFeatures::MapBufferRange) &&
+         features.hasInternalFeature(InternalFeatures::UnmapBuffer);
+}
+
+PixelPackBufferPool::Allocation PixelPackBufferPool::acquire(IContext& context, size_t length) {
+  // the smallest released buffer which is large enough
+  auto best = freeBuffers_.end();
+  for (auto it = freeBuffers_.begin(); it != freeBuffers_.end(); ++it) {
+    if (it->capacity >= length && (best == freeBuffers_.end() || it->capacity < best->capacity)) {
+      best = it;
+    }
+  }
+  if (best != freeBuffers_.end()) {
+    const Allocation allocation = *best;
+    freeBuffers_.erase(best);
+    stats_.reuses++;
+    return allocation;
+  }
+
+  Allocation allocation;
+  context.genBuffers(1, &allocation.buffer);
+  if (allocation.buffer == 0) {
+    IGL_LOG_ERROR("Failed to create a pixel pack buffer\n");
+    return {};
+  }
+  allocation.capacity = length;
+  context.bindBuffer(GL_PIXEL_PACK_BUFFER, allocation.buffer);
+  context.bufferData(
+      GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(length), nullptr, GL_STREAM_READ);
+  context.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  stats_.allocations++;
+  return allocation;
+}
+
+void PixelPackBufferPool::release(IContext& context, const Allocation& allocation) {
+  if (!allocation.isValid()) {
+    return;
+  }
+  freeBuffers_.push_back(allocation);
+  if (freeBuffers_.size() > kMaxFreeBuffers) {
+    // the oldest released buffer is the least likely to match the next readbacks
+    context.deleteBuffers(1, &freeBuffers_.front().buffer);
+    freeBuffers_.erase(freeBuffers_.begin());
+  }
+}
+
+void PixelPackBufferPool::clear(IContext& context) {
+  for (auto& allocation : freeBuffers_) {
+    context.deleteBuffers(1, &allocation.buffer);
+  }
+  freeBuffers_.clear();
+}
+
+} // namespace igl::opengl
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <igl/opengl/GLIncludes.h>
+
+namespace igl::opengl {
+
+class IContext;
+
+/**
+ * @brief A pool of GL_PIXEL_PACK_BUFFER objects for asynchronous readbacks.
+ *
+ * glReadPixels() into a pixel pack buffer returns without waiting for the GPU, and the pixels are
+ * mapped with glMapBufferRange() once the fence after the read is signaled (see
+ * FramebufferReadback). Buffers are returned to the pool when a readback is destroyed, so a
+ * readback per frame of the same size does not allocate GPU memory after the first few frames.
+ *
+ * The pool is owned by IContext (see IContext::getPixelPackBufferPool()) and all methods must be
+ * called with the context current.
+ */
+class PixelPackBufferPool final {
+ public:
+  struct Allocation {
+    GLuint buffer = 0;
+    size_t capacity = 0;
+
+    [[nodiscard]] bool isValid() const {
+      return buffer != 0;
+    }
+  };
+
+  struct Stats {
+    // buffers which were created
+    uint64_t allocations = 0;
+    // acquisitions which reused a released buffer
+    uint64_t reuses = 0;
+  };
+
+  // released buffers beyond this are deleted
+  static constexpr size_t kMaxFreeBuffers = 8;
+
+  [[nodiscard]] static bool isSupported(IContext& context);
+
+  /// @brief Returns a buffer with at least `length` bytes, which is not used by another readback
+  [[nodiscard]] Allocation acquire(IContext& context, size_t length);
+  /// @brief Returns the buffer to the pool. Its readback must have finished.
+  void release(IContext& context, const Allocation& allocation);
+
+  /// @brief Deletes the released buffers
+  void clear(IContext& context);
+
+  [[nodiscard]] size_t getNumFreeBuffers() const {
+    return freeBuffers_.size();
+  }
+  [[nodiscard]] const Stats& getStats() const {
+    return stats_;
+  }
+  void resetStats() {
+    stats_ = {};
+  }
+
+ private:
+  std::vector<Allocation> freeBuffers_;
+  Stats stats_;
+};
+
+} // namespace igl::opengl
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/PixelUnpackBufferRing.h>
+
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+namespace {
+
+// Offsets are aligned for every pixel type. Offset 0 is never used, since a null pixel pointer
+// means that there is no data in the texture upload paths.
+constexpr size_t kAlignment = 256;
+constexpr GLuint64 kWaitTimeoutNs = 1000000; // 1 ms
+
+size_t alignUp(size_t offset) {
+  return (offset + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+} // namespace
+
+bool PixelUnpackBufferRing::isSupported(IContext& context) {
+  const auto& features = context.deviceFeatures();
+  if (!features.hasInternalFeature(InternalFeatures::PixelBufferObject) ||
+      !features.hasInternalFeature(InternalFeatures::Sync)) {
+    return false;
+  }
+  return features.hasInternalFeature(InternalFeatures::BufferStorage) ||
+         (features.hasFeature(DeviceFeatures::MapBufferRange) &&
+          features.hasInternalFeature(InternalFeatures::UnmapBuffer));
+}
+
+bool PixelUnpackBufferRing::create(IContext& context) {
+  if (capacity_ <= kAlignment) {
+    return false;
+  }
+  context.genBuffers(1, &buffer_);
+  if (buffer_ == 0) {
+    IGL_LOG_ERROR("Failed to create the pixel unpack buffer\n");
+    return false;
+  }
+  context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
+  if (context.deviceFeatures().hasInternalFeature(InternalFeatures::BufferStorage)) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    context.bufferStorage(
+        GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(capacity_), nullptr, flags);
+    persistentData_ = static_cast<uint8_t*>(context.mapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(capacity_), flags));
+  } else {
+    context.bufferData(
+        GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(capacity_), nullptr, GL_STREAM_DRAW);
+  }
+  context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  if (context.deviceFeatures().hasInternalFeature(InternalFeatures::BufferStorage) &&
+      persistentData_ == nullptr) {
+    IGL_LOG_ERROR("Failed to map the pixel unpack buffer\n");
+    context.deleteBuffers(1, &buffer_);
+    buffer_ = 0;
+    return false;
+  }
+  head_ = kAlignment;
+  return true;
+}
+
+bool PixelUnpackBufferRing::reclaim(IContext& context, size_t begin, size_t end) {
+  while (!regions_.empty()) {
+    Region& region = regions_.front();
+    const bool overlaps = region.begin < end && begin < region.end;
+    if (region.sync == nullptr) {
+      // still written by the CPU, the upload was not issued yet
+      return !overlaps;
+    }
+    GLenum status = context.clientWaitSync(region.sync, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      if (!overlaps) {
+        // the remaining regions are newer
+        return true;
+      }
+      stats_.waits++;
+      do {
+        status = context.clientWaitSync(region.sync, GL_SYNC_FLUSH_COMMANDS_BIT, kWaitTimeoutNs);
+      } while (status == GL_TIMEOUT_EXPIRED);
+    }
+    context.deleteSync(region.sync);
+    regions_.pop_front();
+  }
+  return true;
+}
+
+PixelUnpackBufferRing::Allocation PixelUnpackBufferRing::allocate(IContext& context,
+                                                                  size_t length) {
+  if (length == 0) {
+    return {};
+  }
+  if ((buffer_ == 0 && !create(context)) || mapped_) {
+    stats_.failures++;
+    return {};
+  }
+
+  size_t begin = alignUp(head_);
+  if (begin + length > capacity_) {
+    begin = kAlignment;
+  }
+  if (begin + length > capacity_ || !reclaim(context, begin, begin + length)) {
+    stats_.failures++;
+    return {};
+  }
+
+  Allocation allocation;
+  allocation.buffer = buffer_;
+  allocation.offset = begin;
+  allocation.length = length;
+  if (persistentData_) {
+    allocation.data = persistentData_ + begin;
+  } else {
+    // the ring fences its regions itself, so the driver does not need to synchronize the mapping
+    const GLbitfield access =
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
+    allocation.data = context.mapBufferRange(GL_PIXEL_UNPACK_BUFFER,
+                                             static_cast<GLintptr>(begin),
+                                             static_cast<GLsizeiptr>(length),
+                                             access);
+    context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (allocation.data == nullptr) {
+      stats_.failures++;
+      return {};
+    }
+    mapped_ = true;
+  }
+
+  regions_.push_back({begin, begin + length, nullptr});
+  head_ = begin + length;
+  stats_.allocations++;
+  stats_.bytes += length;
+  return allocation;
+}
+
+void PixelUnpackBufferRing::bind(IContext& context, const Allocation& allocation) {
+  IGL_DEBUG_ASSERT(allocation.isValid() && allocation.buffer == buffer_);
+  context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
+  if (mapped_) {
+    context.unmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    mapped_ = false;
+  }
+}
+
+void PixelUnpackBufferRing::unbind(IContext& context, const Allocation& allocation) {
+  context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  for (Region& region : regions_) {
+    if (region.begin == allocation.offset && region.sync == nullptr) {
+      region.sync = context.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      return;
+    }
+  }
+  IGL_DEBUG_ABORT("Unknown pixel unpack buffer allocation");
+}
+
+void PixelUnpackBufferRing::clear(IContext& context) {
+  for (const Region& region : regions_) {
+    if (region.sync) {
+      context.deleteSync(region.sync);
+    }
+  }
+  regions_.clear();
+  if (buffer_ != 0) {
+    if (persistentData_ || mapped_) {
+      context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_);
+      context.unmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+      context.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    context.deleteBuffers(1, &buffer_);
+    buffer_ = 0;
+  }
+  persistentData_ = nullptr;
+  mapped_ = false;
+  head_ = 0;
+}
+
+} // namespace igl::opengl
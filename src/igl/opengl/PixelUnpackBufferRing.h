@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <igl/Common.h>
+#include <igl/opengl/GLIncludes.h>
+
+namespace igl::opengl {
+
+class IContext;
+
+/**
+ * @brief A ring of staging memory in a GL_PIXEL_UNPACK_BUFFER for asynchronous texture uploads.
+ *
+ * Pixels are written to an allocation by the CPU and glTexSubImage*() reads them from the buffer
+ * at an offset, so the driver does not have to copy client memory on the render thread. Every
+ * allocation is fenced after its upload and is only reused after the GPU consumed it.
+ *
+ * With glBufferStorage() the buffer is mapped once with GL_MAP_PERSISTENT_BIT, and allocations may
+ * be written on any thread until they are uploaded. Otherwise each allocation is mapped with
+ * glMapBufferRange() until it is uploaded, so there can only be one allocation at a time.
+ *
+ * The ring is owned by IContext (see IContext::setPixelUnpackBufferRingEnabled()). Except for
+ * writing the pixels of an allocation, all methods must be called with the context current.
+ */
+class PixelUnpackBufferRing final {
+ public:
+  struct Allocation {
+    GLuint buffer = 0;
+    // offset of the pixels in the buffer, which is never 0
+    size_t offset = 0;
+    size_t length = 0;
+    // the CPU-visible pixels
+    void* IGL_NULLABLE data = nullptr;
+
+    [[nodiscard]] bool isValid() const {
+      return data != nullptr;
+    }
+  };
+
+  struct Stats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    // allocations which had to wait for the GPU to consume older uploads
+    uint64_t waits = 0;
+    // allocations which failed, e.g. because the ring was too small
+    uint64_t failures = 0;
+  };
+
+  static constexpr size_t kDefaultCapacity = 32 * 1024 * 1024;
+
+  explicit PixelUnpackBufferRing(size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+
+  [[nodiscard]] static bool isSupported(IContext& context);
+
+  /// @brief Returns an allocation of `length` bytes, or an invalid allocation if the ring cannot
+  /// hold it. Waits for the GPU if the memory is still used by an older upload.
+  [[nodiscard]] Allocation allocate(IContext& context, size_t length);
+
+  /// @brief Binds the allocation to GL_PIXEL_UNPACK_BUFFER. Its pixels must have been written.
+  void bind(IContext& context, const Allocation& allocation);
+  /// @brief Unbinds GL_PIXEL_UNPACK_BUFFER and fences the allocation after its upload was issued
+  void unbind(IContext& context, const Allocation& allocation);
+
+  /// @brief Deletes the buffer and the fences
+  void clear(IContext& context);
+
+  [[nodiscard]] bool isPersistent() const {
+    return persistentData_ != nullptr;
+  }
+  [[nodiscard]] size_t getCapacity() const {
+    return capacity_;
+  }
+  [[nodiscard]] const Stats& getStats() const {
+    return stats_;
+  }
+  void resetStats() {
+    stats_ = {};
+  }
+
+ private:
+  // a range of the buffer which is written by the CPU or read by the GPU
+  struct Region {
+    size_t begin = 0;
+    size_t end = 0;
+    // null until the upload was issued
+    GLsync sync = nullptr;
+  };
+
+  [[nodiscard]] bool create(IContext& context);
+  // waits until [begin, end) is not used anymore, returns false if it is still being written
+  [[nodiscard]] bool reclaim(IContext& context, size_t begin, size_t end);
+
+  size_t capacity_;
+  GLuint buffer_ = 0;
+  // the whole buffer, if it is persistently mapped
+  uint8_t* IGL_NULLABLE persistentData_ = nullptr;
+  // true while an allocation is mapped with glMapBufferRange()
+  bool mapped_ = false;
+  size_t head_ = 0;
+  std::deque<Region> regions_;
+  Stats stats_;
+};
+
+} // namespace igl::opengl
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/ProgramBinaryCache.h>
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+namespace {
+
+constexpr uint32_t kBlobMagic = 0x504c4749; // "IGLP"
+constexpr uint32_t kBlobVersion = 1;
+
+// prepended to every blob
+struct BlobHeader {
+  uint32_t magic = kBlobMagic;
+  uint32_t version = kBlobVersion;
+  uint32_t binaryFormat = 0;
+  uint32_t binaryLength = 0;
+};
+
+// FNV-1a, which unlike std::hash gives the same result on every platform and every launch
+constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ull;
+constexpr uint64_t kFnvPrime = 0x100000001b3ull;
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t length) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i != length; i++) {
+    hash = (hash ^ bytes[i]) * kFnvPrime;
+  }
+  return hash;
+}
+
+template<typename T>
+uint64_t hashValue(uint64_t hash, const T& value) {
+  return hashBytes(hash, &value, sizeof(value));
+}
+
+uint64_t hashString(uint64_t hash, const GLubyte* str) {
+  const char* s = reinterpret_cast<const char*>(str);
+  return s ? hashBytes(hash, s, strlen(s) + 1) : hashValue(hash, uint8_t(0));
+}
+
+} // namespace
+
+bool MemoryProgramBinaryStorage::load(uint64_t key, std::vector<uint8_t>& outData) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  auto it = blobs_.find(key);
+  if (it == blobs_.end()) {
+    return false;
+  }
+  outData = it->second;
+  return true;
+}
+
+void MemoryProgramBinaryStorage::store(uint64_t key, const void* data, size_t length) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  const std::lock_guard<std::mutex> lock(mutex_);
+  blobs_[key].assign(bytes, bytes + length);
+}
+
+void MemoryProgramBinaryStorage::remove(uint64_t key) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  blobs_.erase(key);
+}
+
+size_t MemoryProgramBinaryStorage::size() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return blobs_.size();
+}
+
+DirectoryProgramBinaryStorage::DirectoryProgramBinaryStorage(std::string path) :
+  path_(std::move(path)) {
+  if (!path_.empty() && path_.back() != '/') {
+    path_ += '/';
+  }
+}
+
+std::string DirectoryProgramBinaryStorage::getFileName(uint64_t key) const {
+  char name[32] = {};
+  snprintf(name, sizeof(name), "%016" PRIx64 ".glprogram", key);
+  return path_ + name;
+}
+
+bool DirectoryProgramBinaryStorage::load(uint64_t key, std::vector<uint8_t>& outData) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  std::ifstream file(getFileName(key), std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  const std::streamsize size = file.tellg();
+  if (size <= 0) {
+    return false;
+  }
+  outData.resize(static_cast<size_t>(size));
+  file.seekg(0);
+  return static_cast<bool>(file.read(reinterpret_cast<char*>(outData.data()), size));
+}
+
+void DirectoryProgramBinaryStorage::store(uint64_t key, const void* data, size_t length) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  const std::string fileName = getFileName(key);
+  // write a temporary file first, so a crash never leaves a truncated blob behind
+  const std::string tmpFileName = fileName + ".tmp";
+  {
+    std::ofstream file(tmpFileName, std::ios::binary | std::ios::trunc);
+    if (!file ||
+        !file.write(static_cast<const char*>(data), static_cast<std::streamsize>(length))) {
+      IGL_LOG_ERROR("Cannot write the program binary %s\n", tmpFileName.c_str());
+      file.close();
+      std::remove(tmpFileName.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+    std::remove(tmpFileName.c_str());
+  }
+}
+
+void DirectoryProgramBinaryStorage::remove(uint64_t key) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  std::remove(getFileName(key).c_str());
+}
+
+ProgramBinaryCache::ProgramBinaryCache(std::shared_ptr<IProgramBinaryStorage> storage) :
+  storage_(std::move(storage)) {
+  IGL_DEBUG_ASSERT(storage_);
+}
+
+uint64_t ProgramBinaryCache::hashShaderModule(ShaderStage stage,
+                                              const char* source,
+                                              const ShaderCompilerOptions& options) {
+  uint64_t hash = kFnvOffsetBasis;
+  hash = hashValue(hash, static_cast<uint8_t>(stage));
+  hash = hashValue(hash, static_cast<uint8_t>(options.fastMathEnabled));
+  return source ? hashBytes(hash, source, strlen(source)) : hash;
+}
+
+uint64_t ProgramBinaryCache::getProgramKey(IContext& context,
+                                           const uint64_t* moduleHashes,
+                                           size_t numModules) {
+  if (driverHash_ == 0) {
+    driverHash_ = kFnvOffsetBasis;
+    driverHash_ = hashString(driverHash_, context.getString(GL_VENDOR));
+    driverHash_ = hashString(driverHash_, context.getString(GL_RENDERER));
+    driverHash_ = hashString(driverHash_, context.getString(GL_VERSION));
+  }
+  uint64_t key = hashValue(driverHash_, kBlobVersion);
+  for (size_t i = 0; i != numModules; i++) {
+    key = hashValue(key, moduleHashes[i]);
+  }
+  return key;
+}
+
+GLuint ProgramBinaryCache::loadProgram(IContext& context, uint64_t key) {
+  std::vector<uint8_t> blob;
+  if (!storage_->load(key, blob)) {
+    stats_.misses++;
+    return 0;
+  }
+
+  BlobHeader header;
+  if (blob.size() > sizeof(header)) {
+    memcpy(&header, blob.data(), sizeof(header));
+  }
+  if (blob.size() <= sizeof(header) || header.magic != kBlobMagic ||
+      header.version != kBlobVersion || header.binaryLength != blob.size() - sizeof(header)) {
+    IGL_LOG_INFO("Ignoring a malformed program binary\n");
+    storage_->remove(key);
+    stats_.rejected++;
+    return 0;
+  }
+
+  const GLuint program = context.createProgram();
+  if (program == 0) {
+    return 0;
+  }
+  context.programBinary(program,
+                        header.binaryFormat,
+                        blob.data() + sizeof(header),
+                        static_cast<GLsizei>(header.binaryLength));
+
+  GLint status = GL_FALSE;
+  context.getProgramiv(program, GL_LINK_STATUS, &status);
+  if (status == GL_FALSE) {
+    // the driver changed, the program is linked from source instead
+    IGL_LOG_INFO("The driver rejected a program binary\n");
+    context.deleteProgram(program);
+    storage_->remove(key);
+    stats_.rejected++;
+    return 0;
+  }
+
+  stats_.hits++;
+  return program;
+}
+
+void ProgramBinaryCache::prepareProgram(IContext& context, GLuint program) const {
+  // GL_OES_get_program_binary has no hint, the binary is always retrievable
+  if (!context.deviceFeatures().hasInternalRequirement(InternalRequirement::ProgramBinaryExtReq)) {
+    context.programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+}
+
+void ProgramBinaryCache::storeProgram(IContext& context, uint64_t key, GLuint program) {
+  GLint length = 0;
+  context.getProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  std::vector<uint8_t> blob(sizeof(BlobHeader) + length);
+  GLsizei binaryLength = 0;
+  GLenum binaryFormat = 0;
+  context.getProgramBinary(
+      program, length, &binaryLength, &binaryFormat, blob.data() + sizeof(BlobHeader));
+  if (binaryLength <= 0) {
+    return;
+  }
+
+  BlobHeader header;
+  header.binaryFormat = binaryFormat;
+  header.binaryLength = static_cast<uint32_t>(binaryLength);
+  memcpy(blob.data(), &header, sizeof(header));
+  blob.resize(sizeof(header) + binaryLength);
+
+  storage_->store(key, blob.data(), blob.size());
+}
+
+} // namespace igl::opengl
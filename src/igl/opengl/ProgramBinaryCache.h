@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <igl/Shader.h>
+#include <igl/opengl/GLIncludes.h>
+
+namespace igl::opengl {
+
+class IContext;
+
+/**
+ * @brief Storage backend of ProgramBinaryCache. Implementations have to be thread-safe if the
+ * same storage is shared by several contexts.
+ */
+class IProgramBinaryStorage {
+ public:
+  virtual ~IProgramBinaryStorage() = default;
+
+  /// @brief Returns false if there is no blob for `key`
+  [[nodiscard]] virtual bool load(uint64_t key, std::vector<uint8_t>& outData) = 0;
+  virtual void store(uint64_t key, const void* data, size_t length) = 0;
+  virtual void remove(uint64_t key) = 0;
+};
+
+/// @brief Keeps the blobs in memory, e.g. to share them between contexts of the same process
+class MemoryProgramBinaryStorage final : public IProgramBinaryStorage {
+ public:
+  [[nodiscard]] bool load(uint64_t key, std::vector<uint8_t>& outData) override;
+  void store(uint64_t key, const void* data, size_t length) override;
+  void remove(uint64_t key) override;
+
+  [[nodiscard]] size_t size() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<uint64_t, std::vector<uint8_t>> blobs_;
+};
+
+/// @brief Keeps one file per blob in an existing directory, e.g. the cache directory of the app
+class DirectoryProgramBinaryStorage final : public IProgramBinaryStorage {
+ public:
+  explicit DirectoryProgramBinaryStorage(std::string path);
+
+  [[nodiscard]] bool load(uint64_t key, std::vector<uint8_t>& outData) override;
+  void store(uint64_t key, const void* data, size_t length) override;
+  void remove(uint64_t key) override;
+
+ private:
+  [[nodiscard]] std::string getFileName(uint64_t key) const;
+
+  std::mutex mutex_;
+  std::string path_;
+};
+
+/**
+ * @brief Caches linked GL programs with glGetProgramBinary() and glProgramBinary(), so they don't
+ * have to be linked again on the next launch.
+ *
+ * Blobs are keyed by a hash of the shader sources, the stages, ShaderCompilerOptions and the
+ * GL_VENDOR, GL_RENDERER and GL_VERSION strings of the context. Drivers may still reject a blob,
+ * e.g. after an update which did not change the version string. Rejected blobs are removed from the
+ * storage and the program is linked from source again.
+ *
+ * The cache is owned by IContext (see IContext::setProgramBinaryStorage()).
+ */
+class ProgramBinaryCache final {
+ public:
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t rejected = 0;
+  };
+
+  explicit ProgramBinaryCache(std::shared_ptr<IProgramBinaryStorage> storage);
+
+  /// @brief 64-bit hash of a shader module, which is stable across launches
+  [[nodiscard]] static uint64_t hashShaderModule(ShaderStage stage,
+                                                 const char* source,
+                                                 const ShaderCompilerOptions& options);
+
+  /// @brief Returns the key of a program made of modules with these hashes
+  [[nodiscard]] uint64_t getProgramKey(IContext& context,
+                                       const uint64_t* moduleHashes,
+                                       size_t numModules);
+
+  /// @brief Returns a new linked program created from the stored blob, or 0
+  [[nodiscard]] GLuint loadProgram(IContext& context, uint64_t key);
+  /// @brief Sets GL_PROGRAM_BINARY_RETRIEVABLE_HINT on a program before it is linked and stored
+  void prepareProgram(IContext& context, GLuint program) const;
+  /// @brief Stores the binary of a linked program
+  void storeProgram(IContext& context, uint64_t key, GLuint program);
+
+  [[nodiscard]] const Stats& getStats() const {
+    return stats_;
+  }
+  void resetStats() {
+    stats_ = {};
+  }
+
+ private:
+  std::shared_ptr<IProgramBinaryStorage> storage_;
+  // hash of the vendor, renderer and version strings, computed on first use
+  uint64_t driverHash_ = 0;
+  Stats stats_;
+};
+
+} // namespace igl::opengl
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/QueryPool.h>
+
+#include <igl/opengl/DeviceFeatureSet.h>
+
+namespace igl::opengl {
+
+namespace {
+
+// GL_TIMESTAMP is intentionally not defined in GLIncludes.h; see the glQueryCounterEXT workaround
+// in GLFunc.cpp
+#if defined(GL_TIMESTAMP)
+constexpr GLenum kTimestamp = GL_TIMESTAMP;
+#elif defined(GL_TIMESTAMP_EXT)
+constexpr GLenum kTimestamp = GL_TIMESTAMP_EXT;
+#else
+constexpr GLenum kTimestamp = 0x8E28;
+#endif
+
+} // namespace
+
+QueryPool::QueryPool(IContext& context, const QueryPoolDesc& desc) :
+  WithContext(context), IQueryPool(desc) {}
+
+QueryPool::~QueryPool() {
+  if (!ids_.empty()) {
+    getContext().deleteQueries(static_cast<GLsizei>(ids_.size()), ids_.data());
+  }
+}
+
+Result QueryPool::create() {
+  if (desc_.queryCount == 0) {
+    return Result(Result::Code::ArgumentInvalid, "queryCount must be greater than zero");
+  }
+  if (desc_.type != QueryType::Timestamp ||
+      !getContext().deviceFeatures().hasInternalFeature(InternalFeatures::TimerQuery)) {
+    return Result(Result::Code::Unsupported, "Query type is not supported");
+  }
+
+  ids_.resize(desc_.queryCount, 0);
+  getContext().genQueries(static_cast<GLsizei>(ids_.size()), ids_.data());
+
+  return Result();
+}
+
+void QueryPool::writeTimestamp(uint32_t query) {
+  if (!IGL_DEBUG_VERIFY(query < ids_.size())) {
+    return;
+  }
+  getContext().queryCounter(ids_[query], kTimestamp);
+}
+
+bool QueryPool::getTimestamps(uint32_t firstQuery,
+                              uint32_t queryCount,
+                              uint64_t* IGL_NONNULL outNanoseconds) const {
+  IGL_PROFILER_FUNCTION();
+
+  if (!IGL_DEBUG_VERIFY(firstQuery + queryCount <= ids_.size())) {
+    return false;
+  }
+
+  for (uint32_t i = 0; i != queryCount; i++) {
+    GLuint available = GL_FALSE;
+    getContext().getQueryObjectuiv(ids_[firstQuery + i], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) {
+      return false;
+    }
+  }
+
+  // the GPU timer results are undefined after a disjoint event (e.g. a frequency change)
+  if (getContext().deviceFeatures().hasExtension(Extensions::DisjointTimerQuery)) {
+    GLint disjoint = GL_FALSE;
+    getContext().getIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    if (disjoint != GL_FALSE) {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i != queryCount; i++) {
+    GLuint64 value = 0;
+    getContext().getQueryObjectui64v(ids_[firstQuery + i], GL_QUERY_RESULT, &value);
+    outNanoseconds[i] = value;
+  }
+
+  return true;
+}
+
+bool QueryPool::getPipelineStatistics(uint32_t /*firstQuery*/,
+                                      uint32_t /*queryCount*/,
+                                      PipelineStatistics* IGL_NONNULL /*outStatistics*/) const {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+  return false;
+}
+
+} // namespace igl::opengl
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+#include <igl/QueryPool.h>
+#include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+/**
+ * @brief Implements QueryType::Timestamp queries with glQueryCounter(GL_TIMESTAMP) from
+ * GL_ARB_timer_query (OpenGL 3.3) or GL_EXT_disjoint_timer_query (OpenGL ES). Pipeline statistics
+ * queries are not supported.
+ */
+class QueryPool final : public WithContext, public IQueryPool {
+ public:
+  QueryPool(IContext& context, const QueryPoolDesc& desc);
+  ~QueryPool() override;
+
+  Result create();
+
+  [[nodiscard]] bool getTimestamps(uint32_t firstQuery,
+                                   uint32_t queryCount,
+                                   uint64_t* IGL_NONNULL outNanoseconds) const override;
+  [[nodiscard]] bool getPipelineStatistics(uint32_t firstQuery,
+                                           uint32_t queryCount,
+                                           PipelineStatistics* IGL_NONNULL
+                                               outStatistics) const override;
+
+  /// @brief Writes the current GPU time into `query` once all previous commands have completed
+  void writeTimestamp(uint32_t query);
+
+ private:
+  std::vector<GLuint> ids_;
+};
+
+} // namespace igl::opengl
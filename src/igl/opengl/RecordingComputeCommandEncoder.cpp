@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/RecordingComputeCommandEncoder.h>
+
+#include <igl/opengl/CommandStream.h>
+
+namespace igl::opengl {
+
+RecordingComputeCommandEncoder::RecordingComputeCommandEncoder(CommandStream& stream) :
+  stream_(stream) {
+  stream_.record(CommandStream::BeginComputePass{});
+}
+
+void RecordingComputeCommandEncoder::endEncoding() {
+  if (IGL_DEBUG_VERIFY(isEncoding_)) {
+    stream_.record(CommandStream::EndComputePass{});
+    isEncoding_ = false;
+  }
+}
+
+void RecordingComputeCommandEncoder::bindComputePipelineState(
+    const std::shared_ptr<IComputePipelineState>& pipelineState) {
+  stream_.record(CommandStream::BindComputePipelineState{pipelineState});
+}
+
+void RecordingComputeCommandEncoder::dispatchThreadGroups(const Dimensions& threadgroupCount,
+                                                          const Dimensions& threadgroupSize,
+                                                          const Dependencies& dependencies) {
+  stream_.dispatchThreadGroups(threadgroupCount, threadgroupSize, dependencies);
+}
+
+void RecordingComputeCommandEncoder::pushDebugGroupLabel(const char* label,
+                                                         const igl::Color& /*color*/) const {
+  IGL_DEBUG_ASSERT(label != nullptr && *label);
+  stream_.pushDebugGroup(label);
+}
+
+void RecordingComputeCommandEncoder::insertDebugEventLabel(const char* label,
+                                                           const igl::Color& /*color*/) const {
+  IGL_DEBUG_ASSERT(label != nullptr && *label);
+  stream_.insertDebugEvent(label);
+}
+
+void RecordingComputeCommandEncoder::popDebugGroupLabel() const {
+  stream_.record(CommandStream::PopDebugGroup{});
+}
+
+void RecordingComputeCommandEncoder::writeTimestamp(IQueryPool& pool, uint32_t query) {
+  stream_.record(CommandStream::WriteTimestamp{&pool, query});
+}
+
+void RecordingComputeCommandEncoder::beginQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RecordingComputeCommandEncoder::endQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RecordingComputeCommandEncoder::bindUniform(const UniformDesc& uniformDesc,
+                                                 const void* data) {
+  IGL_DEBUG_ASSERT(data != nullptr, "Data cannot be null");
+  if (data) {
+    stream_.bindUniform(uniformDesc, data);
+  }
+}
+
+void RecordingComputeCommandEncoder::bindTexture(uint32_t index, ITexture* texture) {
+  stream_.record(CommandStream::BindTexture{index, 0, texture});
+}
+
+void RecordingComputeCommandEncoder::bindImageTexture(uint32_t /*index*/,
+                                                      ITexture* /*texture*/,
+                                                      TextureFormat /*format*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RecordingComputeCommandEncoder::bindSamplerState(uint32_t /*index*/,
+                                                      ISamplerState* /*samplerState*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+void RecordingComputeCommandEncoder::bindBuffer(uint32_t index,
+                                                IBuffer* buffer,
+                                                size_t offset,
+                                                size_t bufferSize) {
+  // NOLINTEND(bugprone-easily-swappable-parameters)
+  if (buffer) {
+    stream_.record(CommandStream::BindBuffer{index, buffer, offset, bufferSize});
+  }
+}
+
+void RecordingComputeCommandEncoder::bindBytes(uint32_t /*index*/,
+                                               const void* /*data*/,
+                                               size_t /*length*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RecordingComputeCommandEncoder::bindPushConstants(const void* /*data*/,
+                                                       size_t /*length*/,
+                                                       size_t /*offset*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+} // namespace igl::opengl
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/ComputeCommandEncoder.h>
+
+namespace igl::opengl {
+
+class CommandStream;
+
+/// @brief Records compute commands into the CommandStream of a CommandBuffer without touching the
+/// GL context. The commands are replayed by a ComputeCommandEncoder when the command buffer is
+/// submitted.
+class RecordingComputeCommandEncoder final : public IComputeCommandEncoder {
+ public:
+  explicit RecordingComputeCommandEncoder(CommandStream& stream);
+  ~RecordingComputeCommandEncoder() override = default;
+
+  void bindComputePipelineState(
+      const std::shared_ptr<IComputePipelineState>& pipelineState) override;
+  void dispatchThreadGroups(const Dimensions& threadgroupCount,
+                            const Dimensions& threadgroupSize,
+                            const Dependencies& dependencies) override;
+  void endEncoding() override;
+
+  void pushDebugGroupLabel(const char* label, const igl::Color& color) const override;
+  void insertDebugEventLabel(const char* label, const igl::Color& color) const override;
+  void popDebugGroupLabel() const override;
+
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+  /// @brief Not supported: OpenGL only implements timestamp queries
+  void beginQuery(IQueryPool& pool, uint32_t query) override;
+  /// @brief Not supported: OpenGL only implements timestamp queries
+  void endQuery(IQueryPool& pool, uint32_t query) override;
+  // The data pointer must remain valid until the command buffer has been submitted
+  void bindUniform(const UniformDesc& uniformDesc, const void* data) override;
+  void bindTexture(uint32_t index, ITexture* texture) override;
+  void bindImageTexture(uint32_t index, ITexture* texture, TextureFormat format) override;
+  void bindSamplerState(uint32_t index, ISamplerState* samplerState) override;
+  void bindBuffer(uint32_t index, IBuffer* buffer, size_t offset, size_t bufferSize) override;
+  void bindBytes(uint32_t index, const void* data, size_t length) override;
+  void bindPushConstants(const void* data, size_t length, size_t offset) override;
+
+ private:
+  CommandStream& stream_;
+  bool isEncoding_ = true;
+};
+
+} // namespace igl::opengl
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/RecordingRenderCommandEncoder.h>
+
+#include <igl/opengl/CommandBuffer.h>
+#include <igl/opengl/CommandStream.h>
+
+namespace igl::opengl {
+
+RecordingRenderCommandEncoder::RecordingRenderCommandEncoder(
+    const std::shared_ptr<CommandBuffer>& commandBuffer,
+    CommandStream& stream,
+    const RenderPassDesc& renderPass,
+    const std::shared_ptr<IFramebuffer>& framebuffer,
+    const Dependencies& dependencies) :
+  IRenderCommandEncoder(commandBuffer), stream_(stream) {
+  stream_.beginRenderPass(renderPass, framebuffer, dependencies);
+}
+
+void RecordingRenderCommandEncoder::endEncoding() {
+  if (IGL_DEBUG_VERIFY(isEncoding_)) {
+    stream_.record(CommandStream::EndRenderPass{});
+    isEncoding_ = false;
+  }
+}
+
+void RecordingRenderCommandEncoder::pushDebugGroupLabel(const char* label,
+                                                        const igl::Color& /*color*/) const {
+  IGL_DEBUG_ASSERT(label != nullptr && *label);
+  stream_.pushDebugGroup(label);
+}
+
+void RecordingRenderCommandEncoder::insertDebugEventLabel(const char* label,
+                                                          const igl::Color& /*color*/) const {
+  IGL_DEBUG_ASSERT(label != nullptr && *label);
+  stream_.insertDebugEvent(label);
+}
+
+void RecordingRenderCommandEncoder::popDebugGroupLabel() const {
+  stream_.record(CommandStream::PopDebugGroup{});
+}
+
+void RecordingRenderCommandEncoder::writeTimestamp(IQueryPool& pool, uint32_t query) {
+  stream_.record(CommandStream::WriteTimestamp{&pool, query});
+}
+
+void RecordingRenderCommandEncoder::beginQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RecordingRenderCommandEncoder::endQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RecordingRenderCommandEncoder::bindViewport(const Viewport& viewport) {
+  stream_.record(CommandStream::BindViewport{viewport});
+}
+
+void RecordingRenderCommandEncoder::bindScissorRect(const ScissorRect& rect) {
+  stream_.record(CommandStream::BindScissorRect{rect});
+}
+
+void RecordingRenderCommandEncoder::bindRenderPipelineState(
+    const std::shared_ptr<IRenderPipelineState>& pipelineState) {
+  stream_.record(CommandStream::BindRenderPipelineState{pipelineState});
+}
+
+void RecordingRenderCommandEncoder::bindDepthStencilState(
+    const std::shared_ptr<IDepthStencilState>& depthStencilState) {
+  stream_.record(CommandStream::BindDepthStencilState{depthStencilState});
+}
+
+void RecordingRenderCommandEncoder::bindUniform(const UniformDesc& uniformDesc, const void* data) {
+  IGL_DEBUG_ASSERT(data != nullptr, "Data cannot be null");
+  if (data) {
+    stream_.bindUniform(uniformDesc, data);
+  }
+}
+
+void RecordingRenderCommandEncoder::bindBuffer(uint32_t index,
+                                               IBuffer* buffer,
+                                               size_t bufferOffset,
+                                               size_t bufferSize) {
+  if (buffer) {
+    stream_.record(CommandStream::BindBuffer{index, buffer, bufferOffset, bufferSize});
+  }
+}
+
+void RecordingRenderCommandEncoder::bindVertexBuffer(uint32_t index,
+                                                     IBuffer& buffer,
+                                                     size_t bufferOffset) {
+  stream_.record(CommandStream::BindVertexBuffer{index, &buffer, bufferOffset});
+}
+
+void RecordingRenderCommandEncoder::bindIndexBuffer(IBuffer& buffer,
+                                                    IndexFormat format,
+                                                    size_t bufferOffset) {
+  stream_.record(CommandStream::BindIndexBuffer{&buffer, format, bufferOffset});
+}
+
+void RecordingRenderCommandEncoder::bindBytes(size_t /*index*/,
+                                              uint8_t /*target*/,
+                                              const void* /*data*/,
+                                              size_t /*length*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RecordingRenderCommandEncoder::bindPushConstants(const void* /*data*/,
+                                                      size_t /*length*/,
+                                                      size_t /*offset*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RecordingRenderCommandEncoder::bindSamplerState(size_t index,
+                                                     uint8_t target,
+                                                     ISamplerState* samplerState) {
+  stream_.record(
+      CommandStream::BindSamplerState{static_cast<uint32_t>(index), target, samplerState});
+}
+
+void RecordingRenderCommandEncoder::bindTexture(size_t index, uint8_t target, ITexture* texture) {
+  stream_.record(CommandStream::BindTexture{static_cast<uint32_t>(index), target, texture});
+}
+
+void RecordingRenderCommandEncoder::bindTexture(size_t index, ITexture* texture) {
+  bindTexture(index, igl::BindTarget::kFragment, texture);
+}
+
+void RecordingRenderCommandEncoder::bindBindGroup(BindGroupTextureHandle handle) {
+  if (!handle.empty()) {
+    stream_.record(CommandStream::BindBindGroupTexture{handle});
+  }
+}
+
+void RecordingRenderCommandEncoder::bindBindGroup(BindGroupBufferHandle handle,
+                                                  uint32_t numDynamicOffsets,
+                                                  const uint32_t* dynamicOffsets) {
+  if (!handle.empty()) {
+    stream_.bindBindGroup(handle, numDynamicOffsets, dynamicOffsets);
+  }
+}
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+void RecordingRenderCommandEncoder::draw(size_t vertexCount,
+                                         uint32_t instanceCount,
+                                         uint32_t firstVertex,
+                                         uint32_t baseInstance) {
+  // NOLINTEND(bugprone-easily-swappable-parameters)
+  stream_.record(CommandStream::Draw{vertexCount, instanceCount, firstVertex, baseInstance});
+}
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+void RecordingRenderCommandEncoder::drawIndexed(size_t indexCount,
+                                                uint32_t instanceCount,
+                                                uint32_t firstIndex,
+                                                int32_t vertexOffset,
+                                                uint32_t baseInstance) {
+  // NOLINTEND(bugprone-easily-swappable-parameters)
+  stream_.record(CommandStream::DrawIndexed{
+      indexCount, instanceCount, firstIndex, vertexOffset, baseInstance});
+}
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+void RecordingRenderCommandEncoder::multiDrawIndirect(IBuffer& indirectBuffer,
+                                                      size_t indirectBufferOffset,
+                                                      uint32_t drawCount,
+                                                      uint32_t stride) {
+  // NOLINTEND(bugprone-easily-swappable-parameters)
+  stream_.record(CommandStream::MultiDrawIndirect{
+      &indirectBuffer, indirectBufferOffset, drawCount, stride, false});
+}
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+void RecordingRenderCommandEncoder::multiDrawIndexedIndirect(IBuffer& indirectBuffer,
+                                                             size_t indirectBufferOffset,
+                                                             uint32_t drawCount,
+                                                             uint32_t stride) {
+  // NOLINTEND(bugprone-easily-swappable-parameters)
+  stream_.record(CommandStream::MultiDrawIndirect{
+      &indirectBuffer, indirectBufferOffset, drawCount, stride, true});
+}
+
+void RecordingRenderCommandEncoder::setStencilReferenceValue(uint32_t value) {
+  stream_.record(CommandStream::SetStencilReferenceValue{value});
+}
+
+void RecordingRenderCommandEncoder::setBlendColor(const Color& color) {
+  stream_.record(CommandStream::SetBlendColor{color});
+}
+
+void RecordingRenderCommandEncoder::setDepthBias(float depthBias, float slopeScale, float clamp) {
+  stream_.record(CommandStream::SetDepthBias{depthBias, slopeScale, clamp});
+}
+
+} // namespace igl::opengl
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/RenderCommandEncoder.h>
+#include <igl/RenderPass.h>
+
+namespace igl::opengl {
+
+class CommandBuffer;
+class CommandStream;
+
+/// @brief Records render commands into the CommandStream of a CommandBuffer without touching the
+/// GL context. The commands are replayed by a RenderCommandEncoder when the command buffer is
+/// submitted.
+class RecordingRenderCommandEncoder final : public IRenderCommandEncoder {
+ public:
+  RecordingRenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                CommandStream& stream,
+                                const RenderPassDesc& renderPass,
+                                const std::shared_ptr<IFramebuffer>& framebuffer,
+                                const Dependencies& dependencies);
+  ~RecordingRenderCommandEncoder() override = default;
+
+  void endEncoding() override;
+
+  void pushDebugGroupLabel(const char* label, const igl::Color& color) const override;
+  void insertDebugEventLabel(const char* label, const igl::Color& color) const override;
+  void popDebugGroupLabel() const override;
+
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+  /// @brief Not supported: OpenGL only implements timestamp queries
+  void beginQuery(IQueryPool& pool, uint32_t query) override;
+  /// @brief Not supported: OpenGL only implements timestamp queries
+  void endQuery(IQueryPool& pool, uint32_t query) override;
+
+  void bindViewport(const Viewport& viewport) override;
+  void bindScissorRect(const ScissorRect& rect) override;
+
+  void bindRenderPipelineState(const std::shared_ptr<IRenderPipelineState>& pipelineState) override;
+  void bindDepthStencilState(const std::shared_ptr<IDepthStencilState>& depthStencilState) override;
+
+  // The data pointer must remain valid until the command buffer has been submitted
+  void bindUniform(const UniformDesc& uniformDesc, const void* data) override;
+  void bindBuffer(uint32_t index, IBuffer* buffer, size_t bufferOffset, size_t bufferSize) override;
+  void bindVertexBuffer(uint32_t index, IBuffer& buffer, size_t bufferOffset) override;
+  void bindIndexBuffer(IBuffer& buffer, IndexFormat format, size_t bufferOffset) override;
+  void bindBytes(size_t index, uint8_t target, const void* data, size_t length) override;
+  void bindPushConstants(const void* data, size_t length, size_t offset) override;
+  void bindSamplerState(size_t index, uint8_t target, ISamplerState* samplerState) override;
+  void bindTexture(size_t index, uint8_t target, ITexture* texture) override;
+  void bindTexture(size_t index, ITexture* texture) override;
+
+  void bindBindGroup(BindGroupTextureHandle handle) override;
+  void bindBindGroup(BindGroupBufferHandle handle,
+                     uint32_t numDynamicOffsets,
+                     const uint32_t* dynamicOffsets) override;
+
+  void draw(size_t vertexCount,
+            uint32_t instanceCount,
+            uint32_t firstVertex,
+            uint32_t baseInstance) override;
+  void drawIndexed(size_t indexCount,
+                   uint32_t instanceCount,
+                   uint32_t firstIndex,
+                   int32_t vertexOffset,
+                   uint32_t baseInstance) override;
+  void multiDrawIndirect(IBuffer& indirectBuffer,
+                         size_t indirectBufferOffset,
+                         uint32_t drawCount,
+                         uint32_t stride) override;
+  void multiDrawIndexedIndirect(IBuffer& indirectBuffer,
+                                size_t indirectBufferOffset,
+                                uint32_t drawCount,
+                                uint32_t stride) override;
+
+  void setStencilReferenceValue(uint32_t value) override;
+  void setBlendColor(const Color& color) override;
+  void setDepthBias(float depthBias, float slopeScale, float clamp) override;
+
+ private:
+  CommandStream& stream_;
+  bool isEncoding_ = true;
+};
+
+} // namespace igl::opengl
@@ -9,6 +9,7 @@
 #include <igl/opengl/RenderCommandAdapter.h>
 
 #include <algorithm>
+#include <cstring>
 #include <igl/RenderCommandEncoder.h>
 #include <igl/opengl/Buffer.h>
 #include <igl/opengl/DepthStencilState.h>
@@ -21,12 +22,56 @@
 #include <igl/opengl/Texture.h>
 #include <igl/opengl/UniformAdapter.h>
 #include <igl/opengl/VertexArrayObject.h>
+#include <igl/opengl/VertexInputState.h>
 
 #define SET_DIRTY(dirtyMap, index) dirtyMap.set(index)
 #define CLEAR_DIRTY(dirtyMap, index) dirtyMap.reset(index)
 #define IS_DIRTY(dirtyMap, index) dirtyMap[index]
 
 namespace igl::opengl {
+
+namespace {
+
+// the commands in GL_DRAW_INDIRECT_BUFFER
+struct DrawArraysIndirectCommand {
+  GLuint count;
+  GLuint instanceCount;
+  GLuint first;
+  GLuint baseInstance;
+};
+
+struct DrawElementsIndirectCommand {
+  GLuint count;
+  GLuint instanceCount;
+  GLuint firstIndex;
+  GLint baseVertex;
+  GLuint baseInstance;
+};
+
+size_t getIndexSize(GLenum indexType) {
+  switch (indexType) {
+  case GL_UNSIGNED_INT:
+    return 4;
+  case GL_UNSIGNED_SHORT:
+    return 2;
+  default:
+    return 1;
+  }
+}
+
+// reads a command from the CPU copy of an indirect buffer, returns false if it is out of bounds
+template<typename Command>
+bool readIndirectCommand(const ArrayBuffer& buffer, size_t offset, Command& outCommand) {
+  const uint8_t* commands = buffer.getIndirectCommands();
+  if (!IGL_DEBUG_VERIFY(commands && offset + sizeof(Command) <= buffer.getSizeInBytes())) {
+    return false;
+  }
+  memcpy(&outCommand, commands + offset, sizeof(Command));
+  return true;
+}
+
+} // namespace
+
 RenderCommandAdapter::RenderCommandAdapter(IContext& context) :
   WithContext(context),
   uniformAdapter_(UniformAdapter(context, UniformAdapter::PipelineType::Render)),
@@ -110,6 +155,8 @@ void RenderCommandAdapter::setDepthBias(float depthBias, float slopeScale, float
 
 void RenderCommandAdapter::clearVertexBuffers() {
   vertexBuffersDirty_.reset();
+  vertexBuffersBound_.reset();
+  streamingVertexBuffers_.reset();
 }
 
 void RenderCommandAdapter::setVertexBuffer(Buffer& buffer,
@@ -121,6 +168,10 @@ void RenderCommandAdapter::setVertexBuffer(Buffer& buffer,
   if (index < IGL_BUFFER_BINDINGS_MAX) {
     vertexBuffers_[index] = {&buffer, offset};
     SET_DIRTY(vertexBuffersDirty_, index);
+    vertexBuffersBound_.set(index);
+    streamingVertexBuffers_.set(index,
+                                buffer.getType() == Buffer::Type::Attribute &&
+                                    static_cast<ArrayBuffer&>(buffer).isStreaming());
     Result::setOk(outResult);
   } else {
     Result::setResult(outResult, Result::Code::ArgumentInvalid);
@@ -128,6 +179,13 @@ void RenderCommandAdapter::setVertexBuffer(Buffer& buffer,
 }
 
 void RenderCommandAdapter::setIndexBuffer(Buffer& buffer) {
+  // emulated indirect draws check their indices against it, see multiDrawElementsIndirect()
+  indexBuffer_ = &buffer;
+  if (useVAO_ && getContext().getVertexArrayObjectCache()) {
+    // the index buffer is a part of the cached vertex array object, see willDraw()
+    setDirty(StateMask::VertexArray);
+    return;
+  }
   bindBufferWithShaderStorageBufferOverride(buffer, GL_ELEMENT_ARRAY_BUFFER);
 }
 
@@ -244,11 +302,28 @@ void RenderCommandAdapter::clearDependentResources(
 void RenderCommandAdapter::setPipelineState(const std::shared_ptr<IRenderPipelineState>& newValue,
                                             Result* outResult) {
   Result::setOk(outResult);
+  if (newValue) {
+    // a pipeline created with deferred shader compilation is finished when it is first used
+    const Result result = static_cast<RenderPipelineState&>(*newValue).waitUntilReady();
+    if (!result.isOk()) {
+      // a pipeline whose deferred link failed is never bound
+      Result::setResult(outResult, result);
+      return;
+    }
+  }
   if (pipelineState_) {
     clearDependentResources(newValue, outResult); // Only clear if pipeline state was previously set
   }
   pipelineState_ = newValue;
   setDirty(StateMask::PIPELINE);
+
+  auto* pipelineState = static_cast<RenderPipelineState*>(pipelineState_.get());
+  // only programs of contexts with uniform blocks have a batched uniform block
+  const auto* batchedUniformLayout =
+      pipelineState ? pipelineState->getBatchedUniformLayout() : nullptr;
+  uniformAdapter_.setUniformBatch(
+      batchedUniformLayout,
+      batchedUniformLayout ? &pipelineState->getUniformBatch() : nullptr);
 }
 
 void RenderCommandAdapter::drawArrays(GLenum mode, GLint first, GLsizei count) {
@@ -321,15 +396,144 @@ void RenderCommandAdapter::drawElementsIndirect(GLenum mode,
   didDraw();
 }
 
+void RenderCommandAdapter::multiDrawArraysIndirect(GLenum mode,
+                                                   Buffer& indirectBuffer,
+                                                   size_t indirectBufferOffset,
+                                                   GLsizei drawCount,
+                                                   GLsizei stride) {
+  const auto& features = getContext().deviceFeatures();
+  const auto* indirectBufferOffsetPtr =
+      reinterpret_cast<const uint8_t*>(indirectBufferOffset); // NOLINT(performance-no-int-to-ptr)
+  if (features.hasInternalFeature(InternalFeatures::MultiDrawIndirect)) {
+    willDraw();
+    bindBufferWithShaderStorageBufferOverride(indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
+    getContext().multiDrawArraysIndirect(
+        toMockWireframeMode(mode), indirectBufferOffsetPtr, drawCount, stride);
+    didDraw();
+    return;
+  }
+  if (features.hasInternalFeature(InternalFeatures::DrawArraysIndirect)) {
+    for (GLsizei i = 0; i != drawCount; i++) {
+      drawArraysIndirect(mode, indirectBuffer, indirectBufferOffsetPtr + i * stride);
+    }
+    return;
+  }
+
+  if (!IGL_DEBUG_VERIFY(indirectBuffer.getType() == Buffer::Type::Attribute)) {
+    return;
+  }
+  const auto& buffer = static_cast<const ArrayBuffer&>(indirectBuffer);
+  const bool drawInstanced = features.hasFeature(DeviceFeatures::DrawInstanced);
+  for (GLsizei i = 0; i != drawCount; i++) {
+    DrawArraysIndirectCommand command{};
+    if (!readIndirectCommand(buffer, indirectBufferOffset + i * stride, command)) {
+      break;
+    }
+    if (command.count == 0 || command.instanceCount == 0) {
+      continue;
+    }
+    if (command.instanceCount > 1 && !drawInstanced) {
+      IGL_LOG_ERROR_ONCE("Skipping instanced indirect draws, instancing is not supported\n");
+      continue;
+    }
+    setDrawBase(0, command.baseInstance);
+    if (command.instanceCount > 1) {
+      drawArraysInstanced(mode,
+                          static_cast<GLint>(command.first),
+                          static_cast<GLsizei>(command.count),
+                          static_cast<GLsizei>(command.instanceCount));
+    } else {
+      drawArrays(mode, static_cast<GLint>(command.first), static_cast<GLsizei>(command.count));
+    }
+  }
+  setDrawBase(0, 0);
+}
+
+void RenderCommandAdapter::multiDrawElementsIndirect(GLenum mode,
+                                                     GLenum indexType,
+                                                     Buffer& indirectBuffer,
+                                                     size_t indirectBufferOffset,
+                                                     GLsizei drawCount,
+                                                     GLsizei stride) {
+  const auto& features = getContext().deviceFeatures();
+  const auto* indirectBufferOffsetPtr =
+      reinterpret_cast<const uint8_t*>(indirectBufferOffset); // NOLINT(performance-no-int-to-ptr)
+  if (features.hasInternalFeature(InternalFeatures::MultiDrawIndirect)) {
+    willDraw();
+    bindBufferWithShaderStorageBufferOverride(indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
+    getContext().multiDrawElementsIndirect(
+        toMockWireframeMode(mode), indexType, indirectBufferOffsetPtr, drawCount, stride);
+    didDraw();
+    return;
+  }
+  // indexed indirect draws come with glDrawArraysIndirect()
+  if (features.hasInternalFeature(InternalFeatures::DrawArraysIndirect)) {
+    for (GLsizei i = 0; i != drawCount; i++) {
+      drawElementsIndirect(mode, indexType, indirectBuffer, indirectBufferOffsetPtr + i * stride);
+    }
+    return;
+  }
+
+  if (!IGL_DEBUG_VERIFY(indirectBuffer.getType() == Buffer::Type::Attribute && indexBuffer_)) {
+    return;
+  }
+  const auto& buffer = static_cast<const ArrayBuffer&>(indirectBuffer);
+  const bool drawInstanced = features.hasFeature(DeviceFeatures::DrawInstanced);
+  const size_t indexSize = getIndexSize(indexType);
+  const size_t numIndices = indexBuffer_->getSizeInBytes() / indexSize;
+  for (GLsizei i = 0; i != drawCount; i++) {
+    DrawElementsIndirectCommand command{};
+    if (!readIndirectCommand(buffer, indirectBufferOffset + i * stride, command)) {
+      break;
+    }
+    if (command.count == 0 || command.instanceCount == 0) {
+      continue;
+    }
+    if (static_cast<size_t>(command.firstIndex) + command.count > numIndices) {
+      IGL_LOG_ERROR_ONCE("Skipping indirect draws which read beyond the index buffer\n");
+      continue;
+    }
+    if (command.baseVertex < 0) {
+      IGL_LOG_ERROR_ONCE("Skipping indirect draws with a negative baseVertex\n");
+      continue;
+    }
+    if (command.instanceCount > 1 && !drawInstanced) {
+      IGL_LOG_ERROR_ONCE("Skipping instanced indirect draws, instancing is not supported\n");
+      continue;
+    }
+    setDrawBase(static_cast<size_t>(command.baseVertex), command.baseInstance);
+    const auto* indexOffset = reinterpret_cast<const GLvoid*>( // NOLINT(performance-no-int-to-ptr)
+        static_cast<uintptr_t>(command.firstIndex) * indexSize);
+    if (command.instanceCount > 1) {
+      drawElementsInstanced(mode,
+                            static_cast<GLsizei>(command.count),
+                            indexType,
+                            indexOffset,
+                            static_cast<GLsizei>(command.instanceCount));
+    } else {
+      drawElements(mode, static_cast<GLsizei>(command.count), indexType, indexOffset);
+    }
+  }
+  setDrawBase(0, 0);
+}
+
 void RenderCommandAdapter::endEncoding() {
   // Some minimal cleanup needs to occur in order. Otherwise, OpenGL can end in a bad state
   // with complex rendering.
+  if (usedVertexArrayObjectCache_) {
+    // cached vertex array objects must not be modified outside of the render pass
+    activeVAO_->bind();
+    usedVertexArrayObjectCache_ = false;
+  }
   if (pipelineState_) {
     unbindVertexAttributes();
   }
+  vertexBuffersBound_.reset();
+  indexBuffer_ = nullptr;
 
   pipelineState_ = nullptr;
   depthStencilState_ = nullptr;
+  uniformAdapter_.setUniformBatch(nullptr, nullptr);
 
   uniformAdapter_.shrinkUniformUsage();
   uniformAdapter_.clearUniformBuffers();
@@ -346,15 +550,27 @@ void RenderCommandAdapter::willDraw() {
   Result ret;
   auto* pipelineState = static_cast<RenderPipelineState*>(pipelineState_.get());
 
+  if (streamingVertexBuffers_.any()) {
+    updateStreamingVertexBuffers();
+  }
+
   // Vertex Buffers must be bound before pipelineState->bind()
-  if (pipelineState) {
+  auto* vertexArrayCache = useVAO_ ? getContext().getVertexArrayObjectCache() : nullptr;
+  if (pipelineState && vertexArrayCache) {
+    bindCachedVertexArray(*pipelineState, *vertexArrayCache);
+    if (isDirty(StateMask::PIPELINE)) {
+      pipelineState->bind();
+      clearDirty(StateMask::PIPELINE);
+    }
+  } else if (pipelineState) {
     pipelineState->clearActiveAttributesLocations();
     for (size_t bufferIndex = 0; bufferIndex < IGL_BUFFER_BINDINGS_MAX; ++bufferIndex) {
       if (IS_DIRTY(vertexBuffersDirty_, bufferIndex)) {
         auto& bufferState = vertexBuffers_[bufferIndex];
         bindBufferWithShaderStorageBufferOverride((*bufferState.resource), GL_ARRAY_BUFFER);
         // now bind the vertex attributes corresponding to this vertex buffer
-        pipelineState->bindVertexAttributes(bufferIndex, bufferState.offset);
+        pipelineState->bindVertexAttributes(
+            bufferIndex, bufferState.offset + bufferState.slotOffset + bufferState.baseOffset);
         CLEAR_DIRTY(vertexBuffersDirty_, bufferIndex);
       }
     }
@@ -443,6 +659,91 @@ void RenderCommandAdapter::willDraw() {
   }
 }
 
+void RenderCommandAdapter::bindCachedVertexArray(RenderPipelineState& pipelineState,
+                                                 VertexArrayObjectCache& cache) {
+  if (vertexBuffersDirty_.none() && !isDirty(StateMask::PIPELINE) &&
+      !isDirty(StateMask::VertexArray)) {
+    // the same vertex array object is still bound
+    return;
+  }
+
+  // Every cached vertex array object enables its own attributes, nothing has to be disabled later
+  pipelineState.clearActiveAttributesLocations();
+
+  vertexArrayKey_.clear();
+  for (size_t bufferIndex = 0; bufferIndex < IGL_BUFFER_BINDINGS_MAX; ++bufferIndex) {
+    if (vertexBuffersBound_[bufferIndex]) {
+      const auto& bufferState = vertexBuffers_[bufferIndex];
+      pipelineState.appendVertexAttributes(bufferIndex,
+                                           static_cast<ArrayBuffer*>(bufferState.resource)->getId(),
+                                           bufferState.offset + bufferState.slotOffset +
+                                               bufferState.baseOffset,
+                                           vertexArrayKey_);
+    }
+  }
+  if (indexBuffer_) {
+    vertexArrayKey_.indexBuffer = static_cast<ArrayBuffer*>(indexBuffer_)->getId();
+  }
+
+  cache.bind(getContext(), vertexArrayKey_);
+  usedVertexArrayObjectCache_ = true;
+
+  vertexBuffersDirty_.reset();
+  clearDirty(StateMask::VertexArray);
+}
+
+void RenderCommandAdapter::updateStreamingVertexBuffers() {
+  for (size_t bufferIndex = 0; bufferIndex < IGL_BUFFER_BINDINGS_MAX; ++bufferIndex) {
+    if (streamingVertexBuffers_[bufferIndex]) {
+      auto& bufferState = vertexBuffers_[bufferIndex];
+      const size_t slotOffset =
+          static_cast<ArrayBuffer*>(bufferState.resource)->useStreamingSlot();
+      if (slotOffset != bufferState.slotOffset) {
+        bufferState.slotOffset = slotOffset;
+        SET_DIRTY(vertexBuffersDirty_, bufferIndex);
+      }
+    }
+  }
+}
+
+void RenderCommandAdapter::setDrawBase(size_t baseVertex, size_t baseInstance) {
+  auto* pipelineState = static_cast<RenderPipelineState*>(pipelineState_.get());
+  if ((baseVertex == baseVertex_ && baseInstance == baseInstance_) || !pipelineState) {
+    return;
+  }
+  baseVertex_ = baseVertex;
+  baseInstance_ = baseInstance;
+
+  auto* vertexInputState = static_cast<VertexInputState*>(
+      pipelineState->getRenderPipelineDesc().vertexInputState.get());
+  if (!vertexInputState) {
+    return;
+  }
+  for (size_t bufferIndex = 0; bufferIndex < IGL_BUFFER_BINDINGS_MAX; ++bufferIndex) {
+    if (!vertexBuffersBound_[bufferIndex]) {
+      continue;
+    }
+    // all attributes of a buffer share its stride and sample function
+    const auto& attributes = vertexInputState->getAssociatedAttributes(bufferIndex);
+    size_t baseOffset = 0;
+    if (!attributes.empty()) {
+      const auto& attribute = attributes.front();
+      const auto stride = static_cast<size_t>(attribute.stride);
+      if (attribute.sampleFunction == VertexSampleFunction::PerVertex) {
+        baseOffset = baseVertex * stride;
+      } else if (attribute.sampleFunction == VertexSampleFunction::Instance) {
+        // the base instance is not divided by the divisor
+        baseOffset = baseInstance * stride;
+      }
+    }
+    auto& bufferState = vertexBuffers_[bufferIndex];
+    if (baseOffset != bufferState.baseOffset) {
+      bufferState.baseOffset = baseOffset;
+      SET_DIRTY(vertexBuffersDirty_, bufferIndex);
+    }
+  }
+}
+
 void RenderCommandAdapter::unbindTexture(IContext& context,
                                          size_t textureUnit,
                                          TextureState& textureState) {
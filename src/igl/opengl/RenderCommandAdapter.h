@@ -15,6 +15,7 @@
 #include <igl/opengl/GLIncludes.h>
 #include <igl/opengl/UnbindPolicy.h>
 #include <igl/opengl/UniformAdapter.h>
+#include <igl/opengl/VertexArrayObjectCache.h>
 #include <igl/opengl/WithContext.h>
 
 namespace igl {
@@ -27,17 +28,27 @@ class IRenderPipelineState;
 
 namespace opengl {
 class Buffer;
+class RenderPipelineState;
 class VertexArrayObject;
 
 class RenderCommandAdapter final : public WithContext {
  public:
   using StateBits = uint32_t;
-  enum class StateMask : StateBits { NONE = 0, PIPELINE = 1 << 1, DepthStencil = 1 << 2 };
+  enum class StateMask : StateBits {
+    NONE = 0,
+    PIPELINE = 1 << 1,
+    DepthStencil = 1 << 2,
+    VertexArray = 1 << 3,
+  };
 
  private:
   struct BufferState {
     Buffer* resource = nullptr;
     size_t offset = 0;
+    // the slot of a streaming buffer which was bound, see ArrayBuffer::useStreamingSlot()
+    size_t slotOffset = 0;
+    // the first vertex or instance of an emulated indirect draw, see setDrawBase()
+    size_t baseOffset = 0;
   };
 
   using TextureState = std::pair<ITexture*, ISamplerState*>;
@@ -100,6 +111,27 @@ class RenderCommandAdapter final : public WithContext {
                             Buffer& indirectBuffer,
                             const GLvoid* indirectBufferOffset);
 
+  /// @brief Issues `drawCount` commands from the indirect buffer with a single
+  /// glMultiDrawArraysIndirect() where InternalFeatures::MultiDrawIndirect is supported, one
+  /// glDrawArraysIndirect() per command on other contexts with indirect draws, and validated
+  /// glDrawArrays*() calls from the CPU copy of the commands otherwise (see
+  /// ArrayBuffer::getIndirectCommands()). The CPU path offsets the per-instance vertex buffers by
+  /// the baseInstance of each command, so a draw ID passed in as baseInstance reaches per-instance
+  /// attributes like gl_DrawID. The GPU paths need InternalFeatures::BaseInstance for that.
+  void multiDrawArraysIndirect(GLenum mode,
+                               Buffer& indirectBuffer,
+                               size_t indirectBufferOffset,
+                               GLsizei drawCount,
+                               GLsizei stride);
+  /// @brief Same as multiDrawArraysIndirect() for indexed draws, `firstIndex` of each command is
+  /// relative to the start of the index buffer.
+  void multiDrawElementsIndirect(GLenum mode,
+                                 GLenum indexType,
+                                 Buffer& indirectBuffer,
+                                 size_t indirectBufferOffset,
+                                 GLsizei drawCount,
+                                 GLsizei stride);
+
   void endEncoding();
 
   void initialize(const RenderPassDesc& renderPass,
@@ -119,6 +151,12 @@ class RenderCommandAdapter final : public WithContext {
   void willDraw();
   void didDraw();
   void unbindVertexAttributes();
+  // marks the vertex buffers dirty whose streaming slot changed since they were bound
+  void updateStreamingVertexBuffers();
+  void bindCachedVertexArray(RenderPipelineState& pipelineState, VertexArrayObjectCache& cache);
+  // offsets the per-vertex and per-instance vertex buffers, so the next draws start at the given
+  // vertex and instance on contexts without base vertex and base instance draws
+  void setDrawBase(size_t baseVertex, size_t baseInstance);
 
   void bindBufferWithShaderStorageBufferOverride(Buffer& buffer,
                                                  GLenum overrideTargetForShaderStorageBuffer);
@@ -145,6 +183,14 @@ class RenderCommandAdapter final : public WithContext {
  private:
   std::array<BufferState, IGL_BUFFER_BINDINGS_MAX> vertexBuffers_;
   std::bitset<IGL_BUFFER_BINDINGS_MAX> vertexBuffersDirty_;
+  // only used with IContext::getVertexArrayObjectCache()
+  std::bitset<IGL_BUFFER_BINDINGS_MAX> vertexBuffersBound_;
+  std::bitset<IGL_BUFFER_BINDINGS_MAX> streamingVertexBuffers_;
+  Buffer* indexBuffer_ = nullptr;
+  size_t baseVertex_ = 0;
+  size_t baseInstance_ = 0;
+  VertexArrayObjectCache::Key vertexArrayKey_;
+  bool usedVertexArrayObjectCache_ = false;
   std::bitset<IGL_TEXTURE_SAMPLERS_MAX> vertexTextureStatesDirty_;
   std::bitset<IGL_TEXTURE_SAMPLERS_MAX> fragmentTextureStatesDirty_;
   TextureStates vertexTextureStates_;
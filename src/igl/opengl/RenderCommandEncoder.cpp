@@ -15,6 +15,7 @@
 #include <igl/opengl/Framebuffer.h>
 #include <igl/opengl/IContext.h>
 #include <igl/opengl/PlatformDevice.h>
+#include <igl/opengl/QueryPool.h>
 #include <igl/opengl/RenderCommandAdapter.h>
 #include <igl/opengl/UniformAdapter.h>
 
@@ -231,6 +232,18 @@ void RenderCommandEncoder::popDebugGroupLabel() const {
   }
 }
 
+void RenderCommandEncoder::writeTimestamp(IQueryPool& pool, uint32_t query) {
+  static_cast<QueryPool&>(pool).writeTimestamp(query);
+}
+
+void RenderCommandEncoder::beginQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
+void RenderCommandEncoder::endQuery(IQueryPool& /*pool*/, uint32_t /*query*/) {
+  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+}
+
 void RenderCommandEncoder::bindViewport(const Viewport& viewport) {
   if (IGL_DEBUG_VERIFY(adapter_)) {
     adapter_->setViewport(viewport);
@@ -410,12 +423,12 @@ void RenderCommandEncoder::multiDrawIndirect(IBuffer& indirectBuffer,
   if (IGL_DEBUG_VERIFY(adapter_)) {
     getCommandBuffer().incrementCurrentDrawCount();
     const auto mode = toGlPrimitive(adapter_->pipelineState().getRenderPipelineDesc().topology);
-    const auto* indirectBufferOffsetPtr =
-        reinterpret_cast<uint8_t*>(indirectBufferOffset); // NOLINT(performance-no-int-to-ptr)
-    for (uint32_t i = 0; i != drawCount; i++) {
-      adapter_->drawArraysIndirect(mode, (Buffer&)indirectBuffer, indirectBufferOffsetPtr);
-      indirectBufferOffsetPtr += stride ? stride : 16u; // sizeof(DrawArraysIndirectCommand)
-    }
+    adapter_->multiDrawArraysIndirect(mode,
+                                      (Buffer&)indirectBuffer,
+                                      indirectBufferOffset,
+                                      static_cast<GLsizei>(drawCount),
+                                      // sizeof(DrawArraysIndirectCommand)
+                                      static_cast<GLsizei>(stride ? stride : 16u));
   }
 }
 
@@ -427,18 +440,16 @@ void RenderCommandEncoder::multiDrawIndexedIndirect(IBuffer& indirectBuffer,
   // NOLINTEND(bugprone-easily-swappable-parameters)
   IGL_DEBUG_ASSERT(indexType_, "No index buffer bound");
 
-  // TODO: use glMultiDrawElementsIndirect() when available
-
   if (IGL_DEBUG_VERIFY(adapter_ && indexType_)) {
     getCommandBuffer().incrementCurrentDrawCount();
     const auto mode = toGlPrimitive(adapter_->pipelineState().getRenderPipelineDesc().topology);
-    const auto* indirectBufferOffsetPtr =
-        reinterpret_cast<uint8_t*>(indirectBufferOffset); // NOLINT(performance-no-int-to-ptr)
-    for (uint32_t i = 0; i != drawCount; i++) {
-      adapter_->drawElementsIndirect(
-          mode, indexType_, (Buffer&)indirectBuffer, indirectBufferOffsetPtr);
-      indirectBufferOffsetPtr += stride ? stride : 20u; // sizeof(DrawElementsIndirectCommand)
-    }
+    adapter_->multiDrawElementsIndirect(mode,
+                                        indexType_,
+                                        (Buffer&)indirectBuffer,
+                                        indirectBufferOffset,
+                                        static_cast<GLsizei>(drawCount),
+                                        // sizeof(DrawElementsIndirectCommand)
+                                        static_cast<GLsizei>(stride ? stride : 20u));
   }
 }
 
@@ -46,6 +46,12 @@ class RenderCommandEncoder final : public IRenderCommandEncoder, public WithCont
   void insertDebugEventLabel(const char* label, const igl::Color& color) const override;
   void popDebugGroupLabel() const override;
 
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+  /// @brief Not supported: OpenGL only implements timestamp queries
+  void beginQuery(IQueryPool& pool, uint32_t query) override;
+  /// @brief Not supported: OpenGL only implements timestamp queries
+  void endQuery(IQueryPool& pool, uint32_t query) override;
+
   void bindViewport(const Viewport& viewport) override;
   void bindScissorRect(const ScissorRect& rect) override;
 
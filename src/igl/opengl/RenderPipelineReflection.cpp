@@ -87,6 +87,7 @@ RenderPipelineReflection::RenderPipelineReflection(IContext& context, const Shad
     generateUniformBlocksDictionary(context, stages.getProgramID());
   }
   generateUniformDictionary(context, stages.getProgramID());
+  generateBatchedUniformLayout();
   generateAttributeDictionary(context, stages.getProgramID());
   generateShaderStorageBufferObjectDictionary(context, stages.getProgramID());
   cacheDescriptors();
@@ -222,6 +223,10 @@ void RenderPipelineReflection::generateUniformBlocksDictionary(IContext& context
                                &memberDesc.type,
                                nameData.data());
       context.getActiveUniformsiv(pid, 1, &index, GL_UNIFORM_OFFSET, &memberDesc.offset);
+      context.getActiveUniformsiv(
+          pid, 1, &index, GL_UNIFORM_ARRAY_STRIDE, &memberDesc.arrayStride);
+      context.getActiveUniformsiv(
+          pid, 1, &index, GL_UNIFORM_MATRIX_STRIDE, &memberDesc.matrixStride);
 
       // Fix the name by removing [0] suffix for arrays
       // and by stripping the block name from the uniform name
@@ -245,6 +250,35 @@ void RenderPipelineReflection::generateUniformBlocksDictionary(IContext& context
   }
 }
 
+void RenderPipelineReflection::generateBatchedUniformLayout() {
+  batchedUniformLayout_ = {};
+  const auto blockIt =
+      uniformBlocksDictionary_.find(igl::genNameHandle(UniformBatchBuffer::kBlockName));
+  if (blockIt == uniformBlocksDictionary_.end()) {
+    return;
+  }
+  const UniformBlockDesc& blockDesc = blockIt->second;
+
+  // the members get locations after the locations of the loose uniforms
+  GLint firstLocation = 0;
+  for (const auto& entry : uniformDictionary_) {
+    firstLocation = std::max(firstLocation, entry.second.location + entry.second.size);
+  }
+
+  batchedUniformLayout_.blockIndex = blockDesc.blockIndex;
+  batchedUniformLayout_.size = blockDesc.size;
+  batchedUniformLayout_.firstLocation = firstLocation;
+  batchedUniformLayout_.members.reserve(blockDesc.members.size());
+  for (const auto& [name, memberDesc] : blockDesc.members) {
+    const auto location =
+        firstLocation + static_cast<GLint>(batchedUniformLayout_.members.size());
+    batchedUniformLayout_.members.push_back(
+        {memberDesc.offset, memberDesc.arrayStride, memberDesc.matrixStride, memberDesc.size});
+    uniformDictionary_.insert(
+        std::make_pair(name, UniformDesc(memberDesc.size, location, memberDesc.type)));
+  }
+}
+
 void RenderPipelineReflection::generateAttributeDictionary(IContext& context, GLuint pid) {
   IGL_DEBUG_ASSERT(pid != 0);
 
@@ -377,6 +411,10 @@ void RenderPipelineReflection::cacheDescriptors() {
   // uniform blocks
   for (const auto& blockEntry : uniformBlocksDictionary_) {
     const auto& blockDesc = blockEntry.second;
+    if (blockDesc.blockIndex == batchedUniformLayout_.blockIndex) {
+      // bound by the uniform adapter, its members are listed as loose uniforms above
+      continue;
+    }
     BufferArgDesc bufferDesc;
     bufferDesc.isUniformBlock = true;
     bufferDesc.name = blockEntry.first;
@@ -12,6 +12,7 @@
 #include <igl/opengl/GLIncludes.h> // @donotremove
 #include <igl/opengl/IContext.h>
 #include <igl/opengl/Shader.h>
+#include <igl/opengl/UniformBatchBuffer.h>
 
 namespace igl::opengl {
 
@@ -31,6 +32,8 @@ class RenderPipelineReflection final : public IRenderPipelineReflection {
       GLsizei size = 0;
       GLenum type = GL_NONE;
       GLint offset = 0;
+      GLint arrayStride = 0;
+      GLint matrixStride = 0;
     };
 
     GLint size{};
@@ -58,6 +61,12 @@ class RenderPipelineReflection final : public IRenderPipelineReflection {
     return uniformBlocksDictionary_;
   }
 
+  /// @brief Returns the layout of the UniformBatchBuffer::kBlockName block, or nullptr if the
+  /// program has none. Its members are also listed in getUniformDictionary().
+  [[nodiscard]] const UniformBatchBuffer::Layout* IGL_NULLABLE getBatchedUniformLayout() const {
+    return batchedUniformLayout_.blockIndex >= 0 ? &batchedUniformLayout_ : nullptr;
+  }
+
   [[nodiscard]] const std::unordered_map<std::string, int>& getAttributeDictionary() const {
     return attributeDictionary_;
   }
@@ -75,9 +84,12 @@ class RenderPipelineReflection final : public IRenderPipelineReflection {
   std::unordered_map<NameHandle, UniformBlockDesc> uniformBlocksDictionary_;
   std::unordered_map<std::string, int> attributeDictionary_;
   std::unordered_map<NameHandle, int> shaderStorageBufferObjectDictionary_;
+  UniformBatchBuffer::Layout batchedUniformLayout_;
 
   void generateUniformDictionary(IContext& context, GLuint pid);
   void generateUniformBlocksDictionary(IContext& context, GLuint pid);
+  // exposes the members of the batched uniform block as loose uniforms
+  void generateBatchedUniformLayout();
   void generateShaderStorageBufferObjectDictionary(IContext& context, GLuint pid);
   void generateAttributeDictionary(IContext& context, GLuint pid);
 
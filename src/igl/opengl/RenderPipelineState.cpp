@@ -117,6 +117,16 @@ Result RenderPipelineState::create() {
     return Result(Result::Code::ArgumentInvalid, "Missing required shader module(s).");
   }
 
+  if (shaderStages->isLinkPending()) {
+    // the reflection queries would wait for the link, see waitUntilReady()
+    pending_ = true;
+    return Result();
+  }
+  return finishCreate();
+}
+
+Result RenderPipelineState::finishCreate() {
+  const auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
   reflection_ = std::make_shared<RenderPipelineReflection>(getContext(), *shaderStages);
 
   const auto& mFramebufferDesc = desc_.targetDesc;
@@ -169,6 +179,10 @@ Result RenderPipelineState::create() {
     }
   }
 
+  if (const auto* batchedUniformLayout = reflection_->getBatchedUniformLayout()) {
+    uniformBlockBindingMap_[batchedUniformLayout->blockIndex] = UniformBatchBuffer::kBindingIndex;
+  }
+
   for (const auto& [textureUnit, samplerName] : desc_.vertexUnitSamplerMap) {
     const int loc = reflection_->getIndexByName(samplerName);
     if (loc < 0) {
@@ -216,6 +230,26 @@ Result RenderPipelineState::create() {
   return Result();
 }
 
+bool RenderPipelineState::isReady() const {
+  return !pending_ || getShaderStages()->isLinkComplete();
+}
+
+Result RenderPipelineState::waitUntilReady() {
+  if (!pending_) {
+    return pendingResult_;
+  }
+  pending_ = false;
+  auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
+  pendingResult_ = shaderStages->waitForLink();
+  if (pendingResult_.isOk()) {
+    pendingResult_ = finishCreate();
+  }
+  if (!pendingResult_.isOk()) {
+    IGL_LOG_ERROR("Failed to create the render pipeline:\n%s\n", pendingResult_.message.c_str());
+  }
+  return pendingResult_;
+}
+
 void RenderPipelineState::bind() {
   if (desc_.shaderStages) {
     const auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
@@ -321,6 +355,38 @@ void RenderPipelineState::bindVertexAttributes(size_t bufferIndex, size_t buffer
   }
 }
 
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void RenderPipelineState::appendVertexAttributes(size_t bufferIndex,
+                                                 GLuint buffer,
+                                                 size_t bufferOffset,
+                                                 VertexArrayObjectCache::Key& key) const {
+  const auto& attribList = static_cast<VertexInputState*>(desc_.vertexInputState.get())
+                               ->getAssociatedAttributes(bufferIndex);
+  const auto& locations = bufferAttribLocations_[bufferIndex];
+
+  IGL_DEBUG_ASSERT(attribList.size() == locations.size());
+
+  for (size_t i = 0, iLen = attribList.size(); i < iLen; i++) {
+    const auto location = locations[i];
+    if (location < 0) {
+      // Location not found
+      continue;
+    }
+    const auto& attribute = attribList[i];
+    VertexArrayObjectCache::Attribute& cached = key.attributes.emplace_back();
+    cached.location = static_cast<GLuint>(location);
+    cached.buffer = buffer;
+    cached.numComponents = attribute.numComponents;
+    cached.componentType = attribute.componentType;
+    cached.normalized = attribute.normalized;
+    cached.stride = attribute.stride;
+    cached.offset = attribute.bufferOffset + bufferOffset;
+    cached.divisor = attribute.sampleFunction == igl::VertexSampleFunction::Instance
+                         ? static_cast<GLuint>(attribute.sampleRate)
+                         : 0;
+  }
+}
+
 void RenderPipelineState::unbindVertexAttributes() {
   for (const auto& l : activeAttributesLocations_) {
     getContext().disableVertexAttribArray(l);
@@ -370,6 +436,17 @@ Result RenderPipelineState::bindTextureUnit(const size_t unit, uint8_t bindTarge
   return Result();
 }
 
+UniformBatchBuffer::Batch& RenderPipelineState::getUniformBatch() {
+  waitUntilReady();
+  auto& batch = static_cast<ShaderStages*>(desc_.shaderStages.get())->getUniformBatch();
+  const auto* layout = getBatchedUniformLayout();
+  if (layout && batch.data.size() != static_cast<size_t>(layout->size)) {
+    batch.data.assign(layout->size, 0);
+    batch.dirty = true;
+  }
+  return batch;
+}
+
 bool RenderPipelineState::matchesShaderProgram(const RenderPipelineState& rhs) const {
   return static_cast<ShaderStages*>(desc_.shaderStages.get())->getProgramID() ==
          static_cast<ShaderStages*>(rhs.desc_.shaderStages.get())->getProgramID();
@@ -379,7 +456,15 @@ bool RenderPipelineState::matchesVertexInputState(const RenderPipelineState& rhs
   return desc_.vertexInputState == rhs.desc_.vertexInputState;
 }
 
+void RenderPipelineState::waitForLink() const {
+  if (pending_) {
+    // the reflection is only available once the program has linked; a failed link leaves it empty
+    const_cast<RenderPipelineState*>(this)->waitUntilReady();
+  }
+}
+
 int RenderPipelineState::getIndexByName(const NameHandle& name, ShaderStage /*stage*/) const {
+  waitForLink();
   if (reflection_ == nullptr) {
     return -1;
   }
@@ -387,6 +472,7 @@ int RenderPipelineState::getIndexByName(const NameHandle& name, ShaderStage /*st
 }
 
 int RenderPipelineState::getIndexByName(const std::string& name, ShaderStage /*stage*/) const {
+  waitForLink();
   if (reflection_ == nullptr) {
     return -1;
   }
@@ -398,6 +484,7 @@ int RenderPipelineState::getUniformBlockBindingPoint(const NameHandle& uniformBl
 }
 
 std::shared_ptr<IRenderPipelineReflection> RenderPipelineState::renderPipelineReflection() {
+  waitUntilReady();
   return reflection_;
 }
 
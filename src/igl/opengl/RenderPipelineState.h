@@ -14,6 +14,7 @@
 #include <igl/opengl/IContext.h>
 #include <igl/opengl/RenderPipelineReflection.h>
 #include <igl/opengl/Shader.h>
+#include <igl/opengl/VertexArrayObjectCache.h>
 
 namespace igl::opengl {
 
@@ -30,6 +31,8 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   friend class Device;
 
   Result create();
+  // The part of create() which needs the linked program
+  Result finishCreate();
 
  public:
   explicit RenderPipelineState(IContext& context,
@@ -37,12 +40,25 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
                                Result* outResult);
   ~RenderPipelineState() override;
 
+  /// @brief Returns false while the program is still linking, see
+  /// IContext::setParallelShaderCompileEnabled()
+  [[nodiscard]] bool isReady() const override;
+  /// @brief Waits for the program to link and finishes creating the pipeline. The reflection and
+  /// the locations of a pipeline which is not ready are only available after this.
+  Result waitUntilReady();
+
   void bind();
   void unbind();
   Result bindTextureUnit(size_t unit, uint8_t bindTarget);
 
   void bindVertexAttributes(size_t bufferIndex, size_t offset);
   void unbindVertexAttributes();
+  // Appends the attributes sourced from the vertex buffer at `bufferIndex` to `key` instead of
+  // binding them
+  void appendVertexAttributes(size_t bufferIndex,
+                              GLuint buffer,
+                              size_t offset,
+                              VertexArrayObjectCache::Key& key) const;
 
   [[nodiscard]] bool matchesShaderProgram(const RenderPipelineState& rhs) const;
   [[nodiscard]] bool matchesVertexInputState(const RenderPipelineState& rhs) const;
@@ -71,6 +87,14 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
     return static_cast<ShaderStages*>(desc_.shaderStages.get());
   }
 
+  /// @brief Returns the layout of the batched uniform block of the program, or nullptr if it has
+  /// none (see UniformBatchBuffer)
+  [[nodiscard]] const UniformBatchBuffer::Layout* IGL_NULLABLE getBatchedUniformLayout() const {
+    return reflection_ ? reflection_->getBatchedUniformLayout() : nullptr;
+  }
+  /// @brief Returns the values of the batched uniform block, sized for getBatchedUniformLayout()
+  [[nodiscard]] UniformBatchBuffer::Batch& getUniformBatch();
+
   void savePrevPipelineStateAttributesLocations(RenderPipelineState& prevPipelineState) {
     prevPipelineStateAttributesLocations_ = std::move(prevPipelineState.activeAttributesLocations_);
   }
@@ -82,6 +106,9 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   void unbindPrevPipelineVertexAttributes();
 
  private:
+  // Lets the name queries, which are const, complete a pending link
+  void waitForLink() const;
+
   // Tracks a list of attribute locations associated with a bufferIndex
   std::vector<int> bufferAttribLocations_[IGL_BUFFER_BINDINGS_MAX];
 
@@ -95,6 +122,10 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   BlendMode blendMode_ = {GL_FUNC_ADD, GL_FUNC_ADD, GL_ONE, GL_ZERO, GL_ONE, GL_ZERO};
   bool blendEnabled_ = false;
   bool uniformBlockBindingPointSet_ = false;
+  // the program is linking in the background and finishCreate() has not run yet
+  bool pending_ = false;
+  // the result of finishCreate() for a pending pipeline
+  Result pendingResult_;
 };
 
 } // namespace igl::opengl
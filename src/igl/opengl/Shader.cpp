@@ -12,6 +12,7 @@
 #include <string>
 #include <igl/DeviceFeatures.h>
 #include <igl/opengl/DeviceFeatureSet.h>
+#include <igl/opengl/ProgramBinaryCache.h>
 
 #if IGL_SHADER_DUMP
 #include <filesystem>
@@ -45,8 +46,26 @@ void ShaderStages::createRenderProgram(Result* result) {
     return;
   }
 
-  const auto& vertexShader = static_cast<ShaderModule&>(*getVertexModule());
-  const auto& fragmentShader = static_cast<ShaderModule&>(*getFragmentModule());
+  auto& vertexShader = static_cast<ShaderModule&>(*getVertexModule());
+  auto& fragmentShader = static_cast<ShaderModule&>(*getFragmentModule());
+
+  const uint64_t moduleHashes[] = {vertexShader.getProgramBinaryHash(),
+                                   fragmentShader.getProgramBinaryHash()};
+  uint64_t cacheKey = 0;
+  const GLuint cachedProgramID = loadCachedProgram(moduleHashes, 2, cacheKey);
+  if (cachedProgramID != 0) {
+    setProgram(cachedProgramID);
+    Result::setResult(result, Result::Code::Ok);
+    return;
+  }
+
+  // with a program binary cache, the modules are only compiled when the program is not cached
+  for (ShaderModule* shader : {&vertexShader, &fragmentShader}) {
+    if (Result compileResult = shader->compile(); !compileResult.isOk()) {
+      Result::setResult(result, std::move(compileResult));
+      return;
+    }
+  }
   const GLuint vertexShaderID = vertexShader.getShaderID();
   const GLuint fragmentShaderID = fragmentShader.getShaderID();
 
@@ -64,6 +83,7 @@ void ShaderStages::createRenderProgram(Result* result) {
     Result::setResult(result, Result::Code::RuntimeError, "Failed to create GL program");
     return;
   }
+  prepareCachedProgram(programID, cacheKey);
 
   // attach the shaders and link them
   getContext().attachShader(programID, vertexShaderID);
@@ -74,25 +94,12 @@ void ShaderStages::createRenderProgram(Result* result) {
   getContext().detachShader(programID, vertexShaderID);
   getContext().detachShader(programID, fragmentShaderID);
 
-  // check to see if the linking succeeded
-  GLint status = 0;
-  getContext().getProgramiv(programID, GL_LINK_STATUS, &status);
-  if (status == GL_FALSE) {
-    const std::string errorLog = getProgramInfoLog(programID);
-    IGL_LOG_ERROR("failed to link shaders:\n%s\n", errorLog.c_str());
-
-    getContext().deleteProgram(programID);
-    Result::setResult(result, Result::Code::RuntimeError, errorLog);
+  if (getContext().isParallelShaderCompileEnabled()) {
+    deferLink(programID, cacheKey);
+    Result::setResult(result, Result::Code::Ok);
     return;
   }
-
-  // now that the program successfully linked, set the program
-  if (programID_ != 0) {
-    getContext().deleteProgram(programID_);
-  }
-  programID_ = programID;
-
-  Result::setResult(result, Result::Code::Ok);
+  completeLink(programID, cacheKey, result);
 }
 
 void ShaderStages::createComputeProgram(Result* result) {
@@ -102,8 +109,21 @@ void ShaderStages::createComputeProgram(Result* result) {
     return;
   }
 
-  const auto& shader = static_cast<ShaderModule&>(*getComputeModule());
+  auto& shader = static_cast<ShaderModule&>(*getComputeModule());
+
+  const uint64_t moduleHash = shader.getProgramBinaryHash();
+  uint64_t cacheKey = 0;
+  const GLuint cachedProgramID = loadCachedProgram(&moduleHash, 1, cacheKey);
+  if (cachedProgramID != 0) {
+    setProgram(cachedProgramID);
+    Result::setResult(result, Result::Code::Ok);
+    return;
+  }
 
+  if (Result compileResult = shader.compile(); !compileResult.isOk()) {
+    Result::setResult(result, std::move(compileResult));
+    return;
+  }
   const GLuint shaderID = shader.getShaderID();
 
   if (shaderID == 0) {
@@ -120,6 +140,7 @@ void ShaderStages::createComputeProgram(Result* result) {
     Result::setResult(result, Result::Code::RuntimeError, "Failed to create compute GL program");
     return;
   }
+  prepareCachedProgram(programID, cacheKey);
 
   // attach the shaders and link them
   getContext().attachShader(programID, shaderID);
@@ -128,25 +149,103 @@ void ShaderStages::createComputeProgram(Result* result) {
   // detach the shaders now that they've been linked
   getContext().detachShader(programID, shaderID);
 
+  if (getContext().isParallelShaderCompileEnabled()) {
+    deferLink(programID, cacheKey);
+    Result::setResult(result, Result::Code::Ok);
+    return;
+  }
+  completeLink(programID, cacheKey, result);
+}
+
+void ShaderStages::completeLink(GLuint programID, uint64_t cacheKey, Result* result) {
   // check to see if the linking succeeded
   GLint status = 0;
   getContext().getProgramiv(programID, GL_LINK_STATUS, &status);
   if (status == GL_FALSE) {
     const std::string errorLog = getProgramInfoLog(programID);
-    IGL_LOG_ERROR("failed to link compute shaders:\n%s\n", errorLog.c_str());
+    IGL_LOG_ERROR("failed to link %sshaders:\n%s\n",
+                  getType() == ShaderStagesType::Compute ? "compute " : "",
+                  errorLog.c_str());
 
     getContext().deleteProgram(programID);
     Result::setResult(result, Result::Code::RuntimeError, errorLog);
     return;
   }
 
+  if (auto* cache = getContext().getProgramBinaryCache(); cache && cacheKey != 0) {
+    cache->storeProgram(getContext(), cacheKey, programID);
+  }
+
   // now that the program successfully linked, set the program
+  setProgram(programID);
+
+  Result::setResult(result, Result::Code::Ok);
+}
+
+void ShaderStages::deferLink(GLuint programID, uint64_t cacheKey) {
+  // querying GL_LINK_STATUS would wait for the driver, so it is checked in waitForLink()
+  setProgram(programID);
+  linkPending_ = true;
+  pendingCacheKey_ = cacheKey;
+}
+
+bool ShaderStages::isLinkComplete() const {
+  if (!linkPending_ ||
+      !getContext().deviceFeatures().hasInternalFeature(InternalFeatures::ParallelShaderCompile)) {
+    return true;
+  }
+  GLint completed = GL_FALSE;
+  getContext().getProgramiv(programID_, GL_COMPLETION_STATUS_KHR, &completed);
+  return completed != GL_FALSE;
+}
+
+Result ShaderStages::waitForLink() {
+  if (!linkPending_) {
+    return linkResult_;
+  }
+  linkPending_ = false;
+  const GLuint programID = programID_;
+  programID_ = 0;
+  completeLink(programID, pendingCacheKey_, &linkResult_);
+
+  if (!linkResult_.isOk()) {
+    // report the shader which failed to compile rather than the link error
+    for (const auto& module : {getVertexModule(), getFragmentModule(), getComputeModule()}) {
+      if (!module) {
+        continue;
+      }
+      Result compileResult = static_cast<ShaderModule&>(*module).waitForCompile();
+      if (!compileResult.isOk()) {
+        linkResult_ = std::move(compileResult);
+        break;
+      }
+    }
+  }
+  return linkResult_;
+}
+
+GLuint ShaderStages::loadCachedProgram(const uint64_t* moduleHashes,
+                                       size_t numModules,
+                                       uint64_t& outKey) const {
+  auto* cache = getContext().getProgramBinaryCache();
+  if (!cache) {
+    return 0;
+  }
+  outKey = cache->getProgramKey(getContext(), moduleHashes, numModules);
+  return cache->loadProgram(getContext(), outKey);
+}
+
+void ShaderStages::prepareCachedProgram(GLuint programID, uint64_t cacheKey) const {
+  if (auto* cache = getContext().getProgramBinaryCache(); cache && cacheKey != 0) {
+    cache->prepareProgram(getContext(), programID);
+  }
+}
+
+void ShaderStages::setProgram(GLuint programID) {
   if (programID_ != 0) {
     getContext().deleteProgram(programID_);
   }
   programID_ = programID;
-
-  Result::setResult(result, Result::Code::Ok);
 }
 
 // link the given shaders into this shader program
@@ -160,6 +259,7 @@ Result ShaderStages::create(const ShaderStagesDesc& /*desc*/) {
     IGL_DEBUG_ASSERT_NOT_REACHED();
   }
 
+  linkResult_ = result;
   return result;
 }
 
@@ -226,6 +326,33 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
     return Result(Result::Code::ArgumentInvalid, "Unknown shader type");
   }
 
+  hash_ =
+      std::hash<std::string_view>()(std::string_view(desc.input.source, strlen(desc.input.source)));
+  programBinaryHash_ = ProgramBinaryCache::hashShaderModule(
+      desc.info.stage, desc.input.source, desc.input.options);
+
+  if (getContext().getProgramBinaryCache()) {
+    // programs are looked up in the cache first, the shader is only compiled on a miss
+    deferredSource_ = desc.input.source;
+    deferredDebugName_ = desc.debugName;
+    return Result();
+  }
+  return compile(desc.input.source, desc.debugName);
+}
+
+Result ShaderModule::compile() {
+  if (shaderID_ != 0 || deferredSource_.empty()) {
+    return Result();
+  }
+  Result result = compile(deferredSource_.c_str(), deferredDebugName_);
+  if (result.isOk()) {
+    deferredSource_.clear();
+    deferredDebugName_.clear();
+  }
+  return result;
+}
+
+Result ShaderModule::compile(const char* source, const std::string& debugName) {
   // always create a new temp shader ID
   // we'll set or update this object's shader ID after the compilation succeeds
   // otherwise we won't modify this shader
@@ -234,22 +361,22 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
     return Result(Result::Code::RuntimeError, "Failed to create shader ID");
   }
 
-  if (!desc.debugName.empty() &&
+  if (!debugName.empty() &&
       getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DebugLabel)) {
     const GLenum identifier = getContext().deviceFeatures().hasInternalRequirement(
                                   InternalRequirement::DebugLabelExtEnumsReq)
                                   ? GL_SHADER_OBJECT_EXT
                                   : GL_SHADER;
-    getContext().objectLabel(identifier, shaderID, desc.debugName.size(), desc.debugName.c_str());
+    getContext().objectLabel(identifier, shaderID, debugName.size(), debugName.c_str());
   }
 
   // compile the shader
-  const GLchar* src = (GLchar*)desc.input.source;
+  const GLchar* src = source;
 
 #if IGL_SHADER_DUMP
   auto hash = std::hash<const GLchar*>()(src);
   std::string shaderStageExt;
-  switch (desc.info.stage) {
+  switch (info().stage) {
   case ShaderStage::Vertex:
     shaderStageExt = ".vert";
     break;
@@ -277,30 +404,18 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
   getContext().shaderSource(shaderID, 1, &src, nullptr);
   getContext().compileShader(shaderID);
 
-  // see if the compilation succeeded
-  GLint status = 0;
-  getContext().getShaderiv(shaderID, GL_COMPILE_STATUS, &status);
-  if (status == GL_FALSE) {
-    // Get the size of log
-    GLsizei logSize = 0;
-    getContext().getShaderiv(shaderID, GL_INFO_LOG_LENGTH, &logSize);
-
-    // Pre-allocate vector for storage
-    std::vector<GLchar> log(logSize);
-    getContext().getShaderInfoLog(shaderID, logSize, nullptr, log.data());
-
-    // Create actual string from it
-    const std::string errorLog(log.begin(), log.end());
-    IGL_LOG_ERROR("failed to compile %s shader:\n%s\nSource\n%s",
-                  (shaderType_ == GL_VERTEX_SHADER ? "vertex" : "fragment"),
-                  errorLog.c_str(),
-                  src);
-
-    // Delete shader to make sure that we don't have dangling resources
-    getContext().deleteShader(shaderID);
-
-    // Report back.
-    return Result(Result::Code::ArgumentInvalid, errorLog);
+  // querying GL_COMPILE_STATUS would wait for the driver, so a deferred compilation is checked when
+  // a program using the shader is linked, see ShaderStages::waitForLink()
+  compilePending_ = getContext().isParallelShaderCompileEnabled();
+  if (!compilePending_) {
+    Result result = getCompileResult(shaderID, src);
+    if (!result.isOk()) {
+      // Delete shader to make sure that we don't have dangling resources
+      getContext().deleteShader(shaderID);
+
+      // Report back.
+      return result;
+    }
   }
 
   // now that the shader successfully compiled, set the shader
@@ -309,12 +424,43 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
   }
   shaderID_ = shaderID;
 
-  hash_ =
-      std::hash<std::string_view>()(std::string_view(desc.input.source, strlen(desc.input.source)));
-
   return Result();
 }
 
+Result ShaderModule::waitForCompile() {
+  if (!compilePending_) {
+    return Result();
+  }
+  compilePending_ = false;
+  return getCompileResult(shaderID_, nullptr);
+}
+
+Result ShaderModule::getCompileResult(GLuint shaderID, const GLchar* IGL_NULLABLE src) const {
+  // see if the compilation succeeded
+  GLint status = 0;
+  getContext().getShaderiv(shaderID, GL_COMPILE_STATUS, &status);
+  if (status != GL_FALSE) {
+    return Result();
+  }
+
+  // Get the size of log
+  GLsizei logSize = 0;
+  getContext().getShaderiv(shaderID, GL_INFO_LOG_LENGTH, &logSize);
+
+  // Pre-allocate vector for storage
+  std::vector<GLchar> log(logSize);
+  getContext().getShaderInfoLog(shaderID, logSize, nullptr, log.data());
+
+  // Create actual string from it
+  std::string errorLog(log.begin(), log.end());
+  IGL_LOG_ERROR("failed to compile %s shader:\n%s\nSource\n%s",
+                (shaderType_ == GL_VERTEX_SHADER ? "vertex" : "fragment"),
+                errorLog.c_str(),
+                src ? src : "(deferred compilation)");
+
+  return Result(Result::Code::ArgumentInvalid, std::move(errorLog));
+}
+
 std::string ShaderStages::getProgramInfoLog(GLuint programID) const {
   // Get the size of log
   GLsizei logSize = 0;
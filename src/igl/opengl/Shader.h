@@ -8,6 +8,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <string>
 #include <unordered_map>
 #include <igl/ComputePipelineState.h>
 #include <igl/NameHandle.h>
@@ -15,6 +16,7 @@
 #include <igl/Shader.h>
 #include <igl/opengl/GLIncludes.h>
 #include <igl/opengl/IContext.h>
+#include <igl/opengl/UniformBatchBuffer.h>
 
 namespace igl {
 class ICommandBuffer;
@@ -39,9 +41,28 @@ class ShaderModule : public WithContext, public IShaderModule {
     return hash_;
   }
 
+  // Hash of the source, the stage and the compiler options which is stable across launches
+  [[nodiscard]] inline uint64_t getProgramBinaryHash() const {
+    return programBinaryHash_;
+  }
+
   ShaderModule(IContext& context, ShaderModuleInfo info);
 
+  /// @brief Returns the result of the compilation, waiting for it if the driver is still compiling
+  /// in the background (see IContext::setParallelShaderCompileEnabled())
+  Result waitForCompile();
+
+  /// @brief Compiles the shader if the compilation was deferred, because the context has a program
+  /// binary cache (see IContext::setProgramBinaryStorage()). ShaderStages call this when their
+  /// program is not in the cache, so the shader is not compiled for cached programs.
+  Result compile();
+
  private:
+  Result compile(const char* source, const std::string& debugName);
+
+  // Checks the compile status of `shaderID` and logs the errors with the source, if there is one
+  [[nodiscard]] Result getCompileResult(GLuint shaderID, const GLchar* IGL_NULLABLE src) const;
+
   // Type of shader (vertex, fragment, compute)
   GLenum shaderType_ = 0;
 
@@ -50,6 +71,16 @@ class ShaderModule : public WithContext, public IShaderModule {
 
   // Hash of the shader source
   size_t hash_ = 0;
+
+  // Key of the shader in ProgramBinaryCache
+  uint64_t programBinaryHash_ = 0;
+
+  // The compile status has not been checked yet
+  bool compilePending_ = false;
+
+  // Not empty until compile() is called, if the compilation was deferred
+  std::string deferredSource_;
+  std::string deferredDebugName_;
 };
 
 class ShaderStages final : public IShaderStages, public WithContext {
@@ -69,13 +100,49 @@ class ShaderStages final : public IShaderStages, public WithContext {
     return programID_;
   }
 
+  /// @brief Returns true if the program was linked in the background and its link status has not
+  /// been checked yet (see IContext::setParallelShaderCompileEnabled())
+  [[nodiscard]] bool isLinkPending() const {
+    return linkPending_;
+  }
+  /// @brief Returns false while the driver is still linking the program in the background. It
+  /// polls GL_COMPLETION_STATUS_KHR, so it does not wait for the driver.
+  [[nodiscard]] bool isLinkComplete() const;
+  /// @brief Waits for a pending link and returns the result of create(). The program ID is 0 if
+  /// the link failed.
+  Result waitForLink();
+
+  // the values of the batched uniform block, which belong to the program like loose uniforms
+  [[nodiscard]] UniformBatchBuffer::Batch& getUniformBatch() {
+    return uniformBatch_;
+  }
+
  private:
   void createRenderProgram(Result* result);
   void createComputeProgram(Result* result);
+  // Returns a program from the program binary cache, or 0. Sets `outKey` if the cache is enabled.
+  [[nodiscard]] GLuint loadCachedProgram(const uint64_t* moduleHashes,
+                                         size_t numModules,
+                                         uint64_t& outKey) const;
+  // Lets the driver know that the binary of a program which is linked next will be retrieved
+  void prepareCachedProgram(GLuint programID, uint64_t cacheKey) const;
+  // Checks the link status of `programID` and makes it the program of the stages if it linked
+  void completeLink(GLuint programID, uint64_t cacheKey, Result* result);
+  // Makes `programID` the program of the stages without checking its link status
+  void deferLink(GLuint programID, uint64_t cacheKey);
+  void setProgram(GLuint programID);
   [[nodiscard]] std::string getProgramInfoLog(GLuint programID) const;
 
   // the GL shader program ID
   GLuint programID_ = 0;
+
+  // the link status of the program has not been checked yet
+  bool linkPending_ = false;
+  // key of the pending program in ProgramBinaryCache
+  uint64_t pendingCacheKey_ = 0;
+  Result linkResult_;
+
+  UniformBatchBuffer::Batch uniformBatch_;
 };
 
 } // namespace opengl
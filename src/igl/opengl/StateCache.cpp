@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/StateCache.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace igl::opengl {
+
+namespace {
+
+bool contains(GLsizei n, const GLuint* names, GLuint name) {
+  return name != 0 && names != nullptr && std::find(names, names + n, name) != names + n;
+}
+
+template<size_t N>
+void eraseNames(std::array<std::optional<GLuint>, N>& cached, GLsizei n, const GLuint* names) {
+  for (auto& name : cached) {
+    if (name && contains(n, names, *name)) {
+      name.reset();
+    }
+  }
+}
+
+} // namespace
+
+StateCache::BufferTarget StateCache::toBufferTarget(GLenum target) {
+  switch (target) {
+  case GL_ARRAY_BUFFER:
+    return BufferTarget::Array;
+  case GL_COPY_READ_BUFFER:
+    return BufferTarget::CopyRead;
+  case GL_COPY_WRITE_BUFFER:
+    return BufferTarget::CopyWrite;
+  case GL_DRAW_INDIRECT_BUFFER:
+    return BufferTarget::DrawIndirect;
+  case GL_ELEMENT_ARRAY_BUFFER:
+    return BufferTarget::ElementArray;
+  case GL_PIXEL_PACK_BUFFER:
+    return BufferTarget::PixelPack;
+  case GL_PIXEL_UNPACK_BUFFER:
+    return BufferTarget::PixelUnpack;
+  case GL_SHADER_STORAGE_BUFFER:
+    return BufferTarget::ShaderStorage;
+  case GL_UNIFORM_BUFFER:
+    return BufferTarget::Uniform;
+  default:
+    return BufferTarget::Count;
+  }
+}
+
+StateCache::TextureTarget StateCache::toTextureTarget(GLenum target) {
+  switch (target) {
+  case GL_TEXTURE_2D:
+    return TextureTarget::Texture2D;
+  case GL_TEXTURE_2D_ARRAY:
+    return TextureTarget::Texture2DArray;
+  case GL_TEXTURE_2D_MULTISAMPLE:
+    return TextureTarget::Texture2DMultisample;
+  case GL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+    return TextureTarget::Texture2DMultisampleArray;
+  case GL_TEXTURE_3D:
+    return TextureTarget::Texture3D;
+  case GL_TEXTURE_CUBE_MAP:
+    return TextureTarget::TextureCubeMap;
+  case GL_TEXTURE_EXTERNAL_OES:
+    return TextureTarget::TextureExternal;
+  case GL_TEXTURE_RECTANGLE:
+    return TextureTarget::TextureRectangle;
+  default:
+    return TextureTarget::Count;
+  }
+}
+
+StateCache::Capability StateCache::toCapability(GLenum cap) {
+  switch (cap) {
+  case GL_BLEND:
+    return Capability::Blend;
+  case GL_CULL_FACE:
+    return Capability::CullFace;
+  case GL_DEBUG_OUTPUT:
+    return Capability::DebugOutput;
+  case GL_DEPTH_TEST:
+    return Capability::DepthTest;
+  case GL_DITHER:
+    return Capability::Dither;
+  case GL_FRAMEBUFFER_SRGB:
+    return Capability::FramebufferSRGB;
+  case GL_POLYGON_OFFSET_FILL:
+    return Capability::PolygonOffsetFill;
+  case GL_SAMPLE_ALPHA_TO_COVERAGE:
+    return Capability::SampleAlphaToCoverage;
+  case GL_SAMPLE_COVERAGE:
+    return Capability::SampleCoverage;
+  case GL_SCISSOR_TEST:
+    return Capability::ScissorTest;
+  case GL_STENCIL_TEST:
+    return Capability::StencilTest;
+  case GL_TEXTURE_CUBE_MAP_SEAMLESS:
+    return Capability::TextureCubeMapSeamless;
+  default:
+    return Capability::Count;
+  }
+}
+
+uint64_t StateCache::Stats::getTotalIssued() const {
+  return std::accumulate(issued.begin(), issued.end(), uint64_t(0));
+}
+
+uint64_t StateCache::Stats::getTotalElided() const {
+  return std::accumulate(elided.begin(), elided.end(), uint64_t(0));
+}
+
+void StateCache::count(CallType type, bool issued) {
+  if (issued) {
+    stats_.issued[static_cast<size_t>(type)]++;
+  } else {
+    stats_.elided[static_cast<size_t>(type)]++;
+  }
+}
+
+template<typename T>
+bool StateCache::update(CallType type, std::optional<T>& cached, const T& value) {
+  const bool issued = !cached || *cached != value;
+  cached = value;
+  count(type, issued);
+  return issued;
+}
+
+template<typename T>
+bool StateCache::updateFaces(CallType type,
+                             std::array<std::optional<T>, 2>& cached,
+                             GLenum face,
+                             const T& v) {
+  const bool front = face == GL_FRONT || face == GL_FRONT_AND_BACK;
+  const bool back = face == GL_BACK || face == GL_FRONT_AND_BACK;
+  if (!front && !back) {
+    // let GL report the invalid enum
+    count(type, true);
+    return true;
+  }
+  bool issued = false;
+  if (front) {
+    issued |= !cached[0] || *cached[0] != v;
+    cached[0] = v;
+  }
+  if (back) {
+    issued |= !cached[1] || *cached[1] != v;
+    cached[1] = v;
+  }
+  count(type, issued);
+  return issued;
+}
+
+bool StateCache::activeTexture(GLenum texture) {
+  return update(CallType::ActiveTexture, activeTexture_, texture);
+}
+
+bool StateCache::bindBuffer(GLenum target, GLuint buffer) {
+  const auto index = static_cast<size_t>(toBufferTarget(target));
+  if (index == buffers_.size()) {
+    count(CallType::BindBuffer, true);
+    return true;
+  }
+  return update(CallType::BindBuffer, buffers_[index], buffer);
+}
+
+bool StateCache::bindTexture(GLenum target, GLuint texture) {
+  const auto index = static_cast<size_t>(toTextureTarget(target));
+  // the texture unit is unknown when activeTexture_ is empty
+  const size_t unit = activeTexture_ ? *activeTexture_ - GL_TEXTURE0 : textures_.size();
+  if (index == textures_[0].size() || unit >= textures_.size()) {
+    count(CallType::BindTexture, true);
+    return true;
+  }
+  return update(CallType::BindTexture, textures_[unit][index], texture);
+}
+
+bool StateCache::bindVertexArray(GLuint vao) {
+  const bool issued = update(CallType::BindVertexArray, vao_, vao);
+  if (issued) {
+    // the element array buffer binding is part of the vertex array state
+    buffers_[static_cast<size_t>(BufferTarget::ElementArray)].reset();
+  }
+  return issued;
+}
+
+bool StateCache::blendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+  return update(CallType::BlendColor, blendColor_, {red, green, blue, alpha});
+}
+
+bool StateCache::blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+  return update(CallType::BlendEquation, blendEquation_, {modeRGB, modeAlpha});
+}
+
+bool StateCache::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+  return update(CallType::BlendFunc, blendFunc_, {srcRGB, dstRGB, srcAlpha, dstAlpha});
+}
+
+bool StateCache::setEnabled(GLenum cap, bool enabled) {
+  const auto index = static_cast<size_t>(toCapability(cap));
+  if (index == capabilitiesKnown_.size()) {
+    count(CallType::Capability, true);
+    return true;
+  }
+  const bool issued = !capabilitiesKnown_[index] || capabilitiesEnabled_[index] != enabled;
+  capabilitiesKnown_.set(index);
+  capabilitiesEnabled_.set(index, enabled);
+  count(CallType::Capability, issued);
+  return issued;
+}
+
+bool StateCache::colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+  return update(CallType::ColorMask, colorMask_, {red, green, blue, alpha});
+}
+
+bool StateCache::cullFace(GLint mode) {
+  return update(CallType::CullFace, cullFace_, mode);
+}
+
+bool StateCache::depthFunc(GLenum func) {
+  return update(CallType::DepthFunc, depthFunc_, func);
+}
+
+bool StateCache::depthMask(GLboolean flag) {
+  return update(CallType::DepthMask, depthMask_, flag);
+}
+
+bool StateCache::frontFace(GLenum mode) {
+  return update(CallType::FrontFace, frontFace_, mode);
+}
+
+bool StateCache::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  return update(CallType::Scissor, scissor_, {x, y, width, height});
+}
+
+bool StateCache::stencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+  return updateFaces(
+      CallType::StencilFunc, stencilFunc_, face, StencilFunc{func, GLuint(ref), mask});
+}
+
+bool StateCache::stencilMaskSeparate(GLenum face, GLuint mask) {
+  return updateFaces(CallType::StencilMask, stencilMask_, face, mask);
+}
+
+bool StateCache::stencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass) {
+  return updateFaces(CallType::StencilOp, stencilOp_, face, StencilOp{fail, zfail, zpass});
+}
+
+bool StateCache::useProgram(GLuint program) {
+  return update(CallType::UseProgram, program_, program);
+}
+
+bool StateCache::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  return update(CallType::Viewport, viewport_, {x, y, width, height});
+}
+
+void StateCache::invalidateBuffer(GLenum target) {
+  const auto index = static_cast<size_t>(toBufferTarget(target));
+  if (index != buffers_.size()) {
+    buffers_[index].reset();
+  }
+}
+
+void StateCache::onBuffersDeleted(GLsizei n, const GLuint* buffers) {
+  eraseNames(buffers_, n, buffers);
+}
+
+void StateCache::onProgramDeleted(GLuint program) {
+  if (program_ && *program_ == program) {
+    program_.reset();
+  }
+}
+
+void StateCache::onTexturesDeleted(GLsizei n, const GLuint* textures) {
+  for (auto& unit : textures_) {
+    eraseNames(unit, n, textures);
+  }
+}
+
+void StateCache::onVertexArraysDeleted(GLsizei n, const GLuint* vertexArrays) {
+  if (vao_ && contains(n, vertexArrays, *vao_)) {
+    vao_.reset();
+    buffers_[static_cast<size_t>(BufferTarget::ElementArray)].reset();
+  }
+}
+
+void StateCache::invalidate() {
+  const Stats stats = stats_;
+  *this = StateCache();
+  stats_ = stats;
+}
+
+} // namespace igl::opengl
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <optional>
+#include <igl/Common.h>
+#include <igl/opengl/GLIncludes.h>
+
+namespace igl::opengl {
+
+/**
+ * @brief A shadow copy of the GL state set through IContext. Each setter returns true if the GL
+ * call has to be issued and false if it would not change the state, in which case IContext elides
+ * it. State which was never set through IContext (or was invalidated) is unknown, and the first
+ * call to set it is always issued.
+ *
+ * The shadow assumes IContext is the only way the state is changed. Code which calls GL directly
+ * must call IContext::invalidateStateCache() afterwards. Framebuffer bindings are not tracked, and
+ * neither are buffer targets, texture targets, texture units and capabilities outside of the fixed
+ * sets below: their calls are always issued.
+ */
+class StateCache final {
+ public:
+  enum class CallType : uint8_t {
+    ActiveTexture,
+    BindBuffer,
+    BindTexture,
+    BindVertexArray,
+    BlendColor,
+    BlendEquation,
+    BlendFunc,
+    Capability, // glEnable() and glDisable()
+    ColorMask,
+    CullFace,
+    DepthFunc,
+    DepthMask,
+    FrontFace,
+    Scissor,
+    StencilFunc,
+    StencilMask,
+    StencilOp,
+    UseProgram,
+    Viewport,
+    Count,
+  };
+
+  struct Stats {
+    std::array<uint64_t, static_cast<size_t>(CallType::Count)> issued{};
+    std::array<uint64_t, static_cast<size_t>(CallType::Count)> elided{};
+
+    [[nodiscard]] uint64_t getIssued(CallType type) const {
+      return issued[static_cast<size_t>(type)];
+    }
+    [[nodiscard]] uint64_t getElided(CallType type) const {
+      return elided[static_cast<size_t>(type)];
+    }
+    [[nodiscard]] uint64_t getTotalIssued() const;
+    [[nodiscard]] uint64_t getTotalElided() const;
+  };
+
+  [[nodiscard]] bool activeTexture(GLenum texture);
+  [[nodiscard]] bool bindBuffer(GLenum target, GLuint buffer);
+  [[nodiscard]] bool bindTexture(GLenum target, GLuint texture);
+  [[nodiscard]] bool bindVertexArray(GLuint vao);
+  [[nodiscard]] bool blendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha);
+  [[nodiscard]] bool blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha);
+  [[nodiscard]] bool blendFuncSeparate(GLenum srcRGB,
+                                       GLenum dstRGB,
+                                       GLenum srcAlpha,
+                                       GLenum dstAlpha);
+  [[nodiscard]] bool setEnabled(GLenum cap, bool enabled);
+  [[nodiscard]] bool colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
+  [[nodiscard]] bool cullFace(GLint mode);
+  [[nodiscard]] bool depthFunc(GLenum func);
+  [[nodiscard]] bool depthMask(GLboolean flag);
+  [[nodiscard]] bool frontFace(GLenum mode);
+  [[nodiscard]] bool scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+  [[nodiscard]] bool stencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask);
+  [[nodiscard]] bool stencilMaskSeparate(GLenum face, GLuint mask);
+  [[nodiscard]] bool stencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass);
+  [[nodiscard]] bool useProgram(GLuint program);
+  [[nodiscard]] bool viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+  /// @brief The indexed binding functions also change the generic binding point of `target`
+  void invalidateBuffer(GLenum target);
+
+  /// @brief Deleted objects are unbound by GL, and their names can be reused
+  void onBuffersDeleted(GLsizei n, const GLuint* buffers);
+  void onProgramDeleted(GLuint program);
+  void onTexturesDeleted(GLsizei n, const GLuint* textures);
+  void onVertexArraysDeleted(GLsizei n, const GLuint* vertexArrays);
+
+  /// @brief Forgets the entire state. Statistics are preserved
+  void invalidate();
+
+  [[nodiscard]] const Stats& getStats() const {
+    return stats_;
+  }
+  void resetStats() {
+    stats_ = {};
+  }
+
+ private:
+  template<typename T>
+  bool update(CallType type, std::optional<T>& cached, const T& value);
+  // updates the front and back face values of a glStencil*Separate() call
+  template<typename T>
+  bool updateFaces(CallType type, std::array<std::optional<T>, 2>& cached, GLenum face, const T& v);
+  void count(CallType type, bool issued);
+
+  enum class BufferTarget : uint8_t {
+    Array,
+    CopyRead,
+    CopyWrite,
+    DrawIndirect,
+    ElementArray,
+    PixelPack,
+    PixelUnpack,
+    ShaderStorage,
+    Uniform,
+    Count,
+  };
+  enum class TextureTarget : uint8_t {
+    Texture2D,
+    Texture2DArray,
+    Texture2DMultisample,
+    Texture2DMultisampleArray,
+    Texture3D,
+    TextureCubeMap,
+    TextureExternal,
+    TextureRectangle,
+    Count,
+  };
+  enum class Capability : uint8_t {
+    Blend,
+    CullFace,
+    DebugOutput,
+    DepthTest,
+    Dither,
+    FramebufferSRGB,
+    PolygonOffsetFill,
+    SampleAlphaToCoverage,
+    SampleCoverage,
+    ScissorTest,
+    StencilTest,
+    TextureCubeMapSeamless,
+    Count,
+  };
+
+  // return Count for untracked values
+  static BufferTarget toBufferTarget(GLenum target);
+  static TextureTarget toTextureTarget(GLenum target);
+  static Capability toCapability(GLenum cap);
+
+ private:
+  using Rect = std::array<GLint, 4>;
+  using StencilFunc = std::array<GLuint, 3>; // func, ref, mask
+  using StencilOp = std::array<GLenum, 3>; // fail, zfail, zpass
+
+  std::optional<GLenum> activeTexture_;
+  std::array<std::optional<GLuint>, static_cast<size_t>(BufferTarget::Count)> buffers_;
+  // indexed by texture unit and target
+  std::array<std::array<std::optional<GLuint>, static_cast<size_t>(TextureTarget::Count)>,
+             IGL_TEXTURE_SAMPLERS_MAX>
+      textures_;
+  std::optional<GLuint> vao_;
+  std::optional<std::array<GLfloat, 4>> blendColor_;
+  std::optional<std::array<GLenum, 2>> blendEquation_;
+  std::optional<std::array<GLenum, 4>> blendFunc_;
+  std::bitset<static_cast<size_t>(Capability::Count)> capabilitiesKnown_;
+  std::bitset<static_cast<size_t>(Capability::Count)> capabilitiesEnabled_;
+  std::optional<std::array<GLboolean, 4>> colorMask_;
+  std::optional<GLint> cullFace_;
+  std::optional<GLenum> depthFunc_;
+  std::optional<GLboolean> depthMask_;
+  std::optional<GLenum> frontFace_;
+  std::optional<Rect> scissor_;
+  std::array<std::optional<StencilFunc>, 2> stencilFunc_;
+  std::array<std::optional<GLuint>, 2> stencilMask_;
+  std::array<std::optional<StencilOp>, 2> stencilOp_;
+  std::optional<GLuint> program_;
+  std::optional<Rect> viewport_;
+
+  Stats stats_;
+};
+
+} // namespace igl::opengl
@@ -8,6 +8,7 @@
 #include <igl/opengl/TextureBuffer.h>
 
 #include <array>
+#include <cstring>
 #include <utility>
 
 namespace igl::opengl {
@@ -21,6 +22,10 @@ constexpr std::array<GLenum, 6> kCubeFaceTargets = {GL_TEXTURE_CUBE_MAP_POSITIVE
                                                     GL_TEXTURE_CUBE_MAP_NEGATIVE_Y,
                                                     GL_TEXTURE_CUBE_MAP_POSITIVE_Z,
                                                     GL_TEXTURE_CUBE_MAP_NEGATIVE_Z};
+
+// smaller uploads are not worth a fence
+constexpr size_t kMinStagedUploadSize = 64 * 1024;
+
 void swapTextureChannelsForFormat(IContext& context, GLuint target, TextureFormat iglFormat) {
   if (iglFormat == igl::TextureFormat::A_UNorm8 &&
       context.deviceFeatures().hasInternalRequirement(
@@ -429,6 +434,20 @@ Result TextureBuffer::uploadInternal(TextureType /*type*/,
   if (target == 0) {
     return Result{Result::Code::InvalidOperation, "Unknown texture type"};
   }
+  auto* ring = getContext().getPixelUnpackBufferRing();
+  if (ring) {
+    const size_t length =
+        getProperties().getBytesPerRange(range, static_cast<uint32_t>(bytesPerRow));
+    if (length >= kMinStagedUploadSize) {
+      // stage the pixels, so the driver does not copy them synchronously
+      const auto allocation = ring->allocate(getContext(), length);
+      if (allocation.isValid()) {
+        memcpy(allocation.data, data, length);
+        return uploadFromUnpackBuffer(range, allocation, bytesPerRow);
+      }
+    }
+  }
+
   getContext().bindTexture(target, getId());
 
   auto result = uploadInternal(target, range, data, bytesPerRow);
@@ -437,6 +456,35 @@ Result TextureBuffer::uploadInternal(TextureType /*type*/,
   return result;
 }
 
+Result TextureBuffer::uploadFromUnpackBuffer(const TextureRangeDesc& range,
+                                             const PixelUnpackBufferRing::Allocation& allocation,
+                                             size_t bytesPerRow) const {
+  auto* ring = getContext().getPixelUnpackBufferRing();
+  if (!IGL_DEBUG_VERIFY(ring && allocation.isValid())) {
+    return Result{Result::Code::InvalidOperation, "No pixel unpack buffer allocation"};
+  }
+  const auto target = getTarget();
+  if (target == 0) {
+    return Result{Result::Code::InvalidOperation, "Unknown texture type"};
+  }
+  IGL_DEBUG_ASSERT(!needsRepacking(range, bytesPerRow));
+  IGL_DEBUG_ASSERT(getProperties().getBytesPerRange(range, static_cast<uint32_t>(bytesPerRow)) <=
+                   allocation.length);
+
+  getContext().bindTexture(target, getId());
+  ring->bind(getContext(), allocation);
+
+  // with a bound GL_PIXEL_UNPACK_BUFFER, the pixel pointers are offsets into the buffer
+  auto result = uploadInternal(target,
+                               range,
+                               reinterpret_cast<const void*>(allocation.offset), // NOLINT
+                               bytesPerRow);
+
+  ring->unbind(getContext(), allocation);
+  getContext().bindTexture(target, 0);
+  return result;
+}
+
 Result TextureBuffer::uploadInternal(GLenum target,
                                      const TextureRangeDesc& range,
                                      const void* IGL_NULLABLE data,
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <igl/opengl/PixelUnpackBufferRing.h>
 #include <igl/opengl/TextureBufferBase.h>
 
 namespace igl::opengl {
@@ -24,6 +25,13 @@ class TextureBuffer : public TextureBufferBase {
   void bindImage(size_t unit) override;
   uint64_t getTextureId() const override;
 
+  // Uploads pixels which were written to an allocation of the pixel unpack buffer ring of the
+  // context (see IContext::setPixelUnpackBufferRingEnabled()), e.g. on another thread. The
+  // allocation is reused after the GPU consumed it.
+  Result uploadFromUnpackBuffer(const TextureRangeDesc& range,
+                                const PixelUnpackBufferRing::Allocation& allocation,
+                                size_t bytesPerRow = 0) const;
+
  protected:
   Result initialize(const std::string& debugName) const;
   Result initializeWithUpload() const;
@@ -5,12 +5,33 @@
  * LICENSE file in the root directory of this source tree.
  */
 
-#include <igl/opengl/Buffer.h>
 #include <igl/opengl/UniformAdapter.h>
+
+#include <algorithm>
+#include <cstring>
+#include <igl/opengl/Buffer.h>
+#include <igl/opengl/IContext.h>
 #include <igl/opengl/UniformBuffer.h>
 
 namespace igl::opengl {
 
+namespace {
+
+size_t getNumColumns(UniformType type) {
+  switch (type) {
+  case UniformType::Mat2x2:
+    return 2;
+  case UniformType::Mat3x3:
+    return 3;
+  case UniformType::Mat4x4:
+    return 4;
+  default:
+    return 1;
+  }
+}
+
+} // namespace
+
 UniformAdapter::UniformAdapter(const IContext& context, PipelineType type) : pipelineType_(type) {
   // NOTE: 32 "feels" right and yielded good results in MobileLab. Goal here is to minimize
   // number of resize's in the vector but not be unreasonably large.
@@ -50,6 +71,7 @@ void UniformAdapter::clearUniformBuffers() {
   usedUniformDataBytes_ = 0;
   uniforms_.clear();
   uniformBuffersDirtyMask_ = 0;
+  streamingUniformBuffersMask_ = 0;
 
 #if IGL_DEBUG
   std::fill(uniformsDirty_.begin(), uniformsDirty_.end(), false);
@@ -62,6 +84,14 @@ void UniformAdapter::setUniform(const UniformDesc& uniformDesc,
   auto location = uniformDesc.location;
   IGL_DEBUG_ASSERT(location >= 0, "Invalid uniformDesc->location passed to setUniform");
 
+  if (batchLayout_ && data) {
+    if (const auto* member = batchLayout_->getMember(location)) {
+      setBatchedUniform(*member, uniformDesc, data);
+      Result::setOk(outResult);
+      return;
+    }
+  }
+
   // Early out if any of the parameters are invalid.
   if (location < 0 || location >= maxUniforms_ || !data) {
     Result::setResult(outResult, Result::Code::ArgumentInvalid);
@@ -126,6 +156,43 @@ void UniformAdapter::setUniform(const UniformDesc& uniformDesc,
   Result::setOk(outResult);
 }
 
+void UniformAdapter::setBatchedUniform(const UniformBatchBuffer::Layout::Member& member,
+                                       const UniformDesc& uniformDesc,
+                                       const void* data) {
+  // std140 puts every array element and matrix column at its own stride, booleans take 4 bytes
+  const size_t typeSize = igl::sizeForUniformType(uniformDesc.type);
+  const size_t numColumns = getNumColumns(uniformDesc.type);
+  const size_t columnSize = typeSize / numColumns;
+  const size_t srcStride = uniformDesc.elementStride != 0 ? uniformDesc.elementStride : typeSize;
+  const size_t numElements = std::min(uniformDesc.numElements, static_cast<size_t>(member.size));
+  const auto* src = static_cast<const uint8_t*>(data) + uniformDesc.offset;
+  auto& block = batch_->data;
+
+  for (size_t element = 0; element != numElements; element++) {
+    for (size_t column = 0; column != numColumns; column++) {
+      const size_t dstOffset = member.offset + element * member.arrayStride +
+                               column * member.matrixStride;
+      const uint8_t* value = src + element * srcStride + column * columnSize;
+      if (uniformDesc.type == UniformType::Boolean) {
+        const uint32_t boolValue = *value != 0 ? 1 : 0;
+        if (IGL_DEBUG_VERIFY(dstOffset + sizeof(boolValue) <= block.size())) {
+          memcpy(block.data() + dstOffset, &boolValue, sizeof(boolValue));
+        }
+      } else if (IGL_DEBUG_VERIFY(dstOffset + columnSize <= block.size())) {
+        memcpy(block.data() + dstOffset, value, columnSize);
+      }
+    }
+  }
+  batch_->dirty = true;
+}
+
+void UniformAdapter::setUniformBatch(const UniformBatchBuffer::Layout* layout,
+                                     UniformBatchBuffer::Batch* batch) {
+  IGL_DEBUG_ASSERT((layout == nullptr) == (batch == nullptr));
+  batchLayout_ = layout;
+  batch_ = batch;
+}
+
 void UniformAdapter::setUniformBuffer(IBuffer* buffer,
                                       size_t offset,
                                       size_t size,
@@ -139,6 +206,13 @@ void UniformAdapter::setUniformBuffer(IBuffer* buffer,
   if (bindingIndex < IGL_UNIFORM_BLOCKS_BINDING_MAX && buffer) {
     uniformBufferBindingMap_[bindingIndex] = {buffer, offset, size};
     uniformBuffersDirtyMask_ |= 1 << bindingIndex;
+    const auto* glBuffer = static_cast<Buffer*>(buffer);
+    if (glBuffer->getType() == Buffer::Type::UniformBlock &&
+        static_cast<const UniformBlockBuffer*>(glBuffer)->isStreaming()) {
+      streamingUniformBuffersMask_ |= 1 << bindingIndex;
+    } else {
+      streamingUniformBuffersMask_ &= ~(1 << bindingIndex);
+    }
     Result::setOk(outResult);
   } else {
     Result::setResult(outResult, Result::Code::ArgumentInvalid);
@@ -172,6 +246,7 @@ void UniformAdapter::bindToPipeline(IContext& context) {
 #endif
 
   // bind uniform block buffers
+  uniformBuffersDirtyMask_ |= streamingUniformBuffersMask_;
   for (size_t bindingIndex = 0; bindingIndex < IGL_UNIFORM_BLOCKS_BINDING_MAX; ++bindingIndex) {
     if (uniformBuffersDirtyMask_ & (1 << bindingIndex)) {
       auto uniformBinding = uniformBufferBindingMap_.at(bindingIndex);
@@ -190,6 +265,11 @@ void UniformAdapter::bindToPipeline(IContext& context) {
     }
   }
   uniformBuffersDirtyMask_ = 0;
+
+  // one range of the ring replaces the glUniform*() calls of all batched uniforms
+  if (batch_) {
+    context.getUniformBatchBuffer().bind(context, *batch_);
+  }
 }
 
 } // namespace igl::opengl
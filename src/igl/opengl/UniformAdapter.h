@@ -9,6 +9,7 @@
 
 #include <igl/Buffer.h>
 #include <igl/Uniform.h>
+#include <igl/opengl/UniformBatchBuffer.h>
 
 #include <array>
 #include <unordered_map>
@@ -39,6 +40,11 @@ class UniformAdapter {
     return maxUniforms_;
   }
 
+  /// @brief Sets the batched uniform block of the current program. Uniforms at the locations of
+  /// its members are packed into `batch` instead of being set with glUniform*().
+  void setUniformBatch(const UniformBatchBuffer::Layout* IGL_NULLABLE layout,
+                       UniformBatchBuffer::Batch* IGL_NULLABLE batch);
+
   void bindToPipeline(IContext& context);
 
  private:
@@ -50,6 +56,10 @@ class UniformAdapter {
     std::ptrdiff_t dataOffset = 0;
   };
 
+  void setBatchedUniform(const UniformBatchBuffer::Layout::Member& member,
+                         const UniformDesc& uniformDesc,
+                         const void* data);
+
   std::vector<UniformState> uniforms_;
   std::vector<uint8_t> uniformData_;
   uint32_t maxUniforms_ = 1024;
@@ -66,6 +76,12 @@ class UniformAdapter {
   uint32_t uniformBuffersDirtyMask_ = 0;
   static_assert(sizeof(uniformBuffersDirtyMask_) * 8 >= IGL_UNIFORM_BLOCKS_BINDING_MAX,
                 "uniformBuffersDirtyMask size is not enough to fit the flags");
+  // streaming buffers are bound for every draw, since their slot changes after each upload
+  uint32_t streamingUniformBuffersMask_ = 0;
+
+  // only set while the current program has a batched uniform block
+  const UniformBatchBuffer::Layout* IGL_NULLABLE batchLayout_ = nullptr;
+  UniformBatchBuffer::Batch* IGL_NULLABLE batch_ = nullptr;
 
   // Store a copy of uniform data when setUniform is used to avoid the client from managing the
   // memory
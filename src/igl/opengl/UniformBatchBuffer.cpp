@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/UniformBatchBuffer.h>
+
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+bool UniformBatchBuffer::create(IContext& context) {
+  context.deviceFeatures().getFeatureLimits(DeviceFeatureLimits::BufferAlignment, alignment_);
+  IGL_DEBUG_ASSERT(alignment_ != 0 && (alignment_ & (alignment_ - 1)) == 0);
+
+  context.genBuffers(1, &buffer_);
+  if (buffer_ == 0) {
+    IGL_LOG_ERROR("Failed to create the uniform batch buffer\n");
+    return false;
+  }
+  context.bindBuffer(GL_UNIFORM_BUFFER, buffer_);
+  context.bufferData(
+      GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(capacity_), nullptr, GL_STREAM_DRAW);
+  head_ = 0;
+  return true;
+}
+
+void UniformBatchBuffer::bind(IContext& context, Batch& batch) {
+  const size_t length = batch.data.size();
+  if (length == 0) {
+    return;
+  }
+  if (!IGL_DEBUG_VERIFY(length <= capacity_)) {
+    IGL_LOG_ERROR_ONCE("The batched uniforms do not fit into the uniform batch buffer\n");
+    return;
+  }
+  if (buffer_ == 0 && !create(context)) {
+    return;
+  }
+
+  if (batch.dirty || batch.generation != generation_) {
+    size_t begin = (head_ + alignment_ - 1) & ~(alignment_ - 1);
+    context.bindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    if (begin + length > capacity_) {
+      // the driver keeps the old storage until the draws which read it are done
+      context.bufferData(
+          GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>(capacity_), nullptr, GL_STREAM_DRAW);
+      generation_++;
+      stats_.orphans++;
+      begin = 0;
+    }
+    context.bufferSubData(GL_UNIFORM_BUFFER,
+                          static_cast<GLintptr>(begin),
+                          static_cast<GLsizeiptr>(length),
+                          batch.data.data());
+    head_ = begin + length;
+    batch.offset = static_cast<GLintptr>(begin);
+    batch.generation = generation_;
+    batch.dirty = false;
+    stats_.uploads++;
+    stats_.bytes += length;
+  }
+
+  context.bindBufferRange(
+      GL_UNIFORM_BUFFER, kBindingIndex, buffer_, batch.offset, static_cast<GLsizeiptr>(length));
+  stats_.binds++;
+}
+
+void UniformBatchBuffer::clear(IContext& context) {
+  if (buffer_ != 0) {
+    context.deleteBuffers(1, &buffer_);
+    buffer_ = 0;
+  }
+  head_ = 0;
+  // batches which were uploaded to the deleted buffer must be uploaded again
+  generation_++;
+}
+
+} // namespace igl::opengl
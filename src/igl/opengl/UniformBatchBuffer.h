@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <igl/Common.h>
+#include <igl/Macros.h>
+#include <igl/opengl/GLIncludes.h>
+
+namespace igl::opengl {
+
+class IContext;
+
+/**
+ * @brief A ring of GL_UNIFORM_BUFFER memory for batched loose uniforms.
+ *
+ * Programs which declare a std140 uniform block named kBlockName receive the bindUniform() values
+ * of its members in that block instead of glUniform*() calls. RenderPipelineReflection exposes the
+ * members like loose uniforms, so clients look them up by name as usual. The values of a program
+ * are packed into a Batch on the CPU, and the ring uploads each changed batch once with
+ * glBufferSubData() and binds it with a single glBindBufferRange() per draw.
+ *
+ * Contexts without uniform blocks (e.g. OpenGL ES 2.0) use loose uniforms with the same names, e.g.
+ * by declaring the block only if __VERSION__ >= 300:
+ *
+ *   layout(std140) uniform IGLBatchedUniforms {
+ *     vec4 color;
+ *     mat4 mvp;
+ *   };
+ *
+ * When the ring is full its storage is orphaned with glBufferData(), so the driver keeps the old
+ * storage alive for draws in flight. Batches which were uploaded before are uploaded again.
+ *
+ * The ring is owned by IContext (see IContext::getUniformBatchBuffer()) and all methods must be
+ * called with the context current.
+ */
+class UniformBatchBuffer final {
+ public:
+  // the locations of the members of the batched uniform block of a program
+  struct Layout {
+    struct Member {
+      GLint offset = 0;
+      GLint arrayStride = 0;
+      GLint matrixStride = 0;
+      // the number of array elements
+      GLsizei size = 1;
+    };
+
+    GLint blockIndex = -1;
+    GLint size = 0;
+    // the uniform location of members[0], the other members have the following locations
+    GLint firstLocation = 0;
+    std::vector<Member> members;
+
+    [[nodiscard]] const Member* IGL_NULLABLE getMember(GLint location) const {
+      const GLint index = location - firstLocation;
+      return index >= 0 && index < static_cast<GLint>(members.size()) ? &members[index] : nullptr;
+    }
+  };
+
+  // the packed std140 values of one program
+  struct Batch {
+    std::vector<uint8_t> data;
+    // true if `data` changed since it was uploaded
+    bool dirty = true;
+    GLintptr offset = 0;
+    // the storage which `offset` refers to, see UniformBatchBuffer::generation_
+    uint64_t generation = 0;
+  };
+
+  struct Stats {
+    uint64_t uploads = 0;
+    uint64_t bytes = 0;
+    uint64_t binds = 0;
+    // uploads which did not fit and orphaned the storage
+    uint64_t orphans = 0;
+  };
+
+  static constexpr const char* kBlockName = "IGLBatchedUniforms";
+  static constexpr size_t kDefaultCapacity = 1024 * 1024;
+  // above the binding points which are available to IGL clients
+  static constexpr GLuint kBindingIndex = IGL_UNIFORM_BLOCKS_BINDING_MAX;
+
+  explicit UniformBatchBuffer(size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+
+  /// @brief Uploads the batch if it changed and binds it to kBindingIndex
+  void bind(IContext& context, Batch& batch);
+
+  /// @brief Deletes the buffer
+  void clear(IContext& context);
+
+  [[nodiscard]] size_t getCapacity() const {
+    return capacity_;
+  }
+  [[nodiscard]] const Stats& getStats() const {
+    return stats_;
+  }
+  void resetStats() {
+    stats_ = {};
+  }
+
+ private:
+  [[nodiscard]] bool create(IContext& context);
+
+  size_t capacity_;
+  GLuint buffer_ = 0;
+  size_t alignment_ = 256;
+  size_t head_ = 0;
+  // incremented whenever the storage is orphaned, which invalidates the offsets of all batches
+  uint64_t generation_ = 1;
+  Stats stats_;
+};
+
+} // namespace igl::opengl
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/VertexArrayObjectCache.h>
+
+#include <algorithm>
+#include <functional>
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+namespace {
+
+template<typename T>
+void hashCombine(size_t& seed, const T& value) {
+  seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+bool contains(GLsizei n, const GLuint* names, GLuint name) {
+  return name != 0 && std::find(names, names + n, name) != names + n;
+}
+
+void deleteVertexArrays(IContext& context, std::vector<GLuint>& vertexArrays) {
+  if (!vertexArrays.empty()) {
+    context.deleteVertexArrays(static_cast<GLsizei>(vertexArrays.size()), vertexArrays.data());
+    vertexArrays.clear();
+  }
+}
+
+} // namespace
+
+bool VertexArrayObjectCache::Attribute::operator==(const Attribute& other) const {
+  return location == other.location && buffer == other.buffer &&
+         numComponents == other.numComponents && componentType == other.componentType &&
+         normalized == other.normalized && stride == other.stride && offset == other.offset &&
+         divisor == other.divisor;
+}
+
+bool VertexArrayObjectCache::Key::operator==(const Key& other) const {
+  return indexBuffer == other.indexBuffer && attributes == other.attributes;
+}
+
+size_t VertexArrayObjectCache::KeyHasher::operator()(const Key& key) const {
+  size_t hash = std::hash<GLuint>()(key.indexBuffer);
+  for (const Attribute& attribute : key.attributes) {
+    hashCombine(hash, attribute.location);
+    hashCombine(hash, attribute.buffer);
+    hashCombine(hash, attribute.numComponents);
+    hashCombine(hash, attribute.componentType);
+    hashCombine(hash, attribute.normalized);
+    hashCombine(hash, attribute.stride);
+    hashCombine(hash, attribute.offset);
+    hashCombine(hash, attribute.divisor);
+  }
+  return hash;
+}
+
+GLuint VertexArrayObjectCache::create(IContext& context, const Key& key) {
+  GLuint vao = 0;
+  context.genVertexArrays(1, &vao);
+  if (vao == 0) {
+    IGL_LOG_ERROR("Failed to create vertex array object ID\n");
+    return 0;
+  }
+  context.bindVertexArray(vao);
+
+  const bool hasDivisor =
+      context.deviceFeatures().hasInternalFeature(InternalFeatures::VertexAttribDivisor);
+
+  for (const Attribute& attribute : key.attributes) {
+    // GL_ARRAY_BUFFER is not part of the vertex array state, the attribute pointer captures it
+    context.bindBuffer(GL_ARRAY_BUFFER, attribute.buffer);
+    context.enableVertexAttribArray(attribute.location);
+    context.vertexAttribPointer(
+        attribute.location,
+        attribute.numComponents,
+        attribute.componentType,
+        attribute.normalized,
+        attribute.stride,
+        reinterpret_cast<const GLvoid*>(attribute.offset)); // NOLINT(performance-no-int-to-ptr)
+    if (hasDivisor) {
+      context.vertexAttribDivisor(attribute.location, attribute.divisor);
+    }
+  }
+  if (key.indexBuffer) {
+    context.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, key.indexBuffer);
+  }
+  return vao;
+}
+
+void VertexArrayObjectCache::bind(IContext& context, const Key& key) {
+  auto it = vertexArrays_.find(key);
+  if (it != vertexArrays_.end()) {
+    stats_.hits++;
+    context.bindVertexArray(it->second);
+  } else {
+    stats_.misses++;
+    if (vertexArrays_.size() >= capacity_) {
+      // the working set does not fit, start over instead of tracking the usage of every entry
+      stats_.evictions += vertexArrays_.size();
+      clear(context);
+    }
+    const GLuint vao = create(context, key);
+    if (vao == 0) {
+      return;
+    }
+    it = vertexArrays_.emplace(key, vao).first;
+  }
+  boundVertexArray_ = it->second;
+  boundIndexBuffer_ = key.indexBuffer;
+
+  if (!detached_.empty()) {
+    deleteVertexArrays(context, detached_);
+  }
+}
+
+void VertexArrayObjectCache::onVertexArrayBound(GLuint /*vao*/) {
+  // bind() sets it again after the call
+  boundVertexArray_ = 0;
+}
+
+void VertexArrayObjectCache::onElementArrayBufferBound(GLuint buffer) {
+  if (boundVertexArray_ == 0 || buffer == boundIndexBuffer_) {
+    return;
+  }
+  for (auto it = vertexArrays_.begin(); it != vertexArrays_.end(); ++it) {
+    if (it->second == boundVertexArray_) {
+      // it cannot be deleted while it is bound
+      detached_.push_back(it->second);
+      vertexArrays_.erase(it);
+      stats_.evictions++;
+      break;
+    }
+  }
+  boundVertexArray_ = 0;
+}
+
+void VertexArrayObjectCache::onBuffersDeleted(IContext& context, GLsizei n, const GLuint* buffers) {
+  if (n <= 0 || buffers == nullptr) {
+    return;
+  }
+  std::vector<GLuint> evicted;
+  for (auto it = vertexArrays_.begin(); it != vertexArrays_.end();) {
+    const Key& key = it->first;
+    const bool usesBuffer = contains(n, buffers, key.indexBuffer) ||
+                            std::any_of(key.attributes.begin(),
+                                        key.attributes.end(),
+                                        [n, buffers](const Attribute& attribute) {
+                                          return contains(n, buffers, attribute.buffer);
+                                        });
+    if (usesBuffer) {
+      if (it->second == boundVertexArray_) {
+        // deleting the bound vertex array object unbinds it
+        boundVertexArray_ = 0;
+      }
+      evicted.push_back(it->second);
+      it = vertexArrays_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  if (!evicted.empty()) {
+    stats_.evictions += evicted.size();
+    deleteVertexArrays(context, evicted);
+  }
+}
+
+void VertexArrayObjectCache::clear(IContext& context) {
+  std::vector<GLuint> vertexArrays;
+  vertexArrays.reserve(vertexArrays_.size() + detached_.size());
+  for (const auto& it : vertexArrays_) {
+    vertexArrays.push_back(it.second);
+  }
+  vertexArrays_.clear();
+  vertexArrays.insert(vertexArrays.end(), detached_.begin(), detached_.end());
+  detached_.clear();
+  boundVertexArray_ = 0;
+  deleteVertexArrays(context, vertexArrays);
+}
+
+} // namespace igl::opengl
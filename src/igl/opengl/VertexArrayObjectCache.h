@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <igl/opengl/GLIncludes.h>
+
+namespace igl::opengl {
+
+class IContext;
+
+/**
+ * @brief A cache of prebuilt vertex array objects, keyed by the complete vertex array state: the
+ * attribute locations and formats, the vertex buffers with their offsets and the index buffer.
+ * A cache hit costs a single glBindVertexArray() instead of a glVertexAttribPointer() and
+ * glEnableVertexAttribArray() per attribute.
+ *
+ * The cache is owned by IContext (see IContext::setVertexArrayObjectCacheEnabled()). Vertex array
+ * objects which reference a buffer are deleted together with the buffer, so a reused buffer name
+ * never hits a stale entry.
+ */
+class VertexArrayObjectCache final {
+ public:
+  struct Attribute {
+    GLuint location = 0;
+    GLuint buffer = 0;
+    GLint numComponents = 0;
+    GLenum componentType = GL_FLOAT;
+    GLboolean normalized = GL_FALSE;
+    GLsizei stride = 0;
+    uintptr_t offset = 0;
+    GLuint divisor = 0;
+
+    bool operator==(const Attribute& other) const;
+  };
+
+  struct Key {
+    std::vector<Attribute> attributes;
+    GLuint indexBuffer = 0;
+
+    bool operator==(const Key& other) const;
+    void clear() {
+      attributes.clear();
+      indexBuffer = 0;
+    }
+  };
+
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+  };
+
+  static constexpr size_t kDefaultCapacity = 1024;
+
+  explicit VertexArrayObjectCache(size_t capacity = kDefaultCapacity) : capacity_(capacity) {}
+
+  /// @brief Binds a vertex array object with the state described by `key`. It is created on a miss.
+  void bind(IContext& context, const Key& key);
+
+  /// @brief Called by IContext whenever a vertex array object is bound
+  void onVertexArrayBound(GLuint vao);
+  /// @brief Called by IContext whenever a buffer is bound to GL_ELEMENT_ARRAY_BUFFER. Binding a
+  /// different index buffer changes the currently bound vertex array object, which cannot be
+  /// reused anymore.
+  void onElementArrayBufferBound(GLuint buffer);
+  /// @brief Called by IContext after glDeleteBuffers(). Evicts every entry using these buffers.
+  void onBuffersDeleted(IContext& context, GLsizei n, const GLuint* buffers);
+
+  /// @brief Deletes all vertex array objects. The context has to be current.
+  void clear(IContext& context);
+
+  [[nodiscard]] size_t size() const {
+    return vertexArrays_.size();
+  }
+  [[nodiscard]] const Stats& getStats() const {
+    return stats_;
+  }
+  void resetStats() {
+    stats_ = {};
+  }
+
+ private:
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  [[nodiscard]] static GLuint create(IContext& context, const Key& key);
+
+  std::unordered_map<Key, GLuint, KeyHasher> vertexArrays_;
+  // the cached vertex array object which is currently bound, or 0
+  GLuint boundVertexArray_ = 0;
+  GLuint boundIndexBuffer_ = 0;
+  // vertex array objects which were removed from the cache while they were bound
+  std::vector<GLuint> detached_;
+  size_t capacity_;
+  Stats stats_;
+};
+
+} // namespace igl::opengl
@@ -15,6 +15,7 @@
 #include <igl/opengl/PlatformDevice.h>
 #endif // #IGL_BACKEND_OPENGL
 #include <string>
+#include <vector>
 #include <igl/CommandBuffer.h>
 #include <igl/RenderPass.h>
 #include <igl/RenderPipelineState.h>
@@ -719,4 +720,76 @@ TEST_F(FramebufferTest, GetColorAttachmentTest) {
   }
 }
 
+
+//
+// Framebuffer Async Readback Test
+//
+// Asynchronous readbacks return the same pixels as copyBytesColorAttachment() on every backend,
+// whether the backend implements them or falls back to a synchronous copy.
+//
+TEST_F(FramebufferTest, RequestBytesColorAttachment) {
+  constexpr uint32_t kWidth = 16;
+  constexpr uint32_t kHeight = 8;
+  const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                 kWidth,
+                                                 kHeight,
+                                                 TextureDesc::TextureUsageBits::Sampled |
+                                                     TextureDesc::TextureUsageBits::Attachment);
+  Result ret;
+  auto texture = iglDev_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(texture != nullptr);
+
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = texture;
+  auto framebuffer = iglDev_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(framebuffer != nullptr);
+
+  const auto range = TextureRangeDesc::new2D(0, 0, kWidth, kHeight);
+  std::vector<uint32_t> pixels(size_t(kWidth) * kHeight);
+  for (size_t i = 0; i != pixels.size(); i++) {
+    pixels[i] = static_cast<uint32_t>(i * 2654435761u) | 0xff000000u;
+  }
+  ret = texture->upload(range, pixels.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  std::vector<uint32_t> expected(pixels.size());
+  framebuffer->copyBytesColorAttachment(*cmdQueue_, 0, expected.data(), range);
+
+  auto readback = framebuffer->requestBytesColorAttachment(*cmdQueue_, 0, range, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(readback != nullptr);
+
+  // later writes to the attachment do not change a requested readback
+  const std::vector<uint32_t> black(pixels.size(), 0xff000000u);
+  ret = texture->upload(range, black.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  std::vector<uint32_t> actual(pixels.size());
+  ret = readback->copyBytes(actual.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  EXPECT_TRUE(readback->isReady());
+  EXPECT_EQ(actual, expected);
+
+  // rows with padding
+  constexpr size_t kPaddedRowLength = kWidth + 4;
+  std::vector<uint32_t> padded(kPaddedRowLength * kHeight, 0xcdcdcdcdu);
+  ret = readback->copyBytes(padded.data(), kPaddedRowLength * sizeof(uint32_t));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  for (size_t row = 0; row != kHeight; row++) {
+    for (size_t x = 0; x != kWidth; x++) {
+      ASSERT_EQ(padded[row * kPaddedRowLength + x], expected[row * kWidth + x]);
+    }
+    ASSERT_EQ(padded[row * kPaddedRowLength + kWidth], 0xcdcdcdcdu)
+        << "Padding of row " << row << " was overwritten";
+  }
+  ret = readback->copyBytes(padded.data(), kWidth * sizeof(uint32_t) - 4);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentOutOfRange);
+
+  auto invalid = framebuffer->requestBytesColorAttachment(*cmdQueue_, 1, range, &ret);
+  EXPECT_EQ(invalid, nullptr);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentInvalid);
+}
+
 } // namespace igl::tests
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <igl/PixelConversion.h>
+
+namespace igl::tests {
+
+namespace {
+
+float halfToFloatReference(uint16_t half) {
+  const int exponent = (half >> 10) & 0x1f;
+  const int mantissa = half & 0x3ff;
+  float value = 0.0f;
+  if (exponent == 0) {
+    value = std::ldexp(static_cast<float>(mantissa), -24);
+  } else if (exponent == 0x1f) {
+    value = mantissa ? NAN : INFINITY;
+  } else {
+    value = std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+  }
+  return (half & 0x8000) ? -value : value;
+}
+
+bool isHalfNan(uint16_t half) {
+  return (half & 0x7c00) == 0x7c00 && (half & 0x3ff) != 0;
+}
+
+// Repacks and flips 4-byte pixels one at a time, the baseline of the benchmark
+void copyRowsPerPixel(const uint8_t* src,
+                      size_t srcBytesPerRow,
+                      uint8_t* dst,
+                      size_t dstBytesPerRow,
+                      size_t width,
+                      size_t height) {
+  for (size_t y = 0; y < height; ++y) {
+    for (size_t x = 0; x < width; ++x) {
+      std::memcpy(
+          dst + (height - y - 1) * dstBytesPerRow + x * 4, src + y * srcBytesPerRow + x * 4, 4);
+    }
+  }
+}
+
+} // namespace
+
+TEST(PixelConversionTest, HalfToFloat) {
+  std::vector<uint16_t> halves(0x10000);
+  for (size_t i = 0; i < halves.size(); ++i) {
+    halves[i] = static_cast<uint16_t>(i);
+  }
+  std::vector<float> floats(halves.size());
+  convertPixels(reinterpret_cast<const uint8_t*>(halves.data()),
+                reinterpret_cast<uint8_t*>(floats.data()),
+                halves.size() * sizeof(uint16_t),
+                PixelConversion::HalfToFloat);
+
+  for (size_t i = 0; i < halves.size(); ++i) {
+    const float expected = halfToFloatReference(halves[i]);
+    if (std::isnan(expected)) {
+      EXPECT_TRUE(std::isnan(floats[i])) << i;
+    } else {
+      EXPECT_EQ(floats[i], expected) << i;
+      EXPECT_EQ(std::signbit(floats[i]), std::signbit(expected)) << i;
+    }
+  }
+}
+
+TEST(PixelConversionTest, FloatToHalf) {
+  // Every half survives a round trip
+  std::vector<float> floats;
+  std::vector<uint16_t> expected;
+  for (uint32_t i = 0; i < 0x10000; ++i) {
+    floats.push_back(halfToFloatReference(static_cast<uint16_t>(i)));
+    expected.push_back(static_cast<uint16_t>(i));
+  }
+  const size_t numRoundTrips = floats.size();
+
+  // Ties round to even, values between halves round to the nearest one
+  const float kOne = 1.0f;
+  const float kUlp = std::ldexp(1.0f, -10);
+  floats.insert(floats.end(),
+                {
+                    kOne + kUlp * 0.5f, // tie, rounds down to even
+                    kOne + kUlp * 1.5f, // tie, rounds up to even
+                    kOne + kUlp * 0.75f,
+                    -(kOne + kUlp * 0.25f),
+                    65519.0f, // largest finite half after rounding
+                    65520.0f, // overflows
+                    1.0e10f,
+                    std::ldexp(1.0f, -25), // tie between 0 and the smallest denormal
+                    std::ldexp(1.5f, -25),
+                    std::ldexp(1.0f, -30),
+                });
+  expected.insert(expected.end(),
+                  {0x3c00, 0x3c02, 0x3c01, 0xbc00, 0x7bff, 0x7c00, 0x7c00, 0x0000, 0x0001, 0x0000});
+
+  std::vector<uint16_t> halves(floats.size());
+  convertPixels(reinterpret_cast<const uint8_t*>(floats.data()),
+                reinterpret_cast<uint8_t*>(halves.data()),
+                floats.size() * sizeof(float),
+                PixelConversion::FloatToHalf);
+
+  for (size_t i = 0; i < halves.size(); ++i) {
+    if (i < numRoundTrips && isHalfNan(expected[i])) {
+      EXPECT_TRUE(isHalfNan(halves[i])) << i;
+    } else {
+      EXPECT_EQ(halves[i], expected[i]) << i;
+    }
+  }
+}
+
+TEST(PixelConversionTest, SwapRedBlue8) {
+  // Not a multiple of the vector widths, the tail is converted too
+  const size_t numPixels = 37;
+  std::vector<uint8_t> pixels(numPixels * 4);
+  for (size_t i = 0; i < pixels.size(); ++i) {
+    pixels[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  std::vector<uint8_t> swapped(pixels.size());
+  convertPixels(pixels.data(), swapped.data(), pixels.size(), PixelConversion::SwapRedBlue8);
+  for (size_t i = 0; i < numPixels; ++i) {
+    EXPECT_EQ(swapped[i * 4 + 0], pixels[i * 4 + 2]);
+    EXPECT_EQ(swapped[i * 4 + 1], pixels[i * 4 + 1]);
+    EXPECT_EQ(swapped[i * 4 + 2], pixels[i * 4 + 0]);
+    EXPECT_EQ(swapped[i * 4 + 3], pixels[i * 4 + 3]);
+  }
+
+  // In place
+  convertPixels(swapped.data(), swapped.data(), swapped.size(), PixelConversion::SwapRedBlue8);
+  EXPECT_EQ(swapped, pixels);
+}
+
+TEST(PixelConversionTest, CopyPixelRows) {
+  const size_t width = 5;
+  const size_t height = 3;
+  const size_t srcBytesPerRow = width * 2 + 6;
+  const size_t dstBytesPerRow = width * 4 + 4;
+  const uint8_t kPadding = 0xee;
+
+  std::vector<uint16_t> halves(srcBytesPerRow / 2 * height);
+  for (size_t i = 0; i < halves.size(); ++i) {
+    halves[i] = static_cast<uint16_t>(0x3c00 + i);
+  }
+
+  for (bool flipVertical : {false, true}) {
+    std::vector<uint8_t> dst(dstBytesPerRow * height, kPadding);
+    copyPixelRows(reinterpret_cast<const uint8_t*>(halves.data()),
+                  srcBytesPerRow,
+                  dst.data(),
+                  dstBytesPerRow,
+                  width * 2,
+                  height,
+                  PixelConversion::HalfToFloat,
+                  flipVertical);
+
+    for (size_t y = 0; y < height; ++y) {
+      const size_t dstY = flipVertical ? height - y - 1 : y;
+      const uint8_t* dstRow = dst.data() + dstY * dstBytesPerRow;
+      for (size_t x = 0; x < width; ++x) {
+        float value = 0.0f;
+        std::memcpy(&value, dstRow + x * 4, sizeof(value));
+        EXPECT_EQ(value, halfToFloatReference(halves[y * srcBytesPerRow / 2 + x]));
+      }
+      // Padding is untouched
+      for (size_t i = width * 4; i < dstBytesPerRow; ++i) {
+        EXPECT_EQ(dstRow[i], kPadding);
+      }
+    }
+  }
+}
+
+//
+// Measures repacking with a flip and the conversions over common texture sizes
+//
+TEST(PixelConversionTest, Benchmark) {
+  using Clock = std::chrono::steady_clock;
+  using Seconds = std::chrono::duration<double>;
+  constexpr size_t kNumIterations = 4;
+
+  for (size_t size : {256u, 1024u, 2048u, 4096u}) {
+    const size_t rowBytes = size * 4;
+    // Padded rows, as in staging buffers with a row pitch alignment
+    const size_t paddedBytesPerRow = rowBytes + 256;
+    std::vector<uint8_t> src(paddedBytesPerRow * size, 0x3c);
+    std::vector<uint8_t> dst(rowBytes * size * 2);
+
+    const auto measure = [&](auto&& function) {
+      const auto start = Clock::now();
+      for (size_t i = 0; i < kNumIterations; ++i) {
+        function();
+      }
+      const double seconds = Seconds(Clock::now() - start).count() / kNumIterations;
+      // Megabytes of RGBA8 pixels per second
+      return static_cast<double>(rowBytes * size) / 1e6 / seconds;
+    };
+
+    const double perPixel = measure([&]() {
+      copyRowsPerPixel(src.data(), paddedBytesPerRow, dst.data(), rowBytes, size, size);
+    });
+    const double repackFlip = measure([&]() {
+      copyPixelRows(src.data(),
+                    paddedBytesPerRow,
+                    dst.data(),
+                    rowBytes,
+                    rowBytes,
+                    size,
+                    PixelConversion::None,
+                    true);
+    });
+    const double swapRedBlue = measure([&]() {
+      copyPixelRows(src.data(),
+                    paddedBytesPerRow,
+                    dst.data(),
+                    rowBytes,
+                    rowBytes,
+                    size,
+                    PixelConversion::SwapRedBlue8,
+                    true);
+    });
+    const double halfToFloat = measure([&]() {
+      convertPixels(src.data(), dst.data(), rowBytes * size, PixelConversion::HalfToFloat);
+    });
+    const double floatToHalf = measure([&]() {
+      convertPixels(src.data(), dst.data(), rowBytes * size, PixelConversion::FloatToHalf);
+    });
+
+    const std::string prefix = std::to_string(size) + "x" + std::to_string(size);
+    RecordProperty(prefix + "PerPixelCopyMBps", std::to_string(perPixel));
+    RecordProperty(prefix + "RepackFlipMBps", std::to_string(repackFlip));
+    RecordProperty(prefix + "SwapRedBlueFlipMBps", std::to_string(swapRedBlue));
+    RecordProperty(prefix + "HalfToFloatMBps", std::to_string(halfToFloat));
+    RecordProperty(prefix + "FloatToHalfMBps", std::to_string(floatToHalf));
+  }
+}
+
+} // namespace igl::tests
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "util/Common.h"
+
+#include <gtest/gtest.h>
+#include <igl/CommandBuffer.h>
+#include <igl/QueryPool.h>
+#include <igl/RenderPass.h>
+
+namespace igl::tests {
+
+constexpr size_t kOffscreenRtWidth = 2;
+constexpr size_t kOffscreenRtHeight = 2;
+constexpr uint32_t kNumQueries = 3;
+
+//
+// QueryPoolTest
+//
+// Writes GPU timestamps around a render pass and reads them back.
+//
+class QueryPoolTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+
+    Result ret;
+    const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                   kOffscreenRtWidth,
+                                                   kOffscreenRtHeight,
+                                                   TextureDesc::TextureUsageBits::Sampled |
+                                                       TextureDesc::TextureUsageBits::Attachment);
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = iglDev_->createTexture(texDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    renderPass_.colorAttachments.resize(1);
+    renderPass_.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass_.colorAttachments[0].storeAction = StoreAction::Store;
+    renderPass_.colorAttachments[0].clearColor = {1.0, 0.0, 0.0, 1.0};
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  RenderPassDesc renderPass_;
+};
+
+TEST_F(QueryPoolTest, Timestamps) {
+  if (!iglDev_->hasFeature(DeviceFeatures::TimestampQueries)) {
+    GTEST_SKIP() << "Timestamp queries are not supported";
+  }
+
+  Result ret;
+  auto pool = iglDev_->createQueryPool(
+      {.type = QueryType::Timestamp, .queryCount = kNumQueries, .debugName = "QueryPoolTest"},
+      &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(pool != nullptr);
+  ASSERT_EQ(pool->getDesc().queryCount, kNumQueries);
+
+  auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  cmdBuffer->resetQueries(*pool, 0, kNumQueries);
+  cmdBuffer->writeTimestamp(*pool, 0);
+  auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass_, framebuffer_, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  encoder->writeTimestamp(*pool, 1);
+  encoder->endEncoding();
+  cmdBuffer->writeTimestamp(*pool, 2);
+
+  cmdQueue_->submit(*cmdBuffer);
+  cmdBuffer->waitUntilCompleted();
+
+  uint64_t timestamps[kNumQueries] = {};
+  ASSERT_TRUE(pool->getTimestamps(0, kNumQueries, timestamps));
+
+  EXPECT_LE(timestamps[0], timestamps[1]);
+  EXPECT_LE(timestamps[1], timestamps[2]);
+
+  RecordProperty("RenderPassNanoseconds", static_cast<int>(timestamps[2] - timestamps[0]));
+
+  // a subrange
+  uint64_t last = 0;
+  ASSERT_TRUE(pool->getTimestamps(2, 1, &last));
+  EXPECT_EQ(last, timestamps[2]);
+}
+
+TEST_F(QueryPoolTest, ZeroQueries) {
+  if (!iglDev_->hasFeature(DeviceFeatures::TimestampQueries)) {
+    GTEST_SKIP() << "Timestamp queries are not supported";
+  }
+
+  Result ret;
+  auto pool = iglDev_->createQueryPool({.type = QueryType::Timestamp, .queryCount = 0}, &ret);
+  EXPECT_FALSE(ret.isOk());
+  EXPECT_TRUE(pool == nullptr);
+}
+
+TEST_F(QueryPoolTest, UnsupportedPipelineStatistics) {
+  if (iglDev_->hasFeature(DeviceFeatures::PipelineStatisticsQueries)) {
+    GTEST_SKIP() << "Pipeline statistics queries are supported";
+  }
+
+  Result ret;
+  auto pool =
+      iglDev_->createQueryPool({.type = QueryType::PipelineStatistics, .queryCount = 1}, &ret);
+  EXPECT_FALSE(ret.isOk());
+  EXPECT_TRUE(pool == nullptr);
+}
+
+} // namespace igl::tests
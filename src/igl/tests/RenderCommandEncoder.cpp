@@ -25,6 +25,9 @@
 #include <igl/RenderPipelineState.h>
 #include <igl/SamplerState.h>
 #include <igl/VertexInputState.h>
+#if IGL_BACKEND_OPENGL
+#include <igl/opengl/CommandQueue.h>
+#endif // IGL_BACKEND_OPENGL
 
 #define OFFSCREEN_RT_WIDTH 4
 #define OFFSCREEN_RT_HEIGHT 4
@@ -41,8 +44,10 @@ const uint32_t kBackgroundColorHex = 0x80808080;
 /**
  * @brief RenderCommandEncoderTest is a test fixture for all the tests in this file.
  * It takes care of common initialization and allocating of common resources.
+ * The parameter enables the deferred command recording mode of the OpenGL backend (see
+ * opengl::CommandQueue::setCommandRecordingEnabled()), which other backends skip.
  */
-class RenderCommandEncoderTest : public ::testing::Test {
+class RenderCommandEncoderTest : public ::testing::TestWithParam<bool> {
  private:
  public:
   RenderCommandEncoderTest() = default;
@@ -60,6 +65,19 @@ class RenderCommandEncoderTest : public ::testing::Test {
     ASSERT_TRUE(iglDev_ != nullptr);
     ASSERT_TRUE(cmdQueue_ != nullptr);
 
+    if (GetParam()) {
+      bool isRecording = false;
+#if IGL_BACKEND_OPENGL
+      if (iglDev_->getBackendType() == igl::BackendType::OpenGL) {
+        static_cast<opengl::CommandQueue&>(*cmdQueue_).setCommandRecordingEnabled(true);
+        isRecording = true;
+      }
+#endif // IGL_BACKEND_OPENGL
+      if (!isRecording) {
+        GTEST_SKIP() << "Command recording is only implemented by the OpenGL backend";
+      }
+    }
+
     // Create an offscreen texture to render to
     TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
                                              OFFSCREEN_RT_WIDTH,
@@ -374,7 +392,7 @@ class RenderCommandEncoderTest : public ::testing::Test {
   size_t textureUnit_ = 0;
 }; // namespace igl::tests
 
-TEST_F(RenderCommandEncoderTest, shouldDrawAPoint) {
+TEST_P(RenderCommandEncoderTest, shouldDrawAPoint) {
   initializeBuffers(
       // clang-format off
       { kQuarterPixel, kQuarterPixel, 0.0f, 1.0f },
@@ -399,7 +417,7 @@ TEST_F(RenderCommandEncoderTest, shouldDrawAPoint) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, shouldDrawAPointNewBindTexture) {
+TEST_P(RenderCommandEncoderTest, shouldDrawAPointNewBindTexture) {
   initializeBuffers(
       // clang-format off
       { kQuarterPixel, kQuarterPixel, 0.0f, 1.0f },
@@ -427,7 +445,7 @@ TEST_F(RenderCommandEncoderTest, shouldDrawAPointNewBindTexture) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, shouldDrawALine) {
+TEST_P(RenderCommandEncoderTest, shouldDrawALine) {
   initializeBuffers(
       // clang-format off
       {
@@ -458,7 +476,7 @@ TEST_F(RenderCommandEncoderTest, shouldDrawALine) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, shouldDrawLineStrip) {
+TEST_P(RenderCommandEncoderTest, shouldDrawLineStrip) {
   initializeBuffers(
       // clang-format off
       {
@@ -493,7 +511,7 @@ TEST_F(RenderCommandEncoderTest, shouldDrawLineStrip) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, drawIndexedFirstIndex) {
+TEST_P(RenderCommandEncoderTest, drawIndexedFirstIndex) {
   if (!iglDev_->hasFeature(igl::DeviceFeatures::DrawFirstIndexFirstVertex)) {
     GTEST_SKIP();
     return;
@@ -535,7 +553,7 @@ TEST_F(RenderCommandEncoderTest, drawIndexedFirstIndex) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, drawIndexed8Bit) {
+TEST_P(RenderCommandEncoderTest, drawIndexed8Bit) {
   if (!iglDev_->hasFeature(igl::DeviceFeatures::Indices8Bit)) {
     GTEST_SKIP();
     return;
@@ -576,7 +594,7 @@ TEST_F(RenderCommandEncoderTest, drawIndexed8Bit) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, drawInstanced) {
+TEST_P(RenderCommandEncoderTest, drawInstanced) {
   if (!iglDev_->hasFeature(igl::DeviceFeatures::DrawFirstIndexFirstVertex)) {
     GTEST_SKIP();
     return;
@@ -620,7 +638,7 @@ TEST_F(RenderCommandEncoderTest, drawInstanced) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, shouldDrawATriangle) {
+TEST_P(RenderCommandEncoderTest, shouldDrawATriangle) {
   initializeBuffers(
       // clang-format off
       {
@@ -652,7 +670,7 @@ TEST_F(RenderCommandEncoderTest, shouldDrawATriangle) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, shouldDrawTriangleStrip) {
+TEST_P(RenderCommandEncoderTest, shouldDrawTriangleStrip) {
   initializeBuffers(
       // clang-format off
       {
@@ -682,7 +700,7 @@ TEST_F(RenderCommandEncoderTest, shouldDrawTriangleStrip) {
   });
 }
 
-TEST_F(RenderCommandEncoderTest, shouldDrawTriangleStripCopyTextureToBuffer) {
+TEST_P(RenderCommandEncoderTest, shouldDrawTriangleStripCopyTextureToBuffer) {
   if (iglDev_->getBackendType() != igl::BackendType::Vulkan) {
     GTEST_SKIP() << "Not implemented for non-Vulkan backends";
     return;
@@ -753,7 +771,7 @@ TEST_F(RenderCommandEncoderTest, shouldDrawTriangleStripCopyTextureToBuffer) {
   screenCopy->unmap();
 }
 
-TEST_F(RenderCommandEncoderTest, shouldNotDraw) {
+TEST_P(RenderCommandEncoderTest, shouldNotDraw) {
   initializeBuffers(
       // clang-format off
       {
@@ -794,7 +812,7 @@ TEST_F(RenderCommandEncoderTest, shouldNotDraw) {
   });
 }
 
-TEST_F(RenderCommandEncoderTest, shouldDrawATriangleBindGroup) {
+TEST_P(RenderCommandEncoderTest, shouldDrawATriangleBindGroup) {
 #if IGL_PLATFORM_APPLE
   if (iglDev_->getBackendType() == igl::BackendType::Vulkan) {
     // @fb-only
@@ -837,7 +855,7 @@ TEST_F(RenderCommandEncoderTest, shouldDrawATriangleBindGroup) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, DepthBiasShouldDrawAPoint) {
+TEST_P(RenderCommandEncoderTest, DepthBiasShouldDrawAPoint) {
   initializeBuffers(
       // clang-format off
       { kQuarterPixel, kQuarterPixel, 0.0f, 1.0f },
@@ -863,7 +881,7 @@ TEST_F(RenderCommandEncoderTest, DepthBiasShouldDrawAPoint) {
   verifyFrameBuffer(expectedPixels);
 }
 
-TEST_F(RenderCommandEncoderTest, drawUsingBindPushConstants) {
+TEST_P(RenderCommandEncoderTest, drawUsingBindPushConstants) {
   if (iglDev_->getBackendType() != igl::BackendType::Vulkan) {
     GTEST_SKIP() << "Push constants are only supported in Vulkan";
     return;
@@ -926,4 +944,11 @@ TEST_F(RenderCommandEncoderTest, drawUsingBindPushConstants) {
   verifyFrameBuffer(expectedPixels);
 }
 
+INSTANTIATE_TEST_SUITE_P(CommandRecording,
+                         RenderCommandEncoderTest,
+                         ::testing::Values(false, true),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                           return info.param ? "Recording" : "Immediate";
+                         });
+
 } // namespace igl::tests
@@ -267,6 +267,24 @@ const char OGL_SIMPLE_FRAG_SHADER_UNIFORM_BLOCKS[] =
         fragColor = texture(inputImage, uv.xy);
       });
 
+const char OGL_SIMPLE_VERT_SHADER_BATCHED_UNIFORMS[] =
+      IGL_TO_STRING(VERSION(300 es)
+      in vec4 position_in; out vec3 uv;
+
+      layout (std140) uniform IGLBatchedUniforms {
+        float scale;
+        vec2 offsets[2];
+        mat3 rotation;
+        bool flip;
+      };
+
+      void main() {
+        vec4 position = vec4(rotation * position_in.xyz * scale, 1.0);
+        position.xy += offsets[0] + offsets[1];
+        gl_Position = flip ? -position : position;
+        uv = position_in.xyz;
+      });
+
 //-----------------------------------------------------------------------------
 // Metal Shaders
 //-----------------------------------------------------------------------------
@@ -8,6 +8,11 @@
 #include "../util/Common.h"
 
 #include <IGLU/simple_renderer/ShaderUniforms.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string>
 
 namespace igl::tests {
 
@@ -37,6 +42,53 @@ class TestRenderPipelineReflection final : public IRenderPipelineReflection {
   std::vector<SamplerArgDesc> samplerArguments_;
   std::vector<TextureArgDesc> textureArguments_;
 };
+
+// Matches the std140 layout of getBlockDesc(), where each column of a mat3 is padded to 16 bytes
+struct PerFrame {
+  iglu::simdtypes::float4x4 mvp;
+  iglu::simdtypes::float4 color;
+  float normalMatrix[3][4];
+  float lightDir[3];
+  float time;
+};
+
+BufferArgDesc getBlockDesc() {
+  BufferArgDesc desc;
+  desc.name = IGL_NAMEHANDLE("PerFrame");
+  desc.bufferDataSize = sizeof(PerFrame);
+  desc.bufferIndex = 0;
+  desc.shaderStage = ShaderStage::Vertex;
+  desc.isUniformBlock = true;
+  desc.members = {
+      {IGL_NAMEHANDLE("mvp"), UniformType::Mat4x4, offsetof(PerFrame, mvp), 1},
+      {IGL_NAMEHANDLE("color"), UniformType::Float4, offsetof(PerFrame, color), 1},
+      {IGL_NAMEHANDLE("normalMatrix"),
+       UniformType::Mat3x3,
+       offsetof(PerFrame, normalMatrix),
+       1},
+      {IGL_NAMEHANDLE("lightDir"), UniformType::Float3, offsetof(PerFrame, lightDir), 1},
+      {IGL_NAMEHANDLE("time"), UniformType::Float, offsetof(PerFrame, time), 1},
+  };
+  return desc;
+}
+
+// An individual uniform of a legacy OpenGL shader, which is tightly packed
+BufferArgDesc getUniformDesc(const char* name, UniformType type, size_t size) {
+  BufferArgDesc desc;
+  desc.name = genNameHandle(name);
+  desc.bufferDataSize = size;
+  desc.bufferIndex = 1;
+  desc.shaderStage = ShaderStage::Vertex;
+  desc.isUniformBlock = false;
+  desc.members = {{desc.name, type, 0, 1}};
+  return desc;
+}
+
+iglu::simdtypes::float3x3 getNormalMatrix() {
+  return {iglu::simdtypes::float3{1.0f, 2.0f, 3.0f},
+          iglu::simdtypes::float3{4.0f, 5.0f, 6.0f},
+          iglu::simdtypes::float3{7.0f, 8.0f, 9.0f}};
+}
 } // namespace
 
 class ShaderUniformsTest : public ::testing::Test {
@@ -132,4 +184,180 @@ TEST_F(ShaderUniformsTest, SettersCoverage) {
   shaderUniforms.setTexture("test", nullptr, nullptr);
 }
 
+TEST_F(ShaderUniformsTest, ResolvedHandles) {
+  TestRenderPipelineReflection reflection{
+      std::vector<BufferArgDesc>{getBlockDesc()},
+      std::vector<SamplerArgDesc>{},
+      std::vector<TextureArgDesc>{},
+  };
+  iglu::material::ShaderUniforms shaderUniforms(*iglDev_, reflection);
+
+  // Metal names buffers after the instance, the other backends after the type
+  const auto mvp = shaderUniforms.resolveUniform<iglu::simdtypes::float4x4>(
+      IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("mvp"));
+  const auto color = shaderUniforms.resolveUniform<iglu::simdtypes::float4>(
+      IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("color"));
+  const auto time = shaderUniforms.resolveUniform<float>(IGL_NAMEHANDLE("time"));
+  EXPECT_TRUE(mvp.isValid());
+  EXPECT_TRUE(color.isValid());
+  EXPECT_TRUE(time.isValid());
+
+  const auto missing = shaderUniforms.resolveUniform<float>(IGL_NAMEHANDLE("missing"));
+  EXPECT_FALSE(missing.isValid());
+  const auto missingMember = shaderUniforms.resolveUniform<float>(
+      IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("missing"));
+  EXPECT_FALSE(missingMember.isValid());
+
+  // Larger than the array, only logs
+  shaderUniforms.set(time, 1.0f);
+  shaderUniforms.set(time, 1.0f, 1);
+  shaderUniforms.set(color, iglu::simdtypes::float4{1.0f, 0.0f, 0.0f, 1.0f});
+  const iglu::simdtypes::float4x4 matrices[1] = {iglu::simdtypes::float4x4(1.0f)};
+  shaderUniforms.setArray(mvp, matrices, 1);
+  // Setting an invalid handle does nothing
+  shaderUniforms.set(missing, 1.0f);
+
+  const auto block =
+      shaderUniforms.resolveBuffer(IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("PerFrame"));
+  EXPECT_TRUE(block.isValid());
+  EXPECT_FALSE(
+      shaderUniforms.resolveBuffer(IGL_NAMEHANDLE("Missing"), IGL_NAMEHANDLE("Missing")).isValid());
+
+  const PerFrame perFrame{};
+  shaderUniforms.setBuffer(block, &perFrame, sizeof(perFrame));
+  // Larger than the block, only logs
+  shaderUniforms.setBuffer(block, &perFrame, sizeof(perFrame) + 1);
+
+  // Resolving again returns the same locations
+  const auto colorAgain = shaderUniforms.resolveUniform<iglu::simdtypes::float4>(
+      IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("color"));
+  EXPECT_EQ(colorAgain.firstTarget, color.firstTarget);
+  EXPECT_EQ(colorAgain.numTargets, color.numTargets);
+  const auto timeAgain = shaderUniforms.resolveUniform<float>(IGL_NAMEHANDLE("time"));
+  EXPECT_EQ(timeAgain.firstTarget, time.firstTarget);
+  const auto blockAgain =
+      shaderUniforms.resolveBuffer(IGL_NAMEHANDLE("PerFrame"), IGL_NAMEHANDLE("PerFrame"));
+  EXPECT_EQ(blockAgain.firstTarget, block.firstTarget);
+}
+
+TEST_F(ShaderUniformsTest, ResolvedHandlesWriteBufferData) {
+  TestRenderPipelineReflection reflection{
+      std::vector<BufferArgDesc>{getBlockDesc()},
+      std::vector<SamplerArgDesc>{},
+      std::vector<TextureArgDesc>{},
+  };
+  iglu::material::ShaderUniforms shaderUniforms(*iglDev_, reflection);
+
+  const auto blockName = IGL_NAMEHANDLE("PerFrame");
+  const auto block = shaderUniforms.resolveBuffer(blockName, blockName);
+  const auto color = shaderUniforms.resolveUniform<iglu::simdtypes::float4>(
+      blockName, blockName, IGL_NAMEHANDLE("color"));
+  const auto normalMatrix = shaderUniforms.resolveUniform<iglu::simdtypes::float3x3>(
+      blockName, blockName, IGL_NAMEHANDLE("normalMatrix"));
+  const auto lightDir = shaderUniforms.resolveUniform<iglu::simdtypes::float3>(
+      blockName, blockName, IGL_NAMEHANDLE("lightDir"));
+  ASSERT_TRUE(block.isValid());
+  ASSERT_TRUE(color.isValid());
+  ASSERT_TRUE(normalMatrix.isValid());
+  ASSERT_TRUE(lightDir.isValid());
+
+  // The padding of each vector of 3 floats keeps its value
+  PerFrame expected;
+  std::fill_n(reinterpret_cast<float*>(&expected), sizeof(PerFrame) / sizeof(float), -1.0f);
+  shaderUniforms.setBuffer(block, &expected, sizeof(expected));
+
+  shaderUniforms.set(color, iglu::simdtypes::float4{0.1f, 0.2f, 0.3f, 0.4f});
+  shaderUniforms.set(normalMatrix, getNormalMatrix());
+  shaderUniforms.set(lightDir, iglu::simdtypes::float3{10.0f, 11.0f, 12.0f});
+
+  expected.color = iglu::simdtypes::float4{0.1f, 0.2f, 0.3f, 0.4f};
+  for (size_t column = 0; column < 3; ++column) {
+    for (size_t row = 0; row < 3; ++row) {
+      expected.normalMatrix[column][row] = static_cast<float>(column * 3 + row + 1);
+    }
+  }
+  expected.lightDir[0] = 10.0f;
+  expected.lightDir[1] = 11.0f;
+  expected.lightDir[2] = 12.0f;
+
+  const uint8_t* data = shaderUniforms.getBufferData(blockName);
+  ASSERT_TRUE(data != nullptr);
+  EXPECT_EQ(std::memcmp(data, &expected, sizeof(expected)), 0);
+}
+
+TEST_F(ShaderUniformsTest, ResolvedHandlesWritePackedUniforms) {
+  if (iglDev_->getBackendType() != BackendType::OpenGL) {
+    GTEST_SKIP() << "Only individual uniforms in OpenGL are tightly packed";
+  }
+  TestRenderPipelineReflection reflection{
+      std::vector<BufferArgDesc>{
+          getUniformDesc("normalMatrix", UniformType::Mat3x3, sizeof(float[3][3])),
+          getUniformDesc("lightDir", UniformType::Float3, sizeof(float[3])),
+      },
+      std::vector<SamplerArgDesc>{},
+      std::vector<TextureArgDesc>{},
+  };
+  iglu::material::ShaderUniforms shaderUniforms(*iglDev_, reflection);
+
+  const auto normalMatrix =
+      shaderUniforms.resolveUniform<iglu::simdtypes::float3x3>(IGL_NAMEHANDLE("normalMatrix"));
+  const auto lightDir =
+      shaderUniforms.resolveUniform<iglu::simdtypes::float3>(IGL_NAMEHANDLE("lightDir"));
+  ASSERT_TRUE(normalMatrix.isValid());
+  ASSERT_TRUE(lightDir.isValid());
+
+  shaderUniforms.set(normalMatrix, getNormalMatrix());
+  shaderUniforms.set(lightDir, iglu::simdtypes::float3{10.0f, 11.0f, 12.0f});
+
+  const float expectedMatrix[9] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+  const uint8_t* matrixData = shaderUniforms.getBufferData(IGL_NAMEHANDLE("normalMatrix"));
+  ASSERT_TRUE(matrixData != nullptr);
+  EXPECT_EQ(std::memcmp(matrixData, expectedMatrix, sizeof(expectedMatrix)), 0);
+
+  const float expectedVector[3] = {10.0f, 11.0f, 12.0f};
+  const uint8_t* vectorData = shaderUniforms.getBufferData(IGL_NAMEHANDLE("lightDir"));
+  ASSERT_TRUE(vectorData != nullptr);
+  EXPECT_EQ(std::memcmp(vectorData, expectedVector, sizeof(expectedVector)), 0);
+}
+
+//
+// Compares setting a block member by name with setting it through a resolved handle
+//
+TEST_F(ShaderUniformsTest, ResolvedHandlesBenchmark) {
+  using Clock = std::chrono::steady_clock;
+  using Nanoseconds = std::chrono::duration<double, std::nano>;
+  constexpr size_t kNumIterations = 100000;
+
+  TestRenderPipelineReflection reflection{
+      std::vector<BufferArgDesc>{getBlockDesc()},
+      std::vector<SamplerArgDesc>{},
+      std::vector<TextureArgDesc>{},
+  };
+  iglu::material::ShaderUniforms shaderUniforms(*iglDev_, reflection);
+
+  const auto blockTypeName = IGL_NAMEHANDLE("PerFrame");
+  const auto memberName = IGL_NAMEHANDLE("mvp");
+  iglu::simdtypes::float4x4 value{};
+
+  auto start = Clock::now();
+  for (size_t i = 0; i < kNumIterations; ++i) {
+    value.columns[0][0] = static_cast<float>(i);
+    shaderUniforms.setFloat4x4(blockTypeName, blockTypeName, memberName, value);
+  }
+  const double byName = Nanoseconds(Clock::now() - start).count() / kNumIterations;
+
+  const auto handle = shaderUniforms.resolveUniform<iglu::simdtypes::float4x4>(
+      blockTypeName, blockTypeName, memberName);
+  ASSERT_TRUE(handle.isValid());
+  start = Clock::now();
+  for (size_t i = 0; i < kNumIterations; ++i) {
+    value.columns[0][0] = static_cast<float>(i);
+    shaderUniforms.set(handle, value);
+  }
+  const double byHandle = Nanoseconds(Clock::now() - start).count() / kNumIterations;
+
+  RecordProperty("NanosecondsPerSetByName", std::to_string(byName));
+  RecordProperty("NanosecondsPerSetByHandle", std::to_string(byHandle));
+}
+
 } // namespace igl::tests
@@ -9,8 +9,11 @@
 
 #include <IGLU/texture_loader/ktx2/Header.h>
 #include <IGLU/texture_loader/ktx2/TextureLoaderFactory.h>
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <numeric>
+#include <string>
 #include <vector>
 #include <igl/vulkan/util/TextureFormat.h>
 
@@ -228,6 +231,108 @@ void populateMinimalValidFile(std::vector<uint8_t>& buffer,
   putDfd(buffer, vkFormat, forceDfdAfterMipLevel1 ? 1u : numMipLevels);
 }
 
+constexpr uint32_t kOffsetSupercompressionScheme = 44u;
+constexpr uint32_t kSupercompressionZstd = 2u;
+
+// A Zstandard frame made of raw or RLE blocks, which a decoder accepts without compressing anything
+// in the test. RLE blocks require `data` to repeat a single byte value.
+void putZstdFrame(std::vector<uint8_t>& buffer, const std::vector<uint8_t>& data, bool useRle) {
+  constexpr size_t kMaxBlockSize = 128u * 1024u;
+  const uint32_t magicNumber = 0xFD2FB528u;
+  const uint8_t frameHeaderDescriptor = 0xA0; // Single segment, 4 bytes of content size
+  const auto contentSize = static_cast<uint32_t>(data.size());
+
+  const auto* magicNumberBytes = reinterpret_cast<const uint8_t*>(&magicNumber);
+  buffer.insert(buffer.end(), magicNumberBytes, magicNumberBytes + sizeof(magicNumber));
+  buffer.push_back(frameHeaderDescriptor);
+  const auto* contentSizeBytes = reinterpret_cast<const uint8_t*>(&contentSize);
+  buffer.insert(buffer.end(), contentSizeBytes, contentSizeBytes + sizeof(contentSize));
+
+  for (size_t offset = 0; offset < data.size();) {
+    const size_t blockSize = std::min(kMaxBlockSize, data.size() - offset);
+    const bool isLastBlock = offset + blockSize == data.size();
+    const uint32_t blockHeader = (isLastBlock ? 1u : 0u) | ((useRle ? 1u : 0u) << 1) |
+                                 (static_cast<uint32_t>(blockSize) << 3);
+    buffer.push_back(static_cast<uint8_t>(blockHeader & 0xFF));
+    buffer.push_back(static_cast<uint8_t>((blockHeader >> 8) & 0xFF));
+    buffer.push_back(static_cast<uint8_t>((blockHeader >> 16) & 0xFF));
+    if (useRle) {
+      buffer.push_back(data[offset]);
+    } else {
+      buffer.insert(buffer.end(),
+                    data.begin() + static_cast<ptrdiff_t>(offset),
+                    data.begin() + static_cast<ptrdiff_t>(offset + blockSize));
+    }
+    offset += blockSize;
+  }
+}
+
+std::vector<uint8_t> getMipLevelData(uint32_t vkFormat,
+                                     uint32_t width,
+                                     uint32_t height,
+                                     uint32_t mipLevel,
+                                     bool useRle) {
+  const auto format =
+      igl::vulkan::util::vkTextureFormatToTextureFormat(static_cast<int32_t>(vkFormat));
+  const auto properties = igl::TextureFormatProperties::fromTextureFormat(format);
+  const auto range = igl::TextureRangeDesc::new2D(0, 0, width, height);
+
+  std::vector<uint8_t> data(properties.getBytesPerRange(range.atMipLevel(mipLevel)));
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<uint8_t>(useRle ? mipLevel + 1u : mipLevel * 31u + i);
+  }
+  return data;
+}
+
+// A file with every mip level supercompressed with Zstandard
+std::vector<uint8_t> getZstdFile(uint32_t vkFormat,
+                                 uint32_t width,
+                                 uint32_t height,
+                                 uint32_t numMipLevels,
+                                 bool useRle) {
+  const uint32_t dfdByteLength = kDfdMetadataSize - 4u;
+  auto buffer = getBuffer(kHeaderSize + numMipLevels * kMipmapMetadataSize + dfdByteLength);
+
+  const char fixedTag[] = {'\xAB', 'K', 'T', 'X', ' ', '2', '0', '\xBB', '\r', '\n', '\x1A', '\n'};
+  std::memcpy(buffer.data(), &fixedTag, sizeof(fixedTag));
+  put(buffer, kOffsetVkFormat, vkFormat);
+  put(buffer, kOffsetTypeSize, 1);
+  put(buffer, kOffsetFaceCount, 1);
+  put(buffer, kOffsetWidth, width);
+  put(buffer, kOffsetHeight, height);
+  put(buffer, kOffsetLevelCount, numMipLevels);
+  put(buffer, kOffsetSupercompressionScheme, kSupercompressionZstd);
+  putDfd(buffer, vkFormat, numMipLevels);
+
+  // Supercompressed mip levels are stored from the smallest to the largest without padding
+  for (uint32_t i = 0; i < numMipLevels; ++i) {
+    const uint32_t mipLevel = numMipLevels - i - 1;
+    const auto data = getMipLevelData(vkFormat, width, height, mipLevel, useRle);
+    const size_t byteOffset = buffer.size();
+    putZstdFrame(buffer, data, useRle);
+
+    const uint32_t mipmapMetadataOffset = kHeaderSize + mipLevel * kMipmapMetadataSize;
+    put(buffer, mipmapMetadataOffset, static_cast<uint64_t>(byteOffset));
+    put(buffer, mipmapMetadataOffset + 8u, static_cast<uint64_t>(buffer.size() - byteOffset));
+    put(buffer, mipmapMetadataOffset + 16u, static_cast<uint64_t>(data.size()));
+  }
+  return buffer;
+}
+
+// All mip levels, tightly packed from the largest to the smallest
+std::vector<uint8_t> getExpectedZstdFileData(uint32_t vkFormat,
+                                             uint32_t width,
+                                             uint32_t height,
+                                             uint32_t numMipLevels,
+                                             bool useRle) {
+  std::vector<uint8_t> expected;
+  for (uint32_t mipLevel = 0; mipLevel < numMipLevels; ++mipLevel) {
+    const auto data = getMipLevelData(vkFormat, width, height, mipLevel, useRle);
+    expected.insert(expected.end(), data.begin(), data.end());
+  }
+  return expected;
+}
+
 } // namespace
 
 class Ktx2TextureLoaderTest : public ::testing::Test {
@@ -478,4 +583,96 @@ TEST_F(Ktx2TextureLoaderTest, InvalidHeaderWithExcessiveKeyValueData_Fails) {
   EXPECT_FALSE(ret.isOk());
 }
 
+TEST_F(Ktx2TextureLoaderTest, ZstdSupercompressed_Succeeds) {
+  const uint32_t width = 64u;
+  const uint32_t height = 32u;
+  const uint32_t numMipLevels = 5u;
+  const uint32_t vkFormat = 1000054000u; /* VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG */
+
+  for (bool useRle : {false, true}) {
+    const auto buffer = getZstdFile(vkFormat, width, height, numMipLevels, useRle);
+
+    Result ret;
+    auto reader = *iglu::textureloader::DataReader::tryCreate(
+        buffer.data(), static_cast<uint32_t>(buffer.size()), nullptr);
+    auto loader = factory_.tryCreate(reader, &ret);
+    ASSERT_NE(loader, nullptr) << ret.message;
+    EXPECT_TRUE(ret.isOk()) << ret.message;
+    EXPECT_EQ(loader->descriptor().numMipLevels, numMipLevels);
+
+    auto data = loader->load(&ret);
+    ASSERT_NE(data, nullptr);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+    const auto expected = getExpectedZstdFileData(vkFormat, width, height, numMipLevels, useRle);
+    ASSERT_EQ(data->length(), expected.size());
+    EXPECT_EQ(std::memcmp(data->data(), expected.data(), expected.size()), 0);
+  }
+}
+
+TEST_F(Ktx2TextureLoaderTest, ZstdSupercompressedCorrupt_Fails) {
+  const uint32_t width = 64u;
+  const uint32_t height = 32u;
+  const uint32_t numMipLevels = 5u;
+  const uint32_t vkFormat = 1000054000u; /* VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG */
+
+  auto buffer = getZstdFile(vkFormat, width, height, numMipLevels, false);
+  // Break the magic number of the frame of mip level 0, which is stored last
+  uint64_t byteOffset = 0;
+  std::memcpy(&byteOffset, buffer.data() + kHeaderSize, sizeof(byteOffset));
+  buffer[static_cast<size_t>(byteOffset)] ^= 0xFF;
+
+  Result ret;
+  auto reader = *iglu::textureloader::DataReader::tryCreate(
+      buffer.data(), static_cast<uint32_t>(buffer.size()), nullptr);
+  auto loader = factory_.tryCreate(reader, &ret);
+  EXPECT_EQ(loader, nullptr);
+  EXPECT_FALSE(ret.isOk());
+}
+
+TEST_F(Ktx2TextureLoaderTest, ZstdSupercompressedTruncated_Fails) {
+  const uint32_t width = 64u;
+  const uint32_t height = 32u;
+  const uint32_t numMipLevels = 5u;
+  const uint32_t vkFormat = 1000054000u; /* VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG */
+
+  auto buffer = getZstdFile(vkFormat, width, height, numMipLevels, false);
+  buffer.pop_back();
+
+  Result ret;
+  auto reader = *iglu::textureloader::DataReader::tryCreate(
+      buffer.data(), static_cast<uint32_t>(buffer.size()), nullptr);
+  auto loader = factory_.tryCreate(reader, &ret);
+  EXPECT_EQ(loader, nullptr);
+  EXPECT_FALSE(ret.isOk());
+}
+
+TEST_F(Ktx2TextureLoaderTest, ZstdSupercompressedThroughput) {
+  using Clock = std::chrono::steady_clock;
+
+  // Large enough for the first mip levels to be decompressed in parallel
+  const uint32_t width = 2048u;
+  const uint32_t height = 2048u;
+  const uint32_t numMipLevels = 12u;
+  const uint32_t vkFormat = 1000054000u; /* VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG */
+  const uint32_t kNumIterations = 8u;
+
+  const auto buffer = getZstdFile(vkFormat, width, height, numMipLevels, true);
+  auto reader = *iglu::textureloader::DataReader::tryCreate(
+      buffer.data(), static_cast<uint32_t>(buffer.size()), nullptr);
+
+  size_t decompressedBytes = 0;
+  const auto start = Clock::now();
+  for (uint32_t i = 0; i < kNumIterations; ++i) {
+    Result ret;
+    auto loader = factory_.tryCreate(reader, &ret);
+    ASSERT_NE(loader, nullptr) << ret.message;
+    decompressedBytes += loader->memorySizeInBytes();
+  }
+  const std::chrono::duration<double> seconds = Clock::now() - start;
+
+  RecordProperty("CompressedBytes", static_cast<int>(buffer.size()));
+  RecordProperty("DecompressedMegabytesPerSecond",
+                 std::to_string(static_cast<double>(decompressedBytes) / 1e6 / seconds.count()));
+}
+
 } // namespace igl::tests::ktx2
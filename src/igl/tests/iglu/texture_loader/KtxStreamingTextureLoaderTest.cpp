@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../../util/Common.h"
+
+#include <IGLU/texture_loader/IData.h>
+#include <IGLU/texture_loader/ktx1/Header.h>
+#include <IGLU/texture_loader/ktx1/TextureLoaderFactory.h>
+#include <IGLU/texture_loader/ktx2/Header.h>
+#include <IGLU/texture_loader/ktx2/TextureLoaderFactory.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#if !IGL_PLATFORM_WINDOWS
+#include <sys/resource.h>
+#endif
+
+namespace igl::tests {
+
+namespace {
+
+// 2048x2048 RGBA8 with a full mip chain, about 22 MB
+constexpr uint32_t kWidth = 2048u;
+constexpr uint32_t kHeight = 2048u;
+constexpr uint32_t kNumMipLevels = 12u;
+constexpr uint32_t kBytesPerPixel = 4u;
+
+template<typename T>
+void put(std::vector<uint8_t>& buffer, size_t offset, T data) {
+  ASSERT_LE(offset + sizeof(T), buffer.size());
+  std::memcpy(buffer.data() + offset, &data, sizeof(T));
+}
+
+uint32_t getMipLevelBytes(uint32_t mipLevel) {
+  return std::max(kWidth >> mipLevel, 1u) * std::max(kHeight >> mipLevel, 1u) * kBytesPerPixel;
+}
+
+void putMipLevelPixels(std::vector<uint8_t>& buffer, size_t offset, uint32_t mipLevel) {
+  const uint32_t length = getMipLevelBytes(mipLevel);
+  for (uint32_t i = 0; i < length; ++i) {
+    buffer[offset + i] = static_cast<uint8_t>(mipLevel * 31u + i);
+  }
+}
+
+// All mip levels, tightly packed from the largest to the smallest
+std::vector<uint8_t> getExpectedPixels() {
+  size_t length = 0;
+  for (uint32_t mipLevel = 0; mipLevel < kNumMipLevels; ++mipLevel) {
+    length += getMipLevelBytes(mipLevel);
+  }
+  std::vector<uint8_t> pixels(length);
+  size_t offset = 0;
+  for (uint32_t mipLevel = 0; mipLevel < kNumMipLevels; ++mipLevel) {
+    putMipLevelPixels(pixels, offset, mipLevel);
+    offset += getMipLevelBytes(mipLevel);
+  }
+  return pixels;
+}
+
+std::vector<uint8_t> getKtx1File() {
+  size_t length = iglu::textureloader::ktx1::kHeaderLength;
+  for (uint32_t mipLevel = 0; mipLevel < kNumMipLevels; ++mipLevel) {
+    length += 4u + getMipLevelBytes(mipLevel);
+  }
+  std::vector<uint8_t> buffer(length);
+
+  const char fixedTag[] = {'\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n'};
+  std::memcpy(buffer.data(), &fixedTag, sizeof(fixedTag));
+  put(buffer, 12u, iglu::textureloader::ktx1::kEndiannessReference);
+  put(buffer, 16u, 0x1401u); // glType = GL_UNSIGNED_BYTE
+  put(buffer, 20u, 1u); // glTypeSize
+  put(buffer, 24u, 0x1908u); // glFormat = GL_RGBA
+  put(buffer, 28u, 0x8058u); // glInternalFormat = GL_RGBA8
+  put(buffer, 32u, 0x1908u); // glBaseInternalFormat = GL_RGBA
+  put(buffer, 36u, kWidth);
+  put(buffer, 40u, kHeight);
+  put(buffer, 52u, 1u); // numberOfFaces
+  put(buffer, 56u, kNumMipLevels);
+
+  size_t offset = iglu::textureloader::ktx1::kHeaderLength;
+  for (uint32_t mipLevel = 0; mipLevel < kNumMipLevels; ++mipLevel) {
+    put(buffer, offset, getMipLevelBytes(mipLevel));
+    putMipLevelPixels(buffer, offset + 4u, mipLevel);
+    offset += 4u + getMipLevelBytes(mipLevel);
+  }
+  return buffer;
+}
+
+std::vector<uint8_t> getKtx2File() {
+  constexpr uint32_t kLevelIndexOffset = iglu::textureloader::ktx2::kHeaderLength;
+  constexpr uint32_t kDfdOffset = kLevelIndexOffset + kNumMipLevels * 24u;
+  // Basic data format descriptor with 4 samples
+  constexpr uint32_t kDfdLength = 4u + 24u + 4u * 16u;
+  constexpr uint32_t kDataOffset = kDfdOffset + kDfdLength;
+
+  size_t length = kDataOffset;
+  for (uint32_t mipLevel = 0; mipLevel < kNumMipLevels; ++mipLevel) {
+    length += getMipLevelBytes(mipLevel);
+  }
+  std::vector<uint8_t> buffer(length);
+
+  const char fixedTag[] = {'\xAB', 'K', 'T', 'X', ' ', '2', '0', '\xBB', '\r', '\n', '\x1A', '\n'};
+  std::memcpy(buffer.data(), &fixedTag, sizeof(fixedTag));
+  put(buffer, 12u, 37u); // vkFormat = VK_FORMAT_R8G8B8A8_UNORM
+  put(buffer, 16u, 1u); // typeSize
+  put(buffer, 20u, kWidth);
+  put(buffer, 24u, kHeight);
+  put(buffer, 36u, 1u); // faceCount
+  put(buffer, 40u, kNumMipLevels);
+  put(buffer, 48u, kDfdOffset);
+  put(buffer, 52u, kDfdLength);
+
+  put(buffer, kDfdOffset, kDfdLength);
+  put(buffer, kDfdOffset + 8u, static_cast<uint16_t>(2)); // versionNumber
+  put(buffer, kDfdOffset + 10u, static_cast<uint16_t>(kDfdLength - 4u)); // descriptorBlockSize
+  put(buffer, kDfdOffset + 12u, static_cast<uint8_t>(1)); // KHR_DF_MODEL_RGBSDA
+  put(buffer, kDfdOffset + 13u, static_cast<uint8_t>(1)); // KHR_DF_PRIMARIES_BT709
+  put(buffer, kDfdOffset + 14u, static_cast<uint8_t>(1)); // KHR_DF_TRANSFER_LINEAR
+  put(buffer, kDfdOffset + 20u, static_cast<uint8_t>(kBytesPerPixel)); // bytesPlane0
+  const uint8_t channels[] = {0u /* R */, 1u /* G */, 2u /* B */, 15u /* A */};
+  for (uint32_t i = 0; i < 4u; ++i) {
+    const uint32_t sampleOffset = kDfdOffset + 28u + i * 16u;
+    put(buffer, sampleOffset, static_cast<uint16_t>(i * 8u)); // bitOffset
+    put(buffer, sampleOffset + 2u, static_cast<uint8_t>(7)); // bitLength - 1
+    put(buffer, sampleOffset + 3u, channels[i]);
+    put(buffer, sampleOffset + 12u, 255u); // sampleUpper
+  }
+
+  // Mip levels are stored from the smallest to the largest
+  size_t offset = kDataOffset;
+  for (uint32_t i = 0; i < kNumMipLevels; ++i) {
+    const uint32_t mipLevel = kNumMipLevels - i - 1;
+    const uint32_t mipLevelBytes = getMipLevelBytes(mipLevel);
+    const uint32_t levelIndexOffset = kLevelIndexOffset + mipLevel * 24u;
+    put(buffer, levelIndexOffset, static_cast<uint64_t>(offset));
+    put(buffer, levelIndexOffset + 8u, static_cast<uint64_t>(mipLevelBytes));
+    put(buffer, levelIndexOffset + 16u, static_cast<uint64_t>(mipLevelBytes));
+    putMipLevelPixels(buffer, offset, mipLevel);
+    offset += mipLevelBytes;
+  }
+  return buffer;
+}
+
+void writeFile(const std::string& path, const std::vector<uint8_t>& buffer) {
+  FILE* file = fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  EXPECT_EQ(fwrite(buffer.data(), 1, buffer.size(), file), buffer.size());
+  fclose(file);
+}
+
+// Reads the whole file into a heap buffer, like the shell's FileLoader
+std::unique_ptr<iglu::textureloader::IData> readFile(const std::string& path) {
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    return nullptr;
+  }
+  fseek(file, 0, SEEK_END);
+  const auto length = static_cast<uint32_t>(ftell(file));
+  fseek(file, 0, SEEK_SET);
+  auto data = std::make_unique<uint8_t[]>(length);
+  const size_t bytesRead = fread(data.get(), 1, length, file);
+  fclose(file);
+  if (bytesRead != length) {
+    return nullptr;
+  }
+  return iglu::textureloader::IData::tryCreate(std::move(data), length, nullptr);
+}
+
+// Peak resident set size of the process in kilobytes, 0 if unknown
+long getPeakRssKilobytes() {
+#if IGL_PLATFORM_WINDOWS
+  return 0;
+#else
+  rusage usage = {};
+  getrusage(RUSAGE_SELF, &usage);
+#if IGL_PLATFORM_APPLE
+  return usage.ru_maxrss / 1024; // bytes on Apple platforms
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+} // namespace
+
+//
+// KtxStreamingTextureLoaderTest
+//
+// Loads large uncompressed KTX1 and KTX2 files from memory mapped files, which upload mip levels
+// straight from the mapping, and compares load latency and peak memory with reading the whole
+// file into a heap buffer first.
+//
+class KtxStreamingTextureLoaderTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+
+    ktx1Path_ = (std::filesystem::temp_directory_path() / "igl_streaming_test.ktx").string();
+    ktx2Path_ = (std::filesystem::temp_directory_path() / "igl_streaming_test.ktx2").string();
+    writeFile(ktx1Path_, getKtx1File());
+    writeFile(ktx2Path_, getKtx2File());
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove(ktx1Path_, ec);
+    std::filesystem::remove(ktx2Path_, ec);
+  }
+
+  // Creates a loader over `data`, uploads a texture and checks the loaded mip levels
+  void loadAndVerify(const iglu::textureloader::ITextureLoaderFactory& factory,
+                     const iglu::textureloader::IData& data) const {
+    Result ret;
+    auto loader = factory.tryCreate(data.data(), data.length(), &ret);
+    ASSERT_TRUE(loader != nullptr) << ret.message;
+    EXPECT_EQ(loader->descriptor().numMipLevels, kNumMipLevels);
+    EXPECT_EQ(loader->descriptor().format, TextureFormat::RGBA_UNorm8);
+
+    auto texture = loader->create(*iglDev_, &ret);
+    ASSERT_TRUE(texture != nullptr) << ret.message;
+    loader->upload(*texture, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+
+    auto pixels = loader->load(&ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+    ASSERT_TRUE(pixels != nullptr);
+    const auto expectedPixels = getExpectedPixels();
+    ASSERT_EQ(pixels->length(), expectedPixels.size());
+    EXPECT_EQ(std::memcmp(pixels->data(), expectedPixels.data(), expectedPixels.size()), 0);
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::string ktx1Path_;
+  std::string ktx2Path_;
+  iglu::textureloader::ktx1::TextureLoaderFactory ktx1Factory_;
+  iglu::textureloader::ktx2::TextureLoaderFactory ktx2Factory_;
+};
+
+TEST_F(KtxStreamingTextureLoaderTest, Ktx1MappedFile) {
+  Result ret;
+  auto data = iglu::textureloader::IData::tryCreateFromFile(ktx1Path_.c_str(), &ret);
+  ASSERT_TRUE(data != nullptr) << ret.message;
+  loadAndVerify(ktx1Factory_, *data);
+}
+
+TEST_F(KtxStreamingTextureLoaderTest, Ktx2MappedFile) {
+  Result ret;
+  auto data = iglu::textureloader::IData::tryCreateFromFile(ktx2Path_.c_str(), &ret);
+  ASSERT_TRUE(data != nullptr) << ret.message;
+  loadAndVerify(ktx2Factory_, *data);
+}
+
+TEST_F(KtxStreamingTextureLoaderTest, MappedFileExtractData) {
+  Result ret;
+  auto data = iglu::textureloader::IData::tryCreateFromFile(ktx2Path_.c_str(), &ret);
+  ASSERT_TRUE(data != nullptr) << ret.message;
+
+  const auto expectedFile = getKtx2File();
+  auto extracted = data->extractData();
+  data.reset();
+  ASSERT_EQ(extracted.length, expectedFile.size());
+  EXPECT_EQ(std::memcmp(extracted.data, expectedFile.data(), expectedFile.size()), 0);
+  ASSERT_TRUE(extracted.deleter != nullptr);
+  extracted.deleter(const_cast<void*>(extracted.data));
+}
+
+TEST_F(KtxStreamingTextureLoaderTest, MissingFile_Fails) {
+  Result ret;
+  const auto path = std::filesystem::temp_directory_path() / "igl_streaming_test_missing.ktx2";
+  EXPECT_EQ(iglu::textureloader::IData::tryCreateFromFile(path.string().c_str(), &ret), nullptr);
+  EXPECT_FALSE(ret.isOk());
+}
+
+TEST_F(KtxStreamingTextureLoaderTest, CompareWithHeapBuffer) {
+  using Clock = std::chrono::steady_clock;
+  using Microseconds = std::chrono::duration<double, std::micro>;
+
+  const struct {
+    const char* name;
+    const std::string& path;
+    const iglu::textureloader::ITextureLoaderFactory& factory;
+  } assets[] = {
+      {"Ktx1", ktx1Path_, ktx1Factory_},
+      {"Ktx2", ktx2Path_, ktx2Factory_},
+  };
+
+  // The peak resident set size only grows, so the mapped files are measured first
+  for (bool mapped : {true, false}) {
+    for (const auto& asset : assets) {
+      const long peakRssBefore = getPeakRssKilobytes();
+      const auto start = Clock::now();
+
+      Result ret;
+      auto data = mapped ? iglu::textureloader::IData::tryCreateFromFile(asset.path.c_str(), &ret)
+                         : readFile(asset.path);
+      ASSERT_TRUE(data != nullptr) << ret.message;
+      auto loader = asset.factory.tryCreate(data->data(), data->length(), &ret);
+      ASSERT_TRUE(loader != nullptr) << ret.message;
+      auto texture = loader->create(*iglDev_, &ret);
+      ASSERT_TRUE(texture != nullptr) << ret.message;
+      loader->upload(*texture, &ret);
+      ASSERT_TRUE(ret.isOk()) << ret.message;
+
+      const auto latency = Clock::now() - start;
+      const std::string prefix = std::string(mapped ? "Mapped" : "Heap") + asset.name;
+      RecordProperty(prefix + "LoadMicroseconds",
+                     static_cast<int>(Microseconds(latency).count()));
+      RecordProperty(prefix + "PeakRssGrowthKilobytes",
+                     static_cast<int>(getPeakRssKilobytes() - peakRssBefore));
+    }
+  }
+}
+
+} // namespace igl::tests
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../../util/Common.h"
+
+#include <IGLU/texture_loader/TextureStreamer.h>
+#include <IGLU/texture_loader/stb_png/TextureLoaderFactory.h>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr std::array<uint8_t, 128> kRed2x2PNG{
+    {0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44,
+     0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x08, 0x02, 0x00, 0x00, 0x00, 0xfd,
+     0xd4, 0x9a, 0x73, 0x00, 0x00, 0x00, 0x01, 0x73, 0x52, 0x47, 0x42, 0x00, 0xae, 0xce, 0x1c,
+     0xe9, 0x00, 0x00, 0x00, 0x04, 0x67, 0x41, 0x4d, 0x41, 0x00, 0x00, 0xb1, 0x8f, 0x0b, 0xfc,
+     0x61, 0x05, 0x00, 0x00, 0x00, 0x09, 0x70, 0x48, 0x59, 0x73, 0x00, 0x00, 0x0e, 0xc3, 0x00,
+     0x00, 0x0e, 0xc3, 0x01, 0xc7, 0x6f, 0xa8, 0x64, 0x00, 0x00, 0x00, 0x15, 0x49, 0x44, 0x41,
+     0x54, 0x18, 0x57, 0x63, 0x78, 0x67, 0x64, 0xf5, 0x56, 0x4e, 0x8d, 0x01, 0x88, 0xdf, 0xdb,
+     0xb9, 0x02, 0x00, 0x26, 0xc4, 0x05, 0x2f, 0x43, 0xee, 0xb8, 0xc6, 0x00, 0x00, 0x00, 0x00,
+     0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82}};
+
+// Decoded size of kRed2x2PNG, RGBA8 without mipmaps
+constexpr size_t kDecodedBytes = 2u * 2u * 4u;
+
+constexpr uint32_t kNumRequests = 64;
+
+std::unique_ptr<iglu::textureloader::IData> getPngData() {
+  auto data = std::make_unique<uint8_t[]>(kRed2x2PNG.size());
+  std::memcpy(data.get(), kRed2x2PNG.data(), kRed2x2PNG.size());
+  return iglu::textureloader::IData::tryCreate(
+      std::move(data), static_cast<uint32_t>(kRed2x2PNG.size()), nullptr);
+}
+
+} // namespace
+
+//
+// TextureStreamerTest
+//
+// Decodes PNG textures on worker threads and uploads them from processUploads(), checking the
+// priority order and the in-flight and per frame budgets.
+//
+class TextureStreamerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+  }
+
+  void TearDown() override {}
+
+  // Waits until `streamer` has decoded `numRequests` requests without uploading them
+  static void waitForReadyRequests(const iglu::textureloader::TextureStreamer& streamer,
+                                   size_t numRequests) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (streamer.getNumReadyRequests() < numRequests &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(streamer.getNumReadyRequests(), numRequests);
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  iglu::textureloader::stb::png::TextureLoaderFactory factory_;
+};
+
+TEST_F(TextureStreamerTest, AllRequestsComplete) {
+  using Clock = std::chrono::steady_clock;
+
+  iglu::textureloader::TextureStreamer streamer(factory_, {});
+
+  std::vector<std::shared_ptr<ITexture>> textures;
+  const auto start = Clock::now();
+  for (uint32_t i = 0; i < kNumRequests; ++i) {
+    streamer.enqueue(getPngData(), 0, [&textures](std::shared_ptr<ITexture> texture,
+                                                  const Result& result) {
+      EXPECT_TRUE(result.isOk()) << result.message;
+      textures.push_back(std::move(texture));
+    });
+  }
+
+  // a frame loop
+  uint32_t numFrames = 0;
+  const auto deadline = Clock::now() + std::chrono::seconds(10);
+  while (streamer.getNumPendingRequests() > 0 && Clock::now() < deadline) {
+    streamer.processUploads(*iglDev_, *cmdQueue_);
+    numFrames++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  const auto elapsed = Clock::now() - start;
+
+  ASSERT_EQ(textures.size(), kNumRequests);
+  for (const auto& texture : textures) {
+    ASSERT_TRUE(texture != nullptr);
+    EXPECT_EQ(texture->getDimensions().width, 2u);
+    EXPECT_EQ(texture->getDimensions().height, 2u);
+    EXPECT_EQ(texture->getFormat(), TextureFormat::RGBA_UNorm8);
+  }
+
+  const auto stats = streamer.getStats();
+  EXPECT_EQ(stats.numDecoded, kNumRequests);
+  EXPECT_EQ(stats.numUploaded, kNumRequests);
+  EXPECT_EQ(stats.numFailed, 0u);
+  EXPECT_EQ(stats.uploadedBytes, kNumRequests * kDecodedBytes);
+
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  RecordProperty("MicrosecondsPerTexture",
+                 std::to_string(Microseconds(elapsed).count() / kNumRequests));
+  RecordProperty("Frames", static_cast<int>(numFrames));
+}
+
+TEST_F(TextureStreamerTest, UploadsByPriority) {
+  iglu::textureloader::TextureStreamer streamer(factory_, {});
+
+  std::vector<int32_t> completed;
+  const int32_t priorities[] = {1, 5, -3, 5, 0, 2};
+  for (int32_t priority : priorities) {
+    streamer.enqueue(getPngData(), priority, [&completed, priority](auto, const Result& result) {
+      EXPECT_TRUE(result.isOk()) << result.message;
+      completed.push_back(priority);
+    });
+  }
+
+  waitForReadyRequests(streamer, std::size(priorities));
+  EXPECT_EQ(streamer.processUploads(*iglDev_, *cmdQueue_), std::size(priorities));
+  EXPECT_EQ(completed, (std::vector<int32_t>{5, 5, 2, 1, 0, -3}));
+}
+
+TEST_F(TextureStreamerTest, SetPriorityAndCancel) {
+  iglu::textureloader::TextureStreamer streamer(factory_, {});
+
+  std::vector<uint32_t> completed;
+  std::vector<iglu::textureloader::TextureStreamer::RequestId> ids;
+  for (uint32_t i = 0; i < 4u; ++i) {
+    ids.push_back(streamer.enqueue(
+        getPngData(), 0, [&completed, i](auto, const Result& /*result*/) {
+          completed.push_back(i);
+        }));
+  }
+
+  waitForReadyRequests(streamer, ids.size());
+  EXPECT_TRUE(streamer.setPriority(ids[3], 1));
+  EXPECT_TRUE(streamer.cancel(ids[1]));
+  EXPECT_FALSE(streamer.cancel(ids[1]));
+  EXPECT_EQ(streamer.getNumPendingRequests(), 3u);
+
+  EXPECT_EQ(streamer.processUploads(*iglDev_, *cmdQueue_), 3u);
+  EXPECT_EQ(completed, (std::vector<uint32_t>{3, 0, 2}));
+  EXPECT_FALSE(streamer.setPriority(ids[0], 1));
+}
+
+TEST_F(TextureStreamerTest, UploadBudget) {
+  iglu::textureloader::TextureStreamer streamer(factory_,
+                                                {
+                                                    .maxUploadBytesPerFrame = kDecodedBytes,
+                                                });
+
+  for (uint32_t i = 0; i < 4u; ++i) {
+    streamer.enqueue(getPngData(), 0, nullptr);
+  }
+
+  waitForReadyRequests(streamer, 4u);
+  for (uint32_t i = 0; i < 4u; ++i) {
+    EXPECT_EQ(streamer.processUploads(*iglDev_, *cmdQueue_), 1u);
+  }
+  EXPECT_EQ(streamer.processUploads(*iglDev_, *cmdQueue_), 0u);
+}
+
+TEST_F(TextureStreamerTest, InFlightBudget) {
+  // two decoded textures at most
+  iglu::textureloader::TextureStreamer streamer(factory_,
+                                                {
+                                                    .numThreads = 4,
+                                                    .maxInFlightBytes = 2u * kDecodedBytes,
+                                                });
+
+  for (uint32_t i = 0; i < 8u; ++i) {
+    streamer.enqueue(getPngData(), 0, nullptr);
+  }
+
+  waitForReadyRequests(streamer, 2u);
+  // the workers do not decode more until the render thread uploads
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(streamer.getNumReadyRequests(), 2u);
+  EXPECT_EQ(streamer.getStats().numDecoded, 2u);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (streamer.getNumPendingRequests() > 0 && std::chrono::steady_clock::now() < deadline) {
+    streamer.processUploads(*iglDev_, *cmdQueue_);
+  }
+
+  const auto stats = streamer.getStats();
+  EXPECT_EQ(stats.numUploaded, 8u);
+  EXPECT_LE(stats.peakInFlightBytes, 2u * kDecodedBytes);
+}
+
+TEST_F(TextureStreamerTest, InvalidData_Fails) {
+  iglu::textureloader::TextureStreamer streamer(factory_, {});
+
+  auto data = std::make_unique<uint8_t[]>(kRed2x2PNG.size());
+  std::memset(data.get(), 0xff, kRed2x2PNG.size());
+  bool completed = false;
+  streamer.enqueue(iglu::textureloader::IData::tryCreate(
+                       std::move(data), static_cast<uint32_t>(kRed2x2PNG.size()), nullptr),
+                   0,
+                   [&completed](std::shared_ptr<ITexture> texture, const Result& result) {
+                     EXPECT_EQ(texture, nullptr);
+                     EXPECT_FALSE(result.isOk());
+                     completed = true;
+                   });
+
+  waitForReadyRequests(streamer, 1u);
+  EXPECT_EQ(streamer.processUploads(*iglDev_, *cmdQueue_), 1u);
+  EXPECT_TRUE(completed);
+  EXPECT_EQ(streamer.getStats().numFailed, 1u);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <IGLU/texture_loader/ThreadPool.h>
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace igl::tests {
+
+using iglu::textureloader::ThreadPool;
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+  ThreadPool pool(3);
+  ASSERT_EQ(pool.numThreads(), 3u);
+
+  constexpr size_t kCount = 100;
+  std::vector<std::atomic<uint32_t>> visits(kCount);
+  std::mutex mutex;
+  std::set<std::thread::id> threadIds;
+  pool.parallelFor(kCount, [&](size_t i) {
+    visits[i]++;
+    const std::lock_guard<std::mutex> guard(mutex);
+    threadIds.insert(std::this_thread::get_id());
+  });
+
+  for (const auto& v : visits) {
+    EXPECT_EQ(v, 1u);
+  }
+  EXPECT_LE(threadIds.size(), pool.numThreads() + 1);
+}
+
+TEST(ThreadPoolTest, WorkerThreadsRunInline) {
+  ThreadPool pool(2);
+
+  // like a TextureStreamer worker which loads a texture
+  std::thread worker([&pool]() {
+    ThreadPool::setIsWorkerThread(true);
+    const auto id = std::this_thread::get_id();
+    std::atomic<uint32_t> numInline = 0;
+    pool.parallelFor(8, [&](size_t /*i*/) {
+      if (std::this_thread::get_id() == id) {
+        numInline++;
+      }
+    });
+    EXPECT_EQ(numInline, 8u);
+  });
+  worker.join();
+  EXPECT_FALSE(ThreadPool::isWorkerThread());
+
+  // nested calls from the workers of the pool itself do not wait for the pool
+  std::atomic<uint32_t> numNested = 0;
+  pool.parallelFor(4, [&](size_t /*i*/) {
+    pool.parallelFor(4, [&](size_t /*j*/) { numNested++; });
+  });
+  EXPECT_EQ(numNested, 16u);
+}
+
+TEST(ThreadPoolTest, SharedPoolIsBounded) {
+  auto& pool = ThreadPool::shared();
+  EXPECT_EQ(&pool, &ThreadPool::shared());
+  EXPECT_LE(pool.numThreads(), 4u);
+  EXPECT_LT(pool.numThreads(), std::max(std::thread::hardware_concurrency(), 2u));
+}
+
+} // namespace igl::tests
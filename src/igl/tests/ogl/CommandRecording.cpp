@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../data/TextureData.h"
+#include "../data/VertexIndexData.h"
+#include "../util/Common.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <igl/CommandBuffer.h>
+#include <igl/NameHandle.h>
+#include <igl/RenderPass.h>
+#include <igl/RenderPipelineState.h>
+#include <igl/SamplerState.h>
+#include <igl/VertexInputState.h>
+#include <igl/opengl/CommandBuffer.h>
+#include <igl/opengl/CommandQueue.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr size_t kTextureUnit = 0;
+
+} // namespace
+
+//
+// CommandRecordingOGLTest
+//
+// Renders a textured quad with the deferred recording mode of opengl::CommandQueue and compares
+// the result with the immediate mode.
+//
+class CommandRecordingOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+    glQueue_ = std::static_pointer_cast<opengl::CommandQueue>(cmdQueue_);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    Result ret;
+    auto offscreenTexture = iglDev_->createTexture(
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kWidth,
+                           kHeight,
+                           TextureDesc::TextureUsageBits::Sampled |
+                               TextureDesc::TextureUsageBits::Attachment),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = offscreenTexture;
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    renderPass_.colorAttachments.resize(1);
+    renderPass_.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass_.colorAttachments[0].storeAction = StoreAction::Store;
+    renderPass_.colorAttachments[0].clearColor = {0.0f, 0.0f, 0.0f, 1.0f};
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    VertexInputStateDesc inputDesc;
+    inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+    inputDesc.attributes[0].offset = 0;
+    inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+    inputDesc.attributes[0].name = data::shader::simplePos;
+    inputDesc.attributes[0].location = 0;
+    inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+    inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+    inputDesc.attributes[1].offset = 0;
+    inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+    inputDesc.attributes[1].name = data::shader::simpleUv;
+    inputDesc.attributes[1].location = 1;
+    inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+    inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    pipelineDesc.shaderStages = std::move(stages);
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = offscreenTexture->getFormat();
+    pipelineDesc.cullMode = CullMode::Disabled;
+    pipelineDesc.fragmentUnitSamplerMap[kTextureUnit] =
+        IGL_NAMEHANDLE(data::shader::simpleSampler);
+    pipelineState_ = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    texture_ = iglDev_->createTexture(
+        TextureDesc::new2D(
+            TextureFormat::RGBA_UNorm8, kWidth, kHeight, TextureDesc::TextureUsageBits::Sampled),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    texture_->upload(TextureRangeDesc::new2D(0, 0, kWidth, kHeight),
+                     data::texture::TEX_RGBA_MISC1_4x4);
+
+    SamplerStateDesc samplerDesc;
+    samplerDesc.minFilter = samplerDesc.magFilter = SamplerMinMagFilter::Nearest;
+    sampler_ = iglDev_->createSamplerState(samplerDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    BufferDesc bufDesc;
+    bufDesc.type = BufferDesc::BufferTypeBits::Index;
+    bufDesc.data = data::vertex_index::QUAD_IND;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_IND);
+    ib_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    bufDesc.type = BufferDesc::BufferTypeBits::Vertex;
+    bufDesc.data = data::vertex_index::QUAD_VERT;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_VERT);
+    vb_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    bufDesc.data = data::vertex_index::QUAD_UV;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_UV);
+    uv_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+  void TearDown() override {
+    if (glQueue_) {
+      glQueue_->setCommandRecordingEnabled(false);
+    }
+  }
+
+  [[nodiscard]] std::shared_ptr<ICommandBuffer> encode() const {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass_, framebuffer_, {}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    encoder->pushDebugGroupLabel("Quad");
+    encoder->bindRenderPipelineState(pipelineState_);
+    encoder->bindViewport({0.0f, 0.0f, float(kWidth), float(kHeight), 0.0f, 1.0f});
+    encoder->bindTexture(kTextureUnit, BindTarget::kFragment, texture_.get());
+    encoder->bindSamplerState(kTextureUnit, BindTarget::kFragment, sampler_.get());
+    encoder->bindVertexBuffer(data::shader::simplePosIndex, *vb_);
+    encoder->bindVertexBuffer(data::shader::simpleUvIndex, *uv_);
+    encoder->bindIndexBuffer(*ib_, IndexFormat::UInt16);
+    encoder->drawIndexed(6);
+    encoder->popDebugGroupLabel();
+    encoder->endEncoding();
+
+    return cmdBuffer;
+  }
+
+  [[nodiscard]] std::vector<uint32_t> readPixels() const {
+    std::vector<uint32_t> pixels(kWidth * kHeight);
+    framebuffer_->copyBytesColorAttachment(
+        *cmdQueue_, 0, pixels.data(), TextureRangeDesc::new2D(0, 0, kWidth, kHeight));
+    return pixels;
+  }
+
+  // clears the framebuffer in the immediate mode, so a pass which was not replayed is detected
+  void clearFramebuffer() const {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass_, framebuffer_, {}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    encoder->endEncoding();
+    cmdQueue_->submit(*cmdBuffer);
+  }
+
+  [[nodiscard]] std::vector<uint32_t> render() const {
+    auto cmdBuffer = encode();
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+    return readPixels();
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<opengl::CommandQueue> glQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  RenderPassDesc renderPass_;
+  std::shared_ptr<IRenderPipelineState> pipelineState_;
+  std::shared_ptr<ITexture> texture_;
+  std::shared_ptr<ISamplerState> sampler_;
+  std::shared_ptr<IBuffer> vb_, uv_, ib_;
+};
+
+TEST_F(CommandRecordingOGLTest, SameResultAsImmediateMode) {
+  const std::vector<uint32_t> expected = render();
+  clearFramebuffer();
+  ASSERT_NE(readPixels(), expected);
+
+  glQueue_->setCommandRecordingEnabled(true);
+  const std::vector<uint32_t> pixels = render();
+
+  for (size_t i = 0; i != pixels.size(); i++) {
+    ASSERT_EQ(pixels[i], expected[i]) << "Pixel mismatch at " << i;
+  }
+}
+
+TEST_F(CommandRecordingOGLTest, NoGLCallsWhileRecording) {
+  glQueue_->setCommandRecordingEnabled(true);
+
+  context_->resetCounters();
+  auto cmdBuffer = encode();
+  EXPECT_EQ(context_->getCallCount(), 0u);
+
+  auto& glCmdBuffer = static_cast<opengl::CommandBuffer&>(*cmdBuffer);
+  ASSERT_TRUE(glCmdBuffer.isRecording());
+  EXPECT_GT(glCmdBuffer.getNumRecordedCommands(), 0u);
+  EXPECT_EQ(cmdBuffer->getCurrentDrawCount(), 0u);
+
+  cmdQueue_->submit(*cmdBuffer);
+
+  EXPECT_GT(context_->getCallCount(), 0u);
+  EXPECT_EQ(glCmdBuffer.getNumRecordedCommands(), 0u);
+  EXPECT_EQ(cmdBuffer->getCurrentDrawCount(), 1u);
+}
+
+TEST_F(CommandRecordingOGLTest, RecordOnAnotherThread) {
+  const std::vector<uint32_t> expected = render();
+  clearFramebuffer();
+  ASSERT_NE(readPixels(), expected);
+
+  glQueue_->setCommandRecordingEnabled(true);
+
+  std::shared_ptr<ICommandBuffer> cmdBuffer;
+  std::thread thread([this, &cmdBuffer]() { cmdBuffer = encode(); });
+  thread.join();
+  ASSERT_TRUE(cmdBuffer != nullptr);
+
+  cmdQueue_->submit(*cmdBuffer);
+  cmdBuffer->waitUntilCompleted();
+
+  const std::vector<uint32_t> pixels = readPixels();
+  for (size_t i = 0; i != pixels.size(); i++) {
+    ASSERT_EQ(pixels[i], expected[i]) << "Pixel mismatch at " << i;
+  }
+}
+
+} // namespace igl::tests
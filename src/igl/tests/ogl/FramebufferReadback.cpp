@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/Common.h"
+
+#include <chrono>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <igl/Framebuffer.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/PixelPackBufferPool.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kFrameWidth = 1280;
+constexpr uint32_t kFrameHeight = 720;
+constexpr size_t kNumFrames = 30;
+// readbacks in flight, as with a readback which completes a few frames later
+constexpr size_t kFramesInFlight = 3;
+
+void fillFrame(uint32_t* pixels, size_t frame) {
+  for (size_t i = 0; i != size_t(kFrameWidth) * kFrameHeight; i++) {
+    pixels[i] = static_cast<uint32_t>(i * 2654435761u + frame) | 0xff000000;
+  }
+}
+
+} // namespace
+
+//
+// FramebufferReadbackOGLTest
+//
+// Reads the color attachment back with IFramebuffer::requestBytesColorAttachment(), checks the
+// pixels against copyBytesColorAttachment() and measures the render thread time per readback.
+//
+class FramebufferReadbackOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    Result ret;
+    texture_ = iglDev_->createTexture(
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kFrameWidth,
+                           kFrameHeight,
+                           TextureDesc::TextureUsageBits::Sampled |
+                               TextureDesc::TextureUsageBits::Attachment),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = texture_;
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    frame_.resize(size_t(kFrameWidth) * kFrameHeight);
+  }
+
+  [[nodiscard]] static TextureRangeDesc getFrameRange() {
+    return TextureRangeDesc::new2D(0, 0, kFrameWidth, kFrameHeight);
+  }
+
+  [[nodiscard]] bool isAsyncSupported() const {
+    return opengl::PixelPackBufferPool::isSupported(*context_);
+  }
+
+  void uploadFrame(size_t frame) {
+    fillFrame(frame_.data(), frame);
+    ASSERT_TRUE(texture_->upload(getFrameRange(), frame_.data()).isOk());
+  }
+
+  void expectFrame(IFramebufferReadback& readback, size_t frame) const {
+    std::vector<uint32_t> expected(frame_.size());
+    fillFrame(expected.data(), frame);
+    std::vector<uint32_t> pixels(frame_.size());
+    ASSERT_TRUE(readback.copyBytes(pixels.data()).isOk());
+    for (size_t i = 0; i != pixels.size(); i++) {
+      ASSERT_EQ(pixels[i], expected[i]) << "Pixel mismatch at " << i;
+    }
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::shared_ptr<ITexture> texture_;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  std::vector<uint32_t> frame_;
+};
+
+TEST_F(FramebufferReadbackOGLTest, SameResultAsCopyBytes) {
+  uploadFrame(0);
+
+  Result ret;
+  auto readback = framebuffer_->requestBytesColorAttachment(*cmdQueue_, 0, getFrameRange(), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(readback != nullptr);
+
+  // later writes to the attachment do not change a requested readback
+  uploadFrame(1);
+  expectFrame(*readback, 0);
+  EXPECT_TRUE(readback->isReady());
+
+  std::vector<uint32_t> pixels(frame_.size());
+  framebuffer_->copyBytesColorAttachment(*cmdQueue_, 0, pixels.data(), getFrameRange());
+  EXPECT_EQ(pixels, frame_);
+}
+
+TEST_F(FramebufferReadbackOGLTest, PaddedRows) {
+  uploadFrame(0);
+  auto readback = framebuffer_->requestBytesColorAttachment(*cmdQueue_, 0, getFrameRange());
+  ASSERT_TRUE(readback != nullptr);
+
+  constexpr size_t kPadding = 16;
+  const size_t bytesPerRow = kFrameWidth * sizeof(uint32_t);
+  std::vector<uint8_t> pixels((bytesPerRow + kPadding) * kFrameHeight, 0xcd);
+  ASSERT_TRUE(readback->copyBytes(pixels.data(), bytesPerRow + kPadding).isOk());
+  for (size_t row = 0; row != kFrameHeight; row++) {
+    const uint8_t* src = pixels.data() + row * (bytesPerRow + kPadding);
+    ASSERT_EQ(memcmp(src, frame_.data() + row * kFrameWidth, bytesPerRow), 0) << "Row " << row;
+    ASSERT_EQ(src[bytesPerRow], 0xcd) << "Padding of row " << row << " was overwritten";
+  }
+
+  EXPECT_FALSE(readback->copyBytes(pixels.data(), bytesPerRow - 4).isOk());
+}
+
+TEST_F(FramebufferReadbackOGLTest, InvalidAttachment) {
+  Result ret;
+  auto readback = framebuffer_->requestBytesColorAttachment(*cmdQueue_, 1, getFrameRange(), &ret);
+  EXPECT_EQ(readback, nullptr);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentInvalid);
+}
+
+TEST_F(FramebufferReadbackOGLTest, ReusesPixelPackBuffers) {
+  if (!isAsyncSupported()) {
+    GTEST_SKIP() << "Pixel pack buffers are not supported";
+  }
+  auto& pool = context_->getPixelPackBufferPool();
+  pool.resetStats();
+
+  std::vector<std::shared_ptr<IFramebufferReadback>> readbacks;
+  for (size_t frame = 0; frame != kNumFrames; frame++) {
+    uploadFrame(frame);
+    readbacks.push_back(
+        framebuffer_->requestBytesColorAttachment(*cmdQueue_, 0, getFrameRange()));
+    ASSERT_TRUE(readbacks.back() != nullptr);
+    if (readbacks.size() > kFramesInFlight) {
+      expectFrame(*readbacks.front(), frame - kFramesInFlight);
+      readbacks.erase(readbacks.begin());
+    }
+  }
+  for (size_t i = 0; i != readbacks.size(); i++) {
+    expectFrame(*readbacks[i], kNumFrames - kFramesInFlight + i);
+  }
+  readbacks.clear();
+
+  // one buffer per readback in flight, then the released ones are reused
+  EXPECT_EQ(pool.getStats().allocations, kFramesInFlight + 1);
+  EXPECT_EQ(pool.getStats().reuses, kNumFrames - kFramesInFlight - 1);
+  EXPECT_EQ(pool.getNumFreeBuffers(), kFramesInFlight + 1);
+}
+
+TEST_F(FramebufferReadbackOGLTest, StreamFrames) {
+  using Clock = std::chrono::steady_clock;
+  std::vector<uint32_t> pixels(frame_.size());
+
+  // blocking reads
+  Clock::duration syncTime{};
+  for (size_t frame = 0; frame != kNumFrames; frame++) {
+    uploadFrame(frame);
+    const auto start = Clock::now();
+    framebuffer_->copyBytesColorAttachment(*cmdQueue_, 0, pixels.data(), getFrameRange());
+    syncTime += Clock::now() - start;
+  }
+
+  if (!isAsyncSupported()) {
+    GTEST_SKIP() << "Pixel pack buffers are not supported";
+  }
+
+  // readbacks requested every frame and copied a few frames later
+  Clock::duration asyncTime{};
+  std::vector<std::shared_ptr<IFramebufferReadback>> readbacks;
+  for (size_t frame = 0; frame != kNumFrames + kFramesInFlight; frame++) {
+    if (frame < kNumFrames) {
+      uploadFrame(frame);
+    }
+    const auto start = Clock::now();
+    if (frame < kNumFrames) {
+      readbacks.push_back(
+          framebuffer_->requestBytesColorAttachment(*cmdQueue_, 0, getFrameRange()));
+    }
+    if (frame >= kFramesInFlight) {
+      ASSERT_TRUE(readbacks.front()->copyBytes(pixels.data()).isOk());
+      readbacks.erase(readbacks.begin());
+    }
+    asyncTime += Clock::now() - start;
+  }
+
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  RecordProperty("SyncReadbackMicroseconds",
+                 std::to_string(Microseconds(syncTime).count() / kNumFrames));
+  RecordProperty("AsyncReadbackMicroseconds",
+                 std::to_string(Microseconds(asyncTime).count() / kNumFrames));
+}
+
+} // namespace igl::tests
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../data/TextureData.h"
+#include "../data/VertexIndexData.h"
+#include "../util/Common.h"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <vector>
+#include <igl/CommandBuffer.h>
+#include <igl/NameHandle.h>
+#include <igl/RenderPass.h>
+#include <igl/RenderPipelineState.h>
+#include <igl/SamplerState.h>
+#include <igl/VertexInputState.h>
+#include <igl/opengl/Buffer.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr size_t kTextureUnit = 0;
+
+// count, instanceCount, firstIndex, baseVertex, baseInstance
+using DrawElementsIndirectCommand = std::array<uint32_t, 5>;
+
+} // namespace
+
+//
+// MultiDrawIndirectOGLTest
+//
+// Renders a quad with one indexed indirect command per triangle and checks that it matches the
+// directly drawn quad on the native, the per-command and the emulated path.
+//
+class MultiDrawIndirectOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    Result ret;
+    auto offscreenTexture = iglDev_->createTexture(
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kWidth,
+                           kHeight,
+                           TextureDesc::TextureUsageBits::Sampled |
+                               TextureDesc::TextureUsageBits::Attachment),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = offscreenTexture;
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    renderPass_.colorAttachments.resize(1);
+    renderPass_.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass_.colorAttachments[0].storeAction = StoreAction::Store;
+    renderPass_.colorAttachments[0].clearColor = {0.0f, 0.0f, 0.0f, 1.0f};
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    VertexInputStateDesc inputDesc;
+    inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+    inputDesc.attributes[0].offset = 0;
+    inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+    inputDesc.attributes[0].name = data::shader::simplePos;
+    inputDesc.attributes[0].location = 0;
+    inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+    inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+    inputDesc.attributes[1].offset = 0;
+    inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+    inputDesc.attributes[1].name = data::shader::simpleUv;
+    inputDesc.attributes[1].location = 1;
+    inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+    inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    pipelineDesc.shaderStages = std::move(stages);
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = offscreenTexture->getFormat();
+    pipelineDesc.cullMode = CullMode::Disabled;
+    pipelineDesc.fragmentUnitSamplerMap[kTextureUnit] =
+        IGL_NAMEHANDLE(data::shader::simpleSampler);
+    pipelineState_ = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    texture_ = iglDev_->createTexture(
+        TextureDesc::new2D(
+            TextureFormat::RGBA_UNorm8, kWidth, kHeight, TextureDesc::TextureUsageBits::Sampled),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    texture_->upload(TextureRangeDesc::new2D(0, 0, kWidth, kHeight),
+                     data::texture::TEX_RGBA_MISC1_4x4);
+
+    SamplerStateDesc samplerDesc;
+    samplerDesc.minFilter = samplerDesc.magFilter = SamplerMinMagFilter::Nearest;
+    sampler_ = iglDev_->createSamplerState(samplerDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    BufferDesc bufDesc;
+    bufDesc.type = BufferDesc::BufferTypeBits::Index;
+    bufDesc.data = data::vertex_index::QUAD_IND;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_IND);
+    ib_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    bufDesc.type = BufferDesc::BufferTypeBits::Vertex;
+    bufDesc.data = data::vertex_index::QUAD_VERT;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_VERT);
+    vb_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    bufDesc.data = data::vertex_index::QUAD_UV;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_UV);
+    uv_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+  [[nodiscard]] std::shared_ptr<IBuffer> createIndirectBuffer(
+      const std::vector<DrawElementsIndirectCommand>& commands) const {
+    BufferDesc bufDesc(BufferDesc::BufferTypeBits::Indirect,
+                       commands.data(),
+                       commands.size() * sizeof(DrawElementsIndirectCommand),
+                       ResourceStorage::Shared);
+    Result ret;
+    auto buffer = iglDev_->createBuffer(bufDesc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    return buffer;
+  }
+
+  // renders the quad, with the commands of `indirectBuffer` if it is not null, and returns the
+  // number of GL draw calls
+  unsigned int render(IBuffer* indirectBuffer = nullptr, uint32_t drawCount = 0) const {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass_, framebuffer_, {}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    encoder->bindRenderPipelineState(pipelineState_);
+    encoder->bindTexture(kTextureUnit, BindTarget::kFragment, texture_.get());
+    encoder->bindSamplerState(kTextureUnit, BindTarget::kFragment, sampler_.get());
+    encoder->bindVertexBuffer(data::shader::simplePosIndex, *vb_);
+    encoder->bindVertexBuffer(data::shader::simpleUvIndex, *uv_);
+    encoder->bindIndexBuffer(*ib_, IndexFormat::UInt16);
+    const unsigned int drawCountBefore = context_->getCurrentDrawCount();
+    if (indirectBuffer) {
+      encoder->multiDrawIndexedIndirect(*indirectBuffer, 0, drawCount, 0);
+    } else {
+      encoder->drawIndexed(6);
+    }
+    const unsigned int numDraws = context_->getCurrentDrawCount() - drawCountBefore;
+    encoder->endEncoding();
+
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+    return numDraws;
+  }
+
+  [[nodiscard]] std::vector<uint32_t> readPixels() const {
+    std::vector<uint32_t> pixels(kWidth * kHeight);
+    framebuffer_->copyBytesColorAttachment(
+        *cmdQueue_, 0, pixels.data(), TextureRangeDesc::new2D(0, 0, kWidth, kHeight));
+    return pixels;
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  RenderPassDesc renderPass_;
+  std::shared_ptr<IRenderPipelineState> pipelineState_;
+  std::shared_ptr<ITexture> texture_;
+  std::shared_ptr<ISamplerState> sampler_;
+  std::shared_ptr<IBuffer> vb_, uv_, ib_;
+};
+
+TEST_F(MultiDrawIndirectOGLTest, SameResultAsDrawIndexed) {
+  render();
+  const std::vector<uint32_t> expected = readPixels();
+
+  // one command per triangle, with an empty command in between
+  const std::vector<DrawElementsIndirectCommand> commands = {
+      {3, 1, 0, 0, 0},
+      {0, 1, 0, 0, 0},
+      {3, 1, 3, 0, 0},
+  };
+  auto indirectBuffer = createIndirectBuffer(commands);
+  ASSERT_TRUE(indirectBuffer != nullptr);
+  const unsigned int numDraws =
+      render(indirectBuffer.get(), static_cast<uint32_t>(commands.size()));
+
+  const auto& features = context_->deviceFeatures();
+  if (features.hasInternalFeature(opengl::InternalFeatures::MultiDrawIndirect)) {
+    EXPECT_EQ(numDraws, 1u);
+  } else if (features.hasInternalFeature(opengl::InternalFeatures::DrawArraysIndirect)) {
+    EXPECT_EQ(numDraws, commands.size());
+  } else {
+    // the emulation skips the empty command
+    EXPECT_EQ(numDraws, 2u);
+  }
+
+  const std::vector<uint32_t> pixels = readPixels();
+  for (size_t i = 0; i != pixels.size(); i++) {
+    ASSERT_EQ(pixels[i], expected[i]) << "Pixel mismatch at " << i;
+  }
+}
+
+TEST_F(MultiDrawIndirectOGLTest, EmulationValidatesCommands) {
+  const std::vector<DrawElementsIndirectCommand> commands = {
+      {3, 1, 0, 0, 0},
+      // reads beyond the index buffer
+      {3, 1, 6, 0, 0},
+  };
+  auto indirectBuffer = createIndirectBuffer(commands);
+  ASSERT_TRUE(indirectBuffer != nullptr);
+  const auto& glBuffer = static_cast<const opengl::ArrayBuffer&>(*indirectBuffer);
+  if (glBuffer.getIndirectCommands() == nullptr) {
+    GTEST_SKIP() << "Indirect draws are supported";
+  }
+
+  EXPECT_EQ(render(indirectBuffer.get(), static_cast<uint32_t>(commands.size())), 1u);
+
+  // uploads reach the commands which are read on the CPU
+  const DrawElementsIndirectCommand command = {3, 1, 3, 0, 0};
+  const BufferRange range(sizeof(command), sizeof(command));
+  ASSERT_TRUE(indirectBuffer->upload(&command, range).isOk());
+  EXPECT_EQ(render(indirectBuffer.get(), static_cast<uint32_t>(commands.size())), 2u);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <igl/ShaderCreator.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/RenderPipelineState.h>
+#include <igl/opengl/Shader.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr size_t kNumPipelines = 32;
+
+} // namespace
+
+//
+// ParallelShaderCompileOGLTest
+//
+// Creates many render pipelines with deferred shader compilation, polls them until they are ready
+// and measures the render thread time per pipeline with and without deferral.
+//
+class ParallelShaderCompileOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    const auto backendVersion = iglDev_->getBackendVersion();
+    const bool isGles3 = backendVersion.flavor == BackendFlavor::OpenGL_ES &&
+                         backendVersion.majorVersion >= 3;
+    vertexSource_ = isGles3 ? data::shader::OGL_SIMPLE_VERT_SHADER_ES3
+                            : data::shader::OGL_SIMPLE_VERT_SHADER;
+    fragmentSource_ = isGles3 ? data::shader::OGL_SIMPLE_FRAG_SHADER_ES3
+                              : data::shader::OGL_SIMPLE_FRAG_SHADER;
+  }
+
+  void TearDown() override {
+    if (context_) {
+      context_->setParallelShaderCompileEnabled(false);
+    }
+  }
+
+  // Each variant has a different source, so the driver cannot reuse a previous compilation
+  [[nodiscard]] std::shared_ptr<IRenderPipelineState> createPipeline(size_t variant,
+                                                                     Result* outResult) const {
+    const std::string suffix = "\n// variant " + std::to_string(variant) + "\n";
+    const std::string vertexSource = vertexSource_ + suffix;
+    const std::string fragmentSource = fragmentSource_ + suffix;
+    return createPipeline(vertexSource.c_str(), fragmentSource.c_str(), outResult);
+  }
+
+  [[nodiscard]] std::shared_ptr<IRenderPipelineState> createPipeline(const char* vertexSource,
+                                                                     const char* fragmentSource,
+                                                                     Result* outResult) const {
+    std::shared_ptr<IShaderStages> stages = ShaderStagesCreator::fromModuleStringInput(
+        *iglDev_, vertexSource, "main", "", fragmentSource, "main", "", outResult);
+    if (!stages) {
+      return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.shaderStages = std::move(stages);
+    desc.targetDesc.colorAttachments.resize(1);
+    desc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+    desc.fragmentUnitSamplerMap[0] = IGL_NAMEHANDLE("inputImage");
+    return iglDev_->createRenderPipeline(desc, outResult);
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::string vertexSource_;
+  std::string fragmentSource_;
+};
+
+TEST_F(ParallelShaderCompileOGLTest, PipelinesBecomeReady) {
+  using Clock = std::chrono::steady_clock;
+
+  Clock::duration syncTime{};
+  for (size_t i = 0; i != kNumPipelines; i++) {
+    Result ret;
+    const auto start = Clock::now();
+    auto pipeline = createPipeline(i, &ret);
+    syncTime += Clock::now() - start;
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    EXPECT_TRUE(pipeline->isReady());
+  }
+
+  context_->setParallelShaderCompileEnabled(true);
+  std::vector<std::shared_ptr<IRenderPipelineState>> pipelines;
+  const auto start = Clock::now();
+  for (size_t i = 0; i != kNumPipelines; i++) {
+    Result ret;
+    // different variants than above
+    pipelines.push_back(createPipeline(kNumPipelines + i, &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+  const auto deferredTime = Clock::now() - start;
+
+  // poll like a loading screen would, a frame at a time
+  size_t numPolls = 0;
+  const auto deadline = Clock::now() + std::chrono::seconds(10);
+  for (bool allReady = false; !allReady && Clock::now() < deadline; numPolls++) {
+    allReady = true;
+    for (const auto& pipeline : pipelines) {
+      allReady = allReady && pipeline->isReady();
+    }
+    if (!allReady) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  for (const auto& pipeline : pipelines) {
+    auto& glPipeline = static_cast<opengl::RenderPipelineState&>(*pipeline);
+    const Result ret = glPipeline.waitUntilReady();
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    EXPECT_TRUE(glPipeline.isReady());
+    EXPECT_NE(glPipeline.getShaderStages()->getProgramID(), 0u);
+    EXPECT_GE(glPipeline.getIndexByName(IGL_NAMEHANDLE("inputImage"), ShaderStage::Fragment), 0);
+  }
+
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  RecordProperty("SyncCreateMicroseconds",
+                 std::to_string(Microseconds(syncTime).count() / kNumPipelines));
+  RecordProperty("DeferredCreateMicroseconds",
+                 std::to_string(Microseconds(deferredTime).count() / kNumPipelines));
+  RecordProperty("Polls", static_cast<int>(numPolls));
+  RecordProperty(
+      "ParallelShaderCompile",
+      context_->deviceFeatures().hasInternalFeature(opengl::InternalFeatures::ParallelShaderCompile)
+          ? 1
+          : 0);
+}
+
+TEST_F(ParallelShaderCompileOGLTest, NameQueriesWaitForLink) {
+  context_->setParallelShaderCompileEnabled(true);
+  Result ret;
+  auto pipeline = createPipeline(0, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  // without calling waitUntilReady() first
+  EXPECT_GE(pipeline->getIndexByName(IGL_NAMEHANDLE("inputImage"), ShaderStage::Fragment), 0);
+  EXPECT_TRUE(pipeline->isReady());
+}
+
+TEST_F(ParallelShaderCompileOGLTest, CompileErrorReportedWhenReady) {
+  const char* brokenFragmentSource = "void main() { not a shader }";
+
+  // without deferral the error is returned right away
+  Result ret;
+  EXPECT_EQ(createPipeline(vertexSource_.c_str(), brokenFragmentSource, &ret), nullptr);
+  EXPECT_FALSE(ret.isOk());
+
+  context_->setParallelShaderCompileEnabled(true);
+  auto pipeline = createPipeline(vertexSource_.c_str(), brokenFragmentSource, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(pipeline != nullptr);
+
+  auto& glPipeline = static_cast<opengl::RenderPipelineState&>(*pipeline);
+  ret = glPipeline.waitUntilReady();
+  EXPECT_EQ(ret.code, Result::Code::ArgumentInvalid);
+  EXPECT_FALSE(ret.message.empty());
+  EXPECT_EQ(glPipeline.getShaderStages()->getProgramID(), 0u);
+
+  // the result is kept
+  EXPECT_EQ(glPipeline.waitUntilReady().code, Result::Code::ArgumentInvalid);
+}
+
+} // namespace igl::tests
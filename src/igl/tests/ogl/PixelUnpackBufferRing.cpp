@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/Common.h"
+
+#include <chrono>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <igl/Framebuffer.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/PixelUnpackBufferRing.h>
+#include <igl/opengl/TextureBuffer.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kFrameWidth = 1280;
+constexpr uint32_t kFrameHeight = 720;
+constexpr size_t kNumFrames = 30;
+
+void fillFrame(uint32_t* pixels, size_t frame) {
+  for (size_t i = 0; i != size_t(kFrameWidth) * kFrameHeight; i++) {
+    pixels[i] = static_cast<uint32_t>(i * 2654435761u + frame) | 0xff000000;
+  }
+}
+
+} // namespace
+
+//
+// PixelUnpackBufferRingOGLTest
+//
+// Streams video-sized RGBA frames through the pixel unpack buffer ring of IContext, checks the
+// uploaded pixels and measures the render thread time per upload.
+//
+class PixelUnpackBufferRingOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    Result ret;
+    texture_ = iglDev_->createTexture(
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kFrameWidth,
+                           kFrameHeight,
+                           TextureDesc::TextureUsageBits::Sampled |
+                               TextureDesc::TextureUsageBits::Attachment),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = texture_;
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    frame_.resize(size_t(kFrameWidth) * kFrameHeight);
+  }
+
+  void TearDown() override {
+    if (context_) {
+      context_->setPixelUnpackBufferRingEnabled(false);
+    }
+  }
+
+  // returns false when the context does not support pixel unpack buffers
+  [[nodiscard]] bool enableRing() const {
+    context_->setPixelUnpackBufferRingEnabled(true);
+    return context_->getPixelUnpackBufferRing() != nullptr;
+  }
+
+  [[nodiscard]] const opengl::TextureBuffer& getTextureBuffer() const {
+    return static_cast<const opengl::TextureBuffer&>(*texture_);
+  }
+
+  [[nodiscard]] static TextureRangeDesc getFrameRange() {
+    return TextureRangeDesc::new2D(0, 0, kFrameWidth, kFrameHeight);
+  }
+
+  void expectFrame() const {
+    std::vector<uint32_t> pixels(frame_.size());
+    framebuffer_->copyBytesColorAttachment(*cmdQueue_, 0, pixels.data(), getFrameRange());
+    for (size_t i = 0; i != pixels.size(); i++) {
+      ASSERT_EQ(pixels[i], frame_[i]) << "Pixel mismatch at " << i;
+    }
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::shared_ptr<ITexture> texture_;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  std::vector<uint32_t> frame_;
+};
+
+TEST_F(PixelUnpackBufferRingOGLTest, StagedUpload) {
+  if (!enableRing()) {
+    GTEST_SKIP() << "Pixel unpack buffers are not supported";
+  }
+  fillFrame(frame_.data(), 0);
+  ASSERT_TRUE(texture_->upload(getFrameRange(), frame_.data()).isOk());
+
+  const auto& stats = context_->getPixelUnpackBufferRing()->getStats();
+  EXPECT_EQ(stats.allocations, 1u);
+  EXPECT_EQ(stats.bytes, frame_.size() * sizeof(uint32_t));
+  expectFrame();
+}
+
+TEST_F(PixelUnpackBufferRingOGLTest, AllocationTooLarge) {
+  context_->setPixelUnpackBufferRingEnabled(true, 1024 * 1024);
+  auto* ring = context_->getPixelUnpackBufferRing();
+  if (!ring) {
+    GTEST_SKIP() << "Pixel unpack buffers are not supported";
+  }
+  EXPECT_FALSE(ring->allocate(*context_, 2 * 1024 * 1024).isValid());
+  EXPECT_EQ(ring->getStats().failures, 1u);
+
+  // the upload falls back to client memory
+  fillFrame(frame_.data(), 0);
+  ASSERT_TRUE(texture_->upload(getFrameRange(), frame_.data()).isOk());
+  expectFrame();
+}
+
+TEST_F(PixelUnpackBufferRingOGLTest, StreamFrames) {
+  using Clock = std::chrono::steady_clock;
+
+  // uploads from client memory
+  Clock::duration syncTime{};
+  for (size_t frame = 0; frame != kNumFrames; frame++) {
+    fillFrame(frame_.data(), frame);
+    const auto start = Clock::now();
+    ASSERT_TRUE(texture_->upload(getFrameRange(), frame_.data()).isOk());
+    syncTime += Clock::now() - start;
+  }
+  expectFrame();
+
+  if (!enableRing()) {
+    GTEST_SKIP() << "Pixel unpack buffers are not supported";
+  }
+  auto* ring = context_->getPixelUnpackBufferRing();
+
+  // the pixels are written on another thread, the render thread only issues the uploads
+  Clock::duration asyncTime{};
+  for (size_t frame = 0; frame != kNumFrames; frame++) {
+    fillFrame(frame_.data(), frame);
+    const size_t length = frame_.size() * sizeof(uint32_t);
+
+    auto start = Clock::now();
+    const auto allocation = ring->allocate(*context_, length);
+    asyncTime += Clock::now() - start;
+    ASSERT_TRUE(allocation.isValid());
+
+    std::thread writer([&]() { memcpy(allocation.data, frame_.data(), length); });
+    writer.join();
+
+    start = Clock::now();
+    ASSERT_TRUE(getTextureBuffer().uploadFromUnpackBuffer(getFrameRange(), allocation).isOk());
+    asyncTime += Clock::now() - start;
+  }
+  expectFrame();
+
+  using Microseconds = std::chrono::duration<double, std::micro>;
+  RecordProperty("SyncUploadMicroseconds",
+                 std::to_string(Microseconds(syncTime).count() / kNumFrames));
+  RecordProperty("AsyncUploadMicroseconds",
+                 std::to_string(Microseconds(asyncTime).count() / kNumFrames));
+  RecordProperty("Waits", static_cast<int>(ring->getStats().waits));
+  RecordProperty("Persistent", ring->isPersistent() ? 1 : 0);
+
+  EXPECT_EQ(ring->getStats().allocations, kNumFrames);
+  EXPECT_EQ(ring->getStats().failures, 0u);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <unordered_map>
+#include <vector>
+#include <igl/ShaderCreator.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/ProgramBinaryCache.h>
+#include <igl/opengl/Shader.h>
+
+namespace igl::tests {
+
+namespace {
+
+// Storage which can corrupt its blobs, to check that the cache falls back to linking from source
+class TestProgramBinaryStorage final : public opengl::IProgramBinaryStorage {
+ public:
+  bool load(uint64_t key, std::vector<uint8_t>& outData) override {
+    auto it = blobs.find(key);
+    if (it == blobs.end()) {
+      return false;
+    }
+    outData = it->second;
+    return true;
+  }
+  void store(uint64_t key, const void* data, size_t length) override {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    blobs[key].assign(bytes, bytes + length);
+  }
+  void remove(uint64_t key) override {
+    blobs.erase(key);
+  }
+
+  void corrupt() {
+    for (auto& it : blobs) {
+      it.second[0] ^= 0xff;
+    }
+  }
+
+  std::unordered_map<uint64_t, std::vector<uint8_t>> blobs;
+};
+
+} // namespace
+
+//
+// ProgramBinaryCacheOGLTest
+//
+// Creates the same shader stages several times with the program binary cache of IContext and
+// checks that the second program comes from the cache.
+//
+class ProgramBinaryCacheOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+  }
+
+  void TearDown() override {
+    if (context_) {
+      context_->setProgramBinaryStorage(nullptr);
+    }
+  }
+
+  // returns false when the context does not support program binaries
+  [[nodiscard]] bool enableCache(std::shared_ptr<opengl::IProgramBinaryStorage> storage) const {
+    context_->setProgramBinaryStorage(std::move(storage));
+    return context_->getProgramBinaryCache() != nullptr;
+  }
+
+  void createStages(std::unique_ptr<IShaderStages>& stages) const {
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+    auto& glStages = static_cast<opengl::ShaderStages&>(*stages);
+    ASSERT_NE(glStages.getProgramID(), 0u);
+    ASSERT_TRUE(glStages.validate().isOk());
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+};
+
+TEST_F(ProgramBinaryCacheOGLTest, HitAfterMiss) {
+  auto storage = std::make_shared<opengl::MemoryProgramBinaryStorage>();
+  if (!enableCache(storage)) {
+    GTEST_SKIP() << "Program binaries are not supported";
+  }
+  const auto& stats = context_->getProgramBinaryCache()->getStats();
+
+  std::unique_ptr<IShaderStages> stages;
+  createStages(stages);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(storage->size(), 1u);
+
+  std::unique_ptr<IShaderStages> cachedStages;
+  createStages(cachedStages);
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.rejected, 0u);
+
+  // the shaders of a cached program are never compiled
+  auto shaderID = [](const std::shared_ptr<IShaderModule>& module) {
+    return static_cast<opengl::ShaderModule&>(*module).getShaderID();
+  };
+  EXPECT_NE(shaderID(stages->getVertexModule()), 0u);
+  EXPECT_NE(shaderID(stages->getFragmentModule()), 0u);
+  EXPECT_EQ(shaderID(cachedStages->getVertexModule()), 0u);
+  EXPECT_EQ(shaderID(cachedStages->getFragmentModule()), 0u);
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, CompileErrorOnMiss) {
+  if (!enableCache(std::make_shared<opengl::MemoryProgramBinaryStorage>())) {
+    GTEST_SKIP() << "Program binaries are not supported";
+  }
+
+  // the module compiles when the stages are created, which report the error
+  Result ret;
+  auto stages = ShaderStagesCreator::fromModuleStringInput(*iglDev_,
+                                                           data::shader::OGL_SIMPLE_VERT_SHADER,
+                                                           data::shader::simpleVertFunc,
+                                                           "",
+                                                           "void main() { not a shader }",
+                                                           "main",
+                                                           "",
+                                                           &ret);
+  EXPECT_EQ(stages, nullptr);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentInvalid);
+  EXPECT_EQ(context_->getProgramBinaryCache()->getStats().misses, 1u);
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, FallbackOnCorruptBlob) {
+  auto storage = std::make_shared<TestProgramBinaryStorage>();
+  if (!enableCache(storage)) {
+    GTEST_SKIP() << "Program binaries are not supported";
+  }
+  const auto& stats = context_->getProgramBinaryCache()->getStats();
+
+  std::unique_ptr<IShaderStages> stages;
+  createStages(stages);
+  ASSERT_EQ(storage->blobs.size(), 1u);
+  storage->corrupt();
+
+  // the blob is rejected and replaced with a new one
+  std::unique_ptr<IShaderStages> linkedStages;
+  createStages(linkedStages);
+  EXPECT_EQ(stats.rejected, 1u);
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(storage->blobs.size(), 1u);
+
+  std::unique_ptr<IShaderStages> cachedStages;
+  createStages(cachedStages);
+  EXPECT_EQ(stats.hits, 1u);
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, DirectoryStorage) {
+  const std::filesystem::path path =
+      std::filesystem::temp_directory_path() / "igl_program_binaries";
+  std::error_code ec;
+  std::filesystem::remove_all(path, ec);
+  ASSERT_TRUE(std::filesystem::create_directories(path, ec));
+
+  const uint8_t data[] = {1, 2, 3, 4, 5};
+  std::vector<uint8_t> loaded;
+  {
+    opengl::DirectoryProgramBinaryStorage storage(path.string());
+    EXPECT_FALSE(storage.load(42, loaded));
+    storage.store(42, data, sizeof(data));
+  }
+  {
+    // another instance sees the blob, like the next launch of the app
+    opengl::DirectoryProgramBinaryStorage storage(path.string());
+    ASSERT_TRUE(storage.load(42, loaded));
+    EXPECT_EQ(loaded, std::vector<uint8_t>(data, data + sizeof(data)));
+    storage.remove(42);
+    EXPECT_FALSE(storage.load(42, loaded));
+  }
+
+  std::filesystem::remove_all(path, ec);
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, ShaderModuleHash) {
+  const ShaderCompilerOptions options;
+  const uint64_t hash =
+      opengl::ProgramBinaryCache::hashShaderModule(ShaderStage::Vertex, "void main() {}", options);
+  EXPECT_EQ(hash,
+            opengl::ProgramBinaryCache::hashShaderModule(
+                ShaderStage::Vertex, "void main() {}", options));
+  EXPECT_NE(hash,
+            opengl::ProgramBinaryCache::hashShaderModule(
+                ShaderStage::Fragment, "void main() {}", options));
+  EXPECT_NE(hash,
+            opengl::ProgramBinaryCache::hashShaderModule(
+                ShaderStage::Vertex, "void main() { }", options));
+}
+
+} // namespace igl::tests
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../util/TestDevice.h"
+
+#include <gtest/gtest.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/StateCache.h>
+
+namespace igl::tests {
+
+using CallType = opengl::StateCache::CallType;
+
+//
+// StateCacheOGLTest
+//
+// Checks that IContext elides redundant calls when the state cache is enabled, and that the GL
+// state is still correct.
+//
+class StateCacheOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    device_ = util::createTestDevice();
+    ASSERT_TRUE(device_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*device_).getContext();
+    ASSERT_TRUE(context_ != nullptr);
+
+    context_->setStateCacheEnabled(true);
+    context_->resetStateCacheStats();
+  }
+
+  void TearDown() override {
+    context_->setStateCacheEnabled(false);
+  }
+
+ protected:
+  opengl::IContext* context_{};
+  std::shared_ptr<IDevice> device_;
+};
+
+TEST_F(StateCacheOGLTest, Disabled) {
+  context_->setStateCacheEnabled(false);
+  ASSERT_FALSE(context_->isStateCacheEnabled());
+
+  context_->resetCounters();
+  context_->depthFunc(GL_LESS);
+  context_->depthFunc(GL_LESS);
+  EXPECT_EQ(context_->getCallCount(), 2u);
+  EXPECT_EQ(context_->getStateCacheStats().getTotalIssued(), 0u);
+}
+
+TEST_F(StateCacheOGLTest, ElideRedundantCalls) {
+  context_->resetCounters();
+
+  for (int i = 0; i != 4; i++) {
+    context_->enable(GL_BLEND);
+    context_->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    context_->depthFunc(GL_LEQUAL);
+    context_->colorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_FALSE);
+    context_->viewport(0, 0, 16, 16);
+  }
+
+  const auto stats = context_->getStateCacheStats();
+
+  RecordProperty("Issued", static_cast<int>(stats.getTotalIssued()));
+  RecordProperty("Elided", static_cast<int>(stats.getTotalElided()));
+
+  EXPECT_EQ(stats.getIssued(CallType::Capability), 1u);
+  EXPECT_EQ(stats.getElided(CallType::Capability), 3u);
+  EXPECT_EQ(stats.getIssued(CallType::BlendFunc), 1u);
+  EXPECT_EQ(stats.getElided(CallType::BlendFunc), 3u);
+  EXPECT_EQ(stats.getTotalIssued(), 5u);
+  EXPECT_EQ(stats.getTotalElided(), 15u);
+  EXPECT_EQ(context_->getCallCount(), 5u);
+
+  // the state is set
+  EXPECT_TRUE(context_->isEnabled(GL_BLEND));
+  GLint value = 0;
+  context_->getIntegerv(GL_DEPTH_FUNC, &value);
+  EXPECT_EQ(value, GL_LEQUAL);
+  GLint viewport[4] = {};
+  context_->getIntegerv(GL_VIEWPORT, viewport);
+  EXPECT_EQ(viewport[2], 16);
+  EXPECT_EQ(viewport[3], 16);
+
+  // a different value is issued
+  context_->disable(GL_BLEND);
+  EXPECT_FALSE(context_->isEnabled(GL_BLEND));
+  context_->setEnabled(false, GL_BLEND);
+  EXPECT_EQ(context_->getStateCacheStats().getElided(CallType::Capability), 4u);
+}
+
+TEST_F(StateCacheOGLTest, EquivalentCalls) {
+  context_->blendFuncSeparate(GL_ONE, GL_ZERO, GL_ONE, GL_ZERO);
+  context_->blendFunc(GL_ONE, GL_ZERO);
+  context_->stencilMaskSeparate(GL_FRONT, 0xff);
+  context_->stencilMaskSeparate(GL_BACK, 0xff);
+  context_->stencilMask(0xff);
+
+  const auto stats = context_->getStateCacheStats();
+
+  EXPECT_EQ(stats.getElided(CallType::BlendFunc), 1u);
+  EXPECT_EQ(stats.getIssued(CallType::StencilMask), 2u);
+  EXPECT_EQ(stats.getElided(CallType::StencilMask), 1u);
+}
+
+TEST_F(StateCacheOGLTest, TextureUnits) {
+  GLuint textures[2] = {};
+  context_->genTextures(2, textures);
+
+  context_->activeTexture(GL_TEXTURE0);
+  context_->bindTexture(GL_TEXTURE_2D, textures[0]);
+  context_->activeTexture(GL_TEXTURE1);
+  context_->bindTexture(GL_TEXTURE_2D, textures[1]);
+  context_->activeTexture(GL_TEXTURE0);
+  context_->bindTexture(GL_TEXTURE_2D, textures[0]);
+
+  auto stats = context_->getStateCacheStats();
+  EXPECT_EQ(stats.getIssued(CallType::BindTexture), 2u);
+  EXPECT_EQ(stats.getElided(CallType::BindTexture), 1u);
+
+  GLint binding = 0;
+  context_->getIntegerv(GL_TEXTURE_BINDING_2D, &binding);
+  EXPECT_EQ(static_cast<GLuint>(binding), textures[0]);
+
+  // deleted textures are unbound by GL
+  context_->deleteTextures({textures[0], textures[1]});
+  context_->bindTexture(GL_TEXTURE_2D, 0);
+  stats = context_->getStateCacheStats();
+  EXPECT_EQ(stats.getIssued(CallType::BindTexture), 3u);
+}
+
+TEST_F(StateCacheOGLTest, DeletedBuffers) {
+  GLuint buffer = 0;
+  context_->genBuffers(1, &buffer);
+
+  context_->bindBuffer(GL_ARRAY_BUFFER, buffer);
+  context_->bindBuffer(GL_ARRAY_BUFFER, buffer);
+  EXPECT_EQ(context_->getStateCacheStats().getElided(CallType::BindBuffer), 1u);
+
+  context_->deleteBuffers(1, &buffer);
+
+  // the name can be reused, so the next binding must be issued
+  GLuint newBuffer = 0;
+  context_->genBuffers(1, &newBuffer);
+  context_->bindBuffer(GL_ARRAY_BUFFER, newBuffer);
+  EXPECT_EQ(context_->getStateCacheStats().getIssued(CallType::BindBuffer), 2u);
+
+  GLint binding = 0;
+  context_->getIntegerv(GL_ARRAY_BUFFER_BINDING, &binding);
+  EXPECT_EQ(static_cast<GLuint>(binding), newBuffer);
+
+  context_->bindBuffer(GL_ARRAY_BUFFER, 0);
+  context_->deleteBuffers(1, &newBuffer);
+}
+
+TEST_F(StateCacheOGLTest, Invalidate) {
+  context_->depthFunc(GL_GREATER);
+
+  // some external code changes the state behind IContext's back
+  context_->invalidateStateCache();
+  context_->depthFunc(GL_GREATER);
+
+  auto stats = context_->getStateCacheStats();
+  EXPECT_EQ(stats.getIssued(CallType::DepthFunc), 2u);
+  EXPECT_EQ(stats.getElided(CallType::DepthFunc), 0u);
+
+  // the outermost scope forgets the state
+  {
+    const DeviceScope scope(*device_);
+    context_->depthFunc(GL_GREATER);
+  }
+  stats = context_->getStateCacheStats();
+  EXPECT_EQ(stats.getIssued(CallType::DepthFunc), 3u);
+
+  context_->depthFunc(GL_LESS);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../data/TextureData.h"
+#include "../data/VertexIndexData.h"
+#include "../util/Common.h"
+
+#include <chrono>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <igl/CommandBuffer.h>
+#include <igl/NameHandle.h>
+#include <igl/RenderPass.h>
+#include <igl/RenderPipelineState.h>
+#include <igl/SamplerState.h>
+#include <igl/VertexInputState.h>
+#include <igl/opengl/Buffer.h>
+#include <igl/opengl/Device.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr size_t kBufferSize = 64 * 1024;
+constexpr size_t kNumFrames = 100;
+constexpr size_t kNumDrawsPerFrame = 3;
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr size_t kTextureUnit = 0;
+
+} // namespace
+
+//
+// StreamingBufferOGLTest
+//
+// Creates buffers with BufferDesc::BufferAPIHintBits::Streaming, checks that uploads and maps move
+// to the next slot once the current one is used by the GPU, that draws see the contents written
+// through map(), and measures the upload time per frame.
+//
+class StreamingBufferOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+
+    data_.resize(kBufferSize);
+    for (size_t i = 0; i != data_.size(); i++) {
+      data_[i] = static_cast<uint8_t>(i * 7);
+    }
+  }
+
+  std::shared_ptr<IBuffer> createBuffer(BufferDesc::BufferTypeBits type,
+                                        BufferDesc::BufferAPIHint hint,
+                                        ResourceStorage storage = ResourceStorage::Shared) const {
+    BufferDesc desc(type, data_.data(), data_.size(), storage, hint);
+    Result ret;
+    auto buffer = iglDev_->createBuffer(desc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    return buffer;
+  }
+
+  void expectContents(IBuffer& buffer) const {
+    Result ret;
+    const auto* contents =
+        static_cast<const uint8_t*>(buffer.map(BufferRange(data_.size(), 0), &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    ASSERT_TRUE(contents != nullptr);
+    EXPECT_EQ(memcmp(contents, data_.data(), data_.size()), 0);
+    buffer.unmap();
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::vector<uint8_t> data_;
+};
+
+TEST_F(StreamingBufferOGLTest, HintAccepted) {
+  auto buffer =
+      createBuffer(BufferDesc::BufferTypeBits::Vertex, BufferDesc::BufferAPIHintBits::Streaming);
+  ASSERT_TRUE(buffer != nullptr);
+  auto& glBuffer = static_cast<opengl::ArrayBuffer&>(*buffer);
+  if (!glBuffer.isStreaming()) {
+    GTEST_SKIP() << "Buffer storage is not supported";
+  }
+  EXPECT_TRUE(buffer->acceptedApiHints() & BufferDesc::BufferAPIHintBits::Streaming);
+  expectContents(*buffer);
+
+  // static buffers are never streamed
+  auto staticBuffer = createBuffer(BufferDesc::BufferTypeBits::Vertex,
+                                   BufferDesc::BufferAPIHintBits::Streaming,
+                                   ResourceStorage::Private);
+  ASSERT_TRUE(staticBuffer != nullptr);
+  EXPECT_FALSE(static_cast<opengl::ArrayBuffer&>(*staticBuffer).isStreaming());
+  EXPECT_EQ(staticBuffer->acceptedApiHints(), 0);
+}
+
+TEST_F(StreamingBufferOGLTest, SlotSwitch) {
+  auto buffer =
+      createBuffer(BufferDesc::BufferTypeBits::Uniform,
+                   BufferDesc::BufferAPIHintBits::Streaming |
+                       BufferDesc::BufferAPIHintBits::UniformBlock);
+  ASSERT_TRUE(buffer != nullptr);
+  auto& glBuffer = static_cast<opengl::ArrayBuffer&>(*buffer);
+  if (!glBuffer.isStreaming()) {
+    GTEST_SKIP() << "Buffer storage is not supported";
+  }
+  const auto& stats = glBuffer.getStreamingStats();
+
+  // the slot was not used yet, so uploads stay in it
+  ASSERT_TRUE(buffer->upload(data_.data(), BufferRange(16, 0)).isOk());
+  const size_t firstSlot = glBuffer.useStreamingSlot();
+  EXPECT_EQ(stats.slotSwitches, 0u);
+
+  // after a draw, the contents move to the next slot; the GPU copies the rest of the contents
+  data_[32] = 0xab;
+  ASSERT_TRUE(buffer->upload(&data_[32], BufferRange(1, 32)).isOk());
+  EXPECT_EQ(stats.slotSwitches, 1u);
+  EXPECT_EQ(stats.copiedBytes, kBufferSize - 1);
+
+  // the copy may still write the rest of the slot, so uploads outside of the range move on too
+  ASSERT_TRUE(buffer->upload(data_.data(), BufferRange(16, 0)).isOk());
+  EXPECT_EQ(stats.slotSwitches, 2u);
+  ASSERT_TRUE(buffer->upload(data_.data(), BufferRange(16, 0)).isOk());
+  EXPECT_EQ(stats.slotSwitches, 2u);
+  const size_t slot = glBuffer.useStreamingSlot();
+  EXPECT_NE(slot, firstSlot);
+  EXPECT_EQ(slot % 256, 0u);
+
+  // map() moves to the next slot as well, with the current contents
+  expectContents(*buffer);
+  EXPECT_EQ(stats.slotSwitches, 3u);
+  ASSERT_TRUE(buffer->upload(data_.data(), BufferRange(kBufferSize, 0)).isOk());
+  EXPECT_EQ(stats.slotSwitches, 3u);
+  glBuffer.useStreamingSlot();
+
+  // the slots are reused after all of them were used
+  for (size_t i = 4; i < opengl::ArrayBuffer::kNumStreamingSlots; i++) {
+    ASSERT_TRUE(buffer->upload(data_.data(), BufferRange(kBufferSize, 0)).isOk());
+    glBuffer.useStreamingSlot();
+  }
+  ASSERT_TRUE(buffer->upload(data_.data(), BufferRange(kBufferSize, 0)).isOk());
+  EXPECT_EQ(stats.slotSwitches, opengl::ArrayBuffer::kNumStreamingSlots);
+  EXPECT_EQ(glBuffer.useStreamingSlot(), firstSlot);
+  expectContents(*buffer);
+
+  EXPECT_FALSE(buffer->upload(data_.data(), BufferRange(16, kBufferSize)).isOk());
+}
+
+TEST_F(StreamingBufferOGLTest, StreamFrames) {
+  using Clock = std::chrono::steady_clock;
+  using Microseconds = std::chrono::duration<double, std::micro>;
+
+  auto dynamicBuffer = createBuffer(BufferDesc::BufferTypeBits::Vertex, 0);
+  auto streamingBuffer =
+      createBuffer(BufferDesc::BufferTypeBits::Vertex, BufferDesc::BufferAPIHintBits::Streaming);
+  ASSERT_TRUE(dynamicBuffer != nullptr && streamingBuffer != nullptr);
+  auto& glBuffer = static_cast<opengl::ArrayBuffer&>(*streamingBuffer);
+  if (!glBuffer.isStreaming()) {
+    GTEST_SKIP() << "Buffer storage is not supported";
+  }
+
+  // every frame rewrites the whole buffer for each of its draws
+  auto streamFrames = [this](IBuffer& buffer, opengl::ArrayBuffer* streaming) {
+    Clock::duration time{};
+    for (size_t frame = 0; frame != kNumFrames; frame++) {
+      for (size_t draw = 0; draw != kNumDrawsPerFrame; draw++) {
+        data_[0] = static_cast<uint8_t>(frame * kNumDrawsPerFrame + draw);
+        const auto start = Clock::now();
+        EXPECT_TRUE(buffer.upload(data_.data(), BufferRange(data_.size(), 0)).isOk());
+        time += Clock::now() - start;
+        if (streaming) {
+          streaming->useStreamingSlot();
+        }
+      }
+      auto cmdBuffer = cmdQueue_->createCommandBuffer({}, nullptr);
+      cmdQueue_->submit(*cmdBuffer, true);
+    }
+    return Microseconds(time).count() / kNumFrames;
+  };
+
+  const double subDataTime = streamFrames(*dynamicBuffer, nullptr);
+  const double streamingTime = streamFrames(*streamingBuffer, &glBuffer);
+  expectContents(*streamingBuffer);
+
+  const auto& stats = glBuffer.getStreamingStats();
+  // one fence per draw; the first upload still goes to the initial slot, and whole uploads copy
+  // nothing from the previous slot
+  EXPECT_EQ(stats.slotSwitches, kNumFrames * kNumDrawsPerFrame - 1);
+  EXPECT_EQ(stats.copiedBytes, 0u);
+  RecordProperty("BufferSubDataMicroseconds", std::to_string(subDataTime));
+  RecordProperty("StreamingMicroseconds", std::to_string(streamingTime));
+  RecordProperty("Waits", static_cast<int>(stats.waits));
+}
+
+TEST_F(StreamingBufferOGLTest, MapWritesDrawnContents) {
+  Result ret;
+  BufferDesc vbDesc(BufferDesc::BufferTypeBits::Vertex,
+                    data::vertex_index::QUAD_VERT,
+                    sizeof(data::vertex_index::QUAD_VERT),
+                    ResourceStorage::Shared,
+                    BufferDesc::BufferAPIHintBits::Streaming);
+  auto vb = iglDev_->createBuffer(vbDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  if (!static_cast<opengl::ArrayBuffer&>(*vb).isStreaming()) {
+    GTEST_SKIP() << "Buffer storage is not supported";
+  }
+
+  BufferDesc bufDesc;
+  bufDesc.type = BufferDesc::BufferTypeBits::Vertex;
+  bufDesc.data = data::vertex_index::QUAD_UV;
+  bufDesc.length = sizeof(data::vertex_index::QUAD_UV);
+  auto uv = iglDev_->createBuffer(bufDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  bufDesc.type = BufferDesc::BufferTypeBits::Index;
+  bufDesc.data = data::vertex_index::QUAD_IND;
+  bufDesc.length = sizeof(data::vertex_index::QUAD_IND);
+  auto ib = iglDev_->createBuffer(bufDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto offscreenTexture = iglDev_->createTexture(
+      TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                         kWidth,
+                         kHeight,
+                         TextureDesc::TextureUsageBits::Sampled |
+                             TextureDesc::TextureUsageBits::Attachment),
+      &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = offscreenTexture;
+  auto framebuffer = iglDev_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto texture = iglDev_->createTexture(
+      TextureDesc::new2D(
+          TextureFormat::RGBA_UNorm8, kWidth, kHeight, TextureDesc::TextureUsageBits::Sampled),
+      &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  texture->upload(TextureRangeDesc::new2D(0, 0, kWidth, kHeight),
+                  data::texture::TEX_RGBA_MISC1_4x4);
+  SamplerStateDesc samplerDesc;
+  samplerDesc.minFilter = samplerDesc.magFilter = SamplerMinMagFilter::Nearest;
+  auto sampler = iglDev_->createSamplerState(samplerDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  std::unique_ptr<IShaderStages> stages;
+  util::createSimpleShaderStages(iglDev_, stages);
+  ASSERT_TRUE(stages != nullptr);
+  VertexInputStateDesc inputDesc;
+  inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+  inputDesc.attributes[0].offset = 0;
+  inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+  inputDesc.attributes[0].name = data::shader::simplePos;
+  inputDesc.attributes[0].location = 0;
+  inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+  inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+  inputDesc.attributes[1].offset = 0;
+  inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+  inputDesc.attributes[1].name = data::shader::simpleUv;
+  inputDesc.attributes[1].location = 1;
+  inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+  inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+  RenderPipelineDesc pipelineDesc;
+  pipelineDesc.vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  pipelineDesc.shaderStages = std::move(stages);
+  pipelineDesc.targetDesc.colorAttachments.resize(1);
+  pipelineDesc.targetDesc.colorAttachments[0].textureFormat = offscreenTexture->getFormat();
+  pipelineDesc.cullMode = CullMode::Disabled;
+  pipelineDesc.fragmentUnitSamplerMap[kTextureUnit] = IGL_NAMEHANDLE(data::shader::simpleSampler);
+  auto pipelineState = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  RenderPassDesc renderPass;
+  renderPass.colorAttachments.resize(1);
+  renderPass.colorAttachments[0].loadAction = LoadAction::Clear;
+  renderPass.colorAttachments[0].storeAction = StoreAction::Store;
+  renderPass.colorAttachments[0].clearColor = {0.0f, 0.0f, 0.0f, 1.0f};
+
+  // draws the quad and reads the framebuffer back
+  auto render = [&]() {
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass, framebuffer, {}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    encoder->bindRenderPipelineState(pipelineState);
+    encoder->bindTexture(kTextureUnit, BindTarget::kFragment, texture.get());
+    encoder->bindSamplerState(kTextureUnit, BindTarget::kFragment, sampler.get());
+    encoder->bindVertexBuffer(data::shader::simplePosIndex, *vb);
+    encoder->bindVertexBuffer(data::shader::simpleUvIndex, *uv);
+    encoder->bindIndexBuffer(*ib, IndexFormat::UInt16);
+    encoder->drawIndexed(6);
+    encoder->endEncoding();
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+
+    std::vector<uint32_t> pixels(kWidth * kHeight);
+    framebuffer->copyBytesColorAttachment(
+        *cmdQueue_, 0, pixels.data(), TextureRangeDesc::new2D(0, 0, kWidth, kHeight));
+    return pixels;
+  };
+  auto writeVertices = [&](const void* vertices) {
+    void* contents = vb->map(BufferRange(sizeof(data::vertex_index::QUAD_VERT), 0), &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    ASSERT_TRUE(contents != nullptr);
+    memcpy(contents, vertices, sizeof(data::vertex_index::QUAD_VERT));
+    vb->unmap();
+  };
+
+  // opaque black
+  const std::vector<uint32_t> cleared(kWidth * kHeight, 0xff000000);
+  const std::vector<uint32_t> quad = render();
+  ASSERT_NE(quad, cleared);
+
+  // the slot read by the previous draw keeps the quad, the next draw reads a degenerate one
+  std::vector<float> degenerate(sizeof(data::vertex_index::QUAD_VERT) / sizeof(float), 0.0f);
+  for (size_t i = 3; i < degenerate.size(); i += 4) {
+    degenerate[i] = 1.0f;
+  }
+  writeVertices(degenerate.data());
+  EXPECT_EQ(render(), cleared);
+
+  writeVertices(data::vertex_index::QUAD_VERT);
+  EXPECT_EQ(render(), quad);
+
+  // map() returns the drawn contents, and stays in a slot which was not drawn yet
+  const auto& stats = static_cast<opengl::ArrayBuffer&>(*vb).getStreamingStats();
+  const uint64_t slotSwitches = stats.slotSwitches;
+  for (int i = 0; i != 2; i++) {
+    const void* contents = vb->map(BufferRange(sizeof(data::vertex_index::QUAD_VERT), 0), &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    ASSERT_TRUE(contents != nullptr);
+    EXPECT_EQ(
+        memcmp(contents, data::vertex_index::QUAD_VERT, sizeof(data::vertex_index::QUAD_VERT)), 0);
+    vb->unmap();
+  }
+  EXPECT_EQ(stats.slotSwitches, slotSwitches + 1);
+}
+
+} // namespace igl::tests
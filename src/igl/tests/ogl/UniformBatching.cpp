@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <igl/VertexInputState.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/RenderPipelineReflection.h>
+#include <igl/opengl/RenderPipelineState.h>
+#include <igl/opengl/UniformAdapter.h>
+
+namespace igl::tests {
+
+//
+// UniformBatchingOGLTest
+//
+// Creates a pipeline whose program declares the batched uniform block, and checks that loose
+// uniform values are packed into the std140 block and uploaded once per change.
+//
+class UniformBatchingOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    const bool isGles3 = iglDev_->getBackendVersion().flavor == igl::BackendFlavor::OpenGL_ES &&
+                         iglDev_->getBackendVersion().majorVersion >= 3;
+    if (!isGles3 || !iglDev_->hasFeature(DeviceFeatures::UniformBlocks)) {
+      GTEST_SKIP() << "Uniform blocks with OpenGL ES 3.0 shaders are not supported";
+    }
+
+    Result ret;
+    VertexInputStateDesc inputDesc;
+    inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+    inputDesc.attributes[0].offset = 0;
+    inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+    inputDesc.attributes[0].name = data::shader::simplePos;
+    inputDesc.attributes[0].location = 0;
+    inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+    inputDesc.numAttributes = inputDesc.numInputBindings = 1;
+    auto vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createShaderStages(iglDev_,
+                             data::shader::OGL_SIMPLE_VERT_SHADER_BATCHED_UNIFORMS,
+                             "vertexShader",
+                             data::shader::OGL_SIMPLE_FRAG_SHADER_UNIFORM_BLOCKS,
+                             "fragmentShader",
+                             stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    RenderPipelineDesc renderPipelineDesc;
+    renderPipelineDesc.vertexInputState = std::move(vertexInputState);
+    renderPipelineDesc.shaderStages = std::move(stages);
+    pipelineState_ = iglDev_->createRenderPipeline(renderPipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    ASSERT_TRUE(pipelineState_ != nullptr);
+  }
+
+  [[nodiscard]] opengl::RenderPipelineState& getPipelineState() const {
+    return static_cast<opengl::RenderPipelineState&>(*pipelineState_);
+  }
+
+  [[nodiscard]] const opengl::RenderPipelineReflection& getReflection() const {
+    return static_cast<const opengl::RenderPipelineReflection&>(
+        *getPipelineState().renderPipelineReflection());
+  }
+
+  [[nodiscard]] UniformDesc getUniformDesc(const char* name, UniformType type) const {
+    UniformDesc desc;
+    desc.location = pipelineState_->getIndexByName(igl::genNameHandle(name), ShaderStage::Vertex);
+    desc.type = type;
+    return desc;
+  }
+
+  [[nodiscard]] GLint getMemberOffset(const char* name) const {
+    const auto& blocks = getReflection().getUniformBlocksDictionary();
+    const auto& block = blocks.at(igl::genNameHandle(opengl::UniformBatchBuffer::kBlockName));
+    return block.members.at(igl::genNameHandle(name)).offset;
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::shared_ptr<IRenderPipelineState> pipelineState_;
+};
+
+TEST_F(UniformBatchingOGLTest, Reflection) {
+  const auto* layout = getPipelineState().getBatchedUniformLayout();
+  ASSERT_TRUE(layout != nullptr);
+  EXPECT_EQ(layout->members.size(), 4u);
+
+  // the members are looked up like loose uniforms
+  for (const char* name : {"scale", "offsets", "rotation", "flip"}) {
+    const int location = pipelineState_->getIndexByName(igl::genNameHandle(name),
+                                                        ShaderStage::Vertex);
+    EXPECT_TRUE(layout->getMember(location) != nullptr) << name;
+  }
+
+  // the block itself is not a buffer argument, since IGL binds it
+  for (const auto& buffer : getReflection().allUniformBuffers()) {
+    EXPECT_FALSE(buffer.isUniformBlock) << buffer.name.toString();
+  }
+}
+
+TEST_F(UniformBatchingOGLTest, PackAndUpload) {
+  const auto* layout = getPipelineState().getBatchedUniformLayout();
+  ASSERT_TRUE(layout != nullptr);
+  auto& batch = getPipelineState().getUniformBatch();
+  ASSERT_EQ(batch.data.size(), static_cast<size_t>(layout->size));
+
+  opengl::UniformAdapter adapter(*context_, opengl::UniformAdapter::Render);
+  adapter.setUniformBatch(layout, &batch);
+
+  const float scale = 2.0f;
+  const float offsets[2][2] = {{1.0f, 2.0f}, {3.0f, 4.0f}};
+  const float rotation[9] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  const bool flip = true;
+
+  Result ret;
+  adapter.setUniform(getUniformDesc("scale", UniformType::Float), &scale, &ret);
+  ASSERT_TRUE(ret.isOk());
+  auto offsetsDesc = getUniformDesc("offsets", UniformType::Float2);
+  offsetsDesc.numElements = 2;
+  adapter.setUniform(offsetsDesc, offsets, &ret);
+  ASSERT_TRUE(ret.isOk());
+  adapter.setUniform(getUniformDesc("rotation", UniformType::Mat3x3), rotation, &ret);
+  ASSERT_TRUE(ret.isOk());
+  adapter.setUniform(getUniformDesc("flip", UniformType::Boolean), &flip, &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  // std140: array elements and matrix columns are 16 bytes apart, booleans take 4 bytes
+  const uint8_t* block = batch.data.data();
+  float value = 0;
+  memcpy(&value, block + getMemberOffset("scale"), sizeof(value));
+  EXPECT_EQ(value, scale);
+  memcpy(&value, block + getMemberOffset("offsets") + 16 + sizeof(float), sizeof(value));
+  EXPECT_EQ(value, offsets[1][1]);
+  memcpy(&value, block + getMemberOffset("rotation") + 32 + 2 * sizeof(float), sizeof(value));
+  EXPECT_EQ(value, rotation[8]);
+  uint32_t boolValue = 0;
+  memcpy(&boolValue, block + getMemberOffset("flip"), sizeof(boolValue));
+  EXPECT_EQ(boolValue, 1u);
+
+  auto& ring = context_->getUniformBatchBuffer();
+  ring.resetStats();
+  adapter.bindToPipeline(*context_);
+  EXPECT_EQ(ring.getStats().uploads, 1u);
+  EXPECT_EQ(ring.getStats().binds, 1u);
+
+  // unchanged values are only bound again
+  adapter.bindToPipeline(*context_);
+  EXPECT_EQ(ring.getStats().uploads, 1u);
+  EXPECT_EQ(ring.getStats().binds, 2u);
+
+  adapter.setUniform(getUniformDesc("scale", UniformType::Float), &scale, &ret);
+  adapter.bindToPipeline(*context_);
+  EXPECT_EQ(ring.getStats().uploads, 2u);
+}
+
+} // namespace igl::tests
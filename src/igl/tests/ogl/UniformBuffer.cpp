@@ -11,6 +11,7 @@
 #include "../util/Common.h"
 
 #include <array>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <string>
 #include <igl/CommandBuffer.h>
@@ -20,6 +21,7 @@
 #include <igl/SamplerState.h>
 #include <igl/Shader.h>
 #include <igl/VertexInputState.h>
+#include <igl/opengl/CommandQueue.h>
 
 // to not use extra curly braces in initializer lists
 // This is needed to get tests working on Android
@@ -370,9 +372,10 @@ const char kOglUniformArrayFragShader[] =
 // UniformBufferTest
 //
 // Test fixture for all the tests in this file. Takes care of common
-// initialization and allocating of common resources.
+// initialization and allocating of common resources. The parameter enables the deferred command
+// recording mode of the queue.
 //
-class UniformBufferTest : public ::testing::Test {
+class UniformBufferTest : public ::testing::TestWithParam<bool> {
  private:
  public:
   UniformBufferTest() = default;
@@ -395,6 +398,8 @@ class UniformBufferTest : public ::testing::Test {
     util::createDeviceAndQueue(iglDev_, cmdQueue_);
     ASSERT_TRUE(iglDev_ != nullptr);
     ASSERT_TRUE(cmdQueue_ != nullptr);
+    std::static_pointer_cast<opengl::CommandQueue>(cmdQueue_)->setCommandRecordingEnabled(
+        GetParam());
 
     // Create an offscreen texture to render to
     TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
@@ -535,7 +540,7 @@ class UniformBufferTest : public ::testing::Test {
 // The custom fragment shader will only show the original input texture when each and all of the
 // uniform types are binded properly
 //
-TEST_F(UniformBufferTest, UniformBufferBinding) {
+TEST_P(UniformBufferTest, UniformBufferBinding) {
   Result ret;
   std::shared_ptr<IRenderPipelineState> pipelineState;
   const simd::float4 clearColor = {0.0, 0.0, 1.0, 1.0};
@@ -802,6 +807,9 @@ TEST_F(UniformBufferTest, UniformBufferBinding) {
   cmds->drawIndexed(6);
   cmds->endEncoding();
 
+  // the uniform data is copied by bindUniform(), also when the commands are only recorded
+  memset(&fragmentParameters, 0, sizeof(fragmentParameters));
+
   cmdQueue_->submit(*cmdBuf_);
 
   //----------------------
@@ -830,7 +838,7 @@ TEST_F(UniformBufferTest, UniformBufferBinding) {
 // The custom fragment shader will only show the original input texture when each and all of the
 // uniform types are binded properly
 //
-TEST_F(UniformBufferTest, UniformArrayBinding) {
+TEST_P(UniformBufferTest, UniformArrayBinding) {
   Result ret;
   std::shared_ptr<IRenderPipelineState> pipelineState;
   const simd::float4 clearColor = {0.0, 0.0, 1.0, 1.0};
@@ -1204,6 +1212,9 @@ TEST_F(UniformBufferTest, UniformArrayBinding) {
   cmds->drawIndexed(6);
   cmds->endEncoding();
 
+  // the uniform data is copied by bindUniform(), also when the commands are only recorded
+  memset(&fragmentParameters, 0, sizeof(fragmentParameters));
+
   cmdQueue_->submit(*cmdBuf_);
 
   //----------------------
@@ -1225,4 +1236,11 @@ TEST_F(UniformBufferTest, UniformArrayBinding) {
   }
 }
 
+INSTANTIATE_TEST_SUITE_P(UniformBuffer,
+                         UniformBufferTest,
+                         ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                           return info.param ? "Recorded" : "Immediate";
+                         });
+
 } // namespace igl::tests
@@ -0,0 +1,263 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "../data/ShaderData.h"
+#include "../data/TextureData.h"
+#include "../data/VertexIndexData.h"
+#include "../util/Common.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <igl/CommandBuffer.h>
+#include <igl/NameHandle.h>
+#include <igl/RenderPass.h>
+#include <igl/RenderPipelineState.h>
+#include <igl/SamplerState.h>
+#include <igl/VertexInputState.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/VertexArrayObjectCache.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr size_t kTextureUnit = 0;
+
+} // namespace
+
+//
+// VertexArrayObjectCacheOGLTest
+//
+// Renders a textured quad with the vertex array object cache of IContext and checks the cache
+// hits, the number of GL calls and the eviction of deleted buffers.
+//
+class VertexArrayObjectCacheOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    ASSERT_TRUE(cmdQueue_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    Result ret;
+    auto offscreenTexture = iglDev_->createTexture(
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kWidth,
+                           kHeight,
+                           TextureDesc::TextureUsageBits::Sampled |
+                               TextureDesc::TextureUsageBits::Attachment),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = offscreenTexture;
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    renderPass_.colorAttachments.resize(1);
+    renderPass_.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass_.colorAttachments[0].storeAction = StoreAction::Store;
+    renderPass_.colorAttachments[0].clearColor = {0.0f, 0.0f, 0.0f, 1.0f};
+
+    std::unique_ptr<IShaderStages> stages;
+    util::createSimpleShaderStages(iglDev_, stages);
+    ASSERT_TRUE(stages != nullptr);
+
+    VertexInputStateDesc inputDesc;
+    inputDesc.attributes[0].format = VertexAttributeFormat::Float4;
+    inputDesc.attributes[0].offset = 0;
+    inputDesc.attributes[0].bufferIndex = data::shader::simplePosIndex;
+    inputDesc.attributes[0].name = data::shader::simplePos;
+    inputDesc.attributes[0].location = 0;
+    inputDesc.inputBindings[0].stride = sizeof(float) * 4;
+    inputDesc.attributes[1].format = VertexAttributeFormat::Float2;
+    inputDesc.attributes[1].offset = 0;
+    inputDesc.attributes[1].bufferIndex = data::shader::simpleUvIndex;
+    inputDesc.attributes[1].name = data::shader::simpleUv;
+    inputDesc.attributes[1].location = 1;
+    inputDesc.inputBindings[1].stride = sizeof(float) * 2;
+    inputDesc.numAttributes = inputDesc.numInputBindings = 2;
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.vertexInputState = iglDev_->createVertexInputState(inputDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    pipelineDesc.shaderStages = std::move(stages);
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = offscreenTexture->getFormat();
+    pipelineDesc.cullMode = CullMode::Disabled;
+    pipelineDesc.fragmentUnitSamplerMap[kTextureUnit] =
+        IGL_NAMEHANDLE(data::shader::simpleSampler);
+    pipelineState_ = iglDev_->createRenderPipeline(pipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    texture_ = iglDev_->createTexture(
+        TextureDesc::new2D(
+            TextureFormat::RGBA_UNorm8, kWidth, kHeight, TextureDesc::TextureUsageBits::Sampled),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    texture_->upload(TextureRangeDesc::new2D(0, 0, kWidth, kHeight),
+                     data::texture::TEX_RGBA_MISC1_4x4);
+
+    SamplerStateDesc samplerDesc;
+    samplerDesc.minFilter = samplerDesc.magFilter = SamplerMinMagFilter::Nearest;
+    sampler_ = iglDev_->createSamplerState(samplerDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    BufferDesc bufDesc;
+    bufDesc.type = BufferDesc::BufferTypeBits::Index;
+    bufDesc.data = data::vertex_index::QUAD_IND;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_IND);
+    ib_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    bufDesc.type = BufferDesc::BufferTypeBits::Vertex;
+    bufDesc.data = data::vertex_index::QUAD_VERT;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_VERT);
+    vb_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    bufDesc.data = data::vertex_index::QUAD_UV;
+    bufDesc.length = sizeof(data::vertex_index::QUAD_UV);
+    uv_ = iglDev_->createBuffer(bufDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+  void TearDown() override {
+    if (context_) {
+      context_->setVertexArrayObjectCacheEnabled(false);
+    }
+  }
+
+  // returns false when the context does not support vertex array objects
+  [[nodiscard]] bool enableCache() const {
+    context_->setVertexArrayObjectCacheEnabled(true);
+    return context_->isVertexArrayObjectCacheEnabled();
+  }
+
+  void render(size_t numDraws = 1) const {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass_, framebuffer_, {}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    encoder->bindRenderPipelineState(pipelineState_);
+    encoder->bindTexture(kTextureUnit, BindTarget::kFragment, texture_.get());
+    encoder->bindSamplerState(kTextureUnit, BindTarget::kFragment, sampler_.get());
+    for (size_t i = 0; i != numDraws; i++) {
+      encoder->bindVertexBuffer(data::shader::simplePosIndex, *vb_);
+      encoder->bindVertexBuffer(data::shader::simpleUvIndex, *uv_);
+      encoder->bindIndexBuffer(*ib_, IndexFormat::UInt16);
+      encoder->drawIndexed(6);
+    }
+    encoder->endEncoding();
+
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+  }
+
+  [[nodiscard]] std::vector<uint32_t> readPixels() const {
+    std::vector<uint32_t> pixels(kWidth * kHeight);
+    framebuffer_->copyBytesColorAttachment(
+        *cmdQueue_, 0, pixels.data(), TextureRangeDesc::new2D(0, 0, kWidth, kHeight));
+    return pixels;
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  RenderPassDesc renderPass_;
+  std::shared_ptr<IRenderPipelineState> pipelineState_;
+  std::shared_ptr<ITexture> texture_;
+  std::shared_ptr<ISamplerState> sampler_;
+  std::shared_ptr<IBuffer> vb_, uv_, ib_;
+};
+
+TEST_F(VertexArrayObjectCacheOGLTest, SameResultAsWithoutCache) {
+  render();
+  const std::vector<uint32_t> expected = readPixels();
+
+  if (!enableCache()) {
+    GTEST_SKIP() << "Vertex array objects are not supported";
+  }
+  render();
+  const std::vector<uint32_t> pixels = readPixels();
+
+  for (size_t i = 0; i != pixels.size(); i++) {
+    ASSERT_EQ(pixels[i], expected[i]) << "Pixel mismatch at " << i;
+  }
+
+  // a hit renders the same image
+  render();
+  ASSERT_EQ(context_->getVertexArrayObjectCache()->getStats().hits, 1u);
+  ASSERT_EQ(readPixels(), expected);
+}
+
+TEST_F(VertexArrayObjectCacheOGLTest, FewerCallsPerDraw) {
+  constexpr size_t kNumDraws = 16;
+
+  render(kNumDraws);
+  context_->resetCounters();
+  render(kNumDraws);
+  const unsigned int callsWithoutCache = context_->getCallCount();
+
+  if (!enableCache()) {
+    GTEST_SKIP() << "Vertex array objects are not supported";
+  }
+  render(kNumDraws);
+  context_->resetCounters();
+  render(kNumDraws);
+  const unsigned int callsWithCache = context_->getCallCount();
+
+  RecordProperty("CallsWithoutCache", static_cast<int>(callsWithoutCache));
+  RecordProperty("CallsWithCache", static_cast<int>(callsWithCache));
+
+  const auto& stats = context_->getVertexArrayObjectCache()->getStats();
+  EXPECT_EQ(stats.misses, 1u);
+  EXPECT_EQ(stats.hits, 2 * kNumDraws - 1);
+  EXPECT_EQ(context_->getVertexArrayObjectCache()->size(), 1u);
+  EXPECT_LT(callsWithCache, callsWithoutCache);
+}
+
+TEST_F(VertexArrayObjectCacheOGLTest, EvictDeletedBuffers) {
+  if (!enableCache()) {
+    GTEST_SKIP() << "Vertex array objects are not supported";
+  }
+  render();
+  auto* cache = context_->getVertexArrayObjectCache();
+  ASSERT_EQ(cache->size(), 1u);
+
+  // a new buffer with the same contents needs a new vertex array object
+  Result ret;
+  BufferDesc bufDesc;
+  bufDesc.type = BufferDesc::BufferTypeBits::Vertex;
+  bufDesc.data = data::vertex_index::QUAD_UV;
+  bufDesc.length = sizeof(data::vertex_index::QUAD_UV);
+  std::shared_ptr<IBuffer> uv = iglDev_->createBuffer(bufDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  std::swap(uv, uv_);
+  render();
+  EXPECT_EQ(cache->size(), 2u);
+
+  uv = nullptr;
+  context_->flushDeletionQueue();
+  EXPECT_EQ(cache->size(), 1u);
+  EXPECT_EQ(cache->getStats().evictions, 1u);
+
+  render();
+  EXPECT_EQ(cache->getStats().misses, 2u);
+  EXPECT_EQ(cache->getStats().hits, 1u);
+}
+
+} // namespace igl::tests
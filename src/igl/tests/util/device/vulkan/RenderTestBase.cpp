@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/tests/util/device/vulkan/RenderTestBase.h>
+
+#include <igl/CommandBuffer.h>
+#include <igl/ShaderCreator.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::tests::util::device::vulkan {
+
+void RenderTestBase::SetUp() {
+  igl::setDebugBreakEnabled(false);
+}
+
+void RenderTestBase::createDevice(const igl::vulkan::VulkanContextConfig& config) {
+  device_ = createTestDevice(config);
+  ASSERT_TRUE(device_ != nullptr);
+  context_ = &static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+
+  Result ret;
+  cmdQueue_ = device_->createCommandQueue({}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+}
+
+void RenderTestBase::createFramebuffer(uint32_t width,
+                                       uint32_t height,
+                                       TextureFormat depthFormat) {
+  width_ = width;
+  height_ = height;
+
+  Result ret;
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture =
+      device_->createTexture(TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                width,
+                                                height,
+                                                TextureDesc::TextureUsageBits::Sampled |
+                                                    TextureDesc::TextureUsageBits::Attachment),
+                             &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  if (depthFormat != TextureFormat::Invalid) {
+    framebufferDesc.depthAttachment.texture = device_->createTexture(
+        TextureDesc::new2D(depthFormat, width, height, TextureDesc::TextureUsageBits::Attachment),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+  framebuffer_ = device_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  renderPass_.colorAttachments.resize(1);
+  renderPass_.colorAttachments[0].loadAction = LoadAction::Clear;
+  renderPass_.colorAttachments[0].storeAction = StoreAction::Store;
+  renderPass_.colorAttachments[0].clearColor = {0.0f, 0.0f, 0.0f, 0.0f};
+  renderPass_.depthAttachment.loadAction = LoadAction::Clear;
+  renderPass_.depthAttachment.storeAction = StoreAction::DontCare;
+  renderPass_.depthAttachment.clearDepth = 1.0f;
+}
+
+void RenderTestBase::createPipeline(const char* codeFS, RenderPipelineDesc desc) {
+  Result ret;
+  desc.shaderStages = ShaderStagesCreator::fromModuleStringInput(
+      *device_, kCodeVS, "main", "", codeFS, "main", "", &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  desc.targetDesc.colorAttachments.resize(1);
+  desc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+  const auto depthTexture = framebuffer_->getDepthAttachment();
+  desc.targetDesc.depthAttachmentFormat =
+      depthTexture ? depthTexture->getFormat() : TextureFormat::Invalid;
+  desc.cullMode = CullMode::Disabled;
+  pipelineState_ = device_->createRenderPipeline(desc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+}
+
+std::shared_ptr<ITexture> RenderTestBase::createSolidTexture(uint32_t color) const {
+  Result ret;
+  auto texture = device_->createTexture(
+      TextureDesc::new2D(TextureFormat::RGBA_UNorm8, 1, 1, TextureDesc::TextureUsageBits::Sampled),
+      &ret);
+  EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+  if (texture) {
+    ret = texture->upload(TextureRangeDesc::new2D(0, 0, 1, 1), &color);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+  return texture;
+}
+
+void RenderTestBase::render(const std::function<void(IRenderCommandEncoder&)>& draws,
+                            bool endOfFrame) const {
+  Result ret;
+  auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass_, framebuffer_, {}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  if (pipelineState_) {
+    encoder->bindRenderPipelineState(pipelineState_);
+  }
+  draws(*encoder);
+  encoder->endEncoding();
+  cmdQueue_->submit(*cmdBuffer, endOfFrame);
+  cmdBuffer->waitUntilCompleted();
+}
+
+std::vector<uint32_t> RenderTestBase::readPixels() const {
+  std::vector<uint32_t> pixels(static_cast<size_t>(width_) * height_);
+  framebuffer_->copyBytesColorAttachment(
+      *cmdQueue_, 0, pixels.data(), TextureRangeDesc::new2D(0, 0, width_, height_));
+  return pixels;
+}
+
+void RenderTestBase::checkPixels(uint32_t expectedColor) const {
+  const std::vector<uint32_t> pixels = readPixels();
+  for (size_t i = 0; i != pixels.size(); i++) {
+    ASSERT_EQ(pixels[i], expectedColor) << "Pixel mismatch at " << i;
+  }
+}
+
+} // namespace igl::tests::util::device::vulkan
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include <igl/CommandQueue.h>
+#include <igl/Device.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderCommandEncoder.h>
+#include <igl/RenderPass.h>
+#include <igl/RenderPipelineState.h>
+#include <igl/Texture.h>
+
+namespace igl {
+namespace vulkan {
+class VulkanContext;
+struct VulkanContextConfig;
+} // namespace vulkan
+
+namespace tests::util::device::vulkan {
+
+/**
+ Base fixture for Vulkan tests which draw full-screen triangles into a small offscreen framebuffer
+ and check its pixels or the counters of the VulkanContext. Derived fixtures create the device, the
+ framebuffer and the pipeline in their SetUp() with the settings they test.
+ */
+class RenderTestBase : public ::testing::Test {
+ public:
+  /// A full-screen triangle at depth 0, drawn with draw(3)
+  static constexpr const char* kCodeVS = R"(
+void main() {
+  vec2 pos = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+  gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+  /// Samples the texture bound to slot 0 of the fragment stage
+  static constexpr const char* kCodeTextureFS = R"(
+layout (location=0) out vec4 out_FragColor;
+
+layout (set = 0, binding = 0) uniform sampler2D uTex;
+
+void main() {
+  out_FragColor = texture(uTex, vec2(0.5));
+}
+)";
+
+  void SetUp() override;
+
+ protected:
+  /// Creates device_, context_ and cmdQueue_
+  void createDevice(const igl::vulkan::VulkanContextConfig& config);
+  /// Creates framebuffer_ with an RGBA_UNorm8 color attachment and, if `depthFormat` is valid, a
+  /// depth attachment. renderPass_ clears both.
+  void createFramebuffer(uint32_t width,
+                         uint32_t height,
+                         TextureFormat depthFormat = TextureFormat::Invalid);
+  /// Creates pipelineState_ drawing kCodeVS and `codeFS` into framebuffer_. The shader stages and
+  /// the attachment formats of `desc` are overwritten.
+  void createPipeline(const char* codeFS, RenderPipelineDesc desc = {});
+
+  /// A 1x1 RGBA_UNorm8 texture filled with `color`
+  [[nodiscard]] std::shared_ptr<ITexture> createSolidTexture(uint32_t color) const;
+
+  /// Records `draws` in renderPass_ after binding pipelineState_, submits them and waits
+  void render(const std::function<void(IRenderCommandEncoder&)>& draws,
+              bool endOfFrame = false) const;
+  [[nodiscard]] std::vector<uint32_t> readPixels() const;
+  /// Every RGBA8 pixel of the color attachment has to be `expectedColor`
+  void checkPixels(uint32_t expectedColor) const;
+
+  std::shared_ptr<IDevice> device_;
+  igl::vulkan::VulkanContext* context_ = nullptr;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  std::shared_ptr<IRenderPipelineState> pipelineState_;
+  RenderPassDesc renderPass_;
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+};
+
+} // namespace tests::util::device::vulkan
+} // namespace igl
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include <igl/SamplerState.h>
+#include <igl/tests/util/device/vulkan/RenderTestBase.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr uint32_t kNumTextures = 4;
+constexpr uint32_t kNumDraws = 64;
+
+// RGBA8: a different green channel for every texture
+uint32_t getTextureColor(uint32_t index) {
+  return 0xff000000u | ((index * 0x20u + 0x1fu) << 8);
+}
+
+} // namespace
+
+//
+// DescriptorSetCacheTest
+//
+// Cycles through a few textures and checks how many descriptor sets are reused. The parameter is
+// VulkanContextConfig::descriptorSetCacheSize.
+//
+class DescriptorSetCacheTest : public util::device::vulkan::RenderTestBase,
+                               public ::testing::WithParamInterface<uint32_t> {
+ public:
+  void SetUp() override {
+    RenderTestBase::SetUp();
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getContextConfig(true);
+    // push descriptors bypass descriptor sets for textures
+    config.enablePushDescriptors = false;
+    config.descriptorSetCacheSize = GetParam();
+    ASSERT_NO_FATAL_FAILURE(createDevice(config));
+    ASSERT_NO_FATAL_FAILURE(createFramebuffer(kWidth, kHeight));
+    ASSERT_NO_FATAL_FAILURE(createPipeline(kCodeTextureFS));
+
+    for (uint32_t i = 0; i != kNumTextures; i++) {
+      textures_.push_back(createSolidTexture(getTextureColor(i)));
+      ASSERT_TRUE(textures_.back() != nullptr);
+    }
+
+    Result ret;
+    sampler_ = device_->createSamplerState(SamplerStateDesc{}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+  // one draw per texture change, all in one command buffer
+  void renderTextures() const {
+    render([this](IRenderCommandEncoder& encoder) {
+      encoder.bindSamplerState(0, BindTarget::kFragment, sampler_.get());
+      for (uint32_t i = 0; i != kNumDraws; i++) {
+        encoder.bindTexture(0, BindTarget::kFragment, textures_[i % kNumTextures].get());
+        encoder.draw(3);
+      }
+    });
+  }
+
+ protected:
+  std::vector<std::shared_ptr<ITexture>> textures_;
+  std::shared_ptr<ISamplerState> sampler_;
+};
+
+TEST_P(DescriptorSetCacheTest, TextureRebinds) {
+  context_->resetDescriptorSetCacheStats();
+  const size_t numAllocatedBefore = context_->numDescriptorSetsAllocated_;
+
+  renderTextures();
+  ASSERT_FALSE(HasFatalFailure());
+
+  const size_t numAllocated = context_->numDescriptorSetsAllocated_ - numAllocatedBefore;
+  const auto stats = context_->getDescriptorSetCacheStats();
+
+  RecordProperty("HitRatePercent", static_cast<int>(100.0 * stats.getHitRate()));
+
+  if (GetParam()) {
+    EXPECT_EQ(stats.numMisses, kNumTextures);
+    EXPECT_EQ(stats.numHits, kNumDraws - kNumTextures);
+    EXPECT_EQ(numAllocated, kNumTextures);
+  } else {
+    EXPECT_EQ(stats.numMisses, 0u);
+    EXPECT_EQ(stats.numHits, 0u);
+    EXPECT_DOUBLE_EQ(stats.getHitRate(), 0.0);
+    EXPECT_EQ(numAllocated, kNumDraws);
+  }
+
+  // the last draw covers the whole framebuffer
+  checkPixels(getTextureColor((kNumDraws - 1) % kNumTextures));
+}
+
+TEST_P(DescriptorSetCacheTest, ResetStats) {
+  renderTextures();
+  ASSERT_FALSE(HasFatalFailure());
+
+  context_->resetDescriptorSetCacheStats();
+
+  const auto stats = context_->getDescriptorSetCacheStats();
+  EXPECT_EQ(stats.numHits, 0u);
+  EXPECT_EQ(stats.numMisses, 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(DescriptorSetCache,
+                         DescriptorSetCacheTest,
+                         ::testing::Values(0u, 64u),
+                         [](const ::testing::TestParamInfo<uint32_t>& info) {
+                           return info.param ? "Enabled" : "Disabled";
+                         });
+
+} // namespace igl::tests
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include <igl/DepthStencilState.h>
+#include <igl/tests/util/device/vulkan/RenderTestBase.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanPipelineBuilder.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+
+constexpr const char* kCodeFS = R"(
+layout (location=0) out vec4 out_FragColor;
+
+layout (push_constant) uniform PushConstants {
+  vec4 color;
+} pc;
+
+void main() {
+  out_FragColor = pc.color;
+}
+)";
+
+const std::vector<CompareFunction> kCompareFunctions = {
+    CompareFunction::Never,
+    CompareFunction::Less,
+    CompareFunction::Equal,
+    CompareFunction::LessEqual,
+    CompareFunction::Greater,
+    CompareFunction::NotEqual,
+    CompareFunction::GreaterEqual,
+    CompareFunction::AlwaysPass,
+};
+
+} // namespace
+
+//
+// ExtendedDynamicStateTest
+//
+// Changes depth states between draws with and without VK_EXT_extended_dynamic_state and checks how
+// many pipelines are created. The parameter is VulkanContextConfig::enableExtendedDynamicState.
+//
+class ExtendedDynamicStateTest : public util::device::vulkan::RenderTestBase,
+                                 public ::testing::WithParamInterface<bool> {
+ public:
+  void SetUp() override {
+    RenderTestBase::SetUp();
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getContextConfig(true);
+    config.enableExtendedDynamicState = GetParam();
+    ASSERT_NO_FATAL_FAILURE(createDevice(config));
+
+    if (GetParam()) {
+      if (!context_->features().available(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME,
+                                          igl::vulkan::VulkanFeatures::ExtensionType::Device)) {
+        GTEST_SKIP() << "VK_EXT_extended_dynamic_state is not supported";
+      }
+      // the extension is advertised, so it has to be enabled
+      ASSERT_TRUE(context_->features().has_VK_EXT_extended_dynamic_state);
+    } else {
+      ASSERT_FALSE(context_->features().has_VK_EXT_extended_dynamic_state);
+    }
+
+    ASSERT_NO_FATAL_FAILURE(createFramebuffer(kWidth, kHeight, TextureFormat::Z_UNorm16));
+    ASSERT_NO_FATAL_FAILURE(createPipeline(kCodeFS));
+  }
+
+  std::shared_ptr<IDepthStencilState> createDepthState(CompareFunction func, bool write) const {
+    DepthStencilStateDesc desc;
+    desc.compareFunction = func;
+    desc.isDepthWriteEnabled = write;
+    Result ret;
+    auto state = device_->createDepthStencilState(desc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    return state;
+  }
+};
+
+TEST_P(ExtendedDynamicStateTest, PipelineCountWithDepthStateChurn) {
+  std::vector<std::shared_ptr<IDepthStencilState>> depthStates;
+  for (CompareFunction func : kCompareFunctions) {
+    depthStates.push_back(createDepthState(func, false));
+    depthStates.push_back(createDepthState(func, true));
+  }
+
+  const uint32_t numPipelinesBefore = vulkan::VulkanPipelineBuilder::getNumPipelinesCreated();
+
+  render([&depthStates](IRenderCommandEncoder& encoder) {
+    const float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    encoder.bindPushConstants(color, sizeof(color));
+    // every depth state twice: without and with depth bias
+    for (int bias = 0; bias != 2; bias++) {
+      if (bias) {
+        encoder.setDepthBias(1.0f, 1.0f, 0.0f);
+      }
+      for (const auto& state : depthStates) {
+        encoder.bindDepthStencilState(state);
+        encoder.draw(3);
+      }
+    }
+  });
+  ASSERT_FALSE(HasFatalFailure());
+
+  const uint32_t numPipelines =
+      vulkan::VulkanPipelineBuilder::getNumPipelinesCreated() - numPipelinesBefore;
+
+  RecordProperty("NumPipelinesCreated", static_cast<int>(numPipelines));
+
+  if (!GetParam()) {
+    EXPECT_EQ(numPipelines, 2u * depthStates.size());
+  } else if (!context_->features().has_VK_EXT_extended_dynamic_state2) {
+    EXPECT_EQ(numPipelines, 2u);
+  } else {
+    EXPECT_EQ(numPipelines, 1u);
+  }
+}
+
+TEST_P(ExtendedDynamicStateTest, DepthTestIsApplied) {
+  const auto writeDepth = createDepthState(CompareFunction::Less, true);
+  const auto readDepth = createDepthState(CompareFunction::Less, false);
+
+  render([&writeDepth, &readDepth](IRenderCommandEncoder& encoder) {
+    // passes the depth test and writes 0 into the depth buffer
+    const float red[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+    encoder.bindDepthStencilState(writeDepth);
+    encoder.bindPushConstants(red, sizeof(red));
+    encoder.draw(3);
+
+    // fails the depth test
+    const float green[4] = {0.0f, 1.0f, 0.0f, 1.0f};
+    encoder.bindDepthStencilState(readDepth);
+    encoder.bindPushConstants(green, sizeof(green));
+    encoder.draw(3);
+  });
+  ASSERT_FALSE(HasFatalFailure());
+
+  checkPixels(0xff0000ffu);
+}
+
+INSTANTIATE_TEST_SUITE_P(ExtendedDynamicState,
+                         ExtendedDynamicStateTest,
+                         ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                           return info.param ? "Dynamic" : "Baked";
+                         });
+
+} // namespace igl::tests
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include <igl/vulkan/CommandBuffer.h>
+#include <igl/vulkan/RenderCommandEncoder.h>
+
+#include <igl/tests/util/device/vulkan/RenderTestBase.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 16;
+constexpr uint32_t kHeight = 16;
+constexpr uint32_t kNumEncoders = 4;
+constexpr uint32_t kNumDrawsPerEncoder = 16;
+
+constexpr const char* kCodeFS = R"(
+layout (location=0) out vec4 out_FragColor;
+
+layout (push_constant) uniform PushConstants {
+  vec4 color;
+} pc;
+
+void main() {
+  out_FragColor = pc.color;
+}
+)";
+
+} // namespace
+
+//
+// ParallelRenderCommandEncoderTest
+//
+// Records the same render pass on a single thread and on multiple threads using secondary render
+// command encoders. The draws overlap, so the result depends on the order of execution.
+//
+class ParallelRenderCommandEncoderTest : public util::device::vulkan::RenderTestBase {
+ public:
+  void SetUp() override {
+    RenderTestBase::SetUp();
+
+    ASSERT_NO_FATAL_FAILURE(createDevice(util::device::vulkan::getContextConfig(true)));
+    ASSERT_NO_FATAL_FAILURE(createFramebuffer(kWidth, kHeight));
+    ASSERT_NO_FATAL_FAILURE(createPipeline(kCodeFS));
+  }
+
+  // every draw covers a different, overlapping region of the framebuffer with a unique color
+  void recordDraws(IRenderCommandEncoder& encoder, uint32_t encoderIndex) const {
+    encoder.bindRenderPipelineState(pipelineState_);
+    for (uint32_t i = 0; i != kNumDrawsPerEncoder; i++) {
+      const uint32_t drawIndex = encoderIndex * kNumDrawsPerEncoder + i;
+      const uint32_t x = (drawIndex * 3) % kWidth;
+      const uint32_t y = (drawIndex * 5) % kHeight;
+      encoder.bindScissorRect({x, y, kWidth - x, kHeight - y});
+      const float color[4] = {
+          float(drawIndex % 4) / 3.0f,
+          float((drawIndex / 4) % 4) / 3.0f,
+          float(drawIndex) / float(kNumEncoders * kNumDrawsPerEncoder),
+          1.0f,
+      };
+      encoder.bindPushConstants(color, sizeof(color));
+      encoder.draw(3);
+    }
+  }
+
+  std::vector<uint32_t> renderSingleThreaded() const {
+    render([this](IRenderCommandEncoder& encoder) {
+      for (uint32_t i = 0; i != kNumEncoders; i++) {
+        recordDraws(encoder, i);
+      }
+    });
+    return readPixels();
+  }
+
+  std::vector<uint32_t> renderMultiThreaded() const {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    auto& vkCmdBuffer = static_cast<vulkan::CommandBuffer&>(*cmdBuffer);
+    auto encoder = vkCmdBuffer.createParallelRenderCommandEncoder(
+        renderPass_, framebuffer_, {}, kNumEncoders, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    EXPECT_EQ(encoder->getNumSecondaryEncoders(), kNumEncoders);
+
+    // start the threads in reverse order to make sure the execution order does not depend on it
+    std::vector<std::thread> threads;
+    for (uint32_t i = kNumEncoders; i-- > 0;) {
+      threads.emplace_back([this, &encoder, i]() {
+        vulkan::RenderCommandEncoder& secondary = encoder->getSecondaryEncoder(i);
+        recordDraws(secondary, i);
+        secondary.endEncoding();
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    encoder->endEncoding();
+
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+
+    return readPixels();
+  }
+};
+
+TEST_F(ParallelRenderCommandEncoderTest, MatchesSingleThreaded) {
+  const std::vector<uint32_t> expected = renderSingleThreaded();
+
+  // the last draw covers the bottom-right corner, so the result cannot be just the clear color
+  ASSERT_NE(expected.front(), expected.back());
+
+  // repeat a few times to catch nondeterministic ordering
+  for (int iteration = 0; iteration != 3; iteration++) {
+    const std::vector<uint32_t> actual = renderMultiThreaded();
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i != expected.size(); i++) {
+      ASSERT_EQ(actual[i], expected[i]) << "Pixel mismatch at " << i << " (iteration "
+                                        << iteration << ")";
+    }
+  }
+}
+
+} // namespace igl::tests
+#endif
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <array>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include <igl/DepthStencilState.h>
+#include <igl/tests/util/device/vulkan/RenderTestBase.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/RenderCommandEncoder.h>
+#include <igl/vulkan/RenderPipelineState.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 16;
+constexpr uint32_t kHeight = 16;
+
+constexpr std::array<CompareFunction, 8> kCompareFunctions = {
+    CompareFunction::Never,
+    CompareFunction::Less,
+    CompareFunction::Equal,
+    CompareFunction::LessEqual,
+    CompareFunction::Greater,
+    CompareFunction::NotEqual,
+    CompareFunction::GreaterEqual,
+    CompareFunction::AlwaysPass,
+};
+
+constexpr const char* kCodeFS = R"(
+layout (location=0) out vec4 out_FragColor;
+
+void main() {
+  out_FragColor = vec4(1.0);
+}
+)";
+
+} // namespace
+
+//
+// PipelinePrecompileTest
+//
+// Tests for building pipeline variants in the background with
+// igl::vulkan::RenderPipelineState::precompile()
+//
+class PipelinePrecompileTest : public util::device::vulkan::RenderTestBase {
+ public:
+  void createDevice(bool skipDrawsWhileCompilingPipelines) {
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getContextConfig(true);
+    config.skipDrawsWhileCompilingPipelines = skipDrawsWhileCompilingPipelines;
+    // the variants only differ by their depth state, which is not baked into the pipelines with
+    // VK_EXT_extended_dynamic_state
+    config.enableExtendedDynamicState = false;
+    ASSERT_NO_FATAL_FAILURE(RenderTestBase::createDevice(config));
+    ASSERT_NO_FATAL_FAILURE(createFramebuffer(kWidth, kHeight, TextureFormat::Z_UNorm24));
+    ASSERT_NO_FATAL_FAILURE(createPipeline(kCodeFS));
+
+    Result ret;
+    for (CompareFunction func : kCompareFunctions) {
+      DepthStencilStateDesc desc;
+      desc.compareFunction = func;
+      desc.isDepthWriteEnabled = true;
+      depthStencilStates_.push_back(device_->createDepthStencilState(desc, &ret));
+      ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    }
+  }
+
+  // returns the dynamic state of an empty render pass, which carries the render pass index
+  vulkan::RenderPipelineDynamicState getBaseDynamicState() const {
+    vulkan::RenderPipelineDynamicState dynamicState;
+    render([&dynamicState](IRenderCommandEncoder& encoder) {
+      dynamicState = static_cast<vulkan::RenderCommandEncoder&>(encoder).getDynamicState();
+    });
+    return dynamicState;
+  }
+
+  std::vector<vulkan::RenderPipelineDynamicState> getVariants() const {
+    const vulkan::RenderPipelineDynamicState base = getBaseDynamicState();
+
+    std::vector<vulkan::RenderPipelineDynamicState> variants;
+    for (CompareFunction func : kCompareFunctions) {
+      vulkan::RenderPipelineDynamicState variant = base;
+      variant.setDepthCompareOp(vulkan::compareFunctionToVkCompareOp(func));
+      variant.depthWriteEnable_ = true;
+      variants.push_back(variant);
+    }
+    return variants;
+  }
+
+  // one draw per depth state
+  void renderDepthStates() const {
+    render([this](IRenderCommandEncoder& encoder) {
+      for (const auto& state : depthStencilStates_) {
+        encoder.bindDepthStencilState(state);
+        encoder.draw(3);
+      }
+    });
+  }
+
+  const vulkan::RenderPipelineState& getPipelineState() const {
+    return static_cast<const vulkan::RenderPipelineState&>(*pipelineState_);
+  }
+
+ protected:
+  std::vector<std::shared_ptr<IDepthStencilState>> depthStencilStates_;
+};
+
+TEST_F(PipelinePrecompileTest, SyncCompilesAreCounted) {
+  createDevice(false);
+  ASSERT_FALSE(HasFatalFailure());
+
+  context_->pipelineCompiler_->resetStats();
+
+  renderDepthStates();
+
+  const auto stats = context_->pipelineCompiler_->getStats();
+  EXPECT_EQ(stats.numSyncCompiles, kCompareFunctions.size());
+  EXPECT_EQ(stats.numStalls, kCompareFunctions.size());
+  EXPECT_EQ(stats.numAsyncCompiles, 0u);
+  EXPECT_LE(stats.maxStallNanoseconds, stats.totalStallNanoseconds);
+
+  RecordProperty("MaxStallMicroseconds", static_cast<int>(stats.maxStallNanoseconds / 1000u));
+}
+
+TEST_F(PipelinePrecompileTest, PrecompiledVariantsDoNotStall) {
+  createDevice(false);
+  ASSERT_FALSE(HasFatalFailure());
+
+  const std::vector<vulkan::RenderPipelineDynamicState> variants = getVariants();
+
+  context_->pipelineCompiler_->resetStats();
+
+  // duplicates are ignored
+  getPipelineState().precompile(variants);
+  getPipelineState().precompile(variants);
+  getPipelineState().waitForPendingPipelines();
+
+  for (const auto& variant : variants) {
+    EXPECT_TRUE(getPipelineState().isPipelineReady(variant));
+  }
+
+  renderDepthStates();
+
+  const auto stats = context_->pipelineCompiler_->getStats();
+  EXPECT_EQ(stats.numAsyncCompiles, variants.size());
+  EXPECT_EQ(stats.numSyncCompiles, 0u);
+  EXPECT_EQ(stats.numStalls, 0u);
+  EXPECT_EQ(stats.numSkippedDraws, 0u);
+}
+
+TEST_F(PipelinePrecompileTest, SkipDrawsWhileCompiling) {
+  createDevice(true);
+  ASSERT_FALSE(HasFatalFailure());
+
+  const std::vector<vulkan::RenderPipelineDynamicState> variants = getVariants();
+
+  context_->pipelineCompiler_->resetStats();
+
+  // render while the variants may still be compiling: every draw is either skipped or uses a
+  // finished pipeline, but the render thread never waits
+  getPipelineState().precompile(variants);
+  renderDepthStates();
+  getPipelineState().waitForPendingPipelines();
+
+  const auto stats = context_->pipelineCompiler_->getStats();
+  EXPECT_EQ(stats.numAsyncCompiles, variants.size());
+  EXPECT_EQ(stats.numSyncCompiles, 0u);
+  EXPECT_EQ(stats.numStalls, 0u);
+  EXPECT_LE(stats.numSkippedDraws, variants.size());
+
+  // all variants are ready now
+  context_->pipelineCompiler_->resetStats();
+  renderDepthStates();
+  EXPECT_EQ(context_->pipelineCompiler_->getStats().numSkippedDraws, 0u);
+}
+
+} // namespace igl::tests
+#endif
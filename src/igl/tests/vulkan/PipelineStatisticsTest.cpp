@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <gtest/gtest.h>
+#include <memory>
+
+#include <igl/CommandBuffer.h>
+#include <igl/QueryPool.h>
+#include <igl/tests/util/device/vulkan/RenderTestBase.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr uint32_t kNumDraws = 8;
+
+constexpr const char* kCodeFS = R"(
+layout (location=0) out vec4 out_FragColor;
+
+void main() {
+  out_FragColor = vec4(1.0);
+}
+)";
+
+} // namespace
+
+//
+// PipelineStatisticsTest
+//
+// Counts vertices and primitives of a few full-screen triangles with a pipeline statistics query.
+//
+class PipelineStatisticsTest : public util::device::vulkan::RenderTestBase {
+ public:
+  void SetUp() override {
+    RenderTestBase::SetUp();
+
+    ASSERT_NO_FATAL_FAILURE(createDevice(util::device::vulkan::getContextConfig(true)));
+    if (!device_->hasFeature(DeviceFeatures::PipelineStatisticsQueries)) {
+      GTEST_SKIP() << "Pipeline statistics queries are not supported";
+    }
+    ASSERT_NO_FATAL_FAILURE(createFramebuffer(kWidth, kHeight));
+    ASSERT_NO_FATAL_FAILURE(createPipeline(kCodeFS));
+  }
+};
+
+TEST_F(PipelineStatisticsTest, DrawCounts) {
+  Result ret;
+  auto pool = device_->createQueryPool(
+      {.type = QueryType::PipelineStatistics, .queryCount = 1, .debugName = "Statistics"}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  // the query has to be reset outside of the render pass
+  auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  cmdBuffer->resetQueries(*pool, 0, 1);
+  auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass_, framebuffer_, {}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  encoder->bindRenderPipelineState(pipelineState_);
+  encoder->beginQuery(*pool, 0);
+  for (uint32_t i = 0; i != kNumDraws; i++) {
+    encoder->draw(3);
+  }
+  encoder->endQuery(*pool, 0);
+  encoder->endEncoding();
+  cmdQueue_->submit(*cmdBuffer);
+  cmdBuffer->waitUntilCompleted();
+
+  PipelineStatistics stats;
+  ASSERT_TRUE(pool->getPipelineStatistics(0, 1, &stats));
+
+  RecordProperty("FragmentShaderInvocations", static_cast<int>(stats.fragmentShaderInvocations));
+
+  EXPECT_EQ(stats.inputAssemblyVertices, 3u * kNumDraws);
+  EXPECT_EQ(stats.inputAssemblyPrimitives, kNumDraws);
+  // vertex shader invocations may be reused or repeated by the implementation
+  EXPECT_GE(stats.vertexShaderInvocations, 1u);
+  EXPECT_GE(stats.fragmentShaderInvocations, 1u);
+  EXPECT_EQ(stats.computeShaderInvocations, 0u);
+}
+
+} // namespace igl::tests
+#endif
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include <igl/SamplerState.h>
+#include <igl/tests/util/device/vulkan/RenderTestBase.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr uint32_t kNumTextures = 16;
+constexpr uint32_t kNumDraws = 1024;
+
+// RGBA8: a different red channel for every texture
+uint32_t getTextureColor(uint32_t index) {
+  return 0xff000000u | (index * 0x10u + 0x0fu);
+}
+
+} // namespace
+
+//
+// PushDescriptorsTest
+//
+// Binds a different texture before every draw with and without VK_KHR_push_descriptor. The
+// parameter is VulkanContextConfig::enablePushDescriptors.
+//
+class PushDescriptorsTest : public util::device::vulkan::RenderTestBase,
+                            public ::testing::WithParamInterface<bool> {
+ public:
+  void SetUp() override {
+    RenderTestBase::SetUp();
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getContextConfig(true);
+    config.enablePushDescriptors = GetParam();
+    // measure the cost of allocating a descriptor set for every texture change
+    config.descriptorSetCacheSize = 0;
+    ASSERT_NO_FATAL_FAILURE(createDevice(config));
+
+    if (GetParam()) {
+      if (!context_->features().available(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME,
+                                          igl::vulkan::VulkanFeatures::ExtensionType::Device)) {
+        GTEST_SKIP() << "VK_KHR_push_descriptor is not supported";
+      }
+      // the extension is advertised, so it has to be enabled and used
+      ASSERT_TRUE(context_->features().has_VK_KHR_push_descriptor);
+      ASSERT_TRUE(context_->usePushDescriptors_);
+    } else {
+      ASSERT_FALSE(context_->usePushDescriptors_);
+    }
+
+    ASSERT_NO_FATAL_FAILURE(createFramebuffer(kWidth, kHeight));
+    ASSERT_NO_FATAL_FAILURE(createPipeline(kCodeTextureFS));
+
+    for (uint32_t i = 0; i != kNumTextures; i++) {
+      textures_.push_back(createSolidTexture(getTextureColor(i)));
+      ASSERT_TRUE(textures_.back() != nullptr);
+    }
+
+    Result ret;
+    sampler_ = device_->createSamplerState(SamplerStateDesc{}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+ protected:
+  std::vector<std::shared_ptr<ITexture>> textures_;
+  std::shared_ptr<ISamplerState> sampler_;
+};
+
+TEST_P(PushDescriptorsTest, TextureChurn) {
+  const size_t numAllocatedBefore = context_->numDescriptorSetsAllocated_;
+  const size_t numPushedBefore = context_->numDescriptorSetsPushed_;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  render([this](IRenderCommandEncoder& encoder) {
+    encoder.bindSamplerState(0, BindTarget::kFragment, sampler_.get());
+    for (uint32_t i = 0; i != kNumDraws; i++) {
+      encoder.bindTexture(0, BindTarget::kFragment, textures_[i % kNumTextures].get());
+      encoder.draw(3);
+    }
+  });
+  ASSERT_FALSE(HasFatalFailure());
+
+  const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+  const size_t numAllocated = context_->numDescriptorSetsAllocated_ - numAllocatedBefore;
+  const size_t numPushed = context_->numDescriptorSetsPushed_ - numPushedBefore;
+
+  RecordProperty("DrawsPerSecond", static_cast<int>(kNumDraws / seconds.count()));
+  RecordProperty("NumDescriptorSetsAllocated", static_cast<int>(numAllocated));
+  RecordProperty("NumDescriptorSetsPushed", static_cast<int>(numPushed));
+
+  if (GetParam()) {
+    EXPECT_EQ(numPushed, kNumDraws);
+    EXPECT_EQ(numAllocated, 0u);
+  } else {
+    EXPECT_EQ(numPushed, 0u);
+    EXPECT_GE(numAllocated, kNumDraws);
+  }
+
+  checkPixels(getTextureColor((kNumDraws - 1) % kNumTextures));
+}
+
+TEST_P(PushDescriptorsTest, BindGroup) {
+  Result ret;
+  BindGroupTextureDesc desc;
+  desc.textures[0] = textures_[3];
+  desc.samplers[0] = sampler_;
+  desc.debugName = "PushDescriptorsTest";
+  Holder<BindGroupTextureHandle> bindGroup =
+      device_->createBindGroup(desc, pipelineState_.get(), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  render([&bindGroup](IRenderCommandEncoder& encoder) {
+    encoder.bindBindGroup(bindGroup);
+    encoder.draw(3);
+  });
+  ASSERT_FALSE(HasFatalFailure());
+
+  checkPixels(getTextureColor(3));
+}
+
+INSTANTIATE_TEST_SUITE_P(PushDescriptors,
+                         PushDescriptorsTest,
+                         ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                           return info.param ? "Push" : "Pool";
+                         });
+
+} // namespace igl::tests
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include <igl/tests/util/device/vulkan/RenderTestBase.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+#include <igl/vulkan/VulkanUniformRingBuffer.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+constexpr uint32_t kNumDraws = 32;
+constexpr uint32_t kNumFrames = 3;
+
+constexpr const char* kCodeFS = R"(
+layout (location=0) out vec4 out_FragColor;
+
+layout (set = 1, binding = 0, std140) uniform PerDraw {
+  vec4 color;
+} perDraw;
+
+void main() {
+  out_FragColor = perDraw.color;
+}
+)";
+
+} // namespace
+
+//
+// UniformRingBufferTest
+//
+// Feeds per-draw uniforms through bindBytes(), which sub-allocates them from
+// VulkanContext::uniformRingBuffer_. The parameter selects whether the uniform buffer binding uses
+// a dynamic offset (RenderPipelineDesc::isDynamicBufferMask).
+//
+class UniformRingBufferTest : public util::device::vulkan::RenderTestBase,
+                              public ::testing::WithParamInterface<bool> {
+ public:
+  void SetUp() override {
+    RenderTestBase::SetUp();
+
+    ASSERT_NO_FATAL_FAILURE(createDevice(util::device::vulkan::getContextConfig(true)));
+    ASSERT_TRUE(context_->uniformRingBuffer_ != nullptr);
+    ASSERT_NO_FATAL_FAILURE(createFramebuffer(kWidth, kHeight));
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.isDynamicBufferMask = GetParam() ? 1u : 0u;
+    ASSERT_NO_FATAL_FAILURE(createPipeline(kCodeFS, pipelineDesc));
+  }
+
+  // one frame: a different color for every draw, the last one is magenta
+  void renderFrame() const {
+    render(
+        [](IRenderCommandEncoder& encoder) {
+          for (uint32_t i = 0; i != kNumDraws; i++) {
+            const float color[4] = {float(i + 1) / float(kNumDraws), 0.0f, 1.0f, 1.0f};
+            encoder.bindBytes(0, BindTarget::kFragment, color, sizeof(color));
+            encoder.draw(3);
+          }
+        },
+        true);
+  }
+};
+
+TEST_P(UniformRingBufferTest, BindBytes) {
+  context_->resetUniformRingBufferStats();
+  context_->resetDescriptorSetCacheStats();
+  const size_t numAllocatedBefore = context_->numDescriptorSetsAllocated_;
+
+  renderFrame();
+  ASSERT_FALSE(HasFatalFailure());
+
+  const size_t numAllocated = context_->numDescriptorSetsAllocated_ - numAllocatedBefore;
+  const auto stats = context_->getUniformRingBufferStats();
+
+  RecordProperty("PeakFrameBytes", static_cast<int>(stats.peakFrameBytes));
+  RecordProperty("DescriptorSetsAllocated", static_cast<int>(numAllocated));
+
+  EXPECT_EQ(stats.numAllocations, kNumDraws);
+  EXPECT_EQ(stats.numFailedAllocations, 0u);
+  EXPECT_GE(stats.lastFrameBytes, kNumDraws * 4 * sizeof(float));
+  EXPECT_EQ(stats.peakFrameBytes, stats.lastFrameBytes);
+  EXPECT_EQ(stats.peakBytesInUse, stats.lastFrameBytes);
+
+  if (GetParam()) {
+    // only the dynamic offset changes between draws
+    EXPECT_EQ(numAllocated, 1u);
+  } else {
+    EXPECT_EQ(numAllocated, kNumDraws);
+  }
+
+  // the last draw covers the whole framebuffer
+  checkPixels(0xffff00ffu);
+}
+
+TEST_P(UniformRingBufferTest, RecycleCompletedFrames) {
+  context_->resetUniformRingBufferStats();
+
+  for (uint32_t i = 0; i != kNumFrames; i++) {
+    renderFrame();
+    ASSERT_FALSE(HasFatalFailure());
+  }
+
+  const auto stats = context_->getUniformRingBufferStats();
+
+  EXPECT_EQ(stats.numAllocations, kNumFrames * kNumDraws);
+  EXPECT_EQ(stats.numFailedAllocations, 0u);
+  // every frame has completed before the next one started, so the memory was reused
+  EXPECT_EQ(stats.peakBytesInUse, stats.lastFrameBytes);
+  EXPECT_EQ(stats.peakFrameBytes, stats.lastFrameBytes);
+}
+
+TEST_P(UniformRingBufferTest, FullOfUnsubmittedAllocationsFails) {
+  // a small ring filled by a command buffer which is still being encoded
+  vulkan::VulkanUniformRingBuffer ring(*context_, 1024);
+  const auto& first = context_->immediate_->acquire();
+  const auto& second = context_->immediate_->acquire();
+  const std::vector<uint8_t> data(512);
+
+  EXPECT_TRUE(ring.allocate(data.data(), data.size(), first.handle_).valid());
+  EXPECT_TRUE(ring.allocate(data.data(), data.size(), first.handle_).valid());
+  // waiting for `first` would never return
+  EXPECT_FALSE(ring.allocate(data.data(), data.size(), second.handle_).valid());
+  EXPECT_EQ(ring.getStats().numFailedAllocations, 1u);
+
+  context_->immediate_->submit(first);
+  context_->immediate_->submit(second);
+  context_->immediate_->waitAll();
+
+  // the memory is reclaimed once `first` has completed
+  const auto& third = context_->immediate_->acquire();
+  EXPECT_TRUE(ring.allocate(data.data(), data.size(), third.handle_).valid());
+  context_->immediate_->submit(third);
+  context_->immediate_->waitAll();
+}
+
+INSTANTIATE_TEST_SUITE_P(UniformRingBuffer,
+                         UniformRingBufferTest,
+                         ::testing::Values(false, true),
+                         [](const ::testing::TestParamInfo<bool>& info) {
+                           return info.param ? "DynamicOffsets" : "DescriptorOffsets";
+                         });
+
+} // namespace igl::tests
+#endif
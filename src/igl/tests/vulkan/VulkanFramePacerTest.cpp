@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <gtest/gtest.h>
+#include <memory>
+
+#include <igl/CommandBuffer.h>
+#include <igl/CommandQueue.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderPass.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kWidth = 64;
+constexpr uint32_t kHeight = 64;
+constexpr uint32_t kNumFrames = 8;
+
+} // namespace
+
+//
+// VulkanFramePacerTest
+//
+// Ends offscreen frames with `submit(cmdBuffer, true)` and checks how many frames are in flight.
+//
+class VulkanFramePacerTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getContextConfig(true);
+    config.maxFramesInFlight = 1;
+
+    device_ = igl::tests::util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device_ != nullptr);
+    context_ = &static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+    ASSERT_TRUE(context_->framePacer_ != nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue({}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = device_->createTexture(
+        TextureDesc::new2D(
+            TextureFormat::RGBA_UNorm8, kWidth, kHeight, TextureDesc::TextureUsageBits::Attachment),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    framebuffer_ = device_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    renderPass_.colorAttachments.resize(1);
+    renderPass_.colorAttachments[0].loadAction = LoadAction::Clear;
+    renderPass_.colorAttachments[0].storeAction = StoreAction::Store;
+  }
+
+  // submits one frame and returns its SubmitHandle
+  vulkan::VulkanImmediateCommands::SubmitHandle renderFrame() const {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer({}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    auto encoder = cmdBuffer->createRenderCommandEncoder(renderPass_, framebuffer_, {}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    encoder->endEncoding();
+    return vulkan::VulkanImmediateCommands::SubmitHandle(cmdQueue_->submit(*cmdBuffer, true));
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  vulkan::VulkanContext* context_ = nullptr;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  RenderPassDesc renderPass_;
+};
+
+TEST_F(VulkanFramePacerTest, MaxFramesInFlight) {
+  auto& pacer = *context_->framePacer_;
+
+  EXPECT_EQ(pacer.getMaxFramesInFlight(), 1u);
+  pacer.setMaxFramesInFlight(100);
+  EXPECT_EQ(pacer.getMaxFramesInFlight(), vulkan::VulkanFramePacer::kMaxFramesInFlight);
+  pacer.setMaxFramesInFlight(0);
+  EXPECT_EQ(pacer.getMaxFramesInFlight(), 0u);
+  pacer.setMaxFramesInFlight(2);
+  EXPECT_EQ(pacer.getMaxFramesInFlight(), 2u);
+}
+
+TEST_F(VulkanFramePacerTest, WaitAfterSubmit) {
+  auto& pacer = *context_->framePacer_;
+  pacer.resetStats();
+
+  for (uint32_t i = 0; i != kNumFrames; i++) {
+    const auto handle = renderFrame();
+    // with one frame in flight, every frame has completed before the next one can start
+    EXPECT_TRUE(context_->immediate_->isReady(handle));
+  }
+
+  const auto stats = pacer.getStats();
+
+  RecordProperty("TotalWaitMicroseconds", static_cast<int>(stats.totalWaitNanos / 1000));
+
+  EXPECT_EQ(stats.numFrames, kNumFrames);
+  EXPECT_LE(stats.numFramesInFlight, 1u);
+  EXPECT_GE(stats.maxFrameWaitNanos, stats.lastFrameWaitNanos);
+  EXPECT_GE(stats.totalWaitNanos, stats.maxFrameWaitNanos);
+}
+
+TEST_F(VulkanFramePacerTest, LowLatencyMode) {
+  auto& pacer = *context_->framePacer_;
+  pacer.setLowLatencyMode(true);
+  pacer.resetStats();
+
+  for (uint32_t i = 0; i != kNumFrames; i++) {
+    const auto handle = renderFrame();
+    // the wait is postponed until the next frame begins
+    pacer.beginFrame();
+    EXPECT_TRUE(context_->immediate_->isReady(handle));
+  }
+
+  EXPECT_EQ(pacer.getStats().numFrames, kNumFrames);
+}
+
+} // namespace igl::tests
+#endif
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <igl/ComputePipelineState.h>
+#include <igl/ShaderCreator.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/ComputePipelineState.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanPipelineCache.h>
+
+namespace igl::tests {
+
+namespace {
+constexpr const char* kCodeCS = R"(
+layout (local_size_x = 1, local_size_y = 1, local_size_z = 1) in;
+
+layout (std430, binding = 0) buffer Data {
+  uint values[];
+} data;
+
+void main() {
+  data.values[gl_GlobalInvocationID.x] *= 2u;
+}
+)";
+} // namespace
+
+//
+// VulkanPipelineCacheTest
+//
+// Unit tests for igl::vulkan::VulkanPipelineCache
+//
+class VulkanPipelineCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    cachePath_ = (std::filesystem::temp_directory_path() /
+                  ("igl_pipeline_cache_" +
+                   std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) +
+                   ".bin"))
+                     .string();
+    std::error_code ec;
+    std::filesystem::remove(cachePath_, ec);
+  }
+
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove(cachePath_, ec);
+  }
+
+  std::shared_ptr<IDevice> createDevice(const char* cachePath) const {
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getContextConfig(true);
+    config.pipelineCacheFilePath = cachePath;
+    return igl::tests::util::device::vulkan::createTestDevice(config);
+  }
+
+  static vulkan::VulkanContext& getContext(IDevice& device) {
+    return static_cast<vulkan::Device&>(device).getVulkanContext();
+  }
+
+  // creates a compute pipeline and forces the creation of the underlying VkPipeline
+  static void createPipeline(IDevice& device) {
+    Result ret;
+    ComputePipelineDesc desc;
+    desc.shaderStages =
+        ShaderStagesCreator::fromModuleStringInput(device, kCodeCS, "main", "", &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    desc.debugName = "VulkanPipelineCacheTest";
+
+    auto pipelineState = device.createComputePipeline(desc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    ASSERT_TRUE(pipelineState != nullptr);
+
+    ASSERT_NE(static_cast<vulkan::ComputePipelineState&>(*pipelineState).getVkPipeline(),
+              VK_NULL_HANDLE);
+  }
+
+ protected:
+  std::string cachePath_;
+};
+
+TEST_F(VulkanPipelineCacheTest, IsCompatible) {
+  auto device = createDevice(nullptr);
+  ASSERT_TRUE(device != nullptr);
+  auto& ctx = getContext(*device);
+  const VkPhysicalDeviceProperties& props = ctx.getVkPhysicalDeviceProperties();
+
+  createPipeline(*device);
+
+  std::vector<uint8_t> data = ctx.getPipelineCacheData();
+  ASSERT_GE(data.size(), sizeof(VkPipelineCacheHeaderVersionOne));
+  EXPECT_TRUE(vulkan::VulkanPipelineCache::isCompatible(data.data(), data.size(), props));
+
+  // truncated
+  EXPECT_FALSE(vulkan::VulkanPipelineCache::isCompatible(
+      data.data(), sizeof(VkPipelineCacheHeaderVersionOne) - 1, props));
+  EXPECT_FALSE(vulkan::VulkanPipelineCache::isCompatible(nullptr, data.size(), props));
+
+  // a different device
+  VkPhysicalDeviceProperties otherProps = props;
+  otherProps.deviceID++;
+  EXPECT_FALSE(vulkan::VulkanPipelineCache::isCompatible(data.data(), data.size(), otherProps));
+
+  // a different driver build
+  otherProps = props;
+  otherProps.pipelineCacheUUID[0]++;
+  EXPECT_FALSE(vulkan::VulkanPipelineCache::isCompatible(data.data(), data.size(), otherProps));
+
+  // garbage
+  std::fill(data.begin(), data.end(), uint8_t(0xab));
+  EXPECT_FALSE(vulkan::VulkanPipelineCache::isCompatible(data.data(), data.size(), props));
+}
+
+TEST_F(VulkanPipelineCacheTest, SaveWithoutFilePath) {
+  auto device = createDevice(nullptr);
+  ASSERT_TRUE(device != nullptr);
+
+  EXPECT_FALSE(getContext(*device).savePipelineCache().isOk());
+}
+
+TEST_F(VulkanPipelineCacheTest, SaveAndLoad) {
+  {
+    auto device = createDevice(cachePath_.c_str());
+    ASSERT_TRUE(device != nullptr);
+    auto& ctx = getContext(*device);
+
+    // nothing to load on the first run
+    EXPECT_EQ(ctx.pipelineCache_->getStats().numBytesLoadedFromFile, 0u);
+
+    createPipeline(*device);
+
+    const Result result = ctx.savePipelineCache();
+    ASSERT_TRUE(result.isOk()) << result.message.c_str();
+    ASSERT_TRUE(std::filesystem::exists(cachePath_));
+    EXPECT_FALSE(std::filesystem::exists(cachePath_ + ".tmp"));
+
+    if (ctx.features().has_VK_EXT_pipeline_creation_feedback) {
+      const auto stats = ctx.pipelineCache_->getStats();
+      EXPECT_EQ(stats.numHits + stats.numMisses, 1u);
+    }
+  }
+  {
+    auto device = createDevice(cachePath_.c_str());
+    ASSERT_TRUE(device != nullptr);
+    auto& ctx = getContext(*device);
+
+    EXPECT_GT(ctx.pipelineCache_->getStats().numBytesLoadedFromFile, 0u);
+
+    createPipeline(*device);
+
+    if (ctx.features().has_VK_EXT_pipeline_creation_feedback) {
+      const auto stats = ctx.pipelineCache_->getStats();
+      EXPECT_EQ(stats.numHits + stats.numMisses, 1u);
+    }
+  }
+  // the cache is saved again when the context is destroyed
+  EXPECT_TRUE(std::filesystem::exists(cachePath_));
+}
+
+TEST_F(VulkanPipelineCacheTest, CorruptedFileIsIgnored) {
+  {
+    std::ofstream file(cachePath_, std::ios::out | std::ios::binary);
+    const std::vector<char> garbage(1024, 'x');
+    file.write(garbage.data(), static_cast<std::streamsize>(garbage.size()));
+  }
+
+  auto device = createDevice(cachePath_.c_str());
+  ASSERT_TRUE(device != nullptr);
+  auto& ctx = getContext(*device);
+
+  EXPECT_EQ(ctx.pipelineCache_->getStats().numBytesLoadedFromFile, 0u);
+
+  createPipeline(*device);
+
+  // the corrupted file is replaced
+  const Result result = ctx.savePipelineCache();
+  ASSERT_TRUE(result.isOk()) << result.message.c_str();
+  EXPECT_NE(std::filesystem::file_size(cachePath_), 1024u);
+}
+
+} // namespace igl::tests
+#endif
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Common.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include <igl/CommandQueue.h>
+#include <igl/Framebuffer.h>
+#include <igl/tests/util/device/vulkan/TestDevice.h>
+#include <igl/vulkan/Buffer.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanBuffer.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanStagingDevice.h>
+
+namespace igl::tests {
+
+namespace {
+// a tiny staging buffer makes it cheap to upload much more data than fits into it
+constexpr size_t kMaxStagingBufferSize = 1024u * 1024u;
+// room for two staging buffers of large uploads in flight
+constexpr size_t kMaxDedicatedStagingBufferSize = 2u * kMaxStagingBufferSize;
+constexpr uint32_t kTextureSize = 1024;
+constexpr uint32_t kReadbackRows = 64;
+} // namespace
+
+//
+// VulkanStagingDeviceTest
+//
+// Stress tests for asynchronous uploads through igl::vulkan::VulkanStagingDevice
+//
+class VulkanStagingDeviceTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    igl::vulkan::VulkanContextConfig config = util::device::vulkan::getContextConfig(true);
+    config.maxStagingBufferSize = kMaxStagingBufferSize;
+    config.maxDedicatedStagingBufferSize = kMaxDedicatedStagingBufferSize;
+
+    device_ = igl::tests::util::device::vulkan::createTestDevice(config);
+    ASSERT_TRUE(device_ != nullptr);
+    context_ = &static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+    ASSERT_TRUE(context_ != nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue({}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+ protected:
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  vulkan::VulkanContext* context_ = nullptr;
+};
+
+TEST_F(VulkanStagingDeviceTest, AsyncBufferUploads) {
+  vulkan::VulkanStagingDevice& stagingDevice = *context_->stagingDevice_;
+  ASSERT_LE(stagingDevice.getMaxStagingBufferSize(), kMaxStagingBufferSize);
+
+  const size_t kBufferSize = 8u * stagingDevice.getMaxStagingBufferSize();
+  constexpr uint32_t kNumUploads = 4;
+
+  BufferDesc bufferDesc;
+  bufferDesc.type = BufferDesc::BufferTypeBits::Storage;
+  bufferDesc.storage = ResourceStorage::Private;
+  bufferDesc.length = kBufferSize;
+
+  Result ret;
+  const std::shared_ptr<IBuffer> buffer = device_->createBuffer(bufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(buffer != nullptr);
+
+  vulkan::VulkanBuffer& vkBuffer = *static_cast<vulkan::Buffer&>(*buffer).currentVulkanBuffer();
+
+  stagingDevice.resetUploadStats();
+
+  std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t));
+  uint64_t worstCallNanoseconds = 0;
+
+  for (uint32_t upload = 0; upload != kNumUploads; upload++) {
+    for (size_t i = 0; i != data.size(); i++) {
+      data[i] = static_cast<uint32_t>(i * kNumUploads + upload);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto handle = stagingDevice.bufferSubData(vkBuffer, 0, kBufferSize, data.data());
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    worstCallNanoseconds = std::max(
+        worstCallNanoseconds,
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+
+    ASSERT_FALSE(handle.empty());
+    stagingDevice.waitForUpload(handle);
+    ASSERT_TRUE(stagingDevice.isUploadComplete(handle));
+  }
+
+  // the last upload wins
+  const auto* mappedData =
+      static_cast<const uint32_t*>(buffer->map(BufferRange(kBufferSize, 0), &ret));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  for (size_t i = 0; i != data.size(); i++) {
+    ASSERT_EQ(mappedData[i], data[i]) << "Mismatch at " << i;
+  }
+  buffer->unmap();
+
+  const auto& stats = stagingDevice.getUploadStats();
+  EXPECT_EQ(stats.numBytesUploaded, uint64_t(kNumUploads) * kBufferSize);
+  EXPECT_GE(stats.numSubmits,
+            kNumUploads * (kBufferSize / stagingDevice.getMaxStagingBufferSize()));
+  EXPECT_LE(stats.maxStallNanoseconds, stats.totalStallNanoseconds);
+  EXPECT_LE(stats.maxStallNanoseconds, worstCallNanoseconds);
+
+  RecordProperty("WorstUploadCallMicroseconds", static_cast<int>(worstCallNanoseconds / 1000u));
+  RecordProperty("WorstStallMicroseconds", static_cast<int>(stats.maxStallNanoseconds / 1000u));
+}
+
+TEST_F(VulkanStagingDeviceTest, BackToBackLargeBufferUploads) {
+  vulkan::VulkanStagingDevice& stagingDevice = *context_->stagingDevice_;
+
+  // every upload is larger than the staging buffer, and none of them is waited for before the next
+  const size_t kBufferSize = 4u * stagingDevice.getMaxStagingBufferSize();
+  constexpr uint32_t kNumBuffers = 4;
+
+  BufferDesc bufferDesc;
+  bufferDesc.type = BufferDesc::BufferTypeBits::Storage;
+  bufferDesc.storage = ResourceStorage::Private;
+  bufferDesc.length = kBufferSize;
+
+  Result ret;
+  std::vector<std::shared_ptr<IBuffer>> buffers;
+  std::vector<vulkan::VulkanImmediateCommands::SubmitHandle> handles;
+  std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t));
+
+  for (uint32_t b = 0; b != kNumBuffers; b++) {
+    buffers.push_back(device_->createBuffer(bufferDesc, &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    vulkan::VulkanBuffer& vkBuffer =
+        *static_cast<vulkan::Buffer&>(*buffers.back()).currentVulkanBuffer();
+
+    for (size_t i = 0; i != data.size(); i++) {
+      data[i] = static_cast<uint32_t>(i * kNumBuffers + b);
+    }
+    handles.push_back(stagingDevice.bufferSubData(vkBuffer, 0, kBufferSize, data.data()));
+    ASSERT_FALSE(handles.back().empty());
+  }
+
+  for (uint32_t b = 0; b != kNumBuffers; b++) {
+    stagingDevice.waitForUpload(handles[b]);
+    ASSERT_TRUE(stagingDevice.isUploadComplete(handles[b]));
+
+    const auto* mappedData =
+        static_cast<const uint32_t*>(buffers[b]->map(BufferRange(kBufferSize, 0), &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    for (size_t i = 0; i != data.size(); i++) {
+      ASSERT_EQ(mappedData[i], static_cast<uint32_t>(i * kNumBuffers + b)) << "Mismatch at " << i;
+    }
+    buffers[b]->unmap();
+  }
+}
+
+TEST_F(VulkanStagingDeviceTest, DedicatedStagingMemoryIsBounded) {
+  vulkan::VulkanStagingDevice& stagingDevice = *context_->stagingDevice_;
+  ASSERT_EQ(stagingDevice.getMaxDedicatedStagingBufferSize(), kMaxDedicatedStagingBufferSize);
+
+  // all uploads happen within one frame, i.e. without mergeRegionsAndFreeBuffers(), and together
+  // need much more staging memory than the limit
+  const size_t kBufferSize = 4u * stagingDevice.getMaxStagingBufferSize();
+  constexpr uint32_t kNumBuffers = 8;
+  ASSERT_GT(kNumBuffers * kBufferSize, 2u * kMaxDedicatedStagingBufferSize);
+
+  BufferDesc bufferDesc;
+  bufferDesc.type = BufferDesc::BufferTypeBits::Storage;
+  bufferDesc.storage = ResourceStorage::Private;
+  bufferDesc.length = kBufferSize;
+
+  Result ret;
+  std::vector<std::shared_ptr<IBuffer>> buffers;
+  std::vector<vulkan::VulkanImmediateCommands::SubmitHandle> handles;
+  std::vector<uint32_t> data(kBufferSize / sizeof(uint32_t));
+
+  for (uint32_t b = 0; b != kNumBuffers; b++) {
+    buffers.push_back(device_->createBuffer(bufferDesc, &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    vulkan::VulkanBuffer& vkBuffer =
+        *static_cast<vulkan::Buffer&>(*buffers.back()).currentVulkanBuffer();
+
+    for (size_t i = 0; i != data.size(); i++) {
+      data[i] = static_cast<uint32_t>(i * kNumBuffers + b);
+    }
+    handles.push_back(stagingDevice.bufferSubData(vkBuffer, 0, kBufferSize, data.data()));
+    ASSERT_FALSE(handles.back().empty());
+    EXPECT_LE(stagingDevice.getDedicatedStagingBufferSize(), kMaxDedicatedStagingBufferSize);
+  }
+
+  for (uint32_t b = 0; b != kNumBuffers; b++) {
+    stagingDevice.waitForUpload(handles[b]);
+
+    const auto* mappedData =
+        static_cast<const uint32_t*>(buffers[b]->map(BufferRange(kBufferSize, 0), &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    for (size_t i = 0; i != data.size(); i++) {
+      ASSERT_EQ(mappedData[i], static_cast<uint32_t>(i * kNumBuffers + b)) << "Mismatch at " << i;
+    }
+    buffers[b]->unmap();
+  }
+
+  // the dedicated staging buffers are freed at the end of the frame
+  stagingDevice.mergeRegionsAndFreeBuffers();
+  EXPECT_EQ(stagingDevice.getDedicatedStagingBufferSize(), 0u);
+}
+
+TEST_F(VulkanStagingDeviceTest, ChunkedImageUpload) {
+  vulkan::VulkanStagingDevice& stagingDevice = *context_->stagingDevice_;
+
+  const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                 kTextureSize,
+                                                 kTextureSize,
+                                                 TextureDesc::TextureUsageBits::Sampled |
+                                                     TextureDesc::TextureUsageBits::Attachment);
+  Result ret;
+  const std::shared_ptr<ITexture> texture = device_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const size_t kImageSize = size_t(kTextureSize) * kTextureSize * sizeof(uint32_t);
+  // the image is larger than a staging buffer and has to be split into chunks
+  ASSERT_GT(kImageSize, stagingDevice.getMaxStagingBufferSize());
+  ASSERT_GT(kImageSize, stagingDevice.getMaxImageChunkSize());
+
+  std::vector<uint32_t> pixels(size_t(kTextureSize) * kTextureSize);
+  for (size_t i = 0; i != pixels.size(); i++) {
+    pixels[i] = static_cast<uint32_t>(i) | 0xff000000u;
+  }
+
+  stagingDevice.resetUploadStats();
+
+  ret = texture->upload(TextureRangeDesc::new2D(0, 0, kTextureSize, kTextureSize), pixels.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const auto& stats = stagingDevice.getUploadStats();
+  EXPECT_EQ(stats.numBytesUploaded, kImageSize);
+  EXPECT_GE(stats.numSubmits, kImageSize / stagingDevice.getMaxImageChunkSize());
+
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = texture;
+  const std::shared_ptr<IFramebuffer> framebuffer =
+      device_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  // read back in bands small enough to fit into a staging buffer
+  std::vector<uint32_t> band(size_t(kTextureSize) * kReadbackRows);
+  for (uint32_t y = 0; y < kTextureSize; y += kReadbackRows) {
+    framebuffer->copyBytesColorAttachment(
+        *cmdQueue_, 0, band.data(), TextureRangeDesc::new2D(0, y, kTextureSize, kReadbackRows));
+    for (uint32_t row = 0; row != kReadbackRows; row++) {
+      // the Vulkan backend flips the data vertically on readback
+      const size_t srcRow = y + kReadbackRows - 1 - row;
+      for (uint32_t x = 0; x != kTextureSize; x++) {
+        ASSERT_EQ(band[size_t(row) * kTextureSize + x], pixels[srcRow * kTextureSize + x])
+            << "Mismatch at (" << x << ", " << srcRow << ")";
+      }
+    }
+  }
+}
+
+TEST_F(VulkanStagingDeviceTest, AsyncImageReadback) {
+  constexpr uint32_t kSize = 64;
+  const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                 kSize,
+                                                 kSize,
+                                                 TextureDesc::TextureUsageBits::Sampled |
+                                                     TextureDesc::TextureUsageBits::Attachment);
+  Result ret;
+  const std::shared_ptr<ITexture> texture = device_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  std::vector<uint32_t> pixels(size_t(kSize) * kSize);
+  for (size_t i = 0; i != pixels.size(); i++) {
+    pixels[i] = static_cast<uint32_t>(i) | 0xff000000u;
+  }
+  ret = texture->upload(TextureRangeDesc::new2D(0, 0, kSize, kSize), pixels.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = texture;
+  const std::shared_ptr<IFramebuffer> framebuffer =
+      device_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const auto range = TextureRangeDesc::new2D(0, 0, kSize, kSize);
+  std::vector<uint32_t> expected(pixels.size());
+  framebuffer->copyBytesColorAttachment(*cmdQueue_, 0, expected.data(), range);
+
+  // readbacks of the same size reuse the buffers of the previous ones
+  for (uint32_t frame = 0; frame != 3; frame++) {
+    auto readback = framebuffer->requestBytesColorAttachment(*cmdQueue_, 0, range, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    ASSERT_TRUE(readback != nullptr);
+
+    std::vector<uint32_t> actual(pixels.size());
+    ret = readback->copyBytes(actual.data());
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    EXPECT_TRUE(readback->isReady());
+    EXPECT_EQ(actual, expected);
+
+    // rows with padding
+    constexpr size_t kPaddedRowLength = kSize + 4;
+    std::vector<uint32_t> padded(kPaddedRowLength * kSize);
+    ret = readback->copyBytes(padded.data(), kPaddedRowLength * sizeof(uint32_t));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    for (size_t row = 0; row != kSize; row++) {
+      for (size_t x = 0; x != kSize; x++) {
+        ASSERT_EQ(padded[row * kPaddedRowLength + x], expected[row * kSize + x]);
+      }
+    }
+  }
+
+  auto readback = framebuffer->requestBytesColorAttachment(*cmdQueue_, 1, range, &ret);
+  EXPECT_FALSE(ret.isOk());
+  EXPECT_EQ(readback, nullptr);
+}
+
+} // namespace igl::tests
+#endif
@@ -11,6 +11,7 @@
 #include <igl/vulkan/Buffer.h>
 #include <igl/vulkan/ComputeCommandEncoder.h>
 #include <igl/vulkan/EnhancedShaderDebuggingStore.h>
+#include <igl/vulkan/QueryPool.h>
 #include <igl/vulkan/RenderCommandEncoder.h>
 #include <igl/vulkan/Texture.h>
 #include <igl/vulkan/VulkanContext.h>
@@ -33,6 +34,15 @@ std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder
     const std::shared_ptr<IFramebuffer>& framebuffer,
     const Dependencies& dependencies,
     Result* outResult) {
+  return createParallelRenderCommandEncoder(renderPass, framebuffer, dependencies, 0, outResult);
+}
+
+std::unique_ptr<RenderCommandEncoder> CommandBuffer::createParallelRenderCommandEncoder(
+    const RenderPassDesc& renderPass,
+    const std::shared_ptr<IFramebuffer>& framebuffer,
+    const Dependencies& dependencies,
+    uint32_t numSecondaryEncoders,
+    Result* outResult) {
   IGL_PROFILER_FUNCTION();
   IGL_DEBUG_ASSERT(framebuffer);
 
@@ -63,15 +73,22 @@ std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder
         VkImageSubresourceRange{flags, 0, VK_REMAINING_MIP_LEVELS, 0, VK_REMAINING_ARRAY_LAYERS});
   }
 
-  auto encoder = RenderCommandEncoder::create(
-      shared_from_this(), ctx_, renderPass, framebuffer, dependencies, outResult);
+  auto encoder = RenderCommandEncoder::create(shared_from_this(),
+                                              ctx_,
+                                              renderPass,
+                                              framebuffer,
+                                              dependencies,
+                                              numSecondaryEncoders,
+                                              outResult);
 
   if (encoder && ctx_.enhancedShaderDebuggingStore_) {
-    encoder->binder().bindBuffer(
-        EnhancedShaderDebuggingStore::kBufferIndex,
-        static_cast<Buffer*>(ctx_.enhancedShaderDebuggingStore_->vertexBuffer().get()),
-        0,
-        0);
+    auto* debugBuffer =
+        static_cast<Buffer*>(ctx_.enhancedShaderDebuggingStore_->vertexBuffer().get());
+    encoder->binder().bindBuffer(EnhancedShaderDebuggingStore::kBufferIndex, debugBuffer, 0, 0);
+    for (uint32_t i = 0; i != encoder->getNumSecondaryEncoders(); i++) {
+      encoder->getSecondaryEncoder(i).binder().bindBuffer(
+          EnhancedShaderDebuggingStore::kBufferIndex, debugBuffer, 0, 0);
+    }
   }
 
   return encoder;
@@ -255,6 +272,24 @@ void CommandBuffer::copyTextureToBuffer(ITexture& src,
                          range);
 }
 
+void CommandBuffer::resetQueries(IQueryPool& pool, uint32_t firstQuery, uint32_t queryCount) {
+  IGL_PROFILER_FUNCTION();
+
+  ctx_.vf_.vkCmdResetQueryPool(wrapper_.cmdBuf_,
+                               static_cast<QueryPool&>(pool).getVkQueryPool(),
+                               firstQuery,
+                               queryCount);
+}
+
+void CommandBuffer::writeTimestamp(IQueryPool& pool, uint32_t query) {
+  IGL_PROFILER_FUNCTION();
+
+  ctx_.vf_.vkCmdWriteTimestamp(wrapper_.cmdBuf_,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                               static_cast<QueryPool&>(pool).getVkQueryPool(),
+                               query);
+}
+
 void CommandBuffer::waitUntilCompleted() {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
 
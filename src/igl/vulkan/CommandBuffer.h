@@ -13,6 +13,7 @@
 
 namespace igl::vulkan {
 
+class RenderCommandEncoder;
 class VulkanContext;
 
 /// @brief This class implements the igl::ICommandBuffer interface for Vulkan
@@ -44,6 +45,21 @@ class CommandBuffer final : public ICommandBuffer,
       const Dependencies& dependencies,
       Result* outResult) override;
 
+  /** @brief Creates a RenderCommandEncoder with `numSecondaryEncoders` secondary encoders which can
+   * record the contents of the render pass in parallel on multiple threads. The returned encoder
+   * itself cannot record render commands. Secondary encoders are retrieved with
+   * `RenderCommandEncoder::getSecondaryEncoder()` and are executed in the order of their indices
+   * when the returned encoder ends encoding. Otherwise, this function behaves exactly like
+   * `createRenderCommandEncoder()`. No commands can be submitted to the context's queue while
+   * secondary encoders are being recorded.
+   */
+  std::unique_ptr<RenderCommandEncoder> createParallelRenderCommandEncoder(
+      const RenderPassDesc& renderPass,
+      const std::shared_ptr<IFramebuffer>& framebuffer,
+      const Dependencies& dependencies,
+      uint32_t numSecondaryEncoders,
+      Result* outResult);
+
   /** @brief Caches the texture passed in to the function for presentation later. Due to the
    * enhanced shader debugging functionality, the image cannot be presented here. It can only be
    * presented after the command buffer has been submitted, processed and then used by the enhanced
@@ -69,6 +85,10 @@ class CommandBuffer final : public ICommandBuffer,
                            uint32_t level,
                            uint32_t layer) override;
 
+  void resetQueries(IQueryPool& pool, uint32_t firstQuery, uint32_t queryCount) override;
+  /// @brief Writes the timestamp after all previously recorded commands have completed
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+
   /// @brief Waits until the command bufer has been executed by the device.
   void waitUntilCompleted() override;
 
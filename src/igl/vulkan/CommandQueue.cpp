@@ -32,7 +32,7 @@ std::shared_ptr<ICommandBuffer> CommandQueue::createCommandBuffer(const CommandB
   return std::make_shared<CommandBuffer>(device_.getVulkanContext(), desc);
 }
 
-SubmitHandle CommandQueue::submit(const ICommandBuffer& cmdBuffer, bool /* endOfFrame */) {
+SubmitHandle CommandQueue::submit(const ICommandBuffer& cmdBuffer, bool endOfFrame) {
   IGL_PROFILER_FUNCTION();
   VulkanContext& ctx = device_.getVulkanContext();
 
@@ -71,7 +71,9 @@ SubmitHandle CommandQueue::submit(const ICommandBuffer& cmdBuffer, bool /* endOf
 #endif // IGL_COMMAND_QUEUE_DEBUG_FENCES
 
   const bool presentIfNotDebugging = ctx.enhancedShaderDebuggingStore_ == nullptr;
-  auto submitHandle = endCommandBuffer(ctx, vkCmdBuffer, presentIfNotDebugging);
+  // with enhanced shader debugging, the frame ends when the debugging pass presents
+  auto submitHandle = endCommandBuffer(
+      ctx, vkCmdBuffer, presentIfNotDebugging, endOfFrame && presentIfNotDebugging);
 
   if (ctx.enhancedShaderDebuggingStore_) {
     ctx.enhancedShaderDebuggingStore_->enhancedShaderDebuggingPass(*this, vkCmdBuffer);
@@ -82,11 +84,13 @@ SubmitHandle CommandQueue::submit(const ICommandBuffer& cmdBuffer, bool /* endOf
 
 SubmitHandle CommandQueue::endCommandBuffer(VulkanContext& ctx,
                                             CommandBuffer* cmdBuffer,
-                                            bool present) {
+                                            bool present,
+                                            bool endOfFrame) {
   IGL_PROFILER_FUNCTION();
 
   // Submit to the graphics queue.
   const bool shouldPresent = ctx.hasSwapchain() && cmdBuffer->isFromSwapchain() && present;
+  uint64_t timelineValue = 0;
   if (shouldPresent) {
     if (ctx.timelineSemaphore_) {
       // if we are presenting a swapchain image, signal our timeline semaphore
@@ -95,6 +99,7 @@ SubmitHandle CommandQueue::endCommandBuffer(VulkanContext& ctx,
       // we wait for this value next time we want to acquire this swapchain image
       ctx.swapchain_->timelineWaitValues_[ctx.swapchain_->getCurrentImageIndex()] = signalValue;
       ctx.immediate_->signalSemaphore(ctx.timelineSemaphore_->getVkSemaphore(), signalValue);
+      timelineValue = signalValue;
     } else {
       // this can be removed once we switch to timeline semaphores
       ctx.immediate_->waitSemaphore(ctx.swapchain_->getSemaphore());
@@ -110,6 +115,14 @@ SubmitHandle CommandQueue::endCommandBuffer(VulkanContext& ctx,
   ctx.processDeferredTasks();
   ctx.stagingDevice_->mergeRegionsAndFreeBuffers();
 
+  if (shouldPresent || endOfFrame) {
+    if (ctx.uniformRingBuffer_) {
+      ctx.uniformRingBuffer_->endFrame();
+    }
+    // this can wait for the GPU, so it goes last
+    ctx.framePacer_->endFrame(cmdBuffer->lastSubmitHandle_, timelineValue);
+  }
+
   return cmdBuffer->lastSubmitHandle_.handle();
 }
 
@@ -41,7 +41,8 @@ class CommandQueue final : public ICommandQueue {
   /// by calling `enhancedShaderDebuggingPass()`. If the enhanced shader debugging is enabled,
   /// presenting the image is disabled.
   /// @param cmdBuffer The command buffer to be submitted.
-  /// @param endOfFrame Not used
+  /// @param endOfFrame Marks the end of a frame for VulkanContext::framePacer_ and
+  /// VulkanContext::getUniformRingBufferStats(). Presenting always ends a frame.
   SubmitHandle submit(const ICommandBuffer& cmdBuffer, bool endOfFrame = false) override;
 
   /** @brief Ends the current command buffer and resets the internal flag tracking an active command
@@ -50,10 +51,15 @@ class CommandQueue final : public ICommandQueue {
    * swapchain (please refer to CommandBuffer::present), and (4) the present parameter is true. If
    * so, this function waits for the swapchain semaphore before submitting the command buffer for
    * execution. After the command buffer is submitted, this function calls VulkanContext::present()
-   * if an image should be presented. Finally, it signals the context to process deferred tasks (for
+   * if an image should be presented. Then, it signals the context to process deferred tasks (for
    * more details about deferred tasks, please refer to the igl::vulkan::VulkanContext class).
+   * Finally, if an image was presented or `endOfFrame` is true, it ends the frame, which may wait
+   * for the GPU (see VulkanFramePacer).
    */
-  SubmitHandle endCommandBuffer(VulkanContext& ctx, CommandBuffer* cmdBuffer, bool present);
+  SubmitHandle endCommandBuffer(VulkanContext& ctx,
+                                CommandBuffer* cmdBuffer,
+                                bool present,
+                                bool endOfFrame = false);
 
  private:
   Device& device_;
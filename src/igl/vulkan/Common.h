@@ -127,6 +127,13 @@ struct VulkanContextConfig {
   bool enableDualSrcBlend = true;
   bool enableGfxReconstruct = false;
   bool enableMultiviewPerViewViewports = false;
+  // Use VK_EXT_extended_dynamic_state and VK_EXT_extended_dynamic_state2 (if available) to set
+  // depth/stencil state and depth bias enable dynamically instead of creating a separate pipeline
+  // for every combination
+  bool enableExtendedDynamicState = true;
+  // Use VK_KHR_push_descriptor (if available) to update combined image samplers directly in the
+  // command buffer instead of allocating and writing a new descriptor set for every change
+  bool enablePushDescriptors = true;
 
   ColorSpace swapChainColorSpace = igl::ColorSpace::SRGB_NONLINEAR;
   TextureFormat requestedSwapChainTextureFormat = igl::TextureFormat::RGBA_UNorm8;
@@ -134,10 +141,25 @@ struct VulkanContextConfig {
   // the number of resources to support BufferAPIHintBits::Ring
   uint32_t maxResourceCount = 3u;
 
+  // The number of frames the CPU can get ahead of the GPU, in [1, 4]. Passing 0 leaves it to the
+  // swapchain (one frame per swapchain image). Can be changed at runtime through
+  // VulkanContext::framePacer_.
+  uint32_t maxFramesInFlight = 0;
+
+  // Wait for the GPU at the start of a frame (VulkanFramePacer::beginFrame() or the swapchain image
+  // acquisition) instead of right after the previous frame was submitted. This lets applications
+  // sample their input after the wait.
+  bool lowLatencyMode = false;
+
   // owned by the application - should be alive until initContext() returns
   const void* pipelineCacheData = nullptr;
   size_t pipelineCacheDataSize = 0;
 
+  // If set, the pipeline cache is loaded from this file in initContext() (merged with
+  // `pipelineCacheData`, if any) and saved back to it when the context is destroyed. Data created
+  // by a different device or driver is ignored. Should be alive until initContext() returns.
+  const char* IGL_NULLABLE pipelineCacheFilePath = nullptr;
+
   // This enables fences generated at the end of submission to be exported to the client.
   // The client can then use the SubmitHandle to wait for the completion of the GPU work.
   bool exportableFences = false;
@@ -155,6 +177,36 @@ struct VulkanContextConfig {
   // Specifies a default fence timeout value.
   uint64_t fenceTimeoutNanoseconds = UINT64_MAX;
 
+  // Upper bound for the size of a single staging buffer used by VulkanStagingDevice. Passing 0
+  // uses the default value (256 MB). The value is always clamped to
+  // VkPhysicalDeviceLimits::maxStorageBufferRange. Images larger than this are uploaded in chunks.
+  size_t maxStagingBufferSize = 0;
+
+  // Upper bound for the total size of the staging buffers which VulkanStagingDevice allocates for
+  // uploads larger than a chunk while they are in flight. Once it is reached, further uploads wait
+  // for the oldest of those buffers. Passing 0 uses the maximum size of a single staging buffer.
+  size_t maxDedicatedStagingBufferSize = 0;
+
+  // Number of worker threads used by RenderPipelineState::precompile(). Passing 0 picks a default
+  // based on the number of hardware threads. The threads are only started when needed.
+  uint32_t numPipelineCompileThreads = 0;
+
+  // If a draw call needs a pipeline which is still being built in the background, skip the draw
+  // instead of waiting for the pipeline to be ready.
+  bool skipDrawsWhileCompilingPipelines = false;
+
+  // Maximum number of descriptor sets cached per descriptor set layout. A cached descriptor set is
+  // reused when the same textures/buffers are bound again, instead of allocating and writing a new
+  // one. Cached sets are dropped when their descriptor pool is recycled. Passing 0 disables the
+  // cache.
+  uint32_t descriptorSetCacheSize = 64;
+
+  // Size of the persistently mapped buffer which backs bindBytes(). Data passed to bindBytes() is
+  // sub-allocated from it and recycled once the command buffer which used it has completed. Use
+  // VulkanContext::getUniformRingBufferStats() to find a suitable size. Passing 0 disables
+  // bindBytes().
+  size_t uniformRingBufferSize = 1024 * 1024;
+
   size_t numExtraInstanceExtensions = 0;
   const char* IGL_NULLABLE* IGL_NULLABLE extraInstanceExtensions = nullptr;
 
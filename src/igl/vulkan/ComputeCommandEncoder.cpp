@@ -9,6 +9,7 @@
 
 #include <igl/vulkan/Buffer.h>
 #include <igl/vulkan/ComputePipelineState.h>
+#include <igl/vulkan/QueryPool.h>
 #include <igl/vulkan/SamplerState.h>
 #include <igl/vulkan/Texture.h>
 #include <igl/vulkan/VulkanContext.h>
@@ -167,6 +168,27 @@ void ComputeCommandEncoder::popDebugGroupLabel() const {
   ivkCmdEndDebugUtilsLabel(&ctx_.vf_, cmdBuffer_);
 }
 
+void ComputeCommandEncoder::writeTimestamp(IQueryPool& pool, uint32_t query) {
+  IGL_PROFILER_FUNCTION();
+
+  ctx_.vf_.vkCmdWriteTimestamp(cmdBuffer_,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                               static_cast<QueryPool&>(pool).getVkQueryPool(),
+                               query);
+}
+
+void ComputeCommandEncoder::beginQuery(IQueryPool& pool, uint32_t query) {
+  IGL_PROFILER_FUNCTION();
+
+  ctx_.vf_.vkCmdBeginQuery(cmdBuffer_, static_cast<QueryPool&>(pool).getVkQueryPool(), query, 0);
+}
+
+void ComputeCommandEncoder::endQuery(IQueryPool& pool, uint32_t query) {
+  IGL_PROFILER_FUNCTION();
+
+  ctx_.vf_.vkCmdEndQuery(cmdBuffer_, static_cast<QueryPool&>(pool).getVkQueryPool(), query);
+}
+
 void ComputeCommandEncoder::bindUniform(const UniformDesc& /*uniformDesc*/, const void* /*data*/) {
   // DO NOT IMPLEMENT!
   // This is only for backends that MUST use single uniforms in some situations.
@@ -261,8 +283,23 @@ void ComputeCommandEncoder::bindBuffer(uint32_t index,
   binder_.bindBuffer(index, buf, offset, bufferSize);
 }
 
-void ComputeCommandEncoder::bindBytes(uint32_t /*index*/, const void* /*data*/, size_t /*length*/) {
-  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+void ComputeCommandEncoder::bindBytes(uint32_t index, const void* data, size_t length) {
+  IGL_PROFILER_FUNCTION();
+
+  if (!IGL_DEBUG_VERIFY(ctx_.uniformRingBuffer_,
+                        "bindBytes() requires VulkanContextConfig::uniformRingBufferSize > 0")) {
+    return;
+  }
+
+  // the data is kept alive until the command buffer completes
+  const VulkanUniformRingBuffer::Allocation alloc =
+      ctx_.uniformRingBuffer_->allocate(data, length, binder_.nextSubmitHandle_);
+
+  if (!alloc.valid()) {
+    return;
+  }
+
+  binder_.bindUniformBufferRange(index, alloc.buffer, alloc.offset, alloc.size);
 }
 
 void ComputeCommandEncoder::bindPushConstants(const void* data, size_t length, size_t offset) {
@@ -46,6 +46,11 @@ class ComputeCommandEncoder : public IComputeCommandEncoder {
   void insertDebugEventLabel(const char* label, const igl::Color& color) const override;
   void popDebugGroupLabel() const override;
 
+  /// @brief Writes the timestamp after all previously recorded commands have completed
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+  void beginQuery(IQueryPool& pool, uint32_t query) override;
+  void endQuery(IQueryPool& pool, uint32_t query) override;
+
   /// @brief This is only for backends that MUST use single uniforms in some situations. Do not
   /// implement!
   void bindUniform(const UniformDesc& uniformDesc, const void* data) override;
@@ -101,6 +101,7 @@ VkPipeline ComputePipelineState::getVkPipeline() const {
 
   const auto& shaderModule = desc_.shaderStages->getComputeModule();
 
+  VkPipelineCreationFeedbackEXT feedback = {};
   VulkanComputePipelineBuilder()
       .shaderStage(ivkGetPipelineShaderStageCreateInfo(
           VK_SHADER_STAGE_COMPUTE_BIT,
@@ -108,10 +109,13 @@ VkPipeline ComputePipelineState::getVkPipeline() const {
           shaderModule->info().entryPoint.c_str()))
       .build(ctx.vf_,
              ctx.device_->getVkDevice(),
-             ctx.pipelineCache_,
+             ctx.pipelineCache_->getVkPipelineCache(),
              pipelineLayout_,
              &pipeline_,
-             desc_.debugName.c_str());
+             desc_.debugName.c_str(),
+             ctx.features().has_VK_EXT_pipeline_creation_feedback ? &feedback : nullptr);
+
+  ctx.pipelineCache_->recordCreationFeedback(feedback.flags);
 
   return pipeline_;
 }
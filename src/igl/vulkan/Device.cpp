@@ -17,6 +17,7 @@
 #include <igl/vulkan/EnhancedShaderDebuggingStore.h>
 #include <igl/vulkan/Framebuffer.h>
 #include <igl/vulkan/PlatformDevice.h>
+#include <igl/vulkan/QueryPool.h>
 #include <igl/vulkan/RenderPipelineState.h>
 #include <igl/vulkan/SamplerState.h>
 #include <igl/vulkan/ShaderModule.h>
@@ -525,6 +526,36 @@ std::shared_ptr<IFramebuffer> Device::createFramebufferInternal(const Framebuffe
   return resource;
 }
 
+std::shared_ptr<IQueryPool> Device::createQueryPoolInternal(const QueryPoolDesc& desc,
+                                                            Result* IGL_NULLABLE outResult) const {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+  IGL_ENSURE_VULKAN_CONTEXT_THREAD(ctx_);
+
+  const DeviceFeatures feature = desc.type == QueryType::Timestamp
+                                     ? DeviceFeatures::TimestampQueries
+                                     : DeviceFeatures::PipelineStatisticsQueries;
+  if (!hasFeatureInternal(feature)) {
+    Result::setResult(outResult, Result::Code::Unsupported, "Query type is not supported");
+    return nullptr;
+  }
+
+  auto resource = std::make_shared<QueryPool>(*ctx_, desc);
+
+  const Result result = resource->create();
+  if (!result.isOk()) {
+    Result::setResult(outResult, result);
+    return nullptr;
+  }
+  Result::setOk(outResult);
+
+  if (hasResourceTracker()) {
+    resource->initResourceTracker(getResourceTracker(), desc.debugName);
+  }
+
+  return resource;
+}
+
 const PlatformDevice& Device::getPlatformDeviceInternal() const noexcept {
   return platformDevice_;
 }
@@ -690,6 +721,10 @@ bool Device::hasFeatureInternal(DeviceFeatures feature) const {
     return ctx_->areValidationLayersEnabled();
   case DeviceFeatures::TextureViews:
     return true;
+  case DeviceFeatures::TimestampQueries:
+    return deviceProperties.limits.timestampComputeAndGraphics == VK_TRUE;
+  case DeviceFeatures::PipelineStatisticsQueries:
+    return ctx_->features().vkPhysicalDeviceFeatures2.features.pipelineStatisticsQuery == VK_TRUE;
   }
 
   IGL_DEBUG_ABORT("DeviceFeatures value not handled: %d", (int)feature);
@@ -90,6 +90,10 @@ class Device final : public IDevice {
                                                                 Result* IGL_NULLABLE
                                                                     outResult) override;
 
+  [[nodiscard]] std::shared_ptr<IQueryPool> createQueryPool(const QueryPoolDesc& desc,
+                                                            Result* IGL_NULLABLE
+                                                                outResult) const override;
+
   // Platform-specific extensions
   [[nodiscard]] const PlatformDevice& getPlatformDevice() const noexcept override;
 
@@ -176,6 +180,9 @@ class Device final : public IDevice {
   std::shared_ptr<IFramebuffer> createFramebufferInternal(const FramebufferDesc& desc,
                                                           Result* IGL_NULLABLE outResult);
 
+  std::shared_ptr<IQueryPool> createQueryPoolInternal(const QueryPoolDesc& desc,
+                                                      Result* IGL_NULLABLE outResult) const;
+
   // Platform-specific extensions
   [[nodiscard]] const PlatformDevice& getPlatformDeviceInternal() const noexcept;
 
@@ -297,6 +304,12 @@ void inline Device::destroy(SamplerHandle handle) {
   return createFramebufferInternal(desc, outResult);
 }
 
+[[nodiscard]] inline std::shared_ptr<IQueryPool> Device::createQueryPool(
+    const QueryPoolDesc& desc,
+    Result* IGL_NULLABLE outResult) const {
+  return createQueryPoolInternal(desc, outResult);
+}
+
 // Platform-specific extensions
 [[nodiscard]] inline const PlatformDevice& Device::getPlatformDevice() const noexcept {
   return getPlatformDeviceInternal();
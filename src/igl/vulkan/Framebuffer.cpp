@@ -12,7 +12,9 @@
 #include <igl/vulkan/CommandBuffer.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/Device.h>
+#include <igl/vulkan/FramebufferReadback.h>
 #include <igl/vulkan/Texture.h>
+#include <igl/vulkan/VulkanBuffer.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanDevice.h>
 #include <igl/vulkan/VulkanFramebuffer.h>
@@ -106,6 +108,54 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* Not Used */,
                                      true); // Flip the image vertically
 }
 
+std::shared_ptr<IFramebufferReadback> Framebuffer::requestBytesColorAttachment(
+    ICommandQueue& /* Not Used */,
+    size_t index,
+    const TextureRangeDesc& range,
+    Result* IGL_NULLABLE outResult) const {
+  IGL_DEBUG_ASSERT(range.numFaces == 1, "range.numFaces MUST be 1");
+  IGL_DEBUG_ASSERT(range.numLayers == 1, "range.numLayers MUST be 1");
+  IGL_DEBUG_ASSERT(range.numMipLevels == 1, "range.numMipLevels MUST be 1");
+  IGL_PROFILER_FUNCTION();
+
+  const auto& itexture = getColorAttachment(index);
+  if (!itexture) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "No color attachment at index");
+    return nullptr;
+  }
+
+  // If we're doing MSAA, we should be using the resolve color attachment
+  const auto& vkTex = static_cast<Texture&>(
+      itexture->getSamples() == 1 ? *itexture : *getResolveColorAttachment(index));
+  const VkRect2D imageRegion = {
+      VkOffset2D{static_cast<int32_t>(range.x), static_cast<int32_t>(range.y)},
+      VkExtent2D{range.width, range.height},
+  };
+  const auto& properties = vkTex.getProperties();
+  const size_t size = properties.getBytesPerRange(
+      TextureRangeDesc::new2D(0, 0, range.width, range.height));
+
+  VulkanContext& ctx = device_.getVulkanContext();
+  VulkanStagingDevice& stagingDevice = *ctx.stagingDevice_;
+  std::unique_ptr<VulkanBuffer> buffer = stagingDevice.acquireReadbackBuffer(size);
+  if (!buffer || !buffer->getMappedPtr()) {
+    Result::setResult(outResult, Result::Code::RuntimeError, "Failed to create a readback buffer");
+    return nullptr;
+  }
+
+  const auto handle =
+      stagingDevice.requestImageData2D(vkTex.getVkImage(),
+                                       range.mipLevel,
+                                       getVkLayer(itexture->getType(), range.face, range.layer),
+                                       imageRegion,
+                                       vkTex.getVulkanTexture().image_.imageLayout_,
+                                       vkTex.getVulkanTexture().imageView_.getVkImageAspectFlags(),
+                                       *buffer);
+
+  Result::setOk(outResult);
+  return std::make_shared<FramebufferReadback>(ctx, std::move(buffer), handle, properties, range);
+}
+
 void Framebuffer::copyBytesDepthAttachment(ICommandQueue& /*cmdQueue*/,
                                            void* /*pixelBytes*/,
                                            const TextureRangeDesc& /*range*/,
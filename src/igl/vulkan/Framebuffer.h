@@ -45,6 +45,16 @@ class Framebuffer final : public IFramebuffer {
                                 const TextureRangeDesc& range,
                                 size_t bytesPerRow = 0) const override;
 
+  /// @brief Records a copy of the color attachment into a pooled readback buffer and returns
+  /// without waiting for the GPU. The handle is ready once the SubmitHandle of the copy is
+  /// signaled (see FramebufferReadback). Like `copyBytesColorAttachment()`, it copies one face,
+  /// one layer, and one mip level, and the pixels are flipped vertically.
+  std::shared_ptr<IFramebufferReadback> requestBytesColorAttachment(
+      ICommandQueue& cmdQueue,
+      size_t index,
+      const TextureRangeDesc& range,
+      Result* IGL_NULLABLE outResult = nullptr) const override;
+
   /// @brief Not implemented.
   void copyBytesDepthAttachment(ICommandQueue& cmdQueue,
                                 void* pixelBytes,
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/FramebufferReadback.h>
+
+#include <utility>
+#include <igl/vulkan/VulkanBuffer.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanStagingDevice.h>
+
+namespace igl::vulkan {
+
+FramebufferReadback::FramebufferReadback(VulkanContext& ctx,
+                                         std::unique_ptr<VulkanBuffer> buffer,
+                                         VulkanImmediateCommands::SubmitHandle handle,
+                                         TextureFormatProperties properties,
+                                         const TextureRangeDesc& range) :
+  ctx_(ctx),
+  buffer_(std::move(buffer)),
+  handle_(handle),
+  properties_(properties),
+  range_(TextureRangeDesc::new2D(0, 0, range.width, range.height)) {}
+
+FramebufferReadback::~FramebufferReadback() {
+  // the buffer is only reused once the copy has finished
+  ctx_.stagingDevice_->releaseReadbackBuffer(std::move(buffer_), handle_);
+}
+
+bool FramebufferReadback::isReady() const {
+  return ctx_.stagingDevice_->isUploadComplete(handle_);
+}
+
+Result FramebufferReadback::copyBytes(void* pixelBytes, size_t bytesPerRow) {
+  IGL_PROFILER_FUNCTION();
+  if (!IGL_DEBUG_VERIFY(pixelBytes)) {
+    return Result(Result::Code::ArgumentNull, "pixelBytes is null");
+  }
+  const size_t packedBytesPerRow = properties_.getBytesPerRow(range_);
+  if (bytesPerRow == 0) {
+    bytesPerRow = packedBytesPerRow;
+  } else if (bytesPerRow < packedBytesPerRow) {
+    return Result(Result::Code::ArgumentOutOfRange, "bytesPerRow is too small");
+  }
+  if (!IGL_DEBUG_VERIFY(buffer_->getMappedPtr())) {
+    return Result(Result::Code::RuntimeError, "The readback buffer is not mapped");
+  }
+
+  ctx_.stagingDevice_->waitForUpload(handle_);
+  if (!buffer_->isCoherentMemory()) {
+    // a reused readback buffer can be larger than the range
+    buffer_->invalidateMappedMemory(0, properties_.getBytesPerRange(range_));
+  }
+
+  ITexture::repackData(properties_,
+                       range_,
+                       buffer_->getMappedPtr(),
+                       0,
+                       static_cast<uint8_t*>(pixelBytes),
+                       bytesPerRow,
+                       true); // Flip the image vertically
+  return Result();
+}
+
+} // namespace igl::vulkan
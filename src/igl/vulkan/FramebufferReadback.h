@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <igl/Framebuffer.h>
+#include <igl/Texture.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+
+namespace igl::vulkan {
+
+class VulkanBuffer;
+class VulkanContext;
+
+/// @brief A copy of a color attachment into a pooled readback buffer, see
+/// Framebuffer::requestBytesColorAttachment().
+/// isReady() polls the SubmitHandle of the copy without waiting, and copyBytes() waits for it and
+/// copies the pixels out, flipped vertically like Framebuffer::copyBytesColorAttachment(). The
+/// buffer goes back to the VulkanStagingDevice when the readback is destroyed, which must happen
+/// before the context is destroyed.
+class FramebufferReadback final : public IFramebufferReadback {
+ public:
+  FramebufferReadback(VulkanContext& ctx,
+                      std::unique_ptr<VulkanBuffer> buffer,
+                      VulkanImmediateCommands::SubmitHandle handle,
+                      TextureFormatProperties properties,
+                      const TextureRangeDesc& range);
+  ~FramebufferReadback() override;
+
+  [[nodiscard]] bool isReady() const override;
+  Result copyBytes(void* pixelBytes, size_t bytesPerRow = 0) override;
+
+ private:
+  VulkanContext& ctx_;
+  std::unique_ptr<VulkanBuffer> buffer_;
+  VulkanImmediateCommands::SubmitHandle handle_;
+  TextureFormatProperties properties_;
+  // the range of the pixels in the buffer, which starts at (0, 0)
+  TextureRangeDesc range_;
+};
+
+} // namespace igl::vulkan
@@ -75,7 +75,8 @@ PipelineState::PipelineState(
     IShaderStages* stages,
     std::shared_ptr<ISamplerState> immutableSamplers[IGL_TEXTURE_SAMPLERS_MAX],
     uint32_t isDynamicBufferMask,
-    const char* debugName) {
+    const char* debugName) :
+  isDynamicBufferMask_(isDynamicBufferMask) {
   IGL_DEBUG_ASSERT(stages);
 
   initializeSpvModuleInfoFromShaderStages(ctx, stages);
@@ -98,7 +99,8 @@ PipelineState::PipelineState(
     std::vector<VkDescriptorBindingFlags> bindingFlags(bindings.size());
     dslCombinedImageSamplers_ = std::make_unique<VulkanDescriptorSetLayout>(
         ctx,
-        VkDescriptorSetLayoutCreateFlags{},
+        ctx.usePushDescriptors_ ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR
+                                : VkDescriptorSetLayoutCreateFlags{},
         static_cast<uint32_t>(bindings.size()),
         bindings.data(),
         bindingFlags.data(),
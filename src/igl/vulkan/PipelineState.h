@@ -46,6 +46,9 @@ class PipelineState {
  public:
   igl::vulkan::util::SpvModuleInfo info_;
 
+  // buffer bindings which use VK_DESCRIPTOR_TYPE_(UNIFORM|STORAGE)_BUFFER_DYNAMIC descriptors
+  const uint32_t isDynamicBufferMask_ = 0;
+
   VkPushConstantRange pushConstantRange_ = {};
   VkShaderStageFlags stageFlags_ = 0;
 
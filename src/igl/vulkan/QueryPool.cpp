@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/QueryPool.h>
+
+#include <algorithm>
+#include <vector>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace {
+
+constexpr uint32_t kNumPipelineStatistics = 6;
+
+static_assert(sizeof(igl::PipelineStatistics) == kNumPipelineStatistics * sizeof(uint64_t));
+
+} // namespace
+
+namespace igl::vulkan {
+
+QueryPool::QueryPool(const VulkanContext& ctx, const QueryPoolDesc& desc) :
+  IQueryPool(desc), ctx_(ctx) {}
+
+QueryPool::~QueryPool() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_DESTROY);
+
+  if (vkQueryPool_ != VK_NULL_HANDLE) {
+    ctx_.deferredTask(std::packaged_task<void()>(
+        [vf = &ctx_.vf_, device = ctx_.getVkDevice(), pool = vkQueryPool_]() {
+          vf->vkDestroyQueryPool(device, pool, nullptr);
+        }));
+  }
+}
+
+Result QueryPool::create() {
+  if (desc_.queryCount == 0) {
+    return Result(Result::Code::ArgumentInvalid, "queryCount must be greater than zero");
+  }
+
+  const bool isTimestamp = desc_.type == QueryType::Timestamp;
+
+  const VkQueryPoolCreateInfo ci = {
+      .sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .queryType = isTimestamp ? VK_QUERY_TYPE_TIMESTAMP : VK_QUERY_TYPE_PIPELINE_STATISTICS,
+      .queryCount = desc_.queryCount,
+      .pipelineStatistics = isTimestamp ? 0 : kPipelineStatisticsFlags,
+  };
+
+  if (isTimestamp) {
+    // all IGL command buffers are submitted to the graphics queue
+    uint32_t queueFamilyCount = 0;
+    ctx_.vf_.vkGetPhysicalDeviceQueueFamilyProperties(
+        ctx_.getVkPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> properties(queueFamilyCount);
+    ctx_.vf_.vkGetPhysicalDeviceQueueFamilyProperties(
+        ctx_.getVkPhysicalDevice(), &queueFamilyCount, properties.data());
+
+    const uint32_t familyIndex = ctx_.deviceQueues_.graphicsQueueFamilyIndex;
+    const uint32_t validBits =
+        familyIndex < queueFamilyCount ? properties[familyIndex].timestampValidBits : 0;
+    if (validBits == 0) {
+      return Result(Result::Code::Unsupported, "The graphics queue does not support timestamps");
+    }
+    timestampMask_ = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+  }
+
+  VkDevice device = ctx_.getVkDevice();
+
+  const VkResult result = ctx_.vf_.vkCreateQueryPool(device, &ci, nullptr, &vkQueryPool_);
+
+  if (result != VK_SUCCESS) {
+    vkQueryPool_ = VK_NULL_HANDLE;
+    return getResultFromVkResult(result);
+  }
+
+  if (!desc_.debugName.empty()) {
+    VK_ASSERT(ivkSetDebugObjectName(&ctx_.vf_,
+                                    device,
+                                    VK_OBJECT_TYPE_QUERY_POOL,
+                                    (uint64_t)vkQueryPool_,
+                                    desc_.debugName.c_str()));
+  }
+
+  return Result();
+}
+
+bool QueryPool::getResults(uint32_t firstQuery,
+                           uint32_t queryCount,
+                           uint32_t numValues,
+                           uint64_t* IGL_NONNULL outValues) const {
+  IGL_PROFILER_FUNCTION();
+
+  if (!IGL_DEBUG_VERIFY(firstQuery + queryCount <= desc_.queryCount)) {
+    return false;
+  }
+  if (queryCount == 0) {
+    return true;
+  }
+
+  // every query is followed by its availability value
+  const uint32_t stride = numValues + 1;
+
+  std::vector<uint64_t> data(static_cast<size_t>(queryCount) * stride);
+
+  const VkResult result = ctx_.vf_.vkGetQueryPoolResults(
+      ctx_.getVkDevice(),
+      vkQueryPool_,
+      firstQuery,
+      queryCount,
+      data.size() * sizeof(uint64_t),
+      data.data(),
+      stride * sizeof(uint64_t),
+      VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+  if (result == VK_NOT_READY) {
+    return false;
+  }
+  if (result != VK_SUCCESS) {
+    VK_ASSERT(result);
+    return false;
+  }
+
+  for (uint32_t i = 0; i != queryCount; i++) {
+    const uint64_t* values = data.data() + static_cast<size_t>(i) * stride;
+    if (values[numValues] == 0) {
+      return false;
+    }
+    std::copy(values, values + numValues, outValues + static_cast<size_t>(i) * numValues);
+  }
+
+  return true;
+}
+
+bool QueryPool::getTimestamps(uint32_t firstQuery,
+                              uint32_t queryCount,
+                              uint64_t* IGL_NONNULL outNanoseconds) const {
+  if (!IGL_DEBUG_VERIFY(desc_.type == QueryType::Timestamp)) {
+    return false;
+  }
+
+  if (!getResults(firstQuery, queryCount, 1, outNanoseconds)) {
+    return false;
+  }
+
+  // timestampPeriod is the number of nanoseconds per timestamp tick
+  const double period = ctx_.getVkPhysicalDeviceProperties().limits.timestampPeriod;
+
+  for (uint32_t i = 0; i != queryCount; i++) {
+    // bits above timestampValidBits are undefined
+    const uint64_t ticks = outNanoseconds[i] & timestampMask_;
+    outNanoseconds[i] = static_cast<uint64_t>(static_cast<double>(ticks) * period);
+  }
+
+  return true;
+}
+
+bool QueryPool::getPipelineStatistics(uint32_t firstQuery,
+                                      uint32_t queryCount,
+                                      PipelineStatistics* IGL_NONNULL outStatistics) const {
+  if (!IGL_DEBUG_VERIFY(desc_.type == QueryType::PipelineStatistics)) {
+    return false;
+  }
+
+  return getResults(firstQuery,
+                    queryCount,
+                    kNumPipelineStatistics,
+                    reinterpret_cast<uint64_t*>(outStatistics));
+}
+
+} // namespace igl::vulkan
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <igl/QueryPool.h>
+#include <igl/vulkan/Common.h>
+
+namespace igl::vulkan {
+
+class VulkanContext;
+
+/// @brief Implements the igl::IQueryPool interface for Vulkan. Wraps a VkQueryPool whose results
+/// are read back with vkGetQueryPoolResults() without waiting.
+class QueryPool final : public IQueryPool {
+ public:
+  QueryPool(const VulkanContext& ctx, const QueryPoolDesc& desc);
+  ~QueryPool() override;
+
+  QueryPool(const QueryPool&) = delete;
+  QueryPool& operator=(const QueryPool&) = delete;
+
+  /// @brief The statistics collected by pipeline statistics queries. The order of values returned
+  /// by vkGetQueryPoolResults() follows the order of these bits and matches the order of fields in
+  /// igl::PipelineStatistics
+  static constexpr VkQueryPipelineStatisticFlags kPipelineStatisticsFlags =
+      VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+      VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+  /// @brief Creates the VkQueryPool. Pipeline statistics queries require the
+  /// `pipelineStatisticsQuery` device feature, timestamps require a graphics queue with non-zero
+  /// `timestampValidBits`
+  Result create();
+
+  [[nodiscard]] bool getTimestamps(uint32_t firstQuery,
+                                   uint32_t queryCount,
+                                   uint64_t* IGL_NONNULL outNanoseconds) const override;
+  [[nodiscard]] bool getPipelineStatistics(uint32_t firstQuery,
+                                           uint32_t queryCount,
+                                           PipelineStatistics* IGL_NONNULL
+                                               outStatistics) const override;
+
+  [[nodiscard]] VkQueryPool getVkQueryPool() const {
+    return vkQueryPool_;
+  }
+
+ private:
+  /// @brief Copies `numValues` 64-bit values per query into `outValues`. Returns false if any of
+  /// the queries is not available yet
+  bool getResults(uint32_t firstQuery,
+                  uint32_t queryCount,
+                  uint32_t numValues,
+                  uint64_t* IGL_NONNULL outValues) const;
+
+  const VulkanContext& ctx_;
+  VkQueryPool vkQueryPool_ = VK_NULL_HANDLE;
+  // masks out the bits of raw timestamps above the queue's timestampValidBits
+  uint64_t timestampMask_ = ~0ull;
+};
+
+} // namespace igl::vulkan
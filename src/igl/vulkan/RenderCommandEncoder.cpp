@@ -15,6 +15,7 @@
 #include <igl/vulkan/CommandBuffer.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/Framebuffer.h>
+#include <igl/vulkan/QueryPool.h>
 #include <igl/vulkan/RenderPipelineState.h>
 #include <igl/vulkan/SamplerState.h>
 #include <igl/vulkan/Texture.h>
@@ -71,9 +72,23 @@ RenderCommandEncoder::RenderCommandEncoder(const std::shared_ptr<CommandBuffer>&
   IGL_DEBUG_ASSERT(cmdBuffer_ != VK_NULL_HANDLE);
 }
 
+RenderCommandEncoder::RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                           VulkanContext& ctx,
+                                           VkCommandBuffer secondaryCmdBuffer) :
+  IRenderCommandEncoder::IRenderCommandEncoder(commandBuffer),
+  ctx_(ctx),
+  cmdBuffer_(secondaryCmdBuffer),
+  isSecondary_(true),
+  binder_(commandBuffer.get(), ctx, VK_PIPELINE_BIND_POINT_GRAPHICS, secondaryCmdBuffer) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(commandBuffer);
+  IGL_DEBUG_ASSERT(cmdBuffer_ != VK_NULL_HANDLE);
+}
+
 void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
                                       const std::shared_ptr<IFramebuffer>& framebuffer,
                                       const Dependencies& dependencies,
+                                      uint32_t numSecondaryEncoders,
                                       Result& outResult) {
   IGL_PROFILER_FUNCTION();
 
@@ -234,34 +249,106 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
     return;
   }
 
-  ctx_.vf_.vkCmdBeginRenderPass(cmdBuffer_, &bi, VK_SUBPASS_CONTENTS_INLINE);
+  ctx_.vf_.vkCmdBeginRenderPass(cmdBuffer_,
+                                &bi,
+                                numSecondaryEncoders ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                                                     : VK_SUBPASS_CONTENTS_INLINE);
 
   isEncoding_ = true;
 
+  // secondary command buffers are acquired here on the context thread, and can be recorded later
+  // on any thread
+  const auto commandBuffer = std::static_pointer_cast<CommandBuffer>(getCommandBufferPtr());
+
+  secondaryEncoders_.reserve(numSecondaryEncoders);
+
+  for (uint32_t i = 0; i != numSecondaryEncoders; i++) {
+    VkCommandBuffer cmdBuf = ctx_.immediate_->acquireSecondary(i, binder_.nextSubmitHandle_);
+    std::unique_ptr<RenderCommandEncoder> encoder(
+        new RenderCommandEncoder(commandBuffer, ctx_, cmdBuf));
+    encoder->initializeSecondary(*this, bi, viewport, scissor);
+    secondaryEncoders_.push_back(std::move(encoder));
+  }
+
   Result::setOk(&outResult);
 }
 
+void RenderCommandEncoder::initializeSecondary(const RenderCommandEncoder& primary,
+                                               const VkRenderPassBeginInfo& renderPassBeginInfo,
+                                               const Viewport& viewport,
+                                               const ScissorRect& scissor) {
+  IGL_PROFILER_FUNCTION();
+
+  framebuffer_ = primary.framebuffer_;
+  hasDepthAttachment_ = primary.hasDepthAttachment_;
+  dynamicState_.renderPassIndex_ = primary.dynamicState_.renderPassIndex_;
+  dynamicState_.depthBiasEnable_ = false;
+
+  // a pipeline statistics query begun on the primary encoder can be active while the secondary
+  // command buffer executes; occlusion queries are not exposed by IGL
+  const bool hasPipelineStatistics =
+      ctx_.features().vkPhysicalDeviceFeatures2.features.pipelineStatisticsQuery == VK_TRUE;
+  const VkCommandBufferInheritanceInfo inheritanceInfo = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+      .renderPass = renderPassBeginInfo.renderPass,
+      .subpass = 0,
+      .framebuffer = renderPassBeginInfo.framebuffer,
+      .occlusionQueryEnable = VK_FALSE,
+      .queryFlags = 0,
+      .pipelineStatistics = hasPipelineStatistics ? QueryPool::kPipelineStatisticsFlags : 0,
+  };
+  const VkCommandBufferBeginInfo bi = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+               VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+      .pInheritanceInfo = &inheritanceInfo,
+  };
+  VK_ASSERT(ctx_.vf_.vkBeginCommandBuffer(cmdBuffer_, &bi));
+
+  // dynamic state is not inherited from the primary command buffer
+  bindViewport(viewport);
+  bindScissorRect(scissor);
+
+  isEncoding_ = true;
+}
+
 std::unique_ptr<RenderCommandEncoder> RenderCommandEncoder::create(
     const std::shared_ptr<CommandBuffer>& commandBuffer,
     VulkanContext& ctx,
     const RenderPassDesc& renderPass,
     const std::shared_ptr<IFramebuffer>& framebuffer,
     const Dependencies& dependencies,
+    uint32_t numSecondaryEncoders,
     Result* outResult) {
   IGL_PROFILER_FUNCTION();
 
   Result ret;
 
   std::unique_ptr<RenderCommandEncoder> encoder(new RenderCommandEncoder(commandBuffer, ctx));
-  encoder->initialize(renderPass, framebuffer, dependencies, ret);
+  encoder->initialize(renderPass, framebuffer, dependencies, numSecondaryEncoders, ret);
 
   Result::setResult(outResult, ret);
   return ret.isOk() ? std::move(encoder) : nullptr;
 }
 
+RenderCommandEncoder& RenderCommandEncoder::getSecondaryEncoder(uint32_t index) {
+  IGL_DEBUG_ASSERT(index < secondaryEncoders_.size());
+
+  return *secondaryEncoders_[index];
+}
+
 void RenderCommandEncoder::endEncoding() {
   IGL_PROFILER_FUNCTION();
 
+  if (isSecondary_) {
+    // secondary encoders can end encoding on any thread
+    if (isEncoding_) {
+      isEncoding_ = false;
+      VK_ASSERT(ctx_.vf_.vkEndCommandBuffer(cmdBuffer_));
+    }
+    return;
+  }
+
   IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx_);
 
   if (!isEncoding_) {
@@ -270,6 +357,21 @@ void RenderCommandEncoder::endEncoding() {
 
   isEncoding_ = false;
 
+  if (!secondaryEncoders_.empty()) {
+    std::vector<VkCommandBuffer> cmdBuffers;
+    cmdBuffers.reserve(secondaryEncoders_.size());
+    // the order of execution is the order of indices, regardless of which thread recorded what
+    for (const auto& encoder : secondaryEncoders_) {
+      IGL_DEBUG_ASSERT(!encoder->isEncoding_,
+                       "Did you forget to call endEncoding() for a secondary encoder?");
+      encoder->endEncoding();
+      cmdBuffers.push_back(encoder->cmdBuffer_);
+    }
+    ctx_.vf_.vkCmdExecuteCommands(
+        cmdBuffer_, static_cast<uint32_t>(cmdBuffers.size()), cmdBuffers.data());
+    secondaryEncoders_.clear();
+  }
+
   ctx_.vf_.vkCmdEndRenderPass(cmdBuffer_);
 
   for (ITexture* IGL_NULLABLE tex : dependencies_.textures) {
@@ -337,6 +439,33 @@ void RenderCommandEncoder::popDebugGroupLabel() const {
   ivkCmdEndDebugUtilsLabel(&ctx_.vf_, cmdBuffer_);
 }
 
+void RenderCommandEncoder::writeTimestamp(IQueryPool& pool, uint32_t query) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(secondaryEncoders_.empty(),
+                   "Render commands should be recorded into secondary encoders");
+
+  ctx_.vf_.vkCmdWriteTimestamp(cmdBuffer_,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                               static_cast<QueryPool&>(pool).getVkQueryPool(),
+                               query);
+}
+
+void RenderCommandEncoder::beginQuery(IQueryPool& pool, uint32_t query) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(secondaryEncoders_.empty(),
+                   "Render commands should be recorded into secondary encoders");
+
+  ctx_.vf_.vkCmdBeginQuery(cmdBuffer_, static_cast<QueryPool&>(pool).getVkQueryPool(), query, 0);
+}
+
+void RenderCommandEncoder::endQuery(IQueryPool& pool, uint32_t query) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(secondaryEncoders_.empty(),
+                   "Render commands should be recorded into secondary encoders");
+
+  ctx_.vf_.vkCmdEndQuery(cmdBuffer_, static_cast<QueryPool&>(pool).getVkQueryPool(), query);
+}
+
 void RenderCommandEncoder::bindViewport(const Viewport& viewport) {
   IGL_PROFILER_FUNCTION();
   IGL_PROFILER_ZONE_GPU_VK("bindViewport()", ctx_.tracyCtx_, cmdBuffer_);
@@ -422,6 +551,8 @@ void RenderCommandEncoder::bindDepthStencilState(
 
   setStencilState(VK_STENCIL_FACE_FRONT_BIT, desc.frontFaceStencil);
   setStencilState(VK_STENCIL_FACE_BACK_BIT, desc.backFaceStencil);
+
+  isDepthStencilStateDirty_ = true;
 }
 
 void RenderCommandEncoder::bindBuffer(uint32_t index,
@@ -505,11 +636,31 @@ void RenderCommandEncoder::bindIndexBuffer(IBuffer& buffer,
   ctx_.vf_.vkCmdBindIndexBuffer(cmdBuffer_, buf.getVkBuffer(), bufferOffset, type);
 }
 
-void RenderCommandEncoder::bindBytes(size_t /*index*/,
+void RenderCommandEncoder::bindBytes(size_t index,
                                      uint8_t /*target*/,
-                                     const void* /*data*/,
-                                     size_t /*length*/) {
-  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+                                     const void* data,
+                                     size_t length) {
+  IGL_PROFILER_FUNCTION();
+
+#if IGL_VULKAN_PRINT_COMMANDS
+  IGL_LOG_INFO("%p  bindBytes(%u, %u)\n", cmdBuffer_, (uint32_t)index, (uint32_t)length);
+#endif // IGL_VULKAN_PRINT_COMMANDS
+
+  if (!IGL_DEBUG_VERIFY(ctx_.uniformRingBuffer_,
+                        "bindBytes() requires VulkanContextConfig::uniformRingBufferSize > 0")) {
+    return;
+  }
+
+  // the data is kept alive until the command buffer (and all its secondary ones) completes
+  const VulkanUniformRingBuffer::Allocation alloc =
+      ctx_.uniformRingBuffer_->allocate(data, length, binder_.nextSubmitHandle_);
+
+  if (!alloc.valid()) {
+    return;
+  }
+
+  binder_.bindUniformBufferRange(
+      static_cast<uint32_t>(index), alloc.buffer, alloc.offset, alloc.size);
 }
 
 void RenderCommandEncoder::bindPushConstants(const void* data, size_t length, size_t offset) {
@@ -611,7 +762,9 @@ void RenderCommandEncoder::draw(size_t vertexCount,
 
   ensureVertexBuffers();
 
-  flushDynamicState();
+  if (!flushDynamicState()) {
+    return;
+  }
 
 #if IGL_VULKAN_PRINT_COMMANDS
   IGL_LOG_INFO("%p vkCmdDraw(%u, %u, %u, %u)\n",
@@ -646,7 +799,9 @@ void RenderCommandEncoder::drawIndexed(size_t indexCount,
 
   ensureVertexBuffers();
 
-  flushDynamicState();
+  if (!flushDynamicState()) {
+    return;
+  }
 
 #if IGL_VULKAN_PRINT_COMMANDS
   IGL_LOG_INFO("%p vkCmdDrawIndexed(%u, %u, %u, %i, %u)\n",
@@ -673,7 +828,9 @@ void RenderCommandEncoder::multiDrawIndirect(IBuffer& indirectBuffer,
 
   ensureVertexBuffers();
 
-  flushDynamicState();
+  if (!flushDynamicState()) {
+    return;
+  }
 
   ctx_.drawCallCount_ += drawCallCountEnabled_;
 
@@ -698,7 +855,9 @@ void RenderCommandEncoder::multiDrawIndexedIndirect(IBuffer& indirectBuffer,
 
   ensureVertexBuffers();
 
-  flushDynamicState();
+  if (!flushDynamicState()) {
+    return;
+  }
 
   ctx_.drawCallCount_ += drawCallCountEnabled_;
 
@@ -728,6 +887,7 @@ void RenderCommandEncoder::setDepthBias(float depthBias, float slopeScale, float
   IGL_PROFILER_FUNCTION();
 
   dynamicState_.depthBiasEnable_ = true;
+  isDepthStencilStateDirty_ = true;
   ctx_.vf_.vkCmdSetDepthBias(cmdBuffer_, depthBias, clamp, slopeScale);
 }
 
@@ -739,10 +899,22 @@ bool RenderCommandEncoder::setDrawCallCountEnabled(bool value) {
   return returnVal;
 }
 
-void RenderCommandEncoder::flushDynamicState() {
+bool RenderCommandEncoder::flushDynamicState() {
   IGL_PROFILER_FUNCTION();
 
-  binder_.bindPipeline(rps_->getVkPipeline(dynamicState_), &rps_->getSpvModuleInfo());
+  IGL_DEBUG_ASSERT(secondaryEncoders_.empty(),
+                   "Render commands should be recorded into secondary encoders");
+
+  const VkPipeline pipeline = rps_->getVkPipeline(dynamicState_);
+
+  if (pipeline == VK_NULL_HANDLE) {
+    // VulkanContextConfig::skipDrawsWhileCompilingPipelines
+    return false;
+  }
+
+  binder_.bindPipeline(pipeline, &rps_->getSpvModuleInfo());
+
+  flushDepthStencilState();
 
   const VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 
@@ -759,17 +931,24 @@ void RenderCommandEncoder::flushDynamicState() {
           rps_->getRenderPipelineDesc().debugName.c_str());
       IGL_LOG_INFO(IGL_FORMAT("Bind group textures mask: {:b}\n", usageMaskBindGroup).c_str());
       IGL_LOG_INFO(IGL_FORMAT("Pipeline expects        : {:b}\n", usageMaskPipeline).c_str());
-      return;
+      return true;
     }
 
+    if (ctx_.usePushDescriptors_) {
+      // allocated descriptor sets cannot be bound to a push descriptor set layout: push the
+      // textures of the bind group instead
+      binder_.bindingsTextures_ = *ctx_.getBindGroupBindings(pendingBindGroupTexture_);
+      binder_.isDirtyFlags_ |= igl::vulkan::ResourcesBinder::DirtyFlagBits_Textures;
+    } else {
 #if IGL_VULKAN_PRINT_COMMANDS
-    IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - textures bind group\n", cmdBuffer_);
+      IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - textures bind group\n", cmdBuffer_);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-    ctx_.vf_.vkCmdBindDescriptorSets(
-        cmdBuffer_, bindPoint, layout, kBindPoint_CombinedImageSamplers, 1, &dset, 0, nullptr);
-    // This is necessary to support a mix of BindGroups and bindTexture() calls in the same command
-    // encoder. A typical use case for that is running ImGui rendering etc.
-    binder_.isDirtyFlags_ &= ~igl::vulkan::ResourcesBinder::DirtyFlagBits_Textures;
+      ctx_.vf_.vkCmdBindDescriptorSets(
+          cmdBuffer_, bindPoint, layout, kBindPoint_CombinedImageSamplers, 1, &dset, 0, nullptr);
+      // This is necessary to support a mix of BindGroups and bindTexture() calls in the same
+      // command encoder. A typical use case for that is running ImGui rendering etc.
+      binder_.isDirtyFlags_ &= ~igl::vulkan::ResourcesBinder::DirtyFlagBits_Textures;
+    }
     pendingBindGroupTexture_ = {}; // reset
   }
 
@@ -786,7 +965,7 @@ void RenderCommandEncoder::flushDynamicState() {
           rps_->getRenderPipelineDesc().debugName.c_str());
       IGL_LOG_INFO(IGL_FORMAT("Bind group buffers mask: {:b}\n", usageMaskBindGroup).c_str());
       IGL_LOG_INFO(IGL_FORMAT("Pipeline expects       : {:b}\n", usageMaskPipeline).c_str());
-      return;
+      return true;
     }
 
 #if IGL_VULKAN_PRINT_COMMANDS
@@ -823,6 +1002,44 @@ void RenderCommandEncoder::flushDynamicState() {
                                      0,
                                      nullptr);
   }
+
+  return true;
+}
+
+void RenderCommandEncoder::flushDepthStencilState() {
+  const VulkanFeatures& features = ctx_.features();
+
+  if (!isDepthStencilStateDirty_ || !features.has_VK_EXT_extended_dynamic_state) {
+    return;
+  }
+
+  IGL_PROFILER_FUNCTION();
+
+  const VkCommandBuffer cmdBuf = cmdBuffer_;
+  const RenderPipelineDynamicState& state = dynamicState_;
+
+  ctx_.vf_.vkCmdSetDepthTestEnableEXT(cmdBuf, state.isDepthTestEnabled() ? VK_TRUE : VK_FALSE);
+  ctx_.vf_.vkCmdSetDepthWriteEnableEXT(cmdBuf, state.depthWriteEnable_ ? VK_TRUE : VK_FALSE);
+  ctx_.vf_.vkCmdSetDepthCompareOpEXT(cmdBuf, state.getDepthCompareOp());
+  ctx_.vf_.vkCmdSetStencilTestEnableEXT(cmdBuf, state.isStencilTestEnabled() ? VK_TRUE : VK_FALSE);
+  ctx_.vf_.vkCmdSetStencilOpEXT(cmdBuf,
+                                VK_STENCIL_FACE_FRONT_BIT,
+                                state.getStencilStateFailOp(true),
+                                state.getStencilStatePassOp(true),
+                                state.getStencilStateDepthFailOp(true),
+                                state.getStencilStateCompareOp(true));
+  ctx_.vf_.vkCmdSetStencilOpEXT(cmdBuf,
+                                VK_STENCIL_FACE_BACK_BIT,
+                                state.getStencilStateFailOp(false),
+                                state.getStencilStatePassOp(false),
+                                state.getStencilStateDepthFailOp(false),
+                                state.getStencilStateCompareOp(false));
+
+  if (features.has_VK_EXT_extended_dynamic_state2) {
+    ctx_.vf_.vkCmdSetDepthBiasEnableEXT(cmdBuf, state.depthBiasEnable_ ? VK_TRUE : VK_FALSE);
+  }
+
+  isDepthStencilStateDirty_ = false;
 }
 
 void RenderCommandEncoder::ensureVertexBuffers() {
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <igl/Buffer.h>
 #include <igl/CommandEncoder.h>
 #include <igl/Common.h>
@@ -20,7 +22,14 @@
 
 namespace igl::vulkan {
 
-/// @brief This class implements the igl::IRenderCommandEncoder interface for Vulkan
+/** @brief This class implements the igl::IRenderCommandEncoder interface for Vulkan.
+ * A render command encoder can be created with a number of secondary encoders. In this case, the
+ * render pass contents are recorded exclusively into secondary command buffers, one per secondary
+ * encoder, and this (primary) encoder cannot record any render commands itself. Each secondary
+ * encoder uses its own command pool and can be recorded on any thread, but only by one thread at a
+ * time. When the primary encoder ends encoding, the secondary command buffers are executed in the
+ * order of their indices, which makes the result independent of the thread scheduling.
+ */
 class RenderCommandEncoder : public IRenderCommandEncoder {
  public:
   static std::unique_ptr<RenderCommandEncoder> create(
@@ -29,6 +38,7 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
       const RenderPassDesc& renderPass,
       const std::shared_ptr<IFramebuffer>& framebuffer,
       const Dependencies& dependencies,
+      uint32_t numSecondaryEncoders,
       Result* outResult);
 
   ~RenderCommandEncoder() override {
@@ -38,13 +48,29 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
 
   /// @brief Ends encoding for render commands and transitions the layouts of all images bound to
   /// this encoder back to `VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL`. Also transitions all
-  /// dependent textures to `VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL`
+  /// dependent textures to `VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL`. If this encoder has
+  /// secondary encoders, their command buffers are executed in the order of their indices before
+  /// the render pass ends. For a secondary encoder, this function only ends its command buffer.
   void endEncoding() override;
 
+  /// @brief Returns the number of secondary encoders this encoder was created with
+  [[nodiscard]] uint32_t getNumSecondaryEncoders() const {
+    return static_cast<uint32_t>(secondaryEncoders_.size());
+  }
+
+  /// @brief Returns the secondary encoder at `index`. All secondary encoders have to end encoding
+  /// before this encoder ends encoding.
+  RenderCommandEncoder& getSecondaryEncoder(uint32_t index);
+
   void pushDebugGroupLabel(const char* label, const igl::Color& color) const override;
   void insertDebugEventLabel(const char* label, const igl::Color& color) const override;
   void popDebugGroupLabel() const override;
 
+  /// @brief Writes the timestamp after all previously recorded commands have completed
+  void writeTimestamp(IQueryPool& pool, uint32_t query) override;
+  void beginQuery(IQueryPool& pool, uint32_t query) override;
+  void endQuery(IQueryPool& pool, uint32_t query) override;
+
   /// @brief Sets the viewport size specified in `viewport`. This function flips the viewport in the
   /// y-direction but retains the same winding as in OpenGL
   void bindViewport(const Viewport& viewport) override;
@@ -107,6 +133,12 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
     return binder_;
   }
 
+  /// @brief Returns the mutable pipeline parameters the next draw call will use. Can be used to
+  /// collect variants for RenderPipelineState::precompile()
+  [[nodiscard]] const RenderPipelineDynamicState& getDynamicState() const {
+    return dynamicState_;
+  }
+
   /// @brief Enables or disables the draw call count. If enabled, it will increment the draw call,
   /// otherwise it won't. This is used to disable the draw call count when we are doing auxiliary
   /// draw calls such as shader debugging.
@@ -119,28 +151,47 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
 
  private:
   RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer, VulkanContext& ctx);
+  /// @brief Creates a secondary encoder which records into `secondaryCmdBuffer`
+  RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                       VulkanContext& ctx,
+                       VkCommandBuffer secondaryCmdBuffer);
 
   /// @brief Ensures that the vertex buffers are bound by performing checks. If the function doesn't
   /// assert at some point, the vertex buffer(s) is bound correctly.
   void ensureVertexBuffers();
-  void flushDynamicState();
+  /// @brief Binds the pipeline and the pending descriptor sets. Returns false if the draw should be
+  /// skipped because its pipeline is still being built in the background
+  [[nodiscard]] bool flushDynamicState();
+  /// @brief Sets the depth/stencil state with VK_EXT_extended_dynamic_state and
+  /// VK_EXT_extended_dynamic_state2 if they are available. Otherwise, it's baked into the pipeline
+  void flushDepthStencilState();
 
   void initialize(const RenderPassDesc& renderPass,
                   const std::shared_ptr<IFramebuffer>& framebuffer,
                   const Dependencies& dependencies,
+                  uint32_t numSecondaryEncoders,
                   Result& outResult);
+  /// @brief Begins the secondary command buffer so that it continues the render pass of `primary`
+  void initializeSecondary(const RenderCommandEncoder& primary,
+                           const VkRenderPassBeginInfo& renderPassBeginInfo,
+                           const Viewport& viewport,
+                           const ScissorRect& scissor);
   void processDependencies(const Dependencies& dependencies);
 
  private:
   VulkanContext& ctx_;
   VkCommandBuffer cmdBuffer_ = VK_NULL_HANDLE;
   bool isEncoding_ = false;
+  bool isSecondary_ = false;
   bool hasDepthAttachment_ = false;
   std::shared_ptr<IFramebuffer> framebuffer_;
 
   ResourcesBinder binder_;
 
   RenderPipelineDynamicState dynamicState_;
+  // the depth/stencil part of `dynamicState_` has to be set with vkCmdSet...() before the next draw
+  // (only if VK_EXT_extended_dynamic_state is used)
+  bool isDepthStencilStateDirty_ = true;
 
   /* Used to increment the draw call count. Should either be 0 or 1
    *  0: When draw call count is disabled during auxiliary draw calls (shader debugging)
@@ -156,6 +207,8 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
   BindGroupBufferHandle pendingBindGroupBuffer_ = {};
   uint32_t numDynamicOffsets_ = 0;
   uint32_t dynamicOffsets_[IGL_UNIFORM_BLOCKS_BINDING_MAX] = {};
+
+  std::vector<std::unique_ptr<RenderCommandEncoder>> secondaryEncoders_;
 };
 
 } // namespace igl::vulkan
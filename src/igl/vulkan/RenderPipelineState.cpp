@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <chrono>
+
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/Device.h>
 #include <igl/vulkan/RenderPipelineState.h>
@@ -16,6 +18,12 @@
 
 namespace {
 
+uint64_t getNanoseconds() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
 VkPrimitiveTopology primitiveTypeToVkPrimitiveTopology(igl::PrimitiveType t) {
   switch (t) {
   case igl::PrimitiveType::Point:
@@ -337,6 +345,12 @@ RenderPipelineState::~RenderPipelineState() {
   const VulkanContext& ctx = device_.getVulkanContext();
   VkDevice device = ctx.device_->getVkDevice();
 
+  {
+    // background compilations reference this object
+    std::unique_lock<std::mutex> lock(pipelinesMutex_);
+    pendingPipelinesCondition_.wait(lock, [this]() { return pendingPipelines_.empty(); });
+  }
+
   for (const auto& p : pipelines_) {
     if (p.second != VK_NULL_HANDLE) {
       device_.getVulkanContext().deferredTask(
@@ -354,12 +368,125 @@ RenderPipelineState::~RenderPipelineState() {
 }
 
 VkPipeline RenderPipelineState::getVkPipeline(
-    const RenderPipelineDynamicState& dynamicState) const {
+    const RenderPipelineDynamicState& state) const {
+  const VulkanContext& ctx = device_.getVulkanContext();
+  const RenderPipelineDynamicState dynamicState = getPipelineKey(state);
+
+  std::unique_lock<std::mutex> lock(pipelinesMutex_);
+
+  for (;;) {
+    updatePipelineLayout(lock);
+
+    const auto it = pipelines_.find(dynamicState);
+
+    if (it != pipelines_.end()) {
+      return it->second;
+    }
+
+    if (!pendingPipelines_.count(dynamicState)) {
+      break;
+    }
+
+    // the pipeline is being built on another thread
+    if (ctx.config_.skipDrawsWhileCompilingPipelines) {
+      ctx.pipelineCompiler_->recordSkippedDraw();
+      return VK_NULL_HANDLE;
+    }
+
+    IGL_PROFILER_ZONE("getVkPipeline() - wait", IGL_PROFILER_COLOR_WAIT);
+    const uint64_t start = getNanoseconds();
+    pendingPipelinesCondition_.wait(
+        lock, [this, &dynamicState]() { return !pendingPipelines_.count(dynamicState); });
+    ctx.pipelineCompiler_->recordStall(getNanoseconds() - start, false);
+    IGL_PROFILER_ZONE_END();
+  }
+
+  // build a new Vulkan pipeline without holding the lock, so other threads can keep using the
+  // existing ones
+  const uint64_t start = getNanoseconds();
+  const VkPipelineLayout pipelineLayout = pipelineLayout_;
+  const VkRenderPass renderPass = ctx.getRenderPass(dynamicState.renderPassIndex_).pass;
+  pendingPipelines_.insert(dynamicState);
+  lock.unlock();
+
+  const VkPipeline pipeline = createVkPipeline(dynamicState, pipelineLayout, renderPass);
+
+  lock.lock();
+  pipelines_[dynamicState] = pipeline;
+  pendingPipelines_.erase(dynamicState);
+  lock.unlock();
+  pendingPipelinesCondition_.notify_all();
+
+  ctx.pipelineCompiler_->recordStall(getNanoseconds() - start, true);
+
+  // @fb-only
+  // @lint-ignore CLANGTIDY
+  return pipeline;
+}
+
+void RenderPipelineState::precompile(
+    const std::vector<RenderPipelineDynamicState>& dynamicStates) const {
+  IGL_PROFILER_FUNCTION();
+
+  const VulkanContext& ctx = device_.getVulkanContext();
+
+  std::unique_lock<std::mutex> lock(pipelinesMutex_);
+
+  updatePipelineLayout(lock);
+
+  for (const RenderPipelineDynamicState& state : dynamicStates) {
+    const RenderPipelineDynamicState dynamicState = getPipelineKey(state);
+    if (pipelines_.count(dynamicState) || !pendingPipelines_.insert(dynamicState).second) {
+      continue;
+    }
+    // resolve everything that lives in VulkanContext on this thread
+    ctx.pipelineCompiler_->enqueue([this,
+                                    &ctx,
+                                    dynamicState,
+                                    pipelineLayout = pipelineLayout_,
+                                    renderPass =
+                                        ctx.getRenderPass(dynamicState.renderPassIndex_).pass]() {
+      const VkPipeline pipeline = createVkPipeline(dynamicState, pipelineLayout, renderPass);
+      ctx.pipelineCompiler_->recordAsyncCompile();
+      {
+        const std::lock_guard<std::mutex> guard(pipelinesMutex_);
+        pipelines_[dynamicState] = pipeline;
+        pendingPipelines_.erase(dynamicState);
+      }
+      pendingPipelinesCondition_.notify_all();
+    });
+  }
+}
+
+bool RenderPipelineState::isPipelineReady(const RenderPipelineDynamicState& dynamicState) const {
+  const std::lock_guard<std::mutex> guard(pipelinesMutex_);
+
+  return pipelines_.count(getPipelineKey(dynamicState)) != 0;
+}
+
+bool RenderPipelineState::isReady() const {
+  const std::lock_guard<std::mutex> guard(pipelinesMutex_);
+
+  return pendingPipelines_.empty();
+}
+
+void RenderPipelineState::waitForPendingPipelines() const {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
+
+  std::unique_lock<std::mutex> lock(pipelinesMutex_);
+  pendingPipelinesCondition_.wait(lock, [this]() { return pendingPipelines_.empty(); });
+}
+
+void RenderPipelineState::updatePipelineLayout(std::unique_lock<std::mutex>& lock) const {
   const VulkanContext& ctx = device_.getVulkanContext();
 
   if (ctx.config_.enableDescriptorIndexing) {
     // the bindless descriptor set layout can be changed in VulkanContext when the number of
     // existing textures increases
+    if (lastBindlessVkDescriptorSetLayout_ != ctx.getBindlessVkDescriptorSetLayout()) {
+      // pipelines which are being built use the current pipeline layout
+      pendingPipelinesCondition_.wait(lock, [this]() { return pendingPipelines_.empty(); });
+    }
     if (lastBindlessVkDescriptorSetLayout_ != ctx.getBindlessVkDescriptorSetLayout()) {
       // there's a new descriptor set layout - drop the previous Vulkan pipeline
       VkDevice device = ctx.device_->getVkDevice();
@@ -383,14 +510,6 @@ VkPipeline RenderPipelineState::getVkPipeline(
     }
   }
 
-  const auto it = pipelines_.find(dynamicState);
-
-  if (it != pipelines_.end()) {
-    return it->second;
-  }
-
-  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
-
   if (!pipelineLayout_) {
     // NOLINTBEGIN(readability-identifier-naming)
     // @fb-only
@@ -418,15 +537,37 @@ VkPipeline RenderPipelineState::getVkPipeline(
                               (uint64_t)pipelineLayout_,
                               IGL_FORMAT("Pipeline Layout: {}", desc_.debugName.c_str()).c_str()));
   }
+}
+
+RenderPipelineDynamicState RenderPipelineState::getPipelineKey(
+    const RenderPipelineDynamicState& dynamicState) const {
+  const VulkanFeatures& features = device_.getVulkanContext().features();
+
+  RenderPipelineDynamicState key = dynamicState;
+
+  if (features.has_VK_EXT_extended_dynamic_state) {
+    key.resetDepthStencilState();
+  }
+  if (features.has_VK_EXT_extended_dynamic_state2) {
+    key.depthBiasEnable_ = false;
+  }
+
+  return key;
+}
+
+VkPipeline RenderPipelineState::createVkPipeline(const RenderPipelineDynamicState& dynamicState,
+                                                 VkPipelineLayout pipelineLayout,
+                                                 VkRenderPass renderPass) const {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+  const VulkanContext& ctx = device_.getVulkanContext();
 
   const auto& deviceFeatures = ctx.features();
   const VkBool32 dualSrcBlendSupported =
       deviceFeatures.vkPhysicalDeviceFeatures2.features.dualSrcBlend;
 
-  // build a new Vulkan pipeline
-  VkRenderPass renderPass = ctx.getRenderPass(dynamicState.renderPassIndex_).pass;
-
   VkPipeline pipeline = VK_NULL_HANDLE;
+  VkPipelineCreationFeedbackEXT feedback = {};
 
   // Not all attachments are valid. We need to create color blend attachments only for active
   // attachments
@@ -461,6 +602,22 @@ VkPipeline RenderPipelineState::getVkPipeline(
         }
       });
 
+  // these values are set by RenderCommandEncoder
+  std::vector<VkDynamicState> extendedDynamicStates;
+  if (deviceFeatures.has_VK_EXT_extended_dynamic_state) {
+    extendedDynamicStates.insert(extendedDynamicStates.end(),
+                                 {
+                                     VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE_EXT,
+                                     VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE_EXT,
+                                     VK_DYNAMIC_STATE_DEPTH_COMPARE_OP_EXT,
+                                     VK_DYNAMIC_STATE_STENCIL_TEST_ENABLE_EXT,
+                                     VK_DYNAMIC_STATE_STENCIL_OP_EXT,
+                                 });
+  }
+  if (deviceFeatures.has_VK_EXT_extended_dynamic_state2) {
+    extendedDynamicStates.push_back(VK_DYNAMIC_STATE_DEPTH_BIAS_ENABLE_EXT);
+  }
+
   const auto& vertexModule = desc_.shaderStages->getVertexModule();
   const auto& fragmentModule = desc_.shaderStages->getFragmentModule();
   VK_ASSERT_RETURN_NULL_HANDLE(
@@ -475,6 +632,7 @@ VkPipeline RenderPipelineState::getVkPipeline(
               VK_DYNAMIC_STATE_STENCIL_WRITE_MASK,
               VK_DYNAMIC_STATE_STENCIL_REFERENCE,
           })
+          .dynamicStates(extendedDynamicStates)
           .primitiveTopology(primitiveTypeToVkPrimitiveTopology(desc_.topology))
           .depthBiasEnable(dynamicState.depthBiasEnable_)
           .depthCompareOp(dynamicState.getDepthCompareOp(), dynamicState.depthWriteEnable_)
@@ -507,18 +665,17 @@ VkPipeline RenderPipelineState::getVkPipeline(
           .colorBlendAttachmentStates(colorBlendAttachmentStates)
           .build(ctx.vf_,
                  ctx.device_->getVkDevice(),
-                 ctx.pipelineCache_,
-                 pipelineLayout_,
+                 ctx.pipelineCache_->getVkPipelineCache(),
+                 pipelineLayout,
                  renderPass,
                  &pipeline,
-                 desc_.debugName.c_str()));
+                 desc_.debugName.c_str(),
+                 ctx.features().has_VK_EXT_pipeline_creation_feedback ? &feedback : nullptr));
 
   IGL_DEBUG_ASSERT(pipeline != VK_NULL_HANDLE);
 
-  pipelines_[dynamicState] = pipeline;
+  ctx.pipelineCache_->recordCreationFeedback(feedback.flags);
 
-  // @fb-only
-  // @lint-ignore CLANGTIDY
   return pipeline;
 }
 
@@ -7,7 +7,11 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <mutex>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <igl/RenderPipelineState.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/PipelineState.h>
@@ -125,6 +129,38 @@ class alignas(sizeof(uint64_t)) RenderPipelineDynamicState {
     }
   }
 
+  /// @brief Returns true if the depth test has to be enabled for the current depth state
+  [[nodiscard]] bool isDepthTestEnabled() const {
+    return getDepthCompareOp() != VK_COMPARE_OP_ALWAYS || depthWriteEnable_;
+  }
+
+  /// @brief Returns true if the stencil test has to be enabled for the current stencil state
+  [[nodiscard]] bool isStencilTestEnabled() const {
+    auto isEnabled = [this](bool front) {
+      return getStencilStateFailOp(front) != VK_STENCIL_OP_KEEP ||
+             getStencilStatePassOp(front) != VK_STENCIL_OP_KEEP ||
+             getStencilStateDepthFailOp(front) != VK_STENCIL_OP_KEEP ||
+             getStencilStateCompareOp(front) != VK_COMPARE_OP_ALWAYS;
+    };
+    return isEnabled(true) || isEnabled(false);
+  }
+
+  /// @brief Resets the depth and stencil state to the default values. Used when this state is set
+  /// dynamically and should not be part of the pipeline key
+  void resetDepthStencilState() {
+    const RenderPipelineDynamicState defaultState;
+    depthCompareOp_ = defaultState.depthCompareOp_;
+    depthWriteEnable_ = defaultState.depthWriteEnable_;
+    stencilFrontFailOp_ = defaultState.stencilFrontFailOp_;
+    stencilFrontPassOp_ = defaultState.stencilFrontPassOp_;
+    stencilFrontDepthFailOp_ = defaultState.stencilFrontDepthFailOp_;
+    stencilFrontCompareOp_ = defaultState.stencilFrontCompareOp_;
+    stencilBackFailOp_ = defaultState.stencilBackFailOp_;
+    stencilBackPassOp_ = defaultState.stencilBackPassOp_;
+    stencilBackDepthFailOp_ = defaultState.stencilBackDepthFailOp_;
+    stencilBackCompareOp_ = defaultState.stencilBackCompareOp_;
+  }
+
   // comparison operator and hash function for std::unordered_map<>
   bool operator==(const RenderPipelineDynamicState& other) const {
     return *(uint64_t*)this == *(uint64_t*)&other;
@@ -149,7 +185,10 @@ static_assert(alignof(RenderPipelineDynamicState) == sizeof(uint64_t));
  * mutable parameters. If a pipeline doesn't exist with those parameters, one is created and
  * returned. Otherwise an existing pipeline with those settings is returned. This class also tracks
  * the pipeline layout in the context. If a pipeline layout change is detected, this class purges
- * all the pipelines that have been created so far.
+ * all the pipelines that have been created so far. Pipelines for variants known in advance can be
+ * built on background threads with `precompile()` to avoid hitches on the render thread. If
+ * VK_EXT_extended_dynamic_state is available, the depth and stencil state is not baked into the
+ * pipelines and is set by the render command encoder instead.
  */
 class RenderPipelineState final : public IRenderPipelineState, public PipelineState {
  public:
@@ -161,10 +200,28 @@ class RenderPipelineState final : public IRenderPipelineState, public PipelineSt
 
   /** @brief Creates a pipeline with the base parameters provided during construction and all
    * mutable ones provided in the `dynamicState` parameter. If a pipeline layout change is detected,
-   * all cached pipelines are discarded.
+   * all cached pipelines are discarded. This function is thread-safe and can be called from
+   * multiple secondary render command encoders concurrently. If the pipeline is being built by
+   * `precompile()`, this function waits for it, or returns VK_NULL_HANDLE if
+   * VulkanContextConfig::skipDrawsWhileCompilingPipelines is set.
    */
   VkPipeline getVkPipeline(const RenderPipelineDynamicState& dynamicState) const;
 
+  /** @brief Schedules the creation of pipelines for all `dynamicStates` on the worker threads of
+   * VulkanContext::pipelineCompiler_ and returns immediately. Variants which already exist or are
+   * being built are ignored. `getVkPipeline()` picks up the results as soon as they are ready.
+   */
+  void precompile(const std::vector<RenderPipelineDynamicState>& dynamicStates) const;
+
+  /// @brief Returns true if a pipeline for `dynamicState` exists and `getVkPipeline()` won't block
+  [[nodiscard]] bool isPipelineReady(const RenderPipelineDynamicState& dynamicState) const;
+
+  /// @brief Blocks until all pipelines scheduled by `precompile()` are built
+  void waitForPendingPipelines() const;
+
+  /// @brief Returns false while pipelines scheduled by `precompile()` are still being built
+  [[nodiscard]] bool isReady() const override;
+
  private:
   friend class Device;
 
@@ -175,6 +232,20 @@ class RenderPipelineState final : public IRenderPipelineState, public PipelineSt
   void setRenderPipelineReflection(
       const IRenderPipelineReflection& renderPipelineReflection) override;
 
+  /// @brief Discards all pipelines if the bindless descriptor set layout has changed and creates
+  /// the pipeline layout if needed. `lock` must hold `pipelinesMutex_`
+  void updatePipelineLayout(std::unique_lock<std::mutex>& lock) const;
+  /// @brief Returns `dynamicState` without the values which are set dynamically with
+  /// VK_EXT_extended_dynamic_state/VK_EXT_extended_dynamic_state2, so that all combinations of
+  /// these values share one pipeline
+  [[nodiscard]] RenderPipelineDynamicState getPipelineKey(
+      const RenderPipelineDynamicState& dynamicState) const;
+  /// @brief Builds a new Vulkan pipeline. Does not touch any mutable state and can be called from
+  /// any thread
+  VkPipeline createVkPipeline(const RenderPipelineDynamicState& dynamicState,
+                              VkPipelineLayout pipelineLayout,
+                              VkRenderPass renderPass) const;
+
  private:
   const igl::vulkan::Device& device_;
 
@@ -186,10 +257,15 @@ class RenderPipelineState final : public IRenderPipelineState, public PipelineSt
   // This is empty for now.
   std::shared_ptr<RenderPipelineReflection> reflection_;
 
+  mutable std::mutex pipelinesMutex_;
   mutable std::unordered_map<RenderPipelineDynamicState,
                              VkPipeline,
                              RenderPipelineDynamicState::HashFunction>
       pipelines_;
+  // pipelines which are being built, either by a worker thread or synchronously by getVkPipeline()
+  mutable std::unordered_set<RenderPipelineDynamicState, RenderPipelineDynamicState::HashFunction>
+      pendingPipelines_;
+  mutable std::condition_variable pendingPipelinesCondition_;
 };
 
 } // namespace igl::vulkan
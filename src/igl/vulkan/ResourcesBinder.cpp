@@ -20,8 +20,17 @@ namespace igl::vulkan {
 ResourcesBinder::ResourcesBinder(const CommandBuffer* commandBuffer,
                                  VulkanContext& ctx,
                                  VkPipelineBindPoint bindPoint) :
+  ResourcesBinder(commandBuffer,
+                  ctx,
+                  bindPoint,
+                  commandBuffer ? commandBuffer->getVkCommandBuffer() : VK_NULL_HANDLE) {}
+
+ResourcesBinder::ResourcesBinder(const CommandBuffer* commandBuffer,
+                                 VulkanContext& ctx,
+                                 VkPipelineBindPoint bindPoint,
+                                 VkCommandBuffer cmdBuffer) :
   ctx_(ctx),
-  cmdBuffer_(commandBuffer ? commandBuffer->getVkCommandBuffer() : VK_NULL_HANDLE),
+  cmdBuffer_(cmdBuffer),
   bindPoint_(bindPoint),
   nextSubmitHandle_(commandBuffer ? commandBuffer->getNextSubmitHandle()
                                   : VulkanImmediateCommands::SubmitHandle{}) {}
@@ -67,6 +76,27 @@ void ResourcesBinder::bindBuffer(uint32_t index,
   }
 }
 
+void ResourcesBinder::bindUniformBufferRange(uint32_t index,
+                                             VkBuffer buffer,
+                                             VkDeviceSize bufferOffset,
+                                             VkDeviceSize bufferSize) {
+  IGL_PROFILER_FUNCTION();
+
+  if (!IGL_DEBUG_VERIFY(index < IGL_UNIFORM_BLOCKS_BINDING_MAX)) {
+    IGL_DEBUG_ABORT("Buffer index should not exceed kMaxBindingSlots");
+    return;
+  }
+
+  IGL_DEBUG_ASSERT(buffer != VK_NULL_HANDLE);
+
+  VkDescriptorBufferInfo& slot = bindingsBuffers_.buffers[index];
+
+  if (slot.buffer != buffer || slot.offset != bufferOffset || slot.range != bufferSize) {
+    slot = {buffer, bufferOffset, bufferSize};
+    isDirtyFlags_ |= DirtyFlagBits_Buffers;
+  }
+}
+
 void ResourcesBinder::bindSamplerState(uint32_t index, SamplerState* samplerState) {
   IGL_PROFILER_FUNCTION();
 
@@ -208,7 +238,8 @@ void ResourcesBinder::updateBindings(VkPipelineLayout layout, const vulkan::Pipe
                                nextSubmitHandle_,
                                bindingsBuffers_,
                                *state.dslBuffers_,
-                               state.info_);
+                               state.info_,
+                               state.isDynamicBufferMask_);
   }
   if (isDirtyFlags_ & DirtyFlagBits_StorageImages) {
     ctx_.updateBindingsStorageImages(cmdBuffer_,
@@ -55,9 +55,24 @@ class ResourcesBinder final {
                   VulkanContext& ctx,
                   VkPipelineBindPoint bindPoint);
 
+  /// @brief Records all binding commands into `cmdBuffer` instead of the command buffer of
+  /// `commandBuffer`. This is used to record into secondary command buffers which are executed from
+  /// `commandBuffer`, and share its SubmitHandle.
+  ResourcesBinder(const CommandBuffer* commandBuffer,
+                  VulkanContext& ctx,
+                  VkPipelineBindPoint bindPoint,
+                  VkCommandBuffer cmdBuffer);
+
   /// @brief Binds a uniform buffer with an offset to index equal to `index`
   void bindBuffer(uint32_t index, Buffer* buffer, size_t bufferOffset, size_t bufferSize);
 
+  /// @brief Binds a range of a raw uniform buffer, such as an allocation from
+  /// VulkanUniformRingBuffer, to index equal to `index`
+  void bindUniformBufferRange(uint32_t index,
+                              VkBuffer buffer,
+                              VkDeviceSize bufferOffset,
+                              VkDeviceSize bufferSize);
+
   /// @brief Binds a sampler state to index equal to `index`
   void bindSamplerState(uint32_t index, SamplerState* samplerState);
 
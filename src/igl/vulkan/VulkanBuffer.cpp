@@ -36,7 +36,10 @@ VulkanBuffer::VulkanBuffer(const VulkanContext& ctx,
 
     // Initialize VmaAllocation Info
     if (memFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
-      ciAlloc.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+      // host-cached memory is required when requested, it may not be coherent
+      const bool isCached = (memFlags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) != 0;
+      ciAlloc.requiredFlags =
+          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | (isCached ? VK_MEMORY_PROPERTY_HOST_CACHED_BIT : 0);
       ciAlloc.preferredFlags =
           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
       ciAlloc.flags =
@@ -49,7 +52,7 @@ VulkanBuffer::VulkanBuffer(const VulkanContext& ctx,
       ctx_.vf_.vkDestroyBuffer(device, vkBuffer_, nullptr);
       vkBuffer_ = VK_NULL_HANDLE;
 
-      if (requirements.memoryTypeBits & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) {
+      if (!isCached && (requirements.memoryTypeBits & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
         ciAlloc.requiredFlags |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
         isCoherentMemory_ = true;
       }
@@ -63,6 +66,12 @@ VulkanBuffer::VulkanBuffer(const VulkanContext& ctx,
 
     // handle memory-mapped buffers
     if (memFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+      if (memFlags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) {
+        VkMemoryPropertyFlags allocatedFlags = 0;
+        vmaGetAllocationMemoryProperties(
+            (VmaAllocator)ctx_.getVmaAllocator(), vmaAllocation_, &allocatedFlags);
+        isCoherentMemory_ = (allocatedFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+      }
       vmaMapMemory((VmaAllocator)ctx_.getVmaAllocator(), vmaAllocation_, &mappedPtr_);
     }
   } else {
@@ -73,7 +82,15 @@ VulkanBuffer::VulkanBuffer(const VulkanContext& ctx,
     {
       VkMemoryRequirements requirements = {};
       ctx_.vf_.vkGetBufferMemoryRequirements(device_, vkBuffer_, &requirements);
-      if (requirements.memoryTypeBits & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) {
+      if (memFlags & VK_MEMORY_PROPERTY_HOST_CACHED_BIT) {
+        // host-cached memory may not be coherent, check the memory type which is allocated
+        VkPhysicalDeviceMemoryProperties memProperties = {};
+        ctx_.vf_.vkGetPhysicalDeviceMemoryProperties(ctx_.getVkPhysicalDevice(), &memProperties);
+        const uint32_t memoryType = ivkFindMemoryType(
+            &ctx_.vf_, ctx_.getVkPhysicalDevice(), requirements.memoryTypeBits, memFlags);
+        isCoherentMemory_ = (memProperties.memoryTypes[memoryType].propertyFlags &
+                             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+      } else if (requirements.memoryTypeBits & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) {
         isCoherentMemory_ = true;
       }
 
@@ -161,12 +178,18 @@ void VulkanBuffer::invalidateMappedMemory(VkDeviceSize offset, VkDeviceSize size
     vmaInvalidateAllocation(
         static_cast<VmaAllocator>(ctx_.getVmaAllocator()), vmaAllocation_, offset, size);
   } else {
+    // the range has to be aligned to nonCoherentAtomSize unless it reaches the end of the memory
+    const VkDeviceSize atomSize = ctx_.getVkPhysicalDeviceProperties().limits.nonCoherentAtomSize;
+    const VkDeviceSize alignedOffset = offset - offset % atomSize;
+    const VkDeviceSize alignedEnd = size == VK_WHOLE_SIZE
+                                        ? VK_WHOLE_SIZE
+                                        : (offset + size + atomSize - 1) / atomSize * atomSize;
     const VkMappedMemoryRange memoryRange = {
         VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
         nullptr,
         vkMemory_,
-        offset,
-        size,
+        alignedOffset,
+        alignedEnd >= bufferSize_ ? VK_WHOLE_SIZE : alignedEnd - alignedOffset,
     };
     ctx_.vf_.vkInvalidateMappedMemoryRanges(device_, 1, &memoryRange);
   }
@@ -5,9 +5,11 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -30,6 +32,7 @@
 #include <igl/vulkan/Buffer.h>
 #include <igl/vulkan/EnhancedShaderDebuggingStore.h>
 #include <igl/vulkan/RenderPipelineState.h>
+#include <igl/vulkan/ResourcesBinder.h>
 #include <igl/vulkan/SamplerState.h>
 #include <igl/vulkan/Texture.h>
 #include <igl/vulkan/VulkanBuffer.h>
@@ -204,23 +207,26 @@ class DescriptorPoolsArena final {
     numTypes_(1),
     types_{type},
     numDescriptorsPerDSet_(numDescriptorsPerDSet),
+    numDSetsPerPool_(std::max(kNumDSetsPerPool, ctx.config_.descriptorSetCacheSize)),
     dsl_(dsl) {
     IGL_DEBUG_ASSERT(debugName);
     dpDebugName_ = IGL_FORMAT("Descriptor Pool: {}", debugName ? debugName : "");
   }
   DescriptorPoolsArena(const VulkanContext& ctx,
-                       VkDescriptorType type0,
-                       VkDescriptorType type1,
+                       const VkDescriptorType* types,
+                       uint32_t numTypes,
                        VkDescriptorSetLayout dsl,
                        uint32_t numDescriptorsPerDSet,
                        const char* debugName) :
     ctx_(ctx),
     device_(ctx.getVkDevice()),
-    numTypes_(2),
-    types_{type0, type1},
+    numTypes_(numTypes),
     numDescriptorsPerDSet_(numDescriptorsPerDSet),
+    numDSetsPerPool_(std::max(kNumDSetsPerPool, ctx.config_.descriptorSetCacheSize)),
     dsl_(dsl) {
     IGL_DEBUG_ASSERT(debugName);
+    IGL_DEBUG_ASSERT(numTypes <= IGL_ARRAY_NUM_ELEMENTS(types_));
+    std::copy(types, types + numTypes, types_);
     dpDebugName_ = IGL_FORMAT("Descriptor Pool: {}", debugName ? debugName : "");
   }
   ~DescriptorPoolsArena() {
@@ -246,13 +252,117 @@ class DescriptorPoolsArena final {
     }
     VK_ASSERT(ivkAllocateDescriptorSet(&ctx_.vf_, device_, pool_, dsl_, &dset));
     numRemainingDSetsInPool_--;
+    ctx_.numDescriptorSetsAllocated_++;
+    return dset;
+  }
+  /** @brief Returns a descriptor set with the contents of `writes`. If the same contents were
+   * written into a descriptor set of the current pool before, that descriptor set is reused.
+   * Otherwise, a new descriptor set is allocated and updated with `writes`. The `dstSet` members
+   * of `writes` are overwritten. `mutex` guards the arena and is not locked during the update.
+   */
+  [[nodiscard]] VkDescriptorSet acquireDescriptorSet(
+      std::mutex& mutex,
+      VulkanImmediateCommands& ic,
+      VulkanImmediateCommands::SubmitHandle nextSubmitHandle,
+      VkWriteDescriptorSet* writes,
+      uint32_t numWrites) {
+    const uint32_t cacheSize = ctx_.config_.descriptorSetCacheSize;
+    const DescriptorSetContents contents(writes, numWrites);
+
+    VkDescriptorSet dset = VK_NULL_HANDLE;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    uint64_t generation = 0;
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      if (cacheSize) {
+        generation = ctx_.descriptorSetCacheGeneration_;
+        if (cacheGeneration_ != generation) {
+          cache_.clear();
+          cacheGeneration_ = generation;
+        }
+        const auto it = cache_.find(contents.hash);
+        if (it != cache_.end() && contents.matches(it->second.values)) {
+          ctx_.numDescriptorSetCacheHits_++;
+          return it->second.dset;
+        }
+        ctx_.numDescriptorSetCacheMisses_++;
+      }
+      dset = getNextDescriptorSet(ic, nextSubmitHandle);
+      pool = pool_;
+    }
+
+    for (uint32_t i = 0; i != numWrites; i++) {
+      writes[i].dstSet = dset;
+    }
+
+    IGL_PROFILER_ZONE("vkUpdateDescriptorSets()", IGL_PROFILER_COLOR_UPDATE);
+    ctx_.vf_.vkUpdateDescriptorSets(device_, numWrites, writes, 0, nullptr);
+    IGL_PROFILER_ZONE_END();
+
+    if (cacheSize) {
+      std::lock_guard<std::mutex> guard(mutex);
+      // the pool could have been switched or the bound resources destroyed by another thread
+      if (pool == pool_ && generation == ctx_.descriptorSetCacheGeneration_) {
+        if (cache_.size() >= cacheSize) {
+          cache_.clear();
+        }
+        cache_[contents.hash] = {contents.getValues(), dset};
+      }
+    }
+
     return dset;
   }
 
  private:
+  /// @brief The values written into a descriptor set by an array of VkWriteDescriptorSet
+  struct DescriptorSetContents {
+    static constexpr uint32_t kValuesPerWrite = 4;
+    static constexpr uint32_t kMaxValues =
+        kValuesPerWrite * std::max(IGL_TEXTURE_SAMPLERS_MAX, IGL_UNIFORM_BLOCKS_BINDING_MAX);
+
+    DescriptorSetContents(const VkWriteDescriptorSet* writes, uint32_t numWrites) {
+      IGL_DEBUG_ASSERT(numWrites * kValuesPerWrite <= kMaxValues);
+      for (uint32_t i = 0; i != numWrites; i++) {
+        const VkWriteDescriptorSet& w = writes[i];
+        IGL_DEBUG_ASSERT(w.descriptorCount == 1);
+        values[numValues++] = (uint64_t(w.descriptorType) << 32) | w.dstBinding;
+        if (w.pImageInfo) {
+          values[numValues++] = (uint64_t)w.pImageInfo->sampler;
+          values[numValues++] = (uint64_t)w.pImageInfo->imageView;
+          values[numValues++] = w.pImageInfo->imageLayout;
+        } else {
+          IGL_DEBUG_ASSERT(w.pBufferInfo);
+          values[numValues++] = (uint64_t)w.pBufferInfo->buffer;
+          values[numValues++] = w.pBufferInfo->offset;
+          values[numValues++] = w.pBufferInfo->range;
+        }
+      }
+      for (uint32_t i = 0; i != numValues; i++) {
+        hash = hash * 31 + std::hash<uint64_t>()(values[i]);
+      }
+    }
+    [[nodiscard]] bool matches(const std::vector<uint64_t>& other) const {
+      return std::equal(other.begin(), other.end(), values, values + numValues);
+    }
+    [[nodiscard]] std::vector<uint64_t> getValues() const {
+      return {values, values + numValues};
+    }
+
+    uint64_t values[kMaxValues]; // uninitialized
+    uint32_t numValues = 0;
+    uint64_t hash = 0;
+  };
+  struct CachedDescriptorSet {
+    std::vector<uint64_t> values;
+    VkDescriptorSet dset = VK_NULL_HANDLE;
+  };
+
   void switchToNewDescriptorPool(VulkanImmediateCommands& ic,
                                  VulkanImmediateCommands::SubmitHandle nextSubmitHandle) {
-    numRemainingDSetsInPool_ = kNumDSetsPerPool;
+    numRemainingDSetsInPool_ = numDSetsPerPool_;
+    // cached descriptor sets must not outlive the current pool: once the pool is retired, it can be
+    // reset as soon as its SubmitHandle has completed
+    cache_.clear();
 
     if (pool_ != VK_NULL_HANDLE) {
       extinct_.push_back({pool_, nextSubmitHandle});
@@ -272,12 +382,12 @@ class DescriptorPoolsArena final {
     VkDescriptorPoolSize poolSizes[IGL_ARRAY_NUM_ELEMENTS(types_)];
     for (uint32_t i = 0; i != numTypes_; i++) {
       poolSizes[i] = VkDescriptorPoolSize{
-          types_[i], numDescriptorsPerDSet_ ? kNumDSetsPerPool * numDescriptorsPerDSet_ : 1u};
+          types_[i], numDescriptorsPerDSet_ ? numDSetsPerPool_ * numDescriptorsPerDSet_ : 1u};
     }
     VK_ASSERT(ivkCreateDescriptorPool(&ctx_.vf_,
                                       device_,
                                       VkDescriptorPoolCreateFlags{},
-                                      kNumDSetsPerPool,
+                                      numDSetsPerPool_,
                                       numTypes_,
                                       poolSizes,
                                       &pool_));
@@ -292,8 +402,12 @@ class DescriptorPoolsArena final {
   VkDevice device_ = VK_NULL_HANDLE;
   VkDescriptorPool pool_ = VK_NULL_HANDLE;
   const uint32_t numTypes_ = 0;
-  VkDescriptorType types_[2] = {VK_DESCRIPTOR_TYPE_MAX_ENUM, VK_DESCRIPTOR_TYPE_MAX_ENUM};
+  VkDescriptorType types_[4] = {VK_DESCRIPTOR_TYPE_MAX_ENUM,
+                               VK_DESCRIPTOR_TYPE_MAX_ENUM,
+                               VK_DESCRIPTOR_TYPE_MAX_ENUM,
+                               VK_DESCRIPTOR_TYPE_MAX_ENUM};
   const uint32_t numDescriptorsPerDSet_ = 0;
+  const uint32_t numDSetsPerPool_ = kNumDSetsPerPool;
   uint32_t numRemainingDSetsInPool_ = 0;
   std::string dpDebugName_;
 
@@ -305,6 +419,10 @@ class DescriptorPoolsArena final {
   };
 
   std::deque<ExtinctDescriptorPool> extinct_;
+
+  // descriptor sets of the current pool, keyed by DescriptorSetContents::hash
+  std::unordered_map<uint64_t, CachedDescriptorSet> cache_;
+  uint64_t cacheGeneration_ = 0;
 };
 
 namespace {
@@ -316,6 +434,8 @@ struct BindGroupMetadataTextures {
   // hot
   VkDescriptorSet dset = VK_NULL_HANDLE;
   uint32_t usageMask = 0;
+  // the same descriptors for VK_KHR_push_descriptor
+  BindingsTextures bindings = {};
 };
 
 struct BindGroupMetadataBuffers {
@@ -332,6 +452,10 @@ struct BindGroupMetadataBuffers {
 struct VulkanContextImpl final {
   std::thread::id contextThread = std::this_thread::get_id();
 
+  // guards the descriptor pools arenas below; descriptor sets can be allocated concurrently by
+  // secondary render command encoders recorded on different threads
+  std::mutex arenasMutex;
+
   // Vulkan Memory Allocator
   VmaAllocator vma = VK_NULL_HANDLE;
   // :)
@@ -389,19 +513,23 @@ struct VulkanContextImpl final {
   // NOLINTBEGIN(readability-identifier-naming)
   igl::vulkan::DescriptorPoolsArena& getOrCreateArena_Buffers(const VulkanContext& ctx,
                                                               VkDescriptorSetLayout dsl,
-                                                              uint32_t numBindings)
+                                                              uint32_t numBindings,
+                                                              bool hasDynamicBuffers)
   // NOLINTEND(readability-identifier-naming)
   {
     auto it = arenaBuffers.find(dsl);
     if (it != arenaBuffers.end()) {
       return *it->second;
     }
-    arenaBuffers[dsl] = std::make_unique<DescriptorPoolsArena>(ctx,
-                                                               VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                                               VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-                                                               dsl,
-                                                               numBindings,
-                                                               "arenaBuffers_");
+    // dynamic descriptor types are only needed for layouts with dynamic bindings
+    const VkDescriptorType types[] = {
+        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+    };
+    arenaBuffers[dsl] = std::make_unique<DescriptorPoolsArena>(
+        ctx, types, hasDynamicBuffers ? 4u : 2u, dsl, numBindings, "arenaBuffers_");
     return *arenaBuffers[dsl].get();
   }
 };
@@ -460,6 +588,9 @@ VulkanContext::~VulkanContext() {
     waitIdle();
   }
 
+  // finish all background pipeline compilations before anything is destroyed
+  pipelineCompiler_.reset(nullptr);
+
 #if defined(IGL_WITH_TRACY_GPU)
   if (tracyCtx_) {
     TracyVkDestroy(tracyCtx_);
@@ -469,6 +600,7 @@ VulkanContext::~VulkanContext() {
 
   enhancedShaderDebuggingStore_.reset(nullptr);
 
+  uniformRingBuffer_.reset();
   dummyStorageBuffer_.reset();
   dummyUniformBuffer_.reset();
 
@@ -521,6 +653,7 @@ VulkanContext::~VulkanContext() {
 
   waitDeferredTasks();
 
+  framePacer_.reset(nullptr);
   immediate_.reset(nullptr);
   timelineSemaphore_.reset(nullptr);
 
@@ -536,7 +669,13 @@ VulkanContext::~VulkanContext() {
     pimpl_->arenaCombinedImageSamplers.clear();
     pimpl_->arenaStorageImages.clear();
     pimpl_->arenaBuffers.clear();
-    vf_.vkDestroyPipelineCache(device, pipelineCache_, nullptr);
+    if (pipelineCache_ && pipelineCache_->hasFilePath()) {
+      const Result result = pipelineCache_->save();
+      if (!result.isOk()) {
+        IGL_LOG_ERROR("Cannot save the pipeline cache: %s\n", result.message.c_str());
+      }
+    }
+    pipelineCache_.reset(nullptr);
   }
 
   if (vkSurface_ != VK_NULL_HANDLE) {
@@ -566,6 +705,11 @@ VulkanContext::~VulkanContext() {
                  VulkanPipelineBuilder::getNumPipelinesCreated());
     IGL_LOG_INFO("Vulkan compute pipelines created: %u\n",
                  VulkanComputePipelineBuilder::getNumPipelinesCreated());
+    IGL_LOG_INFO("Vulkan descriptor sets allocated: %zu, pushed: %zu\n",
+                 numDescriptorSetsAllocated_.load(),
+                 numDescriptorSetsPushed_.load());
+    IGL_LOG_INFO("Vulkan descriptor set cache hit rate: %.1f%%\n",
+                 100.0 * getDescriptorSetCacheStats().getHitRate());
   }
 #endif // IGL_LOGGING_ENABLED
 
@@ -895,6 +1039,11 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
     return Result(Result::Code::InvalidOperation, "Cannot initialize VK_KHR_buffer_device_address");
   }
 
+  // IGL_TEXTURE_SAMPLERS_MAX is below the guaranteed minimum of maxPushDescriptors (32), so every
+  // combined image sampler descriptor set layout can be pushed
+  usePushDescriptors_ =
+      features_.has_VK_KHR_push_descriptor && vf_.vkCmdPushDescriptorSetKHR != nullptr;
+
   vf_.vkGetDeviceQueue(
       device, deviceQueues_.graphicsQueueFamilyIndex, 0, &deviceQueues_.graphicsQueue);
   vf_.vkGetDeviceQueue(
@@ -917,16 +1066,18 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
                    "Max resource count needs to be greater than zero");
   syncSubmitHandles_.resize(config_.maxResourceCount);
 
+  framePacer_ =
+      std::make_unique<VulkanFramePacer>(*this, config_.maxFramesInFlight, config_.lowLatencyMode);
+
   // create Vulkan pipeline cache
-  {
-    const VkPipelineCacheCreateInfo ci = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-        .flags = VkPipelineCacheCreateFlags(0),
-        .initialDataSize = config_.pipelineCacheDataSize,
-        .pInitialData = config_.pipelineCacheData,
-    };
-    vf_.vkCreatePipelineCache(device, &ci, nullptr, &pipelineCache_);
-  }
+  pipelineCache_ = std::make_unique<VulkanPipelineCache>(vf_,
+                                                         device,
+                                                         getVkPhysicalDeviceProperties(),
+                                                         config_.pipelineCacheFilePath,
+                                                         config_.pipelineCacheData,
+                                                         config_.pipelineCacheDataSize);
+
+  pipelineCompiler_ = std::make_unique<VulkanPipelineCompiler>(config_.numPipelineCompileThreads);
 
   // Create Vulkan Memory Allocator
   if (IGL_VULKAN_USE_VMA) {
@@ -959,6 +1110,11 @@ igl::Result VulkanContext::initContext(const HWDeviceDesc& desc,
                                      nullptr,
                                      "Buffer: dummy storage");
 
+  if (config_.uniformRingBufferSize) {
+    uniformRingBuffer_ =
+        std::make_unique<VulkanUniformRingBuffer>(*this, config_.uniformRingBufferSize);
+  }
+
   // default texture
   {
     const VkFormat dummyTextureFormat = VK_FORMAT_R8G8B8A8_UNORM;
@@ -1221,6 +1377,8 @@ igl::Result VulkanContext::initSwapchain(uint32_t width, uint32_t height) {
   if (swapchain_) {
     vf_.vkDeviceWaitIdle(device_->device_);
     swapchain_ = nullptr; // Destroy old swapchain first
+    // the timeline values of the previous frames belong to the old timeline semaphore
+    framePacer_->reset();
   }
 
   if (!width || !height) {
@@ -1699,18 +1857,11 @@ VulkanContext::RenderPassHandle VulkanContext::findRenderPass(
 }
 
 std::vector<uint8_t> VulkanContext::getPipelineCacheData() const {
-  VkDevice device = device_->getVkDevice();
-
-  size_t size = 0;
-  vf_.vkGetPipelineCacheData(device, pipelineCache_, &size, nullptr);
-
-  std::vector<uint8_t> data(size);
-
-  if (size) {
-    vf_.vkGetPipelineCacheData(device, pipelineCache_, &size, data.data());
-  }
+  return pipelineCache_->getData();
+}
 
-  return data;
+Result VulkanContext::savePipelineCache() const {
+  return pipelineCache_->save();
 }
 
 uint64_t VulkanContext::getFrameNumber() const {
@@ -1726,11 +1877,6 @@ void VulkanContext::updateBindingsTextures(VkCommandBuffer IGL_NONNULL cmdBuf,
                                            const util::SpvModuleInfo& info) const {
   IGL_PROFILER_FUNCTION();
 
-  DescriptorPoolsArena& arena = pimpl_->getOrCreateArena_CombinedImageSamplers(
-      *this, dsl.getVkDescriptorSetLayout(), dsl.numBindings_);
-
-  VkDescriptorSet dset = arena.getNextDescriptorSet(*immediate_, nextSubmitHandle);
-
   // @fb-only
   VkDescriptorImageInfo infoSampledImages[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
   uint32_t numImages = 0;
@@ -1759,8 +1905,13 @@ void VulkanContext::updateBindingsTextures(VkCommandBuffer IGL_NONNULL cmdBuf,
       IGL_DEBUG_ASSERT(data.samplers[loc], "A sampler should be bound to every bound texture slot");
     }
     VkSampler sampler = data.samplers[loc] ? data.samplers[loc] : dummySampler;
-    writes[numWrites++] = ivkGetWriteDescriptorSet_ImageInfo(
-        dset, loc, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, &infoSampledImages[numImages]);
+    // `dstSet` is filled in later; push descriptors do not need a descriptor set at all
+    writes[numWrites++] =
+        ivkGetWriteDescriptorSet_ImageInfo(VK_NULL_HANDLE,
+                                           loc,
+                                           VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                           1,
+                                           &infoSampledImages[numImages]);
     infoSampledImages[numImages++] = VkDescriptorImageInfo{
         .sampler = hasTexture ? sampler : dummySampler,
         .imageView = hasTexture ? texture : dummyImageView,
@@ -1768,17 +1919,34 @@ void VulkanContext::updateBindingsTextures(VkCommandBuffer IGL_NONNULL cmdBuf,
     };
   }
 
-  if (numWrites) {
-    IGL_PROFILER_ZONE("vkUpdateDescriptorSets()", IGL_PROFILER_COLOR_UPDATE);
-    vf_.vkUpdateDescriptorSets(device_->getVkDevice(), numWrites, writes, 0, nullptr);
-    IGL_PROFILER_ZONE_END();
+  if (!numWrites) {
+    return;
+  }
 
+  if (usePushDescriptors_) {
 #if IGL_VULKAN_PRINT_COMMANDS
-    IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - textures\n", cmdBuf, bindPoint);
+    IGL_LOG_INFO("%p vkCmdPushDescriptorSetKHR(%u) - textures\n", cmdBuf, bindPoint);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-    vf_.vkCmdBindDescriptorSets(
-        cmdBuf, bindPoint, layout, kBindPoint_CombinedImageSamplers, 1, &dset, 0, nullptr);
+    vf_.vkCmdPushDescriptorSetKHR(
+        cmdBuf, bindPoint, layout, kBindPoint_CombinedImageSamplers, numWrites, writes);
+    numDescriptorSetsPushed_++;
+    return;
+  }
+
+  DescriptorPoolsArena* arena = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(pimpl_->arenasMutex);
+    arena = &pimpl_->getOrCreateArena_CombinedImageSamplers(
+        *this, dsl.getVkDescriptorSetLayout(), dsl.numBindings_);
   }
+  VkDescriptorSet dset = arena->acquireDescriptorSet(
+      pimpl_->arenasMutex, *immediate_, nextSubmitHandle, writes, numWrites);
+
+#if IGL_VULKAN_PRINT_COMMANDS
+  IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - textures\n", cmdBuf, bindPoint);
+#endif // IGL_VULKAN_PRINT_COMMANDS
+  vf_.vkCmdBindDescriptorSets(
+      cmdBuf, bindPoint, layout, kBindPoint_CombinedImageSamplers, 1, &dset, 0, nullptr);
 }
 
 void VulkanContext::updateBindingsStorageImages(
@@ -1791,11 +1959,6 @@ void VulkanContext::updateBindingsStorageImages(
     const util::SpvModuleInfo& info) const {
   IGL_PROFILER_FUNCTION();
 
-  DescriptorPoolsArena& arena = pimpl_->getOrCreateArena_StorageImages(
-      *this, dsl.getVkDescriptorSetLayout(), dsl.numBindings_);
-
-  VkDescriptorSet dset = arena.getNextDescriptorSet(*immediate_, nextSubmitHandle);
-
   // @fb-only
   VkDescriptorImageInfo infoStorageImages[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
   uint32_t numStorageImages = 0;
@@ -1815,8 +1978,11 @@ void VulkanContext::updateBindingsStorageImages(
     const uint32_t loc = d.bindingLocation;
     IGL_DEBUG_ASSERT(loc < IGL_TEXTURE_SAMPLERS_MAX);
     VkImageView imageView = data.images[loc];
-    writes[numWrites++] = ivkGetWriteDescriptorSet_ImageInfo(
-        dset, loc, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, &infoStorageImages[numStorageImages]);
+    writes[numWrites++] = ivkGetWriteDescriptorSet_ImageInfo(VK_NULL_HANDLE,
+                                                             loc,
+                                                             VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                                                             1,
+                                                             &infoStorageImages[numStorageImages]);
     infoStorageImages[numStorageImages++] = VkDescriptorImageInfo{
         .sampler = VK_NULL_HANDLE,
         .imageView = imageView ? imageView : dummyImageView,
@@ -1824,17 +1990,24 @@ void VulkanContext::updateBindingsStorageImages(
     };
   }
 
-  if (numWrites) {
-    IGL_PROFILER_ZONE("vkUpdateDescriptorSets()", IGL_PROFILER_COLOR_UPDATE);
-    vf_.vkUpdateDescriptorSets(device_->getVkDevice(), numWrites, writes, 0, nullptr);
-    IGL_PROFILER_ZONE_END();
+  if (!numWrites) {
+    return;
+  }
+
+  DescriptorPoolsArena* arena = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(pimpl_->arenasMutex);
+    arena = &pimpl_->getOrCreateArena_StorageImages(
+        *this, dsl.getVkDescriptorSetLayout(), dsl.numBindings_);
+  }
+  VkDescriptorSet dset = arena->acquireDescriptorSet(
+      pimpl_->arenasMutex, *immediate_, nextSubmitHandle, writes, numWrites);
 
 #if IGL_VULKAN_PRINT_COMMANDS
-    IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - storage images\n", cmdBuf, bindPoint);
+  IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - storage images\n", cmdBuf, bindPoint);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-    vf_.vkCmdBindDescriptorSets(
-        cmdBuf, bindPoint, layout, kBindPoint_StorageImages, 1, &dset, 0, nullptr);
-  }
+  vf_.vkCmdBindDescriptorSets(
+      cmdBuf, bindPoint, layout, kBindPoint_StorageImages, 1, &dset, 0, nullptr);
 }
 
 void VulkanContext::updateBindingsBuffers(VkCommandBuffer IGL_NONNULL cmdBuf,
@@ -1843,50 +2016,90 @@ void VulkanContext::updateBindingsBuffers(VkCommandBuffer IGL_NONNULL cmdBuf,
                                           VulkanImmediateCommands::SubmitHandle nextSubmitHandle,
                                           BindingsBuffers& data,
                                           const VulkanDescriptorSetLayout& dsl,
-                                          const util::SpvModuleInfo& info) const {
+                                          const util::SpvModuleInfo& info,
+                                          uint32_t isDynamicBufferMask) const {
   IGL_PROFILER_FUNCTION();
 
-  DescriptorPoolsArena& arena =
-      pimpl_->getOrCreateArena_Buffers(*this, dsl.getVkDescriptorSetLayout(), dsl.numBindings_);
-
-  VkDescriptorSet dset = arena.getNextDescriptorSet(*immediate_, nextSubmitHandle);
-
   // @fb-only
   VkWriteDescriptorSet writes[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
   uint32_t numWrites = 0;
 
+  // Dynamic bindings are written with a zero offset and get their offsets from
+  // vkCmdBindDescriptorSets(). Their descriptors do not change when only the offsets change, so
+  // the descriptor set cache can reuse them (e.g. for sub-allocations from the same buffer).
+  VkDescriptorBufferInfo dynamicBuffers[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
+  uint32_t dynamicOffsets[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
+  uint32_t usedDynamicBuffersMask = 0;
+
   for (const util::BufferDescription& b : info.buffers) {
     IGL_DEBUG_ASSERT(b.descriptorSet == kBindPoint_Buffers);
+    const uint32_t loc = b.bindingLocation;
     IGL_DEBUG_ASSERT(
-        data.buffers[b.bindingLocation].buffer != VK_NULL_HANDLE,
+        data.buffers[loc].buffer != VK_NULL_HANDLE,
         IGL_FORMAT("Did you forget to call bindBuffer() for a buffer at the binding location {}?",
-                   b.bindingLocation)
+                   loc)
             .c_str());
-    writes[numWrites++] = ivkGetWriteDescriptorSet_BufferInfo(
-        dset,
-        b.bindingLocation,
-        b.isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-        1,
-        &data.buffers[b.bindingLocation]);
+    const bool isDynamic = (isDynamicBufferMask & (1u << loc)) != 0;
+    const VkDescriptorBufferInfo* bufferInfo = &data.buffers[loc];
+    if (isDynamic) {
+      usedDynamicBuffersMask |= 1u << loc;
+      dynamicBuffers[loc] = *bufferInfo;
+      dynamicOffsets[loc] = 0;
+      // VK_WHOLE_SIZE ranges are relative to the offset, so they keep it in the descriptor
+      if (dynamicBuffers[loc].range != VK_WHOLE_SIZE) {
+        dynamicOffsets[loc] = static_cast<uint32_t>(dynamicBuffers[loc].offset);
+        dynamicBuffers[loc].offset = 0;
+      }
+      bufferInfo = &dynamicBuffers[loc];
+    }
+    const VkDescriptorType type =
+        b.isStorage ? (isDynamic ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC
+                                 : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                    : (isDynamic ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+                                 : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    writes[numWrites++] =
+        ivkGetWriteDescriptorSet_BufferInfo(VK_NULL_HANDLE, loc, type, 1, bufferInfo);
   }
 
-  if (numWrites) {
-    IGL_PROFILER_ZONE("vkUpdateDescriptorSets()", IGL_PROFILER_COLOR_UPDATE);
-    vf_.vkUpdateDescriptorSets(device_->getVkDevice(), numWrites, writes, 0, nullptr);
-    IGL_PROFILER_ZONE_END();
+  if (!numWrites) {
+    return;
+  }
+
+  // dynamic offsets are consumed in the order of binding numbers
+  uint32_t numDynamicOffsets = 0;
+  for (uint32_t loc = 0; loc != IGL_UNIFORM_BLOCKS_BINDING_MAX; loc++) {
+    if (usedDynamicBuffersMask & (1u << loc)) {
+      dynamicOffsets[numDynamicOffsets++] = dynamicOffsets[loc];
+    }
+  }
+
+  DescriptorPoolsArena* arena = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(pimpl_->arenasMutex);
+    arena = &pimpl_->getOrCreateArena_Buffers(
+        *this, dsl.getVkDescriptorSetLayout(), dsl.numBindings_, usedDynamicBuffersMask != 0);
+  }
+  VkDescriptorSet dset = arena->acquireDescriptorSet(
+      pimpl_->arenasMutex, *immediate_, nextSubmitHandle, writes, numWrites);
 
 #if IGL_VULKAN_PRINT_COMMANDS
-    IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - buffers\n", cmdBuf, bindPoint);
+  IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - buffers\n", cmdBuf, bindPoint);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-    vf_.vkCmdBindDescriptorSets(
-        cmdBuf, bindPoint, layout, kBindPoint_Buffers, 1, &dset, 0, nullptr);
-  }
+  vf_.vkCmdBindDescriptorSets(cmdBuf,
+                              bindPoint,
+                              layout,
+                              kBindPoint_Buffers,
+                              1,
+                              &dset,
+                              numDynamicOffsets,
+                              numDynamicOffsets ? dynamicOffsets : nullptr);
 }
 
 void VulkanContext::deferredTask(std::packaged_task<void()>&& task, SubmitHandle handle) const {
   if (handle.empty()) {
     handle = immediate_->getNextSubmitHandle();
   }
+  const std::lock_guard<std::mutex> guard(deferredTasksMutex_);
   deferredTasks_.emplace_back(std::move(task), handle);
   deferredTasks_.back().frameId_ = this->getFrameNumber();
 }
@@ -1905,13 +2118,20 @@ void VulkanContext::processDeferredTasks() const {
   const uint64_t frameId = getFrameNumber();
   constexpr uint64_t kNumWaitFrames = 3u;
 
+  std::unique_lock<std::mutex> lock(deferredTasksMutex_);
+
   while (!deferredTasks_.empty() && immediate_->isReady(deferredTasks_.front().handle_)) {
     if (frameId && frameId <= deferredTasks_.front().frameId_ + kNumWaitFrames) {
       // do not check anything if it is not yet older than kNumWaitFrames
       break;
     }
-    deferredTasks_.front().task_();
+    std::packaged_task<void()> task = std::move(deferredTasks_.front().task_);
     deferredTasks_.pop_front();
+    descriptorSetCacheGeneration_++;
+    // tasks can schedule other deferred tasks
+    lock.unlock();
+    task();
+    lock.lock();
   }
 }
 
@@ -1920,6 +2140,7 @@ void VulkanContext::waitDeferredTasks() {
 
   for (auto& task : deferredTasks_) {
     immediate_->wait(task.handle_, config_.fenceTimeoutNanoseconds);
+    descriptorSetCacheGeneration_++;
     task.task_();
   }
   deferredTasks_.clear();
@@ -2162,6 +2383,8 @@ igl::BindGroupTextureHandle VulkanContext::createBindGroup(const BindGroupTextur
         isSampledImage ? texture.imageView_.getVkImageView() : dummyImageView,
         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
     };
+    metadata.bindings.textures[loc] = images[numWrites - 1].imageView;
+    metadata.bindings.samplers[loc] = images[numWrites - 1].sampler;
   }
 
   if (!IGL_DEBUG_VERIFY(numWrites)) {
@@ -2394,6 +2617,11 @@ uint32_t VulkanContext::getBindGroupUsageMask(igl::BindGroupTextureHandle handle
   return handle.valid() ? pimpl_->bindGroupTexturesPool.get(handle)->usageMask : 0;
 }
 
+const BindingsTextures* IGL_NULLABLE
+VulkanContext::getBindGroupBindings(igl::BindGroupTextureHandle handle) const {
+  return handle.valid() ? &pimpl_->bindGroupTexturesPool.get(handle)->bindings : nullptr;
+}
+
 VkDescriptorSet VulkanContext::getBindGroupDescriptorSet(igl::BindGroupBufferHandle handle) const {
   return handle.valid() ? pimpl_->bindGroupBuffersPool.get(handle)->dset : VK_NULL_HANDLE;
 }
@@ -2406,6 +2634,28 @@ const VulkanFeatures& VulkanContext::features() const noexcept {
   return features_;
 }
 
+VulkanContext::DescriptorSetCacheStats VulkanContext::getDescriptorSetCacheStats() const noexcept {
+  return {
+      .numHits = numDescriptorSetCacheHits_,
+      .numMisses = numDescriptorSetCacheMisses_,
+  };
+}
+
+void VulkanContext::resetDescriptorSetCacheStats() const noexcept {
+  numDescriptorSetCacheHits_ = 0;
+  numDescriptorSetCacheMisses_ = 0;
+}
+
+VulkanUniformRingBuffer::Stats VulkanContext::getUniformRingBufferStats() const {
+  return uniformRingBuffer_ ? uniformRingBuffer_->getStats() : VulkanUniformRingBuffer::Stats{};
+}
+
+void VulkanContext::resetUniformRingBufferStats() const {
+  if (uniformRingBuffer_) {
+    uniformRingBuffer_->resetStats();
+  }
+}
+
 void VulkanContext::syncAcquireNext() noexcept {
   IGL_PROFILER_FUNCTION();
 
@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include <igl/CommandEncoder.h>
@@ -17,11 +19,15 @@
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanDevice.h>
 #include <igl/vulkan/VulkanFeatures.h>
+#include <igl/vulkan/VulkanFramePacer.h>
 #include <igl/vulkan/VulkanHelpers.h>
 #include <igl/vulkan/VulkanImmediateCommands.h>
+#include <igl/vulkan/VulkanPipelineCache.h>
+#include <igl/vulkan/VulkanPipelineCompiler.h>
 #include <igl/vulkan/VulkanQueuePool.h>
 #include <igl/vulkan/VulkanRenderPassBuilder.h>
 #include <igl/vulkan/VulkanStagingDevice.h>
+#include <igl/vulkan/VulkanUniformRingBuffer.h>
 
 #if defined(IGL_ANDROID_HWBUFFER_SUPPORTED)
 struct AHardwareBuffer;
@@ -207,6 +213,10 @@ class VulkanContext final {
 
   std::vector<uint8_t> getPipelineCacheData() const;
 
+  /// @brief Writes the pipeline cache to VulkanContextConfig::pipelineCacheFilePath. This also
+  /// happens automatically when the context is destroyed
+  Result savePipelineCache() const;
+
   uint64_t getFrameNumber() const;
 
   using SubmitHandle = VulkanImmediateCommands::SubmitHandle;
@@ -224,6 +234,24 @@ class VulkanContext final {
 
   const VulkanFeatures& features() const noexcept;
 
+  struct DescriptorSetCacheStats {
+    uint64_t numHits = 0;
+    uint64_t numMisses = 0;
+
+    [[nodiscard]] double getHitRate() const noexcept {
+      return numHits + numMisses ? double(numHits) / double(numHits + numMisses) : 0.0;
+    }
+  };
+
+  /// @brief Statistics of the descriptor set cache (VulkanContextConfig::descriptorSetCacheSize)
+  [[nodiscard]] DescriptorSetCacheStats getDescriptorSetCacheStats() const noexcept;
+  void resetDescriptorSetCacheStats() const noexcept;
+
+  /// @brief Statistics of the buffer which backs bindBytes()
+  /// (VulkanContextConfig::uniformRingBufferSize)
+  [[nodiscard]] VulkanUniformRingBuffer::Stats getUniformRingBufferStats() const;
+  void resetUniformRingBufferStats() const;
+
   [[nodiscard]] const VkSurfaceCapabilitiesKHR& getSurfaceCapabilities() const noexcept {
     return deviceSurfaceCaps_;
   }
@@ -268,14 +296,18 @@ class VulkanContext final {
   VkDescriptorSet getBindGroupDescriptorSet(BindGroupTextureHandle handle) const;
   VkDescriptorSet getBindGroupDescriptorSet(BindGroupBufferHandle handle) const;
   uint32_t getBindGroupUsageMask(BindGroupTextureHandle handle) const;
+  const BindingsTextures* IGL_NULLABLE getBindGroupBindings(BindGroupTextureHandle handle) const;
   uint32_t getBindGroupUsageMask(BindGroupBufferHandle handle) const;
 
  private:
   friend class Device;
   friend class VulkanStagingDevice;
+  friend class VulkanFramePacer;
   friend class VulkanSwapchain;
+  friend class VulkanUniformRingBuffer;
   friend class CommandQueue;
   friend class ComputeCommandEncoder;
+  friend class QueryPool;
   friend class RenderCommandEncoder;
 
   // should be kept on the heap, otherwise global Vulkan functions can cause arbitrary crashes.
@@ -304,17 +336,25 @@ class VulkanContext final {
   std::unique_ptr<VulkanDevice> device_;
   std::unique_ptr<VulkanSwapchain> swapchain_;
   std::unique_ptr<VulkanSemaphore> timelineSemaphore_;
+  // frames-in-flight control (VulkanContextConfig::maxFramesInFlight)
+  std::unique_ptr<VulkanFramePacer> framePacer_;
   std::unique_ptr<VulkanImmediateCommands> immediate_;
   std::unique_ptr<VulkanStagingDevice> stagingDevice_;
 
   std::unique_ptr<VulkanBuffer> dummyUniformBuffer_;
   std::unique_ptr<VulkanBuffer> dummyStorageBuffer_;
+  // transient uniform data for bindBytes() (VulkanContextConfig::uniformRingBufferSize)
+  std::unique_ptr<VulkanUniformRingBuffer> uniformRingBuffer_;
   // don't use staging on devices with device-local host-visible memory
   bool useStagingForBuffers_ = true;
+  // combined image samplers are pushed with vkCmdPushDescriptorSetKHR() instead of being allocated
+  // from descriptor pools (VK_KHR_push_descriptor and VulkanContextConfig::enablePushDescriptors)
+  bool usePushDescriptors_ = false;
 
   std::unique_ptr<VulkanContextImpl> pimpl_;
 
-  VkPipelineCache pipelineCache_ = VK_NULL_HANDLE;
+  std::unique_ptr<VulkanPipelineCache> pipelineCache_;
+  std::unique_ptr<VulkanPipelineCompiler> pipelineCompiler_;
 
   mutable std::unordered_map<VkFormat, VkSamplerYcbcrConversionInfo> ycbcrConversionInfos_;
 
@@ -328,7 +368,16 @@ class VulkanContext final {
   // a texture/sampler was created since the last descriptor set update
   mutable bool awaitingCreation_ = false;
 
-  mutable size_t drawCallCount_ = 0;
+  // secondary render command encoders can increment this from multiple threads
+  mutable std::atomic<size_t> drawCallCount_ = 0;
+  // descriptor sets allocated from descriptor pool arenas and vkCmdPushDescriptorSetKHR() calls
+  mutable std::atomic<size_t> numDescriptorSetsAllocated_ = 0;
+  mutable std::atomic<size_t> numDescriptorSetsPushed_ = 0;
+  mutable std::atomic<uint64_t> numDescriptorSetCacheHits_ = 0;
+  mutable std::atomic<uint64_t> numDescriptorSetCacheMisses_ = 0;
+  // incremented before deferred tasks destroy Vulkan objects: the handles of destroyed image views,
+  // samplers and buffers can be reused by new objects, so cached descriptor sets become invalid
+  mutable std::atomic<uint64_t> descriptorSetCacheGeneration_ = 0;
 
   // stores an index into renderPasses_
   mutable std::
@@ -354,7 +403,8 @@ class VulkanContext final {
                              VulkanImmediateCommands::SubmitHandle nextSubmitHandle,
                              BindingsBuffers& data,
                              const VulkanDescriptorSetLayout& dsl,
-                             const util::SpvModuleInfo& info) const;
+                             const util::SpvModuleInfo& info,
+                             uint32_t isDynamicBufferMask) const;
   void updateBindingsStorageImages(VkCommandBuffer IGL_NONNULL cmdBuf,
                                    VkPipelineLayout layout,
                                    VkPipelineBindPoint bindPoint,
@@ -372,6 +422,8 @@ class VulkanContext final {
   };
 
   mutable std::deque<DeferredTask> deferredTasks_;
+  // deferred tasks can be scheduled from threads recording secondary command buffers
+  mutable std::mutex deferredTasksMutex_;
 
   // sync resources
   uint32_t syncCurrentIndex_ = 0u;
@@ -118,6 +118,17 @@ VulkanFeatures::VulkanFeatures(VulkanContextConfig config) noexcept :
       .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MULTIVIEW_PER_VIEW_VIEWPORTS_FEATURES_QCOM,
       .multiviewPerViewViewports = VK_TRUE,
   }),
+  // Vulkan 1.3
+  featuresExtendedDynamicState({
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_FEATURES_EXT,
+      .extendedDynamicState = VK_TRUE,
+  }),
+  featuresExtendedDynamicState2({
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT,
+      .extendedDynamicState2 = VK_TRUE,
+      .extendedDynamicState2LogicOp = VK_FALSE,
+      .extendedDynamicState2PatchControlPoints = VK_FALSE,
+  }),
   config_(config) {
   extensions_.resize(kNumberOfExtensionTypes);
   enabledExtensions_.resize(kNumberOfExtensionTypes);
@@ -266,6 +277,8 @@ void VulkanFeatures::assembleFeatureChain(const VulkanContextConfig& config) noe
   featuresFragmentDensityMap.pNext = nullptr;
   features8BitStorage.pNext = nullptr;
   featuresUniformBufferStandardLayout.pNext = nullptr;
+  featuresExtendedDynamicState.pNext = nullptr;
+  featuresExtendedDynamicState2.pNext = nullptr;
 
   // Add the required and optional features to the VkPhysicalDeviceFetaures2_
   ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresSamplerYcbcrConversion);
@@ -303,6 +316,15 @@ void VulkanFeatures::assembleFeatureChain(const VulkanContextConfig& config) noe
   if (hasExtension(VK_KHR_UNIFORM_BUFFER_STANDARD_LAYOUT_EXTENSION_NAME)) {
     ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresUniformBufferStandardLayout);
   }
+  if (config_.enableExtendedDynamicState) {
+    if (hasExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME)) {
+      ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresExtendedDynamicState);
+    }
+    if (hasExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME)) {
+      ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresExtendedDynamicState2);
+    }
+  }
+
   if (config_.enableMultiviewPerViewViewports) {
     if (hasExtension(VK_QCOM_MULTIVIEW_PER_VIEW_VIEWPORTS_EXTENSION_NAME)) {
       ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresMultiviewPerViewViewports);
@@ -343,6 +365,10 @@ VulkanFeatures& VulkanFeatures::operator=(const VulkanFeatures& other) noexcept
   featuresUniformBufferStandardLayout = other.featuresUniformBufferStandardLayout;
   featuresMultiviewPerViewViewports = other.featuresMultiviewPerViewViewports;
 
+  // Vulkan 1.3
+  featuresExtendedDynamicState = other.featuresExtendedDynamicState;
+  featuresExtendedDynamicState2 = other.featuresExtendedDynamicState2;
+
   extensions_ = other.extensions_;
   enabledExtensions_ = other.enabledExtensions_;
   extensionProps_ = other.extensionProps_;
@@ -494,6 +520,8 @@ void VulkanFeatures::enableCommonDeviceExtensions(const VulkanContextConfig& con
 
   has_VK_EXT_index_type_uint8 =
       enable(VK_EXT_INDEX_TYPE_UINT8_EXTENSION_NAME, ExtensionType::Device);
+  has_VK_EXT_pipeline_creation_feedback =
+      enable(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME, ExtensionType::Device);
   has_VK_EXT_queue_family_foreign =
       enable(VK_EXT_QUEUE_FAMILY_FOREIGN_EXTENSION_NAME, ExtensionType::Device);
 
@@ -520,6 +548,22 @@ void VulkanFeatures::enableCommonDeviceExtensions(const VulkanContextConfig& con
   has_VK_EXT_fragment_density_map =
       enable(VK_EXT_FRAGMENT_DENSITY_MAP_EXTENSION_NAME, ExtensionType::Device);
 
+  if (config.enableExtendedDynamicState) {
+    // the features were queried in populateWithAvailablePhysicalDeviceFeatures()
+    has_VK_EXT_extended_dynamic_state =
+        featuresExtendedDynamicState.extendedDynamicState == VK_TRUE &&
+        enable(VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME, ExtensionType::Device);
+    has_VK_EXT_extended_dynamic_state2 =
+        has_VK_EXT_extended_dynamic_state &&
+        featuresExtendedDynamicState2.extendedDynamicState2 == VK_TRUE &&
+        enable(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME, ExtensionType::Device);
+  }
+
+  if (config.enablePushDescriptors) {
+    has_VK_KHR_push_descriptor =
+        enable(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, ExtensionType::Device);
+  }
+
   if (config_.enableMultiviewPerViewViewports) {
     has_VK_QCOM_multiview_per_view_viewports =
         enable(VK_QCOM_MULTIVIEW_PER_VIEW_VIEWPORTS_EXTENSION_NAME, ExtensionType::Device);
@@ -86,6 +86,10 @@ class VulkanFeatures final {
   VkPhysicalDeviceUniformBufferStandardLayoutFeaturesKHR featuresUniformBufferStandardLayout{};
   VkPhysicalDeviceMultiviewPerViewViewportsFeaturesQCOM featuresMultiviewPerViewViewports{};
 
+  // Vulkan 1.3
+  VkPhysicalDeviceExtendedDynamicStateFeaturesEXT featuresExtendedDynamicState{};
+  VkPhysicalDeviceExtendedDynamicState2FeaturesEXT featuresExtendedDynamicState2{};
+
   // We need to reassemble the feature chain because of the pNext pointers
   VulkanFeatures& operator=(const VulkanFeatures& other) noexcept;
 
@@ -127,13 +131,17 @@ class VulkanFeatures final {
 
   // NOLINTBEGIN(readability-identifier-naming)
   bool has_VK_EXT_descriptor_indexing = false; // promoted to Vulkan 1.2
+  bool has_VK_EXT_extended_dynamic_state = false; // promoted to Vulkan 1.3
+  bool has_VK_EXT_extended_dynamic_state2 = false; // promoted to Vulkan 1.3
   bool has_VK_EXT_fragment_density_map = false;
   bool has_VK_EXT_headless_surface = false;
   bool has_VK_EXT_index_type_uint8 = false; // promoted to Vulkan 1.4
+  bool has_VK_EXT_pipeline_creation_feedback = false; // promoted to Vulkan 1.3
   bool has_VK_EXT_queue_family_foreign = false;
   bool has_VK_KHR_8bit_storage = false; // promoted to Vulkan 1.2
   bool has_VK_KHR_buffer_device_address = false; // promoted to Vulkan 1.2
   bool has_VK_KHR_get_surface_capabilities2 = false;
+  bool has_VK_KHR_push_descriptor = false; // promoted to Vulkan 1.4
   bool has_VK_KHR_shader_non_semantic_info = false; // promoted to Vulkan 1.3
   bool has_VK_KHR_synchronization2 = false; // promoted to Vulkan 1.3
   bool has_VK_KHR_timeline_semaphore = false; // promoted to Vulkan 1.2
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanFramePacer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanSemaphore.h>
+
+namespace igl::vulkan {
+
+namespace {
+
+uint64_t getNanoseconds() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+} // namespace
+
+VulkanFramePacer::VulkanFramePacer(const VulkanContext& ctx,
+                                   uint32_t maxFramesInFlight,
+                                   bool lowLatencyMode) :
+  ctx_(ctx), lowLatencyMode_(lowLatencyMode) {
+  setMaxFramesInFlight(maxFramesInFlight);
+}
+
+void VulkanFramePacer::setMaxFramesInFlight(uint32_t maxFramesInFlight) {
+  maxFramesInFlight_ = maxFramesInFlight ? std::clamp(maxFramesInFlight, 1u, kMaxFramesInFlight)
+                                         : 0u;
+}
+
+bool VulkanFramePacer::isCompleted(const Frame& frame) const {
+  return ctx_.immediate_->isReady(frame.handle);
+}
+
+void VulkanFramePacer::wait(const Frame& frame) const {
+  if (frame.timelineValue && ctx_.timelineSemaphore_) {
+    const VkSemaphore semaphore = ctx_.timelineSemaphore_->getVkSemaphore();
+    const VkSemaphoreWaitInfo waitInfo = {
+        .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+        .semaphoreCount = 1,
+        .pSemaphores = &semaphore,
+        .pValues = &frame.timelineValue,
+    };
+    VK_ASSERT(ctx_.vf_.vkWaitSemaphoresKHR(
+        ctx_.getVkDevice(), &waitInfo, ctx_.config_.fenceTimeoutNanoseconds));
+  } else {
+    VK_ASSERT(ctx_.immediate_->wait(frame.handle, ctx_.config_.fenceTimeoutNanoseconds));
+  }
+}
+
+void VulkanFramePacer::waitForFrameSlot() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
+
+  while (!frames_.empty() && isCompleted(frames_.front())) {
+    frames_.pop_front();
+  }
+
+  const uint32_t maxFramesInFlight = maxFramesInFlight_;
+
+  if (!maxFramesInFlight || frames_.size() < maxFramesInFlight) {
+    return;
+  }
+
+  const uint64_t start = getNanoseconds();
+
+  while (frames_.size() >= maxFramesInFlight) {
+    wait(frames_.front());
+    frames_.pop_front();
+  }
+
+  pendingWaitNanos_ += getNanoseconds() - start;
+}
+
+void VulkanFramePacer::beginFrame() {
+  IGL_PROFILER_FUNCTION();
+
+  waitForFrameSlot();
+}
+
+void VulkanFramePacer::endFrame(VulkanImmediateCommands::SubmitHandle handle,
+                                uint64_t timelineValue) {
+  IGL_PROFILER_FUNCTION();
+
+  frames_.push_back({handle, timelineValue});
+
+  while (!frames_.empty() && isCompleted(frames_.front())) {
+    frames_.pop_front();
+  }
+
+  stats_.numFrames++;
+  stats_.lastFrameWaitNanos = pendingWaitNanos_;
+  stats_.maxFrameWaitNanos = std::max(stats_.maxFrameWaitNanos, pendingWaitNanos_);
+  stats_.totalWaitNanos += pendingWaitNanos_;
+  stats_.numFramesInFlight = static_cast<uint32_t>(frames_.size());
+  pendingWaitNanos_ = 0;
+
+  if (!lowLatencyMode_) {
+    // this wait is accounted to the next frame
+    waitForFrameSlot();
+  }
+}
+
+void VulkanFramePacer::reset() {
+  frames_.clear();
+  pendingWaitNanos_ = 0;
+}
+
+} // namespace igl::vulkan
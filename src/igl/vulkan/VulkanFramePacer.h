@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+
+namespace igl::vulkan {
+
+class VulkanContext;
+
+/** @brief Limits the number of frames the CPU can get ahead of the GPU. A frame ends when a command
+ * buffer is presented or submitted with `endOfFrame = true`. Before the CPU starts recording a new
+ * frame, it waits until fewer than `getMaxFramesInFlight()` frames are still executing on the GPU.
+ * Presented frames are tracked with VulkanContext::timelineSemaphore_ when it is available and with
+ * SubmitHandles otherwise.
+ *
+ * By default, the wait happens right after a frame is submitted. In the low-latency mode, it is
+ * postponed until the next frame begins (`beginFrame()` or the next swapchain image acquisition),
+ * so the application can sample its input after the wait. The swapchain imposes its own limit of
+ * one frame per swapchain image.
+ */
+class VulkanFramePacer final {
+ public:
+  static constexpr uint32_t kMaxFramesInFlight = 4;
+
+  VulkanFramePacer(const VulkanContext& ctx, uint32_t maxFramesInFlight, bool lowLatencyMode);
+
+  VulkanFramePacer(const VulkanFramePacer&) = delete;
+  VulkanFramePacer& operator=(const VulkanFramePacer&) = delete;
+
+  struct Stats {
+    /// @brief The number of frames which have ended
+    uint64_t numFrames = 0;
+    /// @brief CPU time spent waiting for the GPU before the last frame could be recorded
+    uint64_t lastFrameWaitNanos = 0;
+    /// @brief The longest `lastFrameWaitNanos` so far
+    uint64_t maxFrameWaitNanos = 0;
+    /// @brief CPU time spent waiting for the GPU in all frames
+    uint64_t totalWaitNanos = 0;
+    /// @brief The number of frames executing on the GPU when the last frame ended (including it)
+    uint32_t numFramesInFlight = 0;
+  };
+
+  /// @brief Sets the number of frames of latency, clamped to [1, kMaxFramesInFlight]. Passing 0
+  /// removes the limit (the swapchain still limits the number of frames in flight)
+  void setMaxFramesInFlight(uint32_t maxFramesInFlight);
+  [[nodiscard]] uint32_t getMaxFramesInFlight() const {
+    return maxFramesInFlight_;
+  }
+
+  /// @brief In the low-latency mode, the CPU waits at the start of a frame instead of after the
+  /// previous frame was submitted
+  void setLowLatencyMode(bool enabled) {
+    lowLatencyMode_ = enabled;
+  }
+  [[nodiscard]] bool isLowLatencyMode() const {
+    return lowLatencyMode_;
+  }
+
+  /// @brief Marks the start of a frame. Waits for the GPU if too many frames are in flight. Calling
+  /// it again in the same frame does nothing
+  void beginFrame();
+
+  /// @brief Marks the end of a frame. `handle` is the SubmitHandle of the last command buffer of
+  /// the frame. `timelineValue` is the value signaled on VulkanContext::timelineSemaphore_ by this
+  /// command buffer, or 0
+  void endFrame(VulkanImmediateCommands::SubmitHandle handle, uint64_t timelineValue);
+
+  /// @brief Forgets all frames. Only call this when the GPU is idle (e.g. the swapchain was
+  /// recreated)
+  void reset();
+
+  [[nodiscard]] Stats getStats() const {
+    return stats_;
+  }
+  void resetStats() {
+    stats_ = {};
+  }
+
+ private:
+  struct Frame {
+    VulkanImmediateCommands::SubmitHandle handle;
+    uint64_t timelineValue = 0;
+  };
+
+  [[nodiscard]] bool isCompleted(const Frame& frame) const;
+  void wait(const Frame& frame) const;
+  /// @brief Waits until fewer than `maxFramesInFlight_` frames are in flight
+  void waitForFrameSlot();
+
+ private:
+  const VulkanContext& ctx_;
+  std::atomic<uint32_t> maxFramesInFlight_ = 0;
+  std::atomic<bool> lowLatencyMode_ = false;
+  // frames executing on the GPU, from the oldest to the newest
+  std::deque<Frame> frames_;
+  // CPU time spent waiting since the last frame ended
+  uint64_t pendingWaitNanos_ = 0;
+  Stats stats_;
+};
+
+} // namespace igl::vulkan
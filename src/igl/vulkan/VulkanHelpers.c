@@ -284,6 +284,8 @@ VkResult ivkCreateDevice(const struct VulkanFunctionTable* vt,
                                              : VK_TRUE,
       .depthBiasClamp = supported ? supported->features.depthBiasClamp : VK_TRUE,
       .fillModeNonSolid = supported ? supported->features.fillModeNonSolid : VK_TRUE,
+      .pipelineStatisticsQuery = supported ? supported->features.pipelineStatisticsQuery
+                                           : VK_FALSE,
       .shaderInt16 = supported ? supported->features.shaderInt16 : VK_TRUE,
   };
   VkDeviceCreateInfo ci = {
@@ -976,10 +978,11 @@ VkResult ivkCreateGraphicsPipeline(const struct VulkanFunctionTable* vt,
                                    const VkPipelineDynamicStateCreateInfo* dynamicState,
                                    VkPipelineLayout pipelineLayout,
                                    VkRenderPass renderPass,
+                                   const void* pNext,
                                    VkPipeline* outPipeline) {
   const VkGraphicsPipelineCreateInfo ci = {
       .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-      .pNext = NULL,
+      .pNext = pNext,
       .flags = 0,
       .stageCount = numShaderStages,
       .pStages = shaderStages,
@@ -1006,10 +1009,11 @@ VkResult ivkCreateComputePipeline(const struct VulkanFunctionTable* vt,
                                   VkPipelineCache pipelineCache,
                                   const VkPipelineShaderStageCreateInfo* shaderStage,
                                   VkPipelineLayout pipelineLayout,
+                                  const void* pNext,
                                   VkPipeline* outPipeline) {
   const VkComputePipelineCreateInfo ci = {
       .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
-      .pNext = NULL,
+      .pNext = pNext,
       .flags = 0,
       .stage = *shaderStage,
       .layout = pipelineLayout,
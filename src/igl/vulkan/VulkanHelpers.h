@@ -193,6 +193,7 @@ VkResult ivkCreateGraphicsPipeline(const struct VulkanFunctionTable* vt,
                                    const VkPipelineDynamicStateCreateInfo* dynamicState,
                                    VkPipelineLayout pipelineLayout,
                                    VkRenderPass renderPass,
+                                   const void* pNext,
                                    VkPipeline* outPipeline);
 
 VkResult ivkCreateComputePipeline(const struct VulkanFunctionTable* vt,
@@ -200,6 +201,7 @@ VkResult ivkCreateComputePipeline(const struct VulkanFunctionTable* vt,
                                   VkPipelineCache pipelineCache,
                                   const VkPipelineShaderStageCreateInfo* shaderStage,
                                   VkPipelineLayout pipelineLayout,
+                                  const void* pNext,
                                   VkPipeline* outPipeline);
 
 VkResult ivkCreateDescriptorSetLayout(const struct VulkanFunctionTable* vt,
@@ -27,6 +27,7 @@ VulkanImmediateCommands::VulkanImmediateCommands(const VulkanFunctionTable& vf,
                queueFamilyIndex,
                debugName),
   debugName_(debugName),
+  queueFamilyIndex_(queueFamilyIndex),
   lastSubmitSemaphore_({
       .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
       .semaphore = VK_NULL_HANDLE,
@@ -155,6 +156,51 @@ const VulkanImmediateCommands::CommandBufferWrapper& VulkanImmediateCommands::ac
   return *current;
 }
 
+VkCommandBuffer VulkanImmediateCommands::acquireSecondary(uint32_t poolIndex,
+                                                          SubmitHandle parentHandle) {
+  IGL_PROFILER_FUNCTION();
+
+  IGL_DEBUG_ASSERT(!parentHandle.empty());
+
+  if (poolIndex >= secondaryPools_.size()) {
+    secondaryPools_.resize(poolIndex + 1);
+  }
+
+  SecondaryCommandPool& pool = secondaryPools_[poolIndex];
+
+  if (!pool.commandPool_) {
+    pool.commandPool_ = std::make_unique<VulkanCommandPool>(
+        vf_,
+        device_,
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+        queueFamilyIndex_,
+        IGL_FORMAT("{} (secondary #{})", debugName_, poolIndex).c_str());
+  }
+
+  // reuse a secondary command buffer whose primary command buffer has completed execution (never
+  // reuse buffers tagged with the same parent because they have not been submitted yet)
+  for (auto& buf : pool.buffers_) {
+    if (buf.parentHandle_ != parentHandle && isReady(buf.parentHandle_)) {
+      buf.parentHandle_ = parentHandle;
+      return buf.cmdBuf_;
+    }
+  }
+
+  const VkCommandBufferAllocateInfo ai = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+      .commandPool = pool.commandPool_->getVkCommandPool(),
+      .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+      .commandBufferCount = 1,
+  };
+
+  VkCommandBuffer cmdBuf = VK_NULL_HANDLE;
+  VK_ASSERT(vf_.vkAllocateCommandBuffers(device_, &ai, &cmdBuf));
+
+  pool.buffers_.push_back({cmdBuf, parentHandle});
+
+  return cmdBuf;
+}
+
 VkResult VulkanImmediateCommands::wait(const SubmitHandle handle, uint64_t timeoutNanoseconds) {
   if (isReady(handle)) {
     return VK_SUCCESS;
@@ -243,6 +289,18 @@ bool VulkanImmediateCommands::isReady(const SubmitHandle handle) const {
   return vf_.vkWaitForFences(device_, 1, &buf.fence_.vkFence_, VK_TRUE, 0) == VK_SUCCESS;
 }
 
+bool VulkanImmediateCommands::isSubmitted(const SubmitHandle handle) const {
+  IGL_DEBUG_ASSERT(handle.bufferIndex_ < kMaxCommandBuffers);
+
+  if (isRecycled(handle)) {
+    return true;
+  }
+
+  const CommandBufferWrapper& buf = buffers_[handle.bufferIndex_];
+
+  return buf.cmdBuf_ == VK_NULL_HANDLE || !buf.isEncoding_;
+}
+
 VulkanImmediateCommands::SubmitHandle VulkanImmediateCommands::submit(
     const CommandBufferWrapper& wrapper) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_SUBMIT);
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include <igl/vulkan/Common.h>
@@ -118,6 +119,15 @@ class VulkanImmediateCommands final {
   /// it does not exist) and its associated synchronization objects
   const CommandBufferWrapper& acquire();
 
+  /** @brief Returns a secondary command buffer from the command pool associated with
+   * `poolIndex`. Every pool index has its own `VulkanCommandPool`, so secondary command buffers
+   * acquired from different pool indices can be recorded concurrently from different threads. The
+   * returned command buffer is tagged with `parentHandle`, which is the SubmitHandle of the primary
+   * command buffer it will be executed from, and is recycled only after that primary command buffer
+   * has completed execution. The returned command buffer is not in the recording state.
+   */
+  VkCommandBuffer acquireSecondary(uint32_t poolIndex, SubmitHandle parentHandle);
+
   /** @brief Submits a command buffer (stored in a `CommandBufferWrapper` object) for submission and
    * returns the `SubmitHandle` associated with the command buffer. Caches the semaphore associated
    * with the command buffer bineg submitted as the last submitted semaphore
@@ -150,6 +160,11 @@ class VulkanImmediateCommands final {
    */
   [[nodiscard]] bool isReady(SubmitHandle handle) const;
 
+  /// @brief Checks whether the command buffer referred by the SubmitHandle has been submitted, i.e.
+  /// it is not being encoded anymore and waiting for it can complete. Empty and recycled handles
+  /// are submitted
+  [[nodiscard]] bool isSubmitted(SubmitHandle handle) const;
+
   /// @brief If the SubmitHandle is not ready, this function waits for the fence associated with the
   /// command buffer referred by the handle to become signaled. The default wait time is
   /// `UINT64_MAX` nanoseconds. Returns a result code if the wait was successful or not.
@@ -182,6 +197,20 @@ class VulkanImmediateCommands final {
   /// internally in `VulkanImmediateCommands`. A SubmitHandle handle is also recycled if it's empty
   [[nodiscard]] bool isRecycled(SubmitHandle handle) const;
 
+  /// @brief A secondary command buffer and the SubmitHandle of the primary command buffer which
+  /// executes it
+  struct SecondaryCommandBuffer {
+    VkCommandBuffer cmdBuf_ = VK_NULL_HANDLE;
+    SubmitHandle parentHandle_ = {};
+  };
+
+  /// @brief A command pool for secondary command buffers. Each pool is used by one recording
+  /// thread at a time
+  struct SecondaryCommandPool {
+    std::unique_ptr<VulkanCommandPool> commandPool_;
+    std::vector<SecondaryCommandBuffer> buffers_;
+  };
+
  private:
   const VulkanFunctionTable& vf_;
   VkDevice device_ = VK_NULL_HANDLE;
@@ -189,6 +218,8 @@ class VulkanImmediateCommands final {
   VulkanCommandPool commandPool_;
   std::string debugName_;
   std::vector<CommandBufferWrapper> buffers_;
+  std::vector<SecondaryCommandPool> secondaryPools_;
+  uint32_t queueFamilyIndex_ = 0;
 
   /// @brief The last submitted handle. Updated on `submit()`
   SubmitHandle lastSubmitHandle_ = SubmitHandle();
@@ -9,8 +9,8 @@
 
 namespace igl::vulkan {
 
-uint32_t VulkanPipelineBuilder::numPipelinesCreated = 0;
-uint32_t VulkanComputePipelineBuilder::numPipelinesCreated = 0;
+std::atomic<uint32_t> VulkanPipelineBuilder::numPipelinesCreated = 0;
+std::atomic<uint32_t> VulkanComputePipelineBuilder::numPipelinesCreated = 0;
 
 VulkanPipelineBuilder::VulkanPipelineBuilder() :
   vertexInputState_(ivkGetPipelineVertexInputStateCreateInfo_Empty()),
@@ -131,7 +131,8 @@ VkResult VulkanPipelineBuilder::build(const VulkanFunctionTable& vf,
                                       VkPipelineLayout pipelineLayout,
                                       VkRenderPass renderPass,
                                       VkPipeline* outPipeline,
-                                      const char* debugName) noexcept {
+                                      const char* debugName,
+                                      VkPipelineCreationFeedbackEXT* outFeedback) noexcept {
   const VkPipelineDynamicStateCreateInfo dynamicState =
       ivkGetPipelineDynamicStateCreateInfo((uint32_t)dynamicStates_.size(), dynamicStates_.data());
   // viewport and scissor are always dynamic
@@ -141,6 +142,15 @@ VkResult VulkanPipelineBuilder::build(const VulkanFunctionTable& vf,
       ivkGetPipelineColorBlendStateCreateInfo(uint32_t(colorBlendAttachmentStates_.size()),
                                               colorBlendAttachmentStates_.data());
 
+  // some drivers require one feedback structure per shader stage
+  std::vector<VkPipelineCreationFeedbackEXT> stageFeedback(shaderStages_.size());
+  const VkPipelineCreationFeedbackCreateInfoEXT feedbackInfo = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT,
+      .pPipelineCreationFeedback = outFeedback,
+      .pipelineStageCreationFeedbackCount = static_cast<uint32_t>(stageFeedback.size()),
+      .pPipelineStageCreationFeedbacks = stageFeedback.data(),
+  };
+
   const auto result = ivkCreateGraphicsPipeline(&vf,
                                                 device,
                                                 pipelineCache,
@@ -157,6 +167,7 @@ VkResult VulkanPipelineBuilder::build(const VulkanFunctionTable& vf,
                                                 &dynamicState,
                                                 pipelineLayout,
                                                 renderPass,
+                                                outFeedback ? &feedbackInfo : nullptr,
                                                 outPipeline);
 
   if (!IGL_DEBUG_VERIFY(result == VK_SUCCESS)) {
@@ -181,9 +192,22 @@ VkResult VulkanComputePipelineBuilder::build(const VulkanFunctionTable& vf,
                                              VkPipelineCache pipelineCache,
                                              VkPipelineLayout pipelineLayout,
                                              VkPipeline* outPipeline,
-                                             const char* debugName) noexcept {
-  const VkResult result = ivkCreateComputePipeline(
-      &vf, device, pipelineCache, &shaderStage_, pipelineLayout, outPipeline);
+                                             const char* debugName,
+                                             VkPipelineCreationFeedbackEXT* outFeedback) noexcept {
+  VkPipelineCreationFeedbackEXT stageFeedback = {};
+  const VkPipelineCreationFeedbackCreateInfoEXT feedbackInfo = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO_EXT,
+      .pPipelineCreationFeedback = outFeedback,
+      .pipelineStageCreationFeedbackCount = 1,
+      .pPipelineStageCreationFeedbacks = &stageFeedback,
+  };
+  const VkResult result = ivkCreateComputePipeline(&vf,
+                                                   device,
+                                                   pipelineCache,
+                                                   &shaderStage_,
+                                                   pipelineLayout,
+                                                   outFeedback ? &feedbackInfo : nullptr,
+                                                   outPipeline);
 
   if (!IGL_DEBUG_VERIFY(result == VK_SUCCESS)) {
     return result;
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanHelpers.h>
@@ -45,7 +46,8 @@ class VulkanPipelineBuilder final {
                                VkPipelineLayout pipelineLayout,
                                VkRenderPass renderPass,
                                VkPipeline* outPipeline,
-                               const char* debugName = nullptr) noexcept;
+                               const char* debugName = nullptr,
+                               VkPipelineCreationFeedbackEXT* outFeedback = nullptr) noexcept;
 
   static uint32_t getNumPipelinesCreated() {
     return numPipelinesCreated;
@@ -60,7 +62,7 @@ class VulkanPipelineBuilder final {
   VkPipelineMultisampleStateCreateInfo multisampleState_;
   VkPipelineDepthStencilStateCreateInfo depthStencilState_;
   std::vector<VkPipelineColorBlendAttachmentState> colorBlendAttachmentStates_;
-  static uint32_t numPipelinesCreated;
+  static std::atomic<uint32_t> numPipelinesCreated;
 };
 
 class VulkanComputePipelineBuilder final {
@@ -75,7 +77,8 @@ class VulkanComputePipelineBuilder final {
                  VkPipelineCache pipelineCache,
                  VkPipelineLayout pipelineLayout,
                  VkPipeline* outPipeline,
-                 const char* debugName = nullptr) noexcept;
+                 const char* debugName = nullptr,
+                 VkPipelineCreationFeedbackEXT* outFeedback = nullptr) noexcept;
 
   static uint32_t getNumPipelinesCreated() {
     return numPipelinesCreated;
@@ -83,7 +86,7 @@ class VulkanComputePipelineBuilder final {
 
  private:
   VkPipelineShaderStageCreateInfo shaderStage_;
-  static uint32_t numPipelinesCreated;
+  static std::atomic<uint32_t> numPipelinesCreated;
 };
 
 } // namespace igl::vulkan
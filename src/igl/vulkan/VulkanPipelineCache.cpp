@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanPipelineCache.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+// 'IGLP'
+constexpr uint32_t kFileMagic = 0x504c4749u;
+// bump this whenever the layout of the file changes
+constexpr uint32_t kFileFormatVersion = 1u;
+
+struct PipelineCacheFileHeader {
+  uint32_t magic = kFileMagic;
+  uint32_t formatVersion = kFileFormatVersion;
+  uint32_t driverVersion = 0;
+  uint32_t reserved = 0;
+  uint64_t dataSize = 0;
+};
+
+static_assert(sizeof(PipelineCacheFileHeader) == 24);
+
+} // namespace
+
+namespace igl::vulkan {
+
+VulkanPipelineCache::VulkanPipelineCache(const VulkanFunctionTable& vf,
+                                         VkDevice device,
+                                         const VkPhysicalDeviceProperties& properties,
+                                         const char* IGL_NULLABLE filePath,
+                                         const void* IGL_NULLABLE initialData,
+                                         size_t initialDataSize) :
+  vf_(vf), device_(device), properties_(properties), filePath_(filePath ? filePath : "") {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+  const std::vector<uint8_t> fileData = loadFile();
+  numBytesLoadedFromFile_ = fileData.size();
+
+  const bool hasInitialData = initialData && initialDataSize &&
+                              isCompatible(initialData, initialDataSize, properties_);
+  if (initialData && initialDataSize && !hasInitialData) {
+    IGL_LOG_INFO("Ignoring pipeline cache data created for a different device or driver\n");
+  }
+
+  // seed the cache with the file contents and merge the application-provided blob into it
+  const bool useFileData = !fileData.empty();
+  const VkPipelineCacheCreateInfo ci = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      .flags = VkPipelineCacheCreateFlags(0),
+      .initialDataSize = useFileData ? fileData.size() : (hasInitialData ? initialDataSize : 0),
+      .pInitialData = useFileData ? fileData.data() : (hasInitialData ? initialData : nullptr),
+  };
+  VK_ASSERT(vf_.vkCreatePipelineCache(device_, &ci, nullptr, &vkPipelineCache_));
+
+  if (useFileData && hasInitialData) {
+    merge(initialData, initialDataSize);
+  }
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+  vf_.vkDestroyPipelineCache(device_, vkPipelineCache_, nullptr);
+}
+
+std::vector<uint8_t> VulkanPipelineCache::getData() const {
+  size_t size = 0;
+  vf_.vkGetPipelineCacheData(device_, vkPipelineCache_, &size, nullptr);
+
+  std::vector<uint8_t> data(size);
+
+  if (size) {
+    vf_.vkGetPipelineCacheData(device_, vkPipelineCache_, &size, data.data());
+    data.resize(size);
+  }
+
+  return data;
+}
+
+Result VulkanPipelineCache::save() const {
+  IGL_PROFILER_FUNCTION();
+
+  if (filePath_.empty()) {
+    return Result(Result::Code::InvalidOperation, "No pipeline cache file path was provided");
+  }
+
+  // pick up pipelines compiled by other runs since this cache was loaded
+  {
+    const std::vector<uint8_t> fileData = loadFile();
+    if (!fileData.empty()) {
+      merge(fileData.data(), fileData.size());
+    }
+  }
+
+  const std::vector<uint8_t> data = getData();
+  if (data.empty()) {
+    return Result(Result::Code::RuntimeError, "vkGetPipelineCacheData() returned no data");
+  }
+
+  PipelineCacheFileHeader header;
+  header.driverVersion = properties_.driverVersion;
+  header.dataSize = data.size();
+
+  const std::string tmpPath = filePath_ + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return Result(Result::Code::RuntimeError, "Cannot open " + tmpPath);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(data.data()),
+               static_cast<std::streamsize>(data.size()));
+    file.close();
+    if (!file) {
+      std::error_code ec;
+      std::filesystem::remove(tmpPath, ec);
+      return Result(Result::Code::RuntimeError, "Cannot write " + tmpPath);
+    }
+  }
+
+  // rename() replaces the destination atomically
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, filePath_, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+    return Result(Result::Code::RuntimeError, "Cannot replace " + filePath_);
+  }
+
+  return Result();
+}
+
+void VulkanPipelineCache::recordCreationFeedback(
+    VkPipelineCreationFeedbackFlagsEXT feedback) noexcept {
+  if ((feedback & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT_EXT) == 0) {
+    return;
+  }
+  if (feedback & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT_EXT) {
+    numHits_++;
+  } else {
+    numMisses_++;
+  }
+}
+
+VulkanPipelineCache::Stats VulkanPipelineCache::getStats() const noexcept {
+  return {
+      .numHits = numHits_,
+      .numMisses = numMisses_,
+      .numBytesLoadedFromFile = numBytesLoadedFromFile_,
+  };
+}
+
+bool VulkanPipelineCache::isCompatible(const void* IGL_NULLABLE data,
+                                       size_t size,
+                                       const VkPhysicalDeviceProperties& properties) noexcept {
+  if (!data || size < sizeof(VkPipelineCacheHeaderVersionOne)) {
+    return false;
+  }
+
+  // the blob may not be aligned
+  VkPipelineCacheHeaderVersionOne header = {};
+  memcpy(&header, data, sizeof(header));
+
+  return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) &&
+         header.headerSize <= size &&
+         header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+         header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+         memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+std::vector<uint8_t> VulkanPipelineCache::loadFile() const {
+  if (filePath_.empty()) {
+    return {};
+  }
+
+  std::ifstream file(filePath_, std::ios::in | std::ios::binary);
+  if (!file) {
+    return {};
+  }
+
+  PipelineCacheFileHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    IGL_LOG_INFO("Ignoring truncated pipeline cache file %s\n", filePath_.c_str());
+    return {};
+  }
+
+  if (header.magic != kFileMagic || header.formatVersion != kFileFormatVersion ||
+      header.driverVersion != properties_.driverVersion) {
+    IGL_LOG_INFO("Ignoring outdated pipeline cache file %s\n", filePath_.c_str());
+    return {};
+  }
+
+  std::error_code ec;
+  const uintmax_t fileSize = std::filesystem::file_size(filePath_, ec);
+  if (ec || fileSize != sizeof(header) + header.dataSize) {
+    IGL_LOG_INFO("Ignoring truncated pipeline cache file %s\n", filePath_.c_str());
+    return {};
+  }
+
+  std::vector<uint8_t> data(header.dataSize);
+  if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+    IGL_LOG_INFO("Ignoring truncated pipeline cache file %s\n", filePath_.c_str());
+    return {};
+  }
+
+  if (!isCompatible(data.data(), data.size(), properties_)) {
+    IGL_LOG_INFO("Ignoring pipeline cache file %s created for a different device\n",
+                 filePath_.c_str());
+    return {};
+  }
+
+  return data;
+}
+
+void VulkanPipelineCache::merge(const void* data, size_t size) const {
+  const VkPipelineCacheCreateInfo ci = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      .flags = VkPipelineCacheCreateFlags(0),
+      .initialDataSize = size,
+      .pInitialData = data,
+  };
+  VkPipelineCache srcCache = VK_NULL_HANDLE;
+  if (vf_.vkCreatePipelineCache(device_, &ci, nullptr, &srcCache) != VK_SUCCESS) {
+    return;
+  }
+  VK_ASSERT(vf_.vkMergePipelineCaches(device_, vkPipelineCache_, 1, &srcCache));
+  vf_.vkDestroyPipelineCache(device_, srcCache, nullptr);
+}
+
+} // namespace igl::vulkan
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <igl/vulkan/Common.h>
+
+namespace igl::vulkan {
+
+/**
+ * @brief Owns the VkPipelineCache used by a VulkanContext and, optionally, persists it on disk.
+ *
+ * The cache is seeded from a file (VulkanContextConfig::pipelineCacheFilePath) and from an
+ * application-provided blob (VulkanContextConfig::pipelineCacheData). Both sources are validated
+ * against the current physical device: blobs produced by a different vendor, device, driver or
+ * pipeline cache UUID are discarded. When both are valid they are merged into one cache.
+ *
+ * The file starts with a small IGL header (magic, format version, driver version and payload size)
+ * followed by the blob returned by vkGetPipelineCacheData(). `save()` merges whatever another run
+ * wrote to the file in the meantime, writes a temporary file and renames it over the old one, so a
+ * crash never leaves a truncated cache behind.
+ *
+ * If VK_EXT_pipeline_creation_feedback is available, pipeline builders report whether each
+ * pipeline was found in the cache, which is exposed through `getStats()`.
+ */
+class VulkanPipelineCache final {
+ public:
+  struct Stats {
+    /// @brief Pipelines created without invoking the compiler, thanks to the cache
+    uint32_t numHits = 0;
+    /// @brief Pipelines that had to be compiled
+    uint32_t numMisses = 0;
+    /// @brief Size of the cache data loaded from the file at creation, 0 if nothing was loaded
+    size_t numBytesLoadedFromFile = 0;
+  };
+
+  VulkanPipelineCache(const VulkanFunctionTable& vf,
+                      VkDevice device,
+                      const VkPhysicalDeviceProperties& properties,
+                      const char* IGL_NULLABLE filePath,
+                      const void* IGL_NULLABLE initialData,
+                      size_t initialDataSize);
+  ~VulkanPipelineCache();
+
+  VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+  VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+
+  [[nodiscard]] VkPipelineCache getVkPipelineCache() const noexcept {
+    return vkPipelineCache_;
+  }
+
+  /// @brief Returns true if the cache is backed by a file
+  [[nodiscard]] bool hasFilePath() const noexcept {
+    return !filePath_.empty();
+  }
+
+  /// @brief Returns the serialized content of the cache, as returned by vkGetPipelineCacheData()
+  [[nodiscard]] std::vector<uint8_t> getData() const;
+
+  /// @brief Merges the cache file written by other runs into this cache and atomically writes the
+  /// result back to the file. Returns an error if no file path was provided or writing failed.
+  /// Must not be called while pipelines are being created on other threads
+  Result save() const;
+
+  /// @brief Records the result of a pipeline creation. `feedback` is the
+  /// VkPipelineCreationFeedbackEXT::flags value filled in by the driver
+  void recordCreationFeedback(VkPipelineCreationFeedbackFlagsEXT feedback) noexcept;
+
+  [[nodiscard]] Stats getStats() const noexcept;
+
+  /// @brief Returns true if `data` is a pipeline cache blob that can be used with a device that has
+  /// the given properties
+  [[nodiscard]] static bool isCompatible(const void* IGL_NULLABLE data,
+                                         size_t size,
+                                         const VkPhysicalDeviceProperties& properties) noexcept;
+
+ private:
+  /// @brief Reads the cache file and returns its payload, or an empty vector if the file does not
+  /// exist or is not compatible with this device
+  [[nodiscard]] std::vector<uint8_t> loadFile() const;
+
+  /// @brief Merges a serialized pipeline cache into `vkPipelineCache_`
+  void merge(const void* data, size_t size) const;
+
+ private:
+  const VulkanFunctionTable& vf_;
+  VkDevice device_ = VK_NULL_HANDLE;
+  const VkPhysicalDeviceProperties properties_;
+  const std::string filePath_;
+  VkPipelineCache vkPipelineCache_ = VK_NULL_HANDLE;
+
+  std::atomic<uint32_t> numHits_ = 0;
+  std::atomic<uint32_t> numMisses_ = 0;
+  size_t numBytesLoadedFromFile_ = 0;
+};
+
+} // namespace igl::vulkan
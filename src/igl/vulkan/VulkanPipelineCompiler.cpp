@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanPipelineCompiler.h>
+
+#include <algorithm>
+
+namespace {
+
+// pipeline compilation is CPU-heavy; leave enough cores for the application
+constexpr uint32_t kMaxDefaultNumThreads = 4;
+
+uint32_t getDefaultNumThreads() {
+  const uint32_t numHardwareThreads = std::thread::hardware_concurrency();
+  return std::clamp(numHardwareThreads / 2u, 1u, kMaxDefaultNumThreads);
+}
+
+} // namespace
+
+namespace igl::vulkan {
+
+VulkanPipelineCompiler::VulkanPipelineCompiler(uint32_t numThreads) :
+  numThreads_(numThreads ? numThreads : getDefaultNumThreads()) {}
+
+VulkanPipelineCompiler::~VulkanPipelineCompiler() {
+  IGL_PROFILER_FUNCTION();
+
+  {
+    const std::lock_guard<std::mutex> guard(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+
+  for (auto& t : threads_) {
+    t.join();
+  }
+}
+
+void VulkanPipelineCompiler::enqueue(std::function<void()>&& task) {
+  {
+    const std::lock_guard<std::mutex> guard(mutex_);
+
+    IGL_DEBUG_ASSERT(!stop_);
+
+    tasks_.emplace_back(std::move(task));
+
+    if (threads_.size() < numThreads_ && threads_.size() < tasks_.size()) {
+      threads_.emplace_back([this]() { workerLoop(); });
+    }
+  }
+  condition_.notify_one();
+}
+
+void VulkanPipelineCompiler::workerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      // drain the queue before exiting: the owners of the tasks are waiting for them to complete
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+void VulkanPipelineCompiler::recordAsyncCompile() noexcept {
+  numAsyncCompiles_++;
+}
+
+void VulkanPipelineCompiler::recordStall(uint64_t nanoseconds, bool isSyncCompile) noexcept {
+  numStalls_++;
+  if (isSyncCompile) {
+    numSyncCompiles_++;
+  }
+  totalStallNanoseconds_ += nanoseconds;
+
+  uint64_t prevMax = maxStallNanoseconds_.load(std::memory_order_relaxed);
+  while (prevMax < nanoseconds &&
+         !maxStallNanoseconds_.compare_exchange_weak(prevMax, nanoseconds)) {
+  }
+}
+
+void VulkanPipelineCompiler::recordSkippedDraw() noexcept {
+  numSkippedDraws_++;
+}
+
+VulkanPipelineCompiler::Stats VulkanPipelineCompiler::getStats() const noexcept {
+  return {
+      .numAsyncCompiles = numAsyncCompiles_,
+      .numSyncCompiles = numSyncCompiles_,
+      .numStalls = numStalls_,
+      .numSkippedDraws = numSkippedDraws_,
+      .totalStallNanoseconds = totalStallNanoseconds_,
+      .maxStallNanoseconds = maxStallNanoseconds_,
+  };
+}
+
+void VulkanPipelineCompiler::resetStats() noexcept {
+  numAsyncCompiles_ = 0;
+  numSyncCompiles_ = 0;
+  numStalls_ = 0;
+  numSkippedDraws_ = 0;
+  totalStallNanoseconds_ = 0;
+  maxStallNanoseconds_ = 0;
+}
+
+} // namespace igl::vulkan
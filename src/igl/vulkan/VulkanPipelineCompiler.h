@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <igl/vulkan/Common.h>
+
+namespace igl::vulkan {
+
+/**
+ * @brief A pool of worker threads used to build Vulkan pipelines in the background, away from the
+ * render thread. The threads are started lazily when the first task is enqueued, so contexts which
+ * never precompile pipelines do not pay for them.
+ *
+ * The class also collects statistics about how pipelines were created, in particular how often the
+ * render thread had to stall because a pipeline it needed was not ready yet.
+ */
+class VulkanPipelineCompiler final {
+ public:
+  struct Stats {
+    /// @brief Pipelines built on the worker threads
+    uint32_t numAsyncCompiles = 0;
+    /// @brief Pipelines built synchronously on the thread that needed them
+    uint32_t numSyncCompiles = 0;
+    /// @brief Number of times a thread was blocked by a pipeline compilation: every synchronous
+    /// compile plus every wait for a pipeline which was still being built in the background
+    uint32_t numStalls = 0;
+    /// @brief Draws skipped because their pipeline was still being built in the background
+    uint32_t numSkippedDraws = 0;
+    uint64_t totalStallNanoseconds = 0;
+    uint64_t maxStallNanoseconds = 0;
+  };
+
+  /// @brief `numThreads` == 0 selects a default based on the number of hardware threads
+  explicit VulkanPipelineCompiler(uint32_t numThreads);
+  /// @brief Runs all remaining tasks and joins the worker threads
+  ~VulkanPipelineCompiler();
+
+  VulkanPipelineCompiler(const VulkanPipelineCompiler&) = delete;
+  VulkanPipelineCompiler& operator=(const VulkanPipelineCompiler&) = delete;
+
+  /// @brief Schedules `task` to be executed on one of the worker threads
+  void enqueue(std::function<void()>&& task);
+
+  [[nodiscard]] uint32_t getNumThreads() const noexcept {
+    return numThreads_;
+  }
+
+  void recordAsyncCompile() noexcept;
+  /// @brief Records a stall of the calling thread. `isSyncCompile` is true if the thread built the
+  /// pipeline itself, false if it waited for a worker thread to finish it
+  void recordStall(uint64_t nanoseconds, bool isSyncCompile) noexcept;
+  void recordSkippedDraw() noexcept;
+
+  [[nodiscard]] Stats getStats() const noexcept;
+  void resetStats() noexcept;
+
+ private:
+  void workerLoop();
+
+ private:
+  const uint32_t numThreads_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::function<void()>> tasks_;
+  std::vector<std::thread> threads_;
+  bool stop_ = false;
+
+  std::atomic<uint32_t> numAsyncCompiles_ = 0;
+  std::atomic<uint32_t> numSyncCompiles_ = 0;
+  std::atomic<uint32_t> numStalls_ = 0;
+  std::atomic<uint32_t> numSkippedDraws_ = 0;
+  std::atomic<uint64_t> totalStallNanoseconds_ = 0;
+  std::atomic<uint64_t> maxStallNanoseconds_ = 0;
+};
+
+} // namespace igl::vulkan
@@ -7,6 +7,9 @@
 
 #include <igl/vulkan/VulkanStagingDevice.h>
 
+#include <algorithm>
+#include <chrono>
+
 #include <igl/IGLSafeC.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanBuffer.h>
@@ -20,16 +23,77 @@
 using VulkanSubmitHandle = igl::vulkan::VulkanImmediateCommands::SubmitHandle;
 
 constexpr VkDeviceSize kMinStagingBufferSize = static_cast<const VkDeviceSize>(1024u) * 1024u;
+constexpr VkDeviceSize kDefaultMaxStagingBufferSize = 256u * kMinStagingBufferSize;
+// Images larger than this are uploaded in several submissions
+constexpr VkDeviceSize kMaxImageChunkSize = 16u * kMinStagingBufferSize;
+// Released readback buffers beyond this are destroyed once their copy has finished
+constexpr size_t kMaxReadbackBuffers = 8;
 
 namespace igl::vulkan {
 
+namespace {
+
+uint64_t getNanoseconds() {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+struct ImageUploadTarget {
+  VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+  VkAccessFlags accessMask = 0;
+};
+
+/// @brief Returns the layout an image should be transitioned to after an upload, based on its usage
+ImageUploadTarget getImageUploadTarget(const VulkanImage& image) {
+  const bool isSampled = (image.getVkImageUsageFlags() & VK_IMAGE_USAGE_SAMPLED_BIT) != 0;
+  const bool isStorage = (image.getVkImageUsageFlags() & VK_IMAGE_USAGE_STORAGE_BIT) != 0;
+  const bool isColorAttachment =
+      (image.getVkImageUsageFlags() & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) != 0;
+  const bool isDepthStencilAttachment =
+      (image.getVkImageUsageFlags() & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0;
+
+  // a ternary cascade...
+  const VkImageLayout targetLayout =
+      isSampled ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+                : (isStorage ? VK_IMAGE_LAYOUT_GENERAL
+                             : (isColorAttachment
+                                    ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+                                    : (isDepthStencilAttachment
+                                           ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+                                           : VK_IMAGE_LAYOUT_UNDEFINED)));
+
+  IGL_DEBUG_ASSERT(targetLayout != VK_IMAGE_LAYOUT_UNDEFINED, "Missing usage flags");
+
+  const VkAccessFlags dstAccessMask =
+      isSampled
+          ? VK_ACCESS_SHADER_READ_BIT
+          : (isStorage ? VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+                       : (isColorAttachment ? VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+                                            : (isDepthStencilAttachment
+                                                   ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
+                                                   : 0)));
+
+  return {targetLayout, dstAccessMask};
+}
+
+} // namespace
+
 VulkanStagingDevice::VulkanStagingDevice(VulkanContext& ctx) : ctx_(ctx) {
   IGL_PROFILER_FUNCTION();
 
   const auto& limits = ctx_.getVkPhysicalDeviceProperties().limits;
 
   // Use value of 256MB (limited by some architectures), and clamp it to the max limits
-  maxStagingBufferSize_ = std::min(limits.maxStorageBufferRange, 256u * 1024u * 1024u);
+  const VkDeviceSize maxSize = ctx_.config_.maxStagingBufferSize
+                                   ? static_cast<VkDeviceSize>(ctx_.config_.maxStagingBufferSize)
+                                   : kDefaultMaxStagingBufferSize;
+  maxStagingBufferSize_ =
+      std::min(static_cast<VkDeviceSize>(limits.maxStorageBufferRange), maxSize);
+  maxDedicatedStagingBufferSize_ =
+      ctx_.config_.maxDedicatedStagingBufferSize
+          ? static_cast<VkDeviceSize>(ctx_.config_.maxDedicatedStagingBufferSize)
+          : maxStagingBufferSize_;
 
   immediate_ = std::make_unique<VulkanImmediateCommands>(
       ctx_.vf_,
@@ -39,16 +103,28 @@ VulkanStagingDevice::VulkanStagingDevice(VulkanContext& ctx) : ctx_(ctx) {
       ctx_.features_.has_VK_KHR_timeline_semaphore && ctx_.features_.has_VK_KHR_synchronization2,
       "VulkanStagingDevice::immediate_");
   IGL_DEBUG_ASSERT(immediate_.get());
+
+  // readback buffers are read by the CPU, which is much faster from cached memory
+  VkPhysicalDeviceMemoryProperties memProperties = {};
+  ctx_.vf_.vkGetPhysicalDeviceMemoryProperties(ctx_.getVkPhysicalDevice(), &memProperties);
+  constexpr VkMemoryPropertyFlags kCachedFlags =
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT;
+  for (uint32_t i = 0; i != memProperties.memoryTypeCount; i++) {
+    if ((memProperties.memoryTypes[i].propertyFlags & kCachedFlags) == kCachedFlags) {
+      readbackMemoryFlags_ = kCachedFlags;
+      break;
+    }
+  }
 }
 
-void VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
-                                        size_t dstOffset,
-                                        size_t size,
-                                        const void* data) {
+VulkanSubmitHandle VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
+                                                      size_t dstOffset,
+                                                      size_t size,
+                                                      const void* data) {
   IGL_PROFILER_FUNCTION();
   if (buffer.isMapped()) {
     buffer.bufferSubData(dstOffset, size, data);
-    return;
+    return {};
   }
 
   uint32_t chunkDstOffset = dstOffset;
@@ -58,9 +134,14 @@ void VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
   IGL_LOG_INFO("Upload requested for data with %u bytes\n", size);
 #endif
 
+  VulkanSubmitHandle handle;
+  const bool isLargeUpload = size > getMaxImageChunkSize();
+
   while (size) {
+    const uint64_t startTime = getNanoseconds();
+
     // finds a free memory block to store the data in the staging buffer
-    MemoryRegion memoryChunk = nextFreeBlock(size, false);
+    MemoryRegion memoryChunk = nextFreeBlock(size, false, isLargeUpload);
     const VkDeviceSize copySize = std::min(static_cast<VkDeviceSize>(size), memoryChunk.size);
 
 #if IGL_VULKAN_DEBUG_STAGING_DEVICE
@@ -69,25 +150,56 @@ void VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
 
     auto& stagingBuffer = stagingBuffers_[memoryChunk.stagingBufferIndex];
 
+    const auto& wrapper = immediate_->acquire();
+    recordStall(startTime);
+
     // copy data into the staging buffer
     stagingBuffer->bufferSubData(memoryChunk.offset, copySize, copyData);
 
     // do the transfer
     const VkBufferCopy copy = {memoryChunk.offset, chunkDstOffset, copySize};
 
-    const auto& wrapper = immediate_->acquire();
     ctx_.vf_.vkCmdCopyBuffer(
         wrapper.cmdBuf_, stagingBuffer->getVkBuffer(), buffer.getVkBuffer(), 1, &copy);
     memoryChunk.handle = immediate_->submit(wrapper); // store the submit handle with the allocation
     regions_.push_back(memoryChunk);
+    handle = memoryChunk.handle;
+
+    uploadStats_.numBytesUploaded += copySize;
+    uploadStats_.numSubmits++;
 
     size -= copySize;
     copyData = (uint8_t*)copyData + copySize;
     chunkDstOffset += copySize;
   }
+
+  return handle;
+}
+
+bool VulkanStagingDevice::isUploadComplete(VulkanSubmitHandle handle) const {
+  return immediate_->isReady(handle);
+}
+
+void VulkanStagingDevice::waitForUpload(VulkanSubmitHandle handle) {
+  IGL_PROFILER_FUNCTION();
+  immediate_->wait(handle, ctx_.config_.fenceTimeoutNanoseconds);
+}
+
+VkDeviceSize VulkanStagingDevice::getMaxImageChunkSize() const {
+  return std::min(kMaxImageChunkSize, maxStagingBufferSize_);
+}
+
+void VulkanStagingDevice::recordStall(uint64_t startNanoseconds) {
+  const uint64_t stall = getNanoseconds() - startNanoseconds;
+  uploadStats_.totalStallNanoseconds += stall;
+  uploadStats_.maxStallNanoseconds = std::max(uploadStats_.maxStallNanoseconds, stall);
 }
 
 void VulkanStagingDevice::mergeRegionsAndFreeBuffers() {
+  mergeRegions(true);
+}
+
+void VulkanStagingDevice::mergeRegions(bool freeBuffers) {
   uint32_t regionIndex = 0;
   while (regionIndex < regions_.size() && immediate_->isReady(regions_[regionIndex].handle)) {
     auto& currRegion = regions_[regionIndex];
@@ -129,10 +241,11 @@ void VulkanStagingDevice::mergeRegionsAndFreeBuffers() {
     }
 
     // if a staging buffer is completely recovered
-    if (currRegion.size == currRegion.alignedSize) {
+    if (freeBuffers && currRegion.size == currRegion.alignedSize) {
       freeStagingBufferSize_ -= currRegion.size;
       // free the staging buffer
       stagingBuffers_[currRegion.stagingBufferIndex].reset();
+      forgetDedicatedBuffer(currRegion.stagingBufferIndex);
       // remove the region
       regions_.erase(regions_.begin() + regionIndex);
 
@@ -155,7 +268,8 @@ void VulkanStagingDevice::mergeRegionsAndFreeBuffers() {
 }
 
 VulkanStagingDevice::MemoryRegion VulkanStagingDevice::nextFreeBlock(VkDeviceSize size,
-                                                                     bool contiguous) {
+                                                                     bool contiguous,
+                                                                     bool dedicated) {
   IGL_PROFILER_FUNCTION();
 
   const VkDeviceSize requestedAlignedSize = getAlignedSize(size);
@@ -170,67 +284,92 @@ VulkanStagingDevice::MemoryRegion VulkanStagingDevice::nextFreeBlock(VkDeviceSiz
   IGL_LOG_INFO("nextFreeBlock() with %u bytes, aligned %u bytes\n", size, requestedAlignedSize);
 #endif
 
-  VkDeviceSize allocatedSize = 0;
-  // at this point, there should be a free region that can fit the requested size
-  auto regionItr = regions_.begin();
-  while (regionItr != regions_.end()) {
+  const auto findFreeRegion = [this, requestedAlignedSize, contiguous]() {
     // if requested size is available or if contiguous memory is not requested
-    if ((regionItr->size >= requestedAlignedSize || !contiguous) &&
-        (immediate_->isReady(regionItr->handle))) {
-      allocatedSize = std::min(regionItr->size, requestedAlignedSize);
-      break;
-    }
-    regionItr++;
-  }
-
-  IGL_DEBUG_ASSERT(allocatedSize);
-
-  if (allocatedSize) {
-    const uint32_t newSize = regionItr->size - allocatedSize;
-    const uint32_t newOffset = regionItr->offset + allocatedSize;
-    const uint32_t stagingBufferIndex = regionItr->stagingBufferIndex;
+    return std::find_if(regions_.begin(), regions_.end(), [&](const MemoryRegion& region) {
+      return (region.size >= requestedAlignedSize || !contiguous) &&
+             immediate_->isReady(region.handle);
+    });
+  };
 
-    const MemoryRegion allocatedRegion = {regionItr->offset,
-                                          allocatedSize,
-                                          regionItr->alignedSize,
-                                          VulkanImmediateCommands::SubmitHandle(),
-                                          stagingBufferIndex};
-
-    // Return this region and add the remaining unused size to the regions_ deque
-    IGL_SCOPE_EXIT {
-      if (newSize > 0) {
-        *regionItr = {newOffset,
-                      newSize,
-                      regionItr->alignedSize,
-                      VulkanImmediateCommands::SubmitHandle(),
-                      stagingBufferIndex};
-      } else {
-        regions_.erase(regionItr);
+  auto regionItr = findFreeRegion();
+
+  if (regionItr == regions_.end() && dedicated) {
+    // Large uploads get a staging buffer of their own instead of waiting for the GPU. It is freed
+    // by mergeRegionsAndFreeBuffers() once the upload has finished. Past the limit, the oldest of
+    // these buffers is waited for, and reused if it fits the request or freed otherwise
+    const VkDeviceSize bufferSize = nextSize(requestedAlignedSize);
+    while (regionItr == regions_.end() && !dedicatedBuffers_.empty() &&
+           dedicatedStagingBufferSize_ + bufferSize > maxDedicatedStagingBufferSize_) {
+      if (!waitForOldestDedicatedBuffer()) {
+        break;
       }
-    };
-
-    freeStagingBufferSize_ -= allocatedSize;
-    return allocatedRegion;
+      regionItr = findFreeRegion();
+      if (regionItr == regions_.end()) {
+        freeStagingBuffer(dedicatedBuffers_.front().stagingBufferIndex);
+      }
+    }
+    if (regionItr == regions_.end()) {
+      allocateStagingBuffer(bufferSize);
+      dedicatedBuffers_.push_back({static_cast<uint32_t>(stagingBuffers_.size()) - 1, bufferSize});
+      dedicatedStagingBufferSize_ += bufferSize;
+      regionItr = regions_.begin();
+    }
   }
 
+  // Wait for the oldest busy regions, one at a time, until one of them can fit the requested size.
+  // Older regions are at the front of the deque
+  while (regionItr == regions_.end()) {
+    const auto busyItr =
+        std::find_if(regions_.begin(), regions_.end(), [this](const MemoryRegion& region) {
+          return !immediate_->isReady(region.handle);
+        });
+    if (busyItr == regions_.end()) {
+      break;
+    }
 #if IGL_VULKAN_DEBUG_STAGING_DEVICE
-  IGL_LOG_INFO(
-      "Could not find an available block. Waiting for the staging device to become fully "
-      "available\n");
+    IGL_LOG_INFO("Could not find an available block. Waiting for the oldest busy block\n");
 #endif
+    if (immediate_->wait(busyItr->handle, ctx_.config_.fenceTimeoutNanoseconds) != VK_SUCCESS) {
+      break;
+    }
+    // adjacent free blocks may fit the requested size together
+    mergeRegions(false);
+    regionItr = findFreeRegion();
+  }
 
-  // Nothing was available. Let's wait for the entire staging buffer to become free
-  waitAndReset();
+  if (regionItr == regions_.end()) {
+    // all blocks are free, but none of them is large enough
+    allocateStagingBuffer(nextSize(requestedAlignedSize));
+    regionItr = regions_.begin();
+  }
 
-  // try to allocate a new staging buffer
-  allocateStagingBuffer(nextSize(requestedAlignedSize));
-  IGL_DEBUG_ASSERT(!regions_.empty());
+  const VkDeviceSize allocatedSize = std::min(regionItr->size, requestedAlignedSize);
+  IGL_DEBUG_ASSERT(allocatedSize);
 
-  if (!regions_.empty()) { // if a valid region is available, return it
-    freeStagingBufferSize_ -= requestedAlignedSize;
-    return regions_.front();
+  const uint32_t newSize = regionItr->size - allocatedSize;
+  const uint32_t newOffset = regionItr->offset + allocatedSize;
+  const uint32_t stagingBufferIndex = regionItr->stagingBufferIndex;
+
+  const MemoryRegion allocatedRegion = {regionItr->offset,
+                                        allocatedSize,
+                                        regionItr->alignedSize,
+                                        VulkanImmediateCommands::SubmitHandle(),
+                                        stagingBufferIndex};
+
+  // Return this region and add the remaining unused size to the regions_ deque
+  if (newSize > 0) {
+    *regionItr = {newOffset,
+                  newSize,
+                  regionItr->alignedSize,
+                  VulkanImmediateCommands::SubmitHandle(),
+                  stagingBufferIndex};
+  } else {
+    regions_.erase(regionItr);
   }
-  return {};
+
+  freeStagingBufferSize_ -= allocatedSize;
+  return allocatedRegion;
 }
 
 void VulkanStagingDevice::getBufferSubData(const VulkanBuffer& buffer,
@@ -276,31 +415,37 @@ void VulkanStagingDevice::getBufferSubData(const VulkanBuffer& buffer,
     dstData = (uint8_t*)dstData + copySize;
     chunkSrcOffset += copySize;
 
+    // the copy has finished, so the block is free again
     regions_.push_back(memoryChunk);
+    freeStagingBufferSize_ += memoryChunk.size;
   }
 }
 
-void VulkanStagingDevice::imageData(const VulkanImage& image,
-                                    TextureType type,
-                                    const TextureRangeDesc& range,
-                                    const TextureFormatProperties& properties,
-                                    uint32_t bytesPerRow,
-                                    VkImageAspectFlags aspectFlags,
-                                    const void* data) {
+VulkanSubmitHandle VulkanStagingDevice::imageData(const VulkanImage& image,
+                                                  TextureType type,
+                                                  const TextureRangeDesc& range,
+                                                  const TextureFormatProperties& properties,
+                                                  uint32_t bytesPerRow,
+                                                  VkImageAspectFlags aspectFlags,
+                                                  const void* data) {
   IGL_PROFILER_FUNCTION();
 
   const bool is420 = (image.imageFormat_ == VK_FORMAT_G8_B8R8_2PLANE_420_UNORM) ||
                      (image.imageFormat_ == VK_FORMAT_G8_B8_R8_3PLANE_420_UNORM);
 
   // @fb-only
-  const uint32_t storageSize =
-      is420 ? image.extent_.width * image.extent_.height * 3u / 2u
-            : static_cast<uint32_t>(properties.getBytesPerRange(range, bytesPerRow));
+  const VkDeviceSize storageSize =
+      is420 ? static_cast<VkDeviceSize>(image.extent_.width) * image.extent_.height * 3u / 2u
+            : static_cast<VkDeviceSize>(properties.getBytesPerRange(range, bytesPerRow));
 
   IGL_DEBUG_ASSERT(storageSize);
 
-  // We don't support uploading image data in small chunks. If the total upload size exceeds the
-  // the maximum allowed staging buffer size, we can't upload it
+  // Large images are split into several smaller transfers, so they do not require a huge
+  // contiguous staging block. Multiplanar images are always uploaded in one go
+  if (!is420 && storageSize > getMaxImageChunkSize()) {
+    return imageDataChunked(image, type, range, properties, bytesPerRow, aspectFlags, data);
+  }
+
   IGL_DEBUG_ASSERT(storageSize <= maxStagingBufferSize_,
                    "Image size exceeds maximum size of staging buffer");
 
@@ -308,16 +453,22 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
   IGL_LOG_INFO("Image upload requested for data with %u bytes\n", storageSize);
 #endif
 
+  const uint64_t startTime = getNanoseconds();
+
   // get next staging buffer free offset
   MemoryRegion memoryChunk = nextFreeBlock(storageSize, true);
 
   IGL_DEBUG_ASSERT(memoryChunk.size >= storageSize);
   auto& stagingBuffer = stagingBuffers_[memoryChunk.stagingBufferIndex];
 
+  const auto& wrapper = immediate_->acquire();
+  recordStall(startTime);
+
   // 1. Copy the pixel data into the host visible staging buffer
   stagingBuffer->bufferSubData(memoryChunk.offset, storageSize, data);
 
-  const auto& wrapper = immediate_->acquire();
+  uploadStats_.numBytesUploaded += storageSize;
+  uploadStats_.numSubmits++;
   const uint32_t initialLayer = getVkLayer(type, range.face, range.layer);
   const uint32_t numLayers = getVkLayer(type, range.numFaces, range.numLayers);
 
@@ -371,7 +522,7 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
 
     } else {
       IGL_DEBUG_ABORT("Unimplemented multiplanar image format");
-      return;
+      return {};
     }
 
     const VkImageSubresourceRange subresourceRange = {
@@ -421,7 +572,7 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
     memoryChunk.handle = immediate_->submit(wrapper);
     regions_.push_back(memoryChunk);
 
-    return;
+    return memoryChunk.handle;
 
     // end of VK_FORMAT_G8_B8R8_2PLANE_420_UNORM code path
   }
@@ -500,53 +651,181 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
                                   static_cast<uint32_t>(copyRegions.size()),
                                   copyRegions.data());
 
-  const bool isSampled = (image.getVkImageUsageFlags() & VK_IMAGE_USAGE_SAMPLED_BIT) != 0;
-  const bool isStorage = (image.getVkImageUsageFlags() & VK_IMAGE_USAGE_STORAGE_BIT) != 0;
-  const bool isColorAttachment =
-      (image.getVkImageUsageFlags() & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) != 0;
-  const bool isDepthStencilAttachment =
-      (image.getVkImageUsageFlags() & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0;
-
-  // a ternary cascade...
-  const VkImageLayout targetLayout =
-      isSampled ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-                : (isStorage ? VK_IMAGE_LAYOUT_GENERAL
-                             : (isColorAttachment
-                                    ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-                                    : (isDepthStencilAttachment
-                                           ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
-                                           : VK_IMAGE_LAYOUT_UNDEFINED)));
-
-  IGL_DEBUG_ASSERT(targetLayout != VK_IMAGE_LAYOUT_UNDEFINED, "Missing usage flags");
-
-  const VkAccessFlags dstAccessMask =
-      isSampled
-          ? VK_ACCESS_SHADER_READ_BIT
-          : (isStorage ? VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
-                       : (isColorAttachment ? VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
-                                            : (isDepthStencilAttachment
-                                                   ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT
-                                                   : 0)));
+  const ImageUploadTarget target = getImageUploadTarget(image);
 
   // 3. Transition TRANSFER_DST_OPTIMAL into `targetLayout`
   ivkImageMemoryBarrier(&ctx_.vf_,
                         wrapper.cmdBuf_,
                         image.getVkImage(),
                         VK_ACCESS_TRANSFER_WRITE_BIT,
-                        dstAccessMask,
+                        target.accessMask,
                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                        targetLayout,
+                        target.layout,
                         VK_PIPELINE_STAGE_TRANSFER_BIT,
                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
                         subresourceRange);
 
-  image.imageLayout_ = targetLayout;
+  image.imageLayout_ = target.layout;
 
   ivkCmdEndDebugUtilsLabel(&ctx_.vf_, wrapper.cmdBuf_);
 
   // Store the allocated block with the SubmitHandle at the end of the deque
   memoryChunk.handle = immediate_->submit(wrapper);
   regions_.push_back(memoryChunk);
+
+  return memoryChunk.handle;
+}
+
+VulkanSubmitHandle VulkanStagingDevice::imageDataChunked(const VulkanImage& image,
+                                                         TextureType type,
+                                                         const TextureRangeDesc& range,
+                                                         const TextureFormatProperties& properties,
+                                                         uint32_t bytesPerRow,
+                                                         VkImageAspectFlags aspectFlags,
+                                                         const void* data) {
+  IGL_PROFILER_FUNCTION();
+
+  const uint32_t initialLayer = getVkLayer(type, range.face, range.layer);
+  const uint32_t numLayers = getVkLayer(type, range.numFaces, range.numLayers);
+  const uint32_t texelsPerRow = bytesPerRow / static_cast<uint32_t>(properties.bytesPerBlock);
+  const bool is3D = image.type_ == VK_IMAGE_TYPE_3D;
+
+  // see imageData()
+  const VkImageAspectFlags aspectMask =
+      image.isDepthFormat_ ? VK_IMAGE_ASPECT_DEPTH_BIT
+                           : (image.isStencilFormat_ ? VK_IMAGE_ASPECT_STENCIL_BIT : aspectFlags);
+  const VkImageSubresourceRange subresourceRange = {
+      aspectFlags,
+      static_cast<uint32_t>(0u),
+      static_cast<uint32_t>(VK_REMAINING_MIP_LEVELS),
+      initialLayer,
+      numLayers,
+  };
+  const ImageUploadTarget target = getImageUploadTarget(image);
+  const VkDeviceSize maxChunkSize = getMaxImageChunkSize();
+
+  VulkanSubmitHandle handle;
+  bool isFirstChunk = true;
+
+  for (auto mipLevel = range.mipLevel; mipLevel < range.mipLevel + range.numMipLevels; ++mipLevel) {
+    const auto mipRange = range.atMipLevel(mipLevel);
+    const uint8_t* mipData = static_cast<const uint8_t*>(data) +
+                             properties.getSubRangeByteOffset(range, mipRange, bytesPerRow);
+
+    // Layers (and cube faces) of a mip level are stored one after another in the same order as
+    // Vulkan array layers. Each layer is split into "slices": rows of texel blocks for 1D/2D
+    // images and depth slices for 3D images
+    const VkDeviceSize layerSize =
+        properties.getBytesPerLayer(mipRange.withNumFaces(1).withNumLayers(1), bytesPerRow);
+    const uint32_t numSlices =
+        is3D ? std::max((mipRange.depth + properties.blockDepth - 1) / properties.blockDepth,
+                        static_cast<uint32_t>(properties.minBlocksZ))
+             : properties.getRows(TextureRangeDesc::new2D(0, 0, mipRange.width, mipRange.height));
+    const uint32_t texelsPerSlice = is3D ? properties.blockDepth : properties.blockHeight;
+    const VkDeviceSize sliceSize = layerSize / numSlices;
+
+    // a single slice always has to fit into one staging buffer
+    IGL_DEBUG_ASSERT(sliceSize <= maxStagingBufferSize_,
+                     "Image slice size exceeds maximum size of staging buffer");
+    const uint32_t slicesPerChunk =
+        std::max(static_cast<uint32_t>(maxChunkSize / sliceSize), static_cast<uint32_t>(1u));
+
+    for (uint32_t layer = 0; layer != numLayers; layer++) {
+      const uint8_t* layerData = mipData + layer * layerSize;
+
+      for (uint32_t slice = 0; slice < numSlices; slice += slicesPerChunk) {
+        const uint32_t chunkSlices = std::min(slicesPerChunk, numSlices - slice);
+        const VkDeviceSize chunkSize = chunkSlices * sliceSize;
+        const bool isLastChunk = mipLevel + 1 == range.mipLevel + range.numMipLevels &&
+                                 layer + 1 == numLayers && slice + chunkSlices == numSlices;
+
+        const uint64_t startTime = getNanoseconds();
+
+        MemoryRegion memoryChunk = nextFreeBlock(chunkSize, true, true);
+        IGL_DEBUG_ASSERT(memoryChunk.size >= chunkSize);
+        auto& stagingBuffer = stagingBuffers_[memoryChunk.stagingBufferIndex];
+
+        const auto& wrapper = immediate_->acquire();
+        recordStall(startTime);
+
+        // 1. Copy the pixel data into the host visible staging buffer
+        stagingBuffer->bufferSubData(memoryChunk.offset, chunkSize, layerData + slice * sliceSize);
+
+        ivkCmdBeginDebugUtilsLabel(&ctx_.vf_,
+                                   wrapper.cmdBuf_,
+                                   "VulkanStagingDevice::imageData (upload image data chunk)",
+                                   kColorUploadImage.toFloatPtr());
+
+        // 2. Transition initial image layout into TRANSFER_DST_OPTIMAL. Subsequent chunks are
+        // submitted later on the same queue and are ordered after this barrier
+        if (isFirstChunk) {
+          ivkImageMemoryBarrier(&ctx_.vf_,
+                                wrapper.cmdBuf_,
+                                image.getVkImage(),
+                                0,
+                                VK_ACCESS_TRANSFER_WRITE_BIT,
+                                VK_IMAGE_LAYOUT_UNDEFINED,
+                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                subresourceRange);
+        }
+
+        // 3. Copy the pixel data from the staging buffer into the image
+        const uint32_t firstTexel = slice * texelsPerSlice;
+        const uint32_t numTexels = is3D ? mipRange.depth : mipRange.height;
+        const uint32_t chunkTexels = std::min(chunkSlices * texelsPerSlice, numTexels - firstTexel);
+        const VkBufferImageCopy copy = ivkGetBufferImageCopy3D(
+            static_cast<uint32_t>(memoryChunk.offset),
+            texelsPerRow,
+            VkOffset3D{static_cast<int32_t>(mipRange.x),
+                       static_cast<int32_t>(mipRange.y + (is3D ? 0u : firstTexel)),
+                       static_cast<int32_t>(mipRange.z + (is3D ? firstTexel : 0u))},
+            VkExtent3D{static_cast<uint32_t>(mipRange.width),
+                       is3D ? static_cast<uint32_t>(mipRange.height) : chunkTexels,
+                       is3D ? chunkTexels : static_cast<uint32_t>(mipRange.depth)},
+            VkImageSubresourceLayers{
+                aspectMask, static_cast<uint32_t>(mipLevel), initialLayer + layer, 1});
+#if IGL_VULKAN_PRINT_COMMANDS
+        IGL_LOG_INFO("%p vkCmdCopyBufferToImage()\n", wrapper.cmdBuf_);
+#endif // IGL_VULKAN_PRINT_COMMANDS
+        ctx_.vf_.vkCmdCopyBufferToImage(wrapper.cmdBuf_,
+                                        stagingBuffer->getVkBuffer(),
+                                        image.getVkImage(),
+                                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                        1,
+                                        &copy);
+
+        // 4. Transition TRANSFER_DST_OPTIMAL into the target layout after the last chunk
+        if (isLastChunk) {
+          ivkImageMemoryBarrier(&ctx_.vf_,
+                                wrapper.cmdBuf_,
+                                image.getVkImage(),
+                                VK_ACCESS_TRANSFER_WRITE_BIT,
+                                target.accessMask,
+                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                target.layout,
+                                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                subresourceRange);
+          image.imageLayout_ = target.layout;
+        }
+
+        ivkCmdEndDebugUtilsLabel(&ctx_.vf_, wrapper.cmdBuf_);
+
+        // Store the allocated block with the SubmitHandle at the end of the deque
+        memoryChunk.handle = immediate_->submit(wrapper);
+        regions_.push_back(memoryChunk);
+        handle = memoryChunk.handle;
+
+        uploadStats_.numBytesUploaded += chunkSize;
+        uploadStats_.numSubmits++;
+        isFirstChunk = false;
+      }
+    }
+  }
+
+  return handle;
 }
 
 void VulkanStagingDevice::getImageData2D(VkImage srcImage,
@@ -658,21 +937,111 @@ void VulkanStagingDevice::getImageData2D(VkImage srcImage,
   freeStagingBufferSize_ += memoryChunk.size;
 }
 
-VkDeviceSize VulkanStagingDevice::getAlignedSize(VkDeviceSize size) const {
-  constexpr VkDeviceSize kStagingBufferAlignment = 16; // updated to support BC7 compressed image
-  return (size + kStagingBufferAlignment - 1) & ~(kStagingBufferAlignment - 1);
+VulkanSubmitHandle VulkanStagingDevice::requestImageData2D(VkImage srcImage,
+                                                           const uint32_t level,
+                                                           const uint32_t layer,
+                                                           const VkRect2D& imageRegion,
+                                                           VkImageLayout layout,
+                                                           VkImageAspectFlags aspectFlags,
+                                                           const VulkanBuffer& dstBuffer) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(layout != VK_IMAGE_LAYOUT_UNDEFINED);
+
+  const auto& wrapper = immediate_->acquire();
+
+  // 1. Transition to VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL
+  ivkImageMemoryBarrier(&ctx_.vf_,
+                        wrapper.cmdBuf_,
+                        srcImage,
+                        0, // srcAccessMask
+                        VK_ACCESS_TRANSFER_READ_BIT, // dstAccessMask
+                        layout,
+                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, // wait for any previous operation
+                        VK_PIPELINE_STAGE_TRANSFER_BIT, // dstStageMask
+                        VkImageSubresourceRange{aspectFlags, level, 1, layer, 1});
+
+  // 2. Copy the pixel data from the image into the readback buffer
+  const VkBufferImageCopy copy = ivkGetBufferImageCopy2D(
+      0, 0, imageRegion, VkImageSubresourceLayers{aspectFlags, level, layer, 1});
+  ctx_.vf_.vkCmdCopyImageToBuffer(wrapper.cmdBuf_,
+                                  srcImage,
+                                  VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                  dstBuffer.getVkBuffer(),
+                                  1,
+                                  &copy);
+
+  // 3. Make the pixels visible to the host once the fence is signaled
+  ivkBufferMemoryBarrier(&ctx_.vf_,
+                         wrapper.cmdBuf_,
+                         dstBuffer.getVkBuffer(),
+                         VK_ACCESS_TRANSFER_WRITE_BIT, // srcAccessMask
+                         VK_ACCESS_HOST_READ_BIT, // dstAccessMask
+                         0,
+                         VK_WHOLE_SIZE,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT, // srcStageMask
+                         VK_PIPELINE_STAGE_HOST_BIT); // dstStageMask
+
+  // 4. Transition back to the initial image layout
+  ivkImageMemoryBarrier(&ctx_.vf_,
+                        wrapper.cmdBuf_,
+                        srcImage,
+                        VK_ACCESS_TRANSFER_READ_BIT, // srcAccessMask
+                        0, // dstAccessMask
+                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        layout,
+                        VK_PIPELINE_STAGE_TRANSFER_BIT, // srcStageMask
+                        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, // dstStageMask
+                        VkImageSubresourceRange{aspectFlags, level, 1, layer, 1});
+
+  return immediate_->submit(wrapper);
 }
 
-void VulkanStagingDevice::waitAndReset() {
+std::unique_ptr<VulkanBuffer> VulkanStagingDevice::acquireReadbackBuffer(VkDeviceSize size) {
   IGL_PROFILER_FUNCTION();
 
-  for (const auto region : regions_) {
-    immediate_->wait(region.handle, ctx_.config_.fenceTimeoutNanoseconds);
+  // the smallest finished buffer which is large enough
+  auto best = readbackBuffers_.end();
+  for (auto it = readbackBuffers_.begin(); it != readbackBuffers_.end(); ++it) {
+    if (it->buffer->getSize() >= size &&
+        (best == readbackBuffers_.end() || it->buffer->getSize() < best->buffer->getSize()) &&
+        immediate_->isReady(it->handle)) {
+      best = it;
+    }
+  }
+  if (best != readbackBuffers_.end()) {
+    std::unique_ptr<VulkanBuffer> buffer = std::move(best->buffer);
+    readbackBuffers_.erase(best);
+    return buffer;
+  }
+
+  ++readbackBufferCounter_;
+  return std::make_unique<VulkanBuffer>(
+      ctx_,
+      ctx_.device_->getVkDevice(),
+      size,
+      VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      readbackMemoryFlags_,
+      IGL_FORMAT("Buffer: readback buffer #{} with {}B", readbackBufferCounter_, size).c_str());
+}
+
+void VulkanStagingDevice::releaseReadbackBuffer(std::unique_ptr<VulkanBuffer> buffer,
+                                                VulkanSubmitHandle handle) {
+  if (!IGL_DEBUG_VERIFY(buffer)) {
+    return;
   }
+  readbackBuffers_.push_back({std::move(buffer), handle});
 
-  regions_.clear();
-  stagingBuffers_.clear();
-  freeStagingBufferSize_ = 0;
+  // the GPU may still write into buffers which are not ready, so only finished ones are destroyed
+  for (auto it = readbackBuffers_.begin();
+       readbackBuffers_.size() > kMaxReadbackBuffers && it != readbackBuffers_.end();) {
+    it = immediate_->isReady(it->handle) ? readbackBuffers_.erase(it) : std::next(it);
+  }
+}
+
+VkDeviceSize VulkanStagingDevice::getAlignedSize(VkDeviceSize size) const {
+  constexpr VkDeviceSize kStagingBufferAlignment = 16; // updated to support BC7 compressed image
+  return (size + kStagingBufferAlignment - 1) & ~(kStagingBufferAlignment - 1);
 }
 
 bool VulkanStagingDevice::shouldAllocateStagingBuffer(VkDeviceSize sizeNeeded,
@@ -743,4 +1112,58 @@ void VulkanStagingDevice::allocateStagingBuffer(VkDeviceSize minimumSize) {
   freeStagingBufferSize_ += stagingBufferSize;
 }
 
+bool VulkanStagingDevice::waitForOldestDedicatedBuffer() {
+  IGL_PROFILER_FUNCTION();
+
+  const uint32_t stagingBufferIndex = dedicatedBuffers_.front().stagingBufferIndex;
+
+#if IGL_VULKAN_DEBUG_STAGING_DEVICE
+  IGL_LOG_INFO("Too much memory in dedicated staging buffers. Waiting for staging buffer %u\n",
+               stagingBufferIndex);
+#endif
+
+  for (const MemoryRegion& region : regions_) {
+    if (region.stagingBufferIndex == stagingBufferIndex && !immediate_->isReady(region.handle) &&
+        immediate_->wait(region.handle, ctx_.config_.fenceTimeoutNanoseconds) != VK_SUCCESS) {
+      return false;
+    }
+  }
+  // the finished blocks may fit the requested size together
+  mergeRegions(false);
+  return true;
+}
+
+void VulkanStagingDevice::freeStagingBuffer(uint32_t stagingBufferIndex) {
+  for (auto regionItr = regions_.begin(); regionItr != regions_.end();) {
+    if (regionItr->stagingBufferIndex != stagingBufferIndex) {
+      ++regionItr;
+      continue;
+    }
+    // finished blocks which still have a handle were not added to the free size yet
+    if (regionItr->handle.empty()) {
+      freeStagingBufferSize_ -= regionItr->size;
+    }
+    regionItr = regions_.erase(regionItr);
+  }
+
+  stagingBuffers_[stagingBufferIndex].reset();
+  forgetDedicatedBuffer(stagingBufferIndex);
+
+  // remove trailing empty staging buffers
+  while (!stagingBuffers_.empty() && stagingBuffers_.back().get() == nullptr) {
+    stagingBuffers_.pop_back();
+  }
+}
+
+void VulkanStagingDevice::forgetDedicatedBuffer(uint32_t stagingBufferIndex) {
+  const auto it = std::find_if(
+      dedicatedBuffers_.begin(), dedicatedBuffers_.end(), [=](const DedicatedBuffer& buffer) {
+        return buffer.stagingBufferIndex == stagingBufferIndex;
+      });
+  if (it != dedicatedBuffers_.end()) {
+    dedicatedStagingBufferSize_ -= it->size;
+    dedicatedBuffers_.erase(it);
+  }
+}
+
 } // namespace igl::vulkan
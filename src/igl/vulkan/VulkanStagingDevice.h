@@ -28,8 +28,20 @@ class VulkanImage;
  * is lazily allocated and grows as needed when the uploaded data cannot be transferred in small
  * chunks and is larger than the current staging buffer's size. The maximum size of the buffer is
  * determined at runtime and is the minimum between VkPhysicalDeviceLimits::VkPhysicalDeviceLimits
- * and 256 MB. Some architectures limit the size of staging buffers to 256MB (buffers that are both
- * host and device visible).
+ * and 256 MB (or VulkanContextConfig::maxStagingBufferSize, if set). Some architectures limit the
+ * size of staging buffers to 256MB (buffers that are both host and device visible).
+ *
+ * Uploads are recorded into command buffers owned by the staging device (`immediate_`) and are
+ * submitted right away, without waiting for them to complete. Upload functions return the
+ * SubmitHandle of the last submission, which can be polled with `isUploadComplete()` or waited on
+ * with `waitForUpload()`. Large images are split into chunks so they never need a contiguous
+ * staging block larger than `getMaxImageChunkSize()`.
+ *
+ * When the staging buffer is full, small uploads wait only for the oldest blocks they need. Uploads
+ * larger than `getMaxImageChunkSize()` do not wait: they get staging buffers of their own, which
+ * are freed by `mergeRegionsAndFreeBuffers()` once the uploads have finished. The total size of
+ * those buffers is bounded by `getMaxDedicatedStagingBufferSize()`; beyond it, uploads wait for
+ * the oldest of them and reuse or free it.
  */
 class VulkanStagingDevice final {
  public:
@@ -41,11 +53,29 @@ class VulkanStagingDevice final {
 
   std::unique_ptr<VulkanImmediateCommands> immediate_;
 
+  /// @brief Statistics about the uploads performed by the staging device
+  struct UploadStats {
+    /// @brief The total number of bytes copied through staging buffers
+    uint64_t numBytesUploaded = 0;
+    /// @brief The number of command buffers submitted for uploads
+    uint32_t numSubmits = 0;
+    /// @brief The total time the caller was blocked waiting for a free staging block or a free
+    /// command buffer
+    uint64_t totalStallNanoseconds = 0;
+    /// @brief The longest single wait for a free staging block or a free command buffer
+    uint64_t maxStallNanoseconds = 0;
+  };
+
   /** @brief Uploads the data at location `data` with the provided size (in bytes) to the
    * VulkanBuffer object on the device at offset `dstOffset`. The upload operation is asynchronous
-   * and the data may or may not be available to the GPU when the function returns
+   * and the data may or may not be available to the GPU when the function returns. Returns the
+   * SubmitHandle of the last submission of the upload, or an empty handle if the buffer is mapped
+   * and the data was copied directly
    */
-  void bufferSubData(VulkanBuffer& buffer, size_t dstOffset, size_t size, const void* data);
+  VulkanImmediateCommands::SubmitHandle bufferSubData(VulkanBuffer& buffer,
+                                                      size_t dstOffset,
+                                                      size_t size,
+                                                      const void* data);
 
   /** @brief Downloads the data with the provided size (in bytes) from the VulkanBuffer object on
    * the device, and at the offset provided, to the location referenced by the pointer `data`. The
@@ -56,14 +86,23 @@ class VulkanStagingDevice final {
 
   /// @brief Uploads the texture data pointed by `data` to the VulkanImage object on the device. The
   /// data may span the entire texture or just part of it. The upload operation is asynchronous and
-  /// the data may or may not be available to the GPU when the function returns
-  void imageData(const VulkanImage& image,
-                 TextureType type,
-                 const TextureRangeDesc& range,
-                 const TextureFormatProperties& properties,
-                 uint32_t bytesPerRow,
-                 VkImageAspectFlags aspectFlags,
-                 const void* data);
+  /// the data may or may not be available to the GPU when the function returns. Data larger than
+  /// `getMaxImageChunkSize()` is split into several submissions. Returns the SubmitHandle of the
+  /// last submission of the upload
+  VulkanImmediateCommands::SubmitHandle imageData(const VulkanImage& image,
+                                                  TextureType type,
+                                                  const TextureRangeDesc& range,
+                                                  const TextureFormatProperties& properties,
+                                                  uint32_t bytesPerRow,
+                                                  VkImageAspectFlags aspectFlags,
+                                                  const void* data);
+
+  /// @brief Returns true if the upload identified by `handle` has completed on the GPU. Does not
+  /// block
+  [[nodiscard]] bool isUploadComplete(VulkanImmediateCommands::SubmitHandle handle) const;
+
+  /// @brief Blocks until the upload identified by `handle` has completed on the GPU
+  void waitForUpload(VulkanImmediateCommands::SubmitHandle handle);
 
   /** @brief Downloads the texture data from the VulkanImage object on the device to the location
    * pointed by `data`. The data requested may span the entire texture or just part of it. The
@@ -82,6 +121,29 @@ class VulkanStagingDevice final {
                       uint32_t bytesPerRow,
                       bool flipImageVertical);
 
+  /** @brief Records a copy of the region of the VulkanImage object into `dstBuffer` at offset 0,
+   * with tightly packed rows, and submits it without waiting for the GPU. The image is back in
+   * `layout` once the copy has finished. Returns the SubmitHandle of the copy, which can be polled
+   * with `isUploadComplete()` before the buffer is read.
+   */
+  VulkanImmediateCommands::SubmitHandle requestImageData2D(VkImage srcImage,
+                                                           uint32_t level,
+                                                           uint32_t layer,
+                                                           const VkRect2D& imageRegion,
+                                                           VkImageLayout layout,
+                                                           VkImageAspectFlags aspectFlags,
+                                                           const VulkanBuffer& dstBuffer);
+
+  /// @brief Returns a host-visible buffer with at least `size` bytes for `requestImageData2D()`,
+  /// in host-cached memory when the device has it. The smallest buffer released with
+  /// `releaseReadbackBuffer()` whose copy has finished is reused
+  [[nodiscard]] std::unique_ptr<VulkanBuffer> acquireReadbackBuffer(VkDeviceSize size);
+
+  /// @brief Returns a buffer to the readback pool. `handle` is the SubmitHandle of the last copy
+  /// into the buffer, which may still be running
+  void releaseReadbackBuffer(std::unique_ptr<VulkanBuffer> buffer,
+                             VulkanImmediateCommands::SubmitHandle handle);
+
   /// @brief Returns the size of staging buffer available for use
   [[nodiscard]] VkDeviceSize getFreeStagingBufferSize() const {
     return freeStagingBufferSize_;
@@ -92,6 +154,31 @@ class VulkanStagingDevice final {
     return maxStagingBufferSize_;
   }
 
+  /// @brief Returns the maximum number of bytes of image data transferred in a single submission
+  [[nodiscard]] VkDeviceSize getMaxImageChunkSize() const;
+
+  /// @brief Returns the total size of the staging buffers allocated for large uploads which were
+  /// not freed yet
+  [[nodiscard]] VkDeviceSize getDedicatedStagingBufferSize() const {
+    return dedicatedStagingBufferSize_;
+  }
+
+  /// @brief Returns the upper bound of `getDedicatedStagingBufferSize()`
+  [[nodiscard]] VkDeviceSize getMaxDedicatedStagingBufferSize() const {
+    return maxDedicatedStagingBufferSize_;
+  }
+
+  /// @brief Returns the upload statistics accumulated since creation or the last call to
+  /// `resetUploadStats()`
+  [[nodiscard]] const UploadStats& getUploadStats() const {
+    return uploadStats_;
+  }
+
+  /// @brief Resets the upload statistics
+  void resetUploadStats() {
+    uploadStats_ = {};
+  }
+
   /// @brief Function to merge regions of the staging buffer that are contiguous, and deallocate
   /// unused staging buffers.
   void mergeRegionsAndFreeBuffers();
@@ -110,19 +197,42 @@ class VulkanStagingDevice final {
    * requested. If the only contiguous block of memory available is smaller than the requested size,
    * the function returns the amount of memory it was able to find.
    *
+   * If no block is available, the function waits for the oldest busy blocks, one at a time, until
+   * one of them can be used.
+   *
    * @param contiguous
    * if true, the function will return a region big enough to accommodate full requested size.
    * if false, the function may return a region smaller than the requested size.
+   * @param dedicated
+   * if true and no block is available, the function allocates a new staging buffer for the request
+   * instead of waiting, unless the staging buffers allocated this way exceed
+   * `maxDedicatedStagingBufferSize_`. Then it waits for the oldest of them instead.
    * @return The offset of the free memory block on the staging buffer and the size of the block
    * found.
    */
-  [[nodiscard]] MemoryRegion nextFreeBlock(VkDeviceSize size, bool contiguous);
+  [[nodiscard]] MemoryRegion nextFreeBlock(VkDeviceSize size,
+                                           bool contiguous,
+                                           bool dedicated = false);
+
+  /// @brief Uploads an image one chunk at a time. Each chunk covers whole rows of texel blocks (or
+  /// whole depth slices for 3D images) of a single mip level and array layer and is submitted
+  /// separately
+  VulkanImmediateCommands::SubmitHandle imageDataChunked(const VulkanImage& image,
+                                                         TextureType type,
+                                                         const TextureRangeDesc& range,
+                                                         const TextureFormatProperties& properties,
+                                                         uint32_t bytesPerRow,
+                                                         VkImageAspectFlags aspectFlags,
+                                                         const void* data);
+
+  /// @brief Adds the time elapsed since `startNanoseconds` to the stall statistics
+  void recordStall(uint64_t startNanoseconds);
 
   [[nodiscard]] VkDeviceSize getAlignedSize(VkDeviceSize size) const;
 
-  /// @brief Waits for all memory blocks to become available and resets the staging device's
-  /// internal state
-  void waitAndReset();
+  /// @brief Merges the finished regions at the front of the deque which are contiguous. Staging
+  /// buffers which are completely free are deallocated if `freeBuffers` is true
+  void mergeRegions(bool freeBuffers);
 
   /**
    * @brief Returns true if the staging buffer cannot store the size requested
@@ -140,6 +250,16 @@ class VulkanStagingDevice final {
   /// size
   void allocateStagingBuffer(VkDeviceSize minimumSize);
 
+  /// @brief Waits for all blocks of the oldest staging buffer allocated for a large upload. Returns
+  /// false if a wait failed
+  [[nodiscard]] bool waitForOldestDedicatedBuffer();
+
+  /// @brief Frees a staging buffer, all of whose blocks have to be finished and in `regions_`
+  void freeStagingBuffer(uint32_t stagingBufferIndex);
+
+  /// @brief Stops tracking a freed staging buffer if it was allocated for a large upload
+  void forgetDedicatedBuffer(uint32_t stagingBufferIndex);
+
  private:
   VulkanContext& ctx_;
   std::vector<std::unique_ptr<VulkanBuffer>> stagingBuffers_;
@@ -148,11 +268,16 @@ class VulkanStagingDevice final {
   VkDeviceSize freeStagingBufferSize_ = 0;
   /// @brief Maximum staging buffer size, limited by some architectures
   VkDeviceSize maxStagingBufferSize_ = 0;
+  /// @brief Total size of the staging buffers in `dedicatedBuffers_`
+  VkDeviceSize dedicatedStagingBufferSize_ = 0;
+  VkDeviceSize maxDedicatedStagingBufferSize_ = 0;
   /// @brief Used to track the current staging buffer's id. Updated every time the staging buffer
   /// grows, it is used as the debug name for the staging buffer for easily tracking it during
   /// debugging
   uint32_t stagingBufferCounter_ = 0;
 
+  UploadStats uploadStats_;
+
   /**
    * @brief Stores the used and unused blocks of memory in the staging buffer. There is no
    * distinction between used and unused blocks in the deque, as we always `wait` on each block
@@ -161,6 +286,26 @@ class VulkanStagingDevice final {
    * the associated command buffer to finish)
    */
   std::deque<MemoryRegion> regions_;
+
+  struct DedicatedBuffer {
+    uint32_t stagingBufferIndex = 0u;
+    VkDeviceSize size = 0u;
+  };
+
+  /// @brief Staging buffers allocated for large uploads which were not freed yet, oldest first
+  std::deque<DedicatedBuffer> dedicatedBuffers_;
+
+  struct ReadbackBuffer {
+    std::unique_ptr<VulkanBuffer> buffer;
+    VulkanImmediateCommands::SubmitHandle handle;
+  };
+
+  /// @brief Released readback buffers, oldest first. A buffer is reused once its handle is ready
+  std::deque<ReadbackBuffer> readbackBuffers_;
+  /// @brief Used as the debug name of readback buffers
+  uint32_t readbackBufferCounter_ = 0;
+  /// @brief HOST_VISIBLE, plus HOST_CACHED if the device has a memory type with both
+  VkMemoryPropertyFlags readbackMemoryFlags_ = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
 };
 
 } // namespace igl::vulkan
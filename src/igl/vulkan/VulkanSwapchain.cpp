@@ -283,6 +283,9 @@ VulkanSwapchain::~VulkanSwapchain() {
 Result VulkanSwapchain::acquireNextImage() {
   IGL_PROFILER_FUNCTION();
 
+  // does nothing if the application has already started the frame
+  ctx_.framePacer_->beginFrame();
+
   VkResult acquireResult = VK_SUCCESS;
 
   if (ctx_.timelineSemaphore_) {
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanUniformRingBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <igl/vulkan/VulkanBuffer.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace {
+
+VkDeviceSize getAlignedSize(VkDeviceSize size, VkDeviceSize alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+namespace igl::vulkan {
+
+VulkanUniformRingBuffer::VulkanUniformRingBuffer(const VulkanContext& ctx, VkDeviceSize size) :
+  ctx_(ctx) {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+  const VkDeviceSize alignment =
+      ctx.getVkPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment;
+
+  alignment_ = std::max<VkDeviceSize>(alignment, 1);
+  size_ = getAlignedSize(size, alignment_);
+
+  // VulkanContext::createBuffer() limits uniform buffers to maxUniformBufferRange; the ring only
+  // has to respect this limit for every individual allocation, so the buffer is created directly
+  buffer_ = std::make_unique<VulkanBuffer>(
+      ctx,
+      ctx.getVkDevice(),
+      size_,
+      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+      "Buffer: uniform ring");
+
+  IGL_DEBUG_ASSERT(buffer_->isMapped());
+}
+
+VulkanUniformRingBuffer::~VulkanUniformRingBuffer() = default;
+
+VulkanUniformRingBuffer::Allocation VulkanUniformRingBuffer::allocate(
+    const void* data,
+    size_t size,
+    VulkanImmediateCommands::SubmitHandle handle) {
+  IGL_PROFILER_FUNCTION();
+
+  IGL_DEBUG_ASSERT(!handle.empty());
+
+  if (!IGL_DEBUG_VERIFY(data && size)) {
+    return {};
+  }
+
+  const VkDeviceSize alignedSize = getAlignedSize(size, alignment_);
+  const uint32_t maxRange = ctx_.getVkPhysicalDeviceProperties().limits.maxUniformBufferRange;
+
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  if (alignedSize > size_ || size > maxRange) {
+    IGL_LOG_ERROR("Cannot allocate %u bytes from the uniform ring buffer (size %u, limit %u)\n",
+                  static_cast<uint32_t>(size),
+                  static_cast<uint32_t>(size_),
+                  maxRange);
+    stats_.numFailedAllocations++;
+    return {};
+  }
+
+  reclaim();
+
+  VkDeviceSize offset = 0;
+  bool wrapped = false;
+
+  while (true) {
+    if (regions_.empty()) {
+      // the entire buffer is free
+      offset = 0;
+      break;
+    }
+    if (head_ > tail_) {
+      // free space: [head_, size_) and [0, tail_)
+      if (head_ + alignedSize <= size_) {
+        offset = head_;
+        break;
+      }
+      if (alignedSize <= tail_) {
+        offset = 0;
+        wrapped = true;
+        break;
+      }
+    } else if (head_ + alignedSize <= tail_) {
+      // free space: [head_, tail_)
+      offset = head_;
+      break;
+    }
+    // out of space: wait for the oldest command buffer unless it is the one we are recording now
+    const VulkanImmediateCommands::SubmitHandle oldest = regions_.front().handle;
+    if (oldest == handle) {
+      IGL_LOG_ERROR(
+          "The uniform ring buffer is too small for a single command buffer. Increase "
+          "VulkanContextConfig::uniformRingBufferSize (%u bytes)\n",
+          static_cast<uint32_t>(size_));
+      stats_.numFailedAllocations++;
+      return {};
+    }
+    if (!ctx_.immediate_->isSubmitted(oldest)) {
+      // another command buffer is still being encoded, waiting for it would never return
+      IGL_LOG_ERROR_ONCE(
+          "The uniform ring buffer is full of allocations from command buffers which have not been "
+          "submitted. Increase VulkanContextConfig::uniformRingBufferSize (%u bytes)\n",
+          static_cast<uint32_t>(size_));
+      stats_.numFailedAllocations++;
+      return {};
+    }
+    const VkResult result =
+        ctx_.immediate_->wait(oldest, ctx_.config_.fenceTimeoutNanoseconds);
+    if (result != VK_SUCCESS) {
+      IGL_LOG_ERROR("Waiting for the uniform ring buffer failed: %s\n",
+                    ivkGetVulkanResultString(result));
+      stats_.numFailedAllocations++;
+      return {};
+    }
+    reclaim();
+  }
+
+  if (wrapped) {
+    // the unused tail of the buffer is released together with the last region
+    regions_.back().end = size_;
+  }
+
+  head_ = offset + alignedSize;
+
+  if (!wrapped && !regions_.empty() && regions_.back().handle == handle) {
+    regions_.back().end = head_;
+  } else {
+    regions_.push_back({head_, handle});
+  }
+
+  std::memcpy(buffer_->getMappedPtr() + offset, data, size);
+
+  stats_.numAllocations++;
+  currentFrameBytes_ += alignedSize;
+  stats_.peakFrameBytes = std::max(stats_.peakFrameBytes, currentFrameBytes_);
+  stats_.peakBytesInUse = std::max(stats_.peakBytesInUse, getBytesInUse());
+
+  return {
+      .buffer = buffer_->getVkBuffer(),
+      .offset = offset,
+      .size = size,
+  };
+}
+
+void VulkanUniformRingBuffer::reclaim() {
+  while (!regions_.empty() && ctx_.immediate_->isReady(regions_.front().handle)) {
+    tail_ = regions_.front().end;
+    if (tail_ == size_) {
+      tail_ = 0;
+    }
+    regions_.pop_front();
+  }
+  if (regions_.empty()) {
+    head_ = 0;
+    tail_ = 0;
+  }
+}
+
+VkDeviceSize VulkanUniformRingBuffer::getBytesInUse() const {
+  if (regions_.empty()) {
+    return 0;
+  }
+  return head_ > tail_ ? head_ - tail_ : size_ - tail_ + head_;
+}
+
+void VulkanUniformRingBuffer::endFrame() {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  stats_.lastFrameBytes = currentFrameBytes_;
+  currentFrameBytes_ = 0;
+}
+
+VulkanUniformRingBuffer::Stats VulkanUniformRingBuffer::getStats() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  return stats_;
+}
+
+void VulkanUniformRingBuffer::resetStats() {
+  std::lock_guard<std::mutex> guard(mutex_);
+
+  stats_ = {};
+  currentFrameBytes_ = 0;
+}
+
+} // namespace igl::vulkan
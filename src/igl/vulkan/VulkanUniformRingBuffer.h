@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+
+namespace igl::vulkan {
+
+class VulkanBuffer;
+class VulkanContext;
+
+/** @brief A linear allocator for transient uniform data, such as the data passed to
+ * `bindBytes()`. All allocations are sub-allocated from one persistently mapped host-visible
+ * buffer, which is used as a ring: every allocation is a pointer bump, and memory is reclaimed once
+ * the SubmitHandle of the command buffer which used it has completed. Allocations are aligned to
+ * VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment, so they can be bound either with a
+ * descriptor offset or as a dynamic offset (VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC). The size of
+ * the buffer is VulkanContextConfig::uniformRingBufferSize; use `getStats()` to size it.
+ */
+class VulkanUniformRingBuffer final {
+ public:
+  VulkanUniformRingBuffer(const VulkanContext& ctx, VkDeviceSize size);
+  ~VulkanUniformRingBuffer();
+
+  VulkanUniformRingBuffer(const VulkanUniformRingBuffer&) = delete;
+  VulkanUniformRingBuffer& operator=(const VulkanUniformRingBuffer&) = delete;
+
+  struct Allocation {
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+
+    [[nodiscard]] bool valid() const {
+      return buffer != VK_NULL_HANDLE;
+    }
+  };
+
+  struct Stats {
+    /// @brief The number of successful allocations
+    uint64_t numAllocations = 0;
+    /// @brief The number of allocations which did not fit into the buffer
+    uint64_t numFailedAllocations = 0;
+    /// @brief The number of bytes allocated during the last completed frame (including alignment)
+    VkDeviceSize lastFrameBytes = 0;
+    /// @brief The largest number of bytes allocated during a single frame (including alignment)
+    VkDeviceSize peakFrameBytes = 0;
+    /// @brief The largest number of bytes in use by the GPU at the same time. The buffer has to be
+    /// at least this large to never run out of space
+    VkDeviceSize peakBytesInUse = 0;
+  };
+
+  /** @brief Copies `size` bytes from `data` into the buffer. The memory is kept alive until
+   * `handle` has completed. `handle` must be the SubmitHandle of the command buffer which uses the
+   * allocation. Returns an invalid allocation if there is not enough free space. Thread-safe.
+   */
+  [[nodiscard]] Allocation allocate(const void* data,
+                                    size_t size,
+                                    VulkanImmediateCommands::SubmitHandle handle);
+
+  /// @brief Marks the end of a frame for the per-frame statistics
+  void endFrame();
+
+  [[nodiscard]] Stats getStats() const;
+  void resetStats();
+
+  [[nodiscard]] VkDeviceSize getSize() const {
+    return size_;
+  }
+
+ private:
+  /// @brief Releases the memory of all the leading regions whose SubmitHandles have completed
+  void reclaim();
+
+  [[nodiscard]] VkDeviceSize getBytesInUse() const;
+
+ private:
+  struct Region {
+    // the end of the region in the buffer; a region starts where the previous one ends
+    VkDeviceSize end = 0;
+    VulkanImmediateCommands::SubmitHandle handle;
+  };
+
+  const VulkanContext& ctx_;
+  std::unique_ptr<VulkanBuffer> buffer_;
+  VkDeviceSize size_ = 0;
+  VkDeviceSize alignment_ = 1;
+
+  mutable std::mutex mutex_;
+  // the next allocation starts here
+  VkDeviceSize head_ = 0;
+  // the start of the oldest region in use by the GPU
+  VkDeviceSize tail_ = 0;
+  // regions in use by the GPU, from the oldest to the newest
+  std::deque<Region> regions_;
+
+  VkDeviceSize currentFrameBytes_ = 0;
+  Stats stats_;
+};
+
+} // namespace igl::vulkan